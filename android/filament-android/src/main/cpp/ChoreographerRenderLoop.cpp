@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <jni.h>
+
+#include <android/choreographer.h>
+
+#include <filament/Renderer.h>
+
+#include <time.h>
+
+using namespace filament;
+
+namespace {
+
+// Owns the AChoreographer frame callback and decides when the frame actually starts.
+//
+// Every product team hand-rolls this dance and most get the details subtly wrong (latching
+// input at post time instead of callback time, passing SystemClock.uptimeMillis() instead of
+// the vsync timestamp, ...), each mistake costing a frame or two of latency. This helper
+// reposts itself every vsync, delays the frame start by the pacing offset predicted by the
+// renderer (see Renderer::getFrameStartOffsetNanos()) so input is latched as late as the GPU
+// budget allows, and then invokes the Java frame callback with the correct vsync timestamp to
+// pass to Renderer.beginFrame().
+class ChoreographerRenderLoop {
+public:
+    static ChoreographerRenderLoop* create(JNIEnv* env, jlong nativeRenderer, jobject callback) {
+        jclass callbackClass = env->GetObjectClass(callback);
+        jmethodID onFrame = env->GetMethodID(callbackClass, "onFrame", "(J)V");
+        if (onFrame == nullptr) {
+            return nullptr;
+        }
+        JavaVM* vm = nullptr;
+        env->GetJavaVM(&vm);
+        return new ChoreographerRenderLoop(vm, (Renderer*) nativeRenderer,
+                env->NewGlobalRef(callback), onFrame);
+    }
+
+    // Must be called on a looper thread; the frame callbacks fire on the same thread.
+    void start() {
+        mRunning = true;
+        postFrameCallback();
+    }
+
+    void stop() {
+        mRunning = false;
+    }
+
+    // The loop deletes itself once the last pending callback has fired, so a callback already
+    // scheduled by the choreographer never runs against a dangling pointer.
+    void destroy(JNIEnv* env) {
+        mRunning = false;
+        env->DeleteGlobalRef(mCallback);
+        mCallback = nullptr;
+        if (mCallbackPending) {
+            mDestroyRequested = true;
+        } else {
+            delete this;
+        }
+    }
+
+private:
+    ChoreographerRenderLoop(JavaVM* vm, Renderer* renderer, jobject callback, jmethodID onFrame)
+            : mVm(vm), mRenderer(renderer), mCallback(callback), mOnFrame(onFrame) {}
+
+    void postFrameCallback() {
+        mCallbackPending = true;
+#if __ANDROID_API__ >= 29
+        AChoreographer_postFrameCallback64(AChoreographer_getInstance(),
+                [](int64_t frameTimeNanos, void* data) {
+                    ((ChoreographerRenderLoop*) data)->frame(frameTimeNanos);
+                }, this);
+#else
+        AChoreographer_postFrameCallback(AChoreographer_getInstance(),
+                [](long frameTimeNanos, void* data) {
+                    ((ChoreographerRenderLoop*) data)->frame(frameTimeNanos);
+                }, this);
+#endif
+    }
+
+    void frame(int64_t frameTimeNanos) {
+        mCallbackPending = false;
+        if (mDestroyRequested) {
+            delete this;
+            return;
+        }
+        if (!mRunning) {
+            return;
+        }
+
+        // Repost before rendering so a long frame doesn't push the next callback out.
+        postFrameCallback();
+
+        // When the renderer predicts the GPU will finish well before the latch deadline, the
+        // frame can start that much later than vsync; input latched after this delay is
+        // correspondingly fresher. A negative offset means the frame is already late, so
+        // start immediately.
+        int64_t const offset = mRenderer->getFrameStartOffsetNanos();
+        if (offset > 0) {
+            int64_t const target = frameTimeNanos + offset;
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            int64_t const nowNanos = int64_t(now.tv_sec) * 1000000000ll + now.tv_nsec;
+            if (target > nowNanos) {
+                struct timespec delay = {
+                        time_t((target - nowNanos) / 1000000000ll),
+                        long((target - nowNanos) % 1000000000ll) };
+                nanosleep(&delay, nullptr);
+            }
+        }
+
+        // The callback latches input and animation state, then runs beginFrame() / render() /
+        // endFrame() with the vsync timestamp we pass here.
+        JNIEnv* env = nullptr;
+        if (mVm->GetEnv((void**) &env, JNI_VERSION_1_6) != JNI_OK) {
+            mVm->AttachCurrentThread(&env, nullptr);
+        }
+        env->CallVoidMethod(mCallback, mOnFrame, (jlong) frameTimeNanos);
+    }
+
+    JavaVM* const mVm;
+    Renderer* const mRenderer;
+    jobject mCallback;
+    jmethodID const mOnFrame;
+    bool mRunning = false;
+    bool mCallbackPending = false;
+    bool mDestroyRequested = false;
+};
+
+} // anonymous namespace
+
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_google_android_filament_android_ChoreographerRenderLoop_nCreate(JNIEnv* env, jclass,
+        jlong nativeRenderer, jobject callback) {
+    return (jlong) ChoreographerRenderLoop::create(env, nativeRenderer, callback);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_google_android_filament_android_ChoreographerRenderLoop_nStart(JNIEnv*, jclass,
+        jlong nativeLoop) {
+    ((ChoreographerRenderLoop*) nativeLoop)->start();
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_google_android_filament_android_ChoreographerRenderLoop_nStop(JNIEnv*, jclass,
+        jlong nativeLoop) {
+    ((ChoreographerRenderLoop*) nativeLoop)->stop();
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_google_android_filament_android_ChoreographerRenderLoop_nDestroy(JNIEnv* env, jclass,
+        jlong nativeLoop) {
+    ((ChoreographerRenderLoop*) nativeLoop)->destroy(env);
+}
@@ -26,6 +26,10 @@
 #include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <string.h>
+
+#include "common/NioUtils.h"
+
 using namespace filament;
 using namespace filament::math;
 
@@ -246,6 +250,63 @@ Java_com_google_android_filament_MaterialInstance_nSetFloatParameterArray(JNIEnv
     env->ReleaseStringUTFChars(name_, name);
 }
 
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_google_android_filament_MaterialInstance_nSetParametersFloat(JNIEnv *env, jclass,
+        jstring name_, jint element, jobject buffer, jint remaining, jint count) {
+    // Each packed record is a native MaterialInstance pointer (2 words) followed by the
+    // parameter value, so updating the same parameter on a whole cast of instances crosses
+    // JNI once and fetches the parameter name once.
+    jint vectorWords = 0;
+    switch ((FloatElement) element) {
+        case FLOAT:  vectorWords = 1;  break;
+        case FLOAT2: vectorWords = 2;  break;
+        case FLOAT3: vectorWords = 3;  break;
+        case FLOAT4: vectorWords = 4;  break;
+        case MAT3:   vectorWords = 9;  break;
+        case MAT4:   vectorWords = 16; break;
+    }
+    const jint recordWords = 2 + vectorWords;
+    AutoBuffer nioBuffer(env, buffer, count * recordWords);
+    size_t sizeInBytes = nioBuffer.getSize();
+    if (sizeInBytes > (remaining << nioBuffer.getShift())) {
+        // BufferOverflowException
+        return -1;
+    }
+
+    const char* name = env->GetStringUTFChars(name_, 0);
+    uint32_t const* record = static_cast<uint32_t const*>(nioBuffer.getData());
+    for (jint j = 0; j < count; j++, record += recordWords) {
+        // the pointer is only guaranteed 4-byte aligned within the packed stream
+        jlong nativeMaterialInstance;
+        memcpy(&nativeMaterialInstance, record, sizeof(jlong));
+        MaterialInstance* instance = (MaterialInstance*) nativeMaterialInstance;
+        float const* v = reinterpret_cast<float const*>(record + 2);
+        switch ((FloatElement) element) {
+            case FLOAT:
+                instance->setParameter(name, v[0]);
+                break;
+            case FLOAT2:
+                instance->setParameter(name, *reinterpret_cast<const float2*>(v));
+                break;
+            case FLOAT3:
+                instance->setParameter(name, *reinterpret_cast<const float3*>(v));
+                break;
+            case FLOAT4:
+                instance->setParameter(name, *reinterpret_cast<const float4*>(v));
+                break;
+            case MAT3:
+                instance->setParameter(name, *reinterpret_cast<const mat3f*>(v));
+                break;
+            case MAT4:
+                instance->setParameter(name, *reinterpret_cast<const mat4f*>(v));
+                break;
+        }
+    }
+    env->ReleaseStringUTFChars(name_, name);
+    return 0;
+}
+
 // defined in TextureSampler.cpp
 namespace filament::JniUtils {
     TextureSampler from_long(jlong params) noexcept;
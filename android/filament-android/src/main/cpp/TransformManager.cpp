@@ -23,6 +23,8 @@
 
 #include <math/mat4.h>
 
+#include "common/NioUtils.h"
+
 using namespace utils;
 using namespace filament;
 
@@ -152,6 +154,29 @@ Java_com_google_android_filament_TransformManager_nSetTransformFp64(JNIEnv* env,
     env->ReleaseDoubleArrayElements(localTransform_, localTransform, JNI_ABORT);
 }
 
+extern "C" JNIEXPORT jint JNICALL
+Java_com_google_android_filament_TransformManager_nSetTransforms(JNIEnv* env,
+        jclass, jlong nativeTransformManager, jobject buffer, jint remaining, jint count) {
+    TransformManager* tm = (TransformManager*) nativeTransformManager;
+    // Each packed record is an instance index followed by a column-major mat4f, so a whole
+    // batch of animation transforms crosses JNI once.
+    constexpr jint RECORD_WORDS = 1 + 16;
+    AutoBuffer nioBuffer(env, buffer, count * RECORD_WORDS);
+    size_t sizeInBytes = nioBuffer.getSize();
+    if (sizeInBytes > (remaining << nioBuffer.getShift())) {
+        // BufferOverflowException
+        return -1;
+    }
+    jint const* record = static_cast<jint const*>(nioBuffer.getData());
+    tm->openLocalTransformTransaction();
+    for (jint j = 0; j < count; j++, record += RECORD_WORDS) {
+        tm->setTransform((TransformManager::Instance) record[0],
+                *reinterpret_cast<const filament::math::mat4f*>(record + 1));
+    }
+    tm->commitLocalTransformTransaction();
+    return 0;
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_google_android_filament_TransformManager_nGetTransform(JNIEnv* env,
         jclass, jlong nativeTransformManager, jint i,
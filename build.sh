@@ -46,6 +46,9 @@ function print_help {
     echo "        Exclude Vulkan support from the Android build."
     echo "    -W"
     echo "        Include WebGPU support for the target platform. (NOT functional atm)."
+    echo "    -T"
+    echo "        Enable wasm threads and SIMD for the WebGL build."
+    echo "        JobSystem workers run on pthread-backed web workers; requires COOP/COEP headers."
     echo "    -s"
     echo "        Add iOS simulator support to the iOS build."
     echo "    -e"
@@ -200,6 +203,8 @@ VULKAN_ANDROID_GRADLE_OPTION=""
 WEBGPU_OPTION="-DFILAMENT_SUPPORTS_WEBGPU=OFF"
 WEBGPU_ANDROID_GRADLE_OPTION=""
 
+WEBGL_THREADS_OPTION=""
+
 EGL_ON_LINUX_OPTION="-DFILAMENT_SUPPORTS_EGL_ON_LINUX=OFF"
 
 MATDBG_OPTION="-DFILAMENT_ENABLE_MATDBG=OFF"
@@ -341,6 +346,7 @@ function build_webgl_with_target {
             -DCMAKE_BUILD_TYPE="$1" \
             -DCMAKE_INSTALL_PREFIX="../webgl-${lc_target}/filament" \
             -DWEBGL=1 \
+            ${WEBGL_THREADS_OPTION} \
             ${WEBGPU_OPTION} \
             ${BACKEND_DEBUG_FLAG_OPTION} \
             ../..
@@ -840,7 +846,7 @@ function check_debug_release_build {
 
 pushd "$(dirname "$0")" > /dev/null
 
-while getopts ":hacCfgimp:q:uvWslwedtk:bVx:S:X:" opt; do
+while getopts ":hacCfgimp:q:uvWslwedtk:bVx:S:X:T" opt; do
     case ${opt} in
         h)
             print_help
@@ -965,6 +971,10 @@ while getopts ":hacCfgimp:q:uvWslwedtk:bVx:S:X:" opt; do
             WEBGPU_ANDROID_GRADLE_OPTION="-Pcom.google.android.filament.include-webgpu"
             echo "Enable support for WebGPU(Experimental) in the core Filament library."
             ;;
+        T)
+            WEBGL_THREADS_OPTION="-DWEBGL_PTHREADS=ON -DWEBGL_SIMD=ON"
+            echo "Enabling wasm threads and SIMD for the WebGL build."
+            ;;
         s)
             IOS_BUILD_SIMULATOR=true
             echo "iOS simulator support enabled."
@@ -18,6 +18,8 @@
 #define TNT_FILAMENT_BACKEND_COMMANDSTREAMVECTOR_H
 
 #include <backend/DriverApiForward.h>
+#include <backend/DriverEnums.h>
+#include <backend/Handle.h>
 
 #include <initializer_list>
 #include <memory>
@@ -100,10 +102,97 @@ private:
     value_type *mOffsets = nullptr;
 };
 
+/**
+ * One descriptor-set bind within a DescriptorSetBindingArray.
+ */
+struct DescriptorSetBinding {
+    DescriptorSetHandle dsh;
+    descriptor_set_t set = 0;
+    DescriptorSetOffsetArray offsets;
+};
+
+/**
+ * An array of descriptor-set binds allocated from the CommandStream's arena, so that several
+ * sets can be bound with a single command (see DriverApi::bindDescriptorSets), amortizing the
+ * command decode and dispatch cost.
+ */
+class DescriptorSetBindingArray {
+public:
+    using value_type = DescriptorSetBinding;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using size_type = uint32_t;
+    using difference_type = int32_t;
+    using pointer = value_type*;
+    using const_pointer = value_type const*;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+
+    DescriptorSetBindingArray() noexcept = default;
+
+    ~DescriptorSetBindingArray() noexcept = default;
+
+    DescriptorSetBindingArray(size_type size, DriverApi& driver) noexcept
+            : mSize(size) {
+        mBindings = (value_type *)allocateFromCommandStream(driver,
+                size * sizeof(value_type), alignof(value_type));
+        std::uninitialized_default_construct_n(mBindings, size);
+    }
+
+    DescriptorSetBindingArray(DescriptorSetBindingArray const&) = delete;
+    DescriptorSetBindingArray& operator=(DescriptorSetBindingArray const&) = delete;
+
+    DescriptorSetBindingArray(DescriptorSetBindingArray&& rhs) noexcept
+            : mBindings(rhs.mBindings), mSize(rhs.mSize) {
+        rhs.mBindings = nullptr;
+        rhs.mSize = 0;
+    }
+
+    DescriptorSetBindingArray& operator=(DescriptorSetBindingArray&& rhs) noexcept {
+        if (this != &rhs) {
+            mBindings = rhs.mBindings;
+            mSize = rhs.mSize;
+            rhs.mBindings = nullptr;
+            rhs.mSize = 0;
+        }
+        return *this;
+    }
+
+    bool empty() const noexcept { return mSize == 0; }
+
+    size_type size() const noexcept { return mSize; }
+
+    value_type* data() noexcept { return mBindings; }
+    const value_type* data() const noexcept { return mBindings; }
+
+    iterator begin() noexcept { return mBindings; }
+    iterator end() noexcept { return mBindings + mSize; }
+    const_iterator begin() const noexcept { return mBindings; }
+    const_iterator end() const noexcept { return mBindings + mSize; }
+
+    reference operator[](size_type n) noexcept {
+        return *(data() + n);
+    }
+
+    const_reference operator[](size_type n) const noexcept {
+        return *(data() + n);
+    }
+
+    void clear() noexcept {
+        mBindings = nullptr;
+        mSize = 0;
+    }
+
+private:
+    value_type *mBindings = nullptr;
+    size_type mSize = 0;
+};
+
 } // namespace filament::backend
 
 #if !defined(NDEBUG)
 utils::io::ostream& operator<<(utils::io::ostream& out, const filament::backend::DescriptorSetOffsetArray& rhs);
+utils::io::ostream& operator<<(utils::io::ostream& out, const filament::backend::DescriptorSetBindingArray& rhs);
 #endif
 
 #endif //TNT_FILAMENT_BACKEND_COMMANDSTREAMVECTOR_H
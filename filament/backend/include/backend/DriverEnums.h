@@ -101,6 +101,14 @@ static constexpr uint64_t SWAP_CHAIN_HAS_STENCIL_BUFFER         = SWAP_CHAIN_CON
  */
 static constexpr uint64_t SWAP_CHAIN_CONFIG_PROTECTED_CONTENT   = 0x40;
 
+/**
+ * Requests the lowest achievable present latency, trading throughput (and possibly tearing)
+ * for it. Best effort: maps to a MAILBOX present mode with the minimum image count on Vulkan,
+ * a reduced drawable count on Metal, and a swap interval of zero on EGL. Ignored where the
+ * platform offers no such control.
+ */
+static constexpr uint64_t SWAP_CHAIN_CONFIG_LOW_LATENCY         = 0x80;
+
 static constexpr size_t MAX_VERTEX_ATTRIBUTE_COUNT  = 16;   // This is guaranteed by OpenGL ES.
 static constexpr size_t MAX_SAMPLER_COUNT           = 62;   // Maximum needed at feature level 3.
 static constexpr size_t MAX_VERTEX_BUFFER_COUNT     = 16;   // Max number of bound buffer objects.
@@ -552,6 +560,7 @@ constexpr TargetBufferFlags getTargetBufferFlagsAt(size_t index) noexcept {
 enum class BufferUsage : uint8_t {
     STATIC,      //!< content modified once, used many times
     DYNAMIC,     //!< content modified frequently, used many times
+    SHARED,      //!< content modified frequently by the CPU, persistently mapped when supported
 };
 
 /**
@@ -1378,6 +1387,13 @@ enum class StreamType {
 //! Releases an ACQUIRED external texture, guaranteed to be called on the application thread.
 using StreamCallback = void(*)(void* image, void* user);
 
+//! Frame statistics for an ACQUIRED stream (see Stream::getStats())
+struct StreamStats {
+    uint64_t framesAcquired = 0;    //!< number of images handed to setAcquiredImage()
+    uint64_t framesSkipped = 0;     //!< number of images superseded by a newer one before being latched
+    int64_t latchLatencyNanos = 0;  //!< time between the last latched image's push and its latch
+};
+
 //! Vertex attribute descriptor
 struct Attribute {
     //! attribute is normalized (remapped between 0 and 1)
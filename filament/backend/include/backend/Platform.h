@@ -26,9 +26,11 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <memory>
 
 namespace filament::backend {
 
+class BlobCacheFile;
 class Driver;
 
 /**
@@ -146,6 +148,12 @@ public:
 
         size_t metalUploadBufferSizeBytes = 512 * 1024;
 
+        /**
+         * Size of the MTLHeap that sampleable textures are placed in. 0 disables heap
+         * placement; textures then get dedicated allocations.
+         */
+        size_t metalTextureHeapSizeBytes = 0;
+
         /**
          * Set to `true` to forcibly disable parallel shader compilation in the backend.
          * Currently only honored by the GL and Metal backends.
@@ -193,6 +201,14 @@ public:
          *      - PlatformEGL
          */
         GpuContextPriority gpuContextPriority = GpuContextPriority::DEFAULT;
+
+        /**
+         * Maximum amount of time, in microseconds, spent per tick finalizing asynchronous
+         * shader compilations. Programs becoming ready in the same frame are then spread over
+         * several frames instead of all linking serially in one. 0 means no budget (all ready
+         * programs are finalized right away). Currently only honored by the GL backend.
+         */
+        uint32_t shaderCompilerTickBudgetUs = 0;
     };
 
     Platform() noexcept;
@@ -322,6 +338,35 @@ public:
     size_t retrieveBlob(const void* UTILS_NONNULL key, size_t keySize,
             void* UTILS_NONNULL value, size_t valueSize);
 
+    /**
+     * Enables the backend-managed blob cache: a single memory-mapped, checksummed archive file
+     * that the backend maintains itself, instead of delegating individual key/value pairs to
+     * the application through setBlobFunc(). Insertions are batched and written back on a
+     * background thread; retrievals are served directly from the mapping, without copying.
+     *
+     * When a cache file is set it takes precedence over the setBlobFunc() callbacks, which are
+     * then only consulted for retrievals that miss the file.
+     *
+     * @param path  path of the cache file; it is created on first insertion if it doesn't exist
+     * @return      true if the file could be opened or created, false otherwise
+     */
+    bool setBlobCacheFile(const char* UTILS_NONNULL path) noexcept;
+
+    /**
+     * Retrieves the value associated with the given key directly from the memory-mapped cache
+     * file set with setBlobCacheFile(), without copying it. On a hit, *valueSize is set to the
+     * size of the value and a pointer to it is returned; the pointer remains valid until this
+     * Platform is destroyed. Returns nullptr on a miss, or if no cache file is set, in which
+     * case the caller should fall back to retrieveBlob().
+     *
+     * @param key          pointer to the beginning of the key
+     * @param keySize      specifies the size in bytes of the binary key pointed to by <key>
+     * @param valueSize    set to the size in bytes of the returned value on a hit
+     * @return             a pointer to the cached value, or nullptr
+     */
+    const void* UTILS_NULLABLE retrieveBlobMapped(const void* UTILS_NONNULL key, size_t keySize,
+            size_t* UTILS_NONNULL valueSize) noexcept;
+
     using DebugUpdateStatFunc = utils::Invocable<void(const char* UTILS_NONNULL key, uint64_t value)>;
 
     /**
@@ -355,6 +400,7 @@ public:
 private:
     InsertBlobFunc mInsertBlob;
     RetrieveBlobFunc mRetrieveBlob;
+    std::unique_ptr<BlobCacheFile> mBlobCacheFile;
     DebugUpdateStatFunc mDebugUpdateStat;
 };
 
@@ -234,6 +234,17 @@ public:
      */
     virtual void commit(SwapChain* UTILS_NONNULL swapChain) noexcept = 0;
 
+    /**
+     * Hints that only `damage` (in surface coordinates) has changed since the previous commit()
+     * of this SwapChain. Only affects the next commit(). The default implementation ignores
+     * the hint, which is always correct.
+     * @param swapChain the SwapChain the damage applies to.
+     * @param damage    the region of the surface that has changed.
+     * @see commit()
+     */
+    virtual void setPresentationDamage(SwapChain* UTILS_NONNULL swapChain,
+            Viewport const& damage) noexcept;
+
     /**
      * Set the time the next committed buffer should be presented to the user at.
      *
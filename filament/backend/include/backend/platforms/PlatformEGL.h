@@ -117,6 +117,8 @@ protected:
 
     void commit(SwapChain* swapChain) noexcept override;
 
+    void setPresentationDamage(SwapChain* swapChain, Viewport const& damage) noexcept override;
+
     bool canCreateFence() noexcept override;
     Fence* createFence() noexcept override;
     void destroyFence(Fence* fence) noexcept override;
@@ -180,6 +182,7 @@ protected:
             bool KHR_no_config_context = false;
             bool KHR_surfaceless_context = false;
             bool EXT_protected_content = false;
+            bool KHR_swap_buffers_with_damage = false;
         } egl;
     } ext;
 
@@ -189,6 +192,8 @@ protected:
         EGLNativeWindowType nativeWindow{};
         EGLConfig config{};
         uint64_t flags{};
+        EGLint damage[4] = {};      // left, bottom, width, height, see setPresentationDamage()
+        bool hasDamage = false;     // whether `damage` applies to the next commit()
     };
 
     void initializeGlExtensions() noexcept;
@@ -59,6 +59,14 @@ public:
     // calling getBuffer();
     bool empty() const noexcept { return mTail == mHead; }
 
+    // Pointer to the next available command, i.e. what the next allocate() will return.
+    void* head() const noexcept { return mHead; }
+
+    // Incremented each time getBuffer() is called. Because getBuffer() can rebase mHead,
+    // a pointer previously returned by allocate() is only valid as long as the generation
+    // hasn't changed.
+    uint32_t getGeneration() const noexcept { return mGeneration; }
+
     // Returns the size used since the last call to getBuffer()
     size_t getUsed() const noexcept { return intptr_t(mHead) - intptr_t(mTail); }
 
@@ -88,6 +96,9 @@ private:
     // pointer to the next available command
     void* mHead = nullptr;
 
+    // see getGeneration()
+    uint32_t mGeneration = 0;
+
     // system page size
     static size_t sPageSize;
 };
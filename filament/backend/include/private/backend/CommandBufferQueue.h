@@ -49,6 +49,7 @@ class CommandBufferQueue {
     mutable std::vector<Range> mCommandBuffersToExecute;
     size_t mFreeSpace = 0;
     size_t mHighWatermark = 0;
+    size_t mStallTime = 0;  // total time flush() waited for free space, in microseconds
     uint32_t mExitRequested = 0;
     bool mPaused = false;
 
@@ -66,6 +67,10 @@ public:
 
     size_t getHighWatermark() const noexcept { return mHighWatermark; }
 
+    // total time flush() spent waiting for the driver thread, in microseconds. Only updated
+    // from the producer thread, like flush().
+    size_t getStallTime() const noexcept { return mStallTime; }
+
     // wait for commands to be available and returns an array containing these commands
     std::vector<Range> waitForCommands() const;
 
@@ -18,6 +18,7 @@
 #define TNT_FILAMENT_BACKEND_PRIVATE_COMMANDSTREAM_H
 
 #include "private/backend/CircularBuffer.h"
+#include "private/backend/CommandStreamCapture.h"
 #include "private/backend/Dispatcher.h"
 #include "private/backend/Driver.h"
 
@@ -38,6 +39,7 @@
 
 #include <cstddef>
 #include <functional>
+#include <memory>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -221,6 +223,13 @@ public:
     inline void methodName(paramsDecl) {                                                        \
         DEBUG_COMMAND_BEGIN(methodName, false, params);                                         \
         using Cmd = COMMAND_TYPE(methodName);                                                   \
+        if (UTILS_UNLIKELY(CommandStream::filter<Cmd>(params))) {                               \
+            DEBUG_COMMAND_END(methodName, false);                                               \
+            return;                                                                             \
+        }                                                                                       \
+        if (UTILS_UNLIKELY(mCapture)) {                                                         \
+            mCapture->record(CaptureCommand::methodName, params);                               \
+        }                                                                                       \
         void* const p = allocateCommand(CommandBase::align(sizeof(Cmd)));                       \
         new(p) Cmd(mDispatcher.methodName##_, APPLY(std::move, params));                        \
         DEBUG_COMMAND_END(methodName, false);                                                   \
@@ -239,6 +248,9 @@ public:
     inline RetType methodName(paramsDecl) {                                                     \
         DEBUG_COMMAND_BEGIN(methodName, false, params);                                         \
         RetType result = mDriver.methodName##S();                                               \
+        if (UTILS_UNLIKELY(mCapture)) {                                                         \
+            mCapture->recordR(CaptureCommand::methodName, result.getId(), params);              \
+        }                                                                                       \
         using Cmd = COMMAND_TYPE(methodName##R);                                                \
         void* const p = allocateCommand(CommandBase::align(sizeof(Cmd)));                       \
         new(p) Cmd(mDispatcher.methodName##_, RetType(result), APPLY(std::move, params));       \
@@ -248,6 +260,72 @@ public:
 
 #include "DriverAPI.inc"
 
+public:
+    /*
+     * When enabled (the default), a small peephole filter runs as commands are recorded:
+     * a scissor command that sets the current scissor state again is dropped, and an
+     * updateBufferObject() immediately superseded by another update of the same range of the
+     * same buffer is turned into a no-op. This reduces the number of commands dispatched on
+     * the driver thread. Commands are never reordered.
+     */
+    void setPeepholeFilterEnabled(bool const enabled) noexcept {
+        mPeephole.enabled = enabled;
+        mPeephole.scissorValid = false;
+        mPeephole.lastBufferUpdate.command = nullptr;
+    }
+
+    /*
+     * Captures the decoded command stream to a file for later replay with
+     * CommandStreamReplayer (see CommandStreamCapture). The capture object must outlive the
+     * capture; pass nullptr to stop capturing. Also enabled automatically when the
+     * FILAMENT_COMMAND_CAPTURE environment variable (or the "debug.filament.capture" system
+     * property on Android) holds a writable path.
+     */
+    void setCapture(CommandStreamCapture* capture) noexcept {
+        mCapture = (capture && capture->isOpen()) ? capture : nullptr;
+    }
+
+private:
+    /*
+     * The peephole filter above runs here, on the producer side, where commands still have a
+     * type -- by the time the stream reaches the driver thread it has been erased to a list
+     * of execute() pointers and can't be inspected anymore. Returns true if the command is
+     * redundant and should not be recorded.
+     */
+    template<typename CMD, typename... ARGS>
+    inline bool filter(ARGS&... args) noexcept {
+        if constexpr (std::is_same_v<CMD, COMMAND_TYPE(scissor)>) {
+            return filterScissor(args...);
+        } else if constexpr (std::is_same_v<CMD, COMMAND_TYPE(updateBufferObject)>) {
+            return filterBufferUpdate(args...);
+        } else if constexpr (std::is_same_v<CMD, COMMAND_TYPE(beginRenderPass)>
+                          || std::is_same_v<CMD, COMMAND_TYPE(endRenderPass)>) {
+            // render pass boundaries can reset the backend's scissor state
+            mPeephole.scissorValid = false;
+        }
+        return false;
+    }
+
+    inline bool filterScissor(Viewport const& scissor) noexcept;
+
+    inline bool filterBufferUpdate(BufferObjectHandle boh,
+            BufferDescriptor const& data, uint32_t byteOffset) noexcept;
+
+    struct {
+        // shadow of the last scissor state recorded, when scissorValid is true
+        Viewport scissor{};
+        bool scissorValid = false;
+        bool enabled = true;
+        struct {
+            void* command = nullptr;    // address of the last updateBufferObject recorded
+            uint32_t generation = 0;    // CircularBuffer generation command belongs to
+            uint32_t byteOffset = 0;
+            size_t size = 0;
+            BufferObjectHandle handle;
+            bool cancelable = false;    // its descriptor doesn't use a custom CallbackHandler
+        } lastBufferUpdate;
+    } mPeephole;
+
 public:
     // This is for debugging only. Currently, CircularBuffer can only be written from a
     // single thread. In debug builds we assert this condition.
@@ -292,6 +370,8 @@ private:
     Driver& UTILS_RESTRICT mDriver;
     CircularBuffer& UTILS_RESTRICT mCurrentBuffer;
     Dispatcher mDispatcher;
+    CommandStreamCapture* mCapture = nullptr;
+    std::unique_ptr<CommandStreamCapture> mOwnedCapture; // when enabled via env/property
 
 #ifndef NDEBUG
     // just for debugging...
@@ -301,6 +381,52 @@ private:
     bool mUsePerformanceCounter = false;
 };
 
+bool CommandStream::filterScissor(Viewport const& scissor) noexcept {
+    if (UTILS_LIKELY(mPeephole.enabled)) {
+        if (mPeephole.scissorValid && scissor == mPeephole.scissor) {
+            // the scissor state is unchanged, don't record the command
+            return true;
+        }
+        mPeephole.scissor = scissor;
+        mPeephole.scissorValid = true;
+    }
+    return false;
+}
+
+bool CommandStream::filterBufferUpdate(BufferObjectHandle const boh,
+        BufferDescriptor const& data, uint32_t const byteOffset) noexcept {
+    if (UTILS_LIKELY(mPeephole.enabled)) {
+        using Cmd = COMMAND_TYPE(updateBufferObject);
+        auto& last = mPeephole.lastBufferUpdate;
+        char* const head = static_cast<char*>(mCurrentBuffer.head());
+        uint32_t const generation = mCurrentBuffer.getGeneration();
+        // the previous update is adjacent iff it's in the current (unflushed) generation and
+        // nothing was allocated after it -- i.e. it ends exactly at the current head
+        if (last.command && last.cancelable
+                && last.generation == generation
+                && static_cast<char*>(last.command) + CommandBase::align(sizeof(Cmd)) == head
+                && last.handle == boh && last.byteOffset == byteOffset
+                && last.size == data.size) {
+            // The previous command updates the same range of the same buffer and is superseded
+            // by this one before the driver could see it; turn it into a no-op in place. Its
+            // BufferDescriptor is released right here, on the main filament thread, which is
+            // where its callback is specified to run.
+            static_assert(sizeof(NoopCommand) <= sizeof(Cmd));
+            Cmd* const cmd = static_cast<Cmd*>(last.command);
+            cmd->~Cmd();
+            new(cmd) NoopCommand(static_cast<char*>(last.command) + CommandBase::align(sizeof(Cmd)));
+        }
+        // this command is recorded at the current head (see allocateCommand())
+        last.command = head;
+        last.generation = generation;
+        last.byteOffset = byteOffset;
+        last.size = data.size;
+        last.handle = boh;
+        last.cancelable = data.getHandler() == nullptr;
+    }
+    return false;
+}
+
 void* CommandStream::allocate(size_t size, size_t alignment) noexcept {
     // make sure alignment is a power of two
     assert_invariant(alignment && !(alignment & alignment-1));
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_BACKEND_PRIVATE_COMMANDSTREAMCAPTURE_H
+#define TNT_FILAMENT_BACKEND_PRIVATE_COMMANDSTREAMCAPTURE_H
+
+#include <backend/BufferDescriptor.h>
+#include <backend/BufferObjectStreamDescriptor.h>
+#include <backend/DescriptorSetOffsetArray.h>
+#include <backend/DriverEnums.h>
+#include <backend/Handle.h>
+#include <backend/PipelineState.h>
+#include <backend/PixelBufferDescriptor.h>
+#include <backend/Platform.h>
+#include <backend/Program.h>
+#include <backend/TargetBufferInfo.h>
+
+#include <utils/CString.h>
+#include <utils/Invocable.h>
+#include <utils/compiler.h>
+
+#include <tsl/robin_map.h>
+
+#include <tuple>
+#include <type_traits>
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace filament::backend {
+
+/*
+ * Identifies a command in a capture file. Generated from DriverAPI.inc so it stays in sync
+ * with the driver API. Ids and payload layouts are positional; CommandStreamCapture::VERSION
+ * below must be bumped whenever DriverAPI.inc changes.
+ */
+enum class CaptureCommand : uint16_t {
+#define DECL_DRIVER_API(methodName, paramsDecl, params) methodName,
+#define DECL_DRIVER_API_SYNCHRONOUS(RetType, methodName, paramsDecl, params)
+#define DECL_DRIVER_API_RETURN(RetType, methodName, paramsDecl, params) methodName,
+#include "private/backend/DriverAPI.inc"
+};
+
+/*
+ * Records the decoded command stream to a file, so it can be fed back to any backend with
+ * CommandStreamReplayer -- typically in a loop, to measure driver-thread execution overhead
+ * with production frames (see tools/cmdreplay). CommandStream calls record() / recordR() as
+ * commands are recorded, i.e. after the peephole filter, so the capture matches what the
+ * driver thread actually executes. Synchronous driver calls and queueCommand() closures are
+ * not part of the command buffer and are not captured.
+ *
+ * Capture can be enabled without code changes by pointing the FILAMENT_COMMAND_CAPTURE
+ * environment variable (or the "debug.filament.capture" system property on Android) at a
+ * writable path before the engine is created; capture then covers the engine's entire life,
+ * which guarantees that every handle referenced by the stream is also created by it.
+ *
+ * The format stores trivially-copyable parameters as raw bytes and is therefore not portable
+ * across ABIs: replay on the same architecture that captured. Callbacks and external
+ * images/streams cannot be serialized; the replayer substitutes inert equivalents for them.
+ */
+class CommandStreamCapture {
+public:
+    static constexpr uint32_t MAGIC = 0x50414346u;  // 'FCAP'
+    static constexpr uint32_t VERSION = 1;
+
+    CommandStreamCapture() noexcept = default;
+    ~CommandStreamCapture() noexcept;
+
+    CommandStreamCapture(CommandStreamCapture const&) = delete;
+    CommandStreamCapture& operator=(CommandStreamCapture const&) = delete;
+
+    // starts capturing to the given file, returns false if the file can't be created
+    bool open(const char* path) noexcept;
+    bool isOpen() const noexcept { return mFile != nullptr; }
+    void close() noexcept;
+
+    /*
+     * The stateful cases below are selected on the decayed parameter types rather than by
+     * overloading, because a non-template overload taking a specific Handle type would drag
+     * Handle's converting constructor into overload resolution for every other handle.
+     *
+     * A DescriptorSetOffsetArray doesn't carry its size -- it's implied by the set's layout --
+     * so we track the dynamic-offset count of each layout and set as they are created, and
+     * write an explicit count with each bind.
+     */
+    template<typename... ARGS>
+    inline void record(CaptureCommand id, ARGS const&... args) noexcept {
+        putHeader(id);
+        using Tuple = std::tuple<std::decay_t<ARGS>...>;
+        if constexpr (std::is_same_v<Tuple,
+                std::tuple<DescriptorSetHandle, descriptor_set_t, DescriptorSetOffsetArray>>) {
+            putBindDescriptorSet(args...);
+        } else if constexpr (std::is_same_v<Tuple, std::tuple<DescriptorSetBindingArray>>) {
+            putBindDescriptorSets(args...);
+        } else {
+            (put(args), ...);
+        }
+    }
+
+    template<typename... ARGS>
+    inline void recordR(CaptureCommand id, uint32_t resultId, ARGS const&... args) noexcept {
+        putHeader(id);
+        putBytes(&resultId, sizeof(resultId));
+        using Tuple = std::tuple<std::decay_t<ARGS>...>;
+        if constexpr (std::is_same_v<Tuple, std::tuple<DescriptorSetLayout>>) {
+            trackDescriptorSetLayout(resultId, args...);
+        } else if constexpr (std::is_same_v<Tuple, std::tuple<DescriptorSetLayoutHandle>>) {
+            trackDescriptorSet(resultId, args...);
+        }
+        (put(args), ...);
+    }
+
+private:
+    void putHeader(CaptureCommand id) noexcept {
+        uint16_t const v = uint16_t(id);
+        putBytes(&v, sizeof(v));
+    }
+
+    void putBytes(void const* data, size_t size) noexcept;
+
+    // trivially-copyable parameters (PODs, enums) are stored as raw bytes; raw pointer
+    // values are stored too, but only as opaque placeholders
+    template<typename T>
+    inline std::enable_if_t<std::is_trivially_copyable_v<T>> put(T const& v) noexcept {
+        putBytes(&v, sizeof(T));
+    }
+
+    // handles are stored as their id (they're not trivially copyable because of the
+    // nulling move constructor)
+    template<typename T>
+    inline void put(Handle<T> const& h) noexcept {
+        uint32_t const id = h.getId();
+        putBytes(&id, sizeof(id));
+    }
+
+    void put(const char* s) noexcept;                           // length-prefixed
+    void put(utils::CString const& s) noexcept;
+    void put(TargetBufferInfo const& info) noexcept;            // these three carry handles
+    void put(MRT const& mrt) noexcept;
+    void put(PipelineState const& state) noexcept;
+    void put(BufferDescriptor const& b) noexcept;
+    void put(PixelBufferDescriptor const& p) noexcept;
+    void put(Program const& p) noexcept;
+    void put(DescriptorSetLayout const& l) noexcept;
+    void put(BufferObjectStreamDescriptor const& d) noexcept;
+    void put(Platform::ExternalImageHandleRef) noexcept {}      // not serializable
+    void put(FrameScheduledCallback const&) noexcept {}         // callbacks are not captured
+    void put(utils::Invocable<void(void)> const&) noexcept {}
+
+    void putOffsets(DescriptorSetHandle dsh, DescriptorSetOffsetArray const& offsets) noexcept;
+
+    // stateful special cases, see record() / recordR() above
+    void putBindDescriptorSet(DescriptorSetHandle const& dsh, descriptor_set_t const& set,
+            DescriptorSetOffsetArray const& offsets) noexcept;
+    void putBindDescriptorSets(DescriptorSetBindingArray const& bindings) noexcept;
+    void trackDescriptorSetLayout(uint32_t resultId, DescriptorSetLayout const& info) noexcept;
+    void trackDescriptorSet(uint32_t resultId, DescriptorSetLayoutHandle const& dslh) noexcept;
+
+    FILE* mFile = nullptr;
+    // dynamic-offset counts, see recordR() above
+    tsl::robin_map<uint32_t, uint32_t> mLayoutDynamicCount;
+    tsl::robin_map<uint32_t, uint32_t> mSetDynamicCount;
+};
+
+} // namespace filament::backend
+
+#endif // TNT_FILAMENT_BACKEND_PRIVATE_COMMANDSTREAMCAPTURE_H
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_BACKEND_PRIVATE_COMMANDSTREAMREPLAYER_H
+#define TNT_FILAMENT_BACKEND_PRIVATE_COMMANDSTREAMREPLAYER_H
+
+#include "backend/DriverApiForward.h"
+
+#include <utils/CString.h>
+#include <utils/Invocable.h>
+
+#include <tsl/robin_map.h>
+
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament::backend {
+
+/*
+ * Feeds a file written by CommandStreamCapture back into a DriverApi, typically in a loop, to
+ * measure driver-thread execution overhead with production frames (see tools/cmdreplay). The
+ * stream can be replayed against any backend, with the caveat that shader binaries are captured
+ * in the source backend's language -- replaying against a different backend requires a capture
+ * taken with that backend selected.
+ *
+ * Handles are remapped as the stream is replayed: each create command maps the captured handle
+ * id to the handle returned by the target driver. A capture spanning the engine's whole life
+ * (see CommandStreamCapture) is therefore self-contained and can be replayed repeatedly with
+ * the same replayer. Commands that reference objects the stream cannot recreate are
+ * substituted: swap chains are created headless (see setHeadlessSwapChainSize()), external
+ * image textures become plain textures of the same size and format, and commands carrying
+ * callbacks or stream associations are decoded but not executed.
+ */
+class CommandStreamReplayer {
+public:
+    CommandStreamReplayer() noexcept = default;
+    ~CommandStreamReplayer() noexcept = default;
+
+    CommandStreamReplayer(CommandStreamReplayer const&) = delete;
+    CommandStreamReplayer& operator=(CommandStreamReplayer const&) = delete;
+
+    // loads a capture file in memory, returns false on I/O error or format mismatch
+    bool open(const char* path) noexcept;
+    void close() noexcept;
+
+    // dimensions used when substituting a headless swap chain for a captured window one
+    void setHeadlessSwapChainSize(uint32_t width, uint32_t height) noexcept {
+        mSwapChainWidth = width;
+        mSwapChainHeight = height;
+    }
+
+    // Replays the whole stream once and returns the number of commands decoded. The commands
+    // are recorded into `driver`; `flush` is invoked after each captured endFrame and at
+    // least every few thousand commands, and must flush and execute the driver's command
+    // buffer -- without it a whole-life capture would overflow the CircularBuffer.
+    size_t replay(DriverApi& driver, utils::Invocable<void()> const& flush = {});
+
+    // number of handle references that couldn't be resolved during replay() so far, i.e.
+    // objects created before the capture started (always 0 for whole-life captures)
+    size_t getUnresolvedHandleCount() const noexcept { return mUnresolvedHandles; }
+
+private:
+    friend class CaptureReader;
+
+    bool replayOne(class CaptureReader& reader, DriverApi& driver, uint16_t& outId);
+
+    std::vector<uint8_t> mData;
+
+    // captured handle id -> handle id on the target driver
+    tsl::robin_map<uint32_t, uint32_t> mHandleMap;
+    // backing store for group/event marker strings, which drivers take by pointer
+    std::vector<utils::CString> mStrings;
+    size_t mUnresolvedHandles = 0;
+    uint32_t mSwapChainWidth = 1920;
+    uint32_t mSwapChainHeight = 1080;
+};
+
+} // namespace filament::backend
+
+#endif // TNT_FILAMENT_BACKEND_PRIVATE_COMMANDSTREAMREPLAYER_H
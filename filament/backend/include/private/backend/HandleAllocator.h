@@ -325,16 +325,18 @@ private:
         }
     };
 
-// FIXME: We should be using a Spinlock here, at least on platforms where mutexes are not
-//        efficient (i.e. non-Linux). However, we've seen some hangs on that spinlock, which
-//        we don't understand well (b/308029108).
+// The arena itself is not synchronized: it is only accessed from the magazine refill/flush
+// paths below, with mArenaLock held, which happens on average once per MAGAZINE_SIZE/2
+// handle operations.
+// (a Spinlock would be tempting for mArenaLock on non-Linux platforms, but we've seen hangs
+//  on such a spinlock that we don't understand well, see b/308029108)
 #ifndef NDEBUG
     using HandleArena = utils::Arena<Allocator,
-            utils::LockingPolicy::Mutex,
+            utils::LockingPolicy::NoLock,
             utils::TrackingPolicy::DebugAndHighWatermark>;
 #else
     using HandleArena = utils::Arena<Allocator,
-            utils::LockingPolicy::Mutex>;
+            utils::LockingPolicy::NoLock>;
 #endif
 
     // allocateHandle()/deallocateHandle() selects the pool to use at compile-time based on the
@@ -359,7 +361,7 @@ private:
     UTILS_NOINLINE
     HandleBase::HandleId allocateHandleInPool() noexcept {
         uint8_t age;
-        void* p = mHandleArena.alloc(SIZE, alignof(std::max_align_t), 0, &age);
+        void* p = cacheAlloc(sizeClassIndex(SIZE), SIZE, &age);
         if (UTILS_LIKELY(p)) {
             uint32_t const tag = (uint32_t(age) << HANDLE_AGE_SHIFT) & HANDLE_AGE_MASK;
             return arenaPointerToHandle(p, tag);
@@ -373,12 +375,52 @@ private:
         if (UTILS_LIKELY(isPoolHandle(id))) {
             auto [p, tag] = handleToPointer(id);
             uint8_t const age = (tag & HANDLE_AGE_MASK) >> HANDLE_AGE_SHIFT;
-            mHandleArena.free(p, SIZE, age);
+            cacheFree(sizeClassIndex(SIZE), SIZE, p, age);
         } else {
             deallocateHandleSlow(id, SIZE);
         }
     }
 
+    /*
+     * Sharded caches ("magazines") sitting in front of the arena. Threads are assigned to
+     * shards round-robin, so concurrent producers (e.g. an asset-loading thread and the main
+     * thread) use different locks in the common case, and the shared arena lock is only
+     * taken when a magazine is refilled or flushed, i.e. once per MAGAZINE_SIZE/2 handle
+     * operations on average. Handle ids are not affected: the nodes still come from the same
+     * pools, so the handle<->pointer arithmetic is unchanged.
+     */
+    static constexpr size_t CACHE_SHARD_COUNT = 4;
+    static constexpr size_t MAGAZINE_SIZE = 32;
+
+    struct CacheShard {
+        utils::Mutex lock;
+        void* entries[3][MAGAZINE_SIZE] = {};
+        size_t count[3] = {};
+    };
+
+    // maps an allocation size to a size class (i.e. pool) index
+    static constexpr size_t sizeClassIndex(size_t const size) noexcept {
+        return size <= P0 ? 0 : (size <= P1 ? 1 : 2);
+    }
+
+    // shard assigned to the calling thread
+    static size_t threadShardIndex() noexcept;
+
+    void* cacheAlloc(size_t sizeClass, size_t size, uint8_t* outAge) noexcept;
+    void cacheFree(size_t sizeClass, size_t size, void* p, uint8_t age) noexcept;
+
+    // takes mArenaLock, keeping track of how often we had to wait for it
+    void lockArena() noexcept;
+
+public:
+    // number of times a thread had to wait for the arena lock. Also emitted as a systrace
+    // counter each time it increases.
+    uint32_t getArenaLockContentionCount() const noexcept {
+        return mArenaContentionCount.load(std::memory_order_relaxed);
+    }
+
+private:
+
     // number if bits allotted to the handle's age (currently 4 max)
     static constexpr uint32_t HANDLE_AGE_BIT_COUNT = 4;
     // number if bits allotted to the handle's debug tag (HANDLE_AGE_BIT_COUNT max)
@@ -432,6 +474,9 @@ private:
     }
 
     HandleArena mHandleArena;
+    CacheShard mCacheShards[CACHE_SHARD_COUNT];
+    mutable utils::Mutex mArenaLock;
+    std::atomic<uint32_t> mArenaContentionCount{ 0 };
 
     // Below is only used when running out of space in the HandleArena
     mutable utils::Mutex mLock;
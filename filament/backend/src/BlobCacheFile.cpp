@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BlobCacheFile.h"
+
+#include <utils/CString.h>
+#include <utils/Hash.h>
+#include <utils/Logger.h>
+#include <utils/compiler.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(WIN32) && !defined(__EMSCRIPTEN__)
+#include <sys/mman.h>
+#define HAS_MMAP 1
+#else
+#define HAS_MMAP 0
+#endif
+
+using namespace utils;
+
+namespace filament::backend {
+
+namespace {
+
+constexpr uint32_t MAGIC = 'F' | ('B' << 8u) | ('L' << 16u) | ('B' << 24u);
+constexpr uint32_t VERSION = 1;
+
+// Archive layout: a Header followed by entryCount records, each a RecordHeader followed by the
+// key bytes and the value bytes, both padded to an 8-byte boundary so that values are always
+// 8-byte aligned within the file (and therefore within the mapping).
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t payloadSize;       // size in bytes of everything following this header
+    uint32_t payloadChecksum;   // hash of the payload bytes
+    uint32_t reserved;
+};
+
+struct RecordHeader {
+    uint32_t keySize;
+    uint32_t valueSize;
+};
+
+constexpr size_t align8(size_t const size) noexcept {
+    return (size + 7u) & ~size_t(7u);
+}
+
+constexpr size_t recordSize(size_t const keySize, size_t const valueSize) noexcept {
+    return sizeof(RecordHeader) + align8(keySize) + align8(valueSize);
+}
+
+uint32_t hashKey(void const* key, size_t const keySize) noexcept {
+    return hash::murmurSlow(static_cast<uint8_t const*>(key), keySize, 42);
+}
+
+} // anonymous namespace
+
+UTILS_NOINLINE
+std::unique_ptr<BlobCacheFile> BlobCacheFile::open(const char* path) {
+    // make sure we'll be able to write the archive back; this also creates an empty file if
+    // there was none, which load() below then harmlessly ignores.
+    FILE* const file = fopen(path, "ab");
+    if (UTILS_UNLIKELY(!file)) {
+        LOG(WARNING) << "Blob cache file " << path << " is not writable";
+        return nullptr;
+    }
+    fclose(file);
+
+    std::unique_ptr<BlobCacheFile> cache{ new BlobCacheFile(CString{ path }) };
+    cache->load();
+    return cache;
+}
+
+BlobCacheFile::BlobCacheFile(CString path) noexcept
+    : mPath(std::move(path)) {
+}
+
+BlobCacheFile::~BlobCacheFile() {
+    if (mWriterThread.joinable()) {
+        {
+            std::lock_guard const lock(mLock);
+            mExitRequested = true;
+        }
+        mCondition.notify_one();
+        mWriterThread.join();
+    }
+    if (mArchive) {
+#if HAS_MMAP
+        munmap(mArchive, mArchiveSize);
+#else
+        free(mArchive);
+#endif
+    }
+}
+
+void BlobCacheFile::load() noexcept {
+    FILE* const file = fopen(mPath.c_str(), "rb");
+    if (!file) {
+        return;
+    }
+    fseek(file, 0, SEEK_END);
+    long const fileSize = ftell(file);
+    if (fileSize < long(sizeof(Header))) {
+        // empty or truncated file, start from scratch
+        fclose(file);
+        return;
+    }
+
+#if HAS_MMAP
+    mArchive = mmap(nullptr, size_t(fileSize), PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    if (mArchive == MAP_FAILED) {
+        mArchive = nullptr;
+    }
+#else
+    mArchive = malloc(size_t(fileSize));
+    if (mArchive) {
+        fseek(file, 0, SEEK_SET);
+        if (fread(mArchive, 1, size_t(fileSize), file) != size_t(fileSize)) {
+            free(mArchive);
+            mArchive = nullptr;
+        }
+    }
+#endif
+    fclose(file);
+    if (UTILS_UNLIKELY(!mArchive)) {
+        return;
+    }
+    mArchiveSize = size_t(fileSize);
+
+    Header const& header = *static_cast<Header const*>(mArchive);
+    char const* const payload = static_cast<char const*>(mArchive) + sizeof(Header);
+    size_t const payloadSize = mArchiveSize - sizeof(Header);
+    if (UTILS_UNLIKELY(header.magic != MAGIC
+            || header.version != VERSION
+            || header.payloadSize != payloadSize
+            || header.payloadChecksum !=
+                    hash::murmurSlow(reinterpret_cast<uint8_t const*>(payload), payloadSize, 0))) {
+        // a mismatched or corrupt archive is not an error, we just lose the cache
+        LOG(WARNING) << "Blob cache file " << mPath.c_str() << " is corrupt or outdated, ignored";
+        return;
+    }
+
+    char const* p = payload;
+    char const* const end = payload + payloadSize;
+    for (uint32_t i = 0; i < header.entryCount; i++) {
+        if (UTILS_UNLIKELY(p + sizeof(RecordHeader) > end)) {
+            break;
+        }
+        RecordHeader const& record = *reinterpret_cast<RecordHeader const*>(p);
+        if (UTILS_UNLIKELY(p + recordSize(record.keySize, record.valueSize) > end)) {
+            break;
+        }
+        char const* const key = p + sizeof(RecordHeader);
+        char const* const value = key + align8(record.keySize);
+        mIndex[hashKey(key, record.keySize)] = { key, value, record.keySize, record.valueSize };
+        p += recordSize(record.keySize, record.valueSize);
+    }
+}
+
+void const* BlobCacheFile::retrieve(void const* key, size_t const keySize,
+        size_t* valueSize) const noexcept {
+    uint32_t const hash = hashKey(key, keySize);
+    std::lock_guard const lock(mLock);
+    auto const pos = mIndex.find(hash);
+    if (pos == mIndex.end()) {
+        return nullptr;
+    }
+    Entry const& entry = pos->second;
+    if (UTILS_UNLIKELY(entry.keySize != keySize || memcmp(entry.key, key, keySize) != 0)) {
+        // hash collision, treat as a miss
+        return nullptr;
+    }
+    *valueSize = entry.valueSize;
+    return entry.value;
+}
+
+void BlobCacheFile::insert(void const* key, size_t const keySize,
+        void const* value, size_t const valueSize) {
+    if (UTILS_UNLIKELY(keySize > UINT32_MAX || valueSize > UINT32_MAX)) {
+        return;
+    }
+
+    // serialize the record up-front, exactly as it will appear in the file; the index then
+    // points into this copy until (and after) it is written out.
+    Record record{ new char[recordSize(keySize, valueSize)]{} };
+    *reinterpret_cast<RecordHeader*>(record.get()) = { uint32_t(keySize), uint32_t(valueSize) };
+    char* const keyCopy = record.get() + sizeof(RecordHeader);
+    char* const valueCopy = keyCopy + align8(keySize);
+    memcpy(keyCopy, key, keySize);
+    memcpy(valueCopy, value, valueSize);
+
+    std::lock_guard const lock(mLock);
+    mIndex[hashKey(key, keySize)] = { keyCopy, valueCopy, uint32_t(keySize), uint32_t(valueSize) };
+    mPending.push_back(std::move(record));
+    if (!mWriterThread.joinable()) {
+        mWriterThread = std::thread(&BlobCacheFile::writerLoop, this);
+    }
+    mCondition.notify_one();
+}
+
+void BlobCacheFile::writerLoop() {
+    std::unique_lock lock(mLock);
+    while (true) {
+        mCondition.wait(lock, [this] { return mExitRequested || !mPending.empty(); });
+        if (mPending.empty()) {
+            break;
+        }
+        if (!mExitRequested) {
+            // let closely-spaced insertions (e.g. a burst of program links at startup)
+            // coalesce into a single write of the archive
+            mCondition.wait_for(lock, std::chrono::milliseconds(500),
+                    [this] { return mExitRequested; });
+        }
+
+        std::vector<Record> written = std::move(mPending);
+        mPending.clear();
+
+        // snapshot the live entries; their pointers are stable, so the file can be written
+        // without holding the lock
+        std::vector<Entry> entries;
+        entries.reserve(mIndex.size());
+        for (auto const& [hash, entry] : mIndex) {
+            entries.push_back(entry);
+        }
+
+        lock.unlock();
+        save(entries);
+        lock.lock();
+
+        mRetained.insert(mRetained.end(),
+                std::make_move_iterator(written.begin()), std::make_move_iterator(written.end()));
+
+        if (mExitRequested && mPending.empty()) {
+            break;
+        }
+    }
+}
+
+void BlobCacheFile::save(std::vector<Entry> const& entries) const noexcept {
+    std::vector<char> payload;
+    size_t payloadSize = 0;
+    for (Entry const& entry : entries) {
+        payloadSize += recordSize(entry.keySize, entry.valueSize);
+    }
+    payload.resize(payloadSize);
+
+    char* p = payload.data();
+    for (Entry const& entry : entries) {
+        *reinterpret_cast<RecordHeader*>(p) = { entry.keySize, entry.valueSize };
+        char* const key = p + sizeof(RecordHeader);
+        char* const value = key + align8(entry.keySize);
+        memset(key + entry.keySize, 0, align8(entry.keySize) - entry.keySize);
+        memset(value + entry.valueSize, 0, align8(entry.valueSize) - entry.valueSize);
+        memcpy(key, entry.key, entry.keySize);
+        memcpy(value, entry.value, entry.valueSize);
+        p += recordSize(entry.keySize, entry.valueSize);
+    }
+
+    Header const header{
+            MAGIC, VERSION,
+            uint32_t(entries.size()), uint32_t(payloadSize),
+            hash::murmurSlow(reinterpret_cast<uint8_t const*>(payload.data()), payloadSize, 0),
+            0 };
+
+    // write to a temporary file first, then rename it over the archive, so that a crash
+    // mid-write can't leave a torn file behind (it would fail the checksum anyway)
+    std::string const tmpPath = std::string{ mPath.c_str() } + ".tmp";
+    FILE* const file = fopen(tmpPath.c_str(), "wb");
+    if (UTILS_UNLIKELY(!file)) {
+        return;
+    }
+    bool ok = fwrite(&header, sizeof(Header), 1, file) == 1;
+    ok = ok && (payloadSize == 0 || fwrite(payload.data(), payloadSize, 1, file) == 1);
+    ok = fclose(file) == 0 && ok;
+    if (UTILS_UNLIKELY(!ok)) {
+        remove(tmpPath.c_str());
+        return;
+    }
+    if (UTILS_UNLIKELY(rename(tmpPath.c_str(), mPath.c_str()) != 0)) {
+        // some filesystems won't replace an existing file, try again after removing it
+        remove(mPath.c_str());
+        if (rename(tmpPath.c_str(), mPath.c_str()) != 0) {
+            remove(tmpPath.c_str());
+        }
+    }
+}
+
+} // namespace filament::backend
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_BACKEND_BLOBCACHEFILE_H
+#define TNT_FILAMENT_BACKEND_BLOBCACHEFILE_H
+
+#include <utils/CString.h>
+#include <utils/Condition.h>
+#include <utils/Mutex.h>
+
+#include <tsl/robin_map.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament::backend {
+
+/*
+ * A blob cache backed by a single, memory-mapped, checksummed archive file. This is the
+ * backend-managed alternative to Platform::setBlobFunc(): instead of handing each key/value
+ * pair to the application (which typically ends up as one small file and several syscalls per
+ * program), all blobs live in one file that is mapped once at startup.
+ *
+ * Retrievals are served directly from the mapping, without copying; the returned pointers
+ * remain valid for the lifetime of the BlobCacheFile. Insertions are copied immediately but
+ * written back lazily: a background thread coalesces pending insertions and atomically
+ * replaces the archive (write to a temporary file, then rename). A corrupt or truncated
+ * archive fails its checksum and is simply discarded.
+ */
+class BlobCacheFile {
+public:
+    // Opens the cache file at the given path, creating it if needed. Returns nullptr if the
+    // path is not writable. An unreadable or corrupt archive is discarded, not an error.
+    static std::unique_ptr<BlobCacheFile> open(const char* path);
+
+    ~BlobCacheFile();
+
+    BlobCacheFile(BlobCacheFile const&) = delete;
+    BlobCacheFile& operator=(BlobCacheFile const&) = delete;
+
+    // Returns a pointer to the value associated with the given key and sets *valueSize, or
+    // returns nullptr on a miss. No copy is made; the pointer remains valid until this
+    // BlobCacheFile is destroyed. Can be called from any thread.
+    void const* retrieve(void const* key, size_t keySize, size_t* valueSize) const noexcept;
+
+    // Schedules the given key/value pair for insertion. The data is copied before returning;
+    // the file itself is updated later, on the background writer thread, batched with other
+    // pending insertions. Can be called from any thread.
+    void insert(void const* key, size_t keySize, void const* value, size_t valueSize);
+
+private:
+    explicit BlobCacheFile(utils::CString path) noexcept;
+
+    // a view into either the mapped archive or a record inserted this session
+    struct Entry {
+        void const* key;
+        void const* value;
+        uint32_t keySize;
+        uint32_t valueSize;
+    };
+
+    using Record = std::unique_ptr<char[]>;
+
+    void load() noexcept;
+    void writerLoop();
+    void save(std::vector<Entry> const& entries) const noexcept;
+
+    utils::CString mPath;
+
+    // the archive as mapped (or read) at open time; entries point into it
+    void* mArchive = nullptr;
+    size_t mArchiveSize = 0;
+
+    mutable utils::Mutex mLock;
+    utils::Condition mCondition;
+    tsl::robin_map<uint32_t, Entry> mIndex;     // keyed by a hash of the key bytes
+    std::vector<Record> mPending;               // serialized records awaiting a write
+    std::vector<Record> mRetained;              // written records, still referenced by mIndex
+    std::thread mWriterThread;
+    bool mExitRequested = false;
+};
+
+} // namespace filament::backend
+
+#endif // TNT_FILAMENT_BACKEND_BLOBCACHEFILE_H
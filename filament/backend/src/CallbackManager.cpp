@@ -21,13 +21,19 @@
 namespace filament::backend {
 
 CallbackManager::CallbackManager(DriverBase& driver) noexcept
-    : mDriver(driver), mCallbacks(1) {
+    : mDriver(driver), mCurrent(&mSlots[0]) {
+    // all slots but the current one start out free
+    for (size_t i = 1; i < SLOT_COUNT; i++) {
+        mFreeSlots.push(&mSlots[i]);
+    }
 }
 
 CallbackManager::~CallbackManager() noexcept = default;
 
 void CallbackManager::terminate() noexcept {
-    for (auto&& item: mCallbacks) {
+    // free slots always have their func cleared, so scanning the whole pool only
+    // finds the in-flight callbacks
+    for (auto& item: mSlots) {
         if (item.func) {
             mDriver.scheduleCallback(
                     item.handler, item.user, item.func);
@@ -36,7 +42,7 @@ void CallbackManager::terminate() noexcept {
 }
 
 CallbackManager::Handle CallbackManager::get() const noexcept {
-    Container::const_iterator const curr = getCurrent();
+    Callback const* const curr = mCurrent.load(std::memory_order_acquire);
     curr->count.fetch_add(1);
     return curr;
 }
@@ -55,7 +61,7 @@ void CallbackManager::put(Handle& curr) noexcept {
 void CallbackManager::setCallback(
         CallbackHandler* handler, CallbackHandler::Callback func, void* user) {
     assert_invariant(func);
-    Container::iterator const curr = allocateNewSlot();
+    Callback* const curr = allocateNewSlot();
     curr->handler = handler;
     curr->func = func;
     curr->user = user;
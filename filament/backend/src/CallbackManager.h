@@ -20,11 +20,11 @@
 
 #include <backend/CallbackHandler.h>
 
-#include <utils/Mutex.h>
+#include <utils/MPMCQueue.h>
 
 #include <atomic>
-#include <mutex>
-#include <list>
+
+#include <stddef.h>
 
 namespace filament::backend {
 
@@ -37,6 +37,9 @@ class CallbackHandler;
  * are typically called from different threads.
  * The callback is specified with "setCallback", which atomically creates a new set of
  * conditions to be met.
+ *
+ * Conditions are tracked in a fixed pool of slots recycled through a lock-free queue, so
+ * get() and put() don't take a lock; these can be called thousands of times per frame.
  */
 class CallbackManager {
     struct Callback {
@@ -46,10 +49,12 @@ class CallbackManager {
         void* user = nullptr;
     };
 
-    using Container = std::list<Callback>;
+    // maximum number of in-flight callbacks; setCallback() blocks when the pool is
+    // exhausted, which acts as back-pressure on the producer.
+    static constexpr size_t SLOT_COUNT = 64;
 
 public:
-    using Handle = Container::const_iterator;
+    using Handle = Callback const*;
 
     explicit CallbackManager(DriverBase& driver) noexcept;
 
@@ -73,25 +78,24 @@ public:
     void setCallback(CallbackHandler* handler, CallbackHandler::Callback func, void* user);
 
 private:
-    Container::const_iterator getCurrent() const noexcept {
-        std::lock_guard const lock(mLock);
-        return --mCallbacks.end();
+    Callback* allocateNewSlot() noexcept {
+        // blocks if all slots are in flight
+        Callback* const next = mFreeSlots.pop();
+        return mCurrent.exchange(next, std::memory_order_acq_rel);
     }
 
-    Container::iterator allocateNewSlot() noexcept {
-        std::lock_guard const lock(mLock);
-        auto curr = --mCallbacks.end();
-        mCallbacks.emplace_back();
-        return curr;
-    }
-    void destroySlot(Container::const_iterator curr) noexcept {
-        std::lock_guard const lock(mLock);
-        mCallbacks.erase(curr);
+    void destroySlot(Callback const* curr) noexcept {
+        Callback* const slot = const_cast<Callback*>(curr);
+        slot->handler = nullptr;
+        slot->func = {};
+        slot->user = nullptr;
+        mFreeSlots.push(slot);
     }
 
     DriverBase& mDriver;
-    mutable utils::Mutex mLock;
-    Container mCallbacks;
+    Callback mSlots[SLOT_COUNT];
+    utils::MPMCQueue<Callback*, SLOT_COUNT> mFreeSlots;
+    std::atomic<Callback*> mCurrent;
 };
 
 } // namespace filament::backend
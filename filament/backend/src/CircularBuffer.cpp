@@ -186,6 +186,7 @@ CircularBuffer::Range CircularBuffer::getBuffer() noexcept {
         }
     }
     mTail = mHead;
+    mGeneration++;
 
     return range;
 }
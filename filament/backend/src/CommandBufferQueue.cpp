@@ -28,6 +28,7 @@
 #include <utils/ostream.h>
 
 #include <algorithm>
+#include <chrono>
 #include <mutex>
 #include <iterator>
 #include <utility>
@@ -135,10 +136,20 @@ void CommandBufferQueue::flush() {
                 "CommandStream is full, but since the rendering thread is paused, "
                 "the buffer cannot flush and we will deadlock. Instead, abort.";
 
+        auto const stallStart = std::chrono::steady_clock::now();
+
         mCondition.wait(lock, [this, requiredSize]() -> bool {
             // TODO: on macOS, we need to call pumpEvents from time to time
             return mFreeSpace >= requiredSize;
         });
+
+        // keep track of how long the producer was stalled waiting on the driver thread, this
+        // shows up as a counter track in perfetto next to the exec/queue sizes
+        auto const stallDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - stallStart).count();
+        mStallTime += size_t(stallDuration);
+        FILAMENT_TRACING_VALUE(FILAMENT_TRACING_CATEGORY_FILAMENT,
+                "CommandBufferQueue stall (us)", uint32_t(stallDuration));
     }
 }
 
@@ -156,8 +167,11 @@ std::vector<CommandBufferQueue::Range> CommandBufferQueue::waitForCommands() con
 void CommandBufferQueue::releaseBuffer(CommandBufferQueue::Range const& buffer) {
     size_t const used = std::distance(
             static_cast<char const*>(buffer.begin), static_cast<char const*>(buffer.end));
-    std::lock_guard const lock(mLock);
-    mFreeSpace += used;
+    {
+        std::lock_guard const lock(mLock);
+        mFreeSpace += used;
+    }
+    // notify after unlocking, so a stalled producer doesn't wake up only to block on mLock
     mCondition.notify_one();
 }
 
@@ -35,6 +35,8 @@
 #include <string>
 #include <utility>
 
+#include <stdlib.h>
+
 #ifdef __ANDROID__
 #include <sys/system_properties.h>
 #endif
@@ -80,6 +82,24 @@ CommandStream::CommandStream(Driver& driver, CircularBuffer& buffer) noexcept
     __system_property_get("debug.filament.perfcounters", property);
     mUsePerformanceCounter = bool(atoi(property));
 #endif
+
+    // capture the command stream without code changes, see setCapture()
+    const char* capturePath = getenv("FILAMENT_COMMAND_CAPTURE");
+#ifdef __ANDROID__
+    char capturePathProperty[PROP_VALUE_MAX];
+    if (!capturePath || !capturePath[0]) {
+        __system_property_get("debug.filament.capture", capturePathProperty);
+        capturePath = capturePathProperty;
+    }
+#endif
+    if (capturePath && capturePath[0]) {
+        mOwnedCapture = std::make_unique<CommandStreamCapture>();
+        if (mOwnedCapture->open(capturePath)) {
+            setCapture(mOwnedCapture.get());
+        } else {
+            mOwnedCapture.reset();
+        }
+    }
 }
 
 void CommandStream::execute(void* buffer) {
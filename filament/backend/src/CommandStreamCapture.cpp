@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "private/backend/CommandStreamCapture.h"
+
+#include <backend/DriverEnums.h>
+#include <backend/Program.h>
+
+#include <utils/Logger.h>
+
+#include <string.h>
+
+namespace filament::backend {
+
+CommandStreamCapture::~CommandStreamCapture() noexcept {
+    close();
+}
+
+bool CommandStreamCapture::open(const char* path) noexcept {
+    close();
+    mFile = fopen(path, "wb");
+    if (!mFile) {
+        LOG(WARNING) << "CommandStreamCapture: can't create '" << path << "'";
+        return false;
+    }
+    uint32_t const header[2] = { MAGIC, VERSION };
+    putBytes(header, sizeof(header));
+    LOG(INFO) << "CommandStreamCapture: capturing command stream to '" << path << "'";
+    return true;
+}
+
+void CommandStreamCapture::close() noexcept {
+    if (mFile) {
+        fclose(mFile);
+        mFile = nullptr;
+        mLayoutDynamicCount.clear();
+        mSetDynamicCount.clear();
+    }
+}
+
+void CommandStreamCapture::putBytes(void const* data, size_t size) noexcept {
+    fwrite(data, 1, size, mFile);
+}
+
+void CommandStreamCapture::put(const char* s) noexcept {
+    uint32_t const size = s ? uint32_t(strlen(s)) : 0;
+    putBytes(&size, sizeof(size));
+    putBytes(s, size);
+}
+
+void CommandStreamCapture::put(utils::CString const& s) noexcept {
+    uint32_t const size = uint32_t(s.size());
+    putBytes(&size, sizeof(size));
+    putBytes(s.data(), size);
+}
+
+void CommandStreamCapture::put(BufferDescriptor const& b) noexcept {
+    uint64_t const size = b.size;
+    putBytes(&size, sizeof(size));
+    putBytes(b.buffer, size);
+}
+
+void CommandStreamCapture::put(PixelBufferDescriptor const& p) noexcept {
+    put(uint8_t(p.type));
+    put(uint8_t(p.alignment));
+    put(uint32_t(p.left));
+    put(uint32_t(p.top));
+    // {stride, format} and {imageSize, compressedFormat} are union-ed, disambiguated by `type`
+    if (p.type == PixelDataType::COMPRESSED) {
+        put(uint32_t(p.imageSize));
+        put(uint16_t(p.compressedFormat));
+    } else {
+        put(uint32_t(p.stride));
+        put(uint16_t(p.format));
+    }
+    put(static_cast<BufferDescriptor const&>(p));
+}
+
+void CommandStreamCapture::put(Program const& program) noexcept {
+    // Program only exposes non-const accessors for some of its fields
+    Program& p = const_cast<Program&>(program);
+
+    put(uint8_t(p.getShaderLanguage()));
+    put(uint64_t(p.getCacheId()));
+    put(uint8_t(p.getPriorityQueue()));
+    put(uint8_t(p.isMultiview()));
+    put(p.getName());
+
+    for (auto const& blob : p.getShadersSource()) {
+        uint64_t const size = blob.size();
+        putBytes(&size, sizeof(size));
+        putBytes(blob.data(), size);
+    }
+
+    auto const& specConstants = p.getSpecializationConstants();
+    put(uint32_t(specConstants.size()));
+    for (auto const& c : specConstants) {
+        put(uint32_t(c.id));
+        put(uint8_t(c.value.index()));
+        int32_t bits = 0;
+        if (auto const* i = std::get_if<int32_t>(&c.value)) {
+            bits = *i;
+        } else if (auto const* f = std::get_if<float>(&c.value)) {
+            memcpy(&bits, f, sizeof(bits));
+        } else if (auto const* b = std::get_if<bool>(&c.value)) {
+            bits = *b ? 1 : 0;
+        }
+        put(bits);
+    }
+
+    for (size_t stage = 0; stage < Program::SHADER_TYPE_COUNT; stage++) {
+        auto const& pushConstants = p.getPushConstants(ShaderStage(stage));
+        put(uint32_t(pushConstants.size()));
+        for (auto const& c : pushConstants) {
+            put(c.name);
+            put(uint8_t(c.type));
+        }
+    }
+
+    for (auto const& set : p.getDescriptorBindings()) {
+        put(uint32_t(set.size()));
+        for (auto const& d : set) {
+            put(d.name);
+            put(uint8_t(d.type));
+            put(uint8_t(d.binding));
+        }
+    }
+
+    auto const& attributes = p.getAttributes();
+    put(uint32_t(attributes.size()));
+    for (auto const& [name, location] : attributes) {
+        put(name);
+        put(uint8_t(location));
+    }
+
+    auto const& bindingUniforms = p.getBindingUniformInfo();
+    put(uint32_t(bindingUniforms.size()));
+    for (auto const& [index, name, uniforms] : bindingUniforms) {
+        put(uint8_t(index));
+        put(name);
+        put(uint32_t(uniforms.size()));
+        for (auto const& u : uniforms) {
+            put(u.name);
+            put(uint16_t(u.offset));
+            put(uint8_t(u.size));
+            put(uint8_t(u.type));
+        }
+    }
+}
+
+void CommandStreamCapture::put(DescriptorSetLayout const& l) noexcept {
+    if (auto const* s = std::get_if<utils::StaticString>(&l.label)) {
+        put(s->c_str());
+    } else if (auto const* s = std::get_if<utils::CString>(&l.label)) {
+        put(*s);
+    } else {
+        put((const char*)nullptr);
+    }
+    put(uint32_t(l.bindings.size()));
+    for (auto const& b : l.bindings) {
+        put(uint8_t(b.type));
+        put(uint8_t(b.stageFlags));
+        put(uint8_t(b.binding));
+        put(uint8_t(b.flags));
+        put(uint16_t(b.count));
+    }
+}
+
+void CommandStreamCapture::put(TargetBufferInfo const& info) noexcept {
+    put(info.handle);
+    put(info.level);
+    put(info.layer);
+}
+
+void CommandStreamCapture::put(MRT const& mrt) noexcept {
+    for (size_t i = 0; i < MRT::MAX_SUPPORTED_RENDER_TARGET_COUNT; i++) {
+        put(mrt[i]);
+    }
+}
+
+void CommandStreamCapture::put(PipelineState const& state) noexcept {
+    put(state.program);
+    put(state.vertexBufferInfo);
+    for (auto const& dslh : state.pipelineLayout.setLayout) {
+        put(dslh);
+    }
+    put(state.rasterState);
+    put(state.stencilState);
+    put(state.polygonOffset);
+    put(state.primitiveType);
+}
+
+void CommandStreamCapture::put(BufferObjectStreamDescriptor const& d) noexcept {
+    put(uint32_t(d.mStreams.size()));
+    for (auto const& s : d.mStreams) {
+        put(uint32_t(s.offset));
+        put(uint32_t(s.stream.getId()));
+        put(uint8_t(s.associationType));
+    }
+}
+
+void CommandStreamCapture::trackDescriptorSetLayout(uint32_t resultId,
+        DescriptorSetLayout const& info) noexcept {
+    uint32_t dynamicCount = 0;
+    for (auto const& b : info.bindings) {
+        if ((uint8_t(b.flags) & uint8_t(DescriptorFlags::DYNAMIC_OFFSET)) != 0) {
+            dynamicCount++;
+        }
+    }
+    mLayoutDynamicCount[resultId] = dynamicCount;
+}
+
+void CommandStreamCapture::trackDescriptorSet(uint32_t resultId,
+        DescriptorSetLayoutHandle const& dslh) noexcept {
+    auto const pos = mLayoutDynamicCount.find(dslh.getId());
+    mSetDynamicCount[resultId] = (pos != mLayoutDynamicCount.end()) ? pos->second : 0;
+}
+
+void CommandStreamCapture::putBindDescriptorSet(DescriptorSetHandle const& dsh,
+        descriptor_set_t const& set, DescriptorSetOffsetArray const& offsets) noexcept {
+    put(dsh);
+    put(set);
+    putOffsets(dsh, offsets);
+}
+
+void CommandStreamCapture::putBindDescriptorSets(
+        DescriptorSetBindingArray const& bindings) noexcept {
+    put(uint32_t(bindings.size()));
+    for (auto const& b : bindings) {
+        put(b.dsh);
+        put(b.set);
+        putOffsets(b.dsh, b.offsets);
+    }
+}
+
+void CommandStreamCapture::putOffsets(DescriptorSetHandle dsh,
+        DescriptorSetOffsetArray const& offsets) noexcept {
+    uint32_t count = 0;
+    if (!offsets.empty()) {
+        auto const pos = mSetDynamicCount.find(dsh.getId());
+        count = (pos != mSetDynamicCount.end()) ? pos->second : 0;
+    }
+    put(count);
+    putBytes(offsets.data(), count * sizeof(uint32_t));
+}
+
+} // namespace filament::backend
@@ -0,0 +1,527 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "private/backend/CommandStreamReplayer.h"
+
+#include "private/backend/CommandStreamCapture.h"
+#include "private/backend/DriverApi.h"
+
+#include <backend/BufferDescriptor.h>
+#include <backend/BufferObjectStreamDescriptor.h>
+#include <backend/DescriptorSetOffsetArray.h>
+#include <backend/DriverEnums.h>
+#include <backend/Handle.h>
+#include <backend/PipelineState.h>
+#include <backend/PixelBufferDescriptor.h>
+#include <backend/Platform.h>
+#include <backend/Program.h>
+#include <backend/TargetBufferInfo.h>
+
+#include <utils/FixedCapacityVector.h>
+#include <utils/Invocable.h>
+#include <utils/Logger.h>
+#include <utils/debug.h>
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace filament::backend {
+
+namespace {
+template<typename T> struct is_handle : std::false_type {};
+template<typename T> struct is_handle<Handle<T>> : std::true_type {};
+template<typename T> inline constexpr bool is_handle_v = is_handle<T>::value;
+} // anonymous namespace
+
+/*
+ * Decodes one command's worth of parameters at a time. Each get<T>() mirrors the matching
+ * CommandStreamCapture::put() overload exactly; the parameter types are recovered from the
+ * driver method's signature, so no type information needs to be stored in the file.
+ */
+class CaptureReader {
+public:
+    CaptureReader(CommandStreamReplayer& replayer, DriverApi& driver,
+            uint8_t const* data, size_t size, size_t pos) noexcept
+            : mReplayer(replayer), mDriver(driver), mData(data), mSize(size), mPos(pos) {
+    }
+
+    bool atEnd() const noexcept { return mPos + sizeof(uint16_t) > mSize; }
+
+    void read(void* out, size_t n) noexcept {
+        assert_invariant(mPos + n <= mSize);
+        memcpy(out, mData + mPos, n);
+        mPos += n;
+    }
+
+    template<typename T>
+    T readRaw() noexcept {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T v{};
+        read(&v, sizeof(T));
+        return v;
+    }
+
+    utils::CString readString() noexcept {
+        uint32_t const size = readRaw<uint32_t>();
+        utils::CString s{ reinterpret_cast<const char*>(mData + mPos), size };
+        mPos += size;
+        return s;
+    }
+
+    template<typename T>
+    T get() noexcept {
+        if constexpr (is_handle_v<T>) {
+            uint32_t const capturedId = readRaw<uint32_t>();
+            if (capturedId == HandleBase::nullid) {
+                return T{};
+            }
+            auto const pos = mReplayer.mHandleMap.find(capturedId);
+            if (UTILS_UNLIKELY(pos == mReplayer.mHandleMap.end())) {
+                // created before the capture started
+                mReplayer.mUnresolvedHandles++;
+                return T{};
+            }
+            return T{ pos->second };
+        } else if constexpr (std::is_same_v<T, utils::CString>) {
+            return readString();
+        } else if constexpr (std::is_same_v<T, const char*>) {
+            // drivers take marker strings by pointer, keep them alive for our whole life
+            mReplayer.mStrings.push_back(readString());
+            return mReplayer.mStrings.back().c_str();
+        } else if constexpr (std::is_same_v<T, BufferDescriptor>) {
+            return readBuffer();
+        } else if constexpr (std::is_same_v<T, PixelBufferDescriptor>) {
+            return readPixelBuffer();
+        } else if constexpr (std::is_same_v<T, Program>) {
+            return readProgram();
+        } else if constexpr (std::is_same_v<T, DescriptorSetLayout>) {
+            return readDescriptorSetLayout();
+        } else if constexpr (std::is_same_v<T, TargetBufferInfo>) {
+            return readTargetBufferInfo();
+        } else if constexpr (std::is_same_v<T, MRT>) {
+            MRT mrt;
+            for (size_t i = 0; i < MRT::MAX_SUPPORTED_RENDER_TARGET_COUNT; i++) {
+                mrt[i] = readTargetBufferInfo();
+            }
+            return mrt;
+        } else if constexpr (std::is_same_v<T, PipelineState>) {
+            PipelineState state;
+            state.program = get<ProgramHandle>();
+            state.vertexBufferInfo = get<VertexBufferInfoHandle>();
+            for (auto& dslh : state.pipelineLayout.setLayout) {
+                dslh = get<DescriptorSetLayoutHandle>();
+            }
+            state.rasterState = readRaw<RasterState>();
+            state.stencilState = readRaw<StencilState>();
+            state.polygonOffset = readRaw<PolygonOffset>();
+            state.primitiveType = readRaw<PrimitiveType>();
+            return state;
+        } else if constexpr (std::is_same_v<T, DescriptorSetOffsetArray>) {
+            return readOffsets();
+        } else if constexpr (std::is_same_v<T, DescriptorSetBindingArray>) {
+            uint32_t const count = readRaw<uint32_t>();
+            DescriptorSetBindingArray bindings{ count, mDriver };
+            for (uint32_t i = 0; i < count; i++) {
+                bindings[i].dsh = get<DescriptorSetHandle>();
+                bindings[i].set = readRaw<descriptor_set_t>();
+                bindings[i].offsets = readOffsets();
+            }
+            return bindings;
+        } else if constexpr (std::is_same_v<T, BufferObjectStreamDescriptor>) {
+            BufferObjectStreamDescriptor d;
+            uint32_t const count = readRaw<uint32_t>();
+            d.mStreams.reserve(count);
+            for (uint32_t i = 0; i < count; i++) {
+                uint32_t const offset = readRaw<uint32_t>();
+                auto const stream = get<Handle<HwStream>>();
+                auto const type = BufferObjectStreamAssociationType(readRaw<uint8_t>());
+                d.mStreams.push_back({ offset, stream, type });
+            }
+            return d;
+        } else if constexpr (std::is_same_v<T, FrameScheduledCallback>
+                || std::is_same_v<T, utils::Invocable<void(void)>>
+                || std::is_same_v<T, Platform::ExternalImageHandle>) {
+            // not captured, substitute an empty one (the commands carrying these are
+            // decoded but never executed, see replayOne())
+            return T{};
+        } else {
+            return readRaw<T>();
+        }
+    }
+
+    // decodes the parameters of an async command and optionally records it into the driver
+    template<typename... ARGS>
+    void invokeAsync(void (DriverApi::*method)(ARGS...), bool const execute = true) noexcept {
+        std::tuple<std::decay_t<ARGS>...> args{ get<std::decay_t<ARGS>>()... };
+        if (execute) {
+            std::apply([&](auto&... a) { (mDriver.*method)(std::move(a)...); }, args);
+        }
+    }
+
+    // same for a command returning a handle; maps the captured handle id to the new one
+    template<typename R, typename... ARGS>
+    void invokeReturn(R (DriverApi::*method)(ARGS...)) noexcept {
+        uint32_t const capturedId = readRaw<uint32_t>();
+        std::tuple<std::decay_t<ARGS>...> args{ get<std::decay_t<ARGS>>()... };
+        R const handle = std::apply([&](auto&... a) {
+            return (mDriver.*method)(std::move(a)...);
+        }, args);
+        mReplayer.mHandleMap[capturedId] = handle.getId();
+    }
+
+    void mapHandle(uint32_t capturedId, uint32_t id) noexcept {
+        mReplayer.mHandleMap[capturedId] = id;
+    }
+
+private:
+    BufferDescriptor readBuffer() noexcept {
+        uint64_t const size = readRaw<uint64_t>();
+        void* const buffer = malloc(size);
+        read(buffer, size);
+        return { buffer, size_t(size), [](void* b, size_t, void*) { free(b); } };
+    }
+
+    PixelBufferDescriptor readPixelBuffer() noexcept {
+        auto const type = PixelDataType(readRaw<uint8_t>());
+        uint8_t const alignment = readRaw<uint8_t>();
+        uint32_t const left = readRaw<uint32_t>();
+        uint32_t const top = readRaw<uint32_t>();
+        uint32_t const strideOrImageSize = readRaw<uint32_t>();
+        uint16_t const format = readRaw<uint16_t>();
+        uint64_t const size = readRaw<uint64_t>();
+        void* const buffer = malloc(size);
+        read(buffer, size);
+        constexpr auto destroyer = +[](void* b, size_t, void*) { free(b); };
+        if (type == PixelDataType::COMPRESSED) {
+            return { buffer, size_t(size),
+                    CompressedPixelDataType(format), strideOrImageSize, destroyer };
+        }
+        return { buffer, size_t(size),
+                PixelDataFormat(format), type, alignment, left, top, strideOrImageSize,
+                destroyer };
+    }
+
+    Program readProgram() noexcept {
+        Program p;
+        p.shaderLanguage(ShaderLanguage(readRaw<uint8_t>()));
+        p.cacheId(readRaw<uint64_t>());
+        p.priorityQueue(CompilerPriorityQueue(readRaw<uint8_t>()));
+        p.multiview(readRaw<uint8_t>() != 0);
+        p.diagnostics(readString(),
+                [](utils::io::ostream& out) -> utils::io::ostream& { return out; });
+
+        for (size_t stage = 0; stage < Program::SHADER_TYPE_COUNT; stage++) {
+            uint64_t const size = readRaw<uint64_t>();
+            if (size) {
+                p.shader(ShaderStage(stage), mData + mPos, size);
+                mPos += size;
+            }
+        }
+
+        uint32_t count = readRaw<uint32_t>();
+        auto specConstants =
+                Program::SpecializationConstantsInfo::with_capacity(count);
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t const id = readRaw<uint32_t>();
+            uint8_t const kind = readRaw<uint8_t>();
+            int32_t const bits = readRaw<int32_t>();
+            Program::SpecializationConstant::Type value;
+            switch (kind) {
+                default:
+                case 0: value = bits; break;
+                case 1: { float f; memcpy(&f, &bits, sizeof(f)); value = f; break; }
+                case 2: value = bool(bits); break;
+            }
+            specConstants.push_back({ id, value });
+        }
+        p.specializationConstants(std::move(specConstants));
+
+        for (size_t stage = 0; stage < Program::SHADER_TYPE_COUNT; stage++) {
+            count = readRaw<uint32_t>();
+            auto pushConstants =
+                    utils::FixedCapacityVector<Program::PushConstant>::with_capacity(count);
+            for (uint32_t i = 0; i < count; i++) {
+                auto name = readString();
+                pushConstants.push_back({ std::move(name), ConstantType(readRaw<uint8_t>()) });
+            }
+            p.pushConstants(ShaderStage(stage), std::move(pushConstants));
+        }
+
+        for (size_t set = 0; set < MAX_DESCRIPTOR_SET_COUNT; set++) {
+            count = readRaw<uint32_t>();
+            auto bindings = Program::DescriptorBindingsInfo::with_capacity(count);
+            for (uint32_t i = 0; i < count; i++) {
+                auto name = readString();
+                auto const type = DescriptorType(readRaw<uint8_t>());
+                bindings.push_back({ std::move(name), type,
+                        descriptor_binding_t(readRaw<uint8_t>()) });
+            }
+            p.descriptorBindings(descriptor_set_t(set), std::move(bindings));
+        }
+
+        count = readRaw<uint32_t>();
+        auto attributes = Program::AttributesInfo::with_capacity(count);
+        for (uint32_t i = 0; i < count; i++) {
+            auto name = readString();
+            attributes.push_back({ std::move(name), readRaw<uint8_t>() });
+        }
+        p.attributes(std::move(attributes));
+
+        count = readRaw<uint32_t>();
+        for (uint32_t i = 0; i < count; i++) {
+            uint8_t const index = readRaw<uint8_t>();
+            auto name = readString();
+            uint32_t const uniformCount = readRaw<uint32_t>();
+            auto uniforms = Program::UniformInfo::with_capacity(uniformCount);
+            for (uint32_t j = 0; j < uniformCount; j++) {
+                auto uniformName = readString();
+                uint16_t const offset = readRaw<uint16_t>();
+                uint8_t const size = readRaw<uint8_t>();
+                uniforms.push_back({ std::move(uniformName), offset, size,
+                        UniformType(readRaw<uint8_t>()) });
+            }
+            p.uniforms(index, std::move(name), std::move(uniforms));
+        }
+        return p;
+    }
+
+    DescriptorSetLayout readDescriptorSetLayout() noexcept {
+        DescriptorSetLayout layout;
+        auto label = readString();
+        if (!label.empty()) {
+            layout.label = std::move(label);
+        }
+        uint32_t const count = readRaw<uint32_t>();
+        layout.bindings =
+                utils::FixedCapacityVector<DescriptorSetLayoutBinding>::with_capacity(count);
+        for (uint32_t i = 0; i < count; i++) {
+            auto const type = DescriptorType(readRaw<uint8_t>());
+            auto const stageFlags = ShaderStageFlags(readRaw<uint8_t>());
+            auto const binding = descriptor_binding_t(readRaw<uint8_t>());
+            auto const flags = DescriptorFlags(readRaw<uint8_t>());
+            uint16_t const descriptorCount = readRaw<uint16_t>();
+            layout.bindings.push_back({ type, stageFlags, binding, flags, descriptorCount });
+        }
+        return layout;
+    }
+
+    TargetBufferInfo readTargetBufferInfo() noexcept {
+        TargetBufferInfo info;
+        info.handle = get<TextureHandle>();
+        info.level = readRaw<uint8_t>();
+        info.layer = readRaw<uint16_t>();
+        return info;
+    }
+
+    DescriptorSetOffsetArray readOffsets() noexcept {
+        uint32_t const count = readRaw<uint32_t>();
+        if (!count) {
+            return {};
+        }
+        DescriptorSetOffsetArray offsets{ count, mDriver };
+        read(offsets.data(), count * sizeof(uint32_t));
+        return offsets;
+    }
+
+    CommandStreamReplayer& mReplayer;
+    DriverApi& mDriver;
+    uint8_t const* const mData;
+    size_t const mSize;
+    size_t mPos;
+};
+
+// ------------------------------------------------------------------------------------------------
+
+bool CommandStreamReplayer::open(const char* path) noexcept {
+    close();
+    FILE* const file = fopen(path, "rb");
+    if (!file) {
+        LOG(ERROR) << "CommandStreamReplayer: can't open '" << path << "'";
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long const size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    mData.resize(size_t(size));
+    size_t const r = fread(mData.data(), 1, mData.size(), file);
+    fclose(file);
+    uint32_t header[2];
+    if (r != mData.size() || mData.size() < sizeof(header)) {
+        LOG(ERROR) << "CommandStreamReplayer: can't read '" << path << "'";
+        return false;
+    }
+    memcpy(header, mData.data(), sizeof(header));
+    if (header[0] != CommandStreamCapture::MAGIC
+            || header[1] != CommandStreamCapture::VERSION) {
+        LOG(ERROR) << "CommandStreamReplayer: '" << path << "' is not a version "
+                   << CommandStreamCapture::VERSION << " capture file";
+        return false;
+    }
+    return true;
+}
+
+void CommandStreamReplayer::close() noexcept {
+    mData.clear();
+    mHandleMap.clear();
+    mStrings.clear();
+    mUnresolvedHandles = 0;
+}
+
+size_t CommandStreamReplayer::replay(DriverApi& driver,
+        utils::Invocable<void()> const& flush) {
+    // keeps the CircularBuffer bounded between captured frame boundaries (e.g. during the
+    // scene-building phase of a whole-life capture)
+    constexpr size_t FLUSH_INTERVAL = 1024;
+
+    CaptureReader reader{ *this, driver, mData.data(), mData.size(), 2 * sizeof(uint32_t) };
+    size_t commandCount = 0;
+    size_t sinceFlush = 0;
+    uint16_t id;
+    while (replayOne(reader, driver, id)) {
+        commandCount++;
+        if (flush && (++sinceFlush >= FLUSH_INTERVAL
+                || CaptureCommand(id) == CaptureCommand::endFrame)) {
+            flush();
+            sinceFlush = 0;
+        }
+    }
+    if (flush) {
+        flush();
+    }
+    return commandCount;
+}
+
+bool CommandStreamReplayer::replayOne(CaptureReader& reader, DriverApi& driver,
+        uint16_t& outId) {
+    if (reader.atEnd()) {
+        return false;
+    }
+
+    outId = reader.readRaw<uint16_t>();
+    auto const id = CaptureCommand(outId);
+
+    /*
+     * Commands referencing objects the stream can't recreate are substituted or skipped (the
+     * parameters are always fully decoded to stay in sync with the stream), see the class
+     * documentation. Everything else goes through the table generated below.
+     */
+    switch (id) {
+        case CaptureCommand::createSwapChain: {
+            uint32_t const capturedId = reader.readRaw<uint32_t>();
+            reader.readRaw<void*>();    // native window, meaningless here
+            uint64_t const flags = reader.readRaw<uint64_t>();
+            reader.mapHandle(capturedId,
+                    driver.createSwapChainHeadless(mSwapChainWidth, mSwapChainHeight,
+                            flags).getId());
+            return true;
+        }
+        case CaptureCommand::createTextureExternalImage2:
+        case CaptureCommand::createTextureExternalImage: {
+            uint32_t const capturedId = reader.readRaw<uint32_t>();
+            auto const target = reader.readRaw<SamplerType>();
+            auto const format = reader.readRaw<TextureFormat>();
+            uint32_t const width = reader.readRaw<uint32_t>();
+            uint32_t const height = reader.readRaw<uint32_t>();
+            auto const usage = reader.readRaw<TextureUsage>();
+            if (id == CaptureCommand::createTextureExternalImage) {
+                reader.readRaw<void*>();    // external image
+            }
+            reader.mapHandle(capturedId,
+                    driver.createTexture(target, 1, format, 1, width, height, 1,
+                            usage).getId());
+            return true;
+        }
+        case CaptureCommand::createTextureExternalImagePlane: {
+            uint32_t const capturedId = reader.readRaw<uint32_t>();
+            auto const format = reader.readRaw<TextureFormat>();
+            uint32_t const width = reader.readRaw<uint32_t>();
+            uint32_t const height = reader.readRaw<uint32_t>();
+            auto const usage = reader.readRaw<TextureUsage>();
+            reader.readRaw<void*>();    // external image
+            reader.readRaw<uint32_t>(); // plane
+            reader.mapHandle(capturedId,
+                    driver.createTexture(SamplerType::SAMPLER_2D, 1, format, 1,
+                            width, height, 1, usage).getId());
+            return true;
+        }
+        case CaptureCommand::importTexture: {
+            uint32_t const capturedId = reader.readRaw<uint32_t>();
+            reader.readRaw<intptr_t>(); // foreign texture id
+            auto const target = reader.readRaw<SamplerType>();
+            uint8_t const levels = reader.readRaw<uint8_t>();
+            auto const format = reader.readRaw<TextureFormat>();
+            uint8_t const samples = reader.readRaw<uint8_t>();
+            uint32_t const width = reader.readRaw<uint32_t>();
+            uint32_t const height = reader.readRaw<uint32_t>();
+            uint32_t const depth = reader.readRaw<uint32_t>();
+            auto const usage = reader.readRaw<TextureUsage>();
+            reader.mapHandle(capturedId,
+                    driver.createTexture(target, levels, format, samples,
+                            width, height, depth, usage).getId());
+            return true;
+        }
+        case CaptureCommand::setFrameScheduledCallback:
+            reader.invokeAsync(&DriverApi::setFrameScheduledCallback, false);
+            return true;
+        case CaptureCommand::setFrameCompletedCallback:
+            reader.invokeAsync(&DriverApi::setFrameCompletedCallback, false);
+            return true;
+        case CaptureCommand::setExternalStream:
+            reader.invokeAsync(&DriverApi::setExternalStream, false);
+            return true;
+        case CaptureCommand::registerBufferObjectStreams:
+            reader.invokeAsync(&DriverApi::registerBufferObjectStreams, false);
+            return true;
+        case CaptureCommand::destroyStream:
+            reader.invokeAsync(&DriverApi::destroyStream, false);
+            return true;
+        case CaptureCommand::compilePrograms: {
+            auto const priority = reader.readRaw<CompilerPriorityQueue>();
+            reader.readRaw<CallbackHandler*>();
+            reader.readRaw<CallbackHandler::Callback>();
+            reader.readRaw<void*>();
+            driver.compilePrograms(priority, nullptr, nullptr, nullptr);
+            return true;
+        }
+        default:
+            break;
+    }
+
+    switch (id) {
+#define DECL_DRIVER_API(methodName, paramsDecl, params)                                         \
+        case CaptureCommand::methodName:                                                        \
+            reader.invokeAsync(&DriverApi::methodName);                                         \
+            break;
+#define DECL_DRIVER_API_SYNCHRONOUS(RetType, methodName, paramsDecl, params)
+#define DECL_DRIVER_API_RETURN(RetType, methodName, paramsDecl, params)                         \
+        case CaptureCommand::methodName:                                                        \
+            reader.invokeReturn(&DriverApi::methodName);                                        \
+            break;
+#include "private/backend/DriverAPI.inc"
+        default:
+            LOG(ERROR) << "CommandStreamReplayer: unknown command id " << +uint16_t(id)
+                       << ", stopping";
+            return false;
+    }
+    return true;
+}
+
+} // namespace filament::backend
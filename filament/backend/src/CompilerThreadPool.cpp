@@ -108,6 +108,30 @@ auto CompilerThreadPool::dequeue(program_token_t const& token) -> Job {
     return job;
 }
 
+bool CompilerThreadPool::requeue(CompilerPriorityQueue priorityQueue,
+        program_token_t const& token) {
+    std::unique_lock const lock(mQueueLock);
+    auto&& [q, pos] = find(token);
+    if (pos == q.end()) {
+        // the job is being (or has been) processed, too late to change its priority
+        return false;
+    }
+    auto item = std::move(*pos);
+    q.erase(pos);
+    auto& destination = mQueues[size_t(priorityQueue)];
+    if (priorityQueue == CompilerPriorityQueue::HIGH) {
+        destination.push_front(std::move(item));
+    } else {
+        destination.push_back(std::move(item));
+    }
+    return true;
+}
+
+size_t CompilerThreadPool::getQueueDepth() noexcept {
+    std::unique_lock const lock(mQueueLock);
+    return mQueues[0].size() + mQueues[1].size();
+}
+
 void CompilerThreadPool::queue(CompilerPriorityQueue priorityQueue,
         program_token_t const& token, Job&& job) {
     std::unique_lock const lock(mQueueLock);
@@ -52,6 +52,13 @@ public:
     void terminate() noexcept;
     void queue(CompilerPriorityQueue priorityQueue, program_token_t const& token, Job&& job);
     Job dequeue(program_token_t const& token);
+    // Moves the job associated with the token, if it is still queued, to the given priority
+    // queue. A job promoted to HIGH goes to the front of the queue, so it runs next; a job
+    // demoted to LOW goes to the back. Returns false if the job was already taken by a
+    // compiler thread (or was never queued).
+    bool requeue(CompilerPriorityQueue priorityQueue, program_token_t const& token);
+    // Number of jobs still queued (not yet taken by a compiler thread).
+    size_t getQueueDepth() noexcept;
 
 private:
     using Queue = std::deque<std::pair<program_token_t, Job>>;
@@ -18,6 +18,8 @@
 
 #include <backend/Handle.h>
 
+#include <private/utils/Tracing.h>
+
 #include <utils/Allocator.h>
 #include <utils/CString.h>
 #include <utils/Logger.h>
@@ -94,6 +96,20 @@ HandleAllocator<P0, P1, P2>::HandleAllocator(const char* name, size_t size) noex
 
 template <size_t P0, size_t P1, size_t P2>
 HandleAllocator<P0, P1, P2>::~HandleAllocator() {
+    // return the nodes still sitting in the cache shards to the arena, so the debug tracking
+    // policy doesn't report them as leaked
+    constexpr size_t sizes[3] = { P0, P1, P2 };
+    for (CacheShard& shard : mCacheShards) {
+        for (size_t s = 0; s < 3; s++) {
+            for (size_t i = 0, n = shard.count[s]; i < n; i++) {
+                void* const p = shard.entries[s][i];
+                uint8_t const age = static_cast<typename Allocator::Node*>(p)[-1].age;
+                mHandleArena.free(p, sizes[s], age);
+            }
+            shard.count[s] = 0;
+        }
+    }
+
     auto& overflowMap = mOverflowMap;
     if (!overflowMap.empty()) {
         PANIC_LOG("Not all handles have been freed. Probably leaking memory.");
@@ -104,6 +120,92 @@ HandleAllocator<P0, P1, P2>::~HandleAllocator() {
     }
 }
 
+template <size_t P0, size_t P1, size_t P2>
+size_t HandleAllocator<P0, P1, P2>::threadShardIndex() noexcept {
+    // threads are assigned to shards round-robin the first time they allocate or free a
+    // pool handle
+    static std::atomic<uint32_t> nextShard{ 0 };
+    static thread_local uint32_t const shard =
+            nextShard.fetch_add(1, std::memory_order_relaxed) % CACHE_SHARD_COUNT;
+    return shard;
+}
+
+template <size_t P0, size_t P1, size_t P2>
+void HandleAllocator<P0, P1, P2>::lockArena() noexcept {
+    if (UTILS_UNLIKELY(!mArenaLock.try_lock())) {
+        mArenaLock.lock();
+        uint32_t const contended =
+                mArenaContentionCount.fetch_add(1, std::memory_order_relaxed) + 1;
+        FILAMENT_TRACING_VALUE(FILAMENT_TRACING_CATEGORY_FILAMENT,
+                "HandleAllocator contention", contended);
+    }
+}
+
+template <size_t P0, size_t P1, size_t P2>
+UTILS_NOINLINE
+void* HandleAllocator<P0, P1, P2>::cacheAlloc(size_t const sizeClass, size_t const size,
+        uint8_t* outAge) noexcept {
+    CacheShard& shard = mCacheShards[threadShardIndex()];
+    std::lock_guard const lock(shard.lock);
+    size_t& count = shard.count[sizeClass];
+    if (UTILS_UNLIKELY(count == 0)) {
+        // the magazine is empty, refill half of it from the shared arena under a single
+        // acquisition of the arena lock
+        lockArena();
+        size_t n = 0;
+        while (n < MAGAZINE_SIZE / 2) {
+            uint8_t age;
+            void* const p = mHandleArena.alloc(size, Allocator::getAlignment(), 0, &age);
+            if (UTILS_UNLIKELY(!p)) {
+                break;
+            }
+            shard.entries[sizeClass][n++] = p;
+        }
+        mArenaLock.unlock();
+        count = n;
+        if (UTILS_UNLIKELY(n == 0)) {
+            // the arena is full, the caller falls back to the system heap
+            return nullptr;
+        }
+    }
+    void* const p = shard.entries[sizeClass][--count];
+    // the node's in-memory age is always current (see cacheFree() below)
+    *outAge = static_cast<typename Allocator::Node*>(p)[-1].age;
+    return p;
+}
+
+template <size_t P0, size_t P1, size_t P2>
+UTILS_NOINLINE
+void HandleAllocator<P0, P1, P2>::cacheFree(size_t const sizeClass, size_t const size,
+        void* p, uint8_t const age) noexcept {
+    // Same double-free / use-after-free check as Allocator::free(). The node's age is bumped
+    // right away, so stale handles are detected while it sits in the cache.
+    auto* const pNode = static_cast<typename Allocator::Node*>(p);
+    uint8_t& expectedAge = pNode[-1].age;
+    if (UTILS_UNLIKELY(!mUseAfterFreeCheckDisabled)) {
+        FILAMENT_CHECK_POSTCONDITION(expectedAge == age) <<
+                "double-free of Handle of size " << size << " at " << p;
+    }
+    expectedAge = (expectedAge + 1) & 0xF; // fixme (see Allocator::free())
+
+    CacheShard& shard = mCacheShards[threadShardIndex()];
+    std::lock_guard const lock(shard.lock);
+    size_t& count = shard.count[sizeClass];
+    if (UTILS_UNLIKELY(count == MAGAZINE_SIZE)) {
+        // the magazine is full, return half of it to the shared arena under a single
+        // acquisition of the arena lock. Allocator::free() checks and bumps the age once
+        // more; the extra bump is harmless, any bump invalidates outstanding stale handles.
+        lockArena();
+        while (count > MAGAZINE_SIZE / 2) {
+            void* const q = shard.entries[sizeClass][--count];
+            uint8_t const currentAge = static_cast<typename Allocator::Node*>(q)[-1].age;
+            mHandleArena.free(q, size, currentAge);
+        }
+        mArenaLock.unlock();
+    }
+    shard.entries[sizeClass][count++] = p;
+}
+
 template <size_t P0, size_t P1, size_t P2>
 UTILS_NOINLINE
 void* HandleAllocator<P0, P1, P2>::handleToPointerSlow(HandleBase::HandleId id) const noexcept {
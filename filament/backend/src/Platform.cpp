@@ -16,6 +16,8 @@
 
 #include <backend/Platform.h>
 
+#include "BlobCacheFile.h"
+
 #include <utils/compiler.h>
 #include <utils/ostream.h>
 
@@ -24,6 +26,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 namespace filament::backend {
 
@@ -128,26 +131,54 @@ void Platform::setBlobFunc(InsertBlobFunc&& insertBlob, RetrieveBlobFunc&& retri
 }
 
 bool Platform::hasInsertBlobFunc() const noexcept {
-    return bool(mInsertBlob);
+    return bool(mInsertBlob) || bool(mBlobCacheFile);
 }
 
 bool Platform::hasRetrieveBlobFunc() const noexcept {
-    return bool(mRetrieveBlob);
+    return bool(mRetrieveBlob) || bool(mBlobCacheFile);
 }
 
 void Platform::insertBlob(void const* key, size_t keySize, void const* value, size_t valueSize) {
+    if (mBlobCacheFile) {
+        mBlobCacheFile->insert(key, keySize, value, valueSize);
+        return;
+    }
     if (mInsertBlob) {
         mInsertBlob(key, keySize, value, valueSize);
     }
 }
 
 size_t Platform::retrieveBlob(void const* key, size_t keySize, void* value, size_t valueSize) {
+    if (mBlobCacheFile) {
+        size_t blobSize = 0;
+        void const* const blob = mBlobCacheFile->retrieve(key, keySize, &blobSize);
+        if (blob) {
+            if (blobSize <= valueSize) {
+                memcpy(value, blob, blobSize);
+            }
+            return blobSize;
+        }
+        // on a miss, fall through to the application-provided callback if there is one
+    }
     if (mRetrieveBlob) {
         return mRetrieveBlob(key, keySize, value, valueSize);
     }
     return 0;
 }
 
+bool Platform::setBlobCacheFile(const char* path) noexcept {
+    mBlobCacheFile = BlobCacheFile::open(path);
+    return bool(mBlobCacheFile);
+}
+
+void const* Platform::retrieveBlobMapped(void const* key, size_t keySize,
+        size_t* valueSize) noexcept {
+    if (mBlobCacheFile) {
+        return mBlobCacheFile->retrieve(key, keySize, valueSize);
+    }
+    return nullptr;
+}
+
 void Platform::setDebugUpdateStatFunc(DebugUpdateStatFunc&& debugUpdateStat) noexcept {
     mDebugUpdateStat = std::move(debugUpdateStat);
 }
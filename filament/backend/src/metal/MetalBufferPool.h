@@ -84,6 +84,11 @@ public:
 private:
     MetalContext& mContext;
 
+    // Rounds a request up to its power-of-two size class. Buffers are allocated at the class
+    // capacity, so steady-state requests of slightly varying sizes all land in the same class
+    // and are serviced from the free list instead of the Metal allocator.
+    static size_t toBucketSize(size_t numBytes) noexcept;
+
     // Synchronizes access to mFreeStages, mUsedStages, and mutable data inside MetalBufferPoolEntrys.
     // acquireBuffer and releaseBuffer may be called on separate threads (the engine thread and a
     // Metal callback thread, for example).
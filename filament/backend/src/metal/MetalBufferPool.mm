@@ -28,7 +28,23 @@
 namespace filament {
 namespace backend {
 
+size_t MetalBufferPool::toBucketSize(size_t numBytes) noexcept {
+    constexpr size_t MIN_BUCKET_SIZE = 1024;
+    constexpr size_t MAX_BUCKET_SIZE = 16 * 1024 * 1024;
+    // Very large requests are rare and one-off; don't round them up.
+    if (numBytes > MAX_BUCKET_SIZE) {
+        return numBytes;
+    }
+    size_t bucket = MIN_BUCKET_SIZE;
+    while (bucket < numBytes) {
+        bucket *= 2;
+    }
+    return bucket;
+}
+
 MetalBufferPoolEntry const* MetalBufferPool::acquireBuffer(size_t numBytes) {
+    numBytes = toBucketSize(numBytes);
+
     std::lock_guard<std::mutex> lock(mMutex);
 
     // First check if a stage exists whose capacity is greater than or equal to the requested size.
@@ -58,6 +58,13 @@ struct MetalDescriptorSet;
 
 constexpr static uint8_t MAX_SAMPLE_COUNT = 8;  // Metal devices support at most 8 MSAA samples
 
+// Experimental: encode render passes through MTLParallelRenderCommandEncoder. This is groundwork
+// for encoding a pass from multiple sub-encoders; draws are still recorded serially on the driver
+// thread, so it currently provides no parallelism and ships disabled.
+#ifndef FILAMENT_METAL_PARALLEL_ENCODING
+#define FILAMENT_METAL_PARALLEL_ENCODING 0
+#endif
+
 class MetalPushConstantBuffer {
 public:
     void setPushConstant(PushConstantVariant value, uint8_t index);
@@ -128,6 +135,10 @@ struct MetalContext {
     std::atomic<uint64_t> latestCompletedCommandBufferId = 0;
     id<MTLCommandBuffer> pendingCommandBuffer = nil;
     id<MTLRenderCommandEncoder> currentRenderPassEncoder = nil;
+#if FILAMENT_METAL_PARALLEL_ENCODING
+    // When parallel encoding is enabled, currentRenderPassEncoder is a sub-encoder of this one.
+    id<MTLParallelRenderCommandEncoder> currentParallelRenderPassEncoder = nil;
+#endif
     uint32_t currentFrame = 0;
 
     std::atomic<bool> memorylessLimitsReached = false;
@@ -192,6 +203,10 @@ struct MetalContext {
     MetalBufferPool* bufferPool;
     MetalBumpAllocator* bumpAllocator;
 
+    // Optional heap that sampleable textures are placed in (see
+    // Engine::Config::metalTextureHeapSizeBytes). nil when disabled.
+    id<MTLHeap> textureHeap = nil;
+
     MetalSwapChain* currentDrawSwapChain = nil;
     MetalSwapChain* currentReadSwapChain = nil;
 
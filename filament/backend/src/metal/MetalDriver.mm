@@ -206,6 +206,15 @@ MetalDriver::MetalDriver(
             new MetalBumpAllocator(mContext->device, driverConfig.metalUploadBufferSizeBytes);
     mContext->blitter = new MetalBlitter(*mContext);
 
+    if (driverConfig.metalTextureHeapSizeBytes > 0) {
+        MTLHeapDescriptor* heapDescriptor = [MTLHeapDescriptor new];
+        heapDescriptor.size = driverConfig.metalTextureHeapSizeBytes;
+        heapDescriptor.storageMode = MTLStorageModePrivate;
+        // Tracked hazards keep heap-placed textures as safe to use as dedicated allocations.
+        heapDescriptor.hazardTrackingMode = MTLHazardTrackingModeTracked;
+        mContext->textureHeap = [mContext->device newHeapWithDescriptor:heapDescriptor];
+    }
+
     if (@available(iOS 12, *)) {
         mContext->timerQueryImpl = new MetalTimerQueryFence(*mContext);
     } else {
@@ -240,6 +249,7 @@ MetalDriver::~MetalDriver() noexcept {
     ScopedAllocationTimer::setPlatform(nullptr);
     mContext->device = nil;
     mContext->emptyTexture = nil;
+    mContext->textureHeap = nil;
     CFRelease(mContext->textureCache);
     delete mContext->bufferPool;
     delete mContext->bumpAllocator;
@@ -990,6 +1000,10 @@ int64_t MetalDriver::getStreamTimestamp(Handle<HwStream> stream) {
     return 0;
 }
 
+StreamStats MetalDriver::getStreamStats(Handle<HwStream> stream) {
+    return {};
+}
+
 void MetalDriver::updateStreams(DriverApi* driver) {
 
 }
@@ -1110,6 +1124,11 @@ bool MetalDriver::isParallelShaderCompileSupported() {
     return mContext->shaderCompiler->isParallelShaderCompileSupported();
 }
 
+uint32_t MetalDriver::getShaderCompilerQueueDepth() {
+    // TODO: expose the MetalShaderCompiler queue depth
+    return 0;
+}
+
 bool MetalDriver::isDepthStencilResolveSupported() {
     return false;
 }
@@ -1297,6 +1316,16 @@ void MetalDriver::compilePrograms(CompilerPriorityQueue priority,
     }
 }
 
+void MetalDriver::setCompilerPriorityQueue(Handle<HwProgram> ph,
+        CompilerPriorityQueue priority) {
+    // Metal's shader compiler doesn't expose a priority for queued compilations.
+}
+
+void* MetalDriver::getBufferObjectMapping(Handle<HwBufferObject> boh) {
+    // TODO: shared-storage MTLBuffers could expose their contents pointer here
+    return nullptr;
+}
+
 void MetalDriver::beginRenderPass(Handle<HwRenderTarget> rth,
         const RenderPassParams& params) {
     DEBUG_LOG("beginRenderPass(rth = %d, params = {...})\n", rth.getId());
@@ -1324,8 +1353,17 @@ void MetalDriver::beginRenderPass(Handle<HwRenderTarget> rth,
         mContext->currentRenderPassAbandoned = false;
     }
 
+#if FILAMENT_METAL_PARALLEL_ENCODING
+    // All draws of the pass currently go through a single sub-encoder; sub-encoders are ended in
+    // the order they were created, so this is equivalent to the serial path below.
+    mContext->currentParallelRenderPassEncoder =
+            [getPendingCommandBuffer(mContext) parallelRenderCommandEncoderWithDescriptor:descriptor];
+    mContext->currentRenderPassEncoder =
+            [mContext->currentParallelRenderPassEncoder renderCommandEncoder];
+#else
     mContext->currentRenderPassEncoder =
             [getPendingCommandBuffer(mContext) renderCommandEncoderWithDescriptor:descriptor];
+#endif
     if (!mContext->groupMarkers.empty()) {
         mContext->currentRenderPassEncoder.label =
                 [NSString stringWithCString:mContext->groupMarkers.top()
@@ -1390,6 +1428,10 @@ void MetalDriver::endRenderPass(int dummy) {
     }
 
     [mContext->currentRenderPassEncoder endEncoding];
+#if FILAMENT_METAL_PARALLEL_ENCODING
+    [mContext->currentParallelRenderPassEncoder endEncoding];
+    mContext->currentParallelRenderPassEncoder = nil;
+#endif
 
     // Command encoders are one time use. Set it to nil to release the encoder and ensure we don't
     // accidentally use it again.
@@ -1424,6 +1466,10 @@ void MetalDriver::commit(Handle<HwSwapChain> sch) {
     swapChain->releaseDrawable();
 }
 
+void MetalDriver::setPresentationDamage(Handle<HwSwapChain> sch, Viewport damage) {
+    // CAMetalLayer has no partial-present API, ignored.
+}
+
 void MetalDriver::setPushConstant(backend::ShaderStage stage, uint8_t index,
         backend::PushConstantVariant value) {
     if (UTILS_UNLIKELY(mContext->currentRenderPassAbandoned)) {
@@ -1735,6 +1781,11 @@ void MetalDriver::blitDEPRECATED(TargetBufferFlags buffers,
     }
 }
 
+void MetalDriver::precompilePipeline(PipelineState const& ps) {
+    // TODO: create the MTLRenderPipelineState ahead of time. For now the pipeline is still
+    //       created (and cached) at the first draw.
+}
+
 void MetalDriver::bindPipeline(PipelineState const& ps) {
     if (UTILS_UNLIKELY(mContext->currentRenderPassAbandoned)) {
         return;
@@ -1987,6 +2038,12 @@ void MetalDriver::bindDescriptorSet(
     }
 }
 
+void MetalDriver::bindDescriptorSets(backend::DescriptorSetBindingArray&& bindings) {
+    for (auto& entry : bindings) {
+        bindDescriptorSet(entry.dsh, entry.set, std::move(entry.offsets));
+    }
+}
+
 void MetalDriver::draw2(uint32_t indexOffset, uint32_t indexCount, uint32_t instanceCount) {
     if (UTILS_UNLIKELY(mContext->currentRenderPassAbandoned)) {
         return;
@@ -130,6 +130,12 @@ MetalSwapChain::MetalSwapChain(
     // Also needed for rendering directly into the SwapChain during refraction.
     nativeWindow.framebufferOnly = NO;
 
+    if (flags & SwapChain::CONFIG_LOW_LATENCY) {
+        // don't let the presentation layer hold on to a third drawable; this trades a little
+        // throughput for a frame of latency
+        layer.maximumDrawableCount = 2;
+    }
+
     layer.device = context.device;
 }
 
@@ -596,6 +602,22 @@ MetalTexture::MetalTexture(MetalContext& context, SamplerType target, uint8_t le
         }
     };
 
+    // Sampleable textures (i.e. material textures, which dominate texture memory) are placed in
+    // the shared texture heap when one was configured, letting Metal recycle their memory as they
+    // come and go. Attachments keep dedicated allocations, as they may use memoryless storage or
+    // outlive heap fragmentation patterns we'd rather avoid.
+    auto const allocateTexture = [&context, usage](MTLTextureDescriptor* descriptor) {
+        constexpr TextureUsage anyAttachment = TextureUsage::COLOR_ATTACHMENT |
+                TextureUsage::DEPTH_ATTACHMENT | TextureUsage::STENCIL_ATTACHMENT;
+        if (context.textureHeap && !any(usage & anyAttachment)) {
+            if (id<MTLTexture> t = [context.textureHeap newTextureWithDescriptor:descriptor]) {
+                return t;
+            }
+            // The heap is exhausted (or incompatible); fall back to a dedicated allocation.
+        }
+        return [context.device newTextureWithDescriptor:descriptor];
+    };
+
     MTLTextureDescriptor* descriptor;
     switch (target) {
         case SamplerType::SAMPLER_2D:
@@ -610,7 +632,7 @@ MetalTexture::MetalTexture(MetalContext& context, SamplerType target, uint8_t le
             descriptor.sampleCount = multisampled ? samples : 1;
             descriptor.usage = getMetalTextureUsage(usage);
             descriptor.storageMode = MTLStorageModePrivate;
-            texture = [context.device newTextureWithDescriptor:descriptor];
+            texture = allocateTexture(descriptor);
             break;
         case SamplerType::SAMPLER_CUBEMAP:
         case SamplerType::SAMPLER_CUBEMAP_ARRAY:
@@ -624,7 +646,7 @@ MetalTexture::MetalTexture(MetalContext& context, SamplerType target, uint8_t le
             descriptor.mipmapLevelCount = levels;
             descriptor.usage = getMetalTextureUsage(usage);
             descriptor.storageMode = MTLStorageModePrivate;
-            texture = [context.device newTextureWithDescriptor:descriptor];
+            texture = allocateTexture(descriptor);
             break;
         case SamplerType::SAMPLER_3D:
             descriptor = [MTLTextureDescriptor new];
@@ -636,7 +658,7 @@ MetalTexture::MetalTexture(MetalContext& context, SamplerType target, uint8_t le
             descriptor.mipmapLevelCount = levels;
             descriptor.usage = getMetalTextureUsage(usage);
             descriptor.storageMode = MTLStorageModePrivate;
-            texture = [context.device newTextureWithDescriptor:descriptor];
+            texture = allocateTexture(descriptor);
             break;
         case SamplerType::SAMPLER_EXTERNAL:
             // If we're using external textures (CVPixelBufferRefs), we don't need to make any
@@ -144,6 +144,10 @@ int64_t NoopDriver::getStreamTimestamp(Handle<HwStream> sh) {
     return 0;
 }
 
+StreamStats NoopDriver::getStreamStats(Handle<HwStream> sh) {
+    return {};
+}
+
 void NoopDriver::updateStreams(CommandStream* driver) {
 }
 
@@ -204,6 +208,10 @@ bool NoopDriver::isParallelShaderCompileSupported() {
     return false;
 }
 
+uint32_t NoopDriver::getShaderCompilerQueueDepth() {
+    return 0;
+}
+
 bool NoopDriver::isDepthStencilResolveSupported() {
     return true;
 }
@@ -303,6 +311,13 @@ void NoopDriver::compilePrograms(CompilerPriorityQueue priority,
     }
 }
 
+void NoopDriver::setCompilerPriorityQueue(Handle<HwProgram> ph, CompilerPriorityQueue priority) {
+}
+
+void* NoopDriver::getBufferObjectMapping(Handle<HwBufferObject> boh) {
+    return nullptr;
+}
+
 void NoopDriver::beginRenderPass(Handle<HwRenderTarget> rth, const RenderPassParams& params) {
 }
 
@@ -318,6 +333,9 @@ void NoopDriver::makeCurrent(Handle<HwSwapChain> drawSch, Handle<HwSwapChain> re
 void NoopDriver::commit(Handle<HwSwapChain> sch) {
 }
 
+void NoopDriver::setPresentationDamage(Handle<HwSwapChain> sch, Viewport damage) {
+}
+
 void NoopDriver::setPushConstant(backend::ShaderStage stage, uint8_t index,
         backend::PushConstantVariant value) {
 }
@@ -368,6 +386,9 @@ void NoopDriver::blit(
 void NoopDriver::bindPipeline(PipelineState const& pipelineState) {
 }
 
+void NoopDriver::precompilePipeline(PipelineState const& pipelineState) {
+}
+
 void NoopDriver::bindRenderPrimitive(Handle<HwRenderPrimitive> rph) {
 }
 
@@ -415,6 +436,9 @@ void NoopDriver::bindDescriptorSet(
         backend::DescriptorSetOffsetArray&& offsets) {
 }
 
+void NoopDriver::bindDescriptorSets(backend::DescriptorSetBindingArray&& bindings) {
+}
+
 void NoopDriver::setDebugTag(HandleBase::HandleId handleId, utils::CString tag) {
 }
 
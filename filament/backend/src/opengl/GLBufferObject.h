@@ -40,6 +40,8 @@ struct GLBufferObject : public HwBufferObject {
             GLenum binding;
             void* buffer;
         };
+        // CPU-visible persistent mapping for BufferUsage::SHARED, when supported
+        void* mapped = nullptr;
     } gl;
     BufferUsage usage;
     BufferObjectBinding bindingType;
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GLStagingRing.h"
+
+#include "OpenGLContext.h"
+
+#include <utils/compiler.h>
+#include <utils/debug.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament::backend {
+
+GLStagingRing::GLStagingRing(OpenGLContext& context, Target const target,
+        size_t const sliceSize) noexcept
+        : mContext(context), mSliceSize(sliceSize) {
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    switch (target) {
+        case Target::PIXEL_UNPACK:  mTarget = GL_PIXEL_UNPACK_BUFFER;   break;
+        case Target::COPY_READ:     mTarget = GL_COPY_READ_BUFFER;      break;
+    }
+#endif
+}
+
+GLStagingRing::~GLStagingRing() noexcept {
+    // all GL objects must have been destroyed with terminate()
+    assert_invariant(mBuffer == 0);
+}
+
+void GLStagingRing::bind(GLuint const buffer) noexcept {
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    if (mTarget == GL_COPY_READ_BUFFER) {
+        // GL_COPY_READ_BUFFER is not tracked by OpenGLContext's binding cache, and nothing
+        // else in the driver binds to it, so we talk to GL directly.
+        glBindBuffer(mTarget, buffer);
+    } else {
+        mContext.bindBuffer(mTarget, buffer);
+    }
+#endif
+}
+
+void GLStagingRing::createBuffer() noexcept {
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    glGenBuffers(1, &mBuffer);
+    bind(mBuffer);
+#if defined(GL_MAP_PERSISTENT_BIT) && defined(GL_MAP_COHERENT_BIT)
+    if (mContext.ext.EXT_buffer_storage) {
+        // with EXT_buffer_storage we can keep the whole ring mapped for its lifetime,
+        // saving a map/unmap pair per update
+        glBufferStorage(mTarget, SLICE_COUNT * mSliceSize, nullptr,
+                GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+        mPersistentMapping = glMapBufferRange(mTarget,
+                0, SLICE_COUNT * mSliceSize,
+                GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+    }
+#endif
+    if (!mPersistentMapping) {
+        glBufferData(mTarget, SLICE_COUNT * mSliceSize, nullptr, GL_STREAM_DRAW);
+    }
+    if (glGetError() != GL_NO_ERROR) {
+        // e.g. out of memory; give up on the ring for good, the client-memory path
+        // still works.
+        bind(0);
+        glDeleteBuffers(1, &mBuffer);
+        mBuffer = 0;
+        mPersistentMapping = nullptr;
+        mBufferCreationFailed = true;
+    }
+#endif
+}
+
+void GLStagingRing::advanceSlice() noexcept {
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    // protect the slice we're leaving; everything consuming it has been issued by now
+    assert_invariant(mFences[mSlice] == nullptr);
+    mFences[mSlice] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    mSlice = (mSlice + 1) % SLICE_COUNT;
+    mOffset = 0;
+
+    // wait until the GPU is done with the new slice's previous contents. In the steady
+    // state this fence is several slices old and long signaled.
+    GLsync const fence = mFences[mSlice];
+    if (fence) {
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+        mFences[mSlice] = nullptr;
+    }
+#endif
+}
+
+GLStagingRing::Allocation GLStagingRing::allocate(size_t const size) noexcept {
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    if (UTILS_UNLIKELY(mContext.isES2() || mBufferCreationFailed || size > mSliceSize)) {
+        return {};
+    }
+    if (UTILS_UNLIKELY(mBuffer == 0)) {
+        createBuffer();
+        if (mBuffer == 0) {
+            return {};
+        }
+    }
+    if (mSliceSize - mOffset < size) {
+        advanceSlice();
+    }
+    size_t const offset = mSlice * mSliceSize + mOffset;
+    mOffset = (mOffset + size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    void* vaddr;
+    if (mPersistentMapping) {
+        vaddr = static_cast<uint8_t*>(mPersistentMapping) + offset;
+    } else {
+        bind(mBuffer);
+        // UNSYNCHRONIZED is safe because the slice's fence has been waited on
+        vaddr = glMapBufferRange(mTarget, GLintptr(offset), GLsizeiptr(size),
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (UTILS_UNLIKELY(!vaddr)) {
+            return {};
+        }
+    }
+    return { vaddr, mBuffer, offset };
+#else
+    return {};
+#endif
+}
+
+void GLStagingRing::commit(Allocation const& allocation) noexcept {
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    assert_invariant(allocation.buffer == mBuffer);
+    bind(allocation.buffer);
+    if (!mPersistentMapping) {
+        glUnmapBuffer(mTarget);
+    }
+#endif
+}
+
+void GLStagingRing::terminate() noexcept {
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    for (GLsync& fence : mFences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (mBuffer) {
+        if (mPersistentMapping) {
+            bind(mBuffer);
+            glUnmapBuffer(mTarget);
+            mPersistentMapping = nullptr;
+        }
+        bind(0);
+        glDeleteBuffers(1, &mBuffer);
+        mBuffer = 0;
+    }
+#endif
+}
+
+} // namespace filament::backend
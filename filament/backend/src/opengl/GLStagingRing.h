@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_BACKEND_OPENGL_GLSTAGINGRING_H
+#define TNT_FILAMENT_BACKEND_OPENGL_GLSTAGINGRING_H
+
+#include "gl_headers.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament::backend {
+
+class OpenGLContext;
+
+/*
+ * A fence-tracked GL staging-buffer ring.
+ *
+ * Updating a GL resource from client memory can stall inside the driver when the destination
+ * is in use, because the driver must either wait or copy the data synchronously (some tilers
+ * instead "ghost" the resource, which is just as expensive). Staging the data in a GL buffer
+ * lets the update call return immediately and the GPU (or the driver's transfer queue) pull
+ * the data later.
+ *
+ * The ring is split into a small number of slices. Allocations are carved linearly out of
+ * the current slice; when it's exhausted, a fence is inserted and we move on to the next
+ * slice, waiting on its fence from the previous time around -- this guarantees we never
+ * overwrite data the GPU hasn't consumed yet, while only fencing once per slice.
+ *
+ * The driver keeps two instances: one bound to GL_PIXEL_UNPACK_BUFFER that stages texture
+ * uploads, and one bound to GL_COPY_READ_BUFFER that stages the per-frame UBO traffic,
+ * which is then copied into place with glCopyBufferSubData().
+ */
+class GLStagingRing {
+public:
+    // GL binding point the ring lives on. An enum rather than a raw GLenum so the tokens
+    // don't leak into code that must also compile with ES2-only headers.
+    enum class Target : uint8_t {
+        PIXEL_UNPACK,   // GL_PIXEL_UNPACK_BUFFER, consumed by glTexSubImage*()
+        COPY_READ,      // GL_COPY_READ_BUFFER, consumed by glCopyBufferSubData()
+    };
+
+    struct Allocation {
+        void* vaddr = nullptr;      // CPU address where the staged data must be written
+        GLuint buffer = 0;          // GL buffer holding the allocation
+        size_t offset = 0;          // byte offset of the staged data within the buffer
+        explicit operator bool() const noexcept { return vaddr != nullptr; }
+    };
+
+    GLStagingRing(OpenGLContext& context, Target target, size_t sliceSize) noexcept;
+    ~GLStagingRing() noexcept;
+
+    GLStagingRing(GLStagingRing const&) = delete;
+    GLStagingRing& operator=(GLStagingRing const&) = delete;
+
+    // Returns a writable region of `size` bytes inside the ring, or a null Allocation if the
+    // request cannot be satisfied (ES2, request larger than a slice, or mapping failure).
+    // The caller must then fall back to the client-memory update path.
+    Allocation allocate(size_t size) noexcept;
+
+    // Makes the data written to `allocation` visible to GL and leaves the buffer bound to
+    // the ring's target. Must be called before issuing the GL command that consumes the
+    // allocation.
+    void commit(Allocation const& allocation) noexcept;
+
+    // Destroys all GL objects owned by the ring. Requires a current GL context.
+    void terminate() noexcept;
+
+private:
+    // A slice must be large enough for the largest common streaming update; oversized
+    // requests are rare enough that falling back to the client-memory path is fine.
+    static constexpr size_t SLICE_COUNT = 4;
+    // offsets must be aligned on the consumer's granularity (the pixel type's size for
+    // texture uploads, 4 bytes for buffer copies); 64 covers all of them
+    static constexpr size_t ALIGNMENT = 64;
+
+    void createBuffer() noexcept;
+    void advanceSlice() noexcept;
+    void bind(GLuint buffer) noexcept;
+
+    OpenGLContext& mContext;
+    GLenum mTarget = 0;                     // resolved from Target; 0 with ES2-only headers
+    size_t const mSliceSize;
+    GLuint mBuffer = 0;
+    void* mPersistentMapping = nullptr;     // non-null with EXT_buffer_storage
+    GLsync mFences[SLICE_COUNT] = {};       // protects each slice's previous contents
+    size_t mSlice = 0;                      // slice currently being carved up
+    size_t mOffset = 0;                     // watermark within the current slice
+    bool mBufferCreationFailed = false;
+};
+
+} // namespace filament::backend
+
+#endif // TNT_FILAMENT_BACKEND_OPENGL_GLSTAGINGRING_H
@@ -49,22 +49,31 @@ GLuint OpenGLBlobCache::retrieve(BlobCacheKey* outKey, Platform& platform,
 #ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
     BlobCacheKey key{ program.getCacheId(), program.getSpecializationConstants() };
 
-    // FIXME: use a static buffer to avoid systematic allocation
-    // always attempt with 64 KiB
-    constexpr size_t DEFAULT_BLOB_SIZE = 65536;
-    std::unique_ptr<Blob, decltype(&::free)> blob{ (Blob*)malloc(DEFAULT_BLOB_SIZE), &::free };
+    // first try the backend-managed cache file, which serves the blob without copying it
+    size_t blobSize = 0;
+    std::unique_ptr<Blob, decltype(&::free)> heapBlob{ nullptr, &::free };
+    Blob const* blob = static_cast<Blob const*>(
+            platform.retrieveBlobMapped(key.data(), key.size(), &blobSize));
 
-    size_t const blobSize = platform.retrieveBlob(
-            key.data(), key.size(), blob.get(), DEFAULT_BLOB_SIZE);
+    if (!blob) {
+        // FIXME: use a static buffer to avoid systematic allocation
+        // always attempt with 64 KiB
+        constexpr size_t DEFAULT_BLOB_SIZE = 65536;
+        heapBlob.reset((Blob*)malloc(DEFAULT_BLOB_SIZE));
+
+        blobSize = platform.retrieveBlob(
+                key.data(), key.size(), heapBlob.get(), DEFAULT_BLOB_SIZE);
 
-    if (blobSize > 0) {
         if (blobSize > DEFAULT_BLOB_SIZE) {
             // our buffer was too small, retry with the correct size
-            blob.reset((Blob*)malloc(blobSize));
+            heapBlob.reset((Blob*)malloc(blobSize));
             platform.retrieveBlob(
-                    key.data(), key.size(), blob.get(), blobSize);
+                    key.data(), key.size(), heapBlob.get(), blobSize);
         }
+        blob = heapBlob.get();
+    }
 
+    if (blobSize > 0) {
         GLsizei const programBinarySize = GLsizei(blobSize - sizeof(Blob));
 
         programId = glCreateProgram();
@@ -306,6 +306,14 @@ void OpenGLContext::synchronizeStateAndCache(size_t index) noexcept {
     mDefaultFbo[index].reset();
 
     contextIndex = index;
+
+    if (index == 1) {
+        // the protected context is always destroyed when we're done with it, so the content of
+        // its VAOs is lost and they need to be re-specified. Context 0's VAOs are intact and
+        // its vaoAge is left alone.
+        state.vaoAge[index]++;
+    }
+
     resetState();
 }
 
@@ -697,6 +705,9 @@ void OpenGLContext::initExtensionsGLES(Extensions* ext, GLint major, GLint minor
     ext->APPLE_color_buffer_packed_float = exts.has("GL_APPLE_color_buffer_packed_float"sv);
 #ifndef __EMSCRIPTEN__
     ext->EXT_clip_control = exts.has("GL_EXT_clip_control"sv);
+#endif
+#ifndef __EMSCRIPTEN__
+    ext->EXT_buffer_storage = exts.has("GL_EXT_buffer_storage"sv);
 #endif
     ext->EXT_clip_cull_distance = exts.has("GL_EXT_clip_cull_distance"sv);
     ext->EXT_color_buffer_float = exts.has("GL_EXT_color_buffer_float"sv);
@@ -808,6 +819,10 @@ void OpenGLContext::initExtensionsGL(Extensions* ext, GLint major, GLint minor)
     if (major > 4 || (major == 4 && minor >= 2)) {
         ext->ARB_shading_language_packing = true;
     }
+    // OpenGL 4.4 implies ARB_buffer_storage
+    if (major > 4 || (major == 4 && minor >= 4)) {
+        ext->EXT_buffer_storage = true;
+    }
     // OpenGL 4.3 implies EXT_discard_framebuffer
     if (major > 4 || (major == 4 && minor >= 3)) {
         ext->EXT_discard_framebuffer = true;
@@ -1144,39 +1159,10 @@ void OpenGLContext::resetState() noexcept {
     }
 
     // state.textures
-    // Reset state.textures to its default state to avoid the complexity and error-prone
-    // nature of resetting the GL state to its existing state
-    state.textures = {};
-    const std::pair<GLuint, bool> textureTargets[] = {
-            { GL_TEXTURE_2D,                true },
-            { GL_TEXTURE_2D_ARRAY,          true },
-            { GL_TEXTURE_CUBE_MAP,          true },
-            { GL_TEXTURE_3D,                true },
-#if defined(BACKEND_OPENGL_LEVEL_GLES31)
-            { GL_TEXTURE_2D_MULTISAMPLE,    true },
-#endif
-#if !defined(__EMSCRIPTEN__)
-#if defined(GL_OES_EGL_image_external)
-            { GL_TEXTURE_EXTERNAL_OES,      ext.OES_EGL_image_external_essl3 },
-#endif
-#if defined(BACKEND_OPENGL_VERSION_GL) || defined(GL_EXT_texture_cube_map_array)
-            { GL_TEXTURE_CUBE_MAP_ARRAY,    ext.EXT_texture_cube_map_array },
-#endif
-#endif
-    };
-    for (GLint unit = 0; unit < gets.max_combined_texture_image_units; ++unit) {
-        glActiveTexture(GL_TEXTURE0 + unit);
-        if (state.major > 2) {
-#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
-            glBindSampler(unit, 0);
-#endif
-        }
-        for (auto [target, available] : textureTargets) {
-            if (available) {
-                glBindTexture(target, 0);
-            }
-        }
-    }
+    // Texture-unit bindings are resynchronized lazily: bumping state.age above marks every
+    // unit stale, and bindTexture()/bindSampler() re-issue the shadowed bindings the first
+    // time a stale unit is used. This avoids issuing units x targets GL calls on each
+    // context change. Only the active texture unit needs to be re-issued here.
     glActiveTexture(GL_TEXTURE0 + state.textures.active);
 
     // state.unpack
@@ -71,15 +71,17 @@ public:
 
         mutable utils::bitset<uint16_t> vertexAttribArray;      // 2
 
-        uint8_t reserved[2] = {};                               // 2
+        uint8_t reserved[1] = {};                               // 1
 
         // if this differs from vertexBufferWithObjects->bufferObjectsVersion, this VAO needs to
         // be updated (see OpenGLDriver::updateVertexArrayObject())
         uint8_t vertexBufferVersion = 0;                        // 1
 
-        // if this differs from OpenGLContext::state.age, this VAO needs to
-        // be updated (see OpenGLDriver::updateVertexArrayObject())
-        uint8_t stateVersion = 0;                               // 1
+        // if this differs from OpenGLContext::state.vaoAge for the given context, this VAO
+        // needs to be updated (see OpenGLDriver::updateVertexArrayObject()). Tracked
+        // per-context because a VAO's content survives makeCurrent transitions, but not the
+        // destruction of the protected context.
+        uint8_t stateVersion[2] = {};                           // 2
 
         // If this differs from OpenGLContext::state.age, this VAO's name needs to be updated.
         // See OpenGLContext::bindVertexArray()
@@ -223,6 +225,7 @@ public:
     struct Extensions {
         bool APPLE_color_buffer_packed_float;
         bool ARB_shading_language_packing;
+        bool EXT_buffer_storage;
         bool EXT_clip_control;
         bool EXT_clip_cull_distance;
         bool EXT_color_buffer_float;
@@ -453,6 +456,10 @@ public:
                 GLuint sampler = 0;
                 GLuint target = 0;
                 GLuint id = 0;
+                // if this differs from state.age, the actual bindings of this unit are
+                // unknown (e.g. after a context change) and are lazily re-issued from the
+                // shadowed state on the next bindTexture()/bindSampler() call.
+                uint8_t stateVersion = 0;
             } units[MAX_TEXTURE_UNIT_COUNT];
         } textures;
 
@@ -471,6 +478,9 @@ public:
             vec2glf depthRange { 0.0f, 1.0f };
         } window;
         uint8_t age = 0;
+        // per-context generation of VAO content; unlike `age`, this is not bumped when simply
+        // switching back to a context whose VAOs are intact (see synchronizeStateAndCache())
+        uint8_t vaoAge[2] = {};
     } state;
 
     struct Procs {
@@ -686,9 +696,20 @@ void OpenGLContext::bindSampler(GLuint unit, GLuint sampler) noexcept {
     assert_invariant(unit < MAX_TEXTURE_UNIT_COUNT);
     assert_invariant(mFeatureLevel >= FeatureLevel::FEATURE_LEVEL_1);
 #ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
-    update_state(state.textures.units[unit].sampler, sampler, [&]() {
+    auto& unitState = state.textures.units[unit];
+    bool const force = UTILS_UNLIKELY(unitState.stateVersion != state.age);
+    if (force) {
+        // the actual bindings of this unit are unknown, re-issue the texture binding from the
+        // shadowed state; the sampler binding is forced below.
+        unitState.stateVersion = state.age;
+        if (unitState.target) {
+            activeTexture(unit);
+            glBindTexture(unitState.target, unitState.id);
+        }
+    }
+    update_state(unitState.sampler, sampler, [&]() {
         glBindSampler(unit, sampler);
-    });
+    }, force);
 #endif
 }
 
@@ -774,16 +795,28 @@ void OpenGLContext::bindBufferRange(GLenum target, GLuint index, GLuint buffer,
 }
 
 void OpenGLContext::bindTexture(GLuint unit, GLuint target, GLuint texId, bool external) noexcept {
+    auto& unitState = state.textures.units[unit];
+    bool const force = UTILS_UNLIKELY(unitState.stateVersion != state.age);
+    if (force) {
+        // the actual bindings of this unit are unknown, re-issue the sampler binding from the
+        // shadowed state; the texture binding is forced below.
+        unitState.stateVersion = state.age;
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+        if (state.major > 2) {
+            glBindSampler(unit, unitState.sampler);
+        }
+#endif
+    }
     //  another texture is bound to the same unit with a different target,
     //  unbind the texture from the current target
-    update_state(state.textures.units[unit].target, target, [&]() {
+    update_state(unitState.target, target, [&]() {
         activeTexture(unit);
-        glBindTexture(state.textures.units[unit].target, 0);
+        glBindTexture(unitState.target, 0);
     });
-    update_state(state.textures.units[unit].id, texId, [&]() {
+    update_state(unitState.id, texId, [&]() {
         activeTexture(unit);
         glBindTexture(target, texId);
-    }, external);
+    }, external || force);
 }
 
 void OpenGLContext::useProgram(GLuint program) noexcept {
@@ -795,7 +828,7 @@ void OpenGLContext::useProgram(GLuint program) noexcept {
 void OpenGLContext::enableVertexAttribArray(RenderPrimitive const* rp, GLuint index) noexcept {
     assert_invariant(rp);
     assert_invariant(index < rp->vertexAttribArray.size());
-    bool const force = rp->stateVersion != state.age;
+    bool const force = rp->stateVersion[contextIndex] != state.vaoAge[contextIndex];
     if (UTILS_UNLIKELY(force || !rp->vertexAttribArray[index])) {
         rp->vertexAttribArray.set(index);
         glEnableVertexAttribArray(index);
@@ -805,7 +838,7 @@ void OpenGLContext::enableVertexAttribArray(RenderPrimitive const* rp, GLuint in
 void OpenGLContext::disableVertexAttribArray(RenderPrimitive const* rp, GLuint index) noexcept {
     assert_invariant(rp);
     assert_invariant(index < rp->vertexAttribArray.size());
-    bool const force = rp->stateVersion != state.age;
+    bool const force = rp->stateVersion[contextIndex] != state.vaoAge[contextIndex];
     if (UTILS_UNLIKELY(force || rp->vertexAttribArray[index])) {
         rp->vertexAttribArray.unset(index);
         glDisableVertexAttribArray(index);
@@ -276,6 +276,9 @@ OpenGLDriver::DebugMarker::~DebugMarker() noexcept {
 OpenGLDriver::OpenGLDriver(OpenGLPlatform* platform, const Platform::DriverConfig& driverConfig) noexcept
         : mPlatform(*platform),
           mContext(mPlatform, driverConfig),
+          // 2 MiB slices for texture uploads, 1 MiB slices for the per-frame UBO traffic
+          mPixelBufferRing(mContext, GLStagingRing::Target::PIXEL_UNPACK, 2u * 1024u * 1024u),
+          mUniformStreamRing(mContext, GLStagingRing::Target::COPY_READ, 1u * 1024u * 1024u),
           mShaderCompilerService(*this),
           mHandleAllocator("Handles",
                   driverConfig.handleArenaSize,
@@ -323,6 +326,9 @@ Dispatcher OpenGLDriver::getDispatcher() const noexcept {
 // ------------------------------------------------------------------------------------------------
 
 void OpenGLDriver::terminate() {
+    // drain pending maintenance work (deferred GL object deletions)
+    executeDeferredOps(std::numeric_limits<size_t>::max());
+
     // wait for the GPU to finish executing all commands
     glFinish();
 
@@ -347,6 +353,9 @@ void OpenGLDriver::terminate() {
     delete mCurrentPushConstants;
     mCurrentPushConstants = nullptr;
 
+    mPixelBufferRing.terminate();
+    mUniformStreamRing.terminate();
+
     mContext.terminate();
 
     mPlatform.terminate();
@@ -364,6 +373,9 @@ ShaderLanguage OpenGLDriver::getShaderLanguage() const noexcept {
 // Change and track GL state
 // ------------------------------------------------------------------------------------------------
 void OpenGLDriver::resetState(int) {
+    // foreign GL code may have modified the content of our VAOs, so they can't be trusted
+    // anymore (unlike for context changes, where they survive)
+    mContext.state.vaoAge[mContext.contextIndex]++;
     mContext.resetState();
 }
 
@@ -689,7 +701,17 @@ void OpenGLDriver::createBufferObjectR(Handle<HwBufferObject> boh,
         bo->gl.binding = getBufferBindingType(bindingType);
         glGenBuffers(1, &bo->gl.id);
         gl.bindBuffer(bo->gl.binding, bo->gl.id);
-        glBufferData(bo->gl.binding, byteCount, nullptr, getBufferUsage(usage));
+#ifdef GL_MAP_PERSISTENT_BIT
+        if (UTILS_UNLIKELY(usage == BufferUsage::SHARED && gl.ext.EXT_buffer_storage)) {
+            // persistently map the buffer, so the client can write into it directly
+            GLbitfield const access = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(bo->gl.binding, byteCount, nullptr, access);
+            bo->gl.mapped = glMapBufferRange(bo->gl.binding, 0, byteCount, access);
+        } else
+#endif
+        {
+            glBufferData(bo->gl.binding, byteCount, nullptr, getBufferUsage(usage));
+        }
     }
 
     CHECK_GL_ERROR()
@@ -1242,7 +1264,7 @@ void OpenGLDriver::updateVertexArrayObject(GLRenderPrimitive* rp, GLVertexBuffer
 #endif
 
     if (UTILS_LIKELY(rp->gl.vertexBufferVersion == vb->bufferObjectsVersion &&
-                     rp->gl.stateVersion == gl.state.age)) {
+                     rp->gl.stateVersion[gl.contextIndex] == gl.state.vaoAge[gl.contextIndex])) {
         return;
     }
 
@@ -1305,7 +1327,7 @@ void OpenGLDriver::updateVertexArrayObject(GLRenderPrimitive* rp, GLVertexBuffer
         }
     }
 
-    rp->gl.stateVersion = gl.state.age;
+    rp->gl.stateVersion[gl.contextIndex] = gl.state.vaoAge[gl.contextIndex];
     if (UTILS_LIKELY(gl.ext.OES_vertex_array_object)) {
         rp->gl.vertexBufferVersion = vb->bufferObjectsVersion;
     } else {
@@ -1884,7 +1906,15 @@ void OpenGLDriver::destroyBufferObject(Handle<HwBufferObject> boh) {
         if (UTILS_UNLIKELY(bo->bindingType == BufferObjectBinding::UNIFORM && gl.isES2())) {
             free(bo->gl.buffer);
         } else {
-            gl.deleteBuffer(bo->gl.id, bo->gl.binding);
+            if (UTILS_UNLIKELY(bo->gl.mapped)) {
+                gl.bindBuffer(bo->gl.binding, bo->gl.id);
+                glUnmapBuffer(bo->gl.binding);
+            }
+            // the GL name can't be reused until the deferred deletion actually runs, so
+            // postponing the state-tracker cleanup along with it is safe
+            runAtIdle([this, id = bo->gl.id, binding = bo->gl.binding] {
+                mContext.deleteBuffer(id, binding);
+            });
         }
         destruct(boh, bo);
     }
@@ -1951,7 +1981,7 @@ void OpenGLDriver::destroyTexture(Handle<HwTexture> th) {
                     if (UTILS_UNLIKELY(t->target == SamplerType::SAMPLER_EXTERNAL)) {
                         mPlatform.destroyExternalImageTexture(t->externalTexture);
                     } else {
-                        glDeleteTextures(1, &t->gl.id);
+                        runAtIdle([id = t->gl.id] { glDeleteTextures(1, &id); });
                     }
                 } else {
                     // The Handle<HwTexture> is always destroyed. For extra precaution we also
@@ -1960,10 +1990,10 @@ void OpenGLDriver::destroyTexture(Handle<HwTexture> th) {
                 }
             } else {
                 assert_invariant(t->gl.target == GL_RENDERBUFFER);
-                glDeleteRenderbuffers(1, &t->gl.id);
+                runAtIdle([id = t->gl.id] { glDeleteRenderbuffers(1, &id); });
             }
             if (t->gl.sidecarRenderBufferMS) {
-                glDeleteRenderbuffers(1, &t->gl.sidecarRenderBufferMS);
+                runAtIdle([id = t->gl.sidecarRenderBufferMS] { glDeleteRenderbuffers(1, &id); });
             }
         } else {
             gl.unbindTexture(t->gl.target, t->gl.id);
@@ -2100,17 +2130,19 @@ Handle<HwStream> OpenGLDriver::createStreamAcquired() {
 // Stashes an acquired external image and a release callback. The image is not bound to OpenGL until
 // the subsequent call to beginFrame (see updateStreamAcquired).
 //
-// setAcquiredImage should be called by the user outside of beginFrame / endFrame, and should be
-// called only once per frame. If the user pushes images to the same stream multiple times in a
-// single frame, we emit a warning and honor only the final image, but still invoke all callbacks.
+// setAcquiredImage should be called by the user outside of beginFrame / endFrame. The stream acts
+// as a mailbox: pushing several images between two frames is expected with high-rate camera or
+// video feeds, and only the newest image is latched. A superseded image is released immediately
+// -- its callback still runs -- and counted in the stream's statistics.
 void OpenGLDriver::setAcquiredImage(Handle<HwStream> sh, void* hwbuffer, const math::mat3f& transform,
         CallbackHandler* handler, StreamCallback cb, void* userData) {
     GLStream* glstream = handle_cast<GLStream*>(sh);
     assert_invariant(glstream->streamType == StreamType::ACQUIRED);
 
-    if (UTILS_UNLIKELY(glstream->user_thread.pending.image)) {
+    bool const wasPending = glstream->user_thread.pending.image != nullptr;
+    if (UTILS_UNLIKELY(wasPending)) {
         scheduleRelease(glstream->user_thread.pending);
-        LOG(WARNING) << "Acquired image is set more than once per frame.";
+        glstream->user_thread.stats.framesSkipped++;
     }
 
     glstream->user_thread.pending = mPlatform.transformAcquiredImage({
@@ -2121,7 +2153,12 @@ void OpenGLDriver::setAcquiredImage(Handle<HwStream> sh, void* hwbuffer, const m
         // If there's no pending image, do nothing. Note that GL_OES_EGL_image does not let you pass
         // NULL to glEGLImageTargetTexture2DOES, and there is no concept of "detaching" an
         // EGLimage from a texture.
-        mStreamsWithPendingAcquiredImage.push_back(glstream);
+        glstream->user_thread.stats.framesAcquired++;
+        glstream->user_thread.pushTime = std::chrono::steady_clock::now();
+        if (!wasPending) {
+            // a superseded image keeps the stream's single slot in the pending list
+            mStreamsWithPendingAcquiredImage.push_back(glstream);
+        }
     }
 }
 
@@ -2134,6 +2171,16 @@ void OpenGLDriver::updateStreams(DriverApi* driver) {
             assert_invariant(s);
             assert_invariant(s->streamType == StreamType::ACQUIRED);
 
+            if (UTILS_UNLIKELY(s->user_thread.pending.image == nullptr)) {
+                // the pending image was superseded by one the platform rejected; the currently
+                // latched image stays bound
+                continue;
+            }
+
+            s->user_thread.stats.latchLatencyNanos = std::chrono::duration_cast<
+                    std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - s->user_thread.pushTime).count();
+
             AcquiredImage const previousImage = s->user_thread.acquired;
             s->user_thread.acquired = s->user_thread.pending;
             s->user_thread.pending = { nullptr };
@@ -2184,6 +2231,14 @@ int64_t OpenGLDriver::getStreamTimestamp(Handle<HwStream> sh) {
     return 0;
 }
 
+StreamStats OpenGLDriver::getStreamStats(Handle<HwStream> sh) {
+    if (sh) {
+        GLStream* s = handle_cast<GLStream*>(sh);
+        return s->user_thread.stats;
+    }
+    return {};
+}
+
 math::mat3f OpenGLDriver::getStreamTransformMatrix(Handle<HwStream> sh) {
     if (sh) {
         GLStream* s = handle_cast<GLStream*>(sh);
@@ -2424,6 +2479,10 @@ bool OpenGLDriver::isParallelShaderCompileSupported() {
     return mShaderCompilerService.isParallelShaderCompileSupported();
 }
 
+uint32_t OpenGLDriver::getShaderCompilerQueueDepth() {
+    return mShaderCompilerService.getQueueDepth();
+}
+
 bool OpenGLDriver::isDepthStencilResolveSupported() {
     return true;
 }
@@ -2522,6 +2581,11 @@ void OpenGLDriver::commit(Handle<HwSwapChain> sch) {
 #endif
 }
 
+void OpenGLDriver::setPresentationDamage(Handle<HwSwapChain> sch, Viewport damage) {
+    GLSwapChain* sc = handle_cast<GLSwapChain*>(sch);
+    mPlatform.setPresentationDamage(sc->swapChain, damage);
+}
+
 void OpenGLDriver::makeCurrent(Handle<HwSwapChain> schDraw, Handle<HwSwapChain> schRead) {
     DEBUG_MARKER()
 
@@ -2682,6 +2746,9 @@ void OpenGLDriver::updateBufferObject(
         assert_invariant(bo->gl.buffer);
         memcpy(static_cast<uint8_t*>(bo->gl.buffer) + byteOffset, bd.buffer, bd.size);
         bo->age++;
+    } else if (UTILS_UNLIKELY(bo->gl.mapped)) {
+        // the buffer is persistently mapped, we can't use glBufferData/glBufferSubData on it
+        memcpy(static_cast<uint8_t*>(bo->gl.mapped) + byteOffset, bd.buffer, bd.size);
     } else {
         assert_invariant(bo->gl.id);
         gl.bindBuffer(bo->gl.binding, bo->gl.id);
@@ -2718,11 +2785,28 @@ void OpenGLDriver::updateBufferObjectUnsynchronized(
         assert_invariant(bo->gl.id);
         assert_invariant(bd.size + byteOffset <= bo->byteCount);
 
-        if (bo->gl.binding != GL_UNIFORM_BUFFER) {
+        if (bo->gl.binding != GL_UNIFORM_BUFFER || bo->gl.mapped) {
             // TODO: use updateBuffer() for all types of buffer? Make sure GL supports that.
             updateBufferObject(boh, std::move(bd), byteOffset);
         } else {
             auto& gl = mContext;
+
+            // Stage the data in the streaming ring and let the GPU copy it into place.
+            // Mapping the UBO itself unsynchronized is notionally cheaper, but on tilers
+            // (Adreno/Mali) it can trigger internal ghosting or a stall when the buffer is
+            // in flight; glCopyBufferSubData() is ordered in the command stream and never
+            // exposes an in-flight buffer to the CPU.
+            if (auto const staging = mUniformStreamRing.allocate(bd.size)) {
+                memcpy(staging.vaddr, bd.buffer, bd.size);
+                mUniformStreamRing.commit(staging); // leaves the ring on GL_COPY_READ_BUFFER
+                gl.bindBuffer(bo->gl.binding, bo->gl.id);
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, bo->gl.binding,
+                        GLintptr(staging.offset), byteOffset, GLsizeiptr(bd.size));
+                scheduleDestroy(std::move(bd));
+                CHECK_GL_ERROR()
+                return;
+            }
+
             gl.bindBuffer(bo->gl.binding, bo->gl.id);
 retry:
             void* const vaddr = glMapBufferRange(bo->gl.binding, byteOffset, (GLsizeiptr)bd.size,
@@ -2756,7 +2840,7 @@ void OpenGLDriver::resetBufferObject(Handle<HwBufferObject> boh) {
 
     if (UTILS_UNLIKELY(bo->bindingType == BufferObjectBinding::UNIFORM && gl.isES2())) {
         // nothing to do here
-    } else {
+    } else if (UTILS_LIKELY(!bo->gl.mapped)) { // immutable storage can't be orphaned
         assert_invariant(bo->gl.id);
         gl.bindBuffer(bo->gl.binding, bo->gl.id);
         glBufferData(bo->gl.binding, bo->byteCount, nullptr, getBufferUsage(bo->usage));
@@ -2837,9 +2921,24 @@ void OpenGLDriver::setTextureData(GLTexture const* t, uint32_t level,
     size_t const bpp = PBD::computeDataSize(p.format, p.type, 1, 1, 1);
     size_t const bpr = PBD::computeDataSize(p.format, p.type, stride, 1, p.alignment);
     size_t const bpl = bpr * height; // TODO: PBD should have a "layer stride"
-    void const* const buffer = static_cast<char const*>(p.buffer)
+    void const* buffer = static_cast<char const*>(p.buffer)
             + bpp* p.left + bpr * p.top + bpl * 0; // TODO: PBD should have a p.depth
 
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    // Stage the pixels in our PBO ring when possible, so that glTexSubImage*() below doesn't
+    // have to copy -- or worse, wait on -- client memory while the texture is in use.
+    bool usingPixelBufferRing = false;
+    size_t const uploadSize = std::min(bpl * std::max(depth, 1u),
+            p.size - size_t(static_cast<char const*>(buffer) - static_cast<char const*>(p.buffer)));
+    if (auto const staging = mPixelBufferRing.allocate(uploadSize)) {
+        memcpy(staging.vaddr, buffer, uploadSize);
+        mPixelBufferRing.commit(staging); // leaves the PBO bound to GL_PIXEL_UNPACK_BUFFER
+        // from here on, `buffer` is an offset into the bound PBO
+        buffer = reinterpret_cast<void const*>(uintptr_t(staging.offset));
+        usingPixelBufferRing = true;
+    }
+#endif
+
     switch (t->target) {
         case SamplerType::SAMPLER_EXTERNAL:
             // if we get there, it's because the user is trying to use an external texture,
@@ -2901,6 +3000,12 @@ void OpenGLDriver::setTextureData(GLTexture const* t, uint32_t level,
         }
     }
 
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    if (usingPixelBufferRing) {
+        gl.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+#endif
+
     scheduleDestroy(std::move(p));
 
     CHECK_GL_ERROR()
@@ -3130,6 +3235,22 @@ void OpenGLDriver::compilePrograms(CompilerPriorityQueue,
     }
 }
 
+void* OpenGLDriver::getBufferObjectMapping(Handle<HwBufferObject> boh) {
+    if (boh) {
+        GLBufferObject const* const bo = handle_cast<const GLBufferObject*>(boh);
+        return bo->gl.mapped;
+    }
+    return nullptr;
+}
+
+void OpenGLDriver::setCompilerPriorityQueue(Handle<HwProgram> ph,
+        CompilerPriorityQueue const priority) {
+    if (ph) {
+        OpenGLProgram* const p = handle_cast<OpenGLProgram*>(ph);
+        p->setPriorityQueue(getShaderCompilerService(), priority);
+    }
+}
+
 void OpenGLDriver::beginRenderPass(Handle<HwRenderTarget> rth,
         const RenderPassParams& params) {
     DEBUG_MARKER()
@@ -3615,6 +3736,23 @@ void OpenGLDriver::readBufferSubData(BufferObjectHandle boh,
 }
 
 
+// how many deferred maintenance items we process per tick()/endFrame(); at ~20us per GL
+// object deletion this bounds the per-frame cost to about a millisecond and a half
+static constexpr size_t DEFERRED_OPS_BUDGET = 64;
+
+void OpenGLDriver::runAtIdle(std::function<void()> fn) noexcept {
+    mDeferredOps.push_back(std::move(fn));
+}
+
+void OpenGLDriver::executeDeferredOps(size_t budget) noexcept {
+    auto& v = mDeferredOps;
+    budget = std::min(budget, v.size());
+    while (budget--) {
+        v.front()();
+        v.pop_front();
+    }
+}
+
 void OpenGLDriver::runEveryNowAndThen(std::function<bool()> fn) noexcept {
     mEveryNowAndThenOps.push_back(std::move(fn));
 }
@@ -3681,6 +3819,7 @@ void OpenGLDriver::tick(int) {
     executeGpuCommandsCompleteOps();
 #endif
     executeEveryNowAndThenOps();
+    executeDeferredOps(DEFERRED_OPS_BUDGET);
     getShaderCompilerService().tick();
 }
 
@@ -3739,6 +3878,7 @@ void OpenGLDriver::endFrame(UTILS_UNUSED uint32_t frameId) {
 #endif
     //FILAMENT_TRACING_NAME(FILAMENT_TRACING_CATEGORY_FILAMENT, "glFinish");
     //glFinish();
+    executeDeferredOps(DEFERRED_OPS_BUDGET);
     mPlatform.endFrame(frameId);
     insertEventMarker("endFrame");
 }
@@ -3772,6 +3912,8 @@ void OpenGLDriver::flush(int) {
 
 void OpenGLDriver::finish(int) {
     DEBUG_MARKER()
+    // finish() is the escape hatch (e.g. at shutdown): drain all pending maintenance work
+    executeDeferredOps(std::numeric_limits<size_t>::max());
     glFinish();
 #ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
     executeGpuCommandsCompleteOps();
@@ -4076,6 +4218,11 @@ void OpenGLDriver::blitDEPRECATED(TargetBufferFlags buffers,
 #endif
 }
 
+void OpenGLDriver::precompilePipeline(PipelineState const&) {
+    // GL has no monolithic pipeline objects; shader compilation/linking is already handled
+    // ahead of time by compilePrograms() / ShaderCompilerService.
+}
+
 void OpenGLDriver::bindPipeline(PipelineState const& state) {
     DEBUG_MARKER()
     auto& gl = mContext;
@@ -4145,6 +4292,12 @@ void OpenGLDriver::bindDescriptorSet(
     }
 }
 
+void OpenGLDriver::bindDescriptorSets(DescriptorSetBindingArray&& bindings) {
+    for (auto& entry : bindings) {
+        bindDescriptorSet(entry.dsh, entry.set, std::move(entry.offsets));
+    }
+}
+
 void OpenGLDriver::updateDescriptors(bitset8 invalidDescriptorSets) noexcept {
     assert_invariant(mBoundProgram);
     auto const offsetOnly = mInvalidDescriptorSetBindingOffsets & ~mInvalidDescriptorSetBindings;
@@ -24,6 +24,7 @@
 #include "GLBufferObject.h"
 #include "GLDescriptorSet.h"
 #include "GLDescriptorSetLayout.h"
+#include "GLStagingRing.h"
 #include "GLTexture.h"
 #include "ShaderCompilerService.h"
 
@@ -50,7 +51,9 @@
 #include <tsl/robin_map.h>
 
 #include <array>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -162,6 +165,8 @@ public:
             AcquiredImage acquired;
             AcquiredImage pending;
             math::mat3f transform;
+            StreamStats stats;
+            std::chrono::steady_clock::time_point pushTime{};
         } user_thread;
 
          math::mat3f transform;
@@ -199,6 +204,8 @@ public:
 private:
     OpenGLPlatform& mPlatform;
     OpenGLContext mContext;
+    GLStagingRing mPixelBufferRing;
+    GLStagingRing mUniformStreamRing;
     ShaderCompilerService mShaderCompilerService;
 
     friend class TimerQueryFactory;
@@ -391,6 +398,13 @@ private:
     void executeEveryNowAndThenOps() noexcept;
     std::vector<std::function<bool()>> mEveryNowAndThenOps;
 
+    // deferred maintenance work (e.g. GL object deletion), drained in FIFO order with a
+    // per-call budget during tick() and endFrame(), and fully by finish() and terminate(),
+    // so bulk destruction (scene unload) doesn't spike a single frame.
+    void runAtIdle(std::function<void()> fn) noexcept;
+    void executeDeferredOps(size_t budget) noexcept;
+    std::deque<std::function<void()>> mDeferredOps;
+
     const Platform::DriverConfig mDriverConfig;
     Platform::DriverConfig const& getDriverConfig() const noexcept { return mDriverConfig; }
 
@@ -90,6 +90,10 @@ void OpenGLPlatform::endFrame(uint32_t frameId) noexcept {
 void OpenGLPlatform::preCommit() noexcept {
 }
 
+void OpenGLPlatform::setPresentationDamage(UTILS_UNUSED SwapChain* swapChain,
+        UTILS_UNUSED Viewport const& damage) noexcept {
+}
+
 OpenGLPlatform::ContextType OpenGLPlatform::getCurrentContextType() const noexcept {
     return ContextType::UNPROTECTED;
 }
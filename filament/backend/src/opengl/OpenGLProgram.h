@@ -75,6 +75,14 @@ public:
         return true;
     }
 
+    // Changes the priority of this program's pending compilation, if there is one.
+    void setPriorityQueue(ShaderCompilerService& compiler,
+            CompilerPriorityQueue const priorityQueue) noexcept {
+        if (UTILS_UNLIKELY(mToken)) {
+            compiler.setPriorityQueue(mToken, priorityQueue);
+        }
+    }
+
     GLuint getBufferBinding(descriptor_set_t set, descriptor_binding_t binding) const noexcept {
         return mBindingMap.get(set, binding);
     }
@@ -42,7 +42,9 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <chrono>
 #include <mutex>
 #include <memory>
 #include <string>
@@ -363,10 +365,33 @@ GLuint ShaderCompilerService::getProgram(program_token_t& token) {
     token = nullptr; // This will try submitting a callback handle to the callback manager.
 }
 
+void ShaderCompilerService::setPriorityQueue(program_token_t const& token,
+        CompilerPriorityQueue const priorityQueue) noexcept {
+    if (mMode == Mode::THREAD_POOL) {
+        mCompilerThreadPool.requeue(priorityQueue, token);
+        return;
+    }
+    // the tick-op based modes process their ops in priority order, so it's enough to move the
+    // op to its new place in the list
+    auto& ops = mRunAtNextTickOps;
+    auto const pos = std::find_if(ops.begin(), ops.end(), [&](const auto& item) {
+        return std::get<1>(item) == token;
+    });
+    if (pos != ops.end() && std::get<0>(*pos) != priorityQueue) {
+        Job job{ std::move(std::get<2>(*pos)) };
+        ops.erase(pos);
+        runAtNextTick(priorityQueue, token, std::move(job));
+    }
+}
+
 void ShaderCompilerService::tick() {
     // we don't need to run executeTickOps() if we're using the thread-pool
     if (UTILS_UNLIKELY(mMode != Mode::THREAD_POOL)) {
         executeTickOps();
+        mQueueDepth.store(uint32_t(mRunAtNextTickOps.size()), std::memory_order_relaxed);
+    } else {
+        mQueueDepth.store(uint32_t(mCompilerThreadPool.getQueueDepth()),
+                std::memory_order_relaxed);
     }
 }
 
@@ -497,6 +522,10 @@ bool ShaderCompilerService::cancelTickOp(program_token_t const& token) noexcept
 }
 
 void ShaderCompilerService::executeTickOps() noexcept {
+    using clock = std::chrono::steady_clock;
+    std::chrono::microseconds const budget{
+            mDriver.getDriverConfig().shaderCompilerTickBudgetUs };
+    clock::time_point const deadline = clock::now() + budget;
     auto& ops = mRunAtNextTickOps;
     auto it = ops.begin();
     while (it != ops.end()) {
@@ -504,6 +533,14 @@ void ShaderCompilerService::executeTickOps() noexcept {
         bool const remove = job.fn(job);
         if (remove) {
             it = ops.erase(it);
+            // Finalizing a ready program (link check, callbacks) is the expensive part, so the
+            // budget is only checked after one completes. Ops are sorted by priority, so we
+            // finalize the programs most likely to be needed first and leave the rest for the
+            // next tick. Ops that merely poll completion status are cheap and always run, so
+            // in-flight compilations keep making progress.
+            if (budget.count() > 0 && clock::now() >= deadline) {
+                break;
+            }
         } else {
             ++it;
         }
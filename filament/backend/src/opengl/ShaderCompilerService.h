@@ -32,6 +32,7 @@
 #include <utils/JobSystem.h>
 
 #include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -82,6 +83,18 @@ public:
     // Must be called at least once per frame.
     void tick();
 
+    // Number of program compilations still queued or in flight. Thread-safe, can be called from
+    // any thread; updated by tick() (used for debugging/metrics).
+    uint32_t getQueueDepth() const noexcept {
+        return mQueueDepth.load(std::memory_order_relaxed);
+    }
+
+    // Changes the priority of a program compilation that hasn't started yet. Promoting to HIGH
+    // makes the program compile next, which is useful when a draw is about to block on it;
+    // demoting to LOW gets it out of the way. No-op once compilation has started.
+    void setPriorityQueue(program_token_t const& token,
+            CompilerPriorityQueue priorityQueue) noexcept;
+
     // Destroys a valid token and all associated resources. Used to "cancel" a program compilation.
     // This function is not called if `initialize(token)` is already invoked.
     static void terminate(program_token_t& token);
@@ -130,6 +143,7 @@ private:
 
     uint32_t mShaderCompilerThreadCount = 0u;
     Mode mMode = Mode::UNDEFINED; // valid after init() is called
+    std::atomic<uint32_t> mQueueDepth{};
 
     using ContainerType = std::tuple<CompilerPriorityQueue, program_token_t, Job>;
     std::vector<ContainerType> mRunAtNextTickOps;
@@ -64,6 +64,9 @@ PFNGLCLIPCONTROLEXTPROC glClipControlEXT;
 #ifdef GL_EXT_discard_framebuffer
 PFNGLDISCARDFRAMEBUFFEREXTPROC glDiscardFramebufferEXT;
 #endif
+#ifdef GL_EXT_buffer_storage
+PFNGLBUFFERSTORAGEEXTPROC glBufferStorageEXT;
+#endif
 #ifdef GL_KHR_parallel_shader_compile
 PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glMaxShaderCompilerThreadsKHR;
 #endif
@@ -120,6 +123,9 @@ void importGLESExtensionsEntryPoints() {
 #ifdef GL_EXT_discard_framebuffer
         getProcAddress(glDiscardFramebufferEXT, "glDiscardFramebufferEXT");
 #endif
+#ifdef GL_EXT_buffer_storage
+    getProcAddress(glBufferStorageEXT, "glBufferStorageEXT");
+#endif
 #ifdef GL_KHR_parallel_shader_compile
         getProcAddress(glMaxShaderCompilerThreadsKHR, "glMaxShaderCompilerThreadsKHR");
 #endif
@@ -148,6 +148,9 @@ extern PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOES;
 #ifdef GL_EXT_discard_framebuffer
 extern PFNGLDISCARDFRAMEBUFFEREXTPROC glDiscardFramebufferEXT;
 #endif
+#ifdef GL_EXT_buffer_storage
+extern PFNGLBUFFERSTORAGEEXTPROC glBufferStorageEXT;
+#endif
 #ifdef GL_KHR_parallel_shader_compile
 extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glMaxShaderCompilerThreadsKHR;
 #endif
@@ -182,6 +185,12 @@ using namespace glext;
 #   define GL_ZERO_TO_ONE                           GL_ZERO_TO_ONE_EXT
 #endif
 
+#ifdef GL_EXT_buffer_storage
+#   define GL_MAP_PERSISTENT_BIT                    GL_MAP_PERSISTENT_BIT_EXT
+#   define GL_MAP_COHERENT_BIT                      GL_MAP_COHERENT_BIT_EXT
+#   define glBufferStorage                          glBufferStorageEXT
+#endif
+
 #ifdef GL_KHR_parallel_shader_compile
 #   define GL_COMPLETION_STATUS                     GL_COMPLETION_STATUS_KHR
 #else
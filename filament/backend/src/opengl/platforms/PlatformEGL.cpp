@@ -62,6 +62,7 @@ UTILS_PRIVATE PFNEGLDESTROYSYNCKHRPROC eglDestroySyncKHR = {};
 UTILS_PRIVATE PFNEGLCLIENTWAITSYNCKHRPROC eglClientWaitSyncKHR = {};
 UTILS_PRIVATE PFNEGLCREATEIMAGEKHRPROC eglCreateImageKHR = {};
 UTILS_PRIVATE PFNEGLDESTROYIMAGEKHRPROC eglDestroyImageKHR = {};
+UTILS_PRIVATE PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC eglSwapBuffersWithDamageKHR = {};
 }
 using namespace glext;
 
@@ -157,6 +158,7 @@ Driver* PlatformEGL::createDriver(void* sharedContext, const DriverConfig& drive
     ext.egl.KHR_no_config_context = extensions.has("EGL_KHR_no_config_context");
     ext.egl.KHR_surfaceless_context = extensions.has("EGL_KHR_surfaceless_context");
     ext.egl.EXT_protected_content = extensions.has("EGL_EXT_protected_content");
+    ext.egl.KHR_swap_buffers_with_damage = extensions.has("EGL_KHR_swap_buffers_with_damage");
 
     eglCreateSyncKHR = (PFNEGLCREATESYNCKHRPROC) eglGetProcAddress("eglCreateSyncKHR");
     eglDestroySyncKHR = (PFNEGLDESTROYSYNCKHRPROC) eglGetProcAddress("eglDestroySyncKHR");
@@ -165,6 +167,9 @@ Driver* PlatformEGL::createDriver(void* sharedContext, const DriverConfig& drive
     eglCreateImageKHR = (PFNEGLCREATEIMAGEKHRPROC) eglGetProcAddress("eglCreateImageKHR");
     eglDestroyImageKHR = (PFNEGLDESTROYIMAGEKHRPROC) eglGetProcAddress("eglDestroyImageKHR");
 
+    eglSwapBuffersWithDamageKHR = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)
+            eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+
     EGLint const pbufferAttribs[] = {
             EGL_WIDTH,  1,
             EGL_HEIGHT, 1,
@@ -614,6 +619,12 @@ bool PlatformEGL::makeCurrent(ContextType type,
     SwapChainEGL const* const rsc = static_cast<SwapChainEGL const*>(readSwapChain);
     EGLContext context = getContextForType(type);
     EGLBoolean const success = egl.makeCurrent(context, dsc->sur, rsc->sur);
+    if (UTILS_UNLIKELY(success == EGL_TRUE
+            && (dsc->flags & SWAP_CHAIN_CONFIG_LOW_LATENCY))) {
+        // the swap interval attaches to the surface currently bound for drawing, so regular
+        // swapchains are unaffected
+        eglSwapInterval(mEGLDisplay, 0);
+    }
     return success == EGL_TRUE;
 }
 
@@ -681,13 +692,32 @@ void PlatformEGL::makeCurrent(SwapChain* drawSwapChain,
 
 void PlatformEGL::commit(SwapChain* swapChain) noexcept {
     if (swapChain) {
-        SwapChainEGL const* const sc = static_cast<SwapChainEGL const*>(swapChain);
+        SwapChainEGL* const sc = static_cast<SwapChainEGL*>(swapChain);
         if (sc->sur != EGL_NO_SURFACE) {
+            if (UTILS_UNLIKELY(sc->hasDamage)) {
+                sc->hasDamage = false;
+                if (ext.egl.KHR_swap_buffers_with_damage && eglSwapBuffersWithDamageKHR) {
+                    eglSwapBuffersWithDamageKHR(mEGLDisplay, sc->sur, sc->damage, 1);
+                    return;
+                }
+            }
             eglSwapBuffers(mEGLDisplay, sc->sur);
         }
     }
 }
 
+void PlatformEGL::setPresentationDamage(SwapChain* swapChain,
+        Viewport const& damage) noexcept {
+    if (swapChain) {
+        SwapChainEGL* const sc = static_cast<SwapChainEGL*>(swapChain);
+        sc->damage[0] = EGLint(damage.left);
+        sc->damage[1] = EGLint(damage.bottom);
+        sc->damage[2] = EGLint(damage.width);
+        sc->damage[3] = EGLint(damage.height);
+        sc->hasDamage = true;
+    }
+}
+
 // -----------------------------------------------------------------------------------------------
 
 bool PlatformEGL::canCreateFence() noexcept {
@@ -530,6 +530,11 @@ io::ostream& operator<<(io::ostream& out, DescriptorSetOffsetArray const& dsa) {
     return out;
 }
 
+io::ostream& operator<<(io::ostream& out, DescriptorSetBindingArray const& dsba) {
+    out << "DescriptorSetBindingArray{" << dsba.size() << "}";
+    return out;
+}
+
 io::ostream& operator<<(io::ostream& stream, ShaderStageFlags stageFlags) {
     const char* str = nullptr;
     switch (stageFlags) {
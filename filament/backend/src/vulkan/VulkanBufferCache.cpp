@@ -22,12 +22,23 @@
 #include "memory/Resource.h"
 #include "memory/ResourceManager.h"
 
+#include <unordered_set>
 #include <utility>
+#include <vector>
+
+using namespace bluevk;
 
 namespace filament::backend {
 
 namespace {
 
+// Defragmentation runs every DEFRAG_PERIOD frames and relocates at most
+// MAX_DEFRAG_MOVES_PER_PASS idle buffers each time, so the cost stays within the
+// driver thread's per-frame maintenance budget.
+constexpr uint64_t DEFRAG_PERIOD = 16;
+constexpr uint32_t MAX_DEFRAG_MOVES_PER_PASS = 16;
+constexpr VkDeviceSize MAX_DEFRAG_BYTES_PER_PASS = 16 * 1024 * 1024;
+
 VkBufferUsageFlags getVkBufferUsage(VulkanBufferUsage usage) {
     switch (usage) {
         case VulkanBufferUsage::VERTEX:
@@ -105,6 +116,12 @@ void VulkanBufferCache::gc() noexcept {
         }
     }
 
+    // Periodically compact the VMA heaps. Without this, 24/7 sessions slowly fragment the
+    // memory blocks as scenes stream in and out.
+    if (mCurrentFrame % DEFRAG_PERIOD == 0) {
+        defragment();
+    }
+
     FVK_SYSTRACE_END();
 }
 
@@ -117,6 +134,104 @@ void VulkanBufferCache::terminate() noexcept {
     }
 }
 
+void VulkanBufferCache::defragment() noexcept {
+    FVK_SYSTRACE_CONTEXT();
+    FVK_SYSTRACE_START("VulkanBufferCache::defragment");
+
+    // Only buffers sitting unused in the pools can be relocated: by the time a buffer is
+    // released here its reference count dropped to zero, so no command buffer, descriptor set
+    // or proxy references its VkBuffer anymore, and its content is garbage until the next
+    // acquire() rewrites it. This means a move needs no GPU copy at all -- we just bind a
+    // fresh VkBuffer to the destination memory and retire the old one.
+    std::unordered_set<VulkanGpuBuffer const*> idleBuffers;
+    for (auto const& bufferPool: mGpuBufferPools) {
+        for (auto const& poolEntry: bufferPool) {
+            idleBuffers.insert(poolEntry.second.gpuBuffer);
+        }
+    }
+    if (idleBuffers.empty()) {
+        FVK_SYSTRACE_END();
+        return;
+    }
+
+    VmaDefragmentationInfo const defragInfo{
+        .flags = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_FAST_BIT,
+        .maxBytesPerPass = MAX_DEFRAG_BYTES_PER_PASS,
+        .maxAllocationsPerPass = MAX_DEFRAG_MOVES_PER_PASS,
+    };
+    VmaDefragmentationContext defragContext;
+    if (vmaBeginDefragmentation(mAllocator, &defragInfo, &defragContext) != VK_SUCCESS) {
+        FVK_SYSTRACE_END();
+        return;
+    }
+
+    VmaAllocatorInfo allocatorInfo{};
+    vmaGetAllocatorInfo(mAllocator, &allocatorInfo);
+    VkDevice const device = allocatorInfo.device;
+
+    // Run a single budgeted pass per call; the next gc() period picks up where we left off.
+    VmaDefragmentationPassMoveInfo pass{};
+    if (vmaBeginDefragmentationPass(mAllocator, defragContext, &pass) == VK_INCOMPLETE) {
+        struct Relocation {
+            VulkanGpuBuffer* gpuBuffer;
+            VkBuffer oldBuffer;
+        };
+        std::vector<Relocation> relocations;
+        relocations.reserve(pass.moveCount);
+        for (uint32_t i = 0; i < pass.moveCount; i++) {
+            VmaDefragmentationMove& move = pass.pMoves[i];
+            VmaAllocationInfo srcInfo{};
+            vmaGetAllocationInfo(mAllocator, move.srcAllocation, &srcInfo);
+            auto* const gpuBuffer = static_cast<VulkanGpuBuffer*>(srcInfo.pUserData);
+            if (!gpuBuffer || idleBuffers.find(gpuBuffer) == idleBuffers.end()) {
+                // not one of our idle pooled buffers (e.g. still in use, or an image), leave
+                // it where it is
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+            VkBufferCreateInfo const bufferInfo{
+                .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+                .size = gpuBuffer->numBytes,
+                .usage = getVkBufferUsage(gpuBuffer->usage) | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            };
+            VkBuffer newBuffer = VK_NULL_HANDLE;
+            if (vkCreateBuffer(device, &bufferInfo, VKALLOC, &newBuffer) != VK_SUCCESS ||
+                    vmaBindBufferMemory(mAllocator, move.dstTmpAllocation, newBuffer)
+                            != VK_SUCCESS) {
+                if (newBuffer != VK_NULL_HANDLE) {
+                    vkDestroyBuffer(device, newBuffer, VKALLOC);
+                }
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+            relocations.push_back({ gpuBuffer, gpuBuffer->vkbuffer });
+            gpuBuffer->vkbuffer = newBuffer;
+        }
+        vmaEndDefragmentationPass(mAllocator, defragContext, &pass);
+
+        // The moved allocations now point at their new memory; retire the old VkBuffers and
+        // refresh the cached allocation info (memory, offset, mapping).
+        for (auto const& relocation: relocations) {
+            vkDestroyBuffer(device, relocation.oldBuffer, VKALLOC);
+            vmaGetAllocationInfo(mAllocator, relocation.gpuBuffer->vmaAllocation,
+                    &relocation.gpuBuffer->allocationInfo);
+        }
+    }
+
+    UTILS_UNUSED_IN_RELEASE VmaDefragmentationStats stats{};
+    vmaEndDefragmentation(mAllocator, defragContext, &stats);
+
+#if FVK_ENABLED(FVK_DEBUG_VULKAN_BUFFER_CACHE)
+    if (stats.allocationsMoved > 0) {
+        FVK_LOGD << "VulkanBufferCache - defragmentation moved " << stats.allocationsMoved
+                 << " buffers (" << stats.bytesMoved << " bytes), freed " << stats.bytesFreed
+                 << " bytes" << utils::io::endl;
+    }
+#endif// FVK_DEBUG_VULKAN_BUFFER_CACHE
+
+    FVK_SYSTRACE_END();
+}
+
 void VulkanBufferCache::release(VulkanGpuBuffer const* gpuBuffer) noexcept {
     assert_invariant(gpuBuffer != nullptr);
 
@@ -154,6 +269,8 @@ VulkanGpuBuffer const* VulkanBufferCache::allocate(VulkanBufferUsage usage,
         .flags = vmaFlags,
         .usage = VMA_MEMORY_USAGE_AUTO,
         .requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        // lets defragment() map a candidate allocation back to its `VulkanGpuBuffer`
+        .pUserData = gpuBuffer,
     };
     UTILS_UNUSED_IN_RELEASE VkResult result = vmaCreateBuffer(mAllocator, &bufferInfo, &allocInfo,
             &gpuBuffer->vkbuffer, &gpuBuffer->vmaAllocation, &gpuBuffer->allocationInfo);
@@ -41,7 +41,8 @@ public:
     fvkmemory::resource_ptr<VulkanBuffer> acquire(VulkanBufferUsage usage,
             uint32_t numBytes) noexcept;
 
-    // Evicts old unused `VulkanGpuBuffer` and bumps the current frame number
+    // Evicts old unused `VulkanGpuBuffer`, bumps the current frame number, and periodically
+    // compacts the VMA heaps by relocating idle pooled buffers.
     void gc() noexcept;
 
     // Destroys all unused `VulkanGpuBuffer`.
@@ -59,6 +60,12 @@ private:
     // Return a `VulkanGpuBuffer` back to its corresponding pool
     void release(VulkanGpuBuffer const* gpuBuffer) noexcept;
 
+    // Runs one budgeted VMA defragmentation pass over the idle pooled buffers. Long sessions
+    // fragment the heaps as scenes stream in and out, to the point where allocations can fail
+    // with plenty of free VRAM; this slowly compacts the heaps without ever touching a buffer
+    // that is still referenced.
+    void defragment() noexcept;
+
     // Allocate a new VkBuffer from the VMA pool of the corresponding `numBytes` and `usage`.
     VulkanGpuBuffer const* allocate(VulkanBufferUsage usage, uint32_t numBytes) noexcept;
 
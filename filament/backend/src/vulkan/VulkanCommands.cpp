@@ -93,6 +93,7 @@ VulkanCommandBuffer::VulkanCommandBuffer(VulkanContext const& context, VkDevice
       isProtected(isProtected),
       mDevice(device),
       mQueue(queue),
+      mPool(pool),
       mBuffer(createCommandBuffer(device, pool)),
       mFenceStatus(std::make_shared<VulkanCmdFence>(VK_INCOMPLETE)) {
     VkSemaphoreCreateInfo sci{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
@@ -111,6 +112,7 @@ void VulkanCommandBuffer::reset() noexcept {
     mMarkerCount = 0;
     mResources.clear();
     mWaitSemaphores.clear();
+    mNextSecondary = 0;
 
     // Internally we use the VK_INCOMPLETE status to mean "not yet submitted". When this fence
     // gets, gets submitted, its status changes to VK_NOT_READY. Finally, when the GPU actually
@@ -175,6 +177,46 @@ void VulkanCommandBuffer::begin() noexcept {
     vkBeginCommandBuffer(mBuffer, &binfo);
 }
 
+VkCommandBuffer VulkanCommandBuffer::beginSecondary(VkRenderPass renderPass, uint32_t subpass,
+        VkFramebuffer framebuffer) noexcept {
+    assert_invariant(mActiveSecondary == VK_NULL_HANDLE);
+    if (mNextSecondary == mSecondaries.size()) {
+        VkCommandBufferAllocateInfo const allocateInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .commandPool = mPool,
+            .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+            .commandBufferCount = 1,
+        };
+        // We don't need to deallocate since destroying the pool will free all of the buffers.
+        VkCommandBuffer secondary;
+        vkAllocateCommandBuffers(mDevice, &allocateInfo, &secondary);
+        mSecondaries.push_back(secondary);
+    }
+    mActiveSecondary = mSecondaries[mNextSecondary++];
+
+    VkCommandBufferInheritanceInfo const inheritance{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        .renderPass = renderPass,
+        .subpass = subpass,
+        .framebuffer = framebuffer,
+    };
+    VkCommandBufferBeginInfo const binfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                 VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+        .pInheritanceInfo = &inheritance,
+    };
+    vkBeginCommandBuffer(mActiveSecondary, &binfo);
+    return mActiveSecondary;
+}
+
+void VulkanCommandBuffer::executeSecondary() noexcept {
+    assert_invariant(mActiveSecondary != VK_NULL_HANDLE);
+    vkEndCommandBuffer(mActiveSecondary);
+    vkCmdExecuteCommands(mBuffer, 1, &mActiveSecondary);
+    mActiveSecondary = VK_NULL_HANDLE;
+}
+
 VkSemaphore VulkanCommandBuffer::submit() {
     while (mMarkerCount > 0) {
         popMarker();
@@ -105,21 +105,38 @@ struct VulkanCommandBuffer {
     }
 
     VkCommandBuffer buffer() const {
+        if (UTILS_UNLIKELY(mActiveSecondary != VK_NULL_HANDLE)) {
+            return mActiveSecondary;
+        }
         return mBuffer;
     }
 
+    // Starts recording the contents of the current render pass into a secondary command buffer
+    // (allocated lazily and reused across submissions). Until executeSecondary() is called,
+    // buffer() returns the secondary, so all render-pass commands are recorded into it.
+    VkCommandBuffer beginSecondary(VkRenderPass renderPass, uint32_t subpass,
+            VkFramebuffer framebuffer) noexcept;
+
+    // Ends the current secondary command buffer and replays it into the primary with
+    // vkCmdExecuteCommands(). After this call, buffer() returns the primary again.
+    void executeSecondary() noexcept;
+
 private:
     VulkanContext const& mContext;
     uint8_t mMarkerCount;
     bool const isProtected;
     VkDevice mDevice;
     VkQueue mQueue;
+    VkCommandPool mPool;
     fvkutils::StaticVector<VkSemaphore, 2> mWaitSemaphores;
     VkCommandBuffer mBuffer;
     VkSemaphore mSubmission;
     VkFence mFence;
     std::shared_ptr<VulkanCmdFence> mFenceStatus;
     std::vector<fvkmemory::resource_ptr<Resource>> mResources;
+    VkCommandBuffer mActiveSecondary = VK_NULL_HANDLE;
+    std::vector<VkCommandBuffer> mSecondaries;  // allocated lazily, reused across submissions
+    uint32_t mNextSecondary = 0;                // first secondary not yet used this submission
 };
 
 struct CommandBufferPool {
@@ -108,6 +108,16 @@
 
 #define FVK_ENABLED(flags) (((FVK_DEBUG_FLAGS) & (flags)) == (flags))
 
+// Experimental: record render-pass contents into secondary command buffers replayed with
+// vkCmdExecuteCommands(). This is the groundwork for spreading the vkCmd encoding of large
+// passes across several threads, which additionally requires per-thread command pools; with a
+// single secondary it is expected to be roughly performance-neutral. Note that secondary
+// command buffers don't inherit dynamic state, so viewport/scissor are re-issued when one is
+// started.
+#ifndef FVK_USE_SECONDARY_COMMAND_BUFFERS
+#define FVK_USE_SECONDARY_COMMAND_BUFFERS 0
+#endif
+
 // Group marker only works only if validation or debug utils is enabled since it uses
 // vkCmd(Begin/End)DebugUtilsLabelEXT or vkCmdDebugMarker(Begin/End)EXT
 #if FVK_ENABLED(FVK_DEBUG_PRINT_GROUP_MARKERS)
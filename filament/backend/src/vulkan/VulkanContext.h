@@ -146,6 +146,17 @@ public:
         return mIsUnifiedMemoryArchitecture;
     }
 
+    // True when the device supports the descriptor-indexing features needed for a bindless
+    // texture table: runtime descriptor arrays with partially-bound, update-after-bind
+    // sampled-image bindings and non-uniform indexing in shaders.
+    inline bool isDescriptorIndexingSupported() const noexcept {
+        auto const& f = mDescriptorIndexingFeatures;
+        return f.runtimeDescriptorArray == VK_TRUE &&
+                f.descriptorBindingPartiallyBound == VK_TRUE &&
+                f.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE &&
+                f.shaderSampledImageArrayNonUniformIndexing == VK_TRUE;
+    }
+
 private:
     VkPhysicalDeviceMemoryProperties mMemoryProperties = {};
     VkPhysicalDeviceProperties2 mPhysicalDeviceProperties = {
@@ -164,6 +175,11 @@ private:
         // non-conformant vulkan implementation).
         .imageView2DOn3DImage = VK_TRUE,
     };
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT mDescriptorIndexingFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT,
+        // Only filled when VK_EXT_descriptor_indexing is present; all features read as
+        // unsupported otherwise.
+    };
     bool mDebugMarkersSupported = false;
     bool mDebugUtilsSupported = false;
     bool mLazilyAllocatedMemorySupported = false;
@@ -1000,6 +1000,10 @@ int64_t VulkanDriver::getStreamTimestamp(Handle<HwStream> sh) {
     return 0;
 }
 
+StreamStats VulkanDriver::getStreamStats(Handle<HwStream> sh) {
+    return {};
+}
+
 void VulkanDriver::updateStreams(CommandStream* driver) {
 }
 
@@ -1114,6 +1118,10 @@ bool VulkanDriver::isParallelShaderCompileSupported() {
     return false;
 }
 
+uint32_t VulkanDriver::getShaderCompilerQueueDepth() {
+    return 0;
+}
+
 bool VulkanDriver::isDepthStencilResolveSupported() {
     // TODO: apparently it could be supported in core 1.2 and/or with VK_KHR_depth_stencil_resolve
     return false;
@@ -1375,6 +1383,15 @@ void VulkanDriver::compilePrograms(CompilerPriorityQueue priority,
     }
 }
 
+void VulkanDriver::setCompilerPriorityQueue(Handle<HwProgram> ph, CompilerPriorityQueue priority) {
+    // shader modules are compiled synchronously in createProgram, nothing to reprioritize
+}
+
+void* VulkanDriver::getBufferObjectMapping(Handle<HwBufferObject> boh) {
+    // TODO: host-visible coherent allocations could expose their mapping here
+    return nullptr;
+}
+
 void VulkanDriver::beginRenderPass(Handle<HwRenderTarget> rth, const RenderPassParams& params) {
     FVK_SYSTRACE_SCOPE();
 
@@ -1504,7 +1521,19 @@ void VulkanDriver::beginRenderPass(Handle<HwRenderTarget> rth, const RenderPassP
         renderPassInfo.pClearValues = &clearValues[0];
     }
 
+#if FVK_USE_SECONDARY_COMMAND_BUFFERS
+    vkCmdBeginRenderPass(cmdbuffer, &renderPassInfo,
+            VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    // All render-pass commands are now recorded into a secondary command buffer (see
+    // VulkanCommandBuffer::buffer()). Dynamic state isn't inherited, so the scissor set above
+    // must be re-issued in the secondary.
+    VkCommandBuffer const passCmdbuffer =
+            commandBuffer->beginSecondary(renderPassInfo.renderPass, 0, vkfb);
+    vkCmdSetScissor(passCmdbuffer, 0, 1, &scissor);
+#else
     vkCmdBeginRenderPass(cmdbuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    VkCommandBuffer const passCmdbuffer = cmdbuffer;
+#endif
 
     VkViewport viewport = {
         .x = (float) params.viewport.left,
@@ -1516,7 +1545,7 @@ void VulkanDriver::beginRenderPass(Handle<HwRenderTarget> rth, const RenderPassP
     };
 
     rt->transformViewportToPlatform(&viewport);
-    vkCmdSetViewport(cmdbuffer, 0, 1, &viewport);
+    vkCmdSetViewport(passCmdbuffer, 0, 1, &viewport);
 
     mCurrentRenderPass = {
         .commandBuffer = commandBuffer,
@@ -1530,6 +1559,10 @@ void VulkanDriver::beginRenderPass(Handle<HwRenderTarget> rth, const RenderPassP
 void VulkanDriver::endRenderPass(int) {
     FVK_SYSTRACE_SCOPE();
 
+#if FVK_USE_SECONDARY_COMMAND_BUFFERS
+    // finish and replay the pass's secondary command buffer; buffer() returns the primary again
+    mCurrentRenderPass.commandBuffer->executeSecondary();
+#endif
     VkCommandBuffer cmdbuffer = mCurrentRenderPass.commandBuffer->buffer();
     vkCmdEndRenderPass(cmdbuffer);
 
@@ -1554,8 +1587,32 @@ void VulkanDriver::nextSubpass(int) {
     assert_invariant(renderTarget);
     assert_invariant(mCurrentRenderPass.params.subpassMask);
 
+#if FVK_USE_SECONDARY_COMMAND_BUFFERS
+    VulkanCommandBuffer* const commandBuffer = mCurrentRenderPass.commandBuffer;
+    commandBuffer->executeSecondary();
+    vkCmdNextSubpass(commandBuffer->buffer(), VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    // the new subpass gets its own secondary command buffer; since dynamic state isn't
+    // inherited, the viewport and scissor must be re-issued
+    VkCommandBuffer const passCmdbuffer = commandBuffer->beginSecondary(
+            mCurrentRenderPass.renderPass, mCurrentRenderPass.currentSubpass + 1,
+            VK_NULL_HANDLE);
+    VkRect2D const scissor{ .offset = { 0, 0 }, .extent = renderTarget->getExtent() };
+    vkCmdSetScissor(passCmdbuffer, 0, 1, &scissor);
+    RenderPassParams const& params = mCurrentRenderPass.params;
+    VkViewport viewport = {
+        .x = (float) params.viewport.left,
+        .y = (float) params.viewport.bottom,
+        .width = (float) params.viewport.width,
+        .height = (float) params.viewport.height,
+        .minDepth = params.depthRange.near,
+        .maxDepth = params.depthRange.far
+    };
+    renderTarget->transformViewportToPlatform(&viewport);
+    vkCmdSetViewport(passCmdbuffer, 0, 1, &viewport);
+#else
     vkCmdNextSubpass(mCurrentRenderPass.commandBuffer->buffer(),
             VK_SUBPASS_CONTENTS_INLINE);
+#endif
 
     mPipelineCache.bindRenderPass(mCurrentRenderPass.renderPass,
             ++mCurrentRenderPass.currentSubpass);
@@ -1597,6 +1654,10 @@ void VulkanDriver::commit(Handle<HwSwapChain> sch) {
     swapChain->present();
 }
 
+void VulkanDriver::setPresentationDamage(Handle<HwSwapChain> sch, Viewport damage) {
+    // TODO: forward to VK_KHR_incremental_present when available
+}
+
 void VulkanDriver::setPushConstant(backend::ShaderStage stage, uint8_t index,
         backend::PushConstantVariant value) {
     assert_invariant(mPipelineState.program && "Expect a program when writing to push constants");
@@ -1780,6 +1841,17 @@ void VulkanDriver::blitDEPRECATED(TargetBufferFlags buffers,
             srcTarget->getColor0(), srcOffsets);
 }
 
+void VulkanDriver::precompilePipeline(PipelineState const& pipelineState) {
+    // Creating a VkPipeline needs a compatible render pass, so this is only a useful hint
+    // while a render pass is active. We simply go through the bindPipeline() path, which
+    // creates and caches the pipeline; binding it without issuing a draw is harmless, and
+    // the first real bindPipeline() with this state then hits the cache.
+    if (UTILS_UNLIKELY(!mCurrentRenderPass.commandBuffer)) {
+        return;
+    }
+    bindPipeline(pipelineState);
+}
+
 void VulkanDriver::bindPipeline(PipelineState const& pipelineState) {
     // This resets all of the pipeline states; the most relevant (needing reset) is .bindInDraw.
     mPipelineState = {};
@@ -1931,6 +2003,12 @@ void VulkanDriver::bindDescriptorSet(
     }
 }
 
+void VulkanDriver::bindDescriptorSets(backend::DescriptorSetBindingArray&& bindings) {
+    for (auto& entry : bindings) {
+        bindDescriptorSet(entry.dsh, entry.set, std::move(entry.offsets));
+    }
+}
+
 void VulkanDriver::draw2(uint32_t indexOffset, uint32_t indexCount, uint32_t instanceCount) {
     FVK_SYSTRACE_SCOPE();
     VkCommandBuffer cmdbuffer = mCurrentRenderPass.commandBuffer->buffer();
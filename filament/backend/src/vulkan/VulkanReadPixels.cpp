@@ -25,6 +25,8 @@
 
 #include <utils/Log.h>
 
+#include <algorithm>
+
 using namespace bluevk;
 
 namespace filament::backend {
@@ -103,16 +105,32 @@ void TaskHandler::loop() {
     }
 }
 
+void VulkanReadPixels::destroyStagingEntry(VkDevice const device, VkCommandPool const cmdpool,
+        StagingEntry const& entry) noexcept {
+    vkDestroyImage(device, entry.image, VKALLOC);
+    vkFreeMemory(device, entry.memory, VKALLOC);
+    vkDestroyFence(device, entry.fence, VKALLOC);
+    vkFreeCommandBuffers(device, cmdpool, 1, &entry.commandBuffer);
+}
+
 void VulkanReadPixels::terminate() noexcept {
     assert_invariant(mDevice != VK_NULL_HANDLE);
     if (mCommandPool == VK_NULL_HANDLE) {
         return;
     }
-    vkDestroyCommandPool(mDevice, mCommandPool, VKALLOC);
+    VkDevice const device = mDevice;
     mDevice = VK_NULL_HANDLE;
 
     mTaskHandler->shutdown();
     mTaskHandler.reset();
+
+    // no tasks can recycle entries past this point
+    for (auto const& entry: mStagingPool) {
+        destroyStagingEntry(device, mCommandPool, entry);
+    }
+    mStagingPool.clear();
+
+    vkDestroyCommandPool(device, mCommandPool, VKALLOC);
 }
 
 VulkanReadPixels::VulkanReadPixels(VkDevice device)
@@ -151,66 +169,97 @@ void VulkanReadPixels::run(fvkmemory::resource_ptr<VulkanRenderTarget> srcTarget
     bool const swizzle
             = srcFormat == VK_FORMAT_B8G8R8A8_UNORM || srcFormat == VK_FORMAT_B8G8R8A8_SRGB;
 
-    // Create a host visible, linearly tiled image as a staging area.
-    VkImageCreateInfo const imageInfo = {
-        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
-        .imageType = VK_IMAGE_TYPE_2D,
-        .format = srcFormat,
-        .extent = { width, height, 1 },
-        .mipLevels = 1,
-        .arrayLayers = 1,
-        .samples = VK_SAMPLE_COUNT_1_BIT,
-        .tiling = VK_IMAGE_TILING_LINEAR,
-        .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT,
-        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-    };
+    // Try to recycle a completed readback of the same shape before creating anything; during
+    // continuous capture this makes the whole operation allocation-free.
+    StagingEntry entry{};
+    bool reused = false;
+    {
+        std::lock_guard<std::mutex> const lock(mStagingPoolMutex);
+        auto const pos = std::find_if(mStagingPool.begin(), mStagingPool.end(),
+                [srcFormat, width, height](StagingEntry const& e) {
+                    return e.format == srcFormat && e.width == width && e.height == height;
+                });
+        if (pos != mStagingPool.end()) {
+            entry = *pos;
+            mStagingPool.erase(pos);
+            reused = true;
+        }
+    }
 
-    VkImage stagingImage;
-    vkCreateImage(device, &imageInfo, VKALLOC, &stagingImage);
+    if (reused) {
+        vkResetFences(device, 1, &entry.fence);
+        // the command buffer is reset implicitly by vkBeginCommandBuffer below
+    } else {
+        entry.format = srcFormat;
+        entry.width = width;
+        entry.height = height;
+
+        // Create a host visible, linearly tiled image as a staging area.
+        VkImageCreateInfo const imageInfo = {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = srcFormat,
+            .extent = { width, height, 1 },
+            .mipLevels = 1,
+            .arrayLayers = 1,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .tiling = VK_IMAGE_TILING_LINEAR,
+            .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        };
 
-#if FVK_ENABLED(FVK_DEBUG_READ_PIXELS)
-    FVK_LOGD << "readPixels created image=" << stagingImage
-             << " to copy from image=" << srcTexture->getVkImage()
-             << " src-layout=" << srcTexture->getLayout(0, 0);
-#endif
+        vkCreateImage(device, &imageInfo, VKALLOC, &entry.image);
 
-    VkMemoryRequirements memReqs;
-    VkDeviceMemory stagingMemory;
-    vkGetImageMemoryRequirements(device, stagingImage, &memReqs);
-
-    uint32_t memoryTypeIndex = selectMemoryFunc(memReqs.memoryTypeBits,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-                    | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
-
-    // If VK_MEMORY_PROPERTY_HOST_CACHED_BIT is not supported, we try only
-    // HOST_VISIBLE+HOST_COHERENT.  HOST_CACHED helps a lot with readpixels performance.
-    if (memoryTypeIndex >= VK_MAX_MEMORY_TYPES) {
-        memoryTypeIndex = selectMemoryFunc(memReqs.memoryTypeBits,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-        FVK_LOGW
-                << "readPixels is slow because VK_MEMORY_PROPERTY_HOST_CACHED_BIT is not available";
-    }
+        VkMemoryRequirements memReqs;
+        vkGetImageMemoryRequirements(device, entry.image, &memReqs);
 
-    FILAMENT_CHECK_POSTCONDITION(memoryTypeIndex < VK_MAX_MEMORY_TYPES)
-            << "VulkanReadPixels: unable to find a memory type that meets requirements.";
+        uint32_t memoryTypeIndex = selectMemoryFunc(memReqs.memoryTypeBits,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                        | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
 
-    VkMemoryAllocateInfo const allocInfo = {
-        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-        .allocationSize = memReqs.size,
-        .memoryTypeIndex = memoryTypeIndex,
-    };
+        // If VK_MEMORY_PROPERTY_HOST_CACHED_BIT is not supported, we try only
+        // HOST_VISIBLE+HOST_COHERENT.  HOST_CACHED helps a lot with readpixels performance.
+        if (memoryTypeIndex >= VK_MAX_MEMORY_TYPES) {
+            memoryTypeIndex = selectMemoryFunc(memReqs.memoryTypeBits,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            FVK_LOGW
+                    << "readPixels is slow because VK_MEMORY_PROPERTY_HOST_CACHED_BIT is not available";
+        }
 
-    vkAllocateMemory(device, &allocInfo, VKALLOC, &stagingMemory);
-    vkBindImageMemory(device, stagingImage, stagingMemory, 0);
+        FILAMENT_CHECK_POSTCONDITION(memoryTypeIndex < VK_MAX_MEMORY_TYPES)
+                << "VulkanReadPixels: unable to find a memory type that meets requirements.";
 
-    VkCommandBuffer cmdbuffer;
-    VkCommandBufferAllocateInfo const allocateInfo = {
-        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-        .commandPool = cmdpool,
-        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-        .commandBufferCount = 1,
-    };
-    vkAllocateCommandBuffers(device, &allocateInfo, &cmdbuffer);
+        VkMemoryAllocateInfo const allocInfo = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = memReqs.size,
+            .memoryTypeIndex = memoryTypeIndex,
+        };
+
+        vkAllocateMemory(device, &allocInfo, VKALLOC, &entry.memory);
+        vkBindImageMemory(device, entry.image, entry.memory, 0);
+
+        VkCommandBufferAllocateInfo const allocateInfo = {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .commandPool = cmdpool,
+            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .commandBufferCount = 1,
+        };
+        vkAllocateCommandBuffers(device, &allocateInfo, &entry.commandBuffer);
+
+        VkFenceCreateInfo const fenceCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        };
+        vkCreateFence(device, &fenceCreateInfo, VKALLOC, &entry.fence);
+    }
+
+#if FVK_ENABLED(FVK_DEBUG_READ_PIXELS)
+    FVK_LOGD << "readPixels using image=" << entry.image << " (reused=" << reused << ")"
+             << " to copy from image=" << srcTexture->getVkImage()
+             << " src-layout=" << srcTexture->getLayout(0, 0);
+#endif
+
+    VkImage const stagingImage = entry.image;
+    VkCommandBuffer const cmdbuffer = entry.commandBuffer;
 
     VkCommandBufferBeginInfo const binfo{
             .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
@@ -276,11 +325,6 @@ void VulkanReadPixels::run(fvkmemory::resource_ptr<VulkanRenderTarget> srcTarget
 
     VkQueue queue;
     vkGetDeviceQueue(device, graphicsQueueFamilyIndex, 0, &queue);
-    VkFence readCompleteFence;
-    VkFenceCreateInfo const fenceCreateInfo{
-            .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
-    };
-    vkCreateFence(device, &fenceCreateInfo, VKALLOC, &readCompleteFence);
     VkSubmitInfo const submitInfo{
             .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
             .waitSemaphoreCount = 0,
@@ -291,7 +335,7 @@ void VulkanReadPixels::run(fvkmemory::resource_ptr<VulkanRenderTarget> srcTarget
             .signalSemaphoreCount = 0,
             .pSignalSemaphores = VK_NULL_HANDLE,
     };
-    vkQueueSubmit(queue, 1, &submitInfo, readCompleteFence);
+    vkQueueSubmit(queue, 1, &submitInfo, entry.fence);
 
     auto* const pUserBuffer = new PixelBufferDescriptor(std::move(pbd));
     auto cleanPbdFunc = [pUserBuffer, readCompleteFunc]() {
@@ -299,10 +343,9 @@ void VulkanReadPixels::run(fvkmemory::resource_ptr<VulkanRenderTarget> srcTarget
         readCompleteFunc(std::move(p));
         delete pUserBuffer;
     };
-    auto waitFenceFunc = [device, width, height, swizzle, srcFormat, stagingImage, stagingMemory,
-                                 cmdpool, cmdbuffer, pUserBuffer,
-                                 fence = readCompleteFence]() mutable {
-        VkResult status = vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+    auto waitFenceFunc = [this, device, width, height, swizzle, srcFormat, cmdpool, pUserBuffer,
+                                 entry]() mutable {
+        VkResult status = vkWaitForFences(device, 1, &entry.fence, VK_TRUE, UINT64_MAX);
         if (status != VK_SUCCESS) {
             FVK_LOGE << "Failed to wait for readPixels fence";
             return;
@@ -311,11 +354,11 @@ void VulkanReadPixels::run(fvkmemory::resource_ptr<VulkanRenderTarget> srcTarget
         PixelBufferDescriptor& p = *pUserBuffer;
         VkImageSubresource subResource{.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT};
         VkSubresourceLayout subResourceLayout;
-        vkGetImageSubresourceLayout(device, stagingImage, &subResource, &subResourceLayout);
+        vkGetImageSubresourceLayout(device, entry.image, &subResource, &subResourceLayout);
 
         // Map image memory so that we can start copying from it.
         uint8_t const* srcPixels;
-        vkMapMemory(device, stagingMemory, 0, VK_WHOLE_SIZE, 0, (void**) &srcPixels);
+        vkMapMemory(device, entry.memory, 0, VK_WHOLE_SIZE, 0, (void**) &srcPixels);
         srcPixels += subResourceLayout.offset;
 
         if (!DataReshaper::reshapeImage(&p, fvkutils::getComponentType(srcFormat),
@@ -325,11 +368,19 @@ void VulkanReadPixels::run(fvkmemory::resource_ptr<VulkanRenderTarget> srcTarget
             FVK_LOGE << "Unsupported PixelDataFormat or PixelDataType";
         }
 
-        vkUnmapMemory(device, stagingMemory);
-        vkDestroyImage(device, stagingImage, VKALLOC);
-        vkFreeMemory(device, stagingMemory, VKALLOC);
-        vkDestroyFence(device, fence, VKALLOC);
-        vkFreeCommandBuffers(device, cmdpool, 1, &cmdbuffer);
+        vkUnmapMemory(device, entry.memory);
+
+        // Recycle the staging resources for the next readback of the same shape; the pool
+        // is bounded so bursty capture can't hoard memory. terminate() drains the task
+        // handler before destroying the pool, so `this` is valid here.
+        {
+            std::lock_guard<std::mutex> const lock(mStagingPoolMutex);
+            if (mStagingPool.size() < MAX_POOLED_STAGING_COUNT) {
+                mStagingPool.push_back(entry);
+                return;
+            }
+        }
+        destroyStagingEntry(device, cmdpool, entry);
     };
     mTaskHandler->post(std::move(waitFenceFunc), std::move(cleanPbdFunc));
 }
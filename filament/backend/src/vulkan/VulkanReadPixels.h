@@ -28,6 +28,7 @@
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 namespace filament::backend {
 
@@ -82,9 +83,30 @@ public:
     void runUntilComplete();
 
 private:
+    // Everything needed for one in-flight readback. Completed entries are recycled into
+    // mStagingPool so that continuous capture (e.g. one readPixels per frame from a headless
+    // swapchain) doesn't allocate staging memory or a command buffer on every call.
+    struct StagingEntry {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    // enough for double-buffered capture plus some slack
+    static constexpr size_t MAX_POOLED_STAGING_COUNT = 4;
+
+    static void destroyStagingEntry(VkDevice device, VkCommandPool cmdpool,
+            StagingEntry const& entry) noexcept;
+
     VkDevice mDevice = VK_NULL_HANDLE;
     VkCommandPool mCommandPool = VK_NULL_HANDLE;
     std::unique_ptr<TaskHandler> mTaskHandler;
+    std::mutex mStagingPoolMutex; // the pool is refilled from the task handler's thread
+    std::vector<StagingEntry> mStagingPool;
 };
 
 }// namespace filament::backend
@@ -68,46 +68,50 @@ fvkmemory::resource_ptr<VulkanStage::Segment> VulkanStagePool::acquireStage(uint
     // no adjacent atoms.
     numBytes = alignToNonCoherentAtomSize(numBytes);
 
-    // First check if a stage segment exists whose capacity is greater than or
-    // equal to the requested size.
-    auto iter = mStages.lower_bound(numBytes);
-
-    // If we have potential buffer candidates, loop through and try to find one
-    // that works with our alignment. Also, set the offset for the buffer.
-    // If we have no buffer, create a new one.
     VulkanStage* pStage = nullptr;
     uint32_t segmentOffset = 0;
-    while (iter != mStages.end()) {
-        segmentOffset = alignValue(iter->second->currentOffset(), alignment);
-
-        // Check for overflow + if there's space.
-        if (segmentOffset >= iter->second->currentOffset() &&
-                iter->second->capacity() - numBytes >= segmentOffset) {
-            // This buffer has enough space.
-            pStage = iter->second;
-            mStages.erase(iter);
-            break;
+
+    // Checks whether `numBytes` fits in `stage` at its current offset, watching
+    // for overflow of the aligned offset.
+    auto const tryCarve = [&pStage, &segmentOffset, numBytes, alignment](VulkanStage* stage) {
+        uint32_t const offset = alignValue(stage->currentOffset(), alignment);
+        if (offset >= stage->currentOffset() && stage->capacity() >= numBytes &&
+                stage->capacity() - numBytes >= offset) {
+            pStage = stage;
+            segmentOffset = offset;
+            return true;
         }
+        return false;
+    };
 
-        // This buffer wasn't suitable. Check the next larger one.
-        ++iter;
+    // Fast path: bump-allocate from the current stage.
+    if (UTILS_UNLIKELY(mStages.empty() || !tryCarve(mStages[mCurrentStage]))) {
+        // The current stage is full (or too small). Move on to a stage whose segments have
+        // all been reclaimed -- i.e. the command buffers that consumed them have had their
+        // submission fence signaled -- resetting it for reuse.
+        for (size_t i = 0, n = mStages.size(); i < n; ++i) {
+            VulkanStage* const stage = mStages[i];
+            if (i != mCurrentStage && stage->isSafeToReset()) {
+                stage->reset();
+            }
+            if (tryCarve(stage)) {
+                mCurrentStage = i;
+                break;
+            }
+        }
+        if (!pStage) {
+            pStage = allocateNewStage(std::max(numBytes, STAGE_SIZE));
+            mStages.push_back(pStage);
+            mCurrentStage = mStages.size() - 1;
+            segmentOffset = 0;
+        }
     }
 
-    if (!pStage) {
-        pStage = allocateNewStage(std::max(numBytes, STAGE_SIZE));
-    }
+    pStage->mLastAccessed = mCurrentFrame;
 
     // Note: this allocation updates `currentOffset` and `segments` within
     // the parent stage. When destroyed, it will update `segments`.
-    fvkmemory::resource_ptr<VulkanStage::Segment> pSegment =
-            pStage->acquireSegment(mResManager, segmentOffset, numBytes);
-
-    // Update the stage's metadata, and reinsert it with the remaining segment
-    // capacity.
-    uint32_t spaceRemaining = pStage->capacity() - pStage->currentOffset();
-    mStages.insert({ spaceRemaining, pStage });
-
-    return pSegment;
+    return pStage->acquireSegment(mResManager, segmentOffset, numBytes);
 }
 
 uint32_t VulkanStagePool::alignToNonCoherentAtomSize(uint32_t bytes) {
@@ -233,35 +237,29 @@ void VulkanStagePool::gc() noexcept {
     }
     const uint64_t evictionTime = mCurrentFrame - TIME_BEFORE_EVICTION;
 
-    decltype(mStages) freeStages;
-    freeStages.swap(mStages);
-    uint8_t freeStageCount = 0;  // Assuming we'll never have > 255 free stages
-    for (auto& pair : freeStages) {
-        // First, find any stages that have no segments within them.
-        if (pair.second->isSafeToReset()) {
-            if (++freeStageCount > MAX_EMPTY_STAGES_TO_RETAIN) {
+    // Destroy empty stages that haven't been carved into for several frames, keeping a few
+    // around so steady-state streaming doesn't reallocate them every frame.
+    uint8_t emptyStageCount = 0;  // Assuming we'll never have > 255 empty stages
+    for (auto iter = mStages.begin(); iter != mStages.end();) {
+        VulkanStage* const stage = *iter;
+        if (stage->isSafeToReset()) {
+            stage->reset();
+            if (++emptyStageCount > MAX_EMPTY_STAGES_TO_RETAIN &&
+                    stage->mLastAccessed < evictionTime) {
 #if FVK_ENABLED(FVK_DEBUG_STAGING_ALLOCATION)
-                FVK_LOGD << "Destroying a staging buffer with hndl " << pair.second->buffer()
+                FVK_LOGD << "Destroying a staging buffer with hndl " << stage->buffer()
                          << utils::io::endl;
 #endif
-                destroyStage(std::move(pair.second));
+                destroyStage(static_cast<VulkanStage const*>(stage));
+                iter = mStages.erase(iter);
                 continue;
             }
-
-#if FVK_ENABLED(FVK_DEBUG_STAGING_ALLOCATION)
-            if (pair.first == 0) {
-                FVK_LOGD << "Recycling an unused staging buffer with hndl " << pair.second->buffer()
-                         << utils::io::endl;
-            }
-#endif
-
-            // Note - this segment is free, make sure the structure is cleared
-            // and reinsert it into our free stage list.
-            pair.second->reset();
-            mStages.insert({ pair.second->capacity(), pair.second });
-        } else {
-            mStages.insert(pair);
         }
+        ++iter;
+    }
+    // the eviction above may have invalidated the current stage index
+    if (mCurrentStage >= mStages.size()) {
+        mCurrentStage = 0;
     }
 
     // Destroy images that have not been used for several frames.
@@ -280,10 +278,11 @@ void VulkanStagePool::gc() noexcept {
 }
 
 void VulkanStagePool::terminate() noexcept {
-    for (auto& pair : mStages) {
-        destroyStage(std::move(pair.second));
+    for (VulkanStage* stage : mStages) {
+        destroyStage(static_cast<VulkanStage const*>(stage));
     }
     mStages.clear();
+    mCurrentStage = 0;
 
     for (auto image : mFreeImages) {
         vmaDestroyImage(mAllocator, image->image(), image->memory());
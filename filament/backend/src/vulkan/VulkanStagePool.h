@@ -23,7 +23,7 @@
 #include "vulkan/memory/ResourceManager.h"
 #include "vulkan/memory/ResourcePointer.h"
 
-#include <map>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -120,6 +120,11 @@ private:
 
     uint32_t mCurrentOffset = 0;
 
+    // Frame count at which a segment was last carved out of this stage; used by the pool
+    // to evict stages that haven't been needed for a while.
+    uint64_t mLastAccessed = 0;
+    friend class VulkanStagePool;
+
     // Maps the start offset of a vulkan stage block to the stage block,
     // for easy deletions later. This is managed by the blocks themselves, in an
     // RAII pattern, during construction and destruction.
@@ -199,10 +204,11 @@ public:
     VulkanStagePool(VmaAllocator allocator, fvkmemory::ResourceManager* resManager,
             VulkanCommands* commands, const VkPhysicalDeviceLimits* deviceLimits);
 
-    // Finds or creates a stage block whose capacity is at least the given
-    // number of bytes. Internally, creates and manages and subdivides large
-    // buffers so that we have less objects around that we have to keep track
-    // of.
+    // Carves a segment of at least the given number of bytes out of one of the large,
+    // persistently-mapped stage buffers. In the common case this is just a bump of the
+    // current stage's offset; a stage is reused once all the segments carved from it have
+    // been reclaimed, which happens when the command buffers holding them are reset after
+    // their submission fence signals.
     // This function is NOT thread-safe.
     // numBytes - the number of bytes required by this segment.
     // alignment - the multiple to align the buffer offset to
@@ -247,8 +253,11 @@ private:
     // exist.
     void destroyStage(VulkanStage const*&& stage);
 
-    // Use an ordered multimap for quick (capacity => stage) lookups using lower_bound().
-    std::multimap<uint32_t, VulkanStage*> mStages;
+    // The stages behave like a ring: mCurrentStage is bump-allocated until full, then we
+    // move on to the next stage whose segments have all been reclaimed (or allocate a new
+    // one). Empty stages that haven't been used for a few frames are evicted in gc().
+    std::vector<VulkanStage*> mStages;
+    size_t mCurrentStage = 0;
 
     std::unordered_set<VulkanStageImage*> mFreeImages;
 
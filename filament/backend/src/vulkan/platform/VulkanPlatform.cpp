@@ -240,6 +240,9 @@ ExtensionSet getDeviceExtensions(VkPhysicalDevice device) {
         VK_KHR_MAINTENANCE2_EXTENSION_NAME,
         VK_KHR_MAINTENANCE3_EXTENSION_NAME,
         VK_KHR_MULTIVIEW_EXTENSION_NAME,
+        // Needed for the bindless texture table (see
+        // VulkanContext::isDescriptorIndexingSupported).
+        VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME,
     };
     ExtensionSet exts;
     // Identify supported physical device extensions
@@ -348,6 +351,7 @@ VkInstance createInstance(ExtensionSet const& requiredExts) {
 VkDevice createLogicalDevice(VkPhysicalDevice physicalDevice,
         VkPhysicalDeviceFeatures2 const& features,
         VkPhysicalDeviceVulkan11Features const& vk11Features,
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT const& descriptorIndexingFeatures,
         uint32_t graphicsQueueFamilyIndex,
         uint32_t protectedGraphicsQueueFamilyIndex, ExtensionSet const& deviceExtensions,
         bool requestImageView2DOn3DImage) {
@@ -427,6 +431,24 @@ VkDevice createLogicalDevice(VkPhysicalDevice physicalDevice,
         chainStruct(&deviceCreateInfo, &multiview);
     }
 
+    // Enable just the descriptor-indexing features the bindless texture table relies on,
+    // limited to what the device reported as supported.
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexing = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT,
+        .shaderSampledImageArrayNonUniformIndexing =
+                descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing,
+        .descriptorBindingSampledImageUpdateAfterBind =
+                descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind,
+        .descriptorBindingUpdateUnusedWhilePending =
+                descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending,
+        .descriptorBindingPartiallyBound =
+                descriptorIndexingFeatures.descriptorBindingPartiallyBound,
+        .runtimeDescriptorArray = descriptorIndexingFeatures.runtimeDescriptorArray,
+    };
+    if (setContains(deviceExtensions, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+        chainStruct(&deviceCreateInfo, &descriptorIndexing);
+    }
+
     VkPhysicalDeviceProtectedMemoryFeatures protectedMemory = {
         .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROTECTED_MEMORY_FEATURES,
         .protectedMemory = VK_TRUE,
@@ -844,6 +866,13 @@ Driver* VulkanPlatform::createDriver(void* sharedContext,
         deviceExts = prunedDeviceExts;
     }
 
+    if (setContains(deviceExts, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+        // Query which descriptor-indexing features the device actually supports; only those
+        // are enabled at device creation (see createLogicalDevice).
+        chainStruct(&context.mPhysicalDeviceFeatures, &context.mDescriptorIndexingFeatures);
+        vkGetPhysicalDeviceFeatures2(mImpl->mPhysicalDevice, &context.mPhysicalDeviceFeatures);
+    }
+
     bool requestPortabilitySubsetImageView2DOn3DImage = false;
     if (setContains(deviceExts, VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME)) {
         // We are on a non-conformant vulkan implementation so we need to ascertain if the features
@@ -857,6 +886,7 @@ Driver* VulkanPlatform::createDriver(void* sharedContext,
     if (mImpl->mDevice == VK_NULL_HANDLE) {
         mImpl->mDevice = createLogicalDevice(mImpl->mPhysicalDevice,
                 context.mPhysicalDeviceFeatures, context.mPhysicalDeviceVk11Features,
+                context.mDescriptorIndexingFeatures,
                 mImpl->mGraphicsQueueFamilyIndex, mImpl->mProtectedGraphicsQueueFamilyIndex,
                 deviceExts, requestPortabilitySubsetImageView2DOn3DImage);
     }
@@ -135,7 +135,8 @@ VulkanPlatformSurfaceSwapChain::VulkanPlatformSurfaceSwapChain(VulkanContext con
       mFallbackExtent(fallbackExtent),
       mUsesRGB((flags & backend::SWAP_CHAIN_CONFIG_SRGB_COLORSPACE) != 0),
       mHasStencil((flags & backend::SWAP_CHAIN_HAS_STENCIL_BUFFER) != 0),
-      mIsProtected((flags & backend::SWAP_CHAIN_CONFIG_PROTECTED_CONTENT) != 0) {
+      mIsProtected((flags & backend::SWAP_CHAIN_CONFIG_PROTECTED_CONTENT) != 0),
+      mLowLatency((flags & backend::SWAP_CHAIN_CONFIG_LOW_LATENCY) != 0) {
     assert_invariant(surface);
     create();
 }
@@ -150,6 +151,29 @@ VkResult VulkanPlatformSurfaceSwapChain::create() {
     VkSurfaceCapabilitiesKHR caps;
     vkGetPhysicalDeviceSurfaceCapabilitiesKHR(mPhysicalDevice, mSurface, &caps);
 
+    // Verify that our chosen present mode is supported. In practice all devices support the
+    // FIFO mode, but we check for it anyway for completeness. (and to avoid validation warnings)
+    // In low-latency mode we prefer MAILBOX, which replaces the queued image instead of
+    // blocking, falling back to FIFO where it isn't available.
+    VkPresentModeKHR desiredPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+    FixedCapacityVector<VkPresentModeKHR> presentModes = fvkutils::enumerate(
+            vkGetPhysicalDeviceSurfacePresentModesKHR, mPhysicalDevice, mSurface);
+    if (mLowLatency) {
+        if (std::any_of(presentModes.begin(), presentModes.end(),
+                    [](VkPresentModeKHR m) { return m == VK_PRESENT_MODE_MAILBOX_KHR; })) {
+            desiredPresentMode = VK_PRESENT_MODE_MAILBOX_KHR;
+        }
+    }
+    bool foundSuitablePresentMode = false;
+    for (VkPresentModeKHR mode: presentModes) {
+        if (mode == desiredPresentMode) {
+            foundSuitablePresentMode = true;
+            break;
+        }
+    }
+    FILAMENT_CHECK_POSTCONDITION(foundSuitablePresentMode)
+            << "Desired present mode is not supported by this device.";
+
     // The general advice is to require one more than the minimum swap chain length, since the
     // absolute minimum could easily require waiting for a driver or presentation layer to release
     // the previous frame's buffer. The only situation in which we'd ask for the minimum length is
@@ -157,7 +181,8 @@ VkResult VulkanPlatformSurfaceSwapChain::create() {
     // acceptable.
     uint32_t const maxImageCount = caps.maxImageCount;
     uint32_t const minImageCount = caps.minImageCount;
-    uint32_t desiredImageCount = minImageCount + 1;
+    uint32_t desiredImageCount = (desiredPresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
+            ? minImageCount : minImageCount + 1;
 
     // According to section 30.5 of VK 1.1, maxImageCount of zero means "that there is no limit on
     // the number of images, though there may be limits related to the total amount of memory used
@@ -190,21 +215,6 @@ VkResult VulkanPlatformSurfaceSwapChain::create() {
     FILAMENT_CHECK_POSTCONDITION(surfaceFormat.format != VK_FORMAT_UNDEFINED)
             << "Cannot find suitable swapchain format";
 
-    // Verify that our chosen present mode is supported. In practice all devices support the FIFO
-    // mode, but we check for it anyway for completeness.  (and to avoid validation warnings)
-    VkPresentModeKHR const desiredPresentMode = VK_PRESENT_MODE_FIFO_KHR;
-    FixedCapacityVector<VkPresentModeKHR> presentModes = fvkutils::enumerate(
-            vkGetPhysicalDeviceSurfacePresentModesKHR, mPhysicalDevice, mSurface);
-    bool foundSuitablePresentMode = false;
-    for (VkPresentModeKHR mode: presentModes) {
-        if (mode == desiredPresentMode) {
-            foundSuitablePresentMode = true;
-            break;
-        }
-    }
-    FILAMENT_CHECK_POSTCONDITION(foundSuitablePresentMode)
-            << "Desired present mode is not supported by this device.";
-
     // Create the low-level swap chain.
     if (caps.currentExtent.width == VULKAN_UNDEFINED_EXTENT
             || caps.currentExtent.height == VULKAN_UNDEFINED_EXTENT) {
@@ -126,6 +126,7 @@ private:
     bool mUsesRGB = false;
     bool mHasStencil = false;
     bool mIsProtected = false;
+    bool mLowLatency = false;
     bool mSuboptimal;
 };
 
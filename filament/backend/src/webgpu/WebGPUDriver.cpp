@@ -74,7 +74,7 @@ WebGPUDriver::WebGPUDriver(WebGPUPlatform& platform,
       mDevice{ mPlatform.requestDevice(mAdapter) },
       mQueue{ mDevice.GetQueue() },
       mPipelineLayoutCache{ mDevice },
-      mPipelineCache{ mDevice },
+      mPipelineCache{ mDevice, mAdapter.GetInstance() },
       mRenderPassMipmapGenerator{ mDevice },
       mSpdComputePassMipmapGenerator{ mDevice },
       mHandleAllocator{ "Handles", driverConfig.handleArenaSize,
@@ -529,6 +529,11 @@ int64_t WebGPUDriver::getStreamTimestamp(Handle<HwStream> sh) {
     return 0;
 }
 
+StreamStats WebGPUDriver::getStreamStats(Handle<HwStream> sh) {
+    //todo
+    return {};
+}
+
 void WebGPUDriver::updateStreams(CommandStream* driver) {
     //todo
 }
@@ -610,6 +615,10 @@ bool WebGPUDriver::isParallelShaderCompileSupported() {
     return false;
 }
 
+uint32_t WebGPUDriver::getShaderCompilerQueueDepth() {
+    return 0;
+}
+
 bool WebGPUDriver::isDepthStencilResolveSupported() {
     return false;
 }
@@ -850,6 +859,15 @@ void WebGPUDriver::compilePrograms(CompilerPriorityQueue priority,
     }
 }
 
+void WebGPUDriver::setCompilerPriorityQueue(Handle<HwProgram> ph, CompilerPriorityQueue priority) {
+    // todo
+}
+
+void* WebGPUDriver::getBufferObjectMapping(Handle<HwBufferObject> boh) {
+    // WebGPU buffer mappings are not persistent
+    return nullptr;
+}
+
 void WebGPUDriver::beginRenderPass(Handle<HwRenderTarget> renderTargetHandle,
         RenderPassParams const& params) {
     assert_invariant(mCommandEncoder);
@@ -991,6 +1009,8 @@ void WebGPUDriver::beginRenderPass(Handle<HwRenderTarget> renderTargetHandle,
             customDepthStencilMsaaSidecarTextureView);
 
     mRenderPassEncoder = mCommandEncoder.BeginRenderPass(&renderPassDescriptor);
+    // a new pass encoder starts with no bind groups, so everything we have needs rebinding
+    mDirtyDescriptorSets = (1u << MAX_DESCRIPTOR_SET_COUNT) - 1u;
 
     // Ensure viewport dimensions are not 0
     FILAMENT_CHECK_POSTCONDITION(params.viewport.width > 0) << "viewport width is 0?";
@@ -1008,6 +1028,7 @@ void WebGPUDriver::beginRenderPass(Handle<HwRenderTarget> renderTargetHandle,
 void WebGPUDriver::endRenderPass(int /* dummy */) {
     mRenderPassEncoder.End();
     mRenderPassEncoder = nullptr;
+    mPendingRenderPipeline = nullptr;
 }
 
 void WebGPUDriver::nextSubpass(int) {
@@ -1051,6 +1072,10 @@ void WebGPUDriver::makeCurrent(Handle<HwSwapChain> drawSch, Handle<HwSwapChain>
     assert_invariant(mCommandEncoder);
 }
 
+void WebGPUDriver::setPresentationDamage(Handle<HwSwapChain> sch, Viewport damage) {
+    // surface presentation with damage is not exposed by webgpu, ignored.
+}
+
 void WebGPUDriver::commit(Handle<HwSwapChain> sch) {
     wgpu::CommandBufferDescriptor commandBufferDescriptor{
         .label = "command_buffer",
@@ -1163,6 +1188,10 @@ void WebGPUDriver::blit(Handle<HwTexture> destinationTextureHandle, const uint8_
     // todo
 }
 
+void WebGPUDriver::precompilePipeline(PipelineState const& pipelineState) {
+    // todo
+}
+
 void WebGPUDriver::bindPipeline(PipelineState const& pipelineState) {
     assert_invariant(mRenderPassEncoder);
     const auto program{ handleCast<WebGPUProgram>(pipelineState.program) };
@@ -1249,9 +1278,9 @@ void WebGPUDriver::bindPipeline(PipelineState const& pipelineState) {
         .colorFormatCount = colorFormatCount,
         .colorFormats = colorFormats.data(),
     };
-    wgpu::RenderPipeline const& pipeline{ mPipelineCache.getOrCreateRenderPipeline(
-            pipelineRequest) };
-    mRenderPassEncoder.SetPipeline(pipeline);
+    // Pipeline creation may still be in flight on a worker thread at this point; we defer
+    // actually setting the pipeline (and thus waiting on it) until the first draw using it.
+    mPendingRenderPipeline = mPipelineCache.getOrCreateRenderPipeline(pipelineRequest);
 }
 
 void WebGPUDriver::bindRenderPrimitive(Handle<HwRenderPrimitive> renderPrimitiveHandle) {
@@ -1273,13 +1302,25 @@ void WebGPUDriver::bindRenderPrimitive(Handle<HwRenderPrimitive> renderPrimitive
 void WebGPUDriver::draw2(const uint32_t indexOffset, const uint32_t indexCount,
         const uint32_t instanceCount) {
     // We defer actually binding until we actually draw
+    if (mPendingRenderPipeline) {
+        mRenderPassEncoder.SetPipeline(
+                mPipelineCache.resolveRenderPipeline(*mPendingRenderPipeline));
+        mPendingRenderPipeline = nullptr;
+    }
+    // only (re)bound sets need a SetBindGroup call; bind group state persists on the encoder
+    // across draws, and these calls dominate encoding cost on the web (each one crosses the
+    // Wasm/JS boundary)
     for (size_t i = 0; i < MAX_DESCRIPTOR_SET_COUNT; i++) {
+        if (!(mDirtyDescriptorSets & (1u << i))) {
+            continue;
+        }
         auto& binding = mCurrentDescriptorSets[i];
         if (binding.bindGroup) {
             mRenderPassEncoder.SetBindGroup(i, binding.bindGroup, binding.offsetCount,
                     binding.offsets.data());
         }
     }
+    mDirtyDescriptorSets = 0;
 
     mRenderPassEncoder.DrawIndexed(indexCount, instanceCount, indexOffset, 0, 0);
 }
@@ -1368,6 +1409,13 @@ void WebGPUDriver::bindDescriptorSet(Handle<HwDescriptorSet> descriptorSetHandle
         .bindGroup = wbg,
         .offsetCount = bindGroup->getEntitiesWithDynamicOffsetsCount(),
         .offsets = std::move(offsets) };
+    mDirtyDescriptorSets |= static_cast<uint8_t>(1u << setIndex);
+}
+
+void WebGPUDriver::bindDescriptorSets(backend::DescriptorSetBindingArray&& bindings) {
+    for (auto& entry : bindings) {
+        bindDescriptorSet(entry.dsh, entry.set, std::move(entry.offsets));
+    }
 }
 
 void WebGPUDriver::setDebugTag(HandleBase::HandleId handleId, utils::CString tag) {
@@ -82,6 +82,9 @@ private:
     WebGPURenderTarget* mCurrentRenderTarget = nullptr;
     WebGPUPipelineLayoutCache mPipelineLayoutCache;
     WebGPUPipelineCache mPipelineCache;
+    // pipeline bound by bindPipeline, possibly still being created asynchronously; resolved and
+    // set on the encoder at the first draw that uses it
+    WebGPUPipelineCache::RenderPipelineCacheEntry* mPendingRenderPipeline = nullptr;
     WebGPURenderPassMipmapGenerator mRenderPassMipmapGenerator;
     spd::MipmapGenerator mSpdComputePassMipmapGenerator;
     WebGPUMsaaTextureResolver mMsaaTextureResolver{};
@@ -92,6 +95,10 @@ private:
         backend::DescriptorSetOffsetArray offsets;
     };
     std::array<DescriptorSetBindingInfo,MAX_DESCRIPTOR_SET_COUNT> mCurrentDescriptorSets;
+    // bitmask of descriptor sets (re)bound since the last draw; only these need a SetBindGroup
+    // call on the current pass encoder
+    uint8_t mDirtyDescriptorSets = 0;
+    static_assert(MAX_DESCRIPTOR_SET_COUNT <= 8, "mDirtyDescriptorSets is an 8-bit mask");
 
     /*
      * Driver interface
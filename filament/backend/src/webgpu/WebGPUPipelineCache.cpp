@@ -25,12 +25,18 @@
 
 #include <utils/BitmaskEnum.h>
 #include <utils/Panic.h>
+#include <utils/compiler.h>
 
 #include <webgpu/webgpu_cpp.h>
 
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
 
 namespace filament::backend {
 
@@ -115,24 +121,37 @@ namespace {
 
 }  // namespace
 
-WebGPUPipelineCache::WebGPUPipelineCache(wgpu::Device const& device)
-    : mDevice{ device } {}
+WebGPUPipelineCache::WebGPUPipelineCache(wgpu::Device const& device,
+        wgpu::Instance const& instance)
+    : mDevice{ device },
+      mInstance{ instance } {}
 
-wgpu::RenderPipeline const& WebGPUPipelineCache::getOrCreateRenderPipeline(
+WebGPUPipelineCache::RenderPipelineCacheEntry* WebGPUPipelineCache::getOrCreateRenderPipeline(
         RenderPipelineRequest const& request) {
     RenderPipelineKey key{};
     populateKey(request, key);
     if (auto iterator{ mRenderPipelines.find(key) }; iterator != mRenderPipelines.end()) {
-        RenderPipelineCacheEntry& entry{ iterator.value() };
-        entry.lastUsedFrameCount = mFrameCount;
-        return entry.pipeline;
+        RenderPipelineCacheEntry* entry{ iterator.value().get() };
+        entry->lastUsedFrameCount = mFrameCount;
+        return entry;
     }
-    const wgpu::RenderPipeline pipeline{ createRenderPipeline(request) };
-    mRenderPipelines.emplace(key, RenderPipelineCacheEntry{
-                                      .pipeline = pipeline,
-                                      .lastUsedFrameCount = mFrameCount,
-                                  });
-    return mRenderPipelines[key].pipeline;
+    auto entry{ std::make_unique<RenderPipelineCacheEntry>() };
+    entry->lastUsedFrameCount = mFrameCount;
+    startRenderPipelineCreation(request, *entry);
+    return mRenderPipelines.emplace(key, std::move(entry)).first.value().get();
+}
+
+wgpu::RenderPipeline const& WebGPUPipelineCache::resolveRenderPipeline(
+        RenderPipelineCacheEntry& entry) {
+    if (UTILS_UNLIKELY(entry.creationPending)) {
+        const wgpu::WaitStatus status{ mInstance.WaitAny(entry.creationFuture,
+                std::numeric_limits<uint64_t>::max()) };
+        FILAMENT_CHECK_POSTCONDITION(status == wgpu::WaitStatus::Success)
+                << "Failed to wait for async render pipeline creation ("
+                << static_cast<uint32_t>(status) << ")";
+        entry.creationPending = false;
+    }
+    return entry.pipeline;
 }
 
 void WebGPUPipelineCache::onFrameEnd() {
@@ -213,8 +232,8 @@ void WebGPUPipelineCache::populateKey(RenderPipelineRequest const& request,
     }
 }
 
-wgpu::RenderPipeline WebGPUPipelineCache::createRenderPipeline(
-        RenderPipelineRequest const& request) {
+void WebGPUPipelineCache::startRenderPipelineCreation(RenderPipelineRequest const& request,
+        RenderPipelineCacheEntry& entry) {
     assert_invariant(request.vertexShaderModule);
     wgpu::DepthStencilState depthStencilState{};
     const bool requestedDepth{ any(request.targetRenderFlags & TargetBufferFlags::DEPTH) };
@@ -352,10 +371,20 @@ wgpu::RenderPipeline WebGPUPipelineCache::createRenderPipeline(
         fragmentState.targets = colorTargets.data();
         pipelineDescriptor.fragment = &fragmentState;
     }
-    const wgpu::RenderPipeline pipeline{ mDevice.CreateRenderPipeline(&pipelineDescriptor) };
-    FILAMENT_CHECK_POSTCONDITION(pipeline)
-            << "Failed to create render pipeline for " << pipelineDescriptor.label;
-    return pipeline;
+    // Create the pipeline asynchronously, so validation and compilation can run on an
+    // implementation worker thread while we keep recording commands; the result is waited on in
+    // resolveRenderPipeline(). The entry outlives the callback (entries are heap-allocated and
+    // pending entries are never evicted), so capturing it by reference is safe.
+    entry.creationPending = true;
+    entry.creationFuture = mDevice.CreateRenderPipelineAsync(&pipelineDescriptor,
+            wgpu::CallbackMode::WaitAnyOnly,
+            [&entry, label = request.label](const wgpu::CreatePipelineAsyncStatus status,
+                    wgpu::RenderPipeline pipeline, wgpu::StringView message) {
+                FILAMENT_CHECK_POSTCONDITION(status == wgpu::CreatePipelineAsyncStatus::Success)
+                        << "Failed to create render pipeline for " << label.c_str_safe() << ": "
+                        << std::string(std::string_view(message));
+                entry.pipeline = std::move(pipeline);
+            });
 }
 
 bool WebGPUPipelineCache::RenderPipelineKeyEqual::operator()(RenderPipelineKey const& key1,
@@ -367,9 +396,10 @@ bool WebGPUPipelineCache::RenderPipelineKeyEqual::operator()(RenderPipelineKey c
 void WebGPUPipelineCache::removeExpiredPipelines() {
     using Iterator = decltype(mRenderPipelines)::const_iterator;
     for (Iterator iterator{ mRenderPipelines.begin() }; iterator != mRenderPipelines.end();) {
-        RenderPipelineCacheEntry const& entry{ iterator.value() };
-        if (mFrameCount > (entry.lastUsedFrameCount +
-                                  FILAMENT_WEBGPU_RENDER_PIPELINE_EXPIRATION_IN_FRAME_COUNT)) {
+        RenderPipelineCacheEntry const& entry{ *iterator.value() };
+        if (!entry.creationPending &&
+                mFrameCount > (entry.lastUsedFrameCount +
+                                      FILAMENT_WEBGPU_RENDER_PIPELINE_EXPIRATION_IN_FRAME_COUNT)) {
             // pipeline expired...
             iterator = mRenderPipelines.erase(iterator);
         } else {
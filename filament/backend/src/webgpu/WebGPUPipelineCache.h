@@ -29,6 +29,7 @@
 #include <webgpu/webgpu_cpp.h>
 
 #include <cstdint>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
@@ -54,15 +55,37 @@ public:
         wgpu::TextureFormat const* colorFormats;
     };
 
-    explicit WebGPUPipelineCache(wgpu::Device const&);
+    /**
+     * A cached pipeline. The pipeline may still be being created asynchronously by the
+     * implementation (e.g. on a Dawn worker thread), in which case creationPending is true and
+     * pipeline is null until resolveRenderPipeline() is called.
+     */
+    struct RenderPipelineCacheEntry final {
+        wgpu::RenderPipeline pipeline{ nullptr };
+        wgpu::Future creationFuture{};
+        bool creationPending{ false };
+        uint64_t lastUsedFrameCount{ 0 };
+    };
+
+    WebGPUPipelineCache(wgpu::Device const&, wgpu::Instance const&);
     WebGPUPipelineCache(WebGPUPipelineCache const&) = delete;
     WebGPUPipelineCache(WebGPUPipelineCache const&&) = delete;
     WebGPUPipelineCache& operator=(WebGPUPipelineCache const&) = delete;
     WebGPUPipelineCache& operator=(WebGPUPipelineCache const&&) = delete;
 
-    [[nodiscard]] wgpu::RenderPipeline const& getOrCreateRenderPipeline(
+    /**
+     * Returns the cache entry for the requested pipeline, kicking off an asynchronous creation
+     * (wgpuDeviceCreateRenderPipelineAsync) on a cache miss. The returned entry may still be
+     * pending; call resolveRenderPipeline() when the pipeline is actually needed, e.g. just
+     * before recording the first draw that uses it, so creation can proceed concurrently with
+     * the command recording in between. The entry stays valid at least until onFrameEnd().
+     */
+    [[nodiscard]] RenderPipelineCacheEntry* getOrCreateRenderPipeline(
             RenderPipelineRequest const&);
 
+    /** Waits for the entry's pipeline creation to finish, if it is still in flight. */
+    [[nodiscard]] wgpu::RenderPipeline const& resolveRenderPipeline(RenderPipelineCacheEntry&);
+
     void onFrameEnd();
 
 private:
@@ -169,19 +192,17 @@ private:
         bool operator()(RenderPipelineKey const&, RenderPipelineKey const&) const;
     };
 
-    struct RenderPipelineCacheEntry final {
-        wgpu::RenderPipeline pipeline{ nullptr };
-        uint64_t lastUsedFrameCount{ 0 };
-    };
-
     static void populateKey(RenderPipelineRequest const&, RenderPipelineKey& outKey);
 
-    [[nodiscard]] wgpu::RenderPipeline createRenderPipeline(RenderPipelineRequest const&);
+    void startRenderPipelineCreation(RenderPipelineRequest const&, RenderPipelineCacheEntry&);
 
     void removeExpiredPipelines();
 
     wgpu::Device mDevice;
-    tsl::robin_map<RenderPipelineKey, RenderPipelineCacheEntry,
+    wgpu::Instance mInstance;
+    // entries are heap-allocated so the asynchronous creation callback can write to them
+    // regardless of map rehashing
+    tsl::robin_map<RenderPipelineKey, std::unique_ptr<RenderPipelineCacheEntry>,
             utils::hash::MurmurHashFn<RenderPipelineKey>, RenderPipelineKeyEqual>
             mRenderPipelines{};
     uint64_t mFrameCount{ 0 };
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Replays a command stream captured with CommandStreamCapture (see the
+ * FILAMENT_COMMAND_CAPTURE environment variable) against any backend, repeatedly, and reports
+ * the time spent decoding and executing it -- a proxy for the driver-thread overhead of
+ * production frames that can be compared across backends and bisected without the application
+ * that produced the capture.
+ */
+
+#include "private/backend/CommandBufferQueue.h"
+#include "private/backend/CommandStream.h"
+#include "private/backend/CommandStreamReplayer.h"
+#include "private/backend/PlatformFactory.h"
+
+#include <backend/DriverEnums.h>
+#include <backend/Platform.h>
+
+#include <utils/Invocable.h>
+
+#include <chrono>
+#include <string>
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace filament::backend;
+
+static void printUsage(const char* name) {
+    printf("Usage: %s [options] <capture-file>\n"
+           "Options:\n"
+           "  -a, --api=<opengl|vulkan|metal|noop>  backend to replay against (default: opengl)\n"
+           "  -n, --iterations=<count>              number of replay iterations (default: 8)\n"
+           "  -s, --size=<WxH>                      headless swap chain size (default: 1920x1080)\n"
+           "  -h, --help                            print this message\n", name);
+}
+
+int main(int argc, char* argv[]) {
+    Backend backend = Backend::OPENGL;
+    size_t iterations = 8;
+    uint32_t width = 1920;
+    uint32_t height = 1080;
+
+    static constexpr struct option OPTIONS[] = {
+            { "api",        required_argument, nullptr, 'a' },
+            { "iterations", required_argument, nullptr, 'n' },
+            { "size",       required_argument, nullptr, 's' },
+            { "help",       no_argument,       nullptr, 'h' },
+            { nullptr, 0, nullptr, 0 }
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "a:n:s:h", OPTIONS, nullptr)) >= 0) {
+        switch (opt) {
+            case 'a':
+                if (!strcmp(optarg, "opengl")) {
+                    backend = Backend::OPENGL;
+                } else if (!strcmp(optarg, "vulkan")) {
+                    backend = Backend::VULKAN;
+                } else if (!strcmp(optarg, "metal")) {
+                    backend = Backend::METAL;
+                } else if (!strcmp(optarg, "noop")) {
+                    backend = Backend::NOOP;
+                } else {
+                    fprintf(stderr, "Unknown backend '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'n':
+                iterations = strtoul(optarg, nullptr, 10);
+                break;
+            case 's':
+                if (sscanf(optarg, "%ux%u", &width, &height) != 2) {
+                    fprintf(stderr, "Invalid size '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'h':
+            default:
+                printUsage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (optind >= argc) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    CommandStreamReplayer replayer;
+    if (!replayer.open(argv[optind])) {
+        return 1;
+    }
+    replayer.setHeadlessSwapChainSize(width, height);
+
+    Platform* platform = PlatformFactory::create(&backend);
+    Driver* const driver = platform->createDriver(nullptr, {});
+    if (!driver) {
+        fprintf(stderr, "Couldn't create the driver\n");
+        return 1;
+    }
+
+    constexpr size_t MiB = 1024u * 1024u;
+    CommandBufferQueue queue(1 * MiB, 3 * MiB, false);
+    DriverApi driverApi(*driver, queue.getCircularBuffer());
+
+    // everything runs on this thread, so flushing also executes
+    std::chrono::nanoseconds executeTime{};
+    utils::Invocable<void()> const flush = [&queue, &driverApi, &executeTime]() {
+        queue.flush();
+        auto const buffers = queue.waitForCommands();
+        auto const start = std::chrono::steady_clock::now();
+        for (auto const& item : buffers) {
+            driverApi.execute(item.begin);
+            queue.releaseBuffer(item);
+        }
+        executeTime += std::chrono::steady_clock::now() - start;
+    };
+
+    for (size_t i = 0; i < iterations; i++) {
+        executeTime = {};
+        auto const start = std::chrono::steady_clock::now();
+        size_t const commands = replayer.replay(driverApi, flush);
+        std::chrono::nanoseconds const total = std::chrono::steady_clock::now() - start;
+        printf("iteration %2zu: %zu commands, total %.3f ms, execute %.3f ms\n",
+                i, commands, double(total.count()) * 1e-6,
+                double(executeTime.count()) * 1e-6);
+    }
+
+    if (size_t const unresolved = replayer.getUnresolvedHandleCount()) {
+        fprintf(stderr, "warning: %zu handle references predate the capture "
+                        "(capture the engine's whole life for exact replay)\n", unresolved);
+    }
+
+    driverApi.finish();
+    flush();
+    driverApi.terminate();
+    delete driver;
+    PlatformFactory::destroy(&platform);
+    return 0;
+}
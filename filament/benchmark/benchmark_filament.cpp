@@ -22,6 +22,7 @@
 #include <filament/Box.h>
 #include <filament/Frustum.h>
 #include "Culler.h"
+#include "ShadowMap.h"
 
 #include <utils/Allocator.h>
 
@@ -103,3 +104,66 @@ BENCHMARK_F(FilamentCullingFixture, sphereCulling)(benchmark::State& state) {
         state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
     }
 }
+
+BENCHMARK_F(FilamentCullingFixture, sphereCullingScalar)(benchmark::State& state) {
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            Culler::Test::intersectsScalar(visibles, frustum, spheres.data(), BATCH_SIZE);
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+    }
+}
+
+class FilamentShadowMapFixture : public benchmark::Fixture {
+protected:
+    static constexpr size_t BATCH_SIZE = 512;
+
+    mat4f projection;
+    std::vector<Aabb> boxes;
+    ShadowMap::Test::FrustumBoxIntersection vertices{};
+
+public:
+    FilamentShadowMapFixture() {
+
+        std::default_random_engine gen; // NOLINT
+        std::uniform_real_distribution<float> rand(0.1f, 100.0f);
+
+        // stands in for the view frustum (or a cascade's split of it) being fitted in
+        // ShadowMap::computeShadowCameraDirectional()
+        projection = mat4f::perspective(45.0f, 1.0f, 0.1f, 100.0f);
+
+        boxes.resize(BATCH_SIZE);
+        for (Aabb& box : boxes) {
+            float const z = rand(gen);
+            float3 const center = {
+                    rand(gen, std::uniform_real_distribution<float>::param_type{ -z, z }),
+                    rand(gen, std::uniform_real_distribution<float>::param_type{ -z, z }),
+                    -z };
+            float3 const extent = {
+                    rand(gen, std::uniform_real_distribution<float>::param_type{ 0.11f, 25.0f }),
+                    rand(gen, std::uniform_real_distribution<float>::param_type{ 0.11f, 25.0f }),
+                    rand(gen, std::uniform_real_distribution<float>::param_type{ 0.11f, 25.0f })
+            };
+            box = Aabb{ center - extent, center + extent };
+        }
+    }
+};
+
+BENCHMARK_F(FilamentShadowMapFixture, frustumBoxIntersection)(benchmark::State& state) {
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            size_t vertexCount = 0;
+            for (Aabb const& box : boxes) {
+                vertexCount += ShadowMap::Test::intersectFrustumWithBox(vertices, projection, box);
+            }
+            benchmark::DoNotOptimize(vertexCount);
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+    }
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <filament/Camera.h>
+#include <filament/DebugRegistry.h>
+#include <filament/Engine.h>
+#include <filament/Renderer.h>
+#include <filament/Scene.h>
+#include <filament/SwapChain.h>
+#include <filament/View.h>
+#include <filament/Viewport.h>
+
+#include <scenegen/SceneGenerator.h>
+
+#include <utils/Entity.h>
+#include <utils/EntityManager.h>
+
+#include <math/vec3.h>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace filament;
+using namespace filament::math;
+using namespace utils;
+
+namespace {
+
+// Full-frame benchmark: renders deterministic scenes (see libs/scenegen) against a headless
+// SwapChain, so the RenderPass/FrameGraph/driver interplay is exercised end-to-end rather
+// than just the micro paths covered by the fixtures in benchmark_filament.cpp. Run with
+// --benchmark_format=json --benchmark_out=frame.json for per-commit tracking; the backend
+// can be forced with FILAMENT_BENCHMARK_BACKEND=[opengl|vulkan|metal|noop].
+
+Engine::Backend getRequestedBackend() {
+    char const* const env = getenv("FILAMENT_BENCHMARK_BACKEND");
+    if (env) {
+        if (!strcmp(env, "opengl")) return Engine::Backend::OPENGL;
+        if (!strcmp(env, "vulkan")) return Engine::Backend::VULKAN;
+        if (!strcmp(env, "metal")) return Engine::Backend::METAL;
+        if (!strcmp(env, "noop")) return Engine::Backend::NOOP;
+    }
+    return Engine::Backend::DEFAULT;
+}
+
+} // anonymous
+
+class FilamentFrameFixture : public benchmark::Fixture {
+protected:
+    static constexpr uint32_t WIDTH = 1920;
+    static constexpr uint32_t HEIGHT = 1080;
+    static constexpr float EXTENT = 50.0f;
+
+    Engine* mEngine = nullptr;
+    SwapChain* mSwapChain = nullptr;
+    Renderer* mRenderer = nullptr;
+    Scene* mScene = nullptr;
+    View* mView = nullptr;
+    Camera* mCamera = nullptr;
+    Entity mCameraEntity;
+    scenegen::SceneGenerator* mGenerator = nullptr;
+
+public:
+    void SetUp(benchmark::State const& state) override {
+        mEngine = Engine::create(getRequestedBackend());
+        mSwapChain = mEngine->createSwapChain(WIDTH, HEIGHT);
+        mRenderer = mEngine->createRenderer();
+        mScene = mEngine->createScene();
+        mView = mEngine->createView();
+
+        mCameraEntity = mEngine->getEntityManager().create();
+        mCamera = mEngine->createCamera(mCameraEntity);
+
+        // a null base material means the engine's default (lit) material is used, which
+        // keeps the benchmark free of matc-generated resources
+        mGenerator = new scenegen::SceneGenerator(*mEngine);
+        scenegen::SceneSpec spec;
+        spec.renderableCount = uint32_t(state.range(0));
+        spec.pointLightCount = uint32_t(state.range(1));
+        spec.seed = 82828;
+        spec.extent = EXTENT;
+        mGenerator->generate(*mScene, spec);
+
+        mCamera->setProjection(45.0, double(WIDTH) / HEIGHT, 0.1, 1000.0);
+        mCamera->lookAt({ 0.0f, EXTENT * 0.75f, EXTENT * 1.5f }, { 0, 0, 0 }, { 0, 1, 0 });
+
+        mView->setViewport({ 0, 0, WIDTH, HEIGHT });
+        mView->setCamera(mCamera);
+        mView->setScene(mScene);
+    }
+
+    void TearDown(benchmark::State const&) override {
+        delete mGenerator;
+        mGenerator = nullptr;
+        mEngine->destroyCameraComponent(mCameraEntity);
+        mEngine->getEntityManager().destroy(mCameraEntity);
+        mEngine->destroy(mView);
+        mEngine->destroy(mScene);
+        mEngine->destroy(mRenderer);
+        mEngine->destroy(mSwapChain);
+        Engine::destroy(&mEngine);
+    }
+
+protected:
+    void renderFrame() {
+        if (mRenderer->beginFrame(mSwapChain)) {
+            mRenderer->render(mView);
+            mRenderer->endFrame();
+        }
+        // wait for the GPU so each iteration measures a complete frame rather than
+        // just command submission
+        mEngine->flushAndWait();
+    }
+
+    void reportGpuTime(benchmark::State& state) {
+        // the frame info history is fed by the backend's timer queries
+        auto const info = mEngine->getDebugRegistry().getDataSource("d.view.frame_info");
+        if (info.data && info.count) {
+            auto const* history = static_cast<DebugRegistry::FrameHistory const*>(info.data);
+            float gpuMs = 0.0f;
+            size_t n = 0;
+            for (size_t i = 0; i < info.count; i++) {
+                if (history[i].frameTime > 0.0f) {
+                    gpuMs += history[i].frameTime;
+                    n++;
+                }
+            }
+            if (n > 0) {
+                state.counters["gpu_frame_ms"] = gpuMs / float(n);
+            }
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(FilamentFrameFixture, fullFrame)(benchmark::State& state) {
+    // warm up so program compilation and driver caches don't pollute the measurement
+    for (int i = 0; i < 8; i++) {
+        renderFrame();
+    }
+    for (auto _ : state) {
+        renderFrame();
+    }
+    reportGpuTime(state);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// {renderables, point lights}
+BENCHMARK_REGISTER_F(FilamentFrameFixture, fullFrame)
+        ->Args({ 64, 0 })
+        ->Args({ 512, 0 })
+        ->Args({ 2048, 0 })
+        ->Args({ 512, 64 })
+        ->Args({ 2048, 256 })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
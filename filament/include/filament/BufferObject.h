@@ -54,6 +54,7 @@ class UTILS_PUBLIC BufferObject : public FilamentAPI {
 public:
     using BufferDescriptor = backend::BufferDescriptor;
     using BindingType = backend::BufferObjectBinding;
+    using UsageType = backend::BufferUsage;
 
     class Builder : public BuilderBase<BuilderDetails>, public BuilderNameMixin<Builder> {
         friend struct BuilderDetails;
@@ -79,6 +80,19 @@ public:
          */
         Builder& bindingType(BindingType bindingType) noexcept;
 
+        /**
+         * Usage hint for this buffer object. (defaults to STATIC)
+         *
+         * UsageType::SHARED requests a persistent, coherent CPU mapping of the buffer, so the
+         * content can be produced directly into GPU-visible memory (see getMappedBuffer()),
+         * skipping the copy that setBuffer() otherwise makes. Not all backends support this;
+         * when unsupported, the buffer behaves like DYNAMIC.
+         *
+         * @param usage Usage hint for this buffer.
+         * @return A reference to this Builder for chaining calls.
+         */
+        Builder& usage(UsageType usage) noexcept;
+
         /**
          * Associate an optional name with this BufferObject for debugging purposes.
          *
@@ -140,6 +154,22 @@ public:
      */
     size_t getByteCount() const noexcept;
 
+    /**
+     * Returns the persistent CPU mapping of a BufferObject created with UsageType::SHARED, or
+     * nullptr if the backend doesn't support persistent mappings (in which case setBuffer()
+     * must be used instead). The mapping is coherent: CPU writes become visible to subsequent
+     * frames without further API calls, but it is the caller's responsibility not to overwrite
+     * a region the GPU may still be reading from.
+     *
+     * The mapping only exists once the buffer creation has executed on the backend; calling
+     * this right after build() can return nullptr even on backends that do support it, waiting
+     * for Engine::flushAndWait() or one frame guarantees availability.
+     *
+     * @param engine Reference to the filament::Engine associated with this BufferObject.
+     * @return The persistently mapped buffer memory, or nullptr.
+     */
+    void* UTILS_NULLABLE getMappedBuffer(Engine& engine) const noexcept;
+
 protected:
     // prevent heap allocation
     ~BufferObject() = default;
@@ -487,6 +487,19 @@ public:
         friend class FColorGrading;
     };
 
+    /**
+     * Returns whether this ColorGrading's look-up table has finished baking.
+     *
+     * The 3D look-up table is generated asynchronously when the ColorGrading is built.
+     * A View keeps using its current color grading until the new one is ready, so changing
+     * gradings is hitch-free; this method can be used to know when the switch will occur.
+     * The tone mapper passed to Builder::toneMapper() must not be destroyed before this
+     * returns true.
+     *
+     * @return true once the look-up table is ready to be used
+     */
+    bool isReady() const noexcept;
+
 protected:
     // prevent heap allocation
     ~ColorGrading() = default;
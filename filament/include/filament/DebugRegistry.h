@@ -26,6 +26,7 @@
 #include <math/mathfwd.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace filament {
 
@@ -118,6 +119,57 @@ public:
 
     DataSource getDataSource(const char* UTILS_NONNULL name) const noexcept;
 
+    /**
+     * Type of a published counter value.
+     * @see snapshotCounters()
+     */
+    enum class CounterType : uint8_t {
+        UINT64,     //!< the counter holds a uint64_t, read from CounterSnapshot::u64
+        FLOAT       //!< the counter holds a float, read from CounterSnapshot::f
+    };
+
+    /**
+     * A point-in-time copy of a counter published by an engine subsystem.
+     */
+    struct CounterSnapshot {
+        const char* UTILS_NONNULL name; //!< stable counter name, e.g. "d.renderer.frame_count"
+        CounterType type;               //!< selects which union member is valid
+        union {
+            uint64_t u64;
+            float f;
+        };
+    };
+
+    /**
+     * Copies the current value of every published counter into \p out.
+     *
+     * Counters are written with single atomic stores by engine subsystems and read here
+     * without taking a lock, so polling them at a low frequency (e.g. 1Hz) from another
+     * thread is safe, even in shipping builds.
+     *
+     * @param out destination array, may be nullptr when \p capacity is 0
+     * @param capacity number of elements available in \p out
+     * @return the total number of published counters, which may exceed \p capacity
+     */
+    size_t snapshotCounters(CounterSnapshot* UTILS_NULLABLE out, size_t capacity) const noexcept;
+
+    /**
+     * Per-render-pass statistics estimated at FrameGraph compile time, exposed through the
+     * "d.renderer.pass_stats" data source. Attachment traffic is computed from the declared
+     * attachment descriptors and their load/store (discard) flags; on tile-based GPUs this
+     * is where most of the bandwidth goes. The data source has a fixed capacity; entries
+     * past the last pass have an empty name.
+     */
+    struct PassStats {
+        static constexpr size_t NAME_LENGTH = 32;
+        char name[NAME_LENGTH];         //!< pass name, truncated, empty past the last pass
+        uint64_t attachmentReadBytes;   //!< estimated bytes loaded from attachments
+        uint64_t attachmentWriteBytes;  //!< estimated bytes stored to attachments
+        //! measured GPU time in ns, 0 unless "d.renderer.gpu_pass_profiling" is set;
+        //! results lag by a few frames (matched to passes by name)
+        uint64_t gpuTimeNs;
+    };
+
     struct FrameHistory {
         using duration_ms = float;
         duration_ms target{};
@@ -19,6 +19,7 @@
 
 
 #include <filament/FilamentAPI.h>
+#include <filament/MaterialEnums.h>
 
 #include <backend/DriverEnums.h>
 #include <backend/Platform.h>
@@ -318,6 +319,23 @@ public:
          */
         size_t metalUploadBufferSizeBytes = 512 * 1024;
 
+        /**
+         * When non-zero, the Metal backend allocates sampleable textures from a shared
+         * MTLHeap of this size (in bytes) instead of giving each texture a dedicated
+         * allocation. This reduces allocation overhead and lets the memory of destroyed
+         * textures be recycled by new ones, which helps apps that stream many material
+         * textures. Textures used as attachments always get dedicated allocations, and
+         * textures that don't fit in the heap fall back to dedicated allocations.
+         *
+         * The heap remains alive throughout the lifetime of the Engine and adds to the
+         * memory footprint of the app, so it should be sized to the texture working set.
+         *
+         * A value of 0 (the default) disables the texture heap.
+         *
+         * Only respected by the Metal backend.
+         */
+        size_t metalTextureHeapSizeBytes = 0;
+
         /**
          * The action to take if a Drawable cannot be acquired.
          *
@@ -334,6 +352,14 @@ public:
          */
         bool disableParallelShaderCompile = false;
 
+        /**
+         * Maximum amount of time, in microseconds, the backend may spend per frame finalizing
+         * asynchronous shader compilations. This smooths out frames where many programs become
+         * ready at once (e.g. during level streaming) at the cost of programs becoming usable
+         * slightly later. 0 means no budget. Currently only honored by the GL backend.
+         */
+        uint32_t shaderCompilerTickBudgetUs = 0;
+
         /*
          * The type of technique for stereoscopic rendering.
          *
@@ -369,6 +395,28 @@ public:
          */
         uint32_t resourceAllocatorCacheMaxAge = 1;
 
+        /*
+         * A bitmask of UserVariantFilterBit values naming material variants the application
+         * declares it will never use (e.g. VSM or FOG). These variants are pruned from every
+         * Material at load time, as if each material had been compiled with the corresponding
+         * matc --variant-filter: they are excluded from Material::compile() and
+         * precompilation, reducing shader compilations, pipeline-cache memory and the number
+         * of cached programs. As with the matc-side filter, the application must not enable
+         * the corresponding renderer features (per-variant shader sizes can be inspected
+         * with matinfo to see what each feature costs).
+         */
+        UserVariantFilterMask variantFilter = 0;
+
+        /*
+         * Size in texels per side of the DFG lookup table used for image-based lighting.
+         *
+         * The default (0) uses the full embedded resolution (128). Setting 64 selects a
+         * quarter-memory variant computed from the embedded data at Engine creation, which
+         * saves texture bandwidth on low-end devices at a small quality cost. Other values
+         * fall back to the full resolution.
+         */
+        uint16_t dfgLutSize = 0;
+
         /*
          * Disable backend handles use-after-free checks.
          * @deprecated use "backend.disable_handle_use_after_free_check" feature flag instead
@@ -804,6 +852,67 @@ public:
      */
     bool isAutomaticInstancingEnabled() const noexcept;
 
+    /**
+     * Callback invoked on the main thread, at most once per frame, when the estimated GPU
+     * memory usage rises above the budget set with setMemoryBudget(). It re-arms once usage
+     * has dropped measurably below the budget again.
+     *
+     * @param user          user pointer given to setMemoryPressureCallback()
+     * @param usedBytes     estimated GPU memory usage when the budget was crossed
+     * @param budgetBytes   the budget set with setMemoryBudget()
+     */
+    using MemoryPressureCallback = void(*)(void* user, uint64_t usedBytes, uint64_t budgetBytes);
+
+    /**
+     * Sets a GPU memory budget in bytes. When the engine's estimated GPU memory usage --
+     * textures, buffers and frame graph transients, published through the
+     * "d.memory.*_bytes" counters of DebugRegistry -- rises above this budget, the
+     * callback set with setMemoryPressureCallback() is invoked, giving a streaming system
+     * the opportunity to evict resources. The usage is an engine-side estimate computed
+     * from resource dimensions and formats; actual driver usage can be higher.
+     *
+     * @param budgetBytes the budget in bytes, 0 (the default) disables the callback
+     */
+    void setMemoryBudget(uint64_t budgetBytes) noexcept;
+
+    /**
+     * Sets the callback invoked when the estimated GPU memory usage crosses the budget.
+     *
+     * @param callback the callback, or nullptr to remove it
+     * @param user arbitrary pointer passed back to the callback
+     * @see setMemoryBudget
+     */
+    void setMemoryPressureCallback(MemoryPressureCallback callback, void* user) noexcept;
+
+    /**
+     * @return the engine's estimated GPU memory usage in bytes
+     * @see setMemoryBudget
+     */
+    uint64_t getEstimatedGpuMemoryUsage() const noexcept;
+
+    /**
+     * Enables or disables merging of contiguous draw calls. When enabled, adjacent draw
+     * commands that use the same render primitive, MaterialInstance and per-renderable data,
+     * and whose index ranges are laid out back-to-back in the index buffer, are folded into a
+     * single draw call. This greatly reduces the draw count for renderables whose geometry is
+     * packed into shared vertex/index buffers -- a common layout for scenes made of masses of
+     * tiny meshes. Scenes that don't use packed geometry pay a small per-frame scanning cost,
+     * which is why merging is opt-in.
+     *
+     * Disabled by default.
+     *
+     * @param enable true to enable, false to disable draw merging.
+     *
+     * @see RenderableManager::Builder::geometry
+     */
+    void setDrawMergingEnabled(bool enable) noexcept;
+
+    /**
+     * @return true if draw merging is enabled, false otherwise.
+     * @see setDrawMergingEnabled
+     */
+    bool isDrawMergingEnabled() const noexcept;
+
     /**
      * Creates a SwapChain from the given Operating System's native window handle.
      *
@@ -1025,6 +1134,16 @@ public:
       */
     void flush();
 
+    /**
+     * Releases as much memory held in internal scratch pools and caches as possible. This
+     * doesn't affect resources created by the application, and the released pools grow back
+     * transparently when rendering resumes.
+     *
+     * <p>This is typically called when the application is backgrounded, for instance in
+     * response to Android's <code>android.content.ComponentCallbacks2.onTrimMemory</code>.</p>
+     */
+    void trimMemory() noexcept;
+
     /**
      * Get paused state of rendering thread.
      *
@@ -1164,6 +1283,83 @@ public:
      */
     static uint64_t getSteadyClockTimeNano() noexcept;
 
+    /**
+     * Starts an in-process profiling session capturing the engine's tracing zones (the
+     * FILAMENT_TRACING_* sites, including JobSystem job spans and command buffer usage)
+     * into the given caller-owned ring buffer, without requiring a platform trace daemon.
+     *
+     * The buffer is filled with fixed-size 64-byte records whose binary layout is
+     * documented in private/utils/TraceRecorder.h; when the buffer is full, the oldest
+     * records are overwritten. The buffer must remain valid until stopProfiling() returns.
+     *
+     * On platforms where tracing is routed to the system tooling (e.g. Perfetto on
+     * Android), or when the engine is built without tracing, no events are captured.
+     *
+     * @param buffer        caller-owned storage for the captured records
+     * @param sizeInBytes   size of buffer in bytes, at least 64
+     */
+    void startProfiling(void* UTILS_NONNULL buffer, size_t sizeInBytes) noexcept;
+
+    /**
+     * Stops the profiling session started with startProfiling().
+     *
+     * @return the total number of records captured. If this exceeds the buffer's capacity
+     *         in records, the buffer wrapped and holds the most recent records, the oldest
+     *         of which lives at index (count % capacity). Returns 0 if no session was
+     *         active.
+     */
+    size_t stopProfiling() noexcept;
+
+    /**
+     * Enables or disables recording of the shader prewarm trace.
+     *
+     * While recording is enabled, the engine logs each (material, shader variant) pair
+     * whose program is actually built, keyed by the material package's stable cache id so
+     * the trace remains valid across sessions as long as the material data is unchanged.
+     * Enabling recording discards any previously recorded trace.
+     *
+     * Record a representative session once (e.g. during the first run), persist the trace
+     * with getPrewarmTrace(), and replay it with prewarm() at the start of later sessions —
+     * or after an app update, from a background service — to move shader compilation out
+     * of the first frames of use.
+     *
+     * @param enabled true to start recording, false to stop
+     */
+    void setPrewarmTraceRecording(bool enabled) noexcept;
+
+    /**
+     * Serializes the prewarm trace recorded so far into a caller-owned buffer.
+     *
+     * The trace is a compact binary blob meant to be written to a file as-is and fed back
+     * to prewarm(); its layout is otherwise opaque. Call with a null buffer (or one that
+     * is too small) to query the required size; nothing is written in that case.
+     *
+     * @param buffer        destination storage, or nullptr to query the size
+     * @param sizeInBytes   size of buffer in bytes
+     * @return the number of bytes required to hold the trace
+     */
+    size_t getPrewarmTrace(void* UTILS_NULLABLE buffer, size_t sizeInBytes) const noexcept;
+
+    /**
+     * Loads a prewarm trace recorded in a previous session and queues background
+     * compilation of the programs it references.
+     *
+     * Materials already loaded are processed immediately; materials created later pick up
+     * their recorded variants when they are built. Compilation happens at low priority on
+     * the driver's shader compiler service and is promoted automatically if rendering
+     * needs a program before it's ready, so calling this is always safe — at worst it's
+     * a no-op. Traces referencing materials that no longer exist, or variants a material
+     * no longer supports, are ignored.
+     *
+     * Pipeline state objects additionally depend on render target and vertex buffer
+     * formats only known to the application; use Material::precompilePipelines() for
+     * those.
+     *
+     * @param data          trace previously obtained from getPrewarmTrace()
+     * @param sizeInBytes   size of data in bytes
+     * @return the number of materials referenced by the trace, or 0 if it is not valid
+     */
+    size_t prewarm(void const* UTILS_NONNULL data, size_t sizeInBytes) noexcept;
 
     DebugRegistry& getDebugRegistry() noexcept;
 
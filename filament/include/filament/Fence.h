@@ -29,6 +29,8 @@
 
 namespace filament {
 
+class Engine;
+
 /**
  * Fence is used to synchronize the application main thread with filament's rendering thread.
  */
@@ -78,6 +80,38 @@ public:
      */
     static FenceStatus waitAndDestroy(Fence* UTILS_NONNULL fence, Mode mode = Mode::FLUSH);
 
+    /**
+     * Returns this Fence's position on the Engine's timeline.
+     *
+     * Fences are assigned monotonically increasing timeline values in creation order, and the
+     * rendering thread signals them in that same order. The value can be used with
+     * waitForTimelineValue() to wait on many fences at once.
+     *
+     * @return This fence's timeline value.
+     */
+    uint64_t getTimelineValue() const noexcept;
+
+    /**
+     * Client-side wait for all Fences with a timeline value less than or equal to \p value.
+     *
+     * This is equivalent to -- but cheaper than -- calling wait() on every Fence created up to
+     * the one that returned \p value from getTimelineValue(), which makes it well suited to
+     * waiting on a batch of streaming uploads with a single call.
+     *
+     * @param engine    Reference to the filament::Engine the fences were created from.
+     * @param value     Timeline value to wait for, as returned by getTimelineValue().
+     * @param mode      Whether the command stream is flushed before waiting or not.
+     * @param timeout   Wait time out. Using a \p timeout of 0 is a way to query the state of
+     *                  the timeline. A \p timeout value of FENCE_WAIT_FOR_EVER is used to
+     *                  disable the timeout.
+     * @return          FenceStatus::CONDITION_SATISFIED on success,
+     *                  FenceStatus::TIMEOUT_EXPIRED if the time out expired or
+     *                  FenceStatus::ERROR in other cases.
+     * @see #getTimelineValue, #Mode
+     */
+    static FenceStatus waitForTimelineValue(Engine& engine, uint64_t value,
+            Mode mode = Mode::FLUSH, uint64_t timeout = FENCE_WAIT_FOR_EVER);
+
 protected:
     // prevent heap allocation
     ~Fence() = default;
@@ -43,8 +43,10 @@ namespace utils {
 
 namespace filament {
 
+class RenderTarget;
 class Texture;
 class TextureSampler;
+class VertexBuffer;
 
 class FEngine;
 class FMaterial;
@@ -241,6 +243,51 @@ public:
                 std::forward<utils::Invocable<void(Material* UTILS_NONNULL)>>(callback));
     }
 
+    /**
+     * Hints the backend to create the pipeline state objects (e.g. VkPipeline) used to draw
+     * this material ahead of time. Material::compile() only primes shader compilation; on
+     * backends with monolithic pipeline objects the pipeline itself is otherwise still created
+     * at the first draw, which can hitch. Calling this during a loading screen absorbs that
+     * cost up front.
+     *
+     * Each call covers one combination of vertex format and render target layout: all variants
+     * of this material (subject to the variants filter, see compile()) are precompiled against
+     * the attachment layout of the given render target and the vertex format of the given
+     * vertex buffer. Call it once per combination the material will be drawn with. Nothing is
+     * drawn into the render target.
+     *
+     * This is a best-effort hint: backends without ahead-of-time pipeline creation ignore it,
+     * and draws using a state not covered here simply create their pipeline on first use as
+     * before. As with compile(), it is recommended to call Engine::flush() after a batch of
+     * calls so the backend can start the work as soon as possible.
+     *
+     * @param renderTarget  a render target whose attachment layout matches the passes this
+     *                      material will be drawn in
+     * @param vertexBuffer  a vertex buffer declaring the vertex format this material will be
+     *                      drawn with
+     * @param variants      variants to precompile, see compile()
+     */
+    void precompilePipelines(RenderTarget* UTILS_NONNULL renderTarget,
+            VertexBuffer* UTILS_NONNULL vertexBuffer,
+            UserVariantFilterMask variants =
+                    UserVariantFilterMask(UserVariantFilterBit::ALL)) noexcept;
+
+    /**
+     * Changes the shadow sampling quality of this material at runtime.
+     *
+     * This is the runtime counterpart of Builder::shadowSamplingQuality(). The quality is a
+     * specialization constant, so the change doesn't rebuild the material; it only
+     * re-specializes the shadow-receiving variants. Their cached programs are invalidated and
+     * re-created from the already loaded shader code the next time they are used -- on backends
+     * with a pipeline cache this amounts to a cache lookup when the quality has been used
+     * before. The new programs can be primed ahead of use with compile().
+     *
+     * This is only taken into account if this material is lit and in the surface domain.
+     *
+     * @param quality the new shadow sampling quality
+     */
+    void setShadowSamplingQuality(Builder::ShadowSamplingQuality quality) noexcept;
+
     /**
      * Creates a new instance of this material. Material instances should be freed using
      * Engine::destroy(const MaterialInstance*).
@@ -347,6 +394,9 @@ public:
     //! Indicates whether a parameter of the given name exists on this material.
     bool hasParameter(const char* UTILS_NONNULL name) const noexcept;
 
+    //! Indicates whether a constant parameter of the given name exists on this material.
+    bool hasConstant(const char* UTILS_NONNULL name) const noexcept;
+
     //! Indicates whether an existing parameter is a sampler or not.
     bool isSampler(const char* UTILS_NONNULL name) const noexcept;
 
@@ -40,6 +40,14 @@ class UTILS_PUBLIC MorphTargetBuffer : public FilamentAPI {
     struct BuilderDetails;
 
 public:
+    /**
+     * Storage precision of the morph target positions.
+     */
+    enum class PositionPrecision : uint8_t {
+        FULL,   //!< 32-bit floating point storage (the default)
+        HALF,   //!< 16-bit floating point storage, halves memory and fetch bandwidth
+    };
+
     class Builder : public BuilderBase<BuilderDetails>, public BuilderNameMixin<Builder> {
         friend struct BuilderDetails;
     public:
@@ -64,6 +72,20 @@ public:
          */
         Builder& count(size_t count) noexcept;
 
+        /**
+         * Storage precision of the positions (PositionPrecision::FULL by default).
+         *
+         * Morph target positions are usually small offsets from the base mesh, where
+         * half precision is ample; it halves the memory footprint of the positions as
+         * well as the per-frame fetch bandwidth in the vertex stage. The data is still
+         * supplied to setPositionsAt() as 32-bit floats and quantized on upload; shaders
+         * are unaffected.
+         *
+         * @param precision Storage precision of the positions.
+         * @return A reference to this Builder for chaining calls.
+         */
+        Builder& positionPrecision(PositionPrecision precision) noexcept;
+
         /**
          * Associate an optional name with this MorphTargetBuffer for debugging purposes.
          *
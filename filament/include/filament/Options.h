@@ -96,6 +96,61 @@ struct DynamicResolutionOptions {
     QualityLevel quality = QualityLevel::LOW;
 };
 
+/**
+ * Closed-loop quality governor for a View.
+ *
+ * When enabled, the View monitors the measured frame time (the same denoised signal that
+ * drives dynamic resolution) against the target frame rate (see Renderer::FrameRateOptions)
+ * and trades visual quality for performance when the frame is consistently over budget,
+ * restoring quality when headroom comes back.
+ *
+ * Three quality axes can be sacrificed. Axes are degraded in the order given by the priority
+ * array, and an axis is fully degraded before the next one is touched; restoration happens in
+ * the reverse order. Each axis has two degradation steps:
+ *
+ * POST_PROCESSING: caps the QualityLevel of post-processing effects (SSAO, bloom, dynamic
+ *                  resolution upscaling) to MEDIUM, then LOW.
+ *
+ * SHADOWS:         renders shadow maps at half, then a quarter, of their requested
+ *                  resolution (ShadowOptions::mapSize).
+ *
+ * RESOLUTION:      caps DynamicResolutionOptions::maxScale to 75%, then 50%, of its value
+ *                  (in covered area), forcing additional savings when the dynamic resolution
+ *                  controller is already saturated.
+ *
+ * Degradation reacts quickly (degradeFrameCount) while restoration is deliberately slow
+ * (restoreFrameCount, restoreHeadroom), providing the hysteresis needed to avoid oscillating
+ * between quality tiers.
+ *
+ * An axis listed several times is only considered once; listing the same axis in all three
+ * priority entries therefore restricts the governor to that single axis.
+ *
+ * \note
+ * Like dynamic resolution, the governor is only active on platforms where the time to render
+ * a frame can be measured accurately (i.e. with timer queries).
+ *
+ * @see View::setAdaptiveQualityOptions()
+ * @see Renderer::FrameRateOptions
+ */
+struct AdaptiveQualityOptions {
+    //! a quality axis the governor is allowed to degrade
+    enum class Axis : uint8_t {
+        POST_PROCESSING,    //!< quality tier of post-processing effects
+        SHADOWS,            //!< shadow map resolution
+        RESOLUTION,         //!< upper bound of the dynamic resolution scale
+    };
+    //! enables the quality governor
+    bool enabled = false;
+    //! consecutive over-budget frames before degrading one step, at least 1
+    uint8_t degradeFrameCount = 8;
+    //! consecutive under-budget frames before restoring one step, at least 1
+    uint16_t restoreFrameCount = 240;
+    //! fraction of the frame budget that must be free before a step is restored [0, 0.5]
+    float restoreHeadroom = 0.15f;
+    //! axes in the order they are sacrificed; the first entry is degraded first and restored last
+    Axis priority[3] = { Axis::POST_PROCESSING, Axis::SHADOWS, Axis::RESOLUTION };
+};
+
 /**
  * Options to control the bloom effect
  *
@@ -350,6 +405,25 @@ struct VignetteOptions {
     bool enabled = false;                       //!< enables or disables the vignette effect
 };
 
+/**
+ * Options to control automatic exposure metering.
+ *
+ * When enabled, the average scene luminance is metered on the GPU every frame and the camera's
+ * exposure is gradually adapted to it, replacing the exposure value set on the Camera. The
+ * metering result is read back asynchronously (a single pixel), so the adaptation lags the
+ * rendered image by a few frames.
+ *
+ * @see setAutoExposureOptions()
+ */
+struct AutoExposureOptions {
+    float speedUp = 3.0f;       //!< adaptation speed when the scene gets brighter, in 1/seconds
+    float speedDown = 1.0f;     //!< adaptation speed when the scene gets darker, in 1/seconds
+    float compensation = 0.0f;  //!< exposure compensation in EV, positive values brighten the image
+    float minEv100 = -6.0f;     //!< lower bound on the adapted exposure value (EV100)
+    float maxEv100 = 18.0f;     //!< upper bound on the adapted exposure value (EV100)
+    bool enabled = false;       //!< enables or disables automatic exposure
+};
+
 /**
  * Structure used to set the precision of the color buffer and related quality settings.
  *
@@ -467,6 +541,14 @@ struct TemporalAntiAliasingOptions {
     bool enabled = false;       //!< enables or disables temporal anti-aliasing
     bool upscaling = false;     //!< 4x TAA upscaling. Disables Dynamic Resolution. [BETA]
 
+    /**
+     * Per-axis ratio between display and render resolution when `upscaling` is enabled.
+     * Clamped to [1.0, 2.0]. The default of 2.0 renders at a quarter of the display area;
+     * smaller values (e.g. 1.3, about 0.6x area) trade a smaller resolution drop for less
+     * temporal reconstruction work. Ignored when `upscaling` is false. [BETA]
+     */
+    float upscalingFactor = 2.0f;
+
     enum class BoxType : uint8_t {
         AABB,           //!< use an AABB neighborhood
         VARIANCE,       //!< use the variance of the neighborhood (not recommended)
@@ -509,6 +591,14 @@ struct ScreenSpaceReflectionsOptions {
     float maxDistance = 3.0f;   //!< maximum distance, in world units, to raycast
     float stride = 2.0f;        //!< stride, in texels, for samples along the ray.
     bool enabled = false;
+    /**
+     * When enabled, rays are traced for only a quarter of the pixels each frame, in an
+     * ordered 2x2 pattern; the remaining pixels reuse the reprojected result from previous
+     * frames, and disoccluded pixels fall back to image-based lighting until they are
+     * traced again. This reduces the ray-marching cost to roughly a quarter at a small
+     * temporal stability cost.
+     */
+    bool quarterRateTracing = false;
 };
 
 /**
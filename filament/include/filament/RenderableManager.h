@@ -118,6 +118,14 @@ public:
      */
     bool empty() const noexcept;
 
+    /**
+     * Reserves storage for at least \p n components. Calling this before building a large
+     * batch of renderables avoids incremental reallocation of the internal arrays.
+     * Invalidates any pointer previously returned by this manager.
+     * @param n total number of components to reserve storage for
+     */
+    void reserve(size_t n) noexcept;
+
     /**
      * Retrieve the `Entity` of the component from its `Instance`.
      * @param i Instance of the component obtained from getInstance()
@@ -214,6 +222,38 @@ public:
                 IndexBuffer* UTILS_NONNULL indices) noexcept; //!< \overload
 
 
+        /**
+         * Partitions the primitives into several levels of detail (lod).
+         *
+         * The count passed to the Builder constructor must be a multiple of \p lodCount; the
+         * first count / lodCount primitives form level 0 (the most detailed one), the next
+         * group forms level 1, and so on. At most 4 levels are supported. By default a
+         * renderable has a single level.
+         *
+         * The level used for rendering is chosen automatically each frame from the projected
+         * screen coverage of the renderable's bounding box, see lodThreshold(). All levels
+         * share the renderable's bounding box, transform and per-primitive state such as
+         * materials and blend orders.
+         *
+         * @param lodCount number of levels of detail, in [1, 4]
+         * @see lodThreshold()
+         */
+        Builder& lodCount(uint8_t lodCount) noexcept;
+
+        /**
+         * Sets the screen coverage below which a level of detail is replaced by the next
+         * (coarser) one.
+         *
+         * The coverage is the ratio of the projected diameter of the renderable's bounding
+         * sphere to the viewport height, clamped to [0, 1]. Thresholds should decrease with
+         * the level; a level without a threshold is never replaced (the default).
+         *
+         * @param level level of detail the threshold applies to, in [0, lodCount - 2]
+         * @param coverage screen coverage below which \p level + 1 is used instead of \p level
+         * @see lodCount()
+         */
+        Builder& lodThreshold(uint8_t level, float coverage) noexcept;
+
         /**
          * Specify the type of geometry for this renderable. DYNAMIC geometry has no restriction,
          * STATIC_BOUNDS geometry means that both the bounds and the world-space transform of the
@@ -342,6 +382,16 @@ public:
          */
         Builder& castShadows(bool enable) noexcept;
 
+        /**
+         * Hints that this renderable's shadow-casting geometry never moves, false by default.
+         *
+         * Shadow maps whose frustum only contains static casters can be cached and refreshed
+         * less often (see the d.shadowmap.update_interval debug property). This is only a
+         * hint: moving a renderable flagged as static can leave stale shadows behind until
+         * the affected shadow maps are refreshed.
+         */
+        Builder& castShadowsStatic(bool enable) noexcept;
+
         /**
          * Controls if this renderable receives shadows, true by default.
          */
@@ -679,6 +729,13 @@ public:
      */
     void setCastShadows(Instance instance, bool enable) noexcept;
 
+    /**
+     * Changes whether the renderable's shadow-casting geometry is considered static.
+     *
+     * \see Builder::castShadowsStatic()
+     */
+    void setCastShadowsStatic(Instance instance, bool enable) noexcept;
+
     /**
      * Changes whether or not the renderable can receive shadows.
      *
@@ -85,6 +85,21 @@ public:
 
     /**
      * Timing information about a frame
+     *
+     * A frame's latency can be attributed from these timestamps:
+     * - command queue wait: backendBeginFrame - beginFrame, i.e. how long the frame's commands
+     *   sat in the command queue before the backend thread started executing them,
+     * - backend execution: backendEndFrame - backendBeginFrame,
+     * - GPU execution: frameTime,
+     * - GPU completion: gpuFrameComplete - backendEndFrame, i.e. how long after the frame was
+     *   submitted the GPU was done with it (and, where fences are implemented with native
+     *   fences, when composition could start).
+     *
+     * The main thread time (endFrame - beginFrame) is additionally attributed to its largest
+     * contributors -- view preparation, command generation and frame graph compilation and
+     * execution -- so CPU-prepare-bound frames can be told apart from GPU-bound ones (the
+     * former calls for reducing scene complexity, the latter for reducing resolution).
+     *
      * @see getFrameInfoHistory()
      */
     struct FrameInfo {
@@ -97,6 +112,10 @@ public:
         time_point_ns endFrame;             //!< Renderer::endFrame() time since epoch [ns]
         time_point_ns backendBeginFrame;    //!< Backend thread time of frame start since epoch [ns]
         time_point_ns backendEndFrame;      //!< Backend thread time of frame end since epoch [ns]
+        time_point_ns gpuFrameComplete;     //!< time the GPU finished this frame, or 0 if unknown [ns]
+        duration_ns viewPrepareTime;        //!< main thread time spent preparing views [ns]
+        duration_ns commandGenerationTime;  //!< CPU time spent generating and sorting the color pass commands [ns]
+        duration_ns frameGraphTime;         //!< main thread time spent compiling and executing the frame graph [ns]
     };
 
     /**
@@ -114,6 +133,23 @@ public:
      */
     size_t getMaxFrameHistorySize() const noexcept;
 
+    /**
+     * Returns the recommended offset, in nanoseconds, to apply to the next beginFrame() call
+     * relative to vsync, so that the frame completes -- and its buffer latches -- within the
+     * vsync window.
+     *
+     * The offset is predicted from the denoised GPU frame time history (see
+     * getFrameInfoHistory()), honoring FrameRateOptions::headRoomRatio. A positive value
+     * means the next frame can be started that much later than vsync, reducing input latency;
+     * a negative value means it should be started that much earlier because the GPU is close
+     * to missing the deadline. Returns 0 when frame pacing is disabled (i.e.
+     * DisplayInfo::refreshRate is 0) or when no timing data is available yet.
+     *
+     * @return start time offset of the next frame relative to vsync in nanoseconds
+     * @see beginFrame(), setDisplayInfo(), setFrameRateOptions()
+     */
+    int64_t getFrameStartOffsetNanos() const noexcept;
+
     /**
      * Use FrameRateOptions to set the desired frame rate and control how quickly the system
      * reacts to GPU load changes.
@@ -389,6 +425,65 @@ public:
      */
     void render(View const* UTILS_NONNULL view);
 
+    /**
+     * Render a group of Views sharing the same Scene into this renderer's window.
+     *
+     * This is equivalent to calling render() on each View in order, except that the
+     * per-frame Scene preparation (gathering of renderables, world-space bounds, etc.)
+     * is performed only once, by the first View of the group, and reused by the others.
+     * Culling, lighting and command generation remain per-View. This is useful for
+     * multi-viewport setups where many Views observe the same Scene from different
+     * cameras, e.g. a grid of security cameras.
+     *
+     * All Views of the group must use the same Scene, otherwise the call aborts.
+     * Because the Scene preparation is shared, the shadow-caster promotion done for
+     * VSM (see ShadowOptions) follows the first View's shadow type; for best results
+     * all Views of a group should use the same shadow type.
+     *
+     * @param views     Pointer to an array of Views to render, all sharing the same Scene.
+     * @param viewCount Number of Views in the array.
+     *
+     * @attention
+     * renderViewGroup() must be called *after* beginFrame() and *before* endFrame().
+     *
+     * @see
+     * render(), beginFrame(), endFrame(), View
+     */
+    void renderViewGroup(View const* UTILS_NONNULL const* UTILS_NONNULL views, size_t viewCount);
+
+    /**
+     * Render several (SwapChain, View) pairs within the current frame.
+     *
+     * This is intended for multi-window applications: instead of running a full
+     * beginFrame() / endFrame() cycle per window -- paying the fixed per-frame cost
+     * (frame pacing, backend begin/end, engine GC, command-buffer flush) once per
+     * window -- all windows are rendered within a single frame. Each entry makes its
+     * SwapChain current and renders the corresponding View into it; the presents are
+     * deferred and issued back-to-back in endFrame(), so the whole group rides a
+     * single command-buffer flush.
+     *
+     * The SwapChain passed to beginFrame() is part of the group and is typically the
+     * first entry of the array. Consecutive entries may share a SwapChain (to render
+     * several Views into one window), but a SwapChain must not reappear after another
+     * one has been rendered to.
+     *
+     * All SwapChains of the group must remain valid until endFrame() is called.
+     * The damage region (see View::declareDamageRegion()) is ignored when more than
+     * one SwapChain is rendered to, as it can only describe a single surface.
+     *
+     * @param swapChains Pointer to an array of SwapChains, one per entry.
+     * @param views      Pointer to an array of Views, one per entry.
+     * @param count      Number of (SwapChain, View) pairs in the arrays.
+     *
+     * @attention
+     * renderSwapChainGroup() must be called *after* beginFrame() and *before* endFrame().
+     *
+     * @see
+     * render(), renderViewGroup(), beginFrame(), endFrame(), SwapChain
+     */
+    void renderSwapChainGroup(SwapChain* UTILS_NONNULL const* UTILS_NONNULL swapChains,
+            View const* UTILS_NONNULL const* UTILS_NONNULL views, size_t count);
+
     /**
      * Copy the currently rendered view to the indicated swap chain, using the
      * indicated source and destination rectangle.
@@ -243,6 +243,19 @@ public:
      */
     int64_t getTimestamp() const noexcept;
 
+    /**
+     * Returns frame statistics for an ACQUIRED stream.
+     *
+     * The stream behaves as a mailbox: when several images are pushed between two frames, only
+     * the newest is latched and the others are released immediately (their callbacks still run)
+     * and counted as skipped. The latch latency measures the time between setAcquiredImage()
+     * and the image being bound for rendering, which is useful to monitor end-to-end camera or
+     * video latency.
+     *
+     * @return statistics accumulated since the stream was created.
+     */
+    backend::StreamStats getStats() const noexcept;
+
 protected:
     // prevent heap allocation
     ~Stream() = default;
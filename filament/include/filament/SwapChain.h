@@ -233,6 +233,22 @@ public:
      */
     static constexpr uint64_t CONFIG_PROTECTED_CONTENT = backend::SWAP_CHAIN_CONFIG_PROTECTED_CONTENT;
 
+    /**
+     * Requests the lowest achievable present latency from the backend, trading throughput (and
+     * possibly tearing, where the platform allows it) for it.
+     *
+     * This is a best-effort hint. It maps to a MAILBOX present mode with the minimum image count
+     * on Vulkan, a reduced drawable count on Metal and a swap interval of zero on EGL; it is
+     * ignored where the platform offers no such control.
+     *
+     * The latency actually achieved can be measured with Renderer::getFrameInfoHistory(), as
+     * FrameInfo::gpuFrameComplete - FrameInfo::beginFrame.
+     *
+     * @see setFrameQueueDepth()
+     * @see Renderer.getFrameInfoHistory()
+     */
+    static constexpr uint64_t CONFIG_LOW_LATENCY = backend::SWAP_CHAIN_CONFIG_LOW_LATENCY;
+
     /**
      * Return whether createSwapChain supports the CONFIG_PROTECTED_CONTENT flag.
      * The default implementation returns false.
@@ -253,6 +269,24 @@ public:
 
     void* UTILS_NULLABLE getNativeWindow() const noexcept;
 
+    /**
+     * Sets the number of frames the presentation engine is allowed to queue ahead, on backends
+     * that expose such a control.
+     *
+     * This is a best-effort hint. A depth of 1 requests the lowest achievable latency -- it is
+     * equivalent to creating the SwapChain with the CONFIG_LOW_LATENCY flag -- and is intended
+     * for interactive content such as inking, where a stale frame is worse than a skipped one.
+     * Larger depths restore the default queueing behavior, which favors throughput.
+     *
+     * Changing the depth may recreate the underlying native swap chain; avoid calling this
+     * every frame.
+     *
+     * @param depth Number of frames the presentation engine may queue, clamped to [1, 3].
+     *
+     * @see CONFIG_LOW_LATENCY
+     */
+    void setFrameQueueDepth(uint8_t depth) noexcept;
+
     /**
      * If this flag is passed to setFrameScheduledCallback, then the behavior of the default
      * CallbackHandler (when nullptr is passed as the handler argument) is altered to call the
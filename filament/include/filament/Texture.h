@@ -458,6 +458,24 @@ public:
      */
     void setExternalImage(Engine& engine, ExternalImageHandleRef image) noexcept;
 
+    /**
+     * Returns the external image previously associated with this Texture via
+     * setExternalImage(Engine&, ExternalImageHandleRef), or an empty handle if none was set.
+     *
+     * Because the handle reference-counts a platform image rather than a driver object, it can
+     * be passed to setExternalImage() on a Texture owned by a *different* Engine, sharing the
+     * underlying memory zero-copy between the two. This is the supported way to use one
+     * resource from several engines: allocate it as a platform image (e.g. an AHardwareBuffer
+     * or CVPixelBuffer), import it into each engine, and let the last release destroy it.
+     * Backends that create the platform image from a driver object (e.g.
+     * PlatformEGL::createExternalImage(EGLImageKHR)) additionally require the engines to share
+     * a context, see Engine::Builder::sharedContext.
+     *
+     * @return the handle set by setExternalImage(), an empty handle otherwise. The deprecated
+     *         void* overloads do not register a handle.
+     */
+    ExternalImageHandle getExternalImage() const noexcept;
+
     /**
      * Specify the external image to associate with this Texture. Typically, the external
      * image is OS specific, and can be a video or camera frame.
@@ -547,6 +565,51 @@ public:
      */
     void generateMipmaps(Engine& engine) const noexcept;
 
+    /**
+     * Schedules mipmap generation to be spread over upcoming frames.
+     *
+     * This is equivalent to generateMipmaps(), except that the GPU work is queued on the
+     * Engine and executed a budgeted amount per frame at the start of Renderer::beginFrame(),
+     * instead of contending with rendering at call time. This is useful when a scene swap
+     * generates mipmaps for dozens of textures at once. Until a texture's turn comes,
+     * samplers stay clamped to the levels populated with setImage(), so it renders correctly
+     * at reduced detail in the meantime.
+     *
+     * Queued generation is canceled if the texture is destroyed first.
+     *
+     * @param engine        Engine this texture is associated to.
+     *
+     * @attention \p engine must be the instance passed to Builder::build()
+     * @attention This Texture instance must NOT use SamplerType::SAMPLER_3D or it has no effect
+     * @see generateMipmaps
+     */
+    void generateMipmapsAsync(Engine& engine) const noexcept;
+
+    /**
+     * Declares which mip levels currently hold valid data, restricting sampling to that range.
+     *
+     * Filament tracks the levels populated by setImage() and automatically clamps samplers to
+     * them; this method additionally allows the range to be shrunk, marking levels as
+     * non-resident again. This is intended for streaming: keep only the tail of a mip chain
+     * resident (e.g. for prefiltered environment cubemaps rotated under a memory budget),
+     * evict the detailed levels with this method when an environment becomes inactive, and
+     * stream them back in with setImage() -- which re-extends the range -- when it is needed
+     * again. Samplers never read levels outside the range, so a partially streamed texture
+     * always renders correctly, just with less detail.
+     *
+     * Note that this doesn't release the texture's storage; it only controls which levels
+     * samplers can see while their content is invalid or in flight.
+     *
+     * @param engine        Engine this texture is associated to.
+     * @param baseLevel     First resident mip level.
+     * @param levelCount    Number of resident mip levels, at least 1.
+     *
+     * @attention \p engine must be the instance passed to Builder::build()
+     * @attention This Texture instance must be SAMPLEABLE with more than one mip level,
+     *            and must not be an external texture.
+     */
+    void setLodRange(Engine& engine, uint8_t baseLevel, uint8_t levelCount);
+
     /** @deprecated */
     struct FaceOffsets {
         using size_type = size_t;
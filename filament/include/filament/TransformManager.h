@@ -129,6 +129,14 @@ public:
      */
     bool empty() const noexcept;
 
+    /**
+     * Reserves storage for at least \p n components. Calling this before creating a large
+     * batch of transforms avoids incremental reallocation of the internal arrays.
+     * Invalidates any pointer previously returned by this manager.
+     * @param n total number of components to reserve storage for
+     */
+    void reserve(size_t n) noexcept;
+
     /**
      * Retrieve the `Entity` of the component from its `Instance`.
      * @param i Instance of the component obtained from getInstance()
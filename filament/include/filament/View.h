@@ -77,10 +77,12 @@ public:
     using ShadowType = filament::ShadowType;
 
     using DynamicResolutionOptions = filament::DynamicResolutionOptions;
+    using AdaptiveQualityOptions = filament::AdaptiveQualityOptions;
     using BloomOptions = filament::BloomOptions;
     using FogOptions = filament::FogOptions;
     using DepthOfFieldOptions = filament::DepthOfFieldOptions;
     using VignetteOptions = filament::VignetteOptions;
+    using AutoExposureOptions = filament::AutoExposureOptions;
     using RenderQuality = filament::RenderQuality;
     using AmbientOcclusionOptions = filament::AmbientOcclusionOptions;
     using TemporalAntiAliasingOptions = filament::TemporalAntiAliasingOptions;
@@ -175,6 +177,26 @@ public:
      */
     Viewport const& getViewport() const noexcept;
 
+    /**
+     * Declares that only the given region of this View (in viewport coordinates) has changed
+     * since the previous frame. Several regions can be declared; they are merged into their
+     * bounding rectangle.
+     *
+     * When a damage region is declared, the next call to Renderer::render() restricts shading
+     * to that region and presents the SwapChain with the corresponding damage rectangle on
+     * platforms that support it (e.g. EGL_KHR_swap_buffers_with_damage). Pixels outside the
+     * region keep the render target's previous content, so this must only be used when that
+     * content is preserved (a custom RenderTarget, or a SwapChain whose buffer is preserved
+     * across frames). Damage is ignored when post-processing is enabled, as most post-process
+     * passes operate on the full frame.
+     *
+     * The declared damage only applies to the next call to Renderer::render() and is cleared
+     * by it; when no damage is declared, the full viewport is considered damaged.
+     *
+     * @param damage the region of the viewport that needs to be redrawn.
+     */
+    void declareDamageRegion(Viewport const& damage) noexcept;
+
     /**
      * Sets this View's Camera.
      *
@@ -293,6 +315,26 @@ public:
      */
     bool isScreenSpaceRefractionEnabled() const noexcept;
 
+    /**
+     * Enables or disables an explicit depth prepass for the color pass. Disabled by default.
+     *
+     * When enabled, opaque and alpha-masked geometry is first rendered depth-only, so that
+     * the early depth test reduces the color pass to the visible fragments. This trades
+     * extra vertex and command processing for less fragment shading, which is typically a
+     * win for scenes with high overdraw and expensive materials, but a loss for scenes that
+     * are vertex-bound or have little overdraw.
+     *
+     * @param enabled true enables the depth prepass, false disables it.
+     */
+    void setDepthPrepassEnabled(bool enabled) noexcept;
+
+    /**
+     * @return whether the depth prepass is enabled
+     *
+     * See setDepthPrepassEnabled() for more information.
+     */
+    bool isDepthPrepassEnabled() const noexcept;
+
     /**
      * Sets how many samples are to be used for MSAA in the post-process stage.
      * Default is 1 and disables MSAA.
@@ -491,6 +533,23 @@ public:
      */
     VignetteOptions getVignetteOptions() const noexcept;
 
+    /**
+     * Enables or disables automatic exposure metering. Disabled by default.
+     *
+     * When enabled, the exposure set on this view's camera is ignored and replaced with a value
+     * adapted to the average scene luminance.
+     *
+     * @param options options
+     */
+    void setAutoExposureOptions(AutoExposureOptions options) noexcept;
+
+    /**
+     * Queries the automatic exposure options.
+     *
+     * @return the current automatic exposure options for this view.
+     */
+    AutoExposureOptions getAutoExposureOptions() const noexcept;
+
     /**
      * Enables or disables dithering in the post-processing stage. Enabled by default.
      *
@@ -519,6 +578,23 @@ public:
      */
     DynamicResolutionOptions getDynamicResolutionOptions() const noexcept;
 
+    /**
+     * Sets the adaptive quality options for this view. The adaptive quality governor
+     * monitors the measured frame time and automatically trades visual quality
+     * (post-processing tiers, shadow map resolution, dynamic resolution bounds) for
+     * performance when the view is consistently over its frame budget.
+     *
+     * @param options The adaptive quality options to use on this view
+     * @see AdaptiveQualityOptions
+     */
+    void setAdaptiveQualityOptions(AdaptiveQualityOptions const& options) noexcept;
+
+    /**
+     * Returns the adaptive quality options associated with this view.
+     * @return value set by setAdaptiveQualityOptions().
+     */
+    AdaptiveQualityOptions getAdaptiveQualityOptions() const noexcept;
+
     /**
      * Sets the rendering quality for this view. Refer to RenderQuality for more
      * information about the different settings available.
@@ -743,6 +819,28 @@ public:
      */
     StereoscopicOptions const& getStereoscopicOptions() const noexcept;
 
+    /**
+     * Enables contribution culling: renderables whose bounding sphere projects to less
+     * than the given number of pixels on screen are culled, on top of regular frustum
+     * culling. This is useful for dense scenes with many small or distant objects that
+     * would otherwise go through the full rendering pipeline without contributing
+     * meaningfully to the image.
+     *
+     * The coverage is estimated from the renderable's bounding sphere, so it is
+     * conservative for thin objects. Only the main visibility is affected; shadow
+     * casting is unchanged.
+     *
+     * @param minPixelArea minimum projected bounding-sphere area, in pixels, below which
+     *                     a renderable is culled. 0 disables contribution culling
+     *                     (the default).
+     */
+    void setContributionCullingThreshold(float minPixelArea) noexcept;
+
+    /**
+     * Returns the contribution culling threshold set by setContributionCullingThreshold().
+     */
+    float getContributionCullingThreshold() const noexcept;
+
     // for debugging...
 
     //! debugging: allows to entirely disable frustum culling. (culling enabled by default).
@@ -39,6 +39,14 @@ static constexpr std::pair<uint8_t, uint8_t> unmorton(uint16_t const m) noexcept
     return { uint8_t(r), uint8_t(r >> 16u) };
 }
 
+static constexpr uint16_t morton(uint8_t const x, uint8_t const y) noexcept {
+    uint32_t m = uint32_t(x) | (uint32_t(y) << 16u);
+    m = (m | (m << 4u)) & 0x0f0f0f0fu;
+    m = (m | (m << 2u)) & 0x33333333u;
+    m = (m | (m << 1u)) & 0x55555555u;
+    return uint16_t(m | (m >> 15u));
+}
+
 AtlasAllocator::AtlasAllocator(size_t const maxTextureSize) noexcept {
     // round to power-of-two immediately inferior or equal to the size specified.
     mMaxTextureSizePot = (sizeof(maxTextureSize) * 8 - 1u) - clz(maxTextureSize);
@@ -62,20 +70,145 @@ AtlasAllocator::Allocation AtlasAllocator::allocate(size_t const textureSize) no
     const NodeId loc = allocateInLayer(LAYERS_DEPTH + layer);
     if (loc.l >= 0) {
         assert_invariant(loc.l - LAYERS_DEPTH == int8_t(layer));
-        const size_t dimension = 1u << powerOfTwo;
-        // find the location of in the texture from the morton code (quadtree position)
-        const auto [x, y] = unmorton(loc.code);
-        // scale to our maximum allocation size
-        const uint32_t mask = (1u << layer) - 1u;
-        result.viewport.left   = int32_t(x & mask) << powerOfTwo;
-        result.viewport.bottom = int32_t(y & mask) << powerOfTwo;
-        result.viewport.width  = dimension;
-        result.viewport.height = dimension;
-        result.layer = loc.code >> (2 * layer);
+        result = toAllocation(loc);
     }
     return result;
 }
 
+AtlasAllocator::Allocation AtlasAllocator::toAllocation(NodeId const node) const noexcept {
+    assert_invariant(node.l >= int8_t(LAYERS_DEPTH));
+    Allocation result{};
+    const size_t layer = size_t(node.l) - LAYERS_DEPTH;
+    const size_t powerOfTwo = mMaxTextureSizePot - layer;
+    const size_t dimension = 1u << powerOfTwo;
+    // find the location of in the texture from the morton code (quadtree position)
+    const auto [x, y] = unmorton(node.code);
+    // scale to our maximum allocation size
+    const uint32_t mask = (1u << layer) - 1u;
+    result.viewport.left   = int32_t(x & mask) << powerOfTwo;
+    result.viewport.bottom = int32_t(y & mask) << powerOfTwo;
+    result.viewport.width  = dimension;
+    result.viewport.height = dimension;
+    result.layer = node.code >> (2 * layer);
+    return result;
+}
+
+bool AtlasAllocator::free(Allocation const& allocation) noexcept {
+    if (UTILS_UNLIKELY(allocation.layer < 0 || allocation.viewport.width == 0)) {
+        return false;
+    }
+    const size_t powerOfTwo =
+            (sizeof(size_t) * 8 - 1u) - clz(size_t(allocation.viewport.width));
+    if (UTILS_UNLIKELY(powerOfTwo > mMaxTextureSizePot ||
+            mMaxTextureSizePot - powerOfTwo >= QUAD_TREE_DEPTH)) {
+        return false;
+    }
+    // reconstruct the node from the layer and viewport (inverse of toAllocation())
+    const size_t layer = mMaxTextureSizePot - powerOfTwo;
+    const NodeId node{
+            int8_t(LAYERS_DEPTH + layer),
+            QuadTree::code_t((uint32_t(allocation.layer) << (2u * layer)) |
+                    morton(uint8_t(uint32_t(allocation.viewport.left) >> powerOfTwo),
+                           uint8_t(uint32_t(allocation.viewport.bottom) >> powerOfTwo)))
+    };
+    if (UTILS_UNLIKELY(
+            !mQuadTree[QuadTreeUtils::index(node.l, node.code)].isAllocated())) {
+        return false;
+    }
+    freeNode(node);
+    return true;
+}
+
+bool AtlasAllocator::defragment(Relocation* const relocation) noexcept {
+    // look for the allocated block furthest from the origin in morton order, it's the
+    // best candidate to relocate
+    NodeId worst{ -1, 0 };
+    uint32_t worstPosition = 0;
+    QuadTree::traverse(0, 0,
+            [this, &worst, &worstPosition](NodeId const& curr) -> QuadTree::TraversalResult {
+                Node const& node = mQuadTree[QuadTreeUtils::index(curr.l, curr.code)];
+                if (node.isAllocated()) {
+                    // nodes above LAYERS_DEPTH only exist in tests, skip them
+                    if (curr.l >= int8_t(LAYERS_DEPTH)) {
+                        const uint32_t position = normalizedPosition(curr);
+                        if (worst.l < 0 || position > worstPosition) {
+                            worst = curr;
+                            worstPosition = position;
+                        }
+                    }
+                    return QuadTree::TraversalResult::SKIP_CHILDREN;
+                }
+                return node.hasChildren() ?
+                        QuadTree::TraversalResult::RECURSE :
+                        QuadTree::TraversalResult::SKIP_CHILDREN;
+            });
+
+    if (worst.l < 0) {
+        return false;
+    }
+
+    // then see if the regular best-fit allocation finds it a spot closer to the origin
+    freeNode(worst);
+    const NodeId moved = allocateInLayer(size_t(worst.l));
+    assert_invariant(moved.l == worst.l);
+    if (normalizedPosition(moved) >= worstPosition) {
+        // it doesn't, restore the previous state
+        if (moved.code != worst.code) {
+            freeNode(moved);
+            markAllocated(worst);
+        }
+        return false;
+    }
+    if (relocation) {
+        relocation->from = toAllocation(worst);
+        relocation->to = toAllocation(moved);
+    }
+    return true;
+}
+
+void AtlasAllocator::freeNode(NodeId const node) noexcept {
+    Node& allocation = mQuadTree[QuadTreeUtils::index(node.l, node.code)];
+    assert_invariant(allocation.isAllocated());
+    assert_invariant(!allocation.hasChildren());
+    allocation.allocated = false;
+    // walk up the hierarchy, removing now-empty nodes from their parent's children count
+    NodeId curr = node;
+    while (curr.l > 0) {
+        Node const& child = mQuadTree[QuadTreeUtils::index(curr.l, curr.code)];
+        if (child.isAllocated() || child.hasChildren()) {
+            break;
+        }
+        Node& parentNode = mQuadTree[QuadTreeUtils::parent(curr.l, curr.code)];
+        assert_invariant(!parentNode.isAllocated());
+        assert_invariant(parentNode.hasChildren());
+        parentNode.children--;
+        curr = NodeId{ int8_t(curr.l - 1), QuadTree::code_t(curr.code >> 2u) };
+    }
+}
+
+void AtlasAllocator::markAllocated(NodeId const node) noexcept {
+    Node& allocation = mQuadTree[QuadTreeUtils::index(node.l, node.code)];
+    assert_invariant(!allocation.isAllocated());
+    assert_invariant(!allocation.hasChildren());
+    allocation.allocated = true;
+    // walk up the hierarchy, creating the nodes that don't exist yet
+    NodeId curr = node;
+    while (curr.l > 0) {
+        Node& parentNode = mQuadTree[QuadTreeUtils::parent(curr.l, curr.code)];
+        assert_invariant(!parentNode.isAllocated());
+        const bool existed = parentNode.hasChildren();
+        parentNode.children++;
+        if (existed) {
+            break;
+        }
+        curr = NodeId{ int8_t(curr.l - 1), QuadTree::code_t(curr.code >> 2u) };
+    }
+}
+
+uint32_t AtlasAllocator::normalizedPosition(NodeId const node) noexcept {
+    return uint32_t(node.code) << (2u * (QuadTree::height() - 1u - size_t(node.l)));
+}
+
 void AtlasAllocator::clear(size_t const maxTextureSize) noexcept {
     std::fill(mQuadTree.begin(), mQuadTree.end(), Node{});
     mMaxTextureSizePot = (sizeof(maxTextureSize) * 8 - 1u) - clz(maxTextureSize);
@@ -151,7 +284,7 @@ AtlasAllocator::NodeId AtlasAllocator::allocateInLayer(size_t const maxHeight) n
                 NodeId ppp = candidate;
                 while (ppp.l > 0) {
                     const size_t pi = QuadTreeUtils::parent(ppp.l, ppp.code);
-                    ppp = NodeId{ int8_t(ppp.l - 1), uint8_t(ppp.code >> 2) };
+                    ppp = NodeId{ int8_t(ppp.l - 1), QuadTree::code_t(ppp.code >> 2) };
                     Node const& node = mQuadTree[pi];
                     assert_invariant(!node.isAllocated());
                     assert_invariant(node.hasChildren());
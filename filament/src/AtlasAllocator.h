@@ -90,6 +90,32 @@ public:
     };
     Allocation allocate(size_t textureSize) noexcept;
 
+    /*
+     * Frees a previous allocation, making its space available again. The allocation must have
+     * been returned by allocate() and not freed already. Returns false if the allocation is
+     * invalid. This allows the atlas to persist across frames and be demand-sized, instead of
+     * being laid out from scratch for the worst case.
+     */
+    bool free(Allocation const& allocation) noexcept;
+
+    /*
+     * A defragmentation step. The content of the `from` block must be copied to `to` by the
+     * caller; both describe a square of the same size.
+     */
+    struct Relocation {
+        Allocation from;
+        Allocation to;
+    };
+
+    /*
+     * Performs at most one relocation step: the allocated block furthest from the origin is
+     * moved to the closest free slot that fits it. Intended to be called at a low frequency
+     * (e.g. once per frame) so the caller can spread the texture copies over time; cold
+     * cached shadow maps relocate for free since they're not re-rendered.
+     * Returns false when the atlas is already as compact as this allocator can make it.
+     */
+    bool defragment(Relocation* relocation) noexcept;
+
     /*
      * Frees all allocations and reset the maximum texture size.
      */
@@ -104,6 +130,19 @@ private:
 
     QuadTree::NodeId allocateInLayer(size_t n) noexcept;
 
+    // converts a node to its Allocation (layer and viewport within the atlas)
+    Allocation toAllocation(NodeId node) const noexcept;
+
+    // frees a node and trims the now-empty part of the hierarchy above it
+    void freeNode(NodeId node) noexcept;
+
+    // allocates a specific node, creating the hierarchy above it as needed
+    void markAllocated(NodeId node) noexcept;
+
+    // position of a node in morton order, normalized to the deepest level, used to
+    // compare positions of nodes that live at different levels
+    static uint32_t normalizedPosition(NodeId node) noexcept;
+
     // quad-tree array to store the allocated list
     QuadTree mQuadTree{};
     uint8_t mMaxTextureSizePot = 0;
@@ -31,4 +31,8 @@ size_t BufferObject::getByteCount() const noexcept {
     return downcast(this)->getByteCount();
 }
 
+void* BufferObject::getMappedBuffer(Engine& engine) const noexcept {
+    return downcast(this)->getMappedBuffer(downcast(engine));
+}
+
 } // namespace filament
@@ -20,6 +20,14 @@
 
 #include <math/fast.h>
 
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#   include <arm_neon.h>
+#   define FILAMENT_CULLER_USE_NEON 1
+#elif defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#   include <immintrin.h>
+#   define FILAMENT_CULLER_USE_AVX2 1
+#endif
+
 using namespace filament::math;
 
 // use 8 if Culler::result_type is 8-bits, on ARMv8 it allows the compiler to write eight
@@ -31,15 +39,12 @@ namespace filament {
 static_assert(Culler::MODULO % FILAMENT_CULLER_VECTORIZE_HINT == 0,
         "MODULO m=must be a multiple of FILAMENT_CULLER_VECTORIZE_HINT");
 
-void Culler::intersects(
-        result_type* UTILS_RESTRICT results,
-        Frustum const& UTILS_RESTRICT frustum,
+static void intersectsSpheresScalar(
+        Culler::result_type* UTILS_RESTRICT results,
+        float4 const* UTILS_RESTRICT planes,
         float4 const* UTILS_RESTRICT b,
         size_t count) noexcept {
 
-    float4 const * const UTILS_RESTRICT planes = frustum.mPlanes;
-
-    count = round(count);
 #if defined(__clang__)
     #pragma clang loop vectorize_width(FILAMENT_CULLER_VECTORIZE_HINT)
 #endif
@@ -59,8 +64,123 @@ void Culler::intersects(
                               planes[j].w - sphere.w;
             visible &= fast::signbit(dot);
         }
-        results[i] = result_type(visible);
+        results[i] = Culler::result_type(visible);
+    }
+}
+
+#if defined(FILAMENT_CULLER_USE_NEON)
+
+// Tests 4 spheres per iteration. vld4q deinterleaves the AoS sphere stream into
+// x/y/z/w lanes, so each plane test is a handful of fused multiply-adds.
+static void intersectsSpheresNeon(
+        Culler::result_type* UTILS_RESTRICT results,
+        float4 const* UTILS_RESTRICT planes,
+        float4 const* UTILS_RESTRICT b,
+        size_t count) noexcept {
+    float32x4_t const zero = vdupq_n_f32(0.0f);
+    for (size_t i = 0; i < count; i += 4) {
+        float32x4x4_t const s = vld4q_f32(reinterpret_cast<float const*>(b + i));
+        uint32x4_t visible = vdupq_n_u32(~0u);
+        for (size_t j = 0; j < 6; j++) {
+            float32x4_t dot = vdupq_n_f32(planes[j].w);
+            dot = vfmaq_n_f32(dot, s.val[0], planes[j].x);
+            dot = vfmaq_n_f32(dot, s.val[1], planes[j].y);
+            dot = vfmaq_n_f32(dot, s.val[2], planes[j].z);
+            dot = vsubq_f32(dot, s.val[3]);
+            visible = vandq_u32(visible, vcltq_f32(dot, zero));
+        }
+        uint16x4_t const n16 = vmovn_u32(visible);
+        uint8x8_t const n8 = vmovn_u16(vcombine_u16(n16, n16));
+        vst1_lane_u32(reinterpret_cast<uint32_t*>(results + i),
+                vreinterpret_u32_u8(n8), 0);
+    }
+}
+
+#elif defined(FILAMENT_CULLER_USE_AVX2)
+
+// Tests 8 spheres per iteration. The AoS sphere stream is transposed to SoA
+// registers (x/y/z/w, 8 wide) so each plane test is three FMAs and a compare.
+__attribute__((target("avx2,fma")))
+static void intersectsSpheresAvx2(
+        Culler::result_type* UTILS_RESTRICT results,
+        float4 const* UTILS_RESTRICT planes,
+        float4 const* UTILS_RESTRICT b,
+        size_t count) noexcept {
+    __m256 const zero = _mm256_setzero_ps();
+    float const* p = reinterpret_cast<float const*>(b);
+    for (size_t i = 0; i < count; i += 8, p += 32) {
+        __m256 const t0 = _mm256_loadu_ps(p +  0);    // s0 s1
+        __m256 const t1 = _mm256_loadu_ps(p +  8);    // s2 s3
+        __m256 const t2 = _mm256_loadu_ps(p + 16);    // s4 s5
+        __m256 const t3 = _mm256_loadu_ps(p + 24);    // s6 s7
+        __m256 const r04 = _mm256_permute2f128_ps(t0, t2, 0x20);
+        __m256 const r15 = _mm256_permute2f128_ps(t0, t2, 0x31);
+        __m256 const r26 = _mm256_permute2f128_ps(t1, t3, 0x20);
+        __m256 const r37 = _mm256_permute2f128_ps(t1, t3, 0x31);
+        __m256 const lo01 = _mm256_unpacklo_ps(r04, r15);
+        __m256 const lo23 = _mm256_unpacklo_ps(r26, r37);
+        __m256 const hi01 = _mm256_unpackhi_ps(r04, r15);
+        __m256 const hi23 = _mm256_unpackhi_ps(r26, r37);
+        __m256 const x = _mm256_shuffle_ps(lo01, lo23, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 const y = _mm256_shuffle_ps(lo01, lo23, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 const z = _mm256_shuffle_ps(hi01, hi23, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 const w = _mm256_shuffle_ps(hi01, hi23, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(~0));
+        for (size_t j = 0; j < 6; j++) {
+            __m256 dot = _mm256_sub_ps(_mm256_broadcast_ss(&planes[j].w), w);
+            dot = _mm256_fmadd_ps(_mm256_broadcast_ss(&planes[j].x), x, dot);
+            dot = _mm256_fmadd_ps(_mm256_broadcast_ss(&planes[j].y), y, dot);
+            dot = _mm256_fmadd_ps(_mm256_broadcast_ss(&planes[j].z), z, dot);
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(dot, zero, _CMP_LT_OQ));
+        }
+        int const mask = _mm256_movemask_ps(visible);
+        for (size_t k = 0; k < 8; k++) {
+            results[i + k] = Culler::result_type(-((mask >> k) & 1));
+        }
+    }
+}
+
+static bool hasAvx2Support() noexcept {
+    static bool const supported =
+            __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+}
+
+#endif
+
+void Culler::intersects(
+        result_type* UTILS_RESTRICT results,
+        Frustum const& UTILS_RESTRICT frustum,
+        float4 const* UTILS_RESTRICT b,
+        size_t count) noexcept {
+
+    float4 const * const UTILS_RESTRICT planes = frustum.mPlanes;
+
+    count = round(count);
+
+#if defined(FILAMENT_CULLER_USE_NEON)
+    intersectsSpheresNeon(results, planes, b, count);
+#elif defined(FILAMENT_CULLER_USE_AVX2)
+    if (UTILS_LIKELY(hasAvx2Support())) {
+        intersectsSpheresAvx2(results, planes, b, count);
+    } else {
+        intersectsSpheresScalar(results, planes, b, count);
     }
+#else
+    intersectsSpheresScalar(results, planes, b, count);
+#endif
+}
+
+void Culler::intersectsScalar(
+        result_type* UTILS_RESTRICT results,
+        Frustum const& UTILS_RESTRICT frustum,
+        float4 const* UTILS_RESTRICT b,
+        size_t count) noexcept {
+
+    float4 const * const UTILS_RESTRICT planes = frustum.mPlanes;
+
+    count = round(count);
+    intersectsSpheresScalar(results, planes, b, count);
 }
 
 void Culler::intersects(
@@ -146,4 +266,11 @@ void Culler::Test::intersects(
     Culler::intersects(results, frustum, b, count);
 }
 
+void Culler::Test::intersectsScalar(
+        result_type* UTILS_RESTRICT results,
+        Frustum const& UTILS_RESTRICT frustum,
+        float4 const* UTILS_RESTRICT b, size_t const count) noexcept {
+    Culler::intersectsScalar(results, frustum, b, count);
+}
+
 } // namespace filament
@@ -55,6 +55,7 @@ public:
 
     /*
      * returns whether each sphere in an array intersects with the frustum
+     * (dispatches to an explicitly vectorized path when the CPU supports it)
      */
     static void intersects(
             result_type* results,
@@ -62,6 +63,16 @@ public:
             math::float4 const* b,
             size_t count) noexcept;
 
+    /*
+     * same as above, but always uses the scalar (autovectorized) loop; used
+     * as a reference for testing and benchmarking the vectorized path
+     */
+    static void intersectsScalar(
+            result_type* results,
+            Frustum const& frustum,
+            math::float4 const* b,
+            size_t count) noexcept;
+
     /*
      * returns whether an AABB intersects with the frustum
      */
@@ -88,6 +99,11 @@ public:
                 Frustum const& frustum,
                 math::float4 const* b,
                 size_t count) noexcept;
+
+        static void intersectsScalar(result_type* results,
+                Frustum const& frustum,
+                math::float4 const* b,
+                size_t count) noexcept;
     };
 };
 
@@ -19,30 +19,79 @@
 #include "details/Engine.h"
 #include "details/Texture.h"
 
+#include <math/half.h>
+
+#include <utils/compiler.h>
+
 namespace filament {
 
 const uint16_t DFG::DFG_LUT[] = {
 #include "generated/data/dfg.inc"
 };
 
-void DFG::init(FEngine& engine) noexcept {
+void DFG::prepareLut(FEngine& engine) noexcept {
     constexpr size_t fp16Count = DFG_LUT_SIZE * DFG_LUT_SIZE * 3;
     constexpr size_t byteCount = fp16Count * sizeof(uint16_t);
 
     static_assert(sizeof(DFG_LUT) == byteCount, "DFG_LUT_SIZE doesn't match size of the DFG LUT");
 
+    mLutSize = DFG_LUT_SIZE;
+    mLutData = DFG_LUT;
+
+    // A reduced variant can be selected to save texture bandwidth on low-end devices. It is
+    // computed from the embedded LUT by averaging 2x2 texel blocks; the DFG terms are smooth,
+    // so a box filter is accurate enough.
+    uint16_t const requested = engine.getConfig().dfgLutSize;
+    if (UTILS_UNLIKELY(requested != 0 && requested <= DFG_LUT_SIZE / 2)) {
+        constexpr size_t lutSize = DFG_LUT_SIZE / 2;
+        mDownsampled.reset(new uint16_t[lutSize * lutSize * 3]);
+        uint16_t* UTILS_RESTRICT dst = mDownsampled.get();
+        for (size_t y = 0; y < lutSize; y++) {
+            for (size_t x = 0; x < lutSize; x++) {
+                for (size_t c = 0; c < 3; c++) {
+                    auto texel = [c](size_t sx, size_t sy) {
+                        return float(math::makeHalf(DFG_LUT[(sy * DFG_LUT_SIZE + sx) * 3 + c]));
+                    };
+                    float const v = 0.25f * (
+                            texel(2 * x, 2 * y)     + texel(2 * x + 1, 2 * y) +
+                            texel(2 * x, 2 * y + 1) + texel(2 * x + 1, 2 * y + 1));
+                    dst[(y * lutSize + x) * 3 + c] = getBits(math::half(v));
+                }
+            }
+        }
+        mLutSize = lutSize;
+        mLutData = mDownsampled.get();
+    }
+}
+
+void DFG::init(FEngine& engine) noexcept {
+    if (mLutData == nullptr) {
+        prepareLut(engine);
+    }
+
+    // The texture is created now so the handle is valid immediately, but the upload is
+    // deferred to upload(), off the Engine::create() critical path.
     Texture* lut = Texture::Builder()
-            .width(DFG_LUT_SIZE)
-            .height(DFG_LUT_SIZE)
+            .width(mLutSize)
+            .height(mLutSize)
             .format(backend::TextureFormat::RGB16F)
             .build(engine);
 
-    Texture::PixelBufferDescriptor buffer(DFG_LUT, byteCount,
+    mLUT = downcast(lut);
+}
+
+void DFG::upload(FEngine& engine) noexcept {
+    if (UTILS_LIKELY(mLutData == nullptr)) {
+        return;
+    }
+
+    size_t const byteCount = mLutSize * mLutSize * 3 * sizeof(uint16_t);
+    Texture::PixelBufferDescriptor buffer(mLutData, byteCount,
             Texture::Format::RGB, Texture::Type::HALF);
 
-    lut->setImage(engine, 0, std::move(buffer));
+    mLUT->setImage(engine, 0, 0, 0, 0, mLutSize, mLutSize, 1, std::move(buffer));
 
-    mLUT = downcast(lut);
+    mLutData = nullptr;
 }
 
 void DFG::terminate(FEngine& engine) noexcept {
@@ -23,6 +23,11 @@
 
 #include <utils/compiler.h>
 
+#include <memory>
+
+#include <stddef.h>
+#include <stdint.h>
+
 namespace filament {
 
 class FEngine;
@@ -40,10 +45,19 @@ public:
     DFG& operator=(DFG const& rhs) = delete;
     DFG& operator=(DFG&& rhs) = delete;
 
+    // Prepares the LUT data on the CPU (including the optional reduced variant). This touches
+    // no driver state and can run on any thread, so FEngine::init() overlaps it with the rest
+    // of the engine setup. Calling init() without it is fine: init() prepares on demand.
+    void prepareLut(FEngine& engine) noexcept;
+
     void init(FEngine& engine) noexcept;
 
+    // Uploads the LUT data on first use. Called once per frame from FEngine::prepare(),
+    // which keeps the upload off the Engine::create() critical path; no-op once uploaded.
+    void upload(FEngine& engine) noexcept;
+
     size_t getLutSize() const noexcept {
-        return DFG_LUT_SIZE;
+        return mLutSize;
     }
 
     bool isValid() const noexcept {
@@ -59,6 +73,13 @@ public:
 private:
     FTexture* mLUT = nullptr;
 
+    // data pending upload, null once uploaded
+    const uint16_t* mLutData = nullptr;
+    // backing store for the reduced variant (see Engine::Config::dfgLutSize); must stay
+    // alive until the driver has consumed the upload, so it is freed in terminate()
+    std::unique_ptr<uint16_t[]> mDownsampled;
+    size_t mLutSize = DFG_LUT_SIZE;
+
     // make sure to use the right size here
     static constexpr size_t DFG_LUT_SIZE = FILAMENT_DFG_LUT_SIZE;
 
@@ -89,6 +89,10 @@ DebugRegistry::DataSource DebugRegistry::getDataSource(const char* name) const n
     return  downcast(this)->getDataSource(name);
 }
 
+size_t DebugRegistry::snapshotCounters(CounterSnapshot* out, size_t const capacity) const noexcept {
+    return downcast(this)->snapshotCounters(out, capacity);
+}
+
 
 } // namespace filament
 
@@ -350,6 +350,10 @@ void Engine::flush() {
     downcast(this)->flush();
 }
 
+void Engine::trimMemory() noexcept {
+    downcast(this)->trimMemory();
+}
+
 EntityManager& Engine::getEntityManager() noexcept {
     return downcast(this)->getEntityManager();
 }
@@ -399,6 +403,26 @@ void Engine::setPaused(bool const paused) {
     downcast(this)->setPaused(paused);
 }
 
+void Engine::startProfiling(void* buffer, size_t const sizeInBytes) noexcept {
+    downcast(this)->startProfiling(buffer, sizeInBytes);
+}
+
+size_t Engine::stopProfiling() noexcept {
+    return downcast(this)->stopProfiling();
+}
+
+void Engine::setPrewarmTraceRecording(bool const enabled) noexcept {
+    downcast(this)->setPrewarmTraceRecording(enabled);
+}
+
+size_t Engine::getPrewarmTrace(void* buffer, size_t const sizeInBytes) const noexcept {
+    return downcast(this)->getPrewarmTrace(buffer, sizeInBytes);
+}
+
+size_t Engine::prewarm(void const* data, size_t const sizeInBytes) noexcept {
+    return downcast(this)->prewarm(data, sizeInBytes);
+}
+
 DebugRegistry& Engine::getDebugRegistry() noexcept {
     return downcast(this)->getDebugRegistry();
 }
@@ -419,6 +443,26 @@ bool Engine::isAutomaticInstancingEnabled() const noexcept {
     return downcast(this)->isAutomaticInstancingEnabled();
 }
 
+void Engine::setMemoryBudget(uint64_t const budgetBytes) noexcept {
+    downcast(this)->getMemoryMonitor().setBudget(budgetBytes);
+}
+
+void Engine::setMemoryPressureCallback(MemoryPressureCallback const callback, void* const user) noexcept {
+    downcast(this)->getMemoryMonitor().setCallback(callback, user);
+}
+
+uint64_t Engine::getEstimatedGpuMemoryUsage() const noexcept {
+    return downcast(this)->getMemoryMonitor().getTotalBytes();
+}
+
+void Engine::setDrawMergingEnabled(bool const enable) noexcept {
+    downcast(this)->setDrawMergingEnabled(enable);
+}
+
+bool Engine::isDrawMergingEnabled() const noexcept {
+    return downcast(this)->isDrawMergingEnabled();
+}
+
 FeatureLevel Engine::getSupportedFeatureLevel() const noexcept {
     return downcast(this)->getSupportedFeatureLevel();
 }
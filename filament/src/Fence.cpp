@@ -16,6 +16,8 @@
 
 #include "details/Fence.h"
 
+#include "details/Engine.h"
+
 namespace filament {
 
 using namespace backend;
@@ -28,4 +30,13 @@ FenceStatus Fence::wait(Mode const mode, uint64_t const timeout) {
     return downcast(this)->wait(mode, timeout);
 }
 
+uint64_t Fence::getTimelineValue() const noexcept {
+    return downcast(this)->getTimelineValue();
+}
+
+FenceStatus Fence::waitForTimelineValue(Engine& engine, uint64_t const value,
+        Mode const mode, uint64_t const timeout) {
+    return FFence::waitForTimelineValue(*downcast(&engine), value, mode, timeout);
+}
+
 } // namespace filament
@@ -42,6 +42,7 @@ struct FrameHistoryEntry {
         FrameGraphTexture color;
         FrameGraphTexture::Descriptor desc;
         math::mat4 projection;
+        uint32_t frameId = 0;   // used for the quarter-rate tracing pattern
     } ssr;
 };
 
@@ -54,6 +54,12 @@ void FrameInfoManager::terminate(DriverApi& driver) noexcept {
     for (auto& query : mQueries) {
         driver.destroyTimerQuery(query.handle);
     }
+    for (auto& fence : mFences) {
+        if (fence.handle) {
+            driver.destroyFence(fence.handle);
+            fence.handle = {};
+        }
+    }
 }
 
 void FrameInfoManager::beginFrame(DriverApi& driver, Config const& config, uint32_t frameId) noexcept {
@@ -71,9 +77,15 @@ void FrameInfoManager::beginFrame(DriverApi& driver, Config const& config, uint3
 
     // references are not invalidated by CircularQueue<>, so we can associate a reference to
     // the slot we created to the timer query used to find the frame time.
-    mQueries[mIndex].pInfo = std::addressof(front);
-    // issue the timer query
-    driver.beginTimerQuery(mQueries[mIndex].handle);
+    if (UTILS_LIKELY(config.gpuTimerQuery)) {
+        mQueries[mIndex].pInfo = std::addressof(front);
+        // issue the timer query
+        driver.beginTimerQuery(mQueries[mIndex].handle);
+    } else {
+        // the frame-wide query yields to per-pass profiling for this frame; the null
+        // pInfo tells the polling loop and endFrame() that this slot wasn't issued
+        mQueries[mIndex].pInfo = nullptr;
+    }
     // issue the custom backend command to get the backend time
     driver.queueCommand([&front](){
         front.backendBeginFrame = std::chrono::steady_clock::now();
@@ -81,6 +93,11 @@ void FrameInfoManager::beginFrame(DriverApi& driver, Config const& config, uint3
 
     // now is a good time to check the oldest active query
     while (mLast != mIndex) {
+        if (UTILS_UNLIKELY(!mQueries[mLast].pInfo)) {
+            // no query was issued for that frame (see Config::gpuTimerQuery)
+            mLast = (mLast + 1) % POOL_COUNT;
+            continue;
+        }
         uint64_t elapsed = 0;
         TimerQueryResult const result = driver.getTimerQueryValue(mQueries[mLast].handle, &elapsed);
         switch (result) {
@@ -107,6 +124,29 @@ void FrameInfoManager::beginFrame(DriverApi& driver, Config const& config, uint3
         // read the pending timer queries until we find one that's not ready
     }
 
+    // similarly, poll the pending frame fences, oldest first, to attribute the time at which
+    // the GPU actually finished each frame. On Android/EGL these are backed by
+    // EGL_ANDROID_native_fence_sync, so this reflects when composition could start.
+    while (mLastFence != mIndex) {
+        auto& fence = mFences[mLastFence];
+        if (fence.handle) {
+            FenceStatus const status = driver.getFenceStatus(fence.handle);
+            if (status == FenceStatus::TIMEOUT_EXPIRED) {
+                // not signaled yet; by construction the newer ones aren't either
+                break;
+            }
+            if (status == FenceStatus::CONDITION_SATISFIED) {
+                fence.pInfo->gpuFrameComplete = clock::now();
+            } else {
+                // the platform can't create fences, don't try again
+                mFencesSupported = false;
+            }
+            driver.destroyFence(fence.handle);
+            fence.handle = {};
+        }
+        mLastFence = (mLastFence + 1) % POOL_COUNT;
+    }
+
     // keep this just for debugging
     if constexpr (false) {
         using namespace utils;
@@ -123,8 +163,10 @@ void FrameInfoManager::beginFrame(DriverApi& driver, Config const& config, uint3
 
 void FrameInfoManager::endFrame(DriverApi& driver) noexcept {
     auto& front = mFrameTimeHistory.front();
-    // close the timer query
-    driver.endTimerQuery(mQueries[mIndex].handle);
+    if (UTILS_LIKELY(mQueries[mIndex].pInfo)) {
+        // close the timer query
+        driver.endTimerQuery(mQueries[mIndex].handle);
+    }
     // queue custom backend command to query the current time
     driver.queueCommand([&front](){
         // backend frame end-time
@@ -134,6 +176,18 @@ void FrameInfoManager::endFrame(DriverApi& driver) noexcept {
     });
     // and finally acquire the time on the main thread
     front.endFrame = std::chrono::steady_clock::now();
+
+    // issue a fence so we can tell when the GPU is actually done with this frame
+    if (mFencesSupported) {
+        auto& fence = mFences[mIndex];
+        if (UTILS_UNLIKELY(fence.handle)) {
+            // the GPU is more than POOL_COUNT frames behind, drop the oldest sample
+            driver.destroyFence(fence.handle);
+        }
+        fence.handle = driver.createFence();
+        fence.pInfo = std::addressof(front);
+    }
+
     mIndex = (mIndex + 1) % POOL_COUNT;
 }
 
@@ -195,7 +249,11 @@ FixedCapacityVector<Renderer::FrameInfo> FrameInfoManager::getFrameInfoHistory(
                 duration_cast<nanoseconds>(entry.beginFrame.time_since_epoch()).count(),
                 duration_cast<nanoseconds>(entry.endFrame.time_since_epoch()).count(),
                 duration_cast<nanoseconds>(entry.backendBeginFrame.time_since_epoch()).count(),
-                duration_cast<nanoseconds>(entry.backendEndFrame.time_since_epoch()).count()
+                duration_cast<nanoseconds>(entry.backendEndFrame.time_since_epoch()).count(),
+                duration_cast<nanoseconds>(entry.gpuFrameComplete.time_since_epoch()).count(),
+                duration_cast<nanoseconds>(entry.viewPrepareTime).count(),
+                duration_cast<nanoseconds>(entry.commandGenTime).count(),
+                duration_cast<nanoseconds>(entry.frameGraphTime).count()
         });
     }
     return result;
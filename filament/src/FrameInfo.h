@@ -56,6 +56,10 @@ struct FrameInfoImpl : public details::FrameInfo {
     time_point endFrame;             // main thread endFrame time
     time_point backendBeginFrame;    // backend thread beginFrame time (makeCurrent time)
     time_point backendEndFrame;      // backend thread endFrame time (present time)
+    time_point gpuFrameComplete{};   // time the frame's fence was seen signaled (GPU done)
+    duration viewPrepareTime{};      // main thread time spent in FView::prepare
+    duration commandGenTime{};       // CPU time spent generating and sorting pass commands
+    duration frameGraphTime{};       // main thread time spent in FrameGraph compile/execute
     std::atomic_bool ready{};        // true once backend thread has populated its data
     explicit FrameInfoImpl(uint32_t const frameId) noexcept
         : frameId(frameId) {
@@ -150,6 +154,10 @@ public:
 
     struct Config {
         uint32_t historySize;
+        // when false, the frame-wide GPU timer query is skipped for that frame; needed
+        // while per-pass profiling is active because the OpenGL GL_TIME_ELAPSED path
+        // only supports a single active query (see FrameGraphPassProfiler)
+        bool gpuTimerQuery = true;
     };
 
     explicit FrameInfoManager(backend::DriverApi& driver) noexcept;
@@ -163,6 +171,14 @@ public:
     // call this immediately before "swap buffers"
     void endFrame(backend::DriverApi& driver) noexcept;
 
+    // Accumulates CPU time attributed to the current frame; the same frame can receive
+    // several contributions (e.g. one per rendered view).
+    void accumulate(duration FrameInfoImpl::* const field, duration const d) noexcept {
+        if (UTILS_LIKELY(!mFrameTimeHistory.empty())) {
+            mFrameTimeHistory.front().*field += d;
+        }
+    }
+
     details::FrameInfo getLastFrameInfo() const noexcept {
         // if pFront is not set yet, return FrameInfo(). But the `valid` field will be false in this case.
         return pFront ? *pFront : details::FrameInfo{};
@@ -177,9 +193,16 @@ private:
         backend::Handle<backend::HwTimerQuery> handle{};
         FrameInfoImpl* pInfo = nullptr;
     };
+    struct FrameFence {
+        backend::Handle<backend::HwFence> handle{};
+        FrameInfoImpl* pInfo = nullptr;
+    };
     std::array<Query, POOL_COUNT> mQueries;
+    std::array<FrameFence, POOL_COUNT> mFences;
     uint32_t mIndex = 0;                // index of current query
     uint32_t mLast = 0;                 // index of oldest query still active
+    uint32_t mLastFence = 0;            // index of oldest fence still pending
+    bool mFencesSupported = true;       // cleared if the platform can't create fences
     FrameInfoImpl* pFront = nullptr;    // the most recent slot with a valid frame time
     FrameHistoryQueue mFrameTimeHistory;
 };
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FramePacer.h"
+
+#include <math/scalar.h>
+
+#include <utils/compiler.h>
+
+#include <stdint.h>
+
+namespace filament {
+
+FramePacer::FramePacer() noexcept {
+    // Mostly-integral controller: the start offset should converge over a handful of frames
+    // rather than chase every frame's noise. The proportional term gives an immediate (partial)
+    // response to load changes, the integral term removes the steady-state error.
+    mPid.setParallelGains(0.25f, 8.0f, 0.0f);
+
+    // don't bother moving the start time for less than 50us of error
+    mPid.setOutputDeadBand(-0.05f, 0.05f);
+}
+
+void FramePacer::update(details::FrameInfo const& frameInfo,
+        int64_t const vsyncPeriodNanos, float const headRoomRatio) noexcept {
+    if (UTILS_UNLIKELY(vsyncPeriodNanos <= 0 || !frameInfo.valid)) {
+        // pacing is disabled (e.g. offscreen swapchain) or we don't have timing data yet
+        mFrameStartOffsetNanos = 0;
+        return;
+    }
+
+    // everything below is in milliseconds, like FrameInfo::duration
+    float const period = float(vsyncPeriodNanos) * 1e-6f;
+
+    // the latch deadline, leaving the configured headroom before the next vsync
+    float const target = period * (1.0f - headRoomRatio);
+
+    // predicted completion time of the next frame relative to vsync, if it were started
+    // with the current offset
+    float const offset = float(mFrameStartOffsetNanos) * 1e-6f;
+    float const measure = offset + frameInfo.denoisedFrameTime.count();
+
+    // the controller output is a correction to the start offset. Bound it so that a single
+    // outlier frame can't move the start time by more than a fraction of the period, and
+    // bound the integral term accordingly to prevent windup while we're clamped.
+    mPid.setOutputLimits(-period * 0.25f, period * 0.25f);
+    mPid.setIntegralLimits(-period * 0.03125f, period * 0.03125f);
+    float const correction = mPid.update(measure, target, period * 1e-3f);
+
+    // never start more than half a period early (we'd eat into the previous frame's GPU
+    // time), nor later than the deadline itself allows
+    float const next = math::clamp(offset + correction, -period * 0.5f, target);
+    mFrameStartOffsetNanos = int64_t(next * 1e6f);
+}
+
+} // namespace filament
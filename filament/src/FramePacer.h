@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_FRAMEPACER_H
+#define TNT_FILAMENT_FRAMEPACER_H
+
+#include "FrameInfo.h"
+#include "PIDController.h"
+
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * FramePacer computes how much earlier or later than vsync the next frame should be started so
+ * that it completes -- and its swapchain buffer latches -- within the current vsync window.
+ *
+ * FrameSkipper only reacts after the fact, once the GPU is already running behind; by then a
+ * missed latch has typically cost a full refresh period. Instead, FramePacer predicts the next
+ * frame's completion time from the denoised GPU frame time maintained by FrameInfoManager, and
+ * servoes the frame start offset toward the latch deadline with a PIDController (the same
+ * controller used for dynamic resolution). The application is expected to poll the resulting
+ * offset via Renderer::getFrameStartOffsetNanos() and schedule its beginFrame() call accordingly.
+ */
+class FramePacer {
+public:
+    FramePacer() noexcept;
+
+    /*
+     * Updates the pacing model with the timing information of the most recent completed frame.
+     * vsyncPeriodNanos is the refresh period (see DisplayInfo::refreshRate), 0 disables pacing.
+     * headRoomRatio reserves a fraction of the period before the deadline, as a safety margin
+     * against frame time jitter (see FrameRateOptions::headRoomRatio).
+     */
+    void update(details::FrameInfo const& frameInfo,
+            int64_t vsyncPeriodNanos, float headRoomRatio) noexcept;
+
+    /*
+     * Returns the recommended offset to apply to the next beginFrame() relative to vsync.
+     * Positive values mean the frame can start that much later (reducing input latency),
+     * negative values that it should start earlier because the GPU is close to missing
+     * the deadline. Returns 0 when pacing is disabled or no timing data is available.
+     */
+    int64_t getFrameStartOffsetNanos() const noexcept { return mFrameStartOffsetNanos; }
+
+private:
+    PIDController mPid;
+    int64_t mFrameStartOffsetNanos = 0;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_FRAMEPACER_H
@@ -26,6 +26,7 @@
 #include <private/backend/DriverApi.h>
 
 #include <filament/Box.h>
+#include <filament/Options.h>
 #include <filament/Viewport.h>
 
 #include <backend/DriverEnums.h>
@@ -50,6 +51,7 @@
 #include <algorithm>
 #include <utils/architecture.h>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <limits>
 #include <type_traits>
@@ -178,6 +180,20 @@ void Froxelizer::setOptions(float const zLightNear, float const zLightFar) noexc
     }
 }
 
+void Froxelizer::setFogOptions(FogOptions const& options) noexcept {
+    mFogClassificationEnabled = options.enabled && options.density > 0.0f;
+    if (mFogClassificationEnabled) {
+        if (options.heightFalloff <= 0.0f) {
+            // constant-density fog, every froxel is relevant
+            mFogTopWorldY = std::numeric_limits<float>::infinity();
+        } else {
+            // the fog density decays as exp(-heightFalloff * (y - height)); above this
+            // altitude it has fallen below 1%, which we treat as "contributes nothing"
+            constexpr float LN_100 = 4.6051702f;
+            mFogTopWorldY = options.height + LN_100 / options.heightFalloff;
+        }
+    }
+}
 
 void Froxelizer::setViewport(filament::Viewport const& viewport) noexcept {
     if (UTILS_UNLIKELY(mViewport != viewport)) {
@@ -351,6 +367,9 @@ void Froxelizer::updateBoundingSpheres(
 
 UTILS_NOINLINE
 bool Froxelizer::update() noexcept {
+    // the froxel grid is being re-derived, the cached light assignment no longer applies
+    mAssignmentCache.valid = false;
+
     bool uniformsNeedUpdating = false;
     if (UTILS_UNLIKELY(mDirtyFlags & VIEWPORT_CHANGED)) {
         filament::Viewport const& viewport = mViewport;
@@ -548,8 +567,70 @@ void Froxelizer::froxelizeLights(FEngine& engine,
         mat4f const& UTILS_RESTRICT viewMatrix,
         const FScene::LightSoa& UTILS_RESTRICT lightData) noexcept {
     // note: this is called asynchronously
-    froxelizeLoop(engine, viewMatrix, lightData);
-    froxelizeAssignRecordsCompress();
+
+    // with a static camera and a static light set, last frame's assignment is still
+    // exact and only needs to be copied into this frame's buffers
+    auto& cache = mAssignmentCache;
+    size_t const count = lightData.size() - FScene::DIRECTIONAL_LIGHTS_COUNT;
+    auto const* const spheres =
+            lightData.data<FScene::POSITION_RADIUS>() + FScene::DIRECTIONAL_LIGHTS_COUNT;
+    auto const* const directions =
+            lightData.data<FScene::DIRECTION>() + FScene::DIRECTIONAL_LIGHTS_COUNT;
+    auto const* const instances =
+            lightData.data<FScene::LIGHT_INSTANCE>() + FScene::DIRECTIONAL_LIGHTS_COUNT;
+
+    bool reuse = cache.valid
+            && cache.spheres.size() == count
+            && !memcmp(&cache.viewMatrix, &viewMatrix, sizeof(mat4f))
+            && !memcmp(&cache.projection, &mProjection, sizeof(mat4f))
+            && !memcmp(cache.spheres.data(), spheres, count * sizeof(spheres[0]))
+            && !memcmp(cache.directions.data(), directions, count * sizeof(directions[0]))
+            && !memcmp(cache.instances.data(), instances, count * sizeof(instances[0]));
+
+    // the spot cone parameters live in the LightManager's SoA, not in lightData, and can be
+    // animated (setSpotLightCone()) without touching anything snapshotted above
+    auto const& lcm = engine.getLightManager();
+    auto const coneOf = [&lcm](FLightManager::Instance const li) noexcept -> float2 {
+        return { lcm.getCosOuterSquared(li), lcm.getSinInverse(li) };
+    };
+    if (reuse) {
+        assert_invariant(cache.cones.size() == count);
+        for (size_t i = 0; i < count; i++) {
+            float2 const cone = coneOf(instances[i]);
+            if (UTILS_UNLIKELY(memcmp(&cache.cones[i], &cone, sizeof(cone)) != 0)) {
+                reuse = false;
+                break;
+            }
+        }
+    }
+
+    if (UTILS_UNLIKELY(reuse)) {
+        assert_invariant(cache.froxels.size() == getFroxelBufferEntryCount());
+        memcpy(mFroxelBufferUser.data(), cache.froxels.data(),
+                cache.froxels.size() * sizeof(FroxelEntry));
+        memcpy(mRecordBufferUser.data(), cache.records.data(), cache.records.size());
+    } else {
+        froxelizeLoop(engine, viewMatrix, lightData);
+        froxelizeAssignRecordsCompress(engine);
+
+        // snapshot the inputs and the result for reuse next frame
+        cache.viewMatrix = viewMatrix;
+        cache.projection = mProjection;
+        cache.spheres.assign(spheres, spheres + count);
+        cache.directions.assign(directions, directions + count);
+        cache.cones.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            cache.cones[i] = coneOf(instances[i]);
+        }
+        cache.instances.assign(instances, instances + count);
+        cache.froxels.assign(mFroxelBufferUser.begin(), mFroxelBufferUser.end());
+        cache.records.assign(mRecordBufferUser.begin(), mRecordBufferUser.end());
+        cache.valid = true;
+    }
+
+    // stamp the per-froxel classification flags; this runs outside the assignment cache
+    // because the fog parameters can change independently of the light assignment
+    classifyFroxels(viewMatrix);
 
 #ifndef NDEBUG
     if (lightData.size()) {
@@ -575,6 +656,33 @@ void Froxelizer::froxelizeLights(FEngine& engine,
 #endif
 }
 
+void Froxelizer::classifyFroxels(mat4f const& UTILS_RESTRICT viewMatrix) noexcept {
+    if (UTILS_LIKELY(!mFogClassificationEnabled)) {
+        // entries are rebuilt (or copied from a cache snapshotted before classification)
+        // every frame, so the flag bits are already clear
+        return;
+    }
+
+    FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
+
+    // world-space y of a view-space point p is dot(row1(inverse(viewMatrix)), { p, 1 })
+    mat4f const invView = inverse(viewMatrix);
+    float4 const row1{ invView[0].y, invView[1].y, invView[2].y, invView[3].y };
+    float const fogTopWorldY = mFogTopWorldY;
+
+    float4 const* const UTILS_RESTRICT boundingSpheres = mBoundingSpheres;
+    FroxelEntry* const UTILS_RESTRICT froxels = mFroxelBufferUser.data();
+    for (size_t i = 0, c = mFroxelCount; i < c; i++) {
+        float4 const s = boundingSpheres[i];
+        float const centerWorldY = row1.x * s.x + row1.y * s.y + row1.z * s.z + row1.w;
+        // conservative: the froxel is fog-relevant if any part of its bounding sphere
+        // is below the fog top (the view matrix is rigid, the radius is preserved)
+        if (centerWorldY - s.w <= fogTopWorldY) {
+            froxels[i].u32 |= FroxelEntry::FLAG_FOG;
+        }
+    }
+}
+
 void Froxelizer::froxelizeLoop(FEngine& engine,
         const mat4f& UTILS_RESTRICT viewMatrix,
         const FScene::LightSoa& UTILS_RESTRICT lightData) noexcept {
@@ -644,33 +752,57 @@ void Froxelizer::froxelizeLoop(FEngine& engine,
     }
 }
 
-void Froxelizer::froxelizeAssignRecordsCompress() noexcept {
+void Froxelizer::froxelizeAssignRecordsCompress(FEngine& engine) noexcept {
     FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
 
+    auto const start = std::chrono::steady_clock::now();
+
     Slice<FroxelThreadData> const froxelThreadData = mFroxelShardedData;
 
     // convert froxel data from N groups of M bits to LightRecord::bitset, so we can
-    // easily compare adjacent froxels, for compaction. The conversion loops below get
-    // inlined and vectorized in release builds.
-
-    // this gets very well vectorized...
+    // easily compare adjacent froxels, for compaction. This runs as a parallel reduction
+    // over slices of the froxel buffer: each job converts its own range and folds its own
+    // partial "all lights" set, merged on this thread after the join -- no atomics needed.
+    // The conversion loops below get inlined and vectorized in release builds.
 
     Slice<LightRecord> records(mLightRecords);
-    for (size_t j = 0, jc = getFroxelBufferEntryCount(); j < jc; j++) {
-        for (size_t i = 0; i < LightRecord::bitset::WORLD_COUNT; i++) {
-            using container_type = LightRecord::bitset::container_type;
-            constexpr size_t r = sizeof(container_type) / sizeof(LightGroupType);
-            container_type b = froxelThreadData[i * r][j];
-            for (size_t k = 0; k < r; k++) {
-                b |= (container_type(froxelThreadData[i * r + k][j]) << (LIGHT_PER_GROUP * k));
+
+    constexpr size_t SLICE_JOB_COUNT = FROXEL_SLICE_COUNT;
+    LightRecord::bitset sliceLights[SLICE_JOB_COUNT];
+
+    auto convert = [froxelThreadData, &records, &sliceLights]
+            (size_t const job, size_t const begin, size_t const end) {
+        FILAMENT_TRACING_NAME(FILAMENT_TRACING_CATEGORY_FILAMENT, "FroxelizeConvert Job");
+        LightRecord::bitset local{};
+        for (size_t j = begin; j < end; j++) {
+            for (size_t i = 0; i < LightRecord::bitset::WORLD_COUNT; i++) {
+                using container_type = LightRecord::bitset::container_type;
+                constexpr size_t r = sizeof(container_type) / sizeof(LightGroupType);
+                container_type b = froxelThreadData[i * r][j];
+                for (size_t k = 0; k < r; k++) {
+                    b |= (container_type(froxelThreadData[i * r + k][j]) << (LIGHT_PER_GROUP * k));
+                }
+                records[j].lights.getBitsAt(i) = b;
             }
-            records[j].lights.getBitsAt(i) = b;
+            local |= records[j].lights;
         }
+        sliceLights[job] = local;
+    };
+
+    JobSystem& js = engine.getJobSystem();
+    size_t const jc = getFroxelBufferEntryCount();
+    size_t const chunk = (jc + SLICE_JOB_COUNT - 1) / SLICE_JOB_COUNT;
+    auto* parent = js.createJob();
+    for (size_t job = 0; job < SLICE_JOB_COUNT; job++) {
+        size_t const begin = std::min(job * chunk, jc);
+        js.run(jobs::createJob(js, parent, std::cref(convert),
+                job, begin, std::min(begin + chunk, jc)));
     }
+    js.runAndWait(parent);
 
     LightRecord::bitset allLights{};
-    for (size_t j = 0, jc = getFroxelBufferEntryCount(); j < jc; j++) {
-        allLights |= records[j].lights;
+    for (auto const& slice : sliceLights) {
+        allLights |= slice;
     }
 
     uint16_t offset = 0;
@@ -759,6 +891,11 @@ void Froxelizer::froxelizeAssignRecordsCompress() noexcept {
 out_of_memory:
     // FIXME: on big-endian systems we need to change the endianness of the record buffer
     ;
+
+    // published through "d.lighting.froxelize_records_compress_us" for per-frame tracking
+    engine.debug.lighting.froxelize_records_compress_us =
+            std::chrono::duration_cast<std::chrono::duration<float, std::micro>>(
+                    std::chrono::steady_clock::now() - start).count();
 }
 
 static float2 project(mat4f const& p, float3 const& v) noexcept {
@@ -33,6 +33,8 @@
 #include <math/mat4.h>
 #include <math/vec4.h>
 
+#include <vector>
+
 namespace filament {
 
 // The number of froxel buffer entries is determined by max UBO size (see
@@ -48,6 +50,7 @@ static_assert(FROXEL_BUFFER_MAX_ENTRY_COUNT % 4 == 0u);
 class FEngine;
 class FCamera;
 class FTexture;
+struct FogOptions;
 
 class Froxel {
 public:
@@ -99,6 +102,10 @@ public:
 
     void setOptions(float zLightNear, float zLightFar) noexcept;
 
+    // Parameters for the per-froxel fog classification (see FroxelEntry::FLAG_FOG).
+    // Called each frame before froxelizeLights().
+    void setFogOptions(FogOptions const& options) noexcept;
+
     /*
      * Allocate per-frame data structures for froxelization.
      *
@@ -141,9 +148,13 @@ public:
      */
 
     struct FroxelEntry {
+        // bits [8..16) are unused by offset/count and carry per-froxel classification
+        // flags, letting the fragment shaders branch out coherently per froxel
+        static constexpr uint32_t FLAG_FOG = 0x100u;   // fog can contribute in this froxel
         inline FroxelEntry(uint16_t const offset, uint8_t const count) noexcept
             : u32((offset << 16) | count) { }
         inline uint8_t count() const noexcept { return u32 & 0xFFu; }
+        inline uint8_t flags() const noexcept { return (u32 >> 8u) & 0xFFu; }
         inline uint16_t offset() const noexcept { return u32 >> 16u; }
         uint32_t u32 = 0;
     };
@@ -202,7 +213,8 @@ private:
     void froxelizeLoop(FEngine& engine,
             math::mat4f const& viewMatrix, const FScene::LightSoa& lightData) noexcept;
 
-    void froxelizeAssignRecordsCompress() noexcept;
+    void froxelizeAssignRecordsCompress(FEngine& engine) noexcept;
+    void classifyFroxels(math::mat4f const& viewMatrix) noexcept;
 
     void froxelizePointAndSpotLight(FroxelThreadData& froxelThread, size_t bit,
             math::mat4f const& projection, const LightParams& light) const noexcept;
@@ -276,12 +288,35 @@ private:
     float mZLightNear;
     float mZLightFar;
 
+    // fog classification parameters (see setFogOptions() / classifyFroxels())
+    float mFogTopWorldY = 0.0f;
+    bool mFogClassificationEnabled = false;
+
     // track if we need to update our internal state before froxelizing
     uint8_t mDirtyFlags = 0;
     enum {
         VIEWPORT_CHANGED = 0x01,
         PROJECTION_CHANGED = 0x02
     };
+
+    // Cross-frame froxelization cache. When the froxel grid, the view matrix and the
+    // visible light set (including the spot cone parameters, which live in the
+    // LightManager) are all bit-identical to the last froxelized frame (i.e. fully
+    // static lighting seen from a static camera), the previous assignment is reused and
+    // froxelizeLights() degenerates into two memcpy()s. Invalidated whenever the grid
+    // is re-derived by update().
+    struct AssignmentCache {
+        bool valid = false;
+        math::mat4f viewMatrix;
+        math::mat4f projection;
+        std::vector<math::float4> spheres;
+        std::vector<math::float3> directions;
+        std::vector<math::float2> cones;        // { cosOuterSquared, sinInverse } per light
+        std::vector<FLightManager::Instance> instances;
+        std::vector<FroxelEntry> froxels;
+        std::vector<RecordBufferType> records;
+    };
+    AssignmentCache mAssignmentCache;
 };
 
 } // namespace filament
@@ -19,6 +19,8 @@
 
 #include "Bimap.h"
 
+#include "details/DebugRegistry.h"
+
 #include <backend/DriverApiForward.h>
 #include <backend/DriverEnums.h>
 #include <backend/Handle.h>
@@ -59,24 +61,34 @@ public:
 
     void destroy(backend::DriverApi& driver, Handle handle) noexcept;
 
+    // binds the cache hit/miss telemetry counters, see FEngine::init()
+    void setCounters(FDebugRegistry::Counter* hits, FDebugRegistry::Counter* misses) noexcept {
+        mCacheHits = hits;
+        mCacheMisses = misses;
+    }
+
 private:
-    struct Key { // 24 bytes
+    struct Key { // 32 bytes
         // The key should not be copyable, unfortunately due to how the Bimap works we have
         // to copy-construct it once.
         Key(Key const&) = default;
         Key& operator=(Key const&) = delete;
         Key& operator=(Key&&) noexcept = delete;
-        explicit Key(Parameters const& params) : params(params), refs(1) { }
+        explicit Key(Parameters const& params)
+                : params(params), hash(params.hash()), refs(1) { }
         Parameters params;
+        size_t hash;            // 8 bytes, computed once at construction
         mutable uint32_t refs;  // 4 bytes
         bool operator==(Key const& rhs) const noexcept {
             return params == rhs.params;
         }
     };
 
+    // returns the hash cached in the key, so probing the open-addressed table never
+    // re-hashes the full parameter struct (once per create() instead of once per probe)
     struct KeyHasher {
         size_t operator()(Key const& p) const noexcept {
-            return p.params.hash();
+            return p.hash;
         }
     };
 
@@ -106,6 +118,10 @@ private:
             utils::AreaPolicy::HeapArea>;
 
 
+    // creation-path telemetry, may be null
+    FDebugRegistry::Counter* mCacheHits = nullptr;
+    FDebugRegistry::Counter* mCacheMisses = nullptr;
+
     // Arena where the set memory is allocated
     PoolAllocatorArena mArena;
 
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HwProgramFactory.h"
+
+#include <backend/DriverApiForward.h>
+#include <backend/Handle.h>
+#include <backend/Program.h>
+
+#include <private/backend/DriverApi.h>
+
+#include <utils/compiler.h>
+#include <utils/debug.h>
+#include <utils/Hash.h>
+
+#include <utility>
+
+#include <stdint.h>
+
+namespace filament {
+
+using namespace utils;
+using namespace backend;
+
+size_t HwProgramFactory::Parameters::hash() const noexcept {
+    return hash::combine(size_t(cacheId),
+            hash::combine(size_t(specConstantsHash), size_t(variant)));
+}
+
+bool operator==(HwProgramFactory::Parameters const& lhs,
+        HwProgramFactory::Parameters const& rhs) noexcept {
+    return lhs.cacheId == rhs.cacheId &&
+           lhs.specConstantsHash == rhs.specConstantsHash &&
+           lhs.variant == rhs.variant;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+HwProgramFactory::HwProgramFactory()
+        : mArena("HwProgramFactory::mArena", SET_ARENA_SIZE),
+          mBimap(mArena) {
+    mBimap.reserve(256);
+}
+
+HwProgramFactory::~HwProgramFactory() noexcept = default;
+
+void HwProgramFactory::terminate(DriverApi&) noexcept {
+    assert_invariant(mBimap.empty());
+}
+
+auto HwProgramFactory::create(DriverApi& driver,
+        Parameters const& params, Program&& program) noexcept -> Handle {
+
+    // see if we have already created this program
+    Key const key(params);
+    auto pos = mBimap.find(key);
+
+    // the common case is that we've never seen it (i.e.: no reuse)
+    if (UTILS_LIKELY(pos == mBimap.end())) {
+        auto handle = driver.createProgram(std::move(program));
+        mBimap.insert(key, { handle });
+        return handle;
+    }
+
+    ++(pos->first.pKey->refs);
+
+    return pos->second.handle;
+}
+
+void HwProgramFactory::destroy(DriverApi& driver, Handle handle) noexcept {
+    // look for this handle in our map
+    auto pos = mBimap.find(Value{ handle });
+    if (--pos->second.pKey->refs == 0) {
+        mBimap.erase(pos);
+        driver.destroyProgram(handle);
+    }
+}
+
+} // namespace filament
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_HWPROGRAMFACTORY_H
+#define TNT_FILAMENT_HWPROGRAMFACTORY_H
+
+#include "Bimap.h"
+
+#include <backend/DriverApiForward.h>
+#include <backend/Handle.h>
+#include <backend/Program.h>
+
+#include <private/filament/Variant.h>
+
+#include <utils/Allocator.h>
+
+#include <functional>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+class FEngine;
+
+/*
+ * Deduplicates backend programs across materials built from the same package. Two FMaterials
+ * created from identical .filamat data produce byte-identical shaders for a given variant, so
+ * they can share a single HwProgram. Programs are keyed by the package's cache id (computed by
+ * matc over the material definition), the variant, and the specialization constant values,
+ * and are refcounted so they're only destroyed with their last material.
+ */
+class HwProgramFactory {
+public:
+    using Handle = backend::ProgramHandle;
+
+    HwProgramFactory();
+    ~HwProgramFactory() noexcept;
+
+    HwProgramFactory(HwProgramFactory const& rhs) = delete;
+    HwProgramFactory(HwProgramFactory&& rhs) noexcept = delete;
+    HwProgramFactory& operator=(HwProgramFactory const& rhs) = delete;
+    HwProgramFactory& operator=(HwProgramFactory&& rhs) noexcept = delete;
+
+    void terminate(backend::DriverApi& driver) noexcept;
+
+    struct Parameters { // 16 bytes
+        uint64_t cacheId;               // hash of the material package
+        uint32_t specConstantsHash;     // hash of the specialization constant values
+        Variant::type_t variant;        // variant within the package
+        size_t hash() const noexcept;
+    };
+
+    friend bool operator==(Parameters const& lhs, Parameters const& rhs) noexcept;
+
+    // returns the program for these parameters, creating it from `program` only if it
+    // doesn't exist yet (in which case `program` is consumed)
+    Handle create(backend::DriverApi& driver,
+            Parameters const& params, backend::Program&& program) noexcept;
+
+    void destroy(backend::DriverApi& driver, Handle handle) noexcept;
+
+private:
+    struct Key { // 20 bytes
+        // The key should not be copyable, unfortunately due to how the Bimap works we have
+        // to copy-construct it once.
+        Key(Key const&) = default;
+        Key& operator=(Key const&) = delete;
+        Key& operator=(Key&&) noexcept = delete;
+        explicit Key(Parameters const& params) : params(params), refs(1) { }
+        Parameters params;
+        mutable uint32_t refs;  // 4 bytes
+        bool operator==(Key const& rhs) const noexcept {
+            return params == rhs.params;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(Key const& p) const noexcept {
+            return p.params.hash();
+        }
+    };
+
+    struct Value { // 4 bytes
+        Handle handle;
+    };
+
+    struct ValueHasher {
+        size_t operator()(Value const v) const noexcept {
+            return std::hash<Handle::HandleId>()(v.handle.getId());
+        }
+    };
+
+    friend bool operator==(Value const lhs, Value const rhs) noexcept {
+        return lhs.handle == rhs.handle;
+    }
+
+    // Size of the arena used for the "set" part of the bimap
+    // about ~1K entries before fall back to heap
+    static constexpr size_t SET_ARENA_SIZE = 24 * 1024;
+
+    // Arena for the set<>, using a pool allocator inside a heap area.
+    using PoolAllocatorArena = utils::Arena<
+            utils::PoolAllocatorWithFallback<sizeof(Key)>,
+            utils::LockingPolicy::NoLock,
+            utils::TrackingPolicy::Untracked,
+            utils::AreaPolicy::HeapArea>;
+
+
+    // Arena where the set memory is allocated
+    PoolAllocatorArena mArena;
+
+    // The special Bimap
+    Bimap<Key, Value, KeyHasher, ValueHasher,
+            utils::STLAllocator<Key, PoolAllocatorArena>> mBimap;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_HWPROGRAMFACTORY_H
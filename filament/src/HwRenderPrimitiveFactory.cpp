@@ -71,11 +71,17 @@ auto HwRenderPrimitiveFactory::create(DriverApi& driver,
 
     // the common case is that we've never seen it (i.e.: no reuse)
     if (UTILS_LIKELY(pos == mBimap.end())) {
+        if (mCacheMisses) {
+            mCacheMisses->increment();
+        }
         auto handle = driver.createRenderPrimitive(vbh, ibh, type);
         mBimap.insert(key, { handle });
         return handle;
     }
 
+    if (mCacheHits) {
+        mCacheHits->increment();
+    }
     ++(pos->first.pKey->refs);
     return pos->second.handle;
 }
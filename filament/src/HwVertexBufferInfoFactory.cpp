@@ -70,6 +70,9 @@ auto HwVertexBufferInfoFactory::create(DriverApi& driver,
 
     // the common case is that we've never seen it (i.e.: no reuse)
     if (UTILS_LIKELY(pos == mBimap.end())) {
+        if (mCacheMisses) {
+            mCacheMisses->increment();
+        }
         auto handle = driver.createVertexBufferInfo(
                 bufferCount, attributeCount,
                 attributes);
@@ -77,6 +80,9 @@ auto HwVertexBufferInfoFactory::create(DriverApi& driver,
         return handle;
     }
 
+    if (mCacheHits) {
+        mCacheHits->increment();
+    }
     ++(pos->first.pKey->refs);
     return pos->second.handle;
 }
@@ -34,6 +34,10 @@ bool LightManager::empty() const noexcept {
     return downcast(this)->empty();
 }
 
+void LightManager::reserve(size_t const n) noexcept {
+    downcast(this)->reserve(n);
+}
+
 Entity LightManager::getEntity(Instance const i) const noexcept {
     return downcast(this)->getEntity(i);
 }
@@ -15,6 +15,8 @@
  */
 
 #include "details/Material.h"
+#include "details/RenderTarget.h"
+#include "details/VertexBuffer.h"
 
 #include <filament/Material.h>
 #include <filament/MaterialEnums.h>
@@ -142,6 +144,10 @@ bool Material::hasParameter(const char* name) const noexcept {
     return downcast(this)->hasParameter(name);
 }
 
+bool Material::hasConstant(const char* name) const noexcept {
+    return downcast(this)->hasConstant(name);
+}
+
 bool Material::isSampler(const char* name) const noexcept {
     return downcast(this)->isSampler(name);
 }
@@ -159,9 +165,19 @@ void Material::compile(CompilerPriorityQueue const priority, UserVariantFilterMa
     downcast(this)->compile(priority, variants, handler, std::move(callback));
 }
 
+void Material::precompilePipelines(RenderTarget* const renderTarget,
+        VertexBuffer* const vertexBuffer, UserVariantFilterMask const variants) noexcept {
+    downcast(this)->precompilePipelines(downcast(renderTarget), downcast(vertexBuffer),
+            variants);
+}
+
 UserVariantFilterMask Material::getSupportedVariants() const noexcept {
     return downcast(this)->getSupportedVariants();
 }
 
+void Material::setShadowSamplingQuality(Builder::ShadowSamplingQuality const quality) noexcept {
+    downcast(this)->setShadowSamplingQuality(quality);
+}
+
 
 } // namespace filament
@@ -75,8 +75,8 @@ constexpr std::pair<ChunkType, ChunkType> shaderLanguageToTags(ShaderLanguage co
 
 MaterialParser::MaterialParserDetails::MaterialParserDetails(
         FixedCapacityVector<ShaderLanguage> preferredLanguages, const void* data,
-        size_t const size)
-    : mManagedBuffer(data, size),
+        size_t const size, bool const copyData)
+    : mManagedBuffer(data, size, copyData),
       mChunkContainer(mManagedBuffer.data(), mManagedBuffer.size()),
       mPreferredLanguages(std::move(preferredLanguages)),
       mMaterialChunk(mChunkContainer) {
@@ -95,13 +95,20 @@ bool MaterialParser::MaterialParserDetails::getFromSimpleChunk(
     return false;
 }
 
-MaterialParser::MaterialParserDetails::ManagedBuffer::ManagedBuffer(const void* start, size_t const size)
-        : mStart(malloc(size)), mSize(size) {
-    memcpy(mStart, start, size);
+MaterialParser::MaterialParserDetails::ManagedBuffer::ManagedBuffer(const void* start,
+        size_t const size, bool const copyData)
+        : mStart(copyData ? malloc(size) : const_cast<void*>(start)),
+          mSize(size),
+          mOwned(copyData) {
+    if (copyData) {
+        memcpy(mStart, start, size);
+    }
 }
 
 MaterialParser::MaterialParserDetails::ManagedBuffer::~ManagedBuffer() noexcept {
-    free(mStart);
+    if (mOwned) {
+        free(mStart);
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -115,8 +122,8 @@ bool MaterialParser::get(typename T::Container* container) const noexcept {
 }
 
 MaterialParser::MaterialParser(FixedCapacityVector<ShaderLanguage> preferredLanguages,
-        const void* data, size_t const size)
-    : mImpl(std::move(preferredLanguages), data, size) {
+        const void* data, size_t const size, bool const copyData)
+    : mImpl(std::move(preferredLanguages), data, size, copyData) {
 }
 
 ChunkContainer& MaterialParser::getChunkContainer() noexcept {
@@ -151,13 +158,14 @@ MaterialParser::ParseResult MaterialParser::parse() noexcept {
     }
 
     const auto [chosenLanguage, matTag, dictTag] = result.value();
-    if (UTILS_UNLIKELY(!DictionaryReader::unflatten(cc, dictTag, mImpl.mBlobDictionary))) {
-        return ParseResult::ERROR_OTHER;
-    }
     if (UTILS_UNLIKELY(!mImpl.mMaterialChunk.initialize(matTag))) {
         return ParseResult::ERROR_OTHER;
     }
 
+    // Defer unflattening the dictionary (which decompresses every shader blob into the heap)
+    // until a shader is actually requested; parsing stays cheap for materials that are
+    // loaded but not used yet.
+    mImpl.mDictionaryTag = dictTag;
     mImpl.mChosenLanguage = chosenLanguage;
     return ParseResult::SUCCESS;
 }
@@ -391,8 +399,19 @@ bool MaterialParser::getReflectionMode(ReflectionMode* value) const noexcept {
     return mImpl.getFromSimpleChunk(MaterialReflectionMode, (uint8_t*)value);
 }
 
+bool MaterialParser::ensureShaderDictionary() noexcept {
+    std::call_once(mImpl.mDictionaryOnce, [this] {
+        mImpl.mDictionaryOk = DictionaryReader::unflatten(getChunkContainer(),
+                mImpl.mDictionaryTag, mImpl.mBlobDictionary);
+    });
+    return mImpl.mDictionaryOk;
+}
+
 bool MaterialParser::getShader(ShaderContent& shader,
         ShaderModel const shaderModel, Variant const variant, ShaderStage const stage) noexcept {
+    if (UTILS_UNLIKELY(!ensureShaderDictionary())) {
+        return false;
+    }
     return mImpl.mMaterialChunk.getShader(shader,
             mImpl.mBlobDictionary, shaderModel, variant, stage);
 }
@@ -32,6 +32,7 @@
 #include <utils/FixedCapacityVector.h>
 
 #include <array>
+#include <mutex>
 #include <tuple>
 #include <utility>
 
@@ -53,8 +54,10 @@ struct MaterialPushConstant;
 
 class MaterialParser {
 public:
+    // When copyData is false the caller guarantees that [data, data + size) outlives the
+    // parser (e.g. a resgen package linked into the binary); no private copy is made.
     MaterialParser(utils::FixedCapacityVector<backend::ShaderLanguage> preferredLanguages,
-            const void* data, size_t size);
+            const void* data, size_t size, bool copyData = true);
 
     MaterialParser(MaterialParser const& rhs) noexcept = delete;
     MaterialParser& operator=(MaterialParser const& rhs) noexcept = delete;
@@ -130,6 +133,11 @@ public:
     bool getShader(filaflat::ShaderContent& shader, backend::ShaderModel shaderModel,
             Variant variant, backend::ShaderStage stage) noexcept;
 
+    // Decodes the shader dictionary if it hasn't been already. getShader() calls this implicitly;
+    // calling it ahead of time (possibly from another thread, e.g. a JobSystem worker) moves the
+    // decompression cost off the first draw. Thread-safe and idempotent.
+    bool ensureShaderDictionary() noexcept;
+
     bool hasShader(backend::ShaderModel const model,
             Variant const variant, backend::ShaderStage const stage) const noexcept {
         return getMaterialChunk().hasShader(model, variant, stage);
@@ -147,7 +155,7 @@ private:
     struct MaterialParserDetails {
         MaterialParserDetails(
                 utils::FixedCapacityVector<backend::ShaderLanguage> preferredLanguages,
-                const void* data, size_t size);
+                const void* data, size_t size, bool copyData);
 
         template<typename T>
         bool getFromSimpleChunk(filamat::ChunkType type, T* value) const noexcept;
@@ -158,8 +166,11 @@ private:
         class ManagedBuffer {
             void* mStart = nullptr;
             size_t mSize = 0;
+            bool mOwned = true;
         public:
-            explicit ManagedBuffer(const void* start, size_t size);
+            // With copyData set, makes a private copy of [start, start + size); otherwise
+            // references the caller's bytes in place (the buffer is only ever read from).
+            ManagedBuffer(const void* start, size_t size, bool copyData);
             ~ManagedBuffer() noexcept;
             ManagedBuffer(ManagedBuffer const& rhs) = delete;
             ManagedBuffer& operator=(ManagedBuffer const& rhs) = delete;
@@ -176,7 +187,13 @@ private:
 
         // Keep MaterialChunk alive between calls to getShader to avoid reload the shader index.
         filaflat::MaterialChunk mMaterialChunk;
+        // The dictionary is unflattened (and decompressed) lazily on the first getShader()
+        // call, so that parsing a package doesn't pay for shaders that are never used.
+        // ensureShaderDictionary() can also run this eagerly from a worker thread.
         filaflat::BlobDictionary mBlobDictionary;
+        filamat::ChunkType mDictionaryTag = filamat::ChunkType::Unknown;
+        std::once_flag mDictionaryOnce;
+        bool mDictionaryOk = false;
     };
 
     filaflat::ChunkContainer& getChunkContainer() noexcept;
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryMonitor.h"
+
+#include <filament/DebugRegistry.h>
+
+#include <utils/compiler.h>
+
+#include <stdint.h>
+
+namespace filament {
+
+void MemoryMonitor::init(FDebugRegistry& debugRegistry) noexcept {
+    mCounters[size_t(Category::TEXTURES)] = debugRegistry.registerCounter(
+            "d.memory.texture_bytes", DebugRegistry::CounterType::UINT64);
+    mCounters[size_t(Category::BUFFERS)] = debugRegistry.registerCounter(
+            "d.memory.buffer_bytes", DebugRegistry::CounterType::UINT64);
+    mCounters[size_t(Category::TRANSIENTS)] = debugRegistry.registerCounter(
+            "d.memory.transient_bytes", DebugRegistry::CounterType::UINT64);
+}
+
+uint64_t MemoryMonitor::getTotalBytes() const noexcept {
+    uint64_t total = 0;
+    for (auto const& bytes : mCategoryBytes) {
+        total += bytes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void MemoryMonitor::update() noexcept {
+    uint64_t const budget = mBudget.load(std::memory_order_relaxed);
+    if (UTILS_LIKELY(!budget || !mCallback)) {
+        mOverBudget = false;
+        return;
+    }
+    uint64_t const used = getTotalBytes();
+    if (!mOverBudget && used > budget) {
+        // rising edge: notify once, then wait for usage to drop before re-arming
+        mOverBudget = true;
+        mCallback(mUser, used, budget);
+    } else if (mOverBudget && used < budget - budget / 8) {
+        // re-arm with ~12% hysteresis so an eviction hovering around the budget
+        // doesn't trigger a callback storm
+        mOverBudget = false;
+    }
+}
+
+} // namespace filament
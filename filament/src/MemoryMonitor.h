@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_MEMORYMONITOR_H
+#define TNT_FILAMENT_MEMORYMONITOR_H
+
+#include "details/DebugRegistry.h"
+
+#include <filament/Engine.h>
+
+#include <array>
+#include <atomic>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+/**
+ * Aggregates estimated GPU memory usage per category, so applications get visibility into
+ * VRAM pressure before the OS takes action. Byte counts are estimates computed engine-side
+ * from resource dimensions and formats at creation time; they are published through the
+ * counter registry ("d.memory.*_bytes"). An optional budget with a pressure callback lets
+ * a streaming system start evicting when usage crosses the budget (see
+ * Engine::setMemoryBudget()); the callback re-arms once usage drops measurably below it.
+ *
+ * track()/release() are thread-safe; update() runs once per frame on the main thread.
+ */
+class MemoryMonitor {
+public:
+    enum class Category : uint8_t {
+        TEXTURES,       // textures created through Texture::Builder
+        BUFFERS,        // buffer and index buffer objects
+        TRANSIENTS,     // frame graph transients, in-flight or cached (ResourceAllocator)
+    };
+    static constexpr size_t CATEGORY_COUNT = 3;
+
+    // registers the per-category counters with the debug registry
+    void init(FDebugRegistry& debugRegistry) noexcept;
+
+    void track(Category const category, size_t const bytes) noexcept {
+        uint64_t const total = mCategoryBytes[size_t(category)].fetch_add(bytes,
+                std::memory_order_relaxed) + bytes;
+        publish(category, total);
+    }
+
+    void release(Category const category, size_t const bytes) noexcept {
+        uint64_t const total = mCategoryBytes[size_t(category)].fetch_sub(bytes,
+                std::memory_order_relaxed) - bytes;
+        publish(category, total);
+    }
+
+    uint64_t getCategoryBytes(Category const category) const noexcept {
+        return mCategoryBytes[size_t(category)].load(std::memory_order_relaxed);
+    }
+
+    uint64_t getTotalBytes() const noexcept;
+
+    void setBudget(uint64_t const budgetBytes) noexcept {
+        mBudget.store(budgetBytes, std::memory_order_relaxed);
+    }
+
+    void setCallback(Engine::MemoryPressureCallback const callback, void* const user) noexcept {
+        mCallback = callback;
+        mUser = user;
+    }
+
+    // evaluates the budget watermark, called once per frame on the main thread
+    void update() noexcept;
+
+private:
+    void publish(Category const category, uint64_t const total) noexcept {
+        if (auto* const counter = mCounters[size_t(category)]) {
+            counter->set(total);
+        }
+    }
+
+    std::array<std::atomic<uint64_t>, CATEGORY_COUNT> mCategoryBytes{};
+    std::array<FDebugRegistry::Counter*, CATEGORY_COUNT> mCounters{};
+    std::atomic<uint64_t> mBudget{ 0 };
+    Engine::MemoryPressureCallback mCallback = nullptr;
+    void* mUser = nullptr;
+    bool mOverBudget = false;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_MEMORYMONITOR_H
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OcclusionCuller.h"
+
+#include "fg/FrameGraph.h"
+#include "fg/FrameGraphResources.h"
+
+#include <backend/DriverEnums.h>
+#include <backend/PixelBufferDescriptor.h>
+
+#include <private/backend/DriverApi.h>
+
+#include <utils/compiler.h>
+#include <utils/debug.h>
+
+#include <math/mat4.h>
+#include <math/vec2.h>
+#include <math/vec4.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+using namespace math;
+using namespace backend;
+
+OcclusionCuller::OcclusionCuller() noexcept = default;
+
+OcclusionCuller::~OcclusionCuller() noexcept {
+    // terminate() must be called before we're destroyed
+    assert_invariant(!mInflight);
+}
+
+void OcclusionCuller::terminate() noexcept {
+    if (mInflight) {
+        // the backend still owns the buffer; the callback will free it
+        mInflight->owner = nullptr;
+        mInflight = nullptr;
+    }
+    mSnapshot.valid = false;
+}
+
+void OcclusionCuller::readbackCompleted(void*, size_t, void* user) {
+    // buffer descriptor callbacks are always dispatched on the main thread
+    Readback* const readback = static_cast<Readback*>(user);
+    OcclusionCuller* const culler = readback->owner;
+    if (UTILS_UNLIKELY(!culler)) {
+        // the culler was terminated while this readback was in flight
+        delete readback;
+        return;
+    }
+    culler->mInflight = nullptr;
+    Snapshot& snapshot = culler->mSnapshot;
+    std::swap(snapshot.data, readback->data);
+    snapshot.viewProjection = readback->viewProjection;
+    snapshot.width = readback->width;
+    snapshot.height = readback->height;
+    snapshot.valid = true;
+    culler->mSpare.reset(readback);
+}
+
+void OcclusionCuller::readback(FrameGraph& fg, FrameGraphId<FrameGraphTexture> const hiz,
+        mat4 const& viewProjection, mat4 const& worldTransform) noexcept {
+    if (mInflight) {
+        // the previous readback hasn't completed yet, keep using the current snapshot
+        return;
+    }
+
+    auto const& desc = fg.getDescriptor(hiz);
+
+    // read back the coarsest level no larger than 64x64 texels (16 KiB), which bounds both
+    // the GPU to CPU transfer and the cost of the footprint scan in isVisible()
+    uint8_t level = 0;
+    while (level + 1u < desc.levels &&
+            (std::max(1u, desc.width >> level) > 64u ||
+             std::max(1u, desc.height >> level) > 64u)) {
+        level++;
+    }
+    uint32_t const width = std::max(1u, desc.width >> level);
+    uint32_t const height = std::max(1u, desc.height >> level);
+
+    std::unique_ptr<Readback> readback = std::move(mSpare);
+    if (!readback) {
+        readback = std::make_unique<Readback>();
+    }
+    readback->owner = this;
+    readback->data.resize(size_t(width) * height);
+    // the scene was prepared with worldTransform applied, store the snapshot matrix in
+    // absolute world space so prepare() can re-apply the transform of a later frame
+    readback->viewProjection = viewProjection * worldTransform;
+    readback->width = width;
+    readback->height = height;
+
+    struct ReadbackPassData {
+        FrameGraphId<FrameGraphTexture> hiz;
+    };
+
+    fg.addPass<ReadbackPassData>("Hi-Z Readback",
+            [&, level](FrameGraph::Builder& builder, auto& data) {
+                data.hiz = builder.createSubresource(hiz, "Hi-Z coarse level", {
+                        .level = level
+                });
+                data.hiz = builder.read(data.hiz, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                builder.declareRenderPass("Hi-Z Readback Target", {
+                        .attachments = { .color = { data.hiz }}
+                });
+                builder.sideEffect();
+            },
+            [this, width, height, readback = readback.release()](
+                    FrameGraphResources const& resources, auto const&, DriverApi& driver) {
+                auto const out = resources.getRenderPassInfo();
+                mInflight = readback;
+                PixelBufferDescriptor buffer(readback->data.data(),
+                        readback->data.size() * sizeof(float),
+                        PixelDataFormat::R, PixelDataType::FLOAT,
+                        &readbackCompleted, readback);
+                driver.readPixels(out.target, 0, 0, width, height, std::move(buffer));
+            });
+}
+
+void OcclusionCuller::prepare(mat4 const& worldTransform) noexcept {
+    if (mSnapshot.valid) {
+        mCullingViewProjection = mat4f{ mSnapshot.viewProjection * inverse(worldTransform) };
+    }
+}
+
+bool OcclusionCuller::isVisible(float3 const& center, float3 const& extent) const noexcept {
+    Snapshot const& s = mSnapshot;
+    if (UTILS_UNLIKELY(!s.valid)) {
+        return true;
+    }
+
+    // project the 8 corners of the AABB; bail out conservatively if any corner lies on or
+    // behind the near plane
+    float2 uvMin = { 1.0f, 1.0f };
+    float2 uvMax = { 0.0f, 0.0f };
+    float boxDepth = 1.0f;
+    for (size_t i = 0; i < 8; i++) {
+        float3 const corner{
+                center.x + ((i & 1) ? extent.x : -extent.x),
+                center.y + ((i & 2) ? extent.y : -extent.y),
+                center.z + ((i & 4) ? extent.z : -extent.z) };
+        float4 const p = mCullingViewProjection * float4{ corner, 1.0f };
+        if (p.w <= 0.0f) {
+            return true;
+        }
+        // NDC to viewport transform; the depth buffer stores z in [0, 1] on all backends
+        float3 const ndc = p.xyz * (1.0f / p.w);
+        uvMin = min(uvMin, ndc.xy * 0.5f + 0.5f);
+        uvMax = max(uvMax, ndc.xy * 0.5f + 0.5f);
+        boxDepth = std::min(boxDepth, ndc.z * 0.5f + 0.5f);
+    }
+
+    if (uvMax.x <= 0.0f || uvMax.y <= 0.0f || uvMin.x >= 1.0f || uvMin.y >= 1.0f) {
+        // entirely off-screen; frustum culling owns this case, don't second-guess it here
+        return true;
+    }
+
+    // dilate the footprint by one texel to cover the screen-space error introduced by the
+    // snapshot being (at least) one frame old
+    int32_t const x0 = std::max(0, int32_t(uvMin.x * float(s.width)) - 1);
+    int32_t const y0 = std::max(0, int32_t(uvMin.y * float(s.height)) - 1);
+    int32_t const x1 = std::min(int32_t(s.width) - 1, int32_t(uvMax.x * float(s.width)) + 1);
+    int32_t const y1 = std::min(int32_t(s.height) - 1, int32_t(uvMax.y * float(s.height)) + 1);
+
+    // the box is occluded only if its closest point is farther than the farthest occluder
+    // over its whole footprint
+    float const* const UTILS_RESTRICT data = s.data.data();
+    for (int32_t y = y0; y <= y1; y++) {
+        for (int32_t x = x0; x <= x1; x++) {
+            if (boxDepth <= data[y * int32_t(s.width) + x]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace filament
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_DETAILS_OCCLUSIONCULLER_H
+#define TNT_FILAMENT_DETAILS_OCCLUSIONCULLER_H
+
+#include "fg/FrameGraphId.h"
+#include "fg/FrameGraphTexture.h"
+
+#include <math/mat4.h>
+#include <math/vec3.h>
+
+#include <memory>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+class FrameGraph;
+
+/*
+ * OcclusionCuller implements a two-phase occlusion culling scheme:
+ *  - during rendering, the coarsest useful level of the Hi-Z pyramid built by
+ *    PostProcessManager::hiZ() is read back asynchronously (the data is typically
+ *    available one or two frames later),
+ *  - during FView::prepare(), renderable bounds that passed frustum culling are tested
+ *    against that snapshot, and occluded ones have their VISIBLE_RENDERABLE bit cleared
+ *    before RenderPass command generation consumes the visibility masks.
+ *
+ * The backend has no compute dispatch, so the bounds test runs on the CPU; the snapshot
+ * is small (64x64 at most), which keeps both the readback and the footprint scan cheap.
+ * The test is conservative: anything we're not sure about -- no data yet, bounds crossing
+ * the near plane, off-screen footprint -- is treated as visible, and the snapshot holds
+ * the farthest depth of each texel's footprint (see hizMipmap.mat).
+ */
+class OcclusionCuller {
+public:
+    OcclusionCuller() noexcept;
+    ~OcclusionCuller() noexcept;
+
+    // must be called before this object is destroyed; an in-flight readback keeps its
+    // buffer alive until the backend releases it
+    void terminate() noexcept;
+
+    /*
+     * Adds a pass that reads back the coarsest useful level of the Hi-Z pyramid.
+     * viewProjection is the matrix the depth buffer is rendered with (i.e. the culling
+     * frustum's) and worldTransform the world-origin transform the scene was prepared
+     * with, so the snapshot can be interpreted in absolute world space later, even if the
+     * origin moves between frames (e.g. with d.view.camera_at_origin).
+     */
+    void readback(FrameGraph& fg, FrameGraphId<FrameGraphTexture> hiz,
+            math::mat4 const& viewProjection, math::mat4 const& worldTransform) noexcept;
+
+    // computes the matrix mapping this frame's world space to the snapshot's clip space.
+    // Must be called before isVisible().
+    void prepare(math::mat4 const& worldTransform) noexcept;
+
+    // conservative visibility test of a world-space AABB against the last snapshot;
+    // returns false only if the box is certainly occluded
+    bool isVisible(math::float3 const& center, math::float3 const& extent) const noexcept;
+
+    bool hasSnapshot() const noexcept { return mSnapshot.valid; }
+
+private:
+    // heap-allocated because ownership is temporarily handed over to the backend while a
+    // readback is in flight (see terminate())
+    struct Readback {
+        OcclusionCuller* owner;         // nulled if the culler is terminated while in flight
+        std::vector<float> data;        // farthest depth per texel
+        math::mat4 viewProjection;      // absolute world space to clip space
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+    static void readbackCompleted(void* buffer, size_t size, void* user);
+
+    struct Snapshot {
+        std::vector<float> data;
+        math::mat4 viewProjection;      // absolute world space to clip space
+        uint32_t width = 0;
+        uint32_t height = 0;
+        bool valid = false;
+    } mSnapshot;
+
+    math::mat4f mCullingViewProjection; // set by prepare() for the current frame
+    Readback* mInflight = nullptr;      // owned by the backend callback
+    std::unique_ptr<Readback> mSpare{}; // recycled to avoid per-frame allocations
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_DETAILS_OCCLUSIONCULLER_H
@@ -307,6 +307,9 @@ static const PostProcessManager::StaticMaterialInfo sMaterialList[] = {
                 { {"arraySampler", false}, {"componentCount", 4} } },
         { "separableGaussianBlur4L",    MATERIAL(MATERIALS, SEPARABLEGAUSSIANBLUR),
                 { {"arraySampler", true }, {"componentCount", 4} } },
+        { "hizMipmap",                  MATERIAL(MATERIALS, HIZMIPMAP) },
+        { "luminance",                  MATERIAL(MATERIALS, LUMINANCE) },
+        { "vsmBlur",                    MATERIAL(MATERIALS, VSMBLUR) },
         { "vsmMipmap",                  MATERIAL(MATERIALS, VSMMIPMAP) },
         { "debugShadowCascades",        MATERIAL(MATERIALS, DEBUGSHADOWCASCADES) },
         { "resolveDepth",               MATERIAL(MATERIALS, RESOLVEDEPTH) },
@@ -323,6 +326,12 @@ void PostProcessManager::init() noexcept {
     //debugRegistry.registerProperty("d.ssao.kernelSize", &engine.debug.ssao.kernelSize);
     //debugRegistry.registerProperty("d.ssao.stddev", &engine.debug.ssao.stddev);
 
+    FDebugRegistry& debugRegistry = engine.getDebugRegistry();
+    debugRegistry.registerProperty("d.taa.filter_width",
+            &engine.debug.taa.filter_width);
+    debugRegistry.registerProperty("d.taa.use_filter_weight_cache",
+            &engine.debug.taa.use_filter_weight_cache);
+
     mFullScreenQuadRph = engine.getFullScreenRenderPrimitive();
     mFullScreenQuadVbih = engine.getFullScreenVertexBuffer()->getVertexBufferInfoHandle();
     mPerRenderableDslh = engine.getPerRenderableDescriptorSetLayout().getHandle();
@@ -581,6 +590,9 @@ PostProcessManager::StructurePassOutput PostProcessManager::structure(FrameGraph
                             .attachments = { .depth = out }
                     });
                 }
+                // the mip chain only depends on the structure buffer, it can overlap
+                // e.g. shadow map rasterization on backends with an async compute queue
+                builder.queueAffinity(FrameGraph::QueueAffinity::COMPUTE);
             },
             [=](FrameGraphResources const& resources, auto const& data, DriverApi& driver) {
                 bindPostProcessDescriptorSet(driver);
@@ -611,6 +623,71 @@ PostProcessManager::StructurePassOutput PostProcessManager::structure(FrameGraph
 
 // ------------------------------------------------------------------------------------------------
 
+FrameGraphId<FrameGraphTexture> PostProcessManager::hiZ(FrameGraph& fg,
+        FrameGraphId<FrameGraphTexture> const depth) noexcept {
+
+    auto const& depthDesc = fg.getDescriptor(depth);
+
+    // The base level is already a conservative 2x2 reduction of the depth buffer, and the
+    // pyramid doesn't need to go below ~16 pixels (which is where the -4 comes from).
+    uint32_t const width = std::max(1u, depthDesc.width / 2u);
+    uint32_t const height = std::max(1u, depthDesc.height / 2u);
+    size_t const levelCount = std::max(1, FTexture::maxLevelCount(width, height) - 4);
+
+    struct HiZPassData {
+        FrameGraphId<FrameGraphTexture> depth;
+        FrameGraphId<FrameGraphTexture> hiz;
+    };
+
+    auto const& hiZPass = fg.addPass<HiZPassData>("Hi-Z Pyramid",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.depth = builder.sample(depth);
+                data.hiz = builder.createTexture("Hi-Z Buffer", {
+                        .width = width, .height = height,
+                        .levels = uint8_t(levelCount),
+                        .format = TextureFormat::R32F });
+                data.hiz = builder.sample(data.hiz);
+                for (size_t i = 0; i < levelCount; i++) {
+                    auto out = builder.createSubresource(data.hiz, "Hi-Z mip", {
+                            .level = uint8_t(i)
+                    });
+                    out = builder.write(out, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                    builder.declareRenderPass("Hi-Z mip target", {
+                            .attachments = { .color = { out }}
+                    });
+                }
+            },
+            [=](FrameGraphResources const& resources, auto const& data, DriverApi& driver) {
+                bindPostProcessDescriptorSet(driver);
+
+                auto const in = resources.getTexture(data.depth);
+                auto const hiz = resources.getTexture(data.hiz);
+                auto& material = getPostProcessMaterial("hizMipmap");
+                FMaterial const* const ma = material.getMaterial(mEngine);
+                auto const pipeline = getPipelineState(ma);
+
+                FMaterialInstance* const mi = PostProcessMaterial::getMaterialInstance(ma);
+
+                for (size_t level = 0; level < levelCount; level++) {
+                    auto const out = resources.getRenderPassInfo(level);
+                    // level 0 reduces the full resolution depth buffer, each subsequent
+                    // level reduces the previous one
+                    auto th = driver.createTextureView(level == 0 ? in : hiz,
+                            level == 0 ? 0 : level - 1, 1);
+                    mi->setParameter("depth", th, {
+                            .filterMin = SamplerMinFilter::NEAREST_MIPMAP_NEAREST });
+                    mi->commit(driver);
+                    mi->use(driver);
+                    renderFullScreenQuad(out, pipeline, driver);
+                    driver.destroyTexture(th);
+                }
+            });
+
+    return hiZPass->hiz;
+}
+
+// ------------------------------------------------------------------------------------------------
+
 FrameGraphId<FrameGraphTexture> PostProcessManager::ssr(FrameGraph& fg,
         RenderPassBuilder const& passBuilder,
         FrameHistory const& frameHistory,
@@ -674,6 +751,7 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::ssr(FrameGraph& fg,
             },
             [this, projection = cameraInfo.projection,
                     userViewMatrix = cameraInfo.getUserViewMatrix(), uvFromClipMatrix, historyProjection,
+                    frameId = frameHistory.getPrevious().ssr.frameId + 1,
                     options, passBuilder = passBuilder]
             (FrameGraphResources const& resources, auto const& data, DriverApi& driver) mutable {
                 // set structure sampler
@@ -688,7 +766,8 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::ssr(FrameGraph& fg,
                 // the history sampler is a regular texture2D
                 TextureHandle const history = data.history ?
                         resources.getTexture(data.history) : getZeroTexture();
-                mSsrPassDescriptorSet.prepareHistorySSR(mEngine, history, reprojection, uvFromViewMatrix, options);
+                mSsrPassDescriptorSet.prepareHistorySSR(mEngine, history, reprojection,
+                        uvFromViewMatrix, options, frameId);
 
                 mSsrPassDescriptorSet.commit(mEngine);
 
@@ -856,6 +935,10 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::screenSpaceAmbientOcclusion(
                         .clearColor = { 1.0f },
                         .clearFlags = TargetBufferFlags::COLOR0 | TargetBufferFlags::COLOR1
                 });
+
+                // SSAO only depends on the structure buffer, it can overlap shadow map
+                // rasterization on backends with an async compute queue
+                builder.queueAffinity(FrameGraph::QueueAffinity::COMPUTE);
             },
             [=](FrameGraphResources const& resources, auto const& data, DriverApi& driver) {
                 bindPostProcessDescriptorSet(driver);
@@ -1103,18 +1186,19 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::generateGaussianMipmap(Frame
     auto const subResourceDesc = fg.getSubResourceDescriptor(input);
 
     // Create one subresource per level to be generated from the input. These will be our
-    // destinations.
+    // destinations. The pass data is allocated from the FrameGraph arena and the level count
+    // is bounded, so an inline array avoids a per-frame heap allocation here.
     struct MipmapPassData {
-        FixedCapacityVector<FrameGraphId<FrameGraphTexture>> out;
+        std::array<FrameGraphId<FrameGraphTexture>, 15> out;    // enough for a 32768 x 32768 texture
     };
     auto const& mipmapPass = fg.addPass<MipmapPassData>("Mipmap Pass",
             [&](FrameGraph::Builder& builder, auto& data) {
-                data.out.reserve(levels - 1);
+                assert_invariant(levels - 1 <= data.out.size());
                 for (size_t i = 1; i < levels; i++) {
-                    data.out.push_back(builder.createSubresource(input,
+                    data.out[i - 1] = builder.createSubresource(input,
                             "Mipmap output", {
                                     .level = uint8_t(subResourceDesc.level + i),
-                                    .layer = subResourceDesc.layer }));
+                                    .layer = subResourceDesc.layer });
                 }
             });
 
@@ -1131,54 +1215,54 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::generateGaussianMipmap(Frame
     return input;
 }
 
+static size_t computeGaussianCoefficients(float2* kernel, size_t const size,
+        size_t const kernelWidth, float const sigma) noexcept {
+    const float alpha = 1.0f / (2.0f * sigma * sigma);
+
+    // number of positive-side samples needed, using linear sampling
+    size_t m = (kernelWidth - 1) / 4 + 1;
+    // clamp to what we have
+    m = std::min(size, m);
+
+    // How the kernel samples are stored:
+    //  *===*---+---+---+---+---+---+
+    //  | 0 | 1 | 2 | 3 | 4 | 5 | 6 |       Gaussian coefficients (right size)
+    //  *===*-------+-------+-------+
+    //  | 0 |   1   |   2   |   3   |       stored coefficients (right side)
+
+    kernel[0].x = 1.0;
+    kernel[0].y = 0.0;
+    float totalWeight = kernel[0].x;
+
+    for (size_t i = 1; i < m; i++) {
+        float const x0 = float(i * 2 - 1);
+        float const x1 = float(i * 2);
+        float const k0 = std::exp(-alpha * x0 * x0);
+        float const k1 = std::exp(-alpha * x1 * x1);
+
+        // k * textureLod(..., o) with bilinear sampling is equivalent to:
+        //      k * (s[0] * (1 - o) + s[1] * o)
+        // solve:
+        //      k0 = k * (1 - o)
+        //      k1 = k * o
+
+        float const k = k0 + k1;
+        float const o = k1 / k;
+        kernel[i].x = k;
+        kernel[i].y = o;
+        totalWeight += (k0 + k1) * 2.0f;
+    }
+    for (size_t i = 0; i < m; i++) {
+        kernel[i].x *= 1.0f / totalWeight;
+    }
+    return m;
+}
+
 FrameGraphId<FrameGraphTexture> PostProcessManager::gaussianBlurPass(FrameGraph& fg,
         FrameGraphId<FrameGraphTexture> const input,
         FrameGraphId<FrameGraphTexture> output,
         bool const reinhard, size_t kernelWidth, const float sigma) noexcept {
 
-    auto computeGaussianCoefficients =
-            [kernelWidth, sigma](float2* kernel, size_t const size) -> size_t {
-        const float alpha = 1.0f / (2.0f * sigma * sigma);
-
-        // number of positive-side samples needed, using linear sampling
-        size_t m = (kernelWidth - 1) / 4 + 1;
-        // clamp to what we have
-        m = std::min(size, m);
-
-        // How the kernel samples are stored:
-        //  *===*---+---+---+---+---+---+
-        //  | 0 | 1 | 2 | 3 | 4 | 5 | 6 |       Gaussian coefficients (right size)
-        //  *===*-------+-------+-------+
-        //  | 0 |   1   |   2   |   3   |       stored coefficients (right side)
-
-        kernel[0].x = 1.0;
-        kernel[0].y = 0.0;
-        float totalWeight = kernel[0].x;
-
-        for (size_t i = 1; i < m; i++) {
-            float const x0 = float(i * 2 - 1);
-            float const x1 = float(i * 2);
-            float const k0 = std::exp(-alpha * x0 * x0);
-            float const k1 = std::exp(-alpha * x1 * x1);
-
-            // k * textureLod(..., o) with bilinear sampling is equivalent to:
-            //      k * (s[0] * (1 - o) + s[1] * o)
-            // solve:
-            //      k0 = k * (1 - o)
-            //      k1 = k * o
-
-            float const k = k0 + k1;
-            float const o = k1 / k;
-            kernel[i].x = k;
-            kernel[i].y = o;
-            totalWeight += (k0 + k1) * 2.0f;
-        }
-        for (size_t i = 0; i < m; i++) {
-            kernel[i].x *= 1.0f / totalWeight;
-        }
-        return m;
-    };
-
     struct BlurPassData {
         FrameGraphId<FrameGraphTexture> in;
         FrameGraphId<FrameGraphTexture> out;
@@ -1264,7 +1348,7 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::gaussianBlurPass(FrameGraph&
 
                 float2 kernel[64];
                 size_t const m = computeGaussianCoefficients(kernel,
-                        std::min(std::size(kernel), kernelStorageSize));
+                        std::min(std::size(kernel), kernelStorageSize), kernelWidth, sigma);
 
                 std::string_view const sourceParameterName = is2dArray ? "sourceArray"sv : "source"sv;
                 // horizontal pass
@@ -1304,6 +1388,130 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::gaussianBlurPass(FrameGraph&
     return blurPass->out;
 }
 
+FrameGraphId<FrameGraphTexture> PostProcessManager::vsmBlurPass(FrameGraph& fg,
+        FrameGraphId<FrameGraphTexture> const input,
+        FrameGraphId<FrameGraphTexture> const output,
+        size_t const kernelWidth, float const sigma) noexcept {
+
+    // The fused filter evaluates the 2D expansion of the separable kernel in a single pass,
+    // trading (2m-1)^2 bilinear taps for the intermediate render-target write+read of the
+    // separable version. This is a win for the small kernels VSM uses; larger kernels should
+    // keep going through gaussianBlurPass().
+    assert_invariant(kernelWidth <= 4 * 3 + 1);
+
+    struct BlurPassData {
+        FrameGraphId<FrameGraphTexture> in;
+        FrameGraphId<FrameGraphTexture> out;
+    };
+
+    auto const& blurPass = fg.addPass<BlurPassData>("VSM Blur Pass (fused)",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.in = builder.sample(input);
+                data.out = builder.declareRenderPass(output);
+            },
+            [=](FrameGraphResources const& resources,
+                    auto const& data, DriverApi& driver) {
+                bindPostProcessDescriptorSet(driver);
+
+                auto const hwOutRT = resources.getRenderPassInfo();
+                auto const hwIn = resources.getTexture(data.in);
+                auto const& inDesc = resources.getDescriptor(data.in);
+
+                auto const& material = getPostProcessMaterial("vsmBlur");
+                FMaterialInstance* const mi = PostProcessMaterial::getMaterialInstance(
+                        mEngine, material);
+
+                float2 kernel[4];
+                size_t const m = computeGaussianCoefficients(kernel,
+                        std::size(kernel), kernelWidth, sigma);
+
+                mi->setParameter("source", hwIn, {
+                        .filterMag = SamplerMagFilter::LINEAR,
+                        .filterMin = SamplerMinFilter::LINEAR
+                });
+                mi->setParameter("axis",
+                        float2{ 1.0f / inDesc.width, 1.0f / inDesc.height });
+                mi->setParameter("count", int32_t(m));
+                mi->setParameter("kernel", kernel, m);
+
+                commitAndRenderFullScreenQuad(driver, hwOutRT, mi);
+            });
+
+    return blurPass->out;
+}
+
+void PostProcessManager::autoExposure(FrameGraph& fg,
+        FrameGraphId<FrameGraphTexture> const input,
+        std::shared_ptr<std::atomic<float>> result) noexcept {
+
+    auto const& inputDesc = fg.getDescriptor(input);
+
+    // quarter resolution is plenty for metering
+    uint32_t const width = std::max(1u, inputDesc.width / 4u);
+    uint32_t const height = std::max(1u, inputDesc.height / 4u);
+    uint8_t const levels = FTexture::maxLevelCount(width, height);
+
+    struct AutoExposureData {
+        FrameGraphId<FrameGraphTexture> input;
+        FrameGraphId<FrameGraphTexture> luminance;
+    };
+
+    fg.addPass<AutoExposureData>("Auto-exposure metering",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.input = builder.sample(input);
+                data.luminance = builder.createTexture("Log-luminance buffer", {
+                        .width = width,
+                        .height = height,
+                        .levels = levels,
+                        .format = TextureFormat::R16F });
+                data.luminance = builder.write(data.luminance,
+                        FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                builder.declareRenderPass("Log-luminance target",
+                        { .attachments = { .color = { data.luminance }}});
+                // nothing consumes the readback, so this pass must not be culled
+                builder.sideEffect();
+            },
+            [=, result = std::move(result)](FrameGraphResources const& resources,
+                    auto const& data, DriverApi& driver) {
+                bindPostProcessDescriptorSet(driver);
+
+                auto const& material = getPostProcessMaterial("luminance");
+                FMaterialInstance* const mi = PostProcessMaterial::getMaterialInstance(
+                        mEngine, material);
+                mi->setParameter("source", resources.getTexture(data.input), {
+                        .filterMag = SamplerMagFilter::LINEAR,
+                        .filterMin = SamplerMinFilter::LINEAR
+                });
+                commitAndRenderFullScreenQuad(driver, resources.getRenderPassInfo(), mi);
+
+                // reduce to 1x1 with the regular mip chain: the average of log2(luminance)
+                // is the log of the geometric mean
+                auto const luminance = resources.getTexture(data.luminance);
+                driver.generateMipmaps(luminance);
+
+                // asynchronously read back the single pixel of the last level; the result
+                // lands in `destination` a few frames from now
+                struct Readback {
+                    std::shared_ptr<std::atomic<float>> destination;
+                    float value;
+                };
+                Readback* const readback = new Readback{ std::move(result), 0.0f };
+                PixelBufferDescriptor pbd(&readback->value, sizeof(float),
+                        PixelDataFormat::R, PixelDataType::FLOAT,
+                        [](void* buffer, size_t, void* user) {
+                            Readback* const r = static_cast<Readback*>(user);
+                            r->destination->store(*static_cast<float*>(buffer),
+                                    std::memory_order_relaxed);
+                            delete r;
+                        }, readback);
+
+                auto const rt = driver.createRenderTarget(TargetBufferFlags::COLOR0,
+                        1, 1, 1, 1, { { luminance, uint8_t(levels - 1) } }, {}, {});
+                driver.readPixels(rt, 0, 0, 1, 1, std::move(pbd));
+                driver.destroyRenderTarget(rt);
+            });
+}
+
 PostProcessManager::ScreenSpaceRefConfig PostProcessManager::prepareMipmapSSR(FrameGraph& fg,
         uint32_t const width, uint32_t const height, TextureFormat const format,
         float const verticalFieldOfView, float2 const scale) noexcept {
@@ -1870,6 +2078,45 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
     auto dilated = dilate(inTilesCocMinMax);
     dilated = dilate(dilated);
 
+    /*
+     * DoF tile mask
+     *
+     * Expand the dilated tile classification into a depth buffer at gather resolution, so the
+     * gather and median passes below can reject tiles that are entirely in focus with the
+     * early depth test, instead of relying only on their per-pixel branches.
+     */
+
+    struct PostProcessDofTileMask {
+        FrameGraphId<FrameGraphTexture> tilesCocMinMax;
+        FrameGraphId<FrameGraphTexture> depth;
+    };
+
+    auto const& ppDoFTileMask = fg.addPass<PostProcessDofTileMask>("DoF tile mask",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.tilesCocMinMax = builder.sample(dilated);
+                data.depth = builder.createTexture("dof tile mask", {
+                        .width  = colorDesc.width  / dofResolution,
+                        .height = colorDesc.height / dofResolution,
+                        .format = TextureFormat::DEPTH16
+                });
+                data.depth = builder.write(data.depth, FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                builder.declareRenderPass("DoF tile mask target", {
+                        .attachments = { .depth = data.depth },
+                        .clearFlags = TargetBufferFlags::DEPTH
+                });
+            },
+            [=](FrameGraphResources const& resources, auto const& data, DriverApi& driver) {
+                bindPostProcessDescriptorSet(driver);
+                auto const& out = resources.getRenderPassInfo();
+                auto tilesCocMinMax = resources.getTexture(data.tilesCocMinMax);
+                auto const& material = getPostProcessMaterial("dofTileMask");
+                FMaterialInstance* const mi =
+                        PostProcessMaterial::getMaterialInstance(mEngine, material);
+                mi->setParameter("tiles", tilesCocMinMax,
+                        { .filterMin = SamplerMinFilter::NEAREST });
+                commitAndRenderFullScreenQuad(driver, out, mi);
+            });
+
     /*
      * DoF blur pass
      */
@@ -1878,6 +2125,7 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
         FrameGraphId<FrameGraphTexture> color;
         FrameGraphId<FrameGraphTexture> coc;
         FrameGraphId<FrameGraphTexture> tilesCocMinMax;
+        FrameGraphId<FrameGraphTexture> tileMask;
         FrameGraphId<FrameGraphTexture> outColor;
         FrameGraphId<FrameGraphTexture> outAlpha;
     };
@@ -1888,6 +2136,8 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
                 data.color          = builder.sample(ppDoFMipmap->inOutColor);
                 data.coc            = builder.sample(ppDoFMipmap->inOutCoc);
                 data.tilesCocMinMax = builder.sample(dilated);
+                data.tileMask       = builder.read(ppDoFTileMask->depth,
+                        FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
 
                 data.outColor = builder.createTexture("dof color output", {
                         .width  = colorDesc.width  / dofResolution,
@@ -1901,8 +2151,12 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
                 });
                 data.outColor  = builder.write(data.outColor, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
                 data.outAlpha  = builder.write(data.outAlpha, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                // We need to clear the buffers because in-focus tiles are skipped by the
+                // depth test; the shader writes vec4(0.0) for those pixels otherwise.
                 builder.declareRenderPass("DoF Target", {
-                        .attachments = { .color = { data.outColor, data.outAlpha }}
+                        .attachments = { .color = { data.outColor, data.outAlpha },
+                                         .depth = data.tileMask },
+                        .clearFlags = TargetBufferFlags::COLOR0 | TargetBufferFlags::COLOR1
                 });
             },
             [=](FrameGraphResources const& resources, auto const& data, DriverApi& driver) {
@@ -1916,8 +2170,8 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
                 auto const& inputDesc = resources.getDescriptor(data.coc);
 
                 auto const& material = getPostProcessMaterial("dof");
-                FMaterialInstance* const mi =
-                        PostProcessMaterial::getMaterialInstance(mEngine, material);
+                FMaterial const* const ma = material.getMaterial(mEngine);
+                FMaterialInstance* const mi = PostProcessMaterial::getMaterialInstance(ma);
                 // it's not safe to use bilinear filtering in the general case (causes artifacts around edges)
                 mi->setParameter("color", color,
                         { .filterMin = SamplerMinFilter::NEAREST_MIPMAP_NEAREST });
@@ -1939,7 +2193,14 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
                     0.0 // unused for now
                 });
                 mi->setParameter("bokehAngle",  bokehAngle);
-                commitAndRenderFullScreenQuad(driver, out, mi);
+                mi->commit(driver);
+                mi->use(driver);
+
+                // Here we use the depth test to skip the tiles that are entirely in focus
+                auto pipeline = getPipelineState(ma);
+                pipeline.rasterState.depthFunc = RasterState::DepthFunc::L;
+                assert_invariant(out.params.readOnlyDepthStencil & RenderPassParams::READONLY_DEPTH);
+                renderFullScreenQuad(out, pipeline, driver);
             });
 
     /*
@@ -1950,6 +2211,7 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
         FrameGraphId<FrameGraphTexture> inColor;
         FrameGraphId<FrameGraphTexture> inAlpha;
         FrameGraphId<FrameGraphTexture> tilesCocMinMax;
+        FrameGraphId<FrameGraphTexture> tileMask;
         FrameGraphId<FrameGraphTexture> outColor;
         FrameGraphId<FrameGraphTexture> outAlpha;
     };
@@ -1960,13 +2222,18 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
                 data.inColor        = builder.sample(ppDoF->outColor);
                 data.inAlpha        = builder.sample(ppDoF->outAlpha);
                 data.tilesCocMinMax = builder.sample(dilated);
+                data.tileMask       = builder.read(ppDoFTileMask->depth,
+                        FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
 
                 data.outColor = builder.createTexture("dof color output", fg.getDescriptor(data.inColor));
                 data.outAlpha = builder.createTexture("dof alpha output", fg.getDescriptor(data.inAlpha));
                 data.outColor = builder.write(data.outColor, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
                 data.outAlpha = builder.write(data.outAlpha, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                // cleared for the same reason as the gather pass above
                 builder.declareRenderPass("DoF Target", {
-                        .attachments = { .color = { data.outColor, data.outAlpha }}
+                        .attachments = { .color = { data.outColor, data.outAlpha },
+                                         .depth = data.tileMask },
+                        .clearFlags = TargetBufferFlags::COLOR0 | TargetBufferFlags::COLOR1
                 });
             },
             [=](FrameGraphResources const& resources, auto const& data, DriverApi& driver) {
@@ -1978,12 +2245,19 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
                 auto tilesCocMinMax = resources.getTexture(data.tilesCocMinMax);
 
                 auto const& material = getPostProcessMaterial("dofMedian");
-                FMaterialInstance* const mi =
-                        PostProcessMaterial::getMaterialInstance(mEngine, material);
+                FMaterial const* const ma = material.getMaterial(mEngine);
+                FMaterialInstance* const mi = PostProcessMaterial::getMaterialInstance(ma);
                 mi->setParameter("dof",   inColor,        { .filterMin = SamplerMinFilter::NEAREST_MIPMAP_NEAREST });
                 mi->setParameter("alpha", inAlpha,        { .filterMin = SamplerMinFilter::NEAREST_MIPMAP_NEAREST });
                 mi->setParameter("tiles", tilesCocMinMax, { .filterMin = SamplerMinFilter::NEAREST });
-                commitAndRenderFullScreenQuad(driver, out, mi);
+                mi->commit(driver);
+                mi->use(driver);
+
+                // the tile mask depth test rejects the tiles that are entirely in focus
+                auto pipeline = getPipelineState(ma);
+                pipeline.rasterState.depthFunc = RasterState::DepthFunc::L;
+                assert_invariant(out.params.readOnlyDepthStencil & RenderPassParams::READONLY_DEPTH);
+                renderFullScreenQuad(out, pipeline, driver);
             });
 
 
@@ -2186,6 +2460,8 @@ PostProcessManager::BloomPassOutput PostProcessManager::bloom(FrameGraph& fg,
                     }
                     builder.declareRenderPass(out, &data.outRT[i]);
                 }
+                // the downsample ladder only depends on its own mips
+                builder.queueAffinity(FrameGraph::QueueAffinity::COMPUTE);
             },
             [=](FrameGraphResources const& resources,
                     auto const& data, DriverApi& driver) {
@@ -2207,6 +2483,14 @@ PostProcessManager::BloomPassOutput PostProcessManager::bloom(FrameGraph& fg,
                 auto const& material13 = getPostProcessMaterial("bloomDownsample");
                 auto* mi13 = PostProcessMaterial::getMaterialInstance(mEngine, material13);
 
+                // single-mip views of the source levels, so that sampling a level while the
+                // next one is bound as an attachment isn't a feedback loop. They're created
+                // and destroyed in batches so the loop below only issues render passes.
+                backend::Handle<backend::HwTexture> hwOutViews[kMaxBloomLevels];
+                for (size_t i = 1; i < inoutBloomOptions.levels; i++) {
+                    hwOutViews[i - 1] = driver.createTextureView(hwOut, i - 1, 1);
+                }
+
                 for (size_t i = 1; i < inoutBloomOptions.levels; i++) {
                     auto hwDstRT = resources.getRenderPassInfo(data.outRT[i]);
                     hwDstRT.params.flags.discardStart = TargetBufferFlags::COLOR;
@@ -2216,12 +2500,14 @@ PostProcessManager::BloomPassOutput PostProcessManager::bloom(FrameGraph& fg,
                     // 9 samples filter.
                     auto vp = resources.getRenderPassInfo(data.outRT[i-1]).params.viewport;
                     auto* const mi = (vp.width & 1 || vp.height & 1) ? mi13 : mi9;
-                    auto hwOutView = driver.createTextureView(hwOut, i - 1, 1);
-                    mi->setParameter("source", hwOutView, {
+                    mi->setParameter("source", hwOutViews[i - 1], {
                             .filterMag = SamplerMagFilter::LINEAR,
                             .filterMin = SamplerMinFilter::LINEAR_MIPMAP_NEAREST });
                     commitAndRenderFullScreenQuad(driver, hwDstRT, mi);
-                    driver.destroyTexture(hwOutView);
+                }
+
+                for (size_t i = 1; i < inoutBloomOptions.levels; i++) {
+                    driver.destroyTexture(hwOutViews[i - 1]);
                 }
             });
 
@@ -2239,6 +2525,8 @@ PostProcessManager::BloomPassOutput PostProcessManager::bloom(FrameGraph& fg,
                             { .level = uint8_t(i) });
                     builder.declareRenderPass(out, &data.outRT[i]);
                 }
+                // the upsample ladder only depends on its own mips
+                builder.queueAffinity(FrameGraph::QueueAffinity::COMPUTE);
             },
             [=](FrameGraphResources const& resources, auto const& data, DriverApi& driver) {
                 bindPostProcessDescriptorSet(driver);
@@ -2253,21 +2541,29 @@ PostProcessManager::BloomPassOutput PostProcessManager::bloom(FrameGraph& fg,
                 pipeline.rasterState.blendFunctionSrcRGB = BlendFunction::ONE;
                 pipeline.rasterState.blendFunctionDstRGB = BlendFunction::ONE;
 
+                // see "Bloom Downsample" above
+                backend::Handle<backend::HwTexture> hwOutViews[kMaxBloomLevels];
+                for (size_t i = 1; i < inoutBloomOptions.levels; i++) {
+                    hwOutViews[i] = driver.createTextureView(hwOut, i, 1);
+                }
+
                 for (size_t j = inoutBloomOptions.levels, i = j - 1; i >= 1; i--, j++) {
                     auto hwDstRT = resources.getRenderPassInfo(data.outRT[i - 1]);
                     hwDstRT.params.flags.discardStart = TargetBufferFlags::NONE; // b/c we'll blend
                     hwDstRT.params.flags.discardEnd = TargetBufferFlags::NONE;
                     auto w = FTexture::valueForLevel(i - 1, outDesc.width);
                     auto h = FTexture::valueForLevel(i - 1, outDesc.height);
-                    auto hwOutView = driver.createTextureView(hwOut, i, 1);
                     mi->setParameter("resolution", float4{ w, h, 1.0f / w, 1.0f / h });
-                    mi->setParameter("source", hwOutView, {
+                    mi->setParameter("source", hwOutViews[i], {
                             .filterMag = SamplerMagFilter::LINEAR,
                             .filterMin = SamplerMinFilter::LINEAR_MIPMAP_NEAREST});
                     mi->commit(driver);
                     mi->use(driver);
                     renderFullScreenQuad(hwDstRT, pipeline, driver);
-                    driver.destroyTexture(hwOutView);
+                }
+
+                for (size_t i = 1; i < inoutBloomOptions.levels; i++) {
+                    driver.destroyTexture(hwOutViews[i]);
                 }
             });
 
@@ -2374,8 +2670,6 @@ void PostProcessManager::colorGradingPrepareSubpass(DriverApi& driver,
 void PostProcessManager::colorGradingSubpass(DriverApi& driver,
         ColorGradingConfig const& colorGradingConfig) noexcept {
 
-    bindPostProcessDescriptorSet(driver);
-
     PostProcessVariant const variant = colorGradingConfig.translucent ?
             PostProcessVariant::TRANSLUCENT : PostProcessVariant::OPAQUE;
 
@@ -2383,7 +2677,9 @@ void PostProcessManager::colorGradingSubpass(DriverApi& driver,
     FMaterial const* const ma = material.getMaterial(mEngine, variant);
     // the UBO has been set and committed in colorGradingPrepareSubpass()
     FMaterialInstance const* mi = PostProcessMaterial::getMaterialInstance(ma);
-    mi->use(driver);
+    DescriptorSet::bind(driver, {
+            { &mPostProcessDescriptorSet.getDescriptorSet(), DescriptorSetBindingPoints::PER_VIEW },
+            { &mi->getDescriptorSet(), DescriptorSetBindingPoints::PER_MATERIAL }});
     auto const pipeline = getPipelineState(ma, variant);
     driver.nextSubpass();
     driver.scissor(mi->getScissor());
@@ -2400,15 +2696,15 @@ void PostProcessManager::customResolvePrepareSubpass(DriverApi& driver, CustomRe
 
 void PostProcessManager::customResolveSubpass(DriverApi& driver) noexcept {
 
-    bindPostProcessDescriptorSet(driver);
-
     FEngine const& engine = mEngine;
     Handle<HwRenderPrimitive> const& fullScreenRenderPrimitive = engine.getFullScreenRenderPrimitive();
     auto const& material = getPostProcessMaterial("customResolveAsSubpass");
     FMaterial const* const ma = material.getMaterial(mEngine);
     // the UBO has been set and committed in colorGradingPrepareSubpass()
     FMaterialInstance const* mi = PostProcessMaterial::getMaterialInstance(ma);
-    mi->use(driver);
+    DescriptorSet::bind(driver, {
+            { &mPostProcessDescriptorSet.getDescriptorSet(), DescriptorSetBindingPoints::PER_VIEW },
+            { &mi->getDescriptorSet(), DescriptorSetBindingPoints::PER_MATERIAL }});
     auto const pipeline = getPipelineState(ma);
     driver.nextSubpass();
     driver.scissor(mi->getScissor());
@@ -2755,6 +3051,84 @@ FMaterialInstance* PostProcessManager::configureColorGradingMaterial(
     return mi;
 }
 
+float4 const* PostProcessManager::getTaaFilterWeights(
+        TemporalAntiAliasingOptions const& taaOptions, float2 const jitter) noexcept {
+
+    // the 3x3 neighborhood sampled by the taa material, in pixel units
+    constexpr float2 sampleOffsets[9] = {
+            { -1.0f, -1.0f }, {  0.0f, -1.0f }, {  1.0f, -1.0f }, { -1.0f,  0.0f },
+            {  0.0f,  0.0f },
+            {  1.0f,  0.0f }, { -1.0f,  1.0f }, {  0.0f,  1.0f }, {  1.0f,  1.0f },
+    };
+
+    constexpr float2 subSampleOffsets[4] = {
+            { -0.25f,  0.25f },
+            {  0.25f,  0.25f },
+            {  0.25f, -0.25f },
+            { -0.25f, -0.25f }
+    };
+
+    auto const lanczos = [](float const x, float const a) -> float {
+        if (x <= std::numeric_limits<float>::epsilon()) {
+            return 1.0f;
+        }
+        if (std::abs(x) <= a) {
+            return (a * std::sin(f::PI * x) * std::sin(f::PI * x / a))
+                   / ((f::PI * f::PI) * (x * x));
+        }
+        return 0.0f;
+    };
+
+    float filterWidth = std::clamp(taaOptions.filterWidth, 1.0f, 2.0f);
+    // debug override of the kernel width for tuning (0 = use the options value)
+    if (UTILS_UNLIKELY(mEngine.debug.taa.filter_width > 0.0f)) {
+        filterWidth = std::clamp(mEngine.debug.taa.filter_width, 1.0f, 2.0f);
+    }
+
+    auto& cache = mTaaFilterWeightsCache;
+    if (cache.filterWidth != filterWidth || cache.upscaling != taaOptions.upscaling ||
+            UTILS_UNLIKELY(!mEngine.debug.taa.use_filter_weight_cache)) {
+        cache.entryCount = 0;
+        cache.filterWidth = filterWidth;
+        cache.upscaling = taaOptions.upscaling;
+    }
+
+    // the jitter comes from a fixed sequence of at most 32 samples (see JitterSequence),
+    // so after a warm-up period every frame hits the cache below
+    for (size_t i = 0; i < cache.entryCount; i++) {
+        if (cache.jitters[i] == jitter) {
+            return cache.weights[i].data();
+        }
+    }
+
+    if (UTILS_UNLIKELY(cache.entryCount == cache.weights.size())) {
+        // can't happen with the sequences above, but don't overflow if one grows
+        cache.entryCount = 0;
+    }
+    size_t const entry = cache.entryCount++;
+    auto& weights = cache.weights[entry];
+    cache.jitters[entry] = jitter;
+
+    float4 sum = 0.0;
+
+    // this doesn't get vectorized (probably because of exp()), so don't bother
+    // unrolling it.
+    UTILS_NOUNROLL
+    for (size_t i = 0; i < 9; i++) {
+        float2 const o = sampleOffsets[i];
+        for (size_t j = 0; j < 4; j++) {
+            float2 const subPixelOffset = taaOptions.upscaling ? subSampleOffsets[j] : float2{ 0 };
+            float2 const d = (o - (jitter - subPixelOffset)) / filterWidth;
+            weights[i][j] = lanczos(length(d), filterWidth);
+        }
+        sum += weights[i];
+    }
+    for (auto& w : weights) {
+        w /= sum;
+    }
+    return weights.data();
+}
+
 FrameGraphId<FrameGraphTexture> PostProcessManager::taa(FrameGraph& fg,
         FrameGraphId<FrameGraphTexture> input,
         FrameGraphId<FrameGraphTexture> const depth,
@@ -2788,8 +3162,8 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::taa(FrameGraph& fg,
             [&](FrameGraph::Builder& builder, auto& data) {
                 auto desc = fg.getDescriptor(input);
                 if (taaOptions.upscaling) {
-                    desc.width *= 2;
-                    desc.height *= 2;
+                    desc.width  = uint32_t(float(desc.width)  * taaOptions.upscalingFactor + 0.5f);
+                    desc.height = uint32_t(float(desc.height) * taaOptions.upscalingFactor + 0.5f);
                 }
                 data.color = builder.sample(input);
                 data.depth = builder.sample(depth);
@@ -2820,50 +3194,8 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::taa(FrameGraph& fg,
                         0, 0, 0,  1
                 }};
 
-                constexpr float2 sampleOffsets[9] = {
-                        { -1.0f, -1.0f }, {  0.0f, -1.0f }, {  1.0f, -1.0f }, { -1.0f,  0.0f },
-                        {  0.0f,  0.0f },
-                        {  1.0f,  0.0f }, { -1.0f,  1.0f }, {  0.0f,  1.0f }, {  1.0f,  1.0f },
-                };
-
-                constexpr float2 subSampleOffsets[4] = {
-                        { -0.25f,  0.25f },
-                        {  0.25f,  0.25f },
-                        {  0.25f, -0.25f },
-                        { -0.25f, -0.25f }
-                };
-
-                UTILS_UNUSED
-                auto const lanczos = [](float const x, float const a) -> float {
-                    if (x <= std::numeric_limits<float>::epsilon()) {
-                        return 1.0f;
-                    }
-                    if (std::abs(x) <= a) {
-                        return (a * std::sin(f::PI * x) * std::sin(f::PI * x / a))
-                               / ((f::PI * f::PI) * (x * x));
-                    }
-                    return 0.0f;
-                };
-
-                float const filterWidth = std::clamp(taaOptions.filterWidth, 1.0f, 2.0f);
-                float4 sum = 0.0;
-                float4 weights[9];
-
-                // this doesn't get vectorized (probably because of exp()), so don't bother
-                // unrolling it.
-                UTILS_NOUNROLL
-                for (size_t i = 0; i < 9; i++) {
-                    float2 const o = sampleOffsets[i];
-                    for (size_t j = 0; j < 4; j++) {
-                        float2 const subPixelOffset = taaOptions.upscaling ? subSampleOffsets[j] : float2{ 0 };
-                        float2 const d = (o - (current.jitter - subPixelOffset)) / filterWidth;
-                        weights[i][j] = lanczos(length(d), filterWidth);
-                    }
-                    sum += weights[i];
-                }
-                for (auto& w : weights) {
-                    w /= sum;
-                }
+                // precomputed per jitter sample, see getTaaFilterWeights()
+                float4 const* const weights = getTaaFilterWeights(taaOptions, current.jitter);
 
                 auto out = resources.getRenderPassInfo();
                 auto color = resources.getTexture(data.color);
@@ -48,6 +48,8 @@
 #include <tsl/robin_map.h>
 
 #include <array>
+#include <atomic>
+#include <memory>
 #include <random>
 #include <string_view>
 
@@ -104,6 +106,11 @@ public:
             RenderPassBuilder const& passBuilder, uint8_t structureRenderFlags,
             uint32_t width, uint32_t height, StructurePassConfig const& config) noexcept;
 
+    // hierarchical-Z (farthest depth) pyramid, built from the structure pass' depth and
+    // used for occlusion culling (see OcclusionCuller)
+    FrameGraphId<FrameGraphTexture> hiZ(FrameGraph& fg,
+            FrameGraphId<FrameGraphTexture> depth) noexcept;
+
     // reflections pass
     FrameGraphId<FrameGraphTexture> ssr(FrameGraph& fg,
             RenderPassBuilder const& passBuilder,
@@ -295,6 +302,21 @@ public:
             FrameGraphId<FrameGraphTexture> output,
             bool reinhard, size_t kernelWidth, float sigma) noexcept;
 
+    // Single-pass fused gaussian blur for VSM shadow maps. Evaluates the 2D expansion of the
+    // separable kernel directly, skipping the intermediate render target of gaussianBlurPass.
+    // Only supports kernelWidth <= 13 (4 stored coefficients).
+    FrameGraphId<FrameGraphTexture> vsmBlurPass(FrameGraph& fg,
+            FrameGraphId<FrameGraphTexture> input,
+            FrameGraphId<FrameGraphTexture> output,
+            size_t kernelWidth, float sigma) noexcept;
+
+    // Auto-exposure metering: reduces `input` to its average log2 luminance on the GPU and
+    // schedules an asynchronous single-pixel readback; the result is stored into `result`
+    // (as log2 of the pre-exposed geometric mean luminance) when the readback completes,
+    // typically a few frames later. NaN in `result` means no measurement has landed yet.
+    void autoExposure(FrameGraph& fg, FrameGraphId<FrameGraphTexture> input,
+            std::shared_ptr<std::atomic<float>> result) noexcept;
+
     FrameGraphId<FrameGraphTexture> debugShadowCascades(FrameGraph& fg,
             FrameGraphId<FrameGraphTexture> input,
             FrameGraphId<FrameGraphTexture> depth) noexcept;
@@ -441,6 +463,22 @@ private:
     static const JitterSequence<4> sUniformHelix4;
     static const JitterSequence<32> sHaltonSamples;
 
+    // Cache of the TAA/upscaling filter weights. The weights only depend on the jitter sample
+    // (at most 32 distinct values per sequence) and a few TemporalAntiAliasingOptions fields,
+    // so each weight set is computed once per sequence sample and the table is rebuilt only
+    // when those fields change; the per-frame setup then does no transcendental math.
+    struct TaaFilterWeightsCache {
+        std::array<std::array<math::float4, 9>, 32> weights;
+        std::array<math::float2, 32> jitters;
+        size_t entryCount = 0;
+        float filterWidth = 0.0f;
+        bool upscaling = false;
+    };
+    TaaFilterWeightsCache mTaaFilterWeightsCache;
+
+    math::float4 const* getTaaFilterWeights(
+            TemporalAntiAliasingOptions const& taaOptions, math::float2 jitter) noexcept;
+
     bool mWorkaroundSplitEasu : 1;
     bool mWorkaroundAllowReadOnlyAncillaryFeedbackLoop : 1;
 };
@@ -85,6 +85,13 @@ RenderPass RenderPassBuilder::build(FEngine const& engine, DriverApi& driver) co
     return RenderPass{ engine, driver, *this };
 }
 
+RenderPass RenderPassBuilder::buildDeferred() const {
+    assert_invariant(mRenderableSoa);
+    RenderPass pass{ *this };
+    pass.mDeferred = true;
+    return pass;
+}
+
 // ------------------------------------------------------------------------------------------------
 
 void RenderPass::BufferObjectHandleDeleter::operator()(BufferObjectHandle handle) noexcept {
@@ -104,8 +111,22 @@ void RenderPass::DescriptorSetHandleDeleter::operator()(
 
 RenderPass::RenderPass(FEngine const& engine, DriverApi& driver,
         RenderPassBuilder const& builder) noexcept
+        : RenderPass(builder) {
+    generate(engine);
+    finalize(engine, driver);
+}
+
+RenderPass::RenderPass(RenderPassBuilder const& builder) noexcept
         : mRenderableSoa(*builder.mRenderableSoa),
-          mColorPassDescriptorSet(builder.mColorPassDescriptorSet) {
+          mColorPassDescriptorSet(builder.mColorPassDescriptorSet),
+          mVisibleRenderables(builder.mVisibleRenderables),
+          mCommandTypeFlags(builder.mCommandTypeFlags),
+          mRenderFlags(builder.mFlags),
+          mVisibilityMask(builder.mVisibilityMask),
+          mVariant(builder.mVariant),
+          mCameraPosition(builder.mCameraPosition),
+          mCameraForwardVector(builder.mCameraForwardVector),
+          mArena(&builder.mArena) {
 
     // compute the number of commands we need
     updateSummedPrimitiveCounts(
@@ -136,15 +157,6 @@ RenderPass::RenderPass(FEngine const& engine, DriverApi& driver,
         }
     }
 
-    appendCommands(engine, { commandBegin, commandCount },
-            builder.mVisibleRenderables,
-            builder.mCommandTypeFlags,
-            builder.mFlags,
-            builder.mVisibilityMask,
-            builder.mVariant,
-            builder.mCameraPosition,
-            builder.mCameraForwardVector);
-
     if (builder.mCustomCommands.has_value()) {
         mCustomCommands.reserve(customCommandCount);
         Command* p = commandBegin + commandCount;
@@ -153,24 +165,73 @@ RenderPass::RenderPass(FEngine const& engine, DriverApi& driver,
         }
     }
 
+    mCommandCount = commandCount;
+    mCommandBegin = commandBegin;
+    mCommandEnd = commandEnd;
+}
+
+void RenderPass::generate(FEngine const& engine) noexcept {
+    Command* const commandBegin = const_cast<Command*>(mCommandBegin);
+
+    appendCommands(engine, { commandBegin, mCommandCount },
+            mVisibleRenderables,
+            mCommandTypeFlags,
+            mRenderFlags,
+            mVisibilityMask,
+            mVariant,
+            mCameraPosition,
+            mCameraForwardVector);
+
     // sort commands once we're done adding commands
-    commandEnd = resize(builder.mArena,
-            sortCommands(commandBegin, commandEnd));
+    Command* commandEnd = sortCommands(engine.getJobSystem(),
+            commandBegin, const_cast<Command*>(mCommandEnd));
+
+    if (UTILS_LIKELY(!mDeferred)) {
+        // In the deferred case we can be running on a JobSystem thread, and the arena could
+        // be in use by other passes being built on the main thread, so we don't reclaim the
+        // unused tail here -- it is, wholesale, at the end of the frame.
+        commandEnd = resize(*mArena, commandEnd);
+    }
+
+    mCommandEnd = commandEnd;
+}
+
+void RenderPass::finalize(FEngine const& engine, DriverApi& driver) noexcept {
+    Command* const commandBegin = const_cast<Command*>(mCommandBegin);
+    Command* commandEnd = const_cast<Command*>(mCommandEnd);
+
+    // Go over all the commands and call prepareProgram().
+    // This must be done from the main thread.
+    for (Command const* first = commandBegin; first != commandEnd; ++first) {
+        if (UTILS_LIKELY((first->key & CUSTOM_MASK) == uint64_t(CustomCommand::PASS))) {
+            auto ma = first->info.mi->getMaterial();
+            ma->prepareProgram(first->info.materialVariant);
+        }
+    }
+
+    if (engine.isDrawMergingEnabled()) {
+        commandEnd = mergeContiguousDraws(commandBegin, commandEnd);
+        if (UTILS_LIKELY(!mDeferred)) {
+            commandEnd = resize(*mArena, commandEnd);
+        }
+    }
 
     if (engine.isAutomaticInstancingEnabled()) {
         int32_t stereoscopicEyeCount = 1;
-        if (builder.mFlags & IS_INSTANCED_STEREOSCOPIC) {
+        if (mRenderFlags & IS_INSTANCED_STEREOSCOPIC) {
             stereoscopicEyeCount *= engine.getConfig().stereoscopicEyeCount;
         }
-        commandEnd = resize(builder.mArena,
-                instanceify(driver,
-                        engine.getPerRenderableDescriptorSetLayout().getHandle(),
-                        commandBegin, commandEnd, stereoscopicEyeCount));
+        commandEnd = instanceify(driver,
+                engine.getPerRenderableDescriptorSetLayout().getHandle(),
+                commandBegin, commandEnd, stereoscopicEyeCount);
+        if (UTILS_LIKELY(!mDeferred)) {
+            commandEnd = resize(*mArena, commandEnd);
+        }
     }
 
     // these are `const` from this point on...
-    mCommandBegin = commandBegin;
     mCommandEnd = commandEnd;
+    mDeferred = false;
 }
 
 // this destructor is actually heavy because it inlines ~vector<>
@@ -237,15 +298,6 @@ void RenderPass::appendCommands(FEngine const& engine,
     // "eof" command. These commands are guaranteed to be sorted last in the
     // command buffer.
     curr[commandCount - 1].key = uint64_t(Pass::SENTINEL);
-
-    // Go over all the commands and call prepareProgram().
-    // This must be done from the main thread.
-    for (Command const* first = curr, *last = curr + commandCount ; first != last ; ++first) {
-        if (UTILS_LIKELY((first->key & CUSTOM_MASK) == uint64_t(CustomCommand::PASS))) {
-            auto ma = first->info.mi->getMaterial();
-            ma->prepareProgram(first->info.materialVariant);
-        }
-    }
 }
 
 void RenderPass::appendCustomCommand(Command* commands,
@@ -268,11 +320,48 @@ void RenderPass::appendCustomCommand(Command* commands,
     commands->key = cmd;
 }
 
-RenderPass::Command* RenderPass::sortCommands(
+RenderPass::Command* RenderPass::sortCommands(JobSystem& js,
         Command* const begin, Command* const end) noexcept {
     FILAMENT_TRACING_NAME(FILAMENT_TRACING_CATEGORY_FILAMENT, "sort commands");
 
-    std::sort(begin, end);
+    size_t const count = end - begin;
+
+    // Below this size a single std::sort beats the JobSystem overhead; above it, each job
+    // sorts its own contiguous chunk of commands and sorted chunks are then merged pairwise,
+    // with the independent merges of each round also running in parallel.
+    constexpr size_t PARALLEL_SORT_COMMANDS_COUNT = 4096;
+    constexpr size_t PARALLEL_SORT_CHUNK_COUNT = 8;     // power-of-two, for pairwise merging
+
+    if (UTILS_LIKELY(count < PARALLEL_SORT_COMMANDS_COUNT)) {
+        std::sort(begin, end);
+    } else {
+        size_t const chunkSize =
+                (count + PARALLEL_SORT_CHUNK_COUNT - 1) / PARALLEL_SORT_CHUNK_COUNT;
+        Command* chunks[PARALLEL_SORT_CHUNK_COUNT + 1];
+        for (size_t i = 0; i <= PARALLEL_SORT_CHUNK_COUNT; i++) {
+            chunks[i] = begin + std::min(i * chunkSize, count);
+        }
+        auto* parent = js.createJob();
+        for (size_t i = 0; i < PARALLEL_SORT_CHUNK_COUNT; i++) {
+            js.run(jobs::createJob(js, parent,
+                    [b = chunks[i], e = chunks[i + 1]] {
+                        std::sort(b, e);
+                    }));
+        }
+        js.runAndWait(parent);
+
+        for (size_t stride = 1; stride < PARALLEL_SORT_CHUNK_COUNT; stride *= 2) {
+            auto* mergeParent = js.createJob();
+            for (size_t i = 0; i < PARALLEL_SORT_CHUNK_COUNT; i += stride * 2) {
+                js.run(jobs::createJob(js, mergeParent,
+                        [f = chunks[i], m = chunks[i + stride],
+                         l = chunks[i + stride * 2]] {
+                            std::inplace_merge(f, m, l);
+                        }));
+            }
+            js.runAndWait(mergeParent);
+        }
+    }
 
     // find the last command
     Command* const last = std::partition_point(begin, end,
@@ -429,6 +518,61 @@ RenderPass::Command* RenderPass::instanceify(DriverApi& driver,
     return last;
 }
 
+RenderPass::Command* RenderPass::mergeContiguousDraws(
+        Command* curr, Command* const last) noexcept {
+    FILAMENT_TRACING_NAME(FILAMENT_TRACING_CATEGORY_FILAMENT, "mergeContiguousDraws");
+
+    // mergeContiguousDraws works by scanning the **sorted** command stream, looking for runs of
+    // draws that differ only by their index range, with the ranges laid out back-to-back in the
+    // index buffer. Such runs are produced by renderables whose primitives are packed into
+    // shared vertex/index buffers -- a common layout for scenes made of masses of tiny meshes --
+    // and can be folded into a single draw since they share the render primitive, the pipeline
+    // state and the per-renderable data.
+
+    UTILS_UNUSED uint32_t drawCallsSavedCount = 0;
+
+    Command* firstSentinel = nullptr;
+    while (curr != last) {
+        Command* e = curr + 1;
+        if (UTILS_LIKELY(curr->info.instanceCount <= 1 && !curr->info.hasHybridInstancing)) {
+            while (e != last &&
+                    e->info.mi == curr->info.mi &&
+                    e->info.rph == curr->info.rph &&
+                    e->info.vbih == curr->info.vbih &&
+                    e->info.dsh == curr->info.dsh &&
+                    // same per-renderable data (i.e.: primitives of the same renderable)
+                    e->info.index == curr->info.index &&
+                    // the index range must start where the accumulated one ends
+                    e->info.indexOffset == curr->info.indexOffset + curr->info.indexCount &&
+                    e->info.instanceCount <= 1 &&
+                    !e->info.hasHybridInstancing &&
+                    e->info.rasterState == curr->info.rasterState &&
+                    e->info.materialVariant == curr->info.materialVariant &&
+                    e->info.skinningOffset == curr->info.skinningOffset &&
+                    e->info.morphingOffset == curr->info.morphingOffset &&
+                    e->info.type == curr->info.type) {
+                // fold this draw into the accumulating one and cancel it
+                curr->info.indexCount += e->info.indexCount;
+                e->key = uint64_t(Pass::SENTINEL);
+                firstSentinel = !firstSentinel ? e : firstSentinel;
+                drawCallsSavedCount++;
+                ++e;
+            }
+        }
+        curr = e;
+    }
+
+    if (UTILS_UNLIKELY(firstSentinel)) {
+        // remove all the canceled commands
+        auto const lastCommand = std::remove_if(firstSentinel, last, [](auto const& command) {
+            return command.key == uint64_t(Pass::SENTINEL);
+        });
+        return lastCommand;
+    }
+
+    return last;
+}
+
 
 /* static */
 UTILS_ALWAYS_INLINE // This function exists only to make the code more readable. we want it inlined.
@@ -529,6 +673,30 @@ void RenderPass::generateCommands(CommandTypeFlags commandTypeFlags, Command* co
                     variant, renderFlags, visibilityMask, cameraPosition, cameraForward,
                     instancedStereoEyeCount);
             break;
+        case CommandTypeFlags::COLOR | CommandTypeFlags::DEPTH:
+            // Color pass with an explicit depth prepass: the depth commands sort in front of
+            // the color commands within each channel (Pass::DEPTH < Pass::COLOR), so opaque
+            // geometry is laid down depth-only first and the early depth test then reduces
+            // the color commands to the visible fragments.
+            // The translucent filter only applies to the depth commands; translucent objects
+            // must still be drawn by the color pass.
+            curr = generateCommandsImpl<CommandTypeFlags::COLOR>(
+                    commandTypeFlags & ~CommandTypeFlags::FILTER_TRANSLUCENT_OBJECTS, curr,
+                    soa, range,
+                    variant, renderFlags, visibilityMask, cameraPosition, cameraForward,
+                    instancedStereoEyeCount);
+            {
+                // only the vertex-relevant bits of the color variant carry over to the
+                // prepass; HAS_SHADOWING is cleared so the prepass culls like the color pass
+                Variant depthVariant{ Variant::DEPTH_VARIANT };
+                depthVariant.setStereo(variant.hasStereo());
+                curr = generateCommandsImpl<CommandTypeFlags::DEPTH>(commandTypeFlags, curr,
+                        soa, range,
+                        depthVariant, RenderFlags(renderFlags & ~HAS_SHADOWING), visibilityMask,
+                        cameraPosition, cameraForward,
+                        instancedStereoEyeCount);
+            }
+            break;
         default:
             // we should never end-up here
             break;
@@ -582,10 +750,8 @@ RenderPass::Command* RenderPass::generateCommandsImpl(CommandTypeFlags extraFlag
     auto const* const UTILS_RESTRICT soaWorldAABBCenter = soa.data<FScene::WORLD_AABB_CENTER>();
     auto const* const UTILS_RESTRICT soaVisibility      = soa.data<FScene::VISIBILITY_STATE>();
     auto const* const UTILS_RESTRICT soaPrimitives      = soa.data<FScene::PRIMITIVES>();
-    auto const* const UTILS_RESTRICT soaSkinning        = soa.data<FScene::SKINNING_BUFFER>();
-    auto const* const UTILS_RESTRICT soaMorphing        = soa.data<FScene::MORPHING_BUFFER>();
     auto const* const UTILS_RESTRICT soaVisibilityMask  = soa.data<FScene::VISIBLE_MASK>();
-    auto const* const UTILS_RESTRICT soaInstanceInfo    = soa.data<FScene::INSTANCES>();
+    auto const* const UTILS_RESTRICT soaDescriptor      = soa.data<FScene::COMMAND_DESCRIPTOR>();
     auto const* const UTILS_RESTRICT soaDescriptorSet   = soa.data<FScene::DESCRIPTOR_SET_HANDLE>();
 
     Command cmd;
@@ -634,11 +800,12 @@ RenderPass::Command* RenderPass::generateCommandsImpl(CommandTypeFlags extraFlag
         float const distance = -(dot(soaWorldAABBCenter[i], cameraForward) - cameraPositionDotCameraForward);
         uint32_t const distanceBits = reinterpret_cast<uint32_t const&>(distance);
 
+        // per-frame classification precomputed by updateCommandDescriptors()
+        FScene::CommandDescriptor const& descriptor = soaDescriptor[i];
+
         // calculate the per-primitive face winding order inversion
         bool const inverseFrontFaces = viewInverseFrontFaces ^ soaVisibility[i].reversedWindingOrder;
-        bool const hasMorphing = soaVisibility[i].morphing;
-        bool const hasSkinning = soaVisibility[i].skinning;
-        bool const hasSkinningOrMorphing = hasSkinning || hasMorphing;
+        bool const hasSkinningOrMorphing = descriptor.hasSkinningOrMorphing;
 
         // if we are already an SSR variant, the SRE bit is already set
         static_assert(Variant::SPECIAL_SSR & Variant::SRE);
@@ -654,9 +821,6 @@ RenderPass::Command* RenderPass::generateCommandsImpl(CommandTypeFlags extraFlag
 
         renderableVariant.setSkinning(hasSkinningOrMorphing);
 
-        FRenderableManager::SkinningBindingInfo const& skinning = soaSkinning[i];
-        FRenderableManager::MorphingBindingInfo const& morphing = soaMorphing[i];
-
         if constexpr (isColorPass) {
             renderableVariant.setFog(soaVisibility[i].fog && Variant::isFogVariant(variant));
             cmd.key = uint64_t(Pass::COLOR);
@@ -668,15 +832,14 @@ RenderPass::Command* RenderPass::generateCommandsImpl(CommandTypeFlags extraFlag
             cmd.info.rasterState.inverseFrontFaces = inverseFrontFaces;
         }
 
-        cmd.key |= makeField(soaVisibility[i].priority, PRIORITY_MASK, PRIORITY_SHIFT);
-        cmd.key |= makeField(soaVisibility[i].channel, CHANNEL_MASK, CHANNEL_SHIFT);
+        cmd.key |= descriptor.keyFragment;
         cmd.info.index = i;
-        cmd.info.hasHybridInstancing = bool(soaInstanceInfo[i].handle);
-        cmd.info.instanceCount = soaInstanceInfo[i].count;
-        cmd.info.hasMorphing = bool(morphing.handle);
-        cmd.info.hasSkinning = bool(skinning.handle);
+        cmd.info.hasHybridInstancing = descriptor.hasHybridInstancing;
+        cmd.info.instanceCount = descriptor.instanceCount;
+        cmd.info.hasMorphing = descriptor.hasMorphing;
+        cmd.info.hasSkinning = descriptor.hasSkinning;
 
-        // soaInstanceInfo[i].count is the number of instances the user has requested, either for
+        // descriptor.instanceCount is the number of instances the user has requested, either for
         // manual or hybrid instancing. Instanced stereo multiplies the number of instances by the
         // eye count.
         if (hasInstancedStereo) {
@@ -688,7 +851,7 @@ RenderPass::Command* RenderPass::generateCommandsImpl(CommandTypeFlags extraFlag
         cmd.info.dsh = soaDescriptorSet[i];
 
         // always set the skinningOffset, even when skinning is off, this doesn't cost anything.
-        cmd.info.skinningOffset = soaSkinning[i].offset * sizeof(PerRenderableBoneUib::BoneData);
+        cmd.info.skinningOffset = descriptor.skinningOffset;
 
         const bool shadowCaster = soaVisibility[i].castShadows & hasShadowing;
         const bool writeDepthForShadowCasters = depthContainsShadowCasters & shadowCaster;
@@ -854,6 +1017,29 @@ void RenderPass::updateSummedPrimitiveCounts(
     summedPrimitiveCount[vr.last] = count;
 }
 
+/* static */
+void RenderPass::updateCommandDescriptors(
+        FScene::RenderableSoa& renderableData, Range<uint32_t> vr) noexcept {
+    auto const* const UTILS_RESTRICT soaVisibility   = renderableData.data<FScene::VISIBILITY_STATE>();
+    auto const* const UTILS_RESTRICT soaSkinning     = renderableData.data<FScene::SKINNING_BUFFER>();
+    auto const* const UTILS_RESTRICT soaMorphing     = renderableData.data<FScene::MORPHING_BUFFER>();
+    auto const* const UTILS_RESTRICT soaInstanceInfo = renderableData.data<FScene::INSTANCES>();
+    auto* const UTILS_RESTRICT soaDescriptors = renderableData.data<FScene::COMMAND_DESCRIPTOR>();
+    for (uint32_t const i : vr) {
+        FScene::CommandDescriptor& desc = soaDescriptors[i];
+        // channel|priority are the only sort-key bits that are identical in all passes
+        desc.keyFragment =
+                makeField(soaVisibility[i].priority, PRIORITY_MASK, PRIORITY_SHIFT) |
+                makeField(soaVisibility[i].channel, CHANNEL_MASK, CHANNEL_SHIFT);
+        desc.skinningOffset = soaSkinning[i].offset * sizeof(PerRenderableBoneUib::BoneData);
+        desc.instanceCount = soaInstanceInfo[i].count;
+        desc.hasSkinning = bool(soaSkinning[i].handle);
+        desc.hasMorphing = bool(soaMorphing[i].handle);
+        desc.hasSkinningOrMorphing = soaVisibility[i].skinning || soaVisibility[i].morphing;
+        desc.hasHybridInstancing = bool(soaInstanceInfo[i].handle);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 
 void RenderPass::Executor::overridePolygonOffset(PolygonOffset const* polygonOffset) noexcept {
@@ -961,6 +1147,7 @@ void RenderPass::Executor::execute(FEngine const& engine, DriverApi& driver,
 
         FMaterialInstance const* UTILS_RESTRICT mi = nullptr;
         FMaterial const* UTILS_RESTRICT ma = nullptr;
+        Variant currentVariant{};
         auto const* UTILS_RESTRICT pCustomCommands = mCustomCommands.data();
 
         // Maximum space occupied in the CircularBuffer by a single `Command`. This must be
@@ -1022,84 +1209,99 @@ void RenderPass::Executor::execute(FEngine const& engine, DriverApi& driver,
 
                 // per-renderable uniform
                 PrimitiveInfo const info = first->info;
-                pipeline.rasterState = info.rasterState;
-                pipeline.vertexBufferInfo = info.vbih;
-                pipeline.primitiveType = info.type;
-                assert_invariant(pipeline.vertexBufferInfo);
-
-                if (UTILS_UNLIKELY(mi != info.mi)) {
-                    // this is always taken the first time
-                    assert_invariant(info.mi);
-
-                    mi = info.mi;
-                    ma = mi->getMaterial();
-
-                    // if we have the scissor override, the material instance and scissor-viewport
-                    // are ignored (typically used for shadow maps).
-                    if (!hasScissorOverride) {
-                        // apply the MaterialInstance scissor
-                        backend::Viewport scissor = mi->getScissor();
-                        if (hasScissorViewport) {
-                            // apply the scissor viewport if any
-                            scissor = applyScissorViewport(mScissor, scissor);
-                        }
-                        if (scissor != currentScissor) {
-                            currentScissor = scissor;
-                            driver.scissor(scissor);
+
+                // Commands are sorted such that draws sharing the same pipeline state end up
+                // adjacent (they only differ by their render primitive and per-renderable
+                // descriptor offset -- a very common case with many distinct meshes using the
+                // same material). Detect such runs so that everything the PipelineState
+                // depends on is re-assembled and compared only when the run ends.
+                bool const samePipeline = mi == info.mi
+                        && currentVariant == info.materialVariant
+                        && pipeline.rasterState == info.rasterState
+                        && pipeline.vertexBufferInfo == info.vbih
+                        && pipeline.primitiveType == info.type;
+
+                if (UTILS_UNLIKELY(!samePipeline)) {
+                    pipeline.rasterState = info.rasterState;
+                    pipeline.vertexBufferInfo = info.vbih;
+                    pipeline.primitiveType = info.type;
+                    currentVariant = info.materialVariant;
+                    assert_invariant(pipeline.vertexBufferInfo);
+
+                    if (UTILS_UNLIKELY(mi != info.mi)) {
+                        // this is always taken the first time
+                        assert_invariant(info.mi);
+
+                        mi = info.mi;
+                        ma = mi->getMaterial();
+
+                        // if we have the scissor override, the material instance and scissor-viewport
+                        // are ignored (typically used for shadow maps).
+                        if (!hasScissorOverride) {
+                            // apply the MaterialInstance scissor
+                            backend::Viewport scissor = mi->getScissor();
+                            if (hasScissorViewport) {
+                                // apply the scissor viewport if any
+                                scissor = applyScissorViewport(mScissor, scissor);
+                            }
+                            if (scissor != currentScissor) {
+                                currentScissor = scissor;
+                                driver.scissor(scissor);
+                            }
                         }
-                    }
 
-                    if (UTILS_LIKELY(!polygonOffsetOverride)) {
-                        pipeline.polygonOffset = mi->getPolygonOffset();
-                    }
-                    pipeline.stencilState = mi->getStencilState();
-
-                    // Each material has its own version of the per-view descriptor-set layout,
-                    // because it depends on the material features (e.g. lit/unlit)
-                    // TODO: QUESTION: are
-                    //      Variant::isValidDepthVariant(info.materialVariant) and
-                    //      Variant::isSSRVariant(info.materialVariant)
-                    //      constant? If so we could precompute ma->getPerViewDescriptorSetLayout()
-                    pipeline.pipelineLayout.setLayout[+DescriptorSetBindingPoints::PER_VIEW] =
-                            ma->getPerViewDescriptorSetLayout(info.materialVariant,
-                                    useVsmDescriptorSetLayout).getHandle();
-
-                    // Each material has a per-material descriptor-set layout which encodes the
-                    // material's parameters (ubo and samplers)
-                    pipeline.pipelineLayout.setLayout[+DescriptorSetBindingPoints::PER_MATERIAL] =
-                            ma->getDescriptorSetLayout().getHandle();
-
-                    if (UTILS_UNLIKELY(ma->getMaterialDomain() == MaterialDomain::POST_PROCESS)) {
-                        // It is possible to get a post-process material here (even though it's
-                        // not technically a public API yet, it is used by the IBLPrefilterLibrary.
-                        // Ideally we would have a more formal compute API). In this case, we need
-                        // to set the post-process descriptor-set.
-                        engine.getPostProcessManager().bindPostProcessDescriptorSet(driver);
-                    } else {
-                        // If we have a ColorPassDescriptorSet we use it to bind the per-view
-                        // descriptor-set (ideally only if it changed). If we don't, it means
-                        // the descriptor-set is already bound and the layout we got from the
-                        // material above should match. This is the case for situations where we
-                        // have a known per-view descriptor-set layout, e.g.: shadow-maps, ssr and
-                        // structure passes.
-                        if (mColorPassDescriptorSet) {
-                            // We have a ColorPassDescriptorSet, we need to go through it for binding
-                            // the per-view descriptor-set because its layout can change based on the
-                            // material.
-                            mColorPassDescriptorSet->bind(driver, ma->getPerViewLayoutIndex());
+                        if (UTILS_LIKELY(!polygonOffsetOverride)) {
+                            pipeline.polygonOffset = mi->getPolygonOffset();
+                        }
+                        pipeline.stencilState = mi->getStencilState();
+
+                        // Each material has its own version of the per-view descriptor-set layout,
+                        // because it depends on the material features (e.g. lit/unlit)
+                        // TODO: QUESTION: are
+                        //      Variant::isValidDepthVariant(info.materialVariant) and
+                        //      Variant::isSSRVariant(info.materialVariant)
+                        //      constant? If so we could precompute ma->getPerViewDescriptorSetLayout()
+                        pipeline.pipelineLayout.setLayout[+DescriptorSetBindingPoints::PER_VIEW] =
+                                ma->getPerViewDescriptorSetLayout(info.materialVariant,
+                                        useVsmDescriptorSetLayout).getHandle();
+
+                        // Each material has a per-material descriptor-set layout which encodes the
+                        // material's parameters (ubo and samplers)
+                        pipeline.pipelineLayout.setLayout[+DescriptorSetBindingPoints::PER_MATERIAL] =
+                                ma->getDescriptorSetLayout().getHandle();
+
+                        if (UTILS_UNLIKELY(ma->getMaterialDomain() == MaterialDomain::POST_PROCESS)) {
+                            // It is possible to get a post-process material here (even though it's
+                            // not technically a public API yet, it is used by the IBLPrefilterLibrary.
+                            // Ideally we would have a more formal compute API). In this case, we need
+                            // to set the post-process descriptor-set.
+                            engine.getPostProcessManager().bindPostProcessDescriptorSet(driver);
+                        } else {
+                            // If we have a ColorPassDescriptorSet we use it to bind the per-view
+                            // descriptor-set (ideally only if it changed). If we don't, it means
+                            // the descriptor-set is already bound and the layout we got from the
+                            // material above should match. This is the case for situations where we
+                            // have a known per-view descriptor-set layout, e.g.: shadow-maps, ssr and
+                            // structure passes.
+                            if (mColorPassDescriptorSet) {
+                                // We have a ColorPassDescriptorSet, we need to go through it for binding
+                                // the per-view descriptor-set because its layout can change based on the
+                                // material.
+                                mColorPassDescriptorSet->bind(driver, ma->getPerViewLayoutIndex());
+                            }
                         }
-                    }
 
-                    // Each MaterialInstance has its own descriptor set. This binds it.
-                    mi->use(driver);
-                }
+                        // Each MaterialInstance has its own descriptor set. This binds it.
+                        mi->use(driver);
+                    }
 
-                assert_invariant(ma);
-                pipeline.program = ma->getProgram(info.materialVariant);
+                    assert_invariant(ma);
+                    pipeline.program = ma->getProgram(info.materialVariant);
 
-                if (UTILS_UNLIKELY(memcmp(&pipeline, &currentPipeline, sizeof(PipelineState)) != 0)) {
-                    currentPipeline = pipeline;
-                    driver.bindPipeline(pipeline);
+                    if (UTILS_UNLIKELY(memcmp(&pipeline, &currentPipeline, sizeof(PipelineState)) != 0)) {
+                        currentPipeline = pipeline;
+                        driver.bindPipeline(pipeline);
+                    }
                 }
 
                 if (UTILS_UNLIKELY(info.rph != currentPrimitiveHandle)) {
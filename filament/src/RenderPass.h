@@ -50,6 +50,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+namespace utils {
+class JobSystem;
+} // namespace utils
+
 namespace filament {
 
 namespace backend {
@@ -206,7 +210,10 @@ public:
         // generate commands for SSAO
         SSAO = DEPTH | FILTER_TRANSLUCENT_OBJECTS,
         // generate commands for screen-space reflections
-        SCREEN_SPACE_REFLECTIONS = COLOR | FILTER_TRANSLUCENT_OBJECTS
+        SCREEN_SPACE_REFLECTIONS = COLOR | FILTER_TRANSLUCENT_OBJECTS,
+        // generate commands for the color pass preceded by an overdraw-limiting depth
+        // prepass (the translucent filter only applies to the depth commands)
+        COLOR_WITH_DEPTH_PREPASS = COLOR | DEPTH | FILTER_TRANSLUCENT_OBJECTS
     };
 
     /*
@@ -312,6 +319,17 @@ public:
         mScissorViewport = viewport;
     }
 
+    // Generates and sorts the commands of a pass created with RenderPassBuilder::buildDeferred().
+    // This is the heavy part of the pass creation; it doesn't touch the driver nor the command
+    // arena, so it can run on a JobSystem thread while the main thread continues setting up the
+    // frame.
+    void generate(FEngine const& engine) noexcept;
+
+    // Completes a pass created with RenderPassBuilder::buildDeferred() once generate() has
+    // returned. This prepares the programs and applies automatic instancing, and therefore must
+    // be called from the main thread, before any Executor is obtained.
+    void finalize(FEngine const& engine, backend::DriverApi& driver) noexcept;
+
     Command const* begin() const noexcept { return mCommandBegin; }
     Command const* end() const noexcept { return mCommandEnd; }
     bool empty() const noexcept { return begin() == end(); }
@@ -393,21 +411,36 @@ public:
         void execute(FEngine const& engine, backend::DriverApi& driver) const noexcept;
     };
 
+    // number of commands generated by this pass, valid once the pass is finalized
+    uint32_t getCommandCount() const noexcept { return mCommandCount; }
+
     // returns a new executor for this pass
     Executor getExecutor() const {
         return getExecutor(mCommandBegin, mCommandEnd);
     }
 
     Executor getExecutor(Command const* b, Command const* e) const {
+        assert_invariant(!mDeferred);
         return { *this, b, e };
     }
 
+    // Precomputes the per-renderable COMMAND_DESCRIPTOR column consumed by
+    // generateCommandsImpl(). Called once per frame from FView::prepare() for all the
+    // renderables any pass of the frame can see, so that each pass's command loop doesn't
+    // re-derive this classification.
+    static void updateCommandDescriptors(
+            FScene::RenderableSoa& renderableData, utils::Range<uint32_t> vr) noexcept;
+
 private:
     friend class FRenderer;
     friend class RenderPassBuilder;
     RenderPass(FEngine const& engine, backend::DriverApi& driver,
             RenderPassBuilder const& builder) noexcept;
 
+    // First phase of the pass creation: allocates the command buffer and records the custom
+    // commands. generate() and finalize() complete the construction.
+    explicit RenderPass(RenderPassBuilder const& builder) noexcept;
+
     // This is the main function of this class, this appends commands to the pass using
     // the current camera, geometry and flags set. This can be called multiple times if needed.
     void appendCommands(FEngine const& engine,
@@ -427,8 +460,9 @@ private:
 
     static Command* resize(Arena& arena, Command* last) noexcept;
 
-    // sorts commands then trims sentinels
-    static Command* sortCommands(
+    // sorts commands then trims sentinels; large command streams are sorted as a
+    // parallel merge sort on the JobSystem
+    static Command* sortCommands(utils::JobSystem& js,
             Command* begin, Command* end) noexcept;
 
     // instanceify commands then trims sentinels
@@ -437,6 +471,9 @@ private:
             Command* begin, Command* end,
             int32_t eyeCount) const noexcept;
 
+    // folds adjacent draws of contiguous index ranges then trims sentinels
+    static Command* mergeContiguousDraws(Command* begin, Command* end) noexcept;
+
     // We choose the command count per job to minimize JobSystem overhead.
     static constexpr size_t JOBS_PARALLEL_FOR_COMMANDS_COUNT = 128;
     static constexpr size_t JOBS_PARALLEL_FOR_COMMANDS_SIZE  =
@@ -475,6 +512,19 @@ private:
     // a vector for our custom commands
     using CustomCommandVector = utils::FixedCapacityVector<Executor::CustomCommandFn>;
     mutable CustomCommandVector mCustomCommands;
+
+    // builder state needed by generate() and finalize()
+    utils::Range<uint32_t> mVisibleRenderables{};
+    CommandTypeFlags mCommandTypeFlags{};
+    RenderFlags mRenderFlags{};
+    FScene::VisibleMaskType mVisibilityMask{};
+    Variant mVariant{};
+    math::float3 mCameraPosition{};
+    math::float3 mCameraForwardVector{};
+    uint32_t mCommandCount = 0;
+    Arena* mArena = nullptr;
+    // true between buildDeferred() and finalize()
+    bool mDeferred = false;
 };
 
 class RenderPassBuilder {
@@ -570,6 +620,11 @@ public:
             const RenderPass::Executor::CustomCommandFn& command);
 
     RenderPass build(FEngine const& engine, backend::DriverApi& driver) const;
+
+    // Like build(), but defers the heavy command generation and sort, so that they can be run
+    // on a JobSystem thread via RenderPass::generate(). RenderPass::finalize() must then be
+    // called from the main thread before an Executor can be obtained.
+    RenderPass buildDeferred() const;
 };
 
 
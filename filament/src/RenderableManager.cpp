@@ -39,6 +39,10 @@ bool RenderableManager::empty() const noexcept {
     return downcast(this)->empty();
 }
 
+void RenderableManager::reserve(size_t const n) noexcept {
+    downcast(this)->reserve(n);
+}
+
 Entity RenderableManager::getEntity(Instance const i) const noexcept {
     return downcast(this)->getEntity(i);
 }
@@ -80,6 +84,10 @@ void RenderableManager::setCastShadows(Instance const instance, bool const enabl
     downcast(this)->setCastShadows(instance, enable);
 }
 
+void RenderableManager::setCastShadowsStatic(Instance const instance, bool const enable) noexcept {
+    downcast(this)->setCastShadowsStatic(instance, enable);
+}
+
 void RenderableManager::setReceiveShadows(Instance const instance, bool const enable) noexcept {
     downcast(this)->setReceiveShadows(instance, enable);
 }
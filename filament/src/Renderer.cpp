@@ -42,6 +42,20 @@ void Renderer::render(View const* view) {
     downcast(this)->render(downcast(view));
 }
 
+void Renderer::renderViewGroup(View const* const* views, size_t const viewCount) {
+    // FView is the only implementation of View, so this cast is safe
+    downcast(this)->renderViewGroup(
+            reinterpret_cast<FView const* const*>(views), viewCount);
+}
+
+void Renderer::renderSwapChainGroup(SwapChain* const* swapChains,
+        View const* const* views, size_t const count) {
+    // FSwapChain and FView are the only implementations, so these casts are safe
+    downcast(this)->renderSwapChainGroup(
+            reinterpret_cast<FSwapChain* const*>(swapChains),
+            reinterpret_cast<FView const* const*>(views), count);
+}
+
 void Renderer::setPresentationTime(int64_t const monotonic_clock_ns) {
     downcast(this)->setPresentationTime(monotonic_clock_ns);
 }
@@ -115,4 +129,8 @@ size_t Renderer::getMaxFrameHistorySize() const noexcept {
     return downcast(this)->getMaxFrameHistorySize();
 }
 
+int64_t Renderer::getFrameStartOffsetNanos() const noexcept {
+    return downcast(this)->getFrameStartOffsetNanos();
+}
+
 } // namespace filament
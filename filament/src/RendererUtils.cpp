@@ -55,7 +55,8 @@ RendererUtils::ColorPassOutput RendererUtils::colorPass(
         ColorPassInput const& colorPassInput,
         FrameGraphTexture::Descriptor const& colorBufferDesc,
         ColorPassConfig const& config, PostProcessManager::ColorGradingConfig const colorGradingConfig,
-        RenderPass::Executor passExecutor) noexcept {
+        RenderPass const& pass,
+        RenderPass::Command const* const first, RenderPass::Command const* const last) noexcept {
 
     struct ColorPassData {
         FrameGraphId<FrameGraphTexture> shadows;
@@ -196,7 +197,7 @@ RendererUtils::ColorPassOutput RendererUtils::colorPass(
                         .layerCount = static_cast<uint8_t>(colorBufferDesc.depth),
                         .clearFlags = clearColorFlags | clearDepthFlags | clearStencilFlags});
             },
-            [=, passExecutor = std::move(passExecutor), &view, &engine](FrameGraphResources const& resources,
+            [=, &pass, &view, &engine](FrameGraphResources const& resources,
                     ColorPassData const& data, DriverApi& driver) {
                 auto out = resources.getRenderPassInfo();
 
@@ -252,7 +253,14 @@ RendererUtils::ColorPassOutput RendererUtils::colorPass(
                 }
 
                 driver.beginRenderPass(out.target, out.params);
-                passExecutor.execute(engine, driver);
+                RenderPass::Executor executor = (first || last) ?
+                        pass.getExecutor(first, last) : pass.getExecutor();
+                if (UTILS_UNLIKELY(config.hasDamage)) {
+                    // restrict shading to the view's declared damage region; content outside
+                    // of it is the render target's previous content
+                    executor.overrideScissor(config.damage);
+                }
+                executor.execute(engine, driver);
                 driver.endRenderPass();
 
                 // color pass is typically heavy, and we don't have much CPU work left after
@@ -316,7 +324,7 @@ RendererUtils::ColorPassOutput RendererUtils::refractionPass(
                     .format = config.hdrFormat
             },
             config, { .asSubpass = false, .customResolve = false },
-            pass.getExecutor(pass.begin(), refraction));
+            pass, pass.begin(), refraction);
 
 
     // Generate the mipmap chain
@@ -346,7 +354,7 @@ RendererUtils::ColorPassOutput RendererUtils::refractionPass(
                     .width = config.physicalViewport.width,
                     .height = config.physicalViewport.height },
             config, colorGradingConfig,
-            pass.getExecutor(refraction, pass.end()));
+            pass, refraction, pass.end());
 
     if (config.msaa > 1 && !colorGradingConfig.asSubpass) {
         // We need to do a resolve here because later passes (such as color grading or DoF) will
@@ -75,6 +75,10 @@ public:
         bool enabledStencilBuffer;
         // whether the screenspace reflections history buffer is initialized
         bool screenSpaceReflectionHistoryNotReady;
+        // scissor restricting the color pass to the view's damage region, in physical
+        // viewport coordinates; full viewport when hasDamage is false
+        Viewport damage{};
+        bool hasDamage = false;
     };
 
     struct ColorPassInput {
@@ -92,13 +96,18 @@ public:
         FrameGraphId<FrameGraphTexture> depth;
     };
 
+    // The pass' Executor for [first, last) -- or for the whole pass if no range is given -- is
+    // created at execute() time, so the pass' commands don't need to exist yet when the frame
+    // graph is set up (see RenderPassBuilder::buildDeferred()).
     static ColorPassOutput colorPass(
             FrameGraph& fg, const char* name, FEngine& engine, FView const& view,
             ColorPassInput const& colorPassInput,
             FrameGraphTexture::Descriptor const& colorBufferDesc,
             ColorPassConfig const& config,
             PostProcessManager::ColorGradingConfig colorGradingConfig,
-            RenderPass::Executor passExecutor) noexcept;
+            RenderPass const& pass,
+            RenderPass::Command const* first = nullptr,
+            RenderPass::Command const* last = nullptr) noexcept;
 
     static ColorPassOutput refractionPass(
             FrameGraph& fg, FEngine& engine, FView const& view,
@@ -18,6 +18,8 @@
 
 #include <filament/Engine.h>
 
+#include "MemoryMonitor.h"
+
 #include "details/Texture.h"
 
 #include <backend/DriverApiForward.h>
@@ -27,6 +29,8 @@
 
 #include "private/backend/DriverApi.h"
 
+#include <private/utils/Tracing.h>
+
 #include <utils/Logger.h>
 #include <utils/algorithm.h>
 #include <utils/bitset.h>
@@ -139,10 +143,18 @@ void ResourceAllocator::terminate() noexcept {
     auto& textureCache = mTextureCache;
     for (auto it = textureCache.begin(); it != textureCache.end();) {
         mBackend.destroyTexture(it->second.handle);
+        if (mMemoryMonitor) {
+            mMemoryMonitor->release(MemoryMonitor::Category::TRANSIENTS, it->second.size);
+        }
         it = textureCache.erase(it);
     }
 }
 
+void ResourceAllocator::setMemoryMonitor(MemoryMonitor* const monitor) noexcept {
+    mMemoryMonitor = monitor;
+    mDisposer->mMemoryMonitor = monitor;
+}
+
 RenderTargetHandle ResourceAllocator::createRenderTarget(const char* name,
         TargetBufferFlags const targetBufferFlags, uint32_t const width, uint32_t const height,
         uint8_t const samples, uint8_t const layerCount, MRT const color, TargetBufferInfo const depth,
@@ -172,14 +184,36 @@ TextureHandle ResourceAllocator::createTexture(const char* name,
 
     // do we have a suitable texture in the cache?
     TextureHandle handle;
-    TextureKey const key{ name, target, levels, format, samples, width, height, depth, usage, swizzle };
+    TextureKey key{ name, target, levels, format, samples, width, height, depth, usage, swizzle };
     if constexpr (mEnabled) {
         auto& textureCache = mTextureCache;
         auto it = textureCache.find(key);
+        if (UTILS_UNLIKELY(it == textureCache.end())) {
+            // No exact match, but a texture created with a superset of the requested usage
+            // bits is just as good. Accepting it lets transients with disjoint lifetimes
+            // alias the same backend texture even when their usages differ slightly
+            // (e.g. an extra UPLOADABLE or COLOR_ATTACHMENT bit).
+            it = std::find_if(textureCache.begin(), textureCache.end(),
+                    [&key](auto const& entry) {
+                        TextureKey const& k = entry.first;
+                        return k.target == key.target &&
+                               k.levels == key.levels &&
+                               k.format == key.format &&
+                               k.samples == key.samples &&
+                               k.width == key.width &&
+                               k.height == key.height &&
+                               k.depth == key.depth &&
+                               (k.usage & key.usage) == key.usage &&
+                               k.swizzle == key.swizzle;
+                    });
+        }
         if (UTILS_LIKELY(it != textureCache.end())) {
             // we do, move the entry to the in-use list, and remove from the cache
             handle = it->second.handle;
             mCacheSize -= it->second.size;
+            // keep the texture's real (possibly wider) usage for when it's checked back in
+            key = it->first;
+            key.name = name;
             textureCache.erase(it);
         } else {
             // we don't, allocate a new texture and populate the in-use list
@@ -191,6 +225,9 @@ TextureHandle ResourceAllocator::createTexture(const char* name,
                 mBackend.destroyTexture(handle);
                 handle = swizzledHandle;
             }
+            if (mMemoryMonitor) {
+                mMemoryMonitor->track(MemoryMonitor::Category::TRANSIENTS, key.getSize());
+            }
         }
     } else {
         handle = mBackend.createTexture(
@@ -201,6 +238,9 @@ TextureHandle ResourceAllocator::createTexture(const char* name,
             mBackend.destroyTexture(handle);
             handle = swizzledHandle;
         }
+        if (mMemoryMonitor) {
+            mMemoryMonitor->track(MemoryMonitor::Category::TRANSIENTS, key.getSize());
+        }
     }
     mDisposer->checkout(handle, key);
     mBackend.setDebugTag(handle.getId(), CString{ name });
@@ -218,6 +258,10 @@ void ResourceAllocator::destroyTexture(TextureHandle const h) noexcept {
         }
     } else {
         mBackend.destroyTexture(h);
+        if (mMemoryMonitor && key.has_value()) {
+            mMemoryMonitor->release(MemoryMonitor::Category::TRANSIENTS,
+                    key.value().getSize());
+        }
     }
 }
 
@@ -286,6 +330,12 @@ void ResourceAllocator::gc(bool const skippedFrame) noexcept {
             }
         }
     }
+
+    // gc() runs once per frame, so this samples the cache at frame granularity
+    FILAMENT_TRACING_VALUE(FILAMENT_TRACING_CATEGORY_FILAMENT,
+            "ResourceAllocator cache size", mCacheSize);
+    FILAMENT_TRACING_VALUE(FILAMENT_TRACING_CATEGORY_FILAMENT,
+            "ResourceAllocator cache entries", mTextureCache.size());
 }
 
 UTILS_NOINLINE
@@ -310,6 +360,9 @@ ResourceAllocator::purge(
         CacheContainer::iterator const& pos) {
     // DLOG(INFO) << "purging " << pos->second.handle.getId() << ", age=" << pos->second.age;
     mBackend.destroyTexture(pos->second.handle);
+    if (mMemoryMonitor) {
+        mMemoryMonitor->release(MemoryMonitor::Category::TRANSIENTS, pos->second.size);
+    }
     mCacheSize -= pos->second.size;
     return mTextureCache.erase(pos);
 }
@@ -333,6 +386,10 @@ void ResourceAllocatorDisposer::destroy(TextureHandle const handle) noexcept {
         auto r = checkin(handle);
         if (r.has_value()) {
             mBackend.destroyTexture(handle);
+            if (mMemoryMonitor) {
+                mMemoryMonitor->release(MemoryMonitor::Category::TRANSIENTS,
+                        r.value().getSize());
+            }
         }
     }
 }
@@ -39,6 +39,7 @@
 
 namespace filament {
 
+class MemoryMonitor;
 class ResourceAllocatorDisposer;
 
 // The only reason we use an interface here is for unit-tests, so we can mock this allocator.
@@ -91,6 +92,9 @@ public:
 
     void terminate() noexcept;
 
+    // reports transient texture allocations to the engine's memory dashboard (optional)
+    void setMemoryMonitor(MemoryMonitor* monitor) noexcept;
+
     backend::RenderTargetHandle createRenderTarget(const char* name,
             backend::TargetBufferFlags targetBufferFlags,
             uint32_t width,
@@ -220,6 +224,7 @@ private:
 
     backend::DriverApi& mBackend;
     std::shared_ptr<ResourceAllocatorDisposer> mDisposer;
+    MemoryMonitor* mMemoryMonitor = nullptr;
     CacheContainer mTextureCache;
     size_t mAge = 0;
     uint32_t mCacheSize = 0;
@@ -244,6 +249,7 @@ private:
 
     using InUseContainer = ResourceAllocator::AssociativeContainer<backend::TextureHandle, TextureKey>;
     backend::DriverApi& mBackend;
+    MemoryMonitor* mMemoryMonitor = nullptr;
     InUseContainer mInUseTextures;
 };
 
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SceneBvh.h"
+
+#include "Culler.h"
+
+#include <private/utils/Tracing.h>
+
+#include <utils/debug.h>
+
+#include <math/vec4.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <string.h>
+
+using namespace filament::math;
+
+namespace filament {
+
+void SceneBvh::update(FScene::RenderableSoa const& soa) noexcept {
+    size_t const count = soa.size();
+    if (UTILS_LIKELY(count < MIN_RENDERABLE_COUNT)) {
+        // not worth a traversal, callers fall back to the linear loop
+        mNodes.clear();
+        mPrimitives.clear();
+        mInstances.clear();
+        return;
+    }
+    if (isValidFor(soa)) {
+        refit(soa);
+    } else {
+        build(soa);
+    }
+}
+
+bool SceneBvh::isValidFor(FScene::RenderableSoa const& soa) const noexcept {
+    auto const* const instances = soa.data<FScene::RENDERABLE_INSTANCE>();
+    return !mNodes.empty() && mInstances.size() == soa.size() &&
+            !memcmp(mInstances.data(), instances, soa.size() * sizeof(instances[0]));
+}
+
+uint32_t SceneBvh::buildNode(FScene::RenderableSoa const& soa,
+        uint32_t const first, uint32_t const count) noexcept {
+    float3 const* const center = soa.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const extent = soa.data<FScene::WORLD_AABB_EXTENT>();
+
+    uint32_t const nodeIndex = uint32_t(mNodes.size());
+    mNodes.push_back({});
+
+    // subtree bounds and centroid bounds
+    float3 lo = std::numeric_limits<float>::max();
+    float3 hi = std::numeric_limits<float>::lowest();
+    float3 clo = lo;
+    float3 chi = hi;
+    for (uint32_t i = first; i < first + count; i++) {
+        uint32_t const p = mPrimitives[i];
+        lo = min(lo, center[p] - extent[p]);
+        hi = max(hi, center[p] + extent[p]);
+        clo = min(clo, center[p]);
+        chi = max(chi, center[p]);
+    }
+
+    Node node;
+    node.center = (lo + hi) * 0.5f;
+    node.extent = (hi - lo) * 0.5f;
+    node.first = first;
+    node.count = count;
+
+    if (count > LEAF_SIZE) {
+        // median split on the longest axis of the centroid bounds
+        float3 const d = chi - clo;
+        size_t const axis = (d.x > d.y) ? (d.x > d.z ? 0 : 2) : (d.y > d.z ? 1 : 2);
+        uint32_t const half = count / 2;
+        std::nth_element(
+                mPrimitives.begin() + first,
+                mPrimitives.begin() + first + half,
+                mPrimitives.begin() + first + count,
+                [center, axis](uint32_t const lhs, uint32_t const rhs) {
+                    return center[lhs][axis] < center[rhs][axis];
+                });
+        node.left = buildNode(soa, first, half);
+        UTILS_UNUSED_IN_RELEASE uint32_t const right =
+                buildNode(soa, first + half, count - half);
+        assert_invariant(right == node.left + 1 || right > node.left);
+    }
+
+    mNodes[nodeIndex] = node;
+    return nodeIndex;
+}
+
+void SceneBvh::build(FScene::RenderableSoa const& soa) noexcept {
+    FILAMENT_TRACING_NAME(FILAMENT_TRACING_CATEGORY_FILAMENT, "SceneBvh::build");
+    size_t const count = soa.size();
+    auto const* const instances = soa.data<FScene::RENDERABLE_INSTANCE>();
+
+    mNodes.clear();
+    mNodes.reserve(2 * count / LEAF_SIZE + 1);
+    mPrimitives.resize(count);
+    std::iota(mPrimitives.begin(), mPrimitives.end(), 0u);
+    buildNode(soa, 0, uint32_t(count));
+
+    mInstances.assign(instances, instances + count);
+}
+
+void SceneBvh::refit(FScene::RenderableSoa const& soa) noexcept {
+    FILAMENT_TRACING_NAME(FILAMENT_TRACING_CATEGORY_FILAMENT, "SceneBvh::refit");
+    float3 const* const center = soa.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const extent = soa.data<FScene::WORLD_AABB_EXTENT>();
+
+    // children always have a larger index than their parent, so a reverse walk
+    // visits them first
+    for (size_t i = mNodes.size(); i-- > 0;) {
+        Node& node = mNodes[i];
+        if (node.left) {
+            Node const& l = mNodes[node.left];
+            Node const& r = mNodes[node.left + 1];
+            float3 const lo = min(l.center - l.extent, r.center - r.extent);
+            float3 const hi = max(l.center + l.extent, r.center + r.extent);
+            node.center = (lo + hi) * 0.5f;
+            node.extent = (hi - lo) * 0.5f;
+        } else {
+            float3 lo = std::numeric_limits<float>::max();
+            float3 hi = std::numeric_limits<float>::lowest();
+            for (uint32_t j = node.first; j < node.first + node.count; j++) {
+                uint32_t const p = mPrimitives[j];
+                lo = min(lo, center[p] - extent[p]);
+                hi = max(hi, center[p] + extent[p]);
+            }
+            node.center = (lo + hi) * 0.5f;
+            node.extent = (hi - lo) * 0.5f;
+        }
+    }
+}
+
+void SceneBvh::cull(Frustum const& frustum, FScene::RenderableSoa& soa,
+        size_t const bit) const noexcept {
+    FILAMENT_TRACING_NAME(FILAMENT_TRACING_CATEGORY_FILAMENT, "SceneBvh::cull");
+    assert_invariant(!mNodes.empty());
+
+    float3 const* const UTILS_RESTRICT center = soa.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const UTILS_RESTRICT extent = soa.data<FScene::WORLD_AABB_EXTENT>();
+    FScene::VisibleMaskType* const UTILS_RESTRICT visibleArray =
+            soa.data<FScene::VISIBLE_MASK>();
+
+    float4 planes[6];
+    frustum.getNormalizedPlanes(planes);
+
+    FScene::VisibleMaskType const mask = FScene::VisibleMaskType(1u << bit);
+
+    auto const setRange = [this, visibleArray, mask](
+            uint32_t const first, uint32_t const count, bool const visible) {
+        for (uint32_t i = first; i < first + count; i++) {
+            auto r = visibleArray[mPrimitives[i]];
+            r &= ~mask;
+            r |= visible ? mask : FScene::VisibleMaskType(0);
+            visibleArray[mPrimitives[i]] = r;
+        }
+    };
+
+    uint32_t stack[64];
+    size_t sp = 0;
+    stack[sp++] = 0;
+    while (sp) {
+        Node const& node = mNodes[stack[--sp]];
+
+        // classify the node's AABB against all six planes
+        bool outside = false;
+        bool inside = true;
+        for (auto const& p : planes) {
+            float const dc = p.x * node.center.x + p.y * node.center.y
+                    + p.z * node.center.z + p.w;
+            float const r = std::abs(p.x) * node.extent.x
+                    + std::abs(p.y) * node.extent.y
+                    + std::abs(p.z) * node.extent.z;
+            if (dc - r >= 0.0f) {
+                outside = true;
+                break;
+            }
+            inside = inside && (dc + r < 0.0f);
+        }
+
+        if (UTILS_LIKELY(outside || inside)) {
+            // the whole subtree is rejected or accepted at once
+            setRange(node.first, node.count, inside);
+        } else if (node.left) {
+            assert_invariant(sp + 2 <= std::size(stack));
+            stack[sp++] = node.left;
+            stack[sp++] = node.left + 1;
+        } else {
+            // straddling leaf: test each primitive like Culler::intersects()
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                uint32_t const p = mPrimitives[i];
+                int visible = ~0;
+                for (auto const& plane : planes) {
+                    float const dot =
+                            plane.x * center[p].x - std::abs(plane.x) * extent[p].x +
+                            plane.y * center[p].y - std::abs(plane.y) * extent[p].y +
+                            plane.z * center[p].z - std::abs(plane.z) * extent[p].z +
+                            plane.w;
+                    visible &= int(dot < 0.0f);
+                }
+                auto r = visibleArray[p];
+                r &= ~mask;
+                r |= visible ? mask : FScene::VisibleMaskType(0);
+                visibleArray[p] = r;
+            }
+        }
+    }
+}
+
+} // namespace filament
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_SCENEBVH_H
+#define TNT_FILAMENT_SCENEBVH_H
+
+#include "details/Scene.h"
+
+#include <filament/Frustum.h>
+
+#include <math/vec3.h>
+
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * A bounding-volume hierarchy over FScene's RenderableSoa, used to cull whole subtrees
+ * instead of testing every renderable against the frustum. The hierarchy is refit
+ * incrementally each frame from the current world-space AABBs; a full rebuild only
+ * happens when the renderable list itself changes (checked against the
+ * RENDERABLE_INSTANCE column).
+ *
+ * The hierarchy is indexed by SoA position, so it is only valid between FScene::prepare()
+ * and the visibility partition in FView::prepare() -- i.e. exactly where culling runs.
+ */
+class SceneBvh {
+public:
+    // Below this number of renderables the linear Culler loop is faster than a traversal.
+    static constexpr size_t MIN_RENDERABLE_COUNT = 1024;
+
+    // Rebuilds or refits the hierarchy for the given renderable data. Clears the
+    // hierarchy when the scene is too small to benefit from it.
+    void update(FScene::RenderableSoa const& soa) noexcept;
+
+    // Whether the hierarchy matches the given renderable data (same renderables, in order).
+    bool isValidFor(FScene::RenderableSoa const& soa) const noexcept;
+
+    // Sets or clears `bit` of VISIBLE_MASK for every renderable, with the same results
+    // as Culler::intersects() over the whole array.
+    void cull(Frustum const& frustum, FScene::RenderableSoa& soa, size_t bit) const noexcept;
+
+private:
+    struct Node {
+        math::float3 center;        // world-space AABB center of the subtree
+        math::float3 extent;        // world-space AABB half-extent of the subtree
+        uint32_t left = 0;          // index of the left child (right is left + 1), 0 for leaves
+        uint32_t first = 0;         // first entry in mPrimitives covered by this subtree
+        uint32_t count = 0;         // number of entries covered by this subtree
+    };
+
+    // Leaves batch a few primitives so the per-primitive loop stays tight.
+    static constexpr size_t LEAF_SIZE = 8;
+
+    void build(FScene::RenderableSoa const& soa) noexcept;
+    void refit(FScene::RenderableSoa const& soa) noexcept;
+    uint32_t buildNode(FScene::RenderableSoa const& soa,
+            uint32_t first, uint32_t count) noexcept;
+
+    std::vector<Node> mNodes;
+    std::vector<uint32_t> mPrimitives;  // permutation of SoA indices, partitioned per subtree
+    std::vector<utils::EntityInstance<RenderableManager>> mInstances;   // topology key
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_SCENEBVH_H
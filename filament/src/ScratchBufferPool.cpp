@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ScratchBufferPool.h"
+
+#include <utils/algorithm.h>
+#include <utils/compiler.h>
+#include <utils/debug.h>
+
+#include <mutex>
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace filament {
+
+using namespace utils;
+
+ScratchBufferPool::ScratchBufferPool() noexcept {
+    for (auto& bucket : mBuckets) {
+        bucket = Container::with_capacity(ENTRIES_PER_BUCKET);
+    }
+}
+
+ScratchBufferPool::~ScratchBufferPool() noexcept {
+    trim();
+#ifndef NDEBUG
+    for (auto const& accounting : mAccounting) {
+        assert_invariant(accounting.outstandingBytes == 0);
+    }
+#endif
+}
+
+size_t ScratchBufferPool::bucketIndex(size_type const size) noexcept {
+    const size_t needed = size + sizeof(Header);
+    // ceil(log2(needed)), needed is always >= sizeof(Header) + 1
+    const size_t log2 = (sizeof(needed) * 8) - clz(needed - 1);
+    return log2 <= MIN_SIZE_SHIFT ? 0 : log2 - MIN_SIZE_SHIFT;
+}
+
+void ScratchBufferPool::deallocate(Header* const p) noexcept {
+    mAllocator.free(p);
+}
+
+void* ScratchBufferPool::get(size_type const size, Tag const tag) noexcept {
+    const size_t bucket = bucketIndex(size);
+
+    // requests too large for the largest bucket are serviced but not pooled
+    if (UTILS_UNLIKELY(bucket >= BUCKET_COUNT)) {
+        Header* const p = static_cast<Header*>(mAllocator.alloc(size + sizeof(Header)));
+        p->size = size;
+        p->bucket = OVERSIZED;
+        p->tag = uint8_t(tag);
+        std::lock_guard const guard(mLock);
+        mAccounting[size_t(tag)].outstandingBytes += size;
+        return p + 1;
+    }
+
+    const size_type usableSize = bucketSize(bucket) - sizeof(Header);
+
+    std::lock_guard const guard(mLock);
+    mAccounting[size_t(tag)].outstandingBytes += usableSize;
+
+    Container& entries = mBuckets[bucket];
+    if (UTILS_LIKELY(!entries.empty())) {
+        Header* const p = entries.back();
+        entries.pop_back();
+        assert_invariant(p->size == usableSize);
+        mAccounting[size_t(p->tag)].pooledBytes -= p->size;
+        p->tag = uint8_t(tag);
+        return p + 1;
+    }
+
+    Header* const p = static_cast<Header*>(mAllocator.alloc(bucketSize(bucket)));
+    p->size = usableSize;
+    p->bucket = uint8_t(bucket);
+    p->tag = uint8_t(tag);
+    return p + 1;
+}
+
+void ScratchBufferPool::put(void* const buffer) noexcept {
+    Header* const p = static_cast<Header*>(buffer) - 1;
+
+    if (UTILS_UNLIKELY(p->bucket == OVERSIZED)) {
+        std::lock_guard const guard(mLock);
+        mAccounting[size_t(p->tag)].outstandingBytes -= p->size;
+        deallocate(p);
+        return;
+    }
+
+    assert_invariant(p->bucket < BUCKET_COUNT);
+    assert_invariant(p->size == bucketSize(p->bucket) - sizeof(Header));
+
+    std::lock_guard const guard(mLock);
+    mAccounting[size_t(p->tag)].outstandingBytes -= p->size;
+
+    Container& entries = mBuckets[p->bucket];
+    if (UTILS_UNLIKELY(entries.size() == entries.capacity())) {
+        deallocate(p);
+        return;
+    }
+    mAccounting[size_t(p->tag)].pooledBytes += p->size;
+    entries.push_back(p);
+}
+
+void ScratchBufferPool::trim() noexcept {
+    std::lock_guard const guard(mLock);
+    for (auto& entries : mBuckets) {
+        for (Header* const p : entries) {
+            mAccounting[size_t(p->tag)].pooledBytes -= p->size;
+            deallocate(p);
+        }
+        entries.clear();
+    }
+}
+
+ScratchBufferPool::Accounting ScratchBufferPool::getAccounting(Tag const tag) const noexcept {
+    std::lock_guard const guard(mLock);
+    return mAccounting[size_t(tag)];
+}
+
+} // namespace filament
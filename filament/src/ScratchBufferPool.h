@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_SCRATCHBUFFERPOOL_H
+#define TNT_FILAMENT_SCRATCHBUFFERPOOL_H
+
+#include <utils/Allocator.h>
+#include <utils/FixedCapacityVector.h>
+#include <utils/Mutex.h>
+
+#include <array>
+#include <memory>
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace filament {
+
+/*
+ * An engine-scoped pool for short-lived heap buffers (UBO staging, readbacks, ...), shared by
+ * subsystems that would otherwise each keep a private scratch pool. Unlike BufferPoolAllocator,
+ * buffers are pooled in power-of-two size buckets, so mixed-size usage doesn't defeat reuse.
+ * Each allocation carries a subsystem tag used for accounting, and trim() releases everything
+ * the pool holds, so the engine can shed scratch memory under pressure (see
+ * Engine::trimMemory()). All member functions are thread-safe.
+ */
+class ScratchBufferPool {
+public:
+    using size_type = uint32_t;
+
+    // which subsystem is allocating, only used for accounting
+    enum class Tag : uint8_t {
+        SCENE,          // per-frame UBO staging (FScene)
+        FROXELIZER,     // froxelization scratch
+        READBACK,       // pixel readback staging
+        OTHER
+    };
+    static constexpr size_t TAG_COUNT = 4;
+
+    ScratchBufferPool() noexcept;
+
+    // pool is neither copyable nor movable, it's shared by reference
+    ScratchBufferPool(ScratchBufferPool const&) = delete;
+    ScratchBufferPool& operator=(ScratchBufferPool const&) = delete;
+
+    // frees all pooled buffers; all outstanding buffers must have been returned
+    ~ScratchBufferPool() noexcept;
+
+    // returns a buffer of at least size bytes
+    void* get(size_type size, Tag tag) noexcept;
+
+    // returns a buffer to the pool
+    void put(void* buffer) noexcept;
+
+    // releases all pooled (i.e. not outstanding) buffers back to the system
+    void trim() noexcept;
+
+    struct Accounting {
+        uint64_t outstandingBytes = 0;  // handed out by get() and not yet returned
+        uint64_t pooledBytes = 0;       // held by the pool, released by trim()
+    };
+    Accounting getAccounting(Tag tag) const noexcept;
+
+private:
+    struct alignas(alignof(std::max_align_t)) Header {
+        size_type size;     // usable size of the buffer (excludes the header)
+        uint8_t bucket;     // bucket index, or OVERSIZED
+        uint8_t tag;
+    };
+
+    static constexpr size_t MIN_SIZE_SHIFT = 12;    // smallest bucket is 4 KiB
+    static constexpr size_t BUCKET_COUNT = 12;      // largest bucket is 8 MiB
+    static constexpr size_t ENTRIES_PER_BUCKET = 4;
+    static constexpr uint8_t OVERSIZED = 0xff;      // not pooled, freed on put()
+
+    // total allocation size of a bucket's buffers, including the header
+    static constexpr size_type bucketSize(size_t const bucket) noexcept {
+        return size_type(1u) << (MIN_SIZE_SHIFT + bucket);
+    }
+
+    // smallest bucket whose buffers can hold size bytes, or >= BUCKET_COUNT if none can
+    static size_t bucketIndex(size_type size) noexcept;
+
+    void deallocate(Header* p) noexcept;
+
+    using Container = utils::FixedCapacityVector<Header*, std::allocator<Header*>, false>;
+    mutable utils::Mutex mLock;
+    std::array<Container, BUCKET_COUNT> mBuckets;
+    Accounting mAccounting[TAG_COUNT];
+    utils::HeapAllocator mAllocator;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_SCRATCHBUFFERPOOL_H
@@ -272,7 +272,7 @@ ShadowMap::ShaderParameters ShadowMap::updatePunctual(
     const mat4f Mp = mat4f::perspective(
             outerConeAngle * f::RAD_TO_DEG * 2.0f, 1.0f, nearPlane, farPlane);
 
-    assert_invariant(shadowMapInfo.textureDimension == mOptions->mapSize);
+    assert_invariant(shadowMapInfo.textureDimension == mDimension);
 
     // Final shadow transform
     const mat4f S = highPrecisionMultiply(Mp, Mv);
@@ -942,14 +942,34 @@ size_t ShadowMap::intersectFrustumWithBox(
     // world-space scene volume
     const Aabb::Corners boxCorners = box.getCorners();
 
+    // Transposes 4 points into one float4 per axis, so that the containment tests below can
+    // process four corners at a time with vector (SIMD) arithmetic.
+    auto const transpose4 = [](float4& x, float4& y, float4& z,
+            float3 const* UTILS_RESTRICT p) {
+        for (size_t i = 0; i < 4; i++) {
+            x[i] = p[i].x;
+            y[i] = p[i].y;
+            z[i] = p[i].z;
+        }
+    };
+
     // a) Keep the frustum's vertices that are known to be inside the scene's box
+    //
+    // For each batch of four corners we compute the largest signed distance to the six faces
+    // of the box; a corner is inside when that distance is negative or null.
+    float4 boxDistance[2];
+    for (size_t b = 0; b < 2; b++) {
+        float4 x, y, z;
+        transpose4(x, y, z, frustumVertices.vertices + b * 4);
+        boxDistance[b] = max(
+                max(max(box.min.x - x, x - box.max.x), max(box.min.y - y, y - box.max.y)),
+                max(box.min.z - z, z - box.max.z));
+    }
+
     UTILS_NOUNROLL
     for (size_t i = 0; i < 8; i++) {
-        float3 const p = frustumVertices[i];
-        outVertices[vertexCount] = p;
-        if ((p.x >= box.min.x && p.x <= box.max.x) &&
-            (p.y >= box.min.y && p.y <= box.max.y) &&
-            (p.z >= box.min.z && p.z <= box.max.z)) {
+        outVertices[vertexCount] = frustumVertices[i];
+        if (boxDistance[i / 4][i % 4] <= 0.0f) {
             vertexCount++;
         }
     }
@@ -964,18 +984,26 @@ size_t ShadowMap::intersectFrustumWithBox(
         // We need to handle the case where a corner of the box lies exactly on a plane of
         // the frustum. This actually often happens due to fitting light-space
         // We fudge the distance to the plane by a small amount.
-        #pragma nounroll
-        for (float3 const p : boxCorners) {
-            outVertices[vertexCount] = p;
-            float const l = dot(frustumPlanes[0].xyz, p) + frustumPlanes[0].w;
-            float const b = dot(frustumPlanes[1].xyz, p) + frustumPlanes[1].w;
-            float const r = dot(frustumPlanes[2].xyz, p) + frustumPlanes[2].w;
-            float const t = dot(frustumPlanes[3].xyz, p) + frustumPlanes[3].w;
-            float const f = dot(frustumPlanes[4].xyz, p) + frustumPlanes[4].w;
-            float const n = dot(frustumPlanes[5].xyz, p) + frustumPlanes[5].w;
-            if ((l <= EPSILON) && (b <= EPSILON) &&
-                (r <= EPSILON) && (t <= EPSILON) &&
-                (f <= EPSILON) && (n <= EPSILON)) {
+        //
+        // As in step (a), the corners are processed four at a time, keeping for each one its
+        // largest signed distance to the six frustum planes.
+        float4 planeDistance[2];
+        for (size_t b = 0; b < 2; b++) {
+            float4 x, y, z;
+            transpose4(x, y, z, boxCorners.vertices + b * 4);
+            float4 d{ -std::numeric_limits<float>::infinity() };
+            UTILS_NOUNROLL
+            for (size_t j = 0; j < 6; j++) {
+                float4 const plane = frustumPlanes[j];
+                d = max(d, x * plane.x + y * plane.y + z * plane.z + plane.w);
+            }
+            planeDistance[b] = d;
+        }
+
+        UTILS_NOUNROLL
+        for (size_t i = 0; i < 8; i++) {
+            outVertices[vertexCount] = boxCorners.vertices[i];
+            if (planeDistance[i / 4][i % 4] <= EPSILON) {
                 vertexCount++;
             }
         }
@@ -1072,49 +1100,49 @@ size_t ShadowMap::intersectFrustum(
     return vertexCount;
 }
 
-UTILS_ALWAYS_INLINE
-inline bool ShadowMap::intersectSegmentWithTriangle(float3& UTILS_RESTRICT p,
-        float3 s0, float3 s1,
-        float3 t0, float3 t1, float3 t2) noexcept {
+bool ShadowMap::intersectSegmentWithPlanarQuad(float3& UTILS_RESTRICT p,
+        float3 s0, float3 s1, float3 t0, float3 t1, float3 t2, float3 t3) noexcept {
     // See Real-Time Rendering -- Tomas Akenine-Moller, Eric Haines, Naty Hoffman
+    // The quad is split along its (t0, t2) diagonal and both triangles are tested
+    // unconditionally; they share the segment terms and the (t2 - t0) edge, and evaluating
+    // them together branchlessly keeps the math in vector registers instead of generating
+    // hard-to-predict early-out branches.
     constexpr const float EPSILON = 1.0f / 65536.0f;  // ~1e-5
-    const auto e1 = t1 - t0;
-    const auto e2 = t2 - t0;
-    const auto d = s1 - s0;
-    const auto q = cross(d, e2);
-    const auto a = dot(e1, q);
-    if (UTILS_UNLIKELY(std::abs(a) < EPSILON)) {
-        // degenerate triangle
-        return false;
-    }
-    const auto s = s0 - t0;
-    const auto u = dot(s, q) * sign(a);
-    const auto r = cross(s, e1);
-    const auto v = dot(d, r) * sign(a);
-    if (u < 0 || v < 0 || u + v > std::abs(a)) {
-        // the ray doesn't intersect within the triangle
-        return false;
-    }
-    const auto t = dot(e2, r) * sign(a);
-    if (t < 0 || t > std::abs(a)) {
-        // the intersection isn't on the segment
-        return false;
+    const float3 d = s1 - s0;
+    const float3 s = s0 - t0;
+    const float3 e1a = t1 - t0;
+    const float3 e2a = t2 - t0;     // shared: also the first edge of the second triangle
+    const float3 e2b = t3 - t0;
+    const float3 qa = cross(d, e2a);
+    const float3 qb = cross(d, e2b);
+    const float3 ra = cross(s, e1a);
+    const float3 rb = cross(s, e2a);
+    const float aa = dot(e1a, qa);
+    const float ab = dot(e2a, qb);
+    const float ua = dot(s, qa) * sign(aa);
+    const float ub = dot(s, qb) * sign(ab);
+    const float va = dot(d, ra) * sign(aa);
+    const float vb = dot(d, rb) * sign(ab);
+    const float ta = dot(e2a, ra) * sign(aa);
+    const float tb = dot(e2b, rb) * sign(ab);
+    // a triangle is rejected when it is degenerate (|a| < EPSILON), when the segment doesn't
+    // intersect its plane within the triangle (u, v), or when the intersection isn't on the
+    // segment (t)
+    const bool hita = (std::abs(aa) >= EPSILON) &
+            (ua >= 0) & (va >= 0) & (ua + va <= std::abs(aa)) &
+            (ta >= 0) & (ta <= std::abs(aa));
+    const bool hitb = (std::abs(ab) >= EPSILON) &
+            (ub >= 0) & (vb >= 0) & (ub + vb <= std::abs(ab)) &
+            (tb >= 0) & (tb <= std::abs(ab));
+    if (hita | hitb) {
+        // when both triangles are hit, the intersection lies on their shared diagonal and
+        // either solution is valid; we keep the first one
+        const float t = hita ? ta : tb;
+        const float a = hita ? aa : ab;
+        p = s0 + d * (t / std::abs(a));
+        return true;
     }
-
-    // compute the intersection point
-    //      Alternate computation: from barycentric coordinates on the triangle
-    //      const auto w = 1 - (u + v) / std::abs(a);
-    //      p = w * t0 + u / std::abs(a) * t1 + v / std::abs(a) * t2;
-
-    p = s0 + d * (t / std::abs(a));
-    return true;
-}
-
-bool ShadowMap::intersectSegmentWithPlanarQuad(float3& UTILS_RESTRICT p,
-        float3 s0, float3 s1, float3 t0, float3 t1, float3 t2, float3 t3) noexcept {
-    bool const hit = intersectSegmentWithTriangle(p, s0, s1, t0, t1, t2) ||
-                     intersectSegmentWithTriangle(p, s0, s1, t0, t2, t3);
-    return hit;
+    return false;
 }
 
 float ShadowMap::texelSizeWorldSpace(const mat3f& worldToShadowTexture,
@@ -1297,9 +1325,11 @@ void ShadowMap::updateSceneInfoSpot(mat4f const& Mv, FScene const& scene,
             }
     );
 }
-void ShadowMap::setAllocation(uint8_t const layer, backend::Viewport viewport) noexcept {
+void ShadowMap::setAllocation(uint8_t const layer, backend::Viewport viewport,
+        uint16_t const dimension) noexcept {
     mLayer = layer;
     mOffset = { viewport.left, viewport.bottom };
+    mDimension = dimension;
 }
 
 backend::Viewport ShadowMap::getViewport() const noexcept {
@@ -1308,7 +1338,7 @@ backend::Viewport ShadowMap::getViewport() const noexcept {
     // or when shadowFar is smaller than the camera far.
     // For spot- and point-lights we also use a 1-texel border, so that bilinear filtering
     // can work properly if the shadowmap is in an atlas (and we can't rely on h/w clamp).
-    const uint32_t dim = mOptions->mapSize;
+    const uint32_t dim = mDimension;
     const uint16_t border = 1u;
     return { mOffset.x + border, mOffset.y + border, dim - 2u * border, dim - 2u * border };
 }
@@ -1320,7 +1350,7 @@ backend::Viewport ShadowMap::getScissor() const noexcept {
     // For spot- and point-lights we also use a 1-texel border, so that bilinear filtering
     // can work properly if the shadowmap is in an atlas (and we can't rely on h/w clamp), so we
     // don't scissor the border, so it gets filled with correct neighboring texels.
-    const uint32_t dim = mOptions->mapSize;
+    const uint32_t dim = mDimension;
     const uint16_t border = 1u;
     switch (mShadowType) {
         case ShadowType::DIRECTIONAL:
@@ -1349,7 +1379,7 @@ float4 ShadowMap::getClampToEdgeCoords(ShadowMapInfo const& shadowMapInfo) const
     }
 
     float const texel = 1.0f / float(shadowMapInfo.atlasDimension);
-    float const dim = float(mOptions->mapSize);
+    float const dim = float(mDimension);
     float const l = float(mOffset.x) + border;
     float const b = float(mOffset.y) + border;
     float const w = dim - 2.0f * border;
@@ -1399,4 +1429,9 @@ void ShadowMap::bind(DriverApi& driver) const noexcept {
     mPerShadowMapUniforms.bind(driver);
 }
 
+size_t ShadowMap::Test::intersectFrustumWithBox(FrustumBoxIntersection& outVertices,
+        mat4f const& projection, Aabb const& box) {
+    return ShadowMap::intersectFrustumWithBox(outVertices, projection, box);
+}
+
 } // namespace filament
@@ -27,6 +27,8 @@
 
 #include "components/LightManager.h"
 
+#include <private/filament/EngineEnums.h>
+
 #include <backend/DriverApiForward.h>
 #include <backend/DriverEnums.h>
 
@@ -55,6 +57,7 @@ class RenderPass;
 // VISIBLE_RENDERABLE                            X
 // VISIBLE_DIR_SHADOW_RENDERABLE               X
 // VISIBLE_DYN_SHADOW_RENDERABLE             X
+// VISIBLE_EYE_RENDERABLE            X X X X
 
 // A "shadow renderable" is a renderable rendered to the shadow map during a shadow pass:
 // PCF shadows: only shadow casters
@@ -63,10 +66,18 @@ class RenderPass;
 static constexpr size_t VISIBLE_RENDERABLE_BIT              = 0u;
 static constexpr size_t VISIBLE_DIR_SHADOW_RENDERABLE_BIT   = 1u;
 static constexpr size_t VISIBLE_DYN_SHADOW_RENDERABLE_BIT   = 2u;
+// one bit per eye with instanced stereo rendering, set when the renderable intersects
+// that eye's frustum (see FView::cullRenderablesPerEye())
+static constexpr size_t VISIBLE_EYE_0_RENDERABLE_BIT        = 3u;
 
 static constexpr Culler::result_type VISIBLE_RENDERABLE = 1u << VISIBLE_RENDERABLE_BIT;
 static constexpr Culler::result_type VISIBLE_DIR_SHADOW_RENDERABLE = 1u << VISIBLE_DIR_SHADOW_RENDERABLE_BIT;
 static constexpr Culler::result_type VISIBLE_DYN_SHADOW_RENDERABLE = 1u << VISIBLE_DYN_SHADOW_RENDERABLE_BIT;
+static constexpr Culler::result_type VISIBLE_EYES_MASK =
+        ((1u << CONFIG_MAX_STEREOSCOPIC_EYES) - 1u) << VISIBLE_EYE_0_RENDERABLE_BIT;
+
+static_assert(VISIBLE_EYE_0_RENDERABLE_BIT + CONFIG_MAX_STEREOSCOPIC_EYES
+        <= sizeof(Culler::result_type) * 8, "too many stereoscopic eyes for the visibility mask");
 
 class ShadowMap {
 public:
@@ -179,7 +190,9 @@ public:
     LightManager::ShadowOptions const* getShadowOptions() const noexcept { return mOptions; }
     size_t getLightIndex() const { return mLightIndex; }
     uint16_t getShadowIndex() const { return mShadowIndex; }
-    void setAllocation(uint8_t layer, backend::Viewport viewport) noexcept;
+    // dimension is the effective map size for this frame; it is normally
+    // ShadowOptions::mapSize, but can be reduced by the View's adaptive quality governor.
+    void setAllocation(uint8_t layer, backend::Viewport viewport, uint16_t dimension) noexcept;
 
     uint8_t getLayer() const noexcept { return mLayer; }
     backend::Viewport getViewport() const noexcept;
@@ -287,15 +300,11 @@ private:
     static inline math::float2 computeNearFarOfWarpSpace(math::mat4f const& lightView,
             math::float3 const* wsVertices, size_t count) noexcept;
 
-    static inline bool intersectSegmentWithPlanarQuad(math::float3& p,
+    static inline bool intersectSegmentWithPlanarQuad(math::float3& UTILS_RESTRICT p,
             math::float3 s0, math::float3 s1,
             math::float3 t0, math::float3 t1,
             math::float3 t2, math::float3 t3) noexcept;
 
-    static inline bool intersectSegmentWithTriangle(math::float3& UTILS_RESTRICT p,
-            math::float3 s0, math::float3 s1,
-            math::float3 t0, math::float3 t1, math::float3 t2) noexcept;
-
     static size_t intersectFrustum(math::float3* out, size_t vertexCount,
             math::float3 const* segmentsVertices, math::float3 const* quadsVertices) noexcept;
 
@@ -355,7 +364,16 @@ private:
     bool mHasVisibleShadows : 1;                                            // :1
     uint8_t mFace           : 3;                                            // :3
     math::ushort2 mOffset{};                                                // 4
-    UTILS_UNUSED uint8_t reserved[4];                                       // 4
+    uint16_t mDimension = 0;    // effective map size this frame            // 2
+    UTILS_UNUSED uint8_t reserved[2];                                       // 2
+
+public:
+    // these are only needed for benchmarking
+    struct UTILS_PUBLIC Test {
+        using FrustumBoxIntersection = ShadowMap::FrustumBoxIntersection;
+        static size_t intersectFrustumWithBox(FrustumBoxIntersection& outVertices,
+                math::mat4f const& projection, Aabb const& box);
+    };
 };
 
 } // namespace filament
@@ -63,6 +63,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 namespace filament {
 
@@ -78,6 +79,8 @@ ShadowMapManager::ShadowMapManager(FEngine& engine)
             &engine.debug.shadowmap.disable_light_frustum_align);
     debugRegistry.registerProperty("d.shadowmap.depth_clamp",
             &engine.debug.shadowmap.depth_clamp);
+    debugRegistry.registerProperty("d.shadowmap.update_interval",
+            &engine.debug.shadowmap.update_interval);
 
     mFeatureShadowAllocator = engine.features.engine.shadows.use_shadow_atlas;
 }
@@ -114,6 +117,9 @@ void ShadowMapManager::terminate(FEngine& engine) {
     if (UTILS_UNLIKELY(mInitialized)) {
         DriverApi& driver = engine.getDriverApi();
         driver.destroyBufferObject(mShadowUbh);
+        if (mShadowAtlasTexture) {
+            driver.destroyTexture(mShadowAtlasTexture);
+        }
         UTILS_NOUNROLL
         for (auto& entry: mShadowMapCache) {
             std::launder(reinterpret_cast<ShadowMap*>(&entry))->terminate(engine);
@@ -161,6 +167,10 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::update(
 
     calculateTextureRequirements(engine, view, lightData);
 
+    // Decide which shadow maps are re-rendered this frame, and manage the persistent
+    // atlas texture needed to reuse the others.
+    updateShadowMapSchedule(engine, cameraInfo, renderableData, lightData);
+
     // Compute scene-dependent values shared across all shadow maps
     ShadowMap::SceneInfo const info{ *view.getScene(), view.getVisibleLayers() };
 
@@ -175,6 +185,154 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::update(
     return shadowTechnique;
 }
 
+// Returns true if any shadow caster not flagged castShadowsStatic intersects the given
+// frustum. `offset` rebases the renderables' positions to the world origin the frustum was
+// computed with (the rotation part of the world transform is ignored; a change of the IBL
+// rotation moves the light direction, which forces a re-render on its own).
+static bool intersectsDynamicCasters(FScene::RenderableSoa const& renderableData,
+        Frustum const& frustum, float3 const offset) noexcept {
+    auto const* const UTILS_RESTRICT visibility =
+            renderableData.data<FScene::VISIBILITY_STATE>();
+    auto const* const UTILS_RESTRICT center = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    auto const* const UTILS_RESTRICT extent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+    for (size_t i = 0, c = renderableData.size(); i < c; i++) {
+        auto const v = visibility[i];
+        if (v.castShadows && !v.castShadowsStatic) {
+            if (frustum.intersects({ center[i] + offset, extent[i] })) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ShadowMapManager::updateShadowMapSchedule(FEngine& engine,
+        CameraInfo const& cameraInfo, FScene::RenderableSoa const& renderableData,
+        FScene::LightSoa const& lightData) noexcept {
+
+    // how much a light can move before we consider its cached shadow map stale
+    constexpr float DIRECTION_EPSILON = 1e-6f;  // 1-cos(angle), about 0.08 degree
+    constexpr float POSITION_EPSILON = 1e-4f;   // relative to the light's falloff radius
+
+    mFrameCount++;
+
+    DriverApi& driver = engine.getDriverApi();
+    uint32_t const interval = uint32_t(std::max(1, engine.debug.shadowmap.update_interval));
+    if (UTILS_LIKELY(interval <= 1)) {
+        // The scheduler is disabled; all shadow maps are re-rendered every frame into a
+        // transient texture (see render()).
+        if (UTILS_UNLIKELY(mShadowAtlasTexture)) {
+            driver.destroyTexture(mShadowAtlasTexture);
+            mShadowAtlasTexture = {};
+        }
+        for (auto& entry : mScheduler) {
+            entry.render = true;
+            entry.valid = false;
+        }
+        return;
+    }
+
+    // Cached shadow maps are reused across frames, so they must live in a persistent texture;
+    // (re)allocate it when the atlas requirements change, which invalidates all cached maps.
+    auto const& requirements = mTextureAtlasRequirements;
+    if (!mShadowAtlasTexture ||
+            mShadowAtlasDesc.size != requirements.size ||
+            mShadowAtlasDesc.layers != requirements.layers ||
+            mShadowAtlasDesc.levels != requirements.levels ||
+            mShadowAtlasDesc.format != requirements.format) {
+        if (mShadowAtlasTexture) {
+            driver.destroyTexture(mShadowAtlasTexture);
+        }
+        TextureUsage const usage = TextureUsage::SAMPLEABLE |
+                (isDepthFormat(requirements.format) ?
+                        TextureUsage::DEPTH_ATTACHMENT : TextureUsage::COLOR_ATTACHMENT);
+        mShadowAtlasTexture = driver.createTexture(SamplerType::SAMPLER_2D_ARRAY,
+                requirements.levels, requirements.format, 1,
+                requirements.size, requirements.size, requirements.layers, usage);
+        mShadowAtlasDesc = requirements;
+        for (auto& entry : mScheduler) {
+            entry.valid = false;
+        }
+    }
+
+    // The light data is in the render world-space, which moves with the world origin; the
+    // scheduler compares light positions across frames, so we undo the world transform first.
+    mat4 const worldTransformInverse = inverse(cameraInfo.worldTransform);
+    mat3f const worldRotationInverse{ worldTransformInverse.upperLeft() };
+
+    // Directional cascades: cascade 0 is re-rendered every frame; the others round-robin over
+    // the update interval, or earlier when the light direction changed.
+    if (mDirectionalShadowMapCount > 0) {
+        float3 const direction = worldRotationInverse *
+                lightData.elementAt<FScene::SHADOW_DIRECTION>(0);
+        float3 const cameraPosition{ worldTransformInverse[3].xyz };
+        // how far the camera can move before a frozen cascade must be re-aimed
+        float const cameraEpsilon = POSITION_EPSILON * std::abs(cameraInfo.zf);
+        for (size_t i = 0; i < mDirectionalShadowMapCount; i++) {
+            SchedulerEntry& entry = mScheduler[i];
+            bool const moved = dot(direction, entry.direction) < 1.0f - DIRECTION_EPSILON;
+            bool refresh = ((mFrameCount + i) % interval) == 0;
+            if (refresh && i > 0 && entry.valid && !moved) {
+                // The periodic refresh is only needed to re-aim the cascade after the camera
+                // moved, or to pick up casters that moved within it; a cascade over purely
+                // static content, seen from a stationary camera, can stay frozen.
+                float3 const d = cameraPosition - entry.position;
+                if (dot(d, d) <= cameraEpsilon * cameraEpsilon) {
+                    float3 const offset{
+                            (entry.worldTransform * worldTransformInverse)[3].xyz };
+                    refresh = intersectsDynamicCasters(renderableData,
+                            getShadowMap(i).getCamera().getCullingFrustum(), offset);
+                }
+            }
+            entry.render = (i == 0) || !entry.valid || moved ||
+                    entry.layer != getShadowMap(i).getLayer() || refresh;
+            if (entry.render) {
+                entry.valid = true;
+                entry.layer = getShadowMap(i).getLayer();
+                entry.direction = direction;
+                entry.position = cameraPosition;
+            }
+        }
+    }
+
+    // Spot and point shadow maps: re-rendered when their light moved, and refreshed
+    // round-robin over the update interval as a safety net for moving shadow casters.
+    for (size_t j = 0; j < mSpotShadowMapCount; j++) {
+        size_t const i = CONFIG_MAX_SHADOW_CASCADES + j;
+        ShadowMap const& shadowMap = getShadowMap(i);
+        size_t const lightIndex = shadowMap.getLightIndex();
+        float4 const positionRadius = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex);
+        float3 const position{
+                (worldTransformInverse * double4{ positionRadius.xyz, 1.0 }).xyz };
+        float3 const direction = worldRotationInverse *
+                lightData.elementAt<FScene::DIRECTION>(lightIndex);
+        float const radius = positionRadius.w;
+        SchedulerEntry& entry = mScheduler[i];
+        float3 const delta = position - entry.position;
+        bool const moved =
+                dot(delta, delta) > POSITION_EPSILON * POSITION_EPSILON * radius * radius ||
+                dot(direction, entry.direction) < 1.0f - DIRECTION_EPSILON ||
+                std::abs(radius - entry.radius) > POSITION_EPSILON * radius;
+        bool refresh = ((mFrameCount + i) % interval) == 0;
+        if (refresh && entry.valid && !moved) {
+            // The periodic refresh is only needed to pick up casters moving within the
+            // frustum; a map over purely static content stays frozen until its light moves.
+            float3 const offset{ (entry.worldTransform * worldTransformInverse)[3].xyz };
+            refresh = intersectsDynamicCasters(renderableData,
+                    shadowMap.getCamera().getCullingFrustum(), offset);
+        }
+        entry.render = !entry.valid || moved ||
+                entry.layer != shadowMap.getLayer() || refresh;
+        if (entry.render) {
+            entry.valid = true;
+            entry.layer = shadowMap.getLayer();
+            entry.position = position;
+            entry.direction = direction;
+            entry.radius = radius;
+        }
+    }
+}
+
 ShadowMapManager::Builder& ShadowMapManager::Builder::directionalShadowMap(size_t const lightIndex,
         LightManager::ShadowOptions const* options) noexcept {
     assert_invariant(options->shadowCascades <= CONFIG_MAX_SHADOW_CASCADES);
@@ -255,16 +413,31 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
 
     VsmShadowOptions const& vsmShadowOptions = view.getVsmShadowOptions();
 
+    // When the update scheduler is active (see updateShadowMapSchedule()), shadow maps can be
+    // reused across frames, so the atlas must be a persistent (imported) texture; otherwise we
+    // use a transient texture, which the FrameGraph can alias with other resources.
+    FrameGraphTexture::Descriptor const shadowmapDesc{
+            .width = textureRequirements.size, .height = textureRequirements.size,
+            .depth = textureRequirements.layers,
+            .levels = textureRequirements.levels,
+            .type = SamplerType::SAMPLER_2D_ARRAY,
+            .format = textureRequirements.format
+    };
+    FrameGraphId<FrameGraphTexture> importedShadows;
+    if (UTILS_UNLIKELY(mShadowAtlasTexture)) {
+        FrameGraphTexture::Usage const usage = FrameGraphTexture::Usage::SAMPLEABLE |
+                (isDepthFormat(textureRequirements.format) ?
+                        FrameGraphTexture::Usage::DEPTH_ATTACHMENT :
+                        FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+        importedShadows = fg.import("Shadowmap", shadowmapDesc, usage,
+                FrameGraphTexture{ .handle = mShadowAtlasTexture });
+    }
+
     auto& prepareShadowPass = fg.addPass<PrepareShadowPassData>("Prepare Shadow Pass",
             [&](FrameGraph::Builder& builder, auto& data) {
                 data.passList.reserve(getMaxShadowMapCount());
-                data.shadows = builder.createTexture("Shadowmap", {
-                        .width = textureRequirements.size, .height = textureRequirements.size,
-                        .depth = textureRequirements.layers,
-                        .levels = textureRequirements.levels,
-                        .type = SamplerType::SAMPLER_2D_ARRAY,
-                        .format = textureRequirements.format
-                });
+                data.shadows = importedShadows ?
+                        importedShadows : builder.createTexture("Shadowmap", shadowmapDesc);
 
                 // these loops create a list of the shadow maps that might need to be rendered
                 auto& passList = data.passList;
@@ -279,7 +452,10 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                         // if hasVisibleShadows() is false, we're guaranteed the shader won't
                         // sample this shadow map (see PerViewUib::cascades and
                         // ShadowMapManager::updateCascadeShadowMaps)
-                        if (shadowMap.hasVisibleShadows()) {
+                        // Cascades frozen by the update scheduler are reused as-is, their
+                        // shadow matrix was rebased in updateCascadeShadowMaps().
+                        if (shadowMap.hasVisibleShadows() &&
+                                mScheduler[shadowMap.getShadowIndex()].render) {
                             passList.push_back({
                                     {}, &shadowMap, directionalShadowCastersRange,
                                     VISIBLE_DIR_SHADOW_RENDERABLE });
@@ -295,6 +471,25 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                     for (auto& shadowMap : getSpotShadowMaps()) {
                         assert_invariant(!shadowMap.isDirectionalShadow());
 
+                        SchedulerEntry const& schedule =
+                                mScheduler[shadowMap.getShadowIndex()];
+                        if (UTILS_UNLIKELY(!schedule.render)) {
+                            // This shadow map is not re-rendered this frame (see
+                            // updateShadowMapSchedule()); the atlas contents are reused, we
+                            // only rebase its shadow matrices to this frame's world origin.
+                            if (shadowMap.hasVisibleShadows()) {
+                                size_t const shadowIndex = shadowMap.getShadowIndex();
+                                mat4f const rebase{ schedule.worldTransform *
+                                        inverse(mainCameraInfo.worldTransform) };
+                                auto& s = mShadowUb.edit();
+                                s.shadows[shadowIndex].lightFromWorldMatrix =
+                                        schedule.lightSpace * rebase;
+                                s.shadows[shadowIndex].lightFromWorldZ =
+                                        transpose(rebase) * schedule.lightFromWorldZ;
+                            }
+                            continue;
+                        }
+
                         switch (shadowMap.getShadowType()) {
                             case ShadowType::DIRECTIONAL:
                                 // we should never be here
@@ -339,6 +534,16 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                     &view = const_cast<FView const&>(view)]
                     (FrameGraphResources const&, auto const& data, DriverApi& driver) mutable {
 
+                // Detect whether any dynamic-shadow caster appeared, disappeared or moved
+                // since last frame. When nothing did, each light's cached caster list is
+                // replayed below instead of re-culling the whole range, so static scenes
+                // stop paying O(lights x renderables) per frame.
+                uint32_t geometryEpoch = 0;
+                if (view.needsPointShadowMaps()) {
+                    geometryEpoch = updateCasterSnapshot(scene->getRenderableData(),
+                            view.getVisibleSpotShadowCasters());
+                }
+
                 // Note: we could almost parallel_for the loop below, the problem currently is
                 // that updatePrimitivesLod() updates temporary global state.
                 // prepareSpotShadowMap() also update the visibility of renderable. These two
@@ -367,16 +572,16 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                             break;
                         case ShadowType::SPOT:
                             if (shadowMap.hasVisibleShadows()) {
-                                ShadowMapManager::cullSpotShadowMap(shadowMap, engine, view,
+                                cullSpotShadowMap(shadowMap, engine, view,
                                         scene->getRenderableData(), entry.range,
-                                        scene->getLightData());
+                                        scene->getLightData(), geometryEpoch);
                             }
                             break;
                         case ShadowType::POINT:
                             if (shadowMap.hasVisibleShadows()) {
-                                ShadowMapManager::cullPointShadowMap(shadowMap, view,
+                                cullPointShadowMap(shadowMap, view,
                                         scene->getRenderableData(), entry.range,
-                                        scene->getLightData());
+                                        scene->getLightData(), geometryEpoch);
                             }
                             break;
                     }
@@ -584,10 +789,20 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                 const float sigma = (blurWidth + 1.0f) / 6.0f;
                 size_t kernelWidth = std::ceil((blurWidth - 5.0f) / 4.0f);
                 kernelWidth = kernelWidth * 4 + 5;
-                ppm.gaussianBlurPass(fg,
-                        shadowPass->tempBlurSrc,
-                        shadowPass->output,
-                        false, kernelWidth, sigma);
+                if (kernelWidth <= 13) {
+                    // the kernels used in practice are small enough for the fused single-pass
+                    // filter, which skips the intermediate render-target round trip -- one
+                    // pass per shadow map instead of two
+                    ppm.vsmBlurPass(fg,
+                            shadowPass->tempBlurSrc,
+                            shadowPass->output,
+                            kernelWidth, sigma);
+                } else {
+                    ppm.gaussianBlurPass(fg,
+                            shadowPass->tempBlurSrc,
+                            shadowPass->output,
+                            false, kernelWidth, sigma);
+                }
             }
 
             // FIXME: mipmapping here is broken because it'll access texels from adjacent
@@ -624,10 +839,11 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateCascadeShadowMaps(FEng
         updateNearFarPlanes(&cameraInfo.cullingProjection, cameraInfo.zn, cameraInfo.zf);
     }
 
+    uint32_t const mapSize = getEffectiveMapSize(options.mapSize);
     const ShadowMap::ShadowMapInfo shadowMapInfo{
             .atlasDimension      = mTextureAtlasRequirements.size,
-            .textureDimension    = uint16_t(options.mapSize),
-            .shadowDimension     = uint16_t(options.mapSize - 2u),
+            .textureDimension    = uint16_t(mapSize),
+            .shadowDimension     = uint16_t(mapSize - 2u),
             .textureSpaceFlipped = engine.getBackend() == Backend::METAL ||
                                    engine.getBackend() == Backend::VULKAN ||
                                    engine.getBackend() == Backend::WEBGPU,
@@ -662,7 +878,7 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateCascadeShadowMaps(FEng
         if (hasVisibleShadows) {
             Frustum const& frustum = shadowMap.getCamera().getCullingFrustum();
             FView::cullRenderables(engine.getJobSystem(), renderableData, frustum,
-                    VISIBLE_DIR_SHADOW_RENDERABLE_BIT);
+                    VISIBLE_DIR_SHADOW_RENDERABLE_BIT, scene->getBvh());
         }
     }
 
@@ -706,6 +922,21 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateCascadeShadowMaps(FEng
             ShadowMap& shadowMap = cascadedShadowMaps[i];
             assert_invariant(shadowMap.getLightIndex() == 0);
 
+            SchedulerEntry& schedule = mScheduler[shadowMap.getShadowIndex()];
+            if (UTILS_UNLIKELY(!schedule.render)) {
+                // This cascade is not re-rendered this frame (see updateShadowMapSchedule());
+                // its shadow map and UBO entry are reused as-is, except for the shadow matrix
+                // which must be rebased to this frame's world origin.
+                if (shadowMap.hasVisibleShadows()) {
+                    auto& s = mShadowUb.edit();
+                    s.shadows[i].lightFromWorldMatrix = schedule.lightSpace *
+                            mat4f{ schedule.worldTransform * inverse(cameraInfo.worldTransform) };
+                    shadowTechnique |= ShadowTechnique::SHADOW_MAP;
+                    cascadeHasVisibleShadows |= 0x1u << i;
+                }
+                continue;
+            }
+
             // update cameraInfo culling projection for the cascade
             float const* nearFarPlanes = splits.begin();
             cameraInfo.zn = -nearFarPlanes[i];
@@ -739,6 +970,10 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateCascadeShadowMaps(FEng
                 s.shadows[shadowIndex].bulbRadiusLs =
                         mSoftShadowOptions.penumbraScale * options.shadowBulbRadius / wsTexelSize;
 
+                // remember what was rendered, in case this cascade is frozen on later frames
+                schedule.lightSpace = shaderParameters.lightSpace;
+                schedule.worldTransform = cameraInfo.worldTransform;
+
                 shadowTechnique |= ShadowTechnique::SHADOW_MAP;
                 cascadeHasVisibleShadows |= 0x1u << i;
             }
@@ -802,10 +1037,11 @@ void ShadowMapManager::prepareSpotShadowMap(ShadowMap& shadowMap, FEngine& engin
     FLightManager::ShadowOptions const* const options = shadowMap.getShadowOptions();
 
     // update the shadow map frustum/camera
+    uint32_t const mapSize = getEffectiveMapSize(options->mapSize);
     const ShadowMap::ShadowMapInfo shadowMapInfo{
             .atlasDimension      = mTextureAtlasRequirements.size,
-            .textureDimension    = uint16_t(options->mapSize),
-            .shadowDimension     = uint16_t(options->mapSize - 2u),
+            .textureDimension    = uint16_t(mapSize),
+            .shadowDimension     = uint16_t(mapSize - 2u),
             .textureSpaceFlipped = engine.getBackend() == Backend::METAL ||
                                    engine.getBackend() == Backend::VULKAN ||
                                    engine.getBackend() == Backend::WEBGPU,
@@ -837,13 +1073,18 @@ void ShadowMapManager::prepareSpotShadowMap(ShadowMap& shadowMap, FEngine& engin
                 mSoftShadowOptions.penumbraScale * options->shadowBulbRadius
                         / wsTexelSizeAtOneMeter;
 
+        // remember what was rendered, in case this shadow map is frozen on later frames
+        SchedulerEntry& schedule = mScheduler[shadowIndex];
+        schedule.lightSpace = shaderParameters.lightSpace;
+        schedule.lightFromWorldZ = shaderParameters.lightFromWorldZ;
+        schedule.worldTransform = mainCameraInfo.worldTransform;
     }
 }
 
 void ShadowMapManager::cullSpotShadowMap(ShadowMap const& shadowMap,
         FEngine const& engine, FView const& view,
         FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
-        FScene::LightSoa const& lightData) noexcept {
+        FScene::LightSoa const& lightData, uint32_t const geometryEpoch) noexcept {
     auto& lcm = engine.getLightManager();
 
     const size_t lightIndex = shadowMap.getLightIndex();
@@ -861,19 +1102,28 @@ void ShadowMapManager::cullSpotShadowMap(ShadowMap const& shadowMap,
     const mat4f Mv = ShadowMap::getDirectionalLightViewMatrix(direction, { 0, 1, 0 }, position);
     const mat4f Mp = mat4f::perspective(outerConeAngle * f::RAD_TO_DEG * 2.0f, 1.0f, 0.01f, radius);
     const mat4f MpMv = highPrecisionMultiply(Mp, Mv);
-    const Frustum frustum(MpMv);
 
-    // Cull shadow casters
+    // Cull shadow casters, or replay the cached caster list when neither the casters nor
+    // the light moved since it was built.
     float3 const* worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
     float3 const* worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
     FScene::VisibleMaskType* visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
-    Culler::intersects(
-            visibleArray + range.first,
-            frustum,
-            worldAABBCenter + range.first,
-            worldAABBExtent + range.first,
-            range.size(),
-            VISIBLE_DYN_SHADOW_RENDERABLE_BIT);
+    SchedulerEntry& schedule = mScheduler[shadowMap.getShadowIndex()];
+    if (geometryEpoch && schedule.castersEpoch == geometryEpoch &&
+            !memcmp(&schedule.cullFrustum, &MpMv, sizeof(mat4f))) {
+        replayCasterList(schedule, visibleArray + range.first, range.size());
+    } else {
+        const Frustum frustum(MpMv);
+        Culler::intersects(
+                visibleArray + range.first,
+                frustum,
+                worldAABBCenter + range.first,
+                worldAABBExtent + range.first,
+                range.size(),
+                VISIBLE_DYN_SHADOW_RENDERABLE_BIT);
+        cacheCasterList(schedule, MpMv, geometryEpoch,
+                visibleArray + range.first, range.size());
+    }
 
     // update their visibility mask
     uint8_t const* layers = renderableData.data<FScene::LAYERS>();
@@ -895,10 +1145,11 @@ void ShadowMapManager::preparePointShadowMap(ShadowMap& shadowMap,
     FLightManager::ShadowOptions const* const options = shadowMap.getShadowOptions();
 
     // update the shadow map frustum/camera
+    uint32_t const mapSize = getEffectiveMapSize(options->mapSize);
     const ShadowMap::ShadowMapInfo shadowMapInfo{
             .atlasDimension      = mTextureAtlasRequirements.size,
-            .textureDimension    = uint16_t(options->mapSize),
-            .shadowDimension     = uint16_t(options->mapSize), // point-lights don't have a border
+            .textureDimension    = uint16_t(mapSize),
+            .shadowDimension     = uint16_t(mapSize), // point-lights don't have a border
             .textureSpaceFlipped = engine.getBackend() == Backend::METAL ||
                                    engine.getBackend() == Backend::VULKAN ||
                                    engine.getBackend() == Backend::WEBGPU,
@@ -929,12 +1180,18 @@ void ShadowMapManager::preparePointShadowMap(ShadowMap& shadowMap,
         s.shadows[shadowIndex].bulbRadiusLs =
                 mSoftShadowOptions.penumbraScale * options->shadowBulbRadius
                         / wsTexelSizeAtOneMeter;
+
+        // remember what was rendered, in case this shadow map is frozen on later frames
+        SchedulerEntry& schedule = mScheduler[shadowIndex];
+        schedule.lightSpace = shaderParameters.lightSpace;
+        schedule.lightFromWorldZ = shaderParameters.lightFromWorldZ;
+        schedule.worldTransform = mainCameraInfo.worldTransform;
     }
 }
 
 void ShadowMapManager::cullPointShadowMap(ShadowMap const& shadowMap, FView const& view,
         FScene::RenderableSoa& renderableData, utils::Range<uint32_t> const range,
-        FScene::LightSoa const& lightData) noexcept {
+        FScene::LightSoa const& lightData, uint32_t const geometryEpoch) noexcept {
 
     uint8_t const face = shadowMap.getFace();
     size_t const lightIndex = shadowMap.getLightIndex();
@@ -948,19 +1205,29 @@ void ShadowMapManager::cullPointShadowMap(ShadowMap const& shadowMap, FView cons
     // compute shadow map frustum for culling
     mat4f const Mv = ShadowMap::getPointLightViewMatrix(TextureCubemapFace(face), position);
     mat4f const Mp = mat4f::perspective(90.0f, 1.0f, 0.01f, radius);
-    Frustum const frustum{ highPrecisionMultiply(Mp, Mv) };
+    mat4f const MpMv = highPrecisionMultiply(Mp, Mv);
 
-    // Cull shadow casters
+    // Cull shadow casters, or replay the cached caster list when neither the casters nor
+    // the light moved since it was built.
     float3 const* worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
     float3 const* worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
     FScene::VisibleMaskType* visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
-    Culler::intersects(
-            visibleArray + range.first,
-            frustum,
-            worldAABBCenter + range.first,
-            worldAABBExtent + range.first,
-            range.size(),
-            VISIBLE_DYN_SHADOW_RENDERABLE_BIT);
+    SchedulerEntry& schedule = mScheduler[shadowMap.getShadowIndex()];
+    if (geometryEpoch && schedule.castersEpoch == geometryEpoch &&
+            !memcmp(&schedule.cullFrustum, &MpMv, sizeof(mat4f))) {
+        replayCasterList(schedule, visibleArray + range.first, range.size());
+    } else {
+        Frustum const frustum{ MpMv };
+        Culler::intersects(
+                visibleArray + range.first,
+                frustum,
+                worldAABBCenter + range.first,
+                worldAABBExtent + range.first,
+                range.size(),
+                VISIBLE_DYN_SHADOW_RENDERABLE_BIT);
+        cacheCasterList(schedule, MpMv, geometryEpoch,
+                visibleArray + range.first, range.size());
+    }
 
     // update their visibility mask
     uint8_t const* layers = renderableData.data<FScene::LAYERS>();
@@ -973,6 +1240,56 @@ void ShadowMapManager::cullPointShadowMap(ShadowMap const& shadowMap, FView cons
             range.size());
 }
 
+uint32_t ShadowMapManager::updateCasterSnapshot(FScene::RenderableSoa const& renderableData,
+        utils::Range<uint32_t> const range) noexcept {
+    auto const* const instances = renderableData.data<FScene::RENDERABLE_INSTANCE>() + range.first;
+    float3 const* const centers = renderableData.data<FScene::WORLD_AABB_CENTER>() + range.first;
+    float3 const* const extents = renderableData.data<FScene::WORLD_AABB_EXTENT>() + range.first;
+    size_t const count = range.size();
+
+    // a single O(n) comparison shared by all shadow maps, instead of O(n) culling per map
+    bool const unchanged = count == mCasterInstances.size()
+            && !memcmp(instances, mCasterInstances.data(), count * sizeof(mCasterInstances[0]))
+            && !memcmp(centers, mCasterCenters.data(), count * sizeof(float3))
+            && !memcmp(extents, mCasterExtents.data(), count * sizeof(float3));
+
+    if (!unchanged) {
+        mCasterInstances.assign(instances, instances + count);
+        mCasterCenters.assign(centers, centers + count);
+        mCasterExtents.assign(extents, extents + count);
+        // 0 is reserved to mean "no valid snapshot"
+        if (UTILS_UNLIKELY(++mCasterEpoch == 0)) {
+            mCasterEpoch = 1;
+        }
+    }
+    return mCasterEpoch;
+}
+
+void ShadowMapManager::replayCasterList(SchedulerEntry const& schedule,
+        Culler::result_type* const UTILS_RESTRICT visibleArray, size_t const count) noexcept {
+    // same rounding as Culler::intersects(); the extra entries' bits are never read
+    size_t const n = Culler::round(count);
+    for (size_t i = 0; i < n; i++) {
+        visibleArray[i] &= ~VISIBLE_DYN_SHADOW_RENDERABLE;
+    }
+    for (uint32_t const i : schedule.casters) {
+        visibleArray[i] |= VISIBLE_DYN_SHADOW_RENDERABLE;
+    }
+}
+
+void ShadowMapManager::cacheCasterList(SchedulerEntry& schedule, mat4f const& frustum,
+        uint32_t const epoch, Culler::result_type const* const UTILS_RESTRICT visibleArray,
+        size_t const count) noexcept {
+    schedule.casters.clear();
+    for (size_t i = 0; i < count; i++) {
+        if (visibleArray[i] & VISIBLE_DYN_SHADOW_RENDERABLE) {
+            schedule.casters.push_back(uint32_t(i));
+        }
+    }
+    schedule.cullFrustum = frustum;
+    schedule.castersEpoch = epoch;
+}
+
 ShadowMapManager::ShadowTechnique ShadowMapManager::updateSpotShadowMaps(FEngine& engine,
         FScene::LightSoa const& lightData) const noexcept {
 
@@ -1017,42 +1334,49 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateSpotShadowMaps(FEngine
 void ShadowMapManager::calculateTextureRequirements(FEngine& engine, FView& view,
         FScene::LightSoa const&) noexcept {
 
+    // latch the adaptive quality governor's shadow resolution reduction for this frame; all
+    // effective dimensions below must be derived from the same shift
+    mShadowMapSizeShift = view.getShadowMapSizeShift();
+
     uint32_t maxDimension = 0;
     bool elvsm = false;
 
     for (ShadowMap const& shadowMap : getCascadedShadowMap()) {
         // Shadow map size should be the same for all cascades.
         auto const& options = shadowMap.getShadowOptions();
-        maxDimension = std::max(maxDimension, options->mapSize);
+        maxDimension = std::max(maxDimension, getEffectiveMapSize(options->mapSize));
         elvsm = elvsm || options->vsm.elvsm;
     }
 
     for (ShadowMap const& shadowMap : getSpotShadowMaps()) {
         auto const& options = shadowMap.getShadowOptions();
-        maxDimension = std::max(maxDimension, options->mapSize);
+        maxDimension = std::max(maxDimension, getEffectiveMapSize(options->mapSize));
         elvsm = elvsm || options->vsm.elvsm;
     }
 
     uint8_t layersNeeded = 0;
 
     std::function const allocateFromAtlas =
-            [&layersNeeded, allocator = AtlasAllocator{ maxDimension }](
+            [this, &layersNeeded, allocator = AtlasAllocator{ maxDimension }](
         ShadowMap* pShadowMap) mutable {
         // Allocate shadowmap from our Atlas Allocator
         auto const& options = pShadowMap->getShadowOptions();
-        auto [layer, pos] = allocator.allocate(options->mapSize);
+        uint32_t const mapSize = getEffectiveMapSize(options->mapSize);
+        auto [layer, pos] = allocator.allocate(mapSize);
         assert_invariant(layer >= 0);
         assert_invariant(!pos.empty());
-        pShadowMap->setAllocation(layer, pos);
+        pShadowMap->setAllocation(layer, pos, uint16_t(mapSize));
         layersNeeded = std::max(uint8_t(layer + 1), layersNeeded);
     };
 
     std::function const allocateFromTextureArray =
-            [&layersNeeded, layer = 0](ShadowMap* pShadowMap) mutable {
+            [this, &layersNeeded, layer = 0](ShadowMap* pShadowMap) mutable {
         // Layout the shadow maps. For now, we take the largest requested dimension and allocate a
         // texture of that size. Each cascade / shadow map gets its own layer in the array texture.
         // The directional shadow cascades start on layer 0, followed by spotlights.
-        pShadowMap->setAllocation(layer, {});
+        auto const& options = pShadowMap->getShadowOptions();
+        pShadowMap->setAllocation(layer, {},
+                uint16_t(getEffectiveMapSize(options->mapSize)));
         layersNeeded = ++layer;
     };
 
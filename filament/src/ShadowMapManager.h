@@ -47,8 +47,10 @@
 #include <utils/Slice.h>
 
 #include <math/mat4.h>
+#include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <new>
@@ -163,22 +165,32 @@ private:
     void calculateTextureRequirements(FEngine&, FView& view,
             FScene::LightSoa const&) noexcept;
 
+    void updateShadowMapSchedule(FEngine& engine, CameraInfo const& cameraInfo,
+            FScene::RenderableSoa const& renderableData,
+            FScene::LightSoa const& lightData) noexcept;
+
     void prepareSpotShadowMap(ShadowMap& shadowMap,
             FEngine& engine, FView& view, CameraInfo const& mainCameraInfo,
             FScene::LightSoa const& lightData, ShadowMap::SceneInfo const& sceneInfo) noexcept;
 
-    static void cullSpotShadowMap(ShadowMap const& map,
+    void cullSpotShadowMap(ShadowMap const& map,
             FEngine const& engine, FView const& view,
             FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
-            FScene::LightSoa const& lightData) noexcept;
+            FScene::LightSoa const& lightData, uint32_t geometryEpoch) noexcept;
 
     void preparePointShadowMap(ShadowMap& map,
             FEngine& engine, FView& view, CameraInfo const& mainCameraInfo,
             FScene::LightSoa const& lightData) const noexcept;
 
-    static void cullPointShadowMap(ShadowMap const& shadowMap, FView const& view,
+    void cullPointShadowMap(ShadowMap const& shadowMap, FView const& view,
             FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
-            FScene::LightSoa const& lightData) noexcept;
+            FScene::LightSoa const& lightData, uint32_t geometryEpoch) noexcept;
+
+    // Compares the dynamic-shadow caster slice of the SoA against last frame's snapshot and
+    // bumps the epoch when a renderable appeared, disappeared or moved. Per-light caster
+    // lists cached with the current epoch can be replayed instead of re-culled.
+    uint32_t updateCasterSnapshot(FScene::RenderableSoa const& renderableData,
+            utils::Range<uint32_t> range) noexcept;
 
     static void updateSpotVisibilityMasks(
             uint8_t visibleLayers,
@@ -186,6 +198,13 @@ private:
             FRenderableManager::Visibility const* UTILS_RESTRICT visibility,
             Culler::result_type* UTILS_RESTRICT visibleMask, size_t count);
 
+    // Effective shadow map dimension after the view's adaptive quality governor is applied
+    // (see FView::getShadowMapSizeShift()). Kept at 32 texels minimum so the 1-texel borders
+    // and filtering stay meaningful.
+    uint32_t getEffectiveMapSize(uint32_t const mapSize) const noexcept {
+        return std::max(32u, mapSize >> mShadowMapSizeShift);
+    }
+
     class CascadeSplits {
     public:
         constexpr static size_t SPLIT_COUNT = CONFIG_MAX_SHADOW_CASCADES + 1;
@@ -218,11 +237,55 @@ private:
         backend::TextureFormat format = backend::TextureFormat::DEPTH16;
     } mTextureAtlasRequirements;
 
+    // shadow map size reduction requested by the view's adaptive quality governor,
+    // latched in calculateTextureRequirements()
+    uint8_t mShadowMapSizeShift = 0;
+
     SoftShadowOptions mSoftShadowOptions;
 
     mutable TypedBuffer<ShadowUib> mShadowUb;
     backend::Handle<backend::HwBufferObject> mShadowUbh;
 
+    // Per shadow map state for the update scheduler (see updateShadowMapSchedule()). With an
+    // update interval greater than one, a shadow map that is not re-rendered on a given frame
+    // keeps its texture contents from an earlier frame; we keep here what's needed to decide
+    // when it becomes stale, and to rebase its shadow matrices to the current world origin.
+    struct SchedulerEntry {
+        math::mat4 worldTransform;      // world transform of the frame the map was rendered in
+        math::mat4f lightSpace;         // lightFromWorldMatrix computed when it was rendered
+        math::float4 lightFromWorldZ{}; // lightFromWorldZ computed when it was rendered
+        math::float3 position{};        // light (or, for cascades, camera) position at render
+                                        // time, pre world-transform
+        math::float3 direction{};       // light direction at render time, pre world-transform
+        float radius = 0.0f;            // light falloff radius at render time
+        uint8_t layer = 0;              // atlas layer the map was rendered into
+        bool valid = false;             // the atlas contents are valid for this map
+        bool render = true;             // the map is re-rendered this frame
+        math::mat4f cullFrustum;        // frustum matrix the caster list below was culled with
+        uint32_t castersEpoch = 0;      // caster snapshot epoch at that cull (0 = no cache)
+        std::vector<uint32_t> casters;  // rows relative to the culled range that passed
+    };
+    mutable std::array<SchedulerEntry, CONFIG_MAX_SHADOWMAPS> mScheduler{};
+
+    static void replayCasterList(SchedulerEntry const& schedule,
+            Culler::result_type* visibleArray, size_t count) noexcept;
+
+    static void cacheCasterList(SchedulerEntry& schedule, math::mat4f const& frustum,
+            uint32_t epoch, Culler::result_type const* visibleArray, size_t count) noexcept;
+
+    // Snapshot of the dynamic-shadow caster slice, used by updateCasterSnapshot() to detect
+    // geometry changes between frames.
+    std::vector<utils::EntityInstance<RenderableManager>> mCasterInstances;
+    std::vector<math::float3> mCasterCenters;
+    std::vector<math::float3> mCasterExtents;
+    uint32_t mCasterEpoch = 0;
+
+    // Persistent shadowmap atlas used when the update scheduler is active; a transient
+    // FrameGraph texture is used otherwise (see render()).
+    backend::Handle<backend::HwTexture> mShadowAtlasTexture;
+    TextureAtlasRequirements mShadowAtlasDesc{};
+    uint32_t mFrameCount = 0;
+
     ShadowMappingUniforms mShadowMappingUniforms = {};
 
     ShadowMap::SceneInfo mSceneInfo;
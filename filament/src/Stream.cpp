@@ -41,4 +41,8 @@ int64_t Stream::getTimestamp() const noexcept {
     return downcast(this)->getTimestamp();
 }
 
+StreamStats Stream::getStats() const noexcept {
+    return downcast(this)->getStats();
+}
+
 } // namespace filament
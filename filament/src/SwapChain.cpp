@@ -42,6 +42,10 @@ void SwapChain::setFrameCompletedCallback(backend::CallbackHandler* handler,
     return downcast(this)->setFrameCompletedCallback(handler, std::move(callback));
 }
 
+void SwapChain::setFrameQueueDepth(uint8_t const depth) noexcept {
+    downcast(this)->setFrameQueueDepth(depth);
+}
+
 bool SwapChain::isSRGBSwapChainSupported(Engine& engine) noexcept {
     return FSwapChain::isSRGBSwapChainSupported(downcast(engine));
 }
@@ -62,6 +62,10 @@ void Texture::setExternalImage(Engine& engine, ExternalImageHandleRef image) noe
     downcast(this)->setExternalImage(downcast(engine), image);
 }
 
+Texture::ExternalImageHandle Texture::getExternalImage() const noexcept {
+    return downcast(this)->getExternalImage();
+}
+
 void Texture::setExternalImage(Engine& engine, void* image) noexcept {
     downcast(this)->setExternalImage(downcast(engine), image);
 }
@@ -78,6 +82,14 @@ void Texture::generateMipmaps(Engine& engine) const noexcept {
     downcast(this)->generateMipmaps(downcast(engine));
 }
 
+void Texture::generateMipmapsAsync(Engine& engine) const noexcept {
+    downcast(this)->generateMipmapsAsync(downcast(engine));
+}
+
+void Texture::setLodRange(Engine& engine, uint8_t const baseLevel, uint8_t const levelCount) {
+    downcast(this)->setLodRange(downcast(engine), baseLevel, levelCount);
+}
+
 bool Texture::isTextureFormatSupported(Engine& engine, InternalFormat const format) noexcept {
     return FTexture::isTextureFormatSupported(downcast(engine), format);
 }
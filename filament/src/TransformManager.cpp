@@ -34,6 +34,10 @@ bool TransformManager::empty() const noexcept {
     return downcast(this)->empty();
 }
 
+void TransformManager::reserve(size_t const n) noexcept {
+    downcast(this)->reserve(n);
+}
+
 Entity TransformManager::getEntity(Instance const i) const noexcept {
     return downcast(this)->getEntity(i);
 }
@@ -37,7 +37,8 @@ namespace filament {
 UniformBuffer::UniformBuffer(size_t const size) noexcept
         : mBuffer(mStorage),
           mSize(uint32_t(size)),
-          mSomethingDirty(true) {
+          mDirtyStart(0),
+          mDirtyEnd(uint32_t(size)) {
     if (UTILS_LIKELY(size > sizeof(mStorage))) {
         mBuffer = alloc(size);
     }
@@ -47,7 +48,9 @@ UniformBuffer::UniformBuffer(size_t const size) noexcept
 UniformBuffer::UniformBuffer(UniformBuffer&& rhs) noexcept
         : mBuffer(rhs.mBuffer),
           mSize(rhs.mSize),
-          mSomethingDirty(rhs.mSomethingDirty) {
+          mDirtyStart(rhs.mDirtyStart),
+          mDirtyEnd(rhs.mDirtyEnd),
+          mGeneration(rhs.mGeneration) {
     if (UTILS_LIKELY(rhs.isLocalStorage())) {
         mBuffer = mStorage;
         memcpy(mBuffer, rhs.mBuffer, mSize);
@@ -58,7 +61,9 @@ UniformBuffer::UniformBuffer(UniformBuffer&& rhs) noexcept
 
 UniformBuffer& UniformBuffer::operator=(UniformBuffer&& rhs) noexcept {
     if (this != &rhs) {
-        mSomethingDirty = rhs.mSomethingDirty;
+        mDirtyStart = rhs.mDirtyStart;
+        mDirtyEnd = rhs.mDirtyEnd;
+        mGeneration = rhs.mGeneration;
         if (UTILS_LIKELY(rhs.isLocalStorage())) {
             mBuffer = mStorage;
             mSize = rhs.mSize;
@@ -31,7 +31,9 @@
 #include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <algorithm>
 #include <type_traits>
+#include <utility>
 
 #include <stdint.h>
 #include <stddef.h>
@@ -80,7 +82,9 @@ public:
     // Invalidate a range of uniforms and return a pointer to it. offset and size given in bytes
     void invalidateUniforms(size_t const offset, size_t const size) const {
         assert_invariant(offset + size <= mSize);
-        mSomethingDirty = true;
+        mDirtyStart = std::min(mDirtyStart, uint32_t(offset));
+        mDirtyEnd = std::max(mDirtyEnd, uint32_t(offset + size));
+        mGeneration++;
     }
 
     void invalidate() const noexcept {
@@ -94,10 +98,34 @@ public:
     size_t getSize() const noexcept { return mSize; }
 
     // return if any uniform has been changed
-    bool isDirty() const noexcept { return mSomethingDirty; }
+    bool isDirty() const noexcept { return mDirtyStart < mDirtyEnd; }
+
+    // whether the byte range [offset, offset + size) was modified since the last clean()
+    bool isDirty(size_t const offset, size_t const size) const noexcept {
+        return uint32_t(offset) < mDirtyEnd && uint32_t(offset + size) > mDirtyStart;
+    }
+
+    // typed variant of the above, e.g.: isUniformDirty<float>(offsetof(PerViewUib, exposure))
+    template<typename T>
+    bool isUniformDirty(size_t const offset) const noexcept {
+        return isDirty(offset, sizeof(T));
+    }
+
+    // monotonically increasing modification counter; unlike the dirty range it survives
+    // clean(), so callers can cache it to cheaply detect changes across commits
+    uint32_t getGeneration() const noexcept { return mGeneration; }
+
+    // modified byte range since the last clean() as { offset, size }; size is 0 when clean
+    std::pair<uint32_t, uint32_t> getDirtyRange() const noexcept {
+        return isDirty() ? std::pair<uint32_t, uint32_t>{ mDirtyStart, mDirtyEnd - mDirtyStart }
+                         : std::pair<uint32_t, uint32_t>{ 0u, 0u };
+    }
 
     // mark the whole buffer as clean (no modified uniforms)
-    void clean() const noexcept { mSomethingDirty = false; }
+    void clean() const noexcept {
+        mDirtyStart = UINT32_MAX;
+        mDirtyEnd = 0;
+    }
 
     /*
      * -----------------------------------------------
@@ -218,8 +246,10 @@ private:
     char mStorage[96]; // 6 lines (6 x vec4 x 4)
     void *mBuffer = nullptr;
     uint32_t mSize = 0;
-    mutable bool mSomethingDirty = false;
-    // we have 3 padding bytes here
+    // modified byte range, empty (i.e. clean) when mDirtyStart >= mDirtyEnd
+    mutable uint32_t mDirtyStart = UINT32_MAX;
+    mutable uint32_t mDirtyEnd = 0;
+    mutable uint32_t mGeneration = 0;
 };
 
 // Specialization for mat3f (which has a different alignment, see std140 layout rules), we declare it
@@ -241,6 +271,13 @@ inline void UniformBuffer::setUniformArray(
     setUniformArray(offset, reinterpret_cast<math::float3 const*>(begin), count * 3);
 }
 
+// mat3f is stored as an array of three vec4-aligned float3 (see setUniform above), so its
+// footprint is two float4 rows plus a trailing float3
+template<>
+inline bool UniformBuffer::isUniformDirty<math::mat3f>(size_t const offset) const noexcept {
+    return isDirty(offset, 2 * sizeof(math::float4) + sizeof(math::float3));
+}
+
 template<>
 inline math::mat3f UniformBuffer::getUniform(size_t const offset) const noexcept {
     math::float4 const* p = reinterpret_cast<math::float4 const*>(
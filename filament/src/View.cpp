@@ -49,6 +49,18 @@ Viewport const& View::getViewport() const noexcept {
     return downcast(this)->getViewport();
 }
 
+void View::declareDamageRegion(Viewport const& damage) noexcept {
+    downcast(this)->declareDamageRegion(damage);
+}
+
+void View::setContributionCullingThreshold(float const minPixelArea) noexcept {
+    downcast(this)->setContributionCullingThreshold(minPixelArea);
+}
+
+float View::getContributionCullingThreshold() const noexcept {
+    return downcast(this)->getContributionCullingThreshold();
+}
+
 void View::setFrustumCullingEnabled(bool const culling) noexcept {
     downcast(this)->setFrustumCullingEnabled(culling);
 }
@@ -161,6 +173,14 @@ View::DynamicResolutionOptions View::getDynamicResolutionOptions() const noexcep
     return downcast(this)->getDynamicResolutionOptions();
 }
 
+void View::setAdaptiveQualityOptions(AdaptiveQualityOptions const& options) noexcept {
+    downcast(this)->setAdaptiveQualityOptions(options);
+}
+
+View::AdaptiveQualityOptions View::getAdaptiveQualityOptions() const noexcept {
+    return downcast(this)->getAdaptiveQualityOptions();
+}
+
 void View::setRenderQuality(const RenderQuality& renderQuality) noexcept {
     downcast(this)->setRenderQuality(renderQuality);
 }
@@ -269,6 +289,14 @@ View::VignetteOptions View::getVignetteOptions() const noexcept {
     return downcast(this)->getVignetteOptions();
 }
 
+void View::setAutoExposureOptions(AutoExposureOptions options) noexcept {
+    downcast(this)->setAutoExposureOptions(options);
+}
+
+View::AutoExposureOptions View::getAutoExposureOptions() const noexcept {
+    return downcast(this)->getAutoExposureOptions();
+}
+
 void View::setBlendMode(BlendMode const blendMode) noexcept {
     downcast(this)->setBlendMode(blendMode);
 }
@@ -289,6 +317,14 @@ void View::setScreenSpaceRefractionEnabled(bool const enabled) noexcept {
     downcast(this)->setScreenSpaceRefractionEnabled(enabled);
 }
 
+void View::setDepthPrepassEnabled(bool const enabled) noexcept {
+    downcast(this)->setDepthPrepassEnabled(enabled);
+}
+
+bool View::isDepthPrepassEnabled() const noexcept {
+    return downcast(this)->isDepthPrepassEnabled();
+}
+
 bool View::isScreenSpaceRefractionEnabled() const noexcept {
     return downcast(this)->isScreenSpaceRefractionEnabled();
 }
@@ -66,6 +66,10 @@ public:
         return mManager.empty();
     }
 
+    void reserve(size_t const n) noexcept {
+        mManager.reserve(n);
+    }
+
     utils::Entity getEntity(Instance const i) const noexcept {
         return mManager.getEntity(i);
     }
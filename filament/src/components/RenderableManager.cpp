@@ -55,6 +55,7 @@
 #include <math/vec4.h>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -79,9 +80,12 @@ struct RenderableManager::BuilderDetails {
     uint8_t mPriority = 0x4;
     uint8_t mCommandChannel = Builder::DEFAULT_CHANNEL;
     uint8_t mLightChannels = 1;
+    uint8_t mLodCount = 1;
+    float mLodThresholds[FRenderableManager::Lods::MAX_LOD_COUNT - 1] = {};
     uint16_t mInstanceCount = 1;
     bool mCulling : 1;
     bool mCastShadows : 1;
+    bool mCastShadowsStatic : 1;
     bool mReceiveShadows : 1;
     bool mScreenSpaceContactShadows : 1;
     bool mSkinningBufferMode : 1;
@@ -104,6 +108,7 @@ struct RenderableManager::BuilderDetails {
 
     explicit BuilderDetails(size_t const count)
             : mEntries(count), mCulling(true), mCastShadows(false),
+              mCastShadowsStatic(false),
               mReceiveShadows(true), mScreenSpaceContactShadows(false),
               mSkinningBufferMode(false), mFogEnabled(true),
               mGeometryType(Builder::GeometryType::DYNAMIC),
@@ -158,6 +163,19 @@ RenderableManager::Builder& RenderableManager::Builder::geometryType(GeometryTyp
     return *this;
 }
 
+RenderableManager::Builder& RenderableManager::Builder::lodCount(uint8_t const lodCount) noexcept {
+    mImpl->mLodCount = clamp(lodCount, uint8_t(1), FRenderableManager::Lods::MAX_LOD_COUNT);
+    return *this;
+}
+
+RenderableManager::Builder& RenderableManager::Builder::lodThreshold(uint8_t const level,
+        float const coverage) noexcept {
+    if (level < FRenderableManager::Lods::MAX_LOD_COUNT - 1) {
+        mImpl->mLodThresholds[level] = clamp(coverage, 0.0f, 1.0f);
+    }
+    return *this;
+}
+
 RenderableManager::Builder& RenderableManager::Builder::material(size_t const index,
         MaterialInstance const* materialInstance) noexcept {
     if (index < mImpl->mEntries.size()) {
@@ -205,6 +223,11 @@ RenderableManager::Builder& RenderableManager::Builder::castShadows(bool const e
     return *this;
 }
 
+RenderableManager::Builder& RenderableManager::Builder::castShadowsStatic(bool const enable) noexcept {
+    mImpl->mCastShadowsStatic = enable;
+    return *this;
+}
+
 RenderableManager::Builder& RenderableManager::Builder::receiveShadows(bool const enable) noexcept {
     mImpl->mReceiveShadows = enable;
     return *this;
@@ -446,6 +469,11 @@ RenderableManager::Builder::Result RenderableManager::Builder::build(Engine& eng
             << ", but instance count is limited to CONFIG_MAX_INSTANCES (" << CONFIG_MAX_INSTANCES
             << ") instances when supplying transforms via an InstanceBuffer.";
 
+    FILAMENT_CHECK_PRECONDITION(mImpl->mEntries.size() % mImpl->mLodCount == 0)
+            << "primitive count (" << mImpl->mEntries.size()
+            << ") must be a multiple of the number of levels of detail ("
+            << unsigned(mImpl->mLodCount) << ")";
+
     if (mImpl->mGeometryType == GeometryType::STATIC) {
         FILAMENT_CHECK_PRECONDITION(mImpl->mSkinningBoneCount == 0)
                 << "Skinning can't be used with STATIC geometry";
@@ -567,11 +595,17 @@ void FRenderableManager::create(
         }
         setPrimitives(ci, { rp, size_type(entryCount) });
 
+        Lods& lods = manager[ci].lods;
+        lods.count = builder->mLodCount;
+        lods.primitiveCount = uint16_t(entryCount / builder->mLodCount);
+        std::copy_n(builder->mLodThresholds, Lods::MAX_LOD_COUNT - 1, lods.thresholds);
+
         setAxisAlignedBoundingBox(ci, builder->mAABB);
         setLayerMask(ci, builder->mLayerMask);
         setPriority(ci, builder->mPriority);
         setChannel(ci, builder->mCommandChannel);
         setCastShadows(ci, builder->mCastShadows);
+        setCastShadowsStatic(ci, builder->mCastShadowsStatic);
         setReceiveShadows(ci, builder->mReceiveShadows);
         setScreenSpaceContactShadows(ci, builder->mScreenSpaceContactShadows);
         setCulling(ci, builder->mCulling);
@@ -692,7 +726,15 @@ void FRenderableManager::create(
                         sizeof(PerRenderableMorphingUib),
                         BufferObjectBinding::UNIFORM,
                         BufferUsage::DYNAMIC),
-                .count = targetCount };
+                .count = targetCount,
+                .activeCount = targetCount };
+            if (targetCount > 0) {
+                // NaN-fill the shadow copy so the first setMorphWeights() always uploads
+                // (NaN compares unequal to everything, including itself)
+                morphWeights.lastWeights = new float[targetCount];
+                std::fill_n(morphWeights.lastWeights, targetCount,
+                        std::numeric_limits<float>::quiet_NaN());
+            }
 
             Slice<FRenderPrimitive>& primitives = mManager[ci].primitives;
             mManager[ci].morphTargetBuffer = morphTargetBuffer;
@@ -774,6 +816,7 @@ void FRenderableManager::destroyComponent(Instance const ci) noexcept {
     if (morphWeights.handle) {
         driver.destroyBufferObject(morphWeights.handle);
     }
+    delete[] morphWeights.lastWeights;
 
     InstancesInfo const& instances = manager[ci].instances;
     if (instances.handle) {
@@ -794,7 +837,7 @@ void FRenderableManager::setMaterialInstanceAt(Instance const instance, uint8_t
         size_t const primitiveIndex, FMaterialInstance const* mi) {
     assert_invariant(mi);
     if (instance) {
-        Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive> primitives = getRenderPrimitives(instance, level);
         if (primitiveIndex < primitives.size() && mi) {
             FMaterial const* material = mi->getMaterial();
 
@@ -822,7 +865,7 @@ void FRenderableManager::setMaterialInstanceAt(Instance const instance, uint8_t
 void FRenderableManager::clearMaterialInstanceAt(Instance instance, uint8_t level,
         size_t primitiveIndex) {
     if (instance) {
-        Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive> primitives = getRenderPrimitives(instance, level);
         if (primitiveIndex < primitives.size()) {
             primitives[primitiveIndex].setMaterialInstance(nullptr);
         }
@@ -832,7 +875,7 @@ void FRenderableManager::clearMaterialInstanceAt(Instance instance, uint8_t leve
 MaterialInstance* FRenderableManager::getMaterialInstanceAt(
         Instance const instance, uint8_t const level, size_t const primitiveIndex) const noexcept {
     if (instance) {
-        const Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive> const primitives = getRenderPrimitives(instance, level);
         if (primitiveIndex < primitives.size()) {
             // We store the material instance as const because we don't want to change it internally
             // but when the user queries it, we want to allow them to call setParameter()
@@ -845,7 +888,7 @@ MaterialInstance* FRenderableManager::getMaterialInstanceAt(
 void FRenderableManager::setBlendOrderAt(Instance const instance, uint8_t const level,
         size_t const primitiveIndex, uint16_t const order) noexcept {
     if (instance) {
-        Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive> primitives = getRenderPrimitives(instance, level);
         if (primitiveIndex < primitives.size()) {
             primitives[primitiveIndex].setBlendOrder(order);
         }
@@ -855,7 +898,7 @@ void FRenderableManager::setBlendOrderAt(Instance const instance, uint8_t const
 void FRenderableManager::setGlobalBlendOrderEnabledAt(Instance const instance, uint8_t const level,
         size_t const primitiveIndex, bool const enabled) noexcept {
     if (instance) {
-        Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive> primitives = getRenderPrimitives(instance, level);
         if (primitiveIndex < primitives.size()) {
             primitives[primitiveIndex].setGlobalBlendOrderEnabled(enabled);
         }
@@ -865,7 +908,7 @@ void FRenderableManager::setGlobalBlendOrderEnabledAt(Instance const instance, u
 AttributeBitset FRenderableManager::getEnabledAttributesAt(
         Instance const instance, uint8_t const level, size_t const primitiveIndex) const noexcept {
     if (instance) {
-        Slice<FRenderPrimitive> const& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive> const primitives = getRenderPrimitives(instance, level);
         if (primitiveIndex < primitives.size()) {
             return primitives[primitiveIndex].getEnabledAttributes();
         }
@@ -877,7 +920,7 @@ void FRenderableManager::setGeometryAt(Instance const instance, uint8_t const le
         PrimitiveType const type, FVertexBuffer* vertices, FIndexBuffer* indices,
         size_t const offset, size_t const count) noexcept {
     if (instance) {
-        Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive> primitives = getRenderPrimitives(instance, level);
         if (primitiveIndex < primitives.size()) {
             primitives[primitiveIndex].set(mHwRenderPrimitiveFactory, mEngine.getDriverApi(),
                     type, vertices, indices, offset, count);
@@ -964,9 +1007,53 @@ void FRenderableManager::setMorphWeights(Instance const instance, float const* w
                 << "Only " << CONFIG_MAX_MORPH_TARGET_COUNT
                 << " morph targets are supported (count=" << count << ", offset=" << offset << ")";
 
-        MorphWeights const& morphWeights = mManager[instance].morphWeights;
+        MorphWeights& morphWeights = mManager[instance].morphWeights;
         if (morphWeights.handle) {
-            updateMorphWeights(mEngine, morphWeights.handle, weights, count, offset);
+            if (float* const UTILS_RESTRICT shadow = morphWeights.lastWeights; shadow) {
+                // Only upload the range of weights that actually changed since the last call.
+                // A face with hundreds of targets typically animates a handful per frame, and
+                // animators keep feeding the full vector even when nothing moved (e.g. for
+                // LOD-reduced faces whose morph track is frozen), in which case we skip the
+                // upload entirely.
+                size_t lo = 0;
+                while (lo < count && shadow[offset + lo] == weights[lo]) {
+                    ++lo;
+                }
+                if (lo == count) {
+                    // unchanged, the UBO and activeCount are already consistent
+                    return;
+                }
+                size_t hi = count;
+                while (hi > lo && shadow[offset + hi - 1] == weights[hi - 1]) {
+                    --hi;
+                }
+                std::copy(weights + lo, weights + hi, shadow + offset + lo);
+                updateMorphWeights(mEngine, morphWeights.handle,
+                        weights + lo, hi - lo, offset + lo);
+            } else {
+                updateMorphWeights(mEngine, morphWeights.handle, weights, count, offset);
+            }
+
+            // track how many targets the shader actually needs to blend: everything past the
+            // last non-zero weight contributes nothing, so the vertex shader can stop there.
+            // With typical facial-animation palettes only a few of the targets are active at
+            // any given time.
+            size_t active = 0;
+            for (size_t i = count; i > 0; --i) {
+                if (weights[i - 1] != 0.0f) {
+                    active = offset + i;
+                    break;
+                }
+            }
+            if (offset == 0 && count >= morphWeights.activeCount) {
+                // the write covers all previously active targets, so this is exact
+                morphWeights.activeCount = uint32_t(active);
+            } else {
+                // partial update: targets outside the written range may still be active
+                morphWeights.activeCount =
+                        std::max(morphWeights.activeCount, uint32_t(active));
+            }
+            morphWeights.activeCount = std::min(morphWeights.activeCount, morphWeights.count);
         }
     }
 }
@@ -1022,4 +1109,12 @@ size_t FRenderableManager::getPrimitiveCount(Instance const instance, uint8_t co
     return getRenderPrimitives(instance, level).size();
 }
 
+Slice<FRenderPrimitive> FRenderableManager::getLodRenderPrimitives(
+        Instance const instance, uint8_t const level) const noexcept {
+    Slice<FRenderPrimitive> const& primitives = mManager[instance].primitives;
+    Lods const& lods = mManager[instance].lods;
+    assert_invariant(level < lods.count);
+    return { primitives.data() + size_t(level) * lods.primitiveCount, lods.primitiveCount };
+}
+
 } // namespace filament
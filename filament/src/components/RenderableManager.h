@@ -69,6 +69,7 @@ public:
         uint8_t priority                : 3;
         uint8_t channel                 : 2;
         bool castShadows                : 1;
+        bool castShadowsStatic          : 1;
         bool receiveShadows             : 1;
         bool culling                    : 1;
 
@@ -110,6 +111,10 @@ public:
         return mManager.empty();
     }
 
+    void reserve(size_t const n) noexcept {
+        mManager.reserve(n);
+    }
+
     utils::Entity getEntity(Instance const i) const noexcept {
         return mManager.getEntity(i);
     }
@@ -133,6 +138,7 @@ public:
     inline void setChannel(Instance instance, uint8_t channel) noexcept;
 
     inline void setCastShadows(Instance instance, bool enable) noexcept;
+    inline void setCastShadowsStatic(Instance instance, bool enable) noexcept;
 
     inline void setLayerMask(Instance instance, uint8_t layerMask) noexcept;
     inline void setReceiveShadows(Instance instance, bool enable) noexcept;
@@ -184,6 +190,7 @@ public:
     struct MorphingBindingInfo {
         backend::Handle<backend::HwBufferObject> handle;
         uint32_t count;
+        uint32_t activeCount;   // see MorphWeights::activeCount
         FMorphTargetBuffer const* morphTargetBuffer;
     };
     inline MorphingBindingInfo getMorphingBufferInfo(Instance instance) const noexcept;
@@ -200,7 +207,19 @@ public:
     static_assert(sizeof(InstancesInfo) == 16);
     inline InstancesInfo getInstancesInfo(Instance instance) const noexcept;
 
-    inline size_t getLevelCount(Instance) const noexcept { return 1u; }
+    // Levels of detail partition the primitives into `count` equally-sized consecutive
+    // groups, finest first. thresholds[i] is the projected screen coverage below which
+    // level i+1 takes over from level i; the last level has no lower bound.
+    struct Lods {
+        static constexpr uint8_t MAX_LOD_COUNT = 4;
+        float thresholds[MAX_LOD_COUNT - 1] = {};
+        uint8_t count = 1;              // number of levels
+        uint16_t primitiveCount = 0;    // primitives per level, only valid if count > 1
+    };
+    static_assert(sizeof(Lods) == 16);
+    inline Lods getLods(Instance instance) const noexcept;
+
+    inline size_t getLevelCount(Instance instance) const noexcept;
     size_t getPrimitiveCount(Instance instance, uint8_t level) const noexcept;
     void setMaterialInstanceAt(Instance instance, uint8_t level,
             size_t primitiveIndex, FMaterialInstance const* materialInstance);
@@ -212,8 +231,7 @@ public:
     void setBlendOrderAt(Instance instance, uint8_t level, size_t primitiveIndex, uint16_t blendOrder) noexcept;
     void setGlobalBlendOrderEnabledAt(Instance instance, uint8_t level, size_t primitiveIndex, bool enabled) noexcept;
     AttributeBitset getEnabledAttributesAt(Instance instance, uint8_t level, size_t primitiveIndex) const noexcept;
-    inline utils::Slice<FRenderPrimitive> const& getRenderPrimitives(Instance instance, uint8_t level) const noexcept;
-    inline utils::Slice<FRenderPrimitive>& getRenderPrimitives(Instance instance, uint8_t level) noexcept;
+    inline utils::Slice<FRenderPrimitive> getRenderPrimitives(Instance instance, uint8_t level) const noexcept;
 
     struct Entry {
         VertexBuffer* vertices = nullptr;
@@ -229,7 +247,15 @@ public:
         } morphing;
     };
 
+    HwRenderPrimitiveFactory& getHwRenderPrimitiveFactory() noexcept {
+        return mHwRenderPrimitiveFactory;
+    }
+
 private:
+    // out-of-line level selection, needs FRenderPrimitive to be a complete type
+    utils::Slice<FRenderPrimitive> getLodRenderPrimitives(
+            Instance instance, uint8_t level) const noexcept;
+
     void destroyComponent(Instance ci) noexcept;
     static void destroyComponentPrimitives(
             HwRenderPrimitiveFactory& factory, backend::DriverApi& driver,
@@ -247,8 +273,14 @@ private:
     struct MorphWeights {
         backend::Handle<backend::HwBufferObject> handle;
         uint32_t count = 0;
+        // number of targets up to and including the last one with a non-zero weight; this is
+        // what the vertex shader needs to iterate over (count is needed for buffer binding)
+        uint32_t activeCount = 0;
+        // shadow copy of the last uploaded weights, used by setMorphWeights() to upload only
+        // the dirty range (owned, freed in destroyComponent())
+        float* lastWeights = nullptr;
     };
-    static_assert(sizeof(MorphWeights) == 8);
+    static_assert(sizeof(MorphWeights) <= 24);
 
     enum {
         AABB,                   // user data
@@ -258,6 +290,7 @@ private:
         INSTANCES,              // user data
         VISIBILITY,             // user data
         PRIMITIVES,             // user data
+        LODS,                   // user data, level of detail partition of PRIMITIVES
         BONES,                  // filament data, UBO storing a pointer to the bones information
         MORPHTARGET_BUFFER,     // morphtarget buffer for the component
         DESCRIPTOR_SET          // per-renderable descriptor set
@@ -271,6 +304,7 @@ private:
             InstancesInfo,                   // INSTANCES
             Visibility,                      // VISIBILITY
             utils::Slice<FRenderPrimitive>,  // PRIMITIVES
+            Lods,                            // LODS
             Bones,                           // BONES
             FMorphTargetBuffer*,            // MORPHTARGET_BUFFER
             DescriptorSet          // DESCRIPTOR_SET
@@ -295,6 +329,7 @@ private:
                 Field<INSTANCES>            instances;
                 Field<VISIBILITY>           visibility;
                 Field<PRIMITIVES>           primitives;
+                Field<LODS>                 lods;
                 Field<BONES>                bones;
                 Field<MORPHTARGET_BUFFER>   morphTargetBuffer;
                 Field<DESCRIPTOR_SET>       descriptorSet;
@@ -361,6 +396,13 @@ void FRenderableManager::setCastShadows(Instance const instance, bool const enab
     }
 }
 
+void FRenderableManager::setCastShadowsStatic(Instance const instance, bool const enable) noexcept {
+    if (instance) {
+        Visibility& visibility = mManager[instance].visibility;
+        visibility.castShadowsStatic = enable;
+    }
+}
+
 void FRenderableManager::setReceiveShadows(Instance const instance, bool const enable) noexcept {
     if (instance) {
         Visibility& visibility = mManager[instance].visibility;
@@ -470,7 +512,7 @@ FRenderableManager::MorphingBindingInfo
 FRenderableManager::getMorphingBufferInfo(Instance const instance) const noexcept {
     MorphWeights const& morphWeights = mManager[instance].morphWeights;
     FMorphTargetBuffer const* const buffer = mManager[instance].morphTargetBuffer;
-    return { morphWeights.handle, morphWeights.count, buffer  };
+    return { morphWeights.handle, morphWeights.count, morphWeights.activeCount, buffer  };
 }
 
 FRenderableManager::InstancesInfo
@@ -478,14 +520,22 @@ FRenderableManager::getInstancesInfo(Instance const instance) const noexcept {
     return mManager[instance].instances;
 }
 
-utils::Slice<FRenderPrimitive> const& FRenderableManager::getRenderPrimitives(
-        Instance const instance, UTILS_UNUSED uint8_t level) const noexcept {
-    return mManager[instance].primitives;
+FRenderableManager::Lods FRenderableManager::getLods(Instance const instance) const noexcept {
+    return mManager[instance].lods;
 }
 
-utils::Slice<FRenderPrimitive>& FRenderableManager::getRenderPrimitives(
-        Instance const instance, UTILS_UNUSED uint8_t level) noexcept {
-    return mManager[instance].primitives;
+size_t FRenderableManager::getLevelCount(Instance const instance) const noexcept {
+    Lods const& lods = mManager[instance].lods;
+    return lods.count;
+}
+
+utils::Slice<FRenderPrimitive> FRenderableManager::getRenderPrimitives(
+        Instance const instance, uint8_t const level) const noexcept {
+    Lods const& lods = mManager[instance].lods;
+    if (UTILS_LIKELY(lods.count <= 1)) {
+        return mManager[instance].primitives;
+    }
+    return getLodRenderPrimitives(instance, level);
 }
 
 DescriptorSet& FRenderableManager::getDescriptorSet(Instance const instance) noexcept {
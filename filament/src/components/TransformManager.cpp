@@ -18,6 +18,8 @@
 
 #include <math/mat4.h>
 
+#include <algorithm>
+
 #include <utils/debug.h>
 #include <filament/TransformManager.h>
 
@@ -191,6 +193,8 @@ void FTransformManager::setTransform(Instance const ci, const mat4& model) noexc
 
 void FTransformManager::updateNodeTransform(Instance const i) noexcept {
     if (UTILS_UNLIKELY(mLocalTransformTransactionOpen)) {
+        // remember which locals changed, so the commit can propagate just those subtrees
+        mTransactionDirtyNodes.push_back(i);
         return;
     }
 
@@ -221,7 +225,24 @@ void FTransformManager::openLocalTransformTransaction() noexcept {
 void FTransformManager::commitLocalTransformTransaction() noexcept {
     if (mLocalTransformTransactionOpen) {
         mLocalTransformTransactionOpen = false;
-        computeAllWorldTransforms();
+        auto& dirty = mTransactionDirtyNodes;
+        if (!mTransactionStructuralChange && dirty.size() < mManager.getComponentCount() / 4) {
+            // Only a fraction of the nodes changed and the hierarchy kept its shape: propagate
+            // just the subtrees under the dirty nodes. Processing in instance order makes a
+            // dirty ancestor's world transform final before its dirty descendants read it in
+            // the common case; when a parent is ordered after its child (possible after a
+            // reparenting outside a transaction), the result is still correct because
+            // propagating the parent recomputes its entire subtree.
+            std::sort(dirty.begin(), dirty.end());
+            dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+            for (Instance const i : dirty) {
+                updateNodeTransform(i);
+            }
+        } else {
+            computeAllWorldTransforms();
+        }
+        dirty.clear();
+        mTransactionStructuralChange = false;
     }
 }
 
@@ -251,6 +272,10 @@ void FTransformManager::computeAllWorldTransforms() noexcept {
 
 // Inserts a parentless node in the hierarchy
 void FTransformManager::insertNode(Instance const i, Instance const parent) noexcept {
+    if (UTILS_UNLIKELY(mLocalTransformTransactionOpen)) {
+        mTransactionStructuralChange = true;
+    }
+
     auto& manager = mManager;
 
     assert_invariant(manager[i].parent == Instance{});
@@ -317,6 +342,11 @@ void FTransformManager::swapNode(Instance const i, Instance const j) noexcept {
 // removes a node from the graph, but doesn't remove it or its children from the array
 // (making everybody orphaned).
 void FTransformManager::removeNode(Instance const i) noexcept {
+    if (UTILS_UNLIKELY(mLocalTransformTransactionOpen)) {
+        // components may move as a result; the recorded dirty instances can't be trusted
+        mTransactionStructuralChange = true;
+    }
+
     auto& manager = mManager;
     Instance const parent = manager[i].parent;
     Instance const prev = manager[i].prev;
@@ -28,6 +28,8 @@
 
 #include <math/mat4.h>
 
+#include <vector>
+
 namespace filament {
 
 class UTILS_PRIVATE FTransformManager : public TransformManager {
@@ -61,6 +63,10 @@ public:
         return mManager.empty();
     }
 
+    void reserve(size_t const n) noexcept {
+        mManager.reserve(n);
+    }
+
     utils::Entity getEntity(Instance const i) const noexcept {
         return mManager.getEntity(i);
     }
@@ -209,7 +215,13 @@ private:
     };
 
     Sim mManager;
+    // instances whose local transform was set while the transaction was open; lets the commit
+    // only re-propagate the affected subtrees instead of the whole hierarchy
+    std::vector<Instance> mTransactionDirtyNodes;
     bool mLocalTransformTransactionOpen = false;
+    // set when the hierarchy itself changed during the transaction, which invalidates the
+    // recorded dirty instances (components can move) and forces a full propagation on commit
+    bool mTransactionStructuralChange = false;
     bool mAccurateTranslations = false;
 };
 
@@ -37,6 +37,7 @@ namespace filament {
 
 struct BufferObject::BuilderDetails {
     BindingType mBindingType = BindingType::VERTEX;
+    UsageType mUsage = UsageType::STATIC;
     uint32_t mByteCount = 0;
 };
 
@@ -58,6 +59,11 @@ BufferObject::Builder& BufferObject::Builder::bindingType(BindingType const bind
     return *this;
 }
 
+BufferObject::Builder& BufferObject::Builder::usage(UsageType const usage) noexcept {
+    mImpl->mUsage = usage;
+    return *this;
+}
+
 BufferObject::Builder& BufferObject::Builder::name(const char* name, size_t const len) noexcept {
     return BuilderNameMixin::name(name, len);
 }
@@ -76,13 +82,15 @@ FBufferObject::FBufferObject(FEngine& engine, const Builder& builder)
         : mByteCount(builder->mByteCount), mBindingType(builder->mBindingType) {
     FEngine::DriverApi& driver = engine.getDriverApi();
     mHandle = driver.createBufferObject(builder->mByteCount, builder->mBindingType,
-            backend::BufferUsage::STATIC);
+            builder->mUsage);
     if (auto name = builder.getName(); !name.empty()) {
         driver.setDebugTag(mHandle.getId(), std::move(name));
     }
+    engine.getMemoryMonitor().track(MemoryMonitor::Category::BUFFERS, mByteCount);
 }
 
 void FBufferObject::terminate(FEngine& engine) {
+    engine.getMemoryMonitor().release(MemoryMonitor::Category::BUFFERS, mByteCount);
     FEngine::DriverApi& driver = engine.getDriverApi();
     driver.destroyBufferObject(mHandle);
 }
@@ -95,4 +103,8 @@ void FBufferObject::setBuffer(FEngine& engine, BufferDescriptor&& buffer, uint32
     engine.getDriverApi().updateBufferObject(mHandle, std::move(buffer), byteOffset);
 }
 
+void* FBufferObject::getMappedBuffer(FEngine& engine) const noexcept {
+    return engine.getDriverApi().getBufferObjectMapping(mHandle);
+}
+
 } // namespace filament
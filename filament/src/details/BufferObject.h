@@ -42,6 +42,8 @@ public:
 
     BindingType getBindingType() const noexcept { return mBindingType; }
 
+    void* getMappedBuffer(FEngine& engine) const noexcept;
+
 private:
     friend class BufferObject;
     void setBuffer(FEngine& engine, BufferDescriptor&& buffer, uint32_t byteOffset = 0);
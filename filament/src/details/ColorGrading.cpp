@@ -31,9 +31,11 @@
 
 #include <private/utils/Tracing.h>
 
+#include <utils/Hash.h>
 #include <utils/JobSystem.h>
 #include <utils/Mutex.h>
 
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
 #include <tuple>
@@ -652,6 +654,117 @@ struct Config {
     ColorTransform oetf;
 };
 
+// State of an asynchronous 3D LUT bake. The constructor kicks off the slice jobs and returns
+// immediately; completeBake() waits if needed and uploads the result. The Builder copy keeps
+// the grading parameters alive, but note that the tone mapper itself is owned by the caller
+// and must outlive the bake.
+struct FColorGrading::BakeState {
+    ColorGrading::Builder builder;
+    Config config;
+    void* data;
+    void* converted;
+    uint32_t width;
+    uint32_t height;
+    uint32_t depth;
+    size_t lutElementCount;
+    size_t elementSize;
+    backend::PixelDataFormat format;
+    backend::PixelDataType type;
+    std::atomic<uint32_t> remainingSlices;
+    std::atomic<bool> done = { false };
+};
+
+float3 FColorGrading::hdrColorAt(size_t r, size_t g, size_t b,
+        Builder const& builder, Config const& config) noexcept {
+    float3 v = float3{r, g, b} * (1.0f / float(config.lutDimension - 1u));
+
+    // LogC encoding
+    v = LogC_to_linear(v);
+
+    // Kill negative values near 0.0f due to imprecision in the log conversion
+    v = max(v, 0.0f);
+
+    if (builder->hasAdjustments) {
+        // Exposure
+        v = adjustExposure(v, builder->exposure);
+
+        // Purkinje shift ("low-light" vision)
+        v = scotopicAdaptation(v, builder->nightAdaptation);
+    }
+
+    // Move to color grading color space
+    v = config.colorGradingIn * v;
+
+    if (builder->hasAdjustments) {
+        // White balance
+        v = chromaticAdaptation(v, config.adaptationTransform);
+
+        // Kill negative values before the next transforms
+        v = max(v, 0.0f);
+
+        // Channel mixer
+        v = channelMixer(v, builder->outRed, builder->outGreen, builder->outBlue);
+
+        // Shadows/mid-tones/highlights
+        v = tonalRanges(v, config.colorGradingLuminance,
+                builder->shadows, builder->midtones, builder->highlights,
+                builder->tonalRanges);
+
+        // The adjustments below behave better in log space
+        v = linear_to_LogC(v);
+
+        // ASC CDL
+        v = colorDecisionList(v, builder->slope, builder->offset, builder->power);
+
+        // Contrast in log space
+        v = contrast(v, builder->contrast);
+
+        // Back to linear space
+        v = LogC_to_linear(v);
+
+        // Vibrance in linear space
+        v = vibrance(v, config.colorGradingLuminance, builder->vibrance);
+
+        // Saturation in linear space
+        v = saturation(v, config.colorGradingLuminance, builder->saturation);
+
+        // Kill negative values before curves
+        v = max(v, 0.0f);
+
+        // RGB curves
+        v = curves(v,
+                builder->shadowGamma, builder->midPoint, builder->highlightScale);
+    }
+
+    // Tone mapping
+    if (builder->luminanceScaling) {
+        v = luminanceScaling(v, *builder->toneMapper, config.colorGradingLuminance);
+    } else {
+        v = (*builder->toneMapper)(v);
+    }
+
+    // Go back to display color space
+    v = config.colorGradingOut * v;
+
+    // Apply gamut mapping
+    if (builder->gamutMapping) {
+        // TODO: This should depend on the output color space
+        v = gamutMapping_sRGB(v);
+    }
+
+    // TODO: We should convert to the output color space if we use a working
+    //       color space that's not sRGB
+    // TODO: Allow the user to customize the output color space
+
+    // We need to clamp for the output transfer function
+    v = saturate(v);
+
+    // Apply OETF
+    v = config.oetf(v);
+
+    return v;
+}
+
 // Inside the FColorGrading constructor, TSAN sporadically detects a data race on the config struct;
 // the Filament thread writes and the Job thread reads. In practice there should be no data race, so
 // we force TSAN off to silence the warning.
@@ -659,6 +772,20 @@ UTILS_NO_SANITIZE_THREAD
 FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
     FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
 
+    // Identical settings produce an identical LUT, and UIs tend to rebuild ColorGrading
+    // objects on every preset switch, so first check whether this exact grading was already
+    // baked (64^3 float LUTs are 1.5 MiB each, and a bake takes several milliseconds).
+    uint64_t const key = computeCacheKey(engine, builder);
+    LutCache& lutCache = engine.getColorGradingLutCache();
+    if (LutCache::Entry* const entry = lutCache.acquire(key)) {
+        mCacheEntry = entry;
+        mLutHandle = entry->lut;
+        mDimension = entry->dimension;
+        mIsOneDimensional = entry->isOneDimensional;
+        mIsLDR = entry->isLDR;
+        return;
+    }
+
     DriverApi& driver = engine.getDriverApi();
 
     // XXX: The following two conditions also only hold true as long as the input and output color
@@ -702,103 +829,19 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
     assert_invariant(FTexture::isTextureFormatSupported(engine, textureFormat));
     assert_invariant(FTexture::validatePixelFormatAndType(textureFormat, format, type));
 
-    void* converted = nullptr;
-    if (type == PixelDataType::UINT_2_10_10_10_REV) {
-        // convert input to UINT_2_10_10_10_REV if needed
-        converted = malloc(lutElementCount * sizeof(uint32_t));
-    }
-
-    auto hdrColorAt = [builder, config](size_t r, size_t g, size_t b) {
-        float3 v = float3{r, g, b} * (1.0f / float(config.lutDimension - 1u));
-
-        // LogC encoding
-        v = LogC_to_linear(v);
-
-        // Kill negative values near 0.0f due to imprecision in the log conversion
-        v = max(v, 0.0f);
-
-        if (builder->hasAdjustments) {
-            // Exposure
-            v = adjustExposure(v, builder->exposure);
-
-            // Purkinje shift ("low-light" vision)
-            v = scotopicAdaptation(v, builder->nightAdaptation);
-        }
-
-        // Move to color grading color space
-        v = config.colorGradingIn * v;
-
-        if (builder->hasAdjustments) {
-            // White balance
-            v = chromaticAdaptation(v, config.adaptationTransform);
-
-            // Kill negative values before the next transforms
-            v = max(v, 0.0f);
-
-            // Channel mixer
-            v = channelMixer(v, builder->outRed, builder->outGreen, builder->outBlue);
-
-            // Shadows/mid-tones/highlights
-            v = tonalRanges(v, config.colorGradingLuminance,
-                    builder->shadows, builder->midtones, builder->highlights,
-                    builder->tonalRanges);
-
-            // The adjustments below behave better in log space
-            v = linear_to_LogC(v);
-
-            // ASC CDL
-            v = colorDecisionList(v, builder->slope, builder->offset, builder->power);
-
-            // Contrast in log space
-            v = contrast(v, builder->contrast);
-
-            // Back to linear space
-            v = LogC_to_linear(v);
-
-            // Vibrance in linear space
-            v = vibrance(v, config.colorGradingLuminance, builder->vibrance);
-
-            // Saturation in linear space
-            v = saturation(v, config.colorGradingLuminance, builder->saturation);
-
-            // Kill negative values before curves
-            v = max(v, 0.0f);
-
-            // RGB curves
-            v = curves(v,
-                    builder->shadowGamma, builder->midPoint, builder->highlightScale);
-        }
-
-        // Tone mapping
-        if (builder->luminanceScaling) {
-            v = luminanceScaling(v, *builder->toneMapper, config.colorGradingLuminance);
-        } else {
-            v = (*builder->toneMapper)(v);
-        }
-
-        // Go back to display color space
-        v = config.colorGradingOut * v;
-
-        // Apply gamut mapping
-        if (builder->gamutMapping) {
-            // TODO: This should depend on the output color space
-            v = gamutMapping_sRGB(v);
-        }
-
-        // TODO: We should convert to the output color space if we use a working
-        //       color space that's not sRGB
-        // TODO: Allow the user to customize the output color space
-
-        // We need to clamp for the output transfer function
-        v = saturate(v);
-
-        // Apply OETF
-        v = config.oetf(v);
+    //auto now = std::chrono::steady_clock::now();
 
-        return v;
-    };
+    // Create the texture first so the handle is valid immediately. For the 3D case its
+    // content is uploaded by completeBake() once the slice jobs are done.
+    mLutHandle = driver.createTexture(SamplerType::SAMPLER_3D, 1, textureFormat, 1,
+            width, height, depth, TextureUsage::DEFAULT);
 
-    //auto now = std::chrono::steady_clock::now();
+    LutCache::Entry* const entry = lutCache.insert(key);
+    entry->lut = mLutHandle;
+    entry->dimension = mDimension;
+    entry->isOneDimensional = mIsOneDimensional;
+    entry->isLDR = mIsLDR;
+    mCacheEntry = entry;
 
     if (mIsOneDimensional) {
         half* UTILS_RESTRICT p = (half*) data;
@@ -818,31 +861,53 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
             }
         } else {
             for (size_t rgb = 0; rgb < config.lutDimension; rgb++) {
-                *p++ = half(hdrColorAt(rgb, rgb, rgb).r);
+                *p++ = half(hdrColorAt(rgb, rgb, rgb, builder, config).r);
             }
         }
+
+        driver.update3DImage(mLutHandle, 0,
+                0, 0, 0,
+                width, height, depth,
+                PixelBufferDescriptor{
+                    data, lutElementCount * elementSize, format, type,
+                            [](void* buffer, size_t, void*) { free(buffer); }
+                            });
     } else {
+        void* converted = nullptr;
+        if (type == PixelDataType::UINT_2_10_10_10_REV) {
+            // convert input to UINT_2_10_10_10_REV if needed
+            converted = malloc(lutElementCount * sizeof(uint32_t));
+        }
+
         // Multithreadedly generate the tone mapping 3D look-up table using 32 jobs
         // Slices are 8 KiB (128 cache lines) apart.
-        // This takes about 3-6ms on Android in Release
+        // This takes about 3-6ms on Android in Release. The bake runs asynchronously: the
+        // constructor returns immediately and completeBake() uploads the result once the
+        // jobs are done, so switching to a new color grading doesn't stall a frame
+        // (see FView::setColorGrading()).
+        BakeState* const bake = new BakeState{
+                builder, config, data, converted,
+                width, height, depth, lutElementCount, elementSize, format, type,
+                { uint32_t(config.lutDimension) },
+        };
         JobSystem& js = engine.getJobSystem();
         auto *slices = js.createJob();
         for (size_t b = 0; b < config.lutDimension; b++) {
             auto* job = js.createJob(slices,
-                    [data, converted, b, &config, builder, &hdrColorAt](
-                            JobSystem&, JobSystem::Job*) {
+                    [bake, b](JobSystem&, JobSystem::Job*) {
+                Config const& config = bake->config;
                 half4* UTILS_RESTRICT p =
-                        (half4*) data + b * config.lutDimension * config.lutDimension;
+                        (half4*) bake->data + b * config.lutDimension * config.lutDimension;
                 for (size_t g = 0; g < config.lutDimension; g++) {
                     for (size_t r = 0; r < config.lutDimension; r++) {
-                        *p++ = half4{hdrColorAt(r, g, b), 0.0f};
+                        *p++ = half4{hdrColorAt(r, g, b, bake->builder, config), 0.0f};
                     }
                 }
 
-                if (converted) {
-                    uint32_t* const UTILS_RESTRICT dst = (uint32_t*) converted +
+                if (bake->converted) {
+                    uint32_t* const UTILS_RESTRICT dst = (uint32_t*) bake->converted +
                             b * config.lutDimension * config.lutDimension;
-                    half4* UTILS_RESTRICT src = (half4*) data +
+                    half4* UTILS_RESTRICT src = (half4*) bake->data +
                             b * config.lutDimension * config.lutDimension;
                     // we use a vectorize width of 8 because, on ARMv8 it allows the compiler to
                     // write eight 32-bits results in one go.
@@ -858,42 +923,209 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
                         dst[i] = (pb << 20u) | (pg << 10u) | pr;
                     }
                 }
+
+                // the last slice to finish publishes the bake (see isReady())
+                if (bake->remainingSlices.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    bake->done.store(true, std::memory_order_release);
+                }
             });
             js.run(job);
         }
 
-        // TODO: Should we do a runAndRetain() and defer the wait() + texture creation until
-        //       getHwHandle() is invoked?
-        js.runAndWait(slices);
+        entry->bakeState = bake;
+        entry->bakeJob = js.runAndRetain(slices);
     }
 
     //std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - now;
     //DLOG(INFO) << "LUT generation time: " << duration.count() << " ms";
+}
 
-    if (converted) {
-        free(data);
-        data = converted;
-        elementSize = sizeof(uint32_t);
+bool FColorGrading::isReady() const noexcept {
+    BakeState const* const bake = mCacheEntry->bakeState;
+    return bake == nullptr || bake->done.load(std::memory_order_acquire);
+}
+
+void FColorGrading::completeBake(FEngine& engine) const noexcept {
+    // the bake is shared with every FColorGrading built from the same settings; whoever
+    // needs the LUT first finishes it
+    LutCache::Entry* const entry = mCacheEntry;
+    BakeState* const bake = entry->bakeState;
+    if (bake == nullptr) {
+        return;
     }
 
-    // Create texture.
-    mLutHandle = driver.createTexture(SamplerType::SAMPLER_3D, 1, textureFormat, 1,
-            width, height, depth, TextureUsage::DEFAULT);
+    // returns immediately if the slice jobs have already finished (see isReady())
+    engine.getJobSystem().waitAndRelease(entry->bakeJob);
+
+    void* data = bake->data;
+    size_t elementSize = bake->elementSize;
+    if (bake->converted) {
+        free(bake->data);
+        data = bake->converted;
+        elementSize = sizeof(uint32_t);
+    }
 
-    driver.update3DImage(mLutHandle, 0,
+    engine.getDriverApi().update3DImage(mLutHandle, 0,
             0, 0, 0,
-            width, height, depth,
+            bake->width, bake->height, bake->depth,
             PixelBufferDescriptor{
-                data, lutElementCount * elementSize, format, type,
+                data, bake->lutElementCount * elementSize, bake->format, bake->type,
                         [](void* buffer, size_t, void*) { free(buffer); }
                         });
+
+    entry->bakeState = nullptr;
+    entry->bakeJob = nullptr;
+    delete bake;
 }
 
 FColorGrading::~FColorGrading() noexcept = default;
 
 void FColorGrading::terminate(FEngine& engine) {
-    DriverApi& driver = engine.getDriverApi();
-    driver.destroyTexture(mLutHandle);
+    engine.getColorGradingLutCache().release(engine, mCacheEntry);
+    mCacheEntry = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// LUT dedup cache
+//------------------------------------------------------------------------------
+
+uint64_t FColorGrading::computeCacheKey(FEngine& engine, Builder const& builder) noexcept {
+    size_t seed = 0;
+    auto hashFloat3 = [&seed](float3 const v) {
+        hash::combine(seed, v.x);
+        hash::combine(seed, v.y);
+        hash::combine(seed, v.z);
+    };
+
+    // Everything that influences the baked LUT content must be hashed here, which is a
+    // superset of what BuilderDetails::operator==() compares: the (deprecated) toneMapping
+    // enum selects the grading transforms, and the 1D LUT feature flag changes the texture
+    // we produce.
+    hash::combine(seed, builder->format);
+    hash::combine(seed, builder->dimension);
+    hash::combine(seed, builder->toneMapping);
+    hash::combine(seed, builder->luminanceScaling);
+    hash::combine(seed, builder->gamutMapping);
+    hash::combine(seed, builder->exposure);
+    hash::combine(seed, builder->nightAdaptation);
+    hash::combine(seed, builder->whiteBalance.x);
+    hash::combine(seed, builder->whiteBalance.y);
+    hashFloat3(builder->outRed);
+    hashFloat3(builder->outGreen);
+    hashFloat3(builder->outBlue);
+    hashFloat3(builder->shadows);
+    hashFloat3(builder->midtones);
+    hashFloat3(builder->highlights);
+    hashFloat3(builder->tonalRanges.xyz);
+    hash::combine(seed, builder->tonalRanges.w);
+    hashFloat3(builder->slope);
+    hashFloat3(builder->offset);
+    hashFloat3(builder->power);
+    hash::combine(seed, builder->contrast);
+    hash::combine(seed, builder->vibrance);
+    hash::combine(seed, builder->saturation);
+    hashFloat3(builder->shadowGamma);
+    hashFloat3(builder->midPoint);
+    hashFloat3(builder->highlightScale);
+    hash::combine(seed, builder->hasAdjustments);
+    hash::combine(seed, engine.features.engine.color_grading.use_1d_lut);
+
+    ColorSpace const& colorSpace = builder->outputColorSpace;
+    auto const& primaries = colorSpace.getPrimaries();
+    hash::combine(seed, primaries.r.x);
+    hash::combine(seed, primaries.r.y);
+    hash::combine(seed, primaries.g.x);
+    hash::combine(seed, primaries.g.y);
+    hash::combine(seed, primaries.b.x);
+    hash::combine(seed, primaries.b.y);
+    hash::combine(seed, colorSpace.getWhitePoint().x);
+    hash::combine(seed, colorSpace.getWhitePoint().y);
+    auto const& transferFunction = colorSpace.getTransferFunction();
+    hash::combine(seed, transferFunction.a);
+    hash::combine(seed, transferFunction.b);
+    hash::combine(seed, transferFunction.c);
+    hash::combine(seed, transferFunction.d);
+    hash::combine(seed, transferFunction.e);
+    hash::combine(seed, transferFunction.f);
+    hash::combine(seed, transferFunction.g);
+
+    // The tone mapper is an opaque user subclass that we cannot introspect (and RTTI is
+    // disabled), so it is keyed by behavior instead: sample its response on a low-discrepancy
+    // set of probe colors spanning the LUT input domain and hash the results. Any parameter
+    // change of a practical tone mapping operator perturbs most of its outputs, so probes
+    // from two different operators won't agree.
+    ToneMapper const& toneMapper = *builder->toneMapper;
+    constexpr size_t PROBE_COUNT = 32;
+    for (size_t i = 0; i < PROBE_COUNT; i++) {
+        auto const fract = [](float const v) { return v - std::floor(v); };
+        float3 const c = LogC_to_linear(float3{
+                fract(0.5f + float(i) * 0.6180339887f),   // 1D low-discrepancy sequences
+                fract(0.5f + float(i) * 0.7548776662f),   // (additive recurrences) in the
+                fract(0.5f + float(i) * 0.5698402910f)}); // LogC-encoded input domain
+        hashFloat3(toneMapper(c));
+    }
+    hash::combine(seed, toneMapper.isOneDimensional());
+    hash::combine(seed, toneMapper.isLDR());
+
+    return seed;
+}
+
+FColorGrading::LutCache::Entry* FColorGrading::LutCache::acquire(uint64_t const key) noexcept {
+    if (auto const pos = mEntries.find(key); pos != mEntries.end()) {
+        Entry* const entry = pos->second;
+        entry->refCount++;
+        return entry;
+    }
+    return nullptr;
+}
+
+FColorGrading::LutCache::Entry* FColorGrading::LutCache::insert(uint64_t const key) noexcept {
+    Entry* const entry = new Entry{};
+    entry->key = key;
+    entry->refCount = 1;
+    mEntries[key] = entry;
+    return entry;
+}
+
+void FColorGrading::LutCache::release(FEngine& engine, Entry* const entry) noexcept {
+    assert_invariant(entry && entry->refCount > 0);
+    if (--entry->refCount > 0) {
+        return;
+    }
+    if (UTILS_UNLIKELY(entry->bakeState)) {
+        // the bake was never consumed; wait for the jobs and drop the result
+        engine.getJobSystem().waitAndRelease(entry->bakeJob);
+        free(entry->bakeState->data);
+        free(entry->bakeState->converted);
+        delete entry->bakeState;
+    }
+    engine.getDriverApi().destroyTexture(entry->lut);
+    mEntries.erase(entry->key);
+    delete entry;
+}
+
+void FColorGrading::LutCache::terminate(FEngine& engine) noexcept {
+    // FEngine::shutdown() terminates all ColorGrading objects before we get here, so the map
+    // is normally already empty; this is just protection against leaked references.
+    for (auto const& [key, entry]: mEntries) {
+        if (entry->bakeState) {
+            engine.getJobSystem().waitAndRelease(entry->bakeJob);
+            free(entry->bakeState->data);
+            free(entry->bakeState->converted);
+            delete entry->bakeState;
+        }
+        engine.getDriverApi().destroyTexture(entry->lut);
+        delete entry;
+    }
+    mEntries.clear();
+}
+
+//------------------------------------------------------------------------------
+// Public API
+//------------------------------------------------------------------------------
+
+bool ColorGrading::isReady() const noexcept {
+    return downcast(this)->isReady();
 }
 
 } //namespace filament
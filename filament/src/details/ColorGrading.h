@@ -24,14 +24,57 @@
 
 #include <filament/ColorGrading.h>
 
+#include <utils/JobSystem.h>
+
 #include <math/mathfwd.h>
 
+#include <tsl/robin_map.h>
+
+#include <stdint.h>
+
 namespace filament {
 
 class FEngine;
+struct Config;
 
 class FColorGrading : public ColorGrading {
 public:
+    struct BakeState; // state of an asynchronous 3D LUT bake, defined in ColorGrading.cpp
+
+    // Engine-level dedup cache for baked LUTs, keyed by a hash of the Builder settings and
+    // of the tone mapper's sampled response. Entries are refcounted: FColorGrading instances
+    // built from identical settings share one LUT texture (and one bake), which is destroyed
+    // when the last of them goes away.
+    class LutCache {
+    public:
+        LutCache() noexcept = default;
+        LutCache(LutCache const&) = delete;
+        LutCache& operator=(LutCache const&) = delete;
+
+        // destroys whatever is left; all entries are normally gone by the time this is called
+        void terminate(FEngine& engine) noexcept;
+
+    private:
+        friend class FColorGrading;
+
+        struct Entry {
+            backend::TextureHandle lut;
+            BakeState* bakeState = nullptr; // non-null while the shared bake is in flight
+            utils::JobSystem::Job* bakeJob = nullptr;
+            uint64_t key = 0;
+            uint32_t dimension = 0;
+            uint32_t refCount = 0;
+            bool isOneDimensional = false;
+            bool isLDR = false;
+        };
+
+        Entry* acquire(uint64_t key) noexcept;  // bumps the refcount on a hit, else nullptr
+        Entry* insert(uint64_t key) noexcept;   // adds a new entry with a refcount of 1
+        void release(FEngine& engine, Entry* entry) noexcept;
+
+        tsl::robin_map<uint64_t, Entry*> mEntries;
+    };
+
     FColorGrading(FEngine& engine, const Builder& builder);
     FColorGrading(const FColorGrading& rhs) = delete;
     FColorGrading& operator=(const FColorGrading& rhs) = delete;
@@ -41,13 +84,27 @@ public:
     // frees driver resources, object becomes invalid
     void terminate(FEngine& engine);
 
+    // true once the asynchronous 3D LUT bake has finished (always true for 1D LUTs)
+    bool isReady() const noexcept;
+
+    // Waits for the LUT bake if needed and uploads the result to the texture. Must be
+    // called from the engine thread before the LUT is sampled; no-op once completed.
+    // This is logically const (lazy finalization of the shared cache entry).
+    void completeBake(FEngine& engine) const noexcept;
+
     backend::TextureHandle getHwHandle() const noexcept { return mLutHandle; }
     uint32_t getDimension() const noexcept { return mDimension; }
     bool isOneDimensional() const noexcept { return mIsOneDimensional; }
     bool isLDR() const noexcept { return mIsLDR; }
 
 private:
+    static math::float3 hdrColorAt(size_t r, size_t g, size_t b,
+            Builder const& builder, Config const& config) noexcept;
+
+    static uint64_t computeCacheKey(FEngine& engine, Builder const& builder) noexcept;
+
     backend::TextureHandle mLutHandle;
+    LutCache::Entry* mCacheEntry = nullptr; // owns our share of the LUT, never null
     uint32_t mDimension;
     bool mIsOneDimensional;
     bool mIsLDR;
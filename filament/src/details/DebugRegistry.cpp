@@ -24,10 +24,15 @@
 #include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <string_view>
 #include <utility>
 
+#include <stddef.h>
+#include <stdint.h>
+
 using namespace filament::math;
 using namespace utils;
 
@@ -136,6 +141,37 @@ void FDebugRegistry::unregisterDataSource(std::string_view const name) noexcept
 }
 
 
+FDebugRegistry::Counter* FDebugRegistry::registerCounter(std::string_view const name,
+        CounterType const type) noexcept {
+    auto& counterMap = mCounterMap;
+    auto const& pos = counterMap.find(name);
+    if (pos != counterMap.end()) {
+        return pos->second;
+    }
+    auto& entry = mCounters.emplace_back();
+    entry.name = name;
+    entry.type = type;
+    counterMap[name] = &entry.counter;
+    return &entry.counter;
+}
+
+size_t FDebugRegistry::snapshotCounters(CounterSnapshot* out, size_t const capacity) const noexcept {
+    auto const& counters = mCounters;
+    size_t const n = std::min(counters.size(), capacity);
+    for (size_t i = 0; i < n; i++) {
+        CounterEntry const& entry = counters[i];
+        uint64_t const bits = entry.counter.mBits.load(std::memory_order_relaxed);
+        out[i].name = entry.name.data();
+        out[i].type = entry.type;
+        if (entry.type == CounterType::FLOAT) {
+            out[i].f = utils::bit_cast<float>(uint32_t(bits));
+        } else {
+            out[i].u64 = bits;
+        }
+    }
+    return counters.size();
+}
+
 DebugRegistry::DataSource FDebugRegistry::getDataSource(const char* name) const noexcept {
     std::string_view const key{ name };
     auto& dataSourceMap = mDataSourceMap;
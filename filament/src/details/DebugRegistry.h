@@ -21,17 +21,21 @@
 
 #include <filament/DebugRegistry.h>
 
+#include <utils/algorithm.h>
 #include <utils/compiler.h>
 #include <utils/Invocable.h>
 
 #include <math/mathfwd.h>
 
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace filament {
 
@@ -100,6 +104,37 @@ public:
         registerProperty(name, p, FLOAT4, std::move(fn));
     }
 
+    /**
+     * A high-frequency telemetry counter. Writers publish with single atomic stores and
+     * readers snapshot without locks, so counters are cheap enough to update from hot
+     * paths every frame and safe to poll from another thread in shipping builds.
+     */
+    class Counter {
+    public:
+        void set(uint64_t const v) noexcept {
+            mBits.store(v, std::memory_order_relaxed);
+        }
+        void set(float const v) noexcept {
+            mBits.store(utils::bit_cast<uint32_t>(v), std::memory_order_relaxed);
+        }
+        void increment(uint64_t const n = 1) noexcept {
+            mBits.fetch_add(n, std::memory_order_relaxed);
+        }
+    private:
+        friend class FDebugRegistry;
+        std::atomic<uint64_t> mBits{ 0 };
+    };
+
+    /**
+     * Registers a counter under a stable name, or retrieves it if it already exists. The
+     * returned pointer remains valid for the lifetime of the registry. \p name must be a
+     * string literal. Counters should be registered during engine initialization, before
+     * another thread can call snapshotCounters().
+     */
+    Counter* registerCounter(std::string_view name, CounterType type) noexcept;
+
+    size_t snapshotCounters(CounterSnapshot* out, size_t capacity) const noexcept;
+
     // registers a DataSource directly
     bool registerDataSource(std::string_view name, void const* data, size_t count) noexcept;
 
@@ -124,7 +159,14 @@ private:
     void* getPropertyAddress(const char* name);
     void const* getPropertyAddress(const char* name) const noexcept;
     DataSource getDataSource(const char* name) const noexcept;
+    struct CounterEntry {
+        std::string_view name;
+        CounterType type;
+        Counter counter;
+    };
     std::unordered_map<std::string_view, PropertyInfo> mPropertyMap;
+    std::deque<CounterEntry> mCounters; // deque so registered counters have stable addresses
+    std::unordered_map<std::string_view, Counter*> mCounterMap;
     mutable std::unordered_map<std::string_view, DataSource> mDataSourceMap;
     mutable std::unordered_map<std::string_view, utils::Invocable<DataSource()>> mDataSourceCreatorMap;
 };
@@ -51,6 +51,7 @@
 #include <backend/DriverEnums.h>
 
 #include <private/utils/Tracing.h>
+#include <private/utils/TraceRecorder.h>
 
 #include <utils/Allocator.h>
 #include <utils/CallStack.h>
@@ -134,6 +135,7 @@ Engine* FEngine::create(Builder const& builder) {
         DriverConfig const driverConfig{
                 .handleArenaSize = instance->getRequestedDriverHandleArenaSize(),
                 .metalUploadBufferSizeBytes = instance->getConfig().metalUploadBufferSizeBytes,
+                .metalTextureHeapSizeBytes = instance->getConfig().metalTextureHeapSizeBytes,
                 .disableParallelShaderCompile = instance->features.backend.disable_parallel_shader_compile,
                 .disableHandleUseAfterFreeCheck = instance->features.backend.disable_handle_use_after_free_check,
                 .disableHeapHandleTags = instance->features.backend.disable_heap_handle_tags,
@@ -142,6 +144,7 @@ Engine* FEngine::create(Builder const& builder) {
                 .assertNativeWindowIsValid = instance->features.backend.opengl.assert_native_window_is_valid,
                 .metalDisablePanicOnDrawableFailure = instance->getConfig().metalDisablePanicOnDrawableFailure,
                 .gpuContextPriority = instance->getConfig().gpuContextPriority,
+                .shaderCompilerTickBudgetUs = instance->getConfig().shaderCompilerTickBudgetUs,
         };
         instance->mDriver = platform->createDriver(sharedContext, driverConfig);
 
@@ -321,6 +324,50 @@ void FEngine::init() {
     LOG(INFO) << "Backend feature level: " << int(driverApi.getFeatureLevel());
     LOG(INFO) << "FEngine feature level: " << int(mActiveFeatureLevel);
 
+    // Select the default material package now; its parse is pure CPU work independent of the
+    // driver-command setup below, so it runs on the job system and overlaps with it. Same for
+    // the DFG LUT preparation. Both are joined right before their results are needed.
+    const void* defaultMaterialData = nullptr;
+    size_t defaultMaterialSize = 0;
+#ifdef FILAMENT_ENABLE_FEATURE_LEVEL_0
+    if (UTILS_UNLIKELY(mActiveFeatureLevel == FeatureLevel::FEATURE_LEVEL_0)) {
+        defaultMaterialData = MATERIALS_DEFAULTMATERIAL_FL0_DATA;
+        defaultMaterialSize = MATERIALS_DEFAULTMATERIAL_FL0_SIZE;
+    } else
+#endif
+    {
+        switch (mConfig.stereoscopicType) {
+            case StereoscopicType::NONE:
+            case StereoscopicType::INSTANCED:
+                defaultMaterialData = MATERIALS_DEFAULTMATERIAL_DATA;
+                defaultMaterialSize = MATERIALS_DEFAULTMATERIAL_SIZE;
+                break;
+            case StereoscopicType::MULTIVIEW:
+#ifdef FILAMENT_ENABLE_MULTIVIEW
+                defaultMaterialData = MATERIALS_DEFAULTMATERIAL_MULTIVIEW_DATA;
+                defaultMaterialSize = MATERIALS_DEFAULTMATERIAL_MULTIVIEW_SIZE;
+#else
+                assert_invariant(false);
+#endif
+                break;
+        }
+    }
+
+    JobSystem& js = mJobSystem;
+
+    std::unique_ptr<MaterialParser> defaultMaterialParser;
+    JobSystem::Job* parseJob = js.runAndRetain(jobs::createJob(js, nullptr,
+            [this, &defaultMaterialParser, defaultMaterialData, defaultMaterialSize] {
+                // the package is resgen data linked into the binary, parse it in place
+                defaultMaterialParser = FMaterial::createParser(getBackend(),
+                        getShaderLanguage(), defaultMaterialData, defaultMaterialSize, false);
+            }));
+
+    JobSystem::Job* dfgJob = nullptr;
+    if (getSupportedFeatureLevel() >= FeatureLevel::FEATURE_LEVEL_1) {
+        dfgJob = js.runAndRetain(jobs::createJob(js, nullptr,
+                [this] { mDFG.prepareLut(*this); }));
+    }
 
     mResourceAllocatorDisposer = std::make_shared<ResourceAllocatorDisposer>(driverApi);
 
@@ -425,33 +472,14 @@ void FEngine::init() {
             driverApi,
             descriptor_sets::getPerRenderableLayout() };
 
-#ifdef FILAMENT_ENABLE_FEATURE_LEVEL_0
-    if (UTILS_UNLIKELY(mActiveFeatureLevel == FeatureLevel::FEATURE_LEVEL_0)) {
-        FMaterial::DefaultMaterialBuilder defaultMaterialBuilder;
-        defaultMaterialBuilder.package(
-                MATERIALS_DEFAULTMATERIAL_FL0_DATA, MATERIALS_DEFAULTMATERIAL_FL0_SIZE);
-        mDefaultMaterial = downcast(defaultMaterialBuilder.build(*const_cast<FEngine*>(this)));
-    } else
-#endif
     {
         FMaterial::DefaultMaterialBuilder defaultMaterialBuilder;
-        switch (mConfig.stereoscopicType) {
-            case StereoscopicType::NONE:
-            case StereoscopicType::INSTANCED:
-                defaultMaterialBuilder.package(
-                        MATERIALS_DEFAULTMATERIAL_DATA, MATERIALS_DEFAULTMATERIAL_SIZE);
-                break;
-            case StereoscopicType::MULTIVIEW:
-#ifdef FILAMENT_ENABLE_MULTIVIEW
-                defaultMaterialBuilder.package(
-                        MATERIALS_DEFAULTMATERIAL_MULTIVIEW_DATA,
-                        MATERIALS_DEFAULTMATERIAL_MULTIVIEW_SIZE);
-#else
-                assert_invariant(false);
-#endif
-                break;
-        }
-        mDefaultMaterial = downcast(defaultMaterialBuilder.build(*this));
+        defaultMaterialBuilder.package(defaultMaterialData, defaultMaterialSize);
+        js.waitAndRelease(parseJob);
+        // The default material package is known-good, so the validation that
+        // Material::Builder::build() performs on user packages is not needed here.
+        mDefaultMaterial = createMaterial(defaultMaterialBuilder,
+                std::move(defaultMaterialParser));
     }
 
     if (UTILS_UNLIKELY(getSupportedFeatureLevel() >= FeatureLevel::FEATURE_LEVEL_1)) {
@@ -484,6 +512,7 @@ void FEngine::init() {
                 BufferObjectBinding::UNIFORM, BufferUsage::STATIC);
 
         mLightManager.init(*this);
+        js.waitAndRelease(dfgJob);
         mDFG.init(*this);
     }
 
@@ -521,6 +550,47 @@ void FEngine::init() {
                 });
             });
 
+    mDebugRegistry.registerProperty("d.lighting.froxelize_records_compress_us",
+            &debug.lighting.froxelize_records_compress_us);
+
+    mDebugRegistry.registerProperty("d.renderer.heap_allocation_count",
+            &debug.renderer.heap_allocation_count);
+
+    mDebugRegistry.registerProperty("d.renderer.gpu_pass_profiling",
+            &debug.renderer.gpu_pass_profiling);
+
+    mDebugRegistry.registerProperty("d.shader_compiler.queue_depth",
+            &debug.shader_compiler.queue_depth);
+
+    debug.renderer.frame_count = mDebugRegistry.registerCounter("d.renderer.frame_count",
+            DebugRegistry::CounterType::UINT64);
+
+    debug.renderer.draw_calls = mDebugRegistry.registerCounter("d.renderer.draw_calls",
+            DebugRegistry::CounterType::UINT64);
+
+    debug.view.visible_renderables = mDebugRegistry.registerCounter("d.view.visible_renderables",
+            DebugRegistry::CounterType::UINT64);
+
+    mMemoryMonitor.init(mDebugRegistry);
+
+    // creation-path telemetry for the backend-object dedup factories, so cache behavior
+    // can be verified in load-time profiles
+    mHwDescriptorSetLayoutFactory.setCounters(
+            mDebugRegistry.registerCounter("d.factories.descriptor_set_layout.cache_hits",
+                    DebugRegistry::CounterType::UINT64),
+            mDebugRegistry.registerCounter("d.factories.descriptor_set_layout.cache_misses",
+                    DebugRegistry::CounterType::UINT64));
+    mHwVertexBufferInfoFactory.setCounters(
+            mDebugRegistry.registerCounter("d.factories.vertex_buffer_info.cache_hits",
+                    DebugRegistry::CounterType::UINT64),
+            mDebugRegistry.registerCounter("d.factories.vertex_buffer_info.cache_misses",
+                    DebugRegistry::CounterType::UINT64));
+    mRenderableManager.getHwRenderPrimitiveFactory().setCounters(
+            mDebugRegistry.registerCounter("d.factories.render_primitive.cache_hits",
+                    DebugRegistry::CounterType::UINT64),
+            mDebugRegistry.registerCounter("d.factories.render_primitive.cache_misses",
+                    DebugRegistry::CounterType::UINT64));
+
     mInitialized = true;
 }
 
@@ -606,6 +676,9 @@ void FEngine::shutdown() {
     cleanupResourceList(std::move(mSkyboxes));
     cleanupResourceList(std::move(mColorGradings));
 
+    // all LUT cache entries were released when the ColorGrading objects were terminated
+    mColorGradingLutCache.terminate(*this);
+
     // this must be done after Skyboxes and before materials
     destroy(mSkyboxMaterial);
     mSkyboxMaterial = nullptr;
@@ -676,6 +749,12 @@ void FEngine::prepare() {
     // skipped if the UBO hasn't changed. Still we could have a lot of these.
     DriverApi& driver = getDriverApi();
 
+    // evaluate the GPU memory budget watermark (see Engine::setMemoryBudget())
+    mMemoryMonitor.update();
+
+    // uploads the DFG LUT on the first frame (no-op afterwards)
+    mDFG.upload(*this);
+
     for (auto& materialInstanceList: mMaterialInstances) {
         materialInstanceList.second.forEach([&driver](FMaterialInstance* item) {
             // post-process materials instances must be commited explicitly because their
@@ -708,6 +787,138 @@ void FEngine::flush() {
     flushCommandBuffer(mCommandBufferQueue);
 }
 
+void FEngine::trimMemory() noexcept {
+    // release the scratch buffers subsystems are not actively using
+    mScratchBufferPool.trim();
+}
+
+void FEngine::queueMipmapGeneration(FTexture const* texture) noexcept {
+    auto& queue = mPendingMipmapGeneration;
+    if (std::find(queue.begin(), queue.end(), texture) == queue.end()) {
+        queue.push_back(texture);
+    }
+}
+
+void FEngine::processMipmapGenerationQueue() noexcept {
+    auto& queue = mPendingMipmapGeneration;
+    if (UTILS_LIKELY(queue.empty())) {
+        return;
+    }
+
+    // Per-frame budget expressed in texels of the texture's base level, a proxy for the GPU
+    // time the blit chain takes. At least one texture is processed per frame, so the queue
+    // always drains even when it only holds oversized textures.
+    constexpr size_t TEXEL_BUDGET_PER_FRAME = 8u << 20u;
+
+    size_t budget = TEXEL_BUDGET_PER_FRAME;
+    size_t processed = 0;
+    for (FTexture const* const t : queue) {
+        t->generateMipmaps(*this);
+        processed++;
+        size_t const cost = t->getWidth() * t->getHeight();
+        if (cost >= budget) {
+            break;
+        }
+        budget -= cost;
+    }
+    queue.erase(queue.begin(), queue.begin() + ptrdiff_t(processed));
+}
+
+void FEngine::startProfiling(void* buffer, size_t const sizeInBytes) noexcept {
+    TraceRecorder::get().start(buffer, sizeInBytes);
+}
+
+size_t FEngine::stopProfiling() noexcept {
+    return TraceRecorder::get().stop();
+}
+
+namespace {
+// on-disk layout of a prewarm trace (see FEngine::getPrewarmTrace())
+struct PrewarmTraceHeader {
+    uint32_t magic;         // PREWARM_TRACE_MAGIC
+    uint32_t version;       // PREWARM_TRACE_VERSION
+    uint64_t count;         // number of PrewarmTraceEntry following the header
+};
+struct PrewarmTraceEntry {
+    uint64_t cacheId;                           // MaterialParser::getCacheId()
+    uint64_t variants[VARIANT_COUNT / 64];      // VariantList storage words
+};
+constexpr uint32_t PREWARM_TRACE_MAGIC = 0x46505754u;   // 'FPWT'
+constexpr uint32_t PREWARM_TRACE_VERSION = 1;
+} // anonymous namespace
+
+void FEngine::setPrewarmTraceRecording(bool const enabled) noexcept {
+    if (enabled && !mPrewarmTraceRecording) {
+        // a new session replaces whatever was recorded previously
+        mPrewarmTraceRecorded.clear();
+    }
+    mPrewarmTraceRecording = enabled;
+}
+
+void FEngine::recordPrewarmVariant(uint64_t const cacheId, Variant const variant) noexcept {
+    mPrewarmTraceRecorded[cacheId].set(variant.key);
+}
+
+size_t FEngine::getPrewarmTrace(void* buffer, size_t const sizeInBytes) const noexcept {
+    size_t const needed = sizeof(PrewarmTraceHeader)
+            + mPrewarmTraceRecorded.size() * sizeof(PrewarmTraceEntry);
+    if (buffer && sizeInBytes >= needed) {
+        PrewarmTraceHeader const header{
+                PREWARM_TRACE_MAGIC, PREWARM_TRACE_VERSION,
+                uint64_t(mPrewarmTraceRecorded.size()) };
+        char* p = static_cast<char*>(buffer);
+        memcpy(p, &header, sizeof(header));
+        p += sizeof(header);
+        for (auto const& [cacheId, variants] : mPrewarmTraceRecorded) {
+            PrewarmTraceEntry entry{ cacheId, {} };
+            for (size_t i = 0; i < VARIANT_COUNT / 64; i++) {
+                entry.variants[i] = variants.getBitsAt(i);
+            }
+            memcpy(p, &entry, sizeof(entry));
+            p += sizeof(entry);
+        }
+    }
+    return needed;
+}
+
+size_t FEngine::prewarm(void const* data, size_t const sizeInBytes) noexcept {
+    if (!data || sizeInBytes < sizeof(PrewarmTraceHeader)) {
+        return 0;
+    }
+    PrewarmTraceHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != PREWARM_TRACE_MAGIC || header.version != PREWARM_TRACE_VERSION ||
+            sizeInBytes < sizeof(header) + header.count * sizeof(PrewarmTraceEntry)) {
+        return 0;
+    }
+
+    // retain the trace; materials created after this call pick up their variants
+    // from FMaterial's constructor via getPrewarmVariants()
+    char const* p = static_cast<char const*>(data) + sizeof(header);
+    for (uint64_t i = 0; i < header.count; i++, p += sizeof(PrewarmTraceEntry)) {
+        PrewarmTraceEntry entry;
+        memcpy(&entry, p, sizeof(entry));
+        VariantList& variants = mPrewarmTraceLoaded[entry.cacheId];
+        for (size_t j = 0; j < VARIANT_COUNT / 64; j++) {
+            variants.getBitsAt(j) |= entry.variants[j];
+        }
+    }
+
+    // kick background compilation for the materials already loaded
+    mMaterials.forEach([this](FMaterial* material) {
+        if (auto const* const variants = getPrewarmVariants(material->getCacheId())) {
+            material->prewarmVariants(*variants);
+        }
+    });
+
+    return header.count;
+}
+
+VariantList const* FEngine::getPrewarmVariants(uint64_t const cacheId) const noexcept {
+    auto const pos = mPrewarmTraceLoaded.find(cacheId);
+    return pos != mPrewarmTraceLoaded.end() ? &pos->second : nullptr;
+}
+
 void FEngine::flushAndWait() {
     flushAndWait(FENCE_WAIT_FOR_EVER);
 }
@@ -755,6 +966,7 @@ int FEngine::loop() {
     DriverConfig const driverConfig {
             .handleArenaSize = getRequestedDriverHandleArenaSize(),
             .metalUploadBufferSizeBytes = mConfig.metalUploadBufferSizeBytes,
+            .metalTextureHeapSizeBytes = mConfig.metalTextureHeapSizeBytes,
             .disableParallelShaderCompile = features.backend.disable_parallel_shader_compile,
             .disableHandleUseAfterFreeCheck = features.backend.disable_handle_use_after_free_check,
             .disableHeapHandleTags = features.backend.disable_heap_handle_tags,
@@ -763,6 +975,7 @@ int FEngine::loop() {
             .assertNativeWindowIsValid = features.backend.opengl.assert_native_window_is_valid,
             .metalDisablePanicOnDrawableFailure = mConfig.metalDisablePanicOnDrawableFailure,
             .gpuContextPriority = mConfig.gpuContextPriority,
+            .shaderCompilerTickBudgetUs = mConfig.shaderCompilerTickBudgetUs,
     };
     mDriver = mPlatform->createDriver(mSharedGLContext, driverConfig);
 
@@ -1167,6 +1380,11 @@ bool FEngine::destroy(const FColorGrading* p) {
 
 UTILS_NOINLINE
 bool FEngine::destroy(const FTexture* p) {
+    if (UTILS_UNLIKELY(!mPendingMipmapGeneration.empty())) {
+        // cancel any pending mipmap generation
+        auto& queue = mPendingMipmapGeneration;
+        queue.erase(std::remove(queue.begin(), queue.end(), p), queue.end());
+    }
     return terminateAndDestroy(p, mTextures);
 }
 
@@ -21,9 +21,12 @@
 
 #include "Allocators.h"
 #include "DFG.h"
+#include "MemoryMonitor.h"
 #include "PostProcessManager.h"
 #include "ResourceList.h"
 #include "HwDescriptorSetLayoutFactory.h"
+#include "ScratchBufferPool.h"
+#include "HwProgramFactory.h"
 #include "HwVertexBufferInfoFactory.h"
 
 #include "components/CameraManager.h"
@@ -51,6 +54,7 @@
 
 #include <private/filament/EngineEnums.h>
 #include <private/filament/BufferInterfaceBlock.h>
+#include <private/filament/Variant.h>
 
 #include <filament/ColorGrading.h>
 #include <filament/Engine.h>
@@ -63,6 +67,8 @@
 
 #include <backend/DriverEnums.h>
 
+#include <tsl/robin_map.h>
+
 #include <utils/Allocator.h>
 #include <utils/compiler.h>
 #include <utils/CountDownLatch.h>
@@ -78,6 +84,7 @@
 #include <string_view>
 #include <random>
 #include <thread>
+#include <vector>
 #include <type_traits>
 #include <unordered_map>
 
@@ -256,6 +263,10 @@ public:
         return mHeapAllocator;
     }
 
+    ScratchBufferPool& getScratchBufferPool() noexcept {
+        return mScratchBufferPool;
+    }
+
     Backend getBackend() const noexcept {
         return mBackend;
     }
@@ -405,6 +416,14 @@ public:
     void flushAndWait();
     bool flushAndWait(uint64_t timeout);
 
+    void trimMemory() noexcept;
+
+    // schedules mipmap generation for the next frames, see Texture::generateMipmapsAsync()
+    void queueMipmapGeneration(FTexture const* texture) noexcept;
+
+    // generates mipmaps for a budgeted number of queued textures, called once per frame
+    void processMipmapGenerationQueue() noexcept;
+
     // flush the current buffer
     void flush();
 
@@ -444,6 +463,37 @@ public:
         return mDebugRegistry;
     }
 
+    MemoryMonitor& getMemoryMonitor() noexcept {
+        return mMemoryMonitor;
+    }
+
+    MemoryMonitor const& getMemoryMonitor() const noexcept {
+        return mMemoryMonitor;
+    }
+
+    FFence::Timeline& getFenceTimeline() noexcept {
+        return mFenceTimeline;
+    }
+
+    void startProfiling(void* buffer, size_t sizeInBytes) noexcept;
+
+    size_t stopProfiling() noexcept;
+
+    void setPrewarmTraceRecording(bool enabled) noexcept;
+
+    size_t getPrewarmTrace(void* buffer, size_t sizeInBytes) const noexcept;
+
+    size_t prewarm(void const* data, size_t sizeInBytes) noexcept;
+
+    bool isPrewarmTraceRecording() const noexcept { return mPrewarmTraceRecording; }
+
+    // called from FMaterial::prepareProgramSlow() when a program is actually built
+    // while a recording session is active
+    void recordPrewarmVariant(uint64_t cacheId, Variant variant) noexcept;
+
+    // variants recorded for this material in the trace loaded by prewarm(), or nullptr
+    VariantList const* getPrewarmVariants(uint64_t cacheId) const noexcept;
+
     bool execute();
 
     utils::JobSystem& getJobSystem() const noexcept {
@@ -474,6 +524,14 @@ public:
         return mAutomaticInstancingEnabled;
     }
 
+    void setDrawMergingEnabled(bool const enable) noexcept {
+        mDrawMergingEnabled = enable;
+    }
+
+    bool isDrawMergingEnabled() const noexcept {
+        return mDrawMergingEnabled;
+    }
+
     HwVertexBufferInfoFactory& getVertexBufferInfoFactory() noexcept {
         return mHwVertexBufferInfoFactory;
     }
@@ -482,6 +540,14 @@ public:
         return mHwDescriptorSetLayoutFactory;
     }
 
+    HwProgramFactory& getProgramFactory() noexcept {
+        return mHwProgramFactory;
+    }
+
+    FColorGrading::LutCache& getColorGradingLutCache() noexcept {
+        return mColorGradingLutCache;
+    }
+
     DescriptorSetLayout const& getPerViewDescriptorSetLayoutDepthVariant() const noexcept {
         return mPerViewDescriptorSetLayoutDepthVariant;
     }
@@ -571,6 +637,7 @@ private:
     Platform* mPlatform = nullptr;
     bool mOwnPlatform = false;
     bool mAutomaticInstancingEnabled = false;
+    bool mDrawMergingEnabled = false;
     void* mSharedGLContext = nullptr;
     backend::Handle<backend::HwRenderPrimitive> mFullScreenTriangleRph;
     FVertexBuffer* mFullScreenTriangleVb = nullptr;
@@ -587,6 +654,7 @@ private:
     std::shared_ptr<ResourceAllocatorDisposer> mResourceAllocatorDisposer;
     HwVertexBufferInfoFactory mHwVertexBufferInfoFactory;
     HwDescriptorSetLayoutFactory mHwDescriptorSetLayoutFactory;
+    HwProgramFactory mHwProgramFactory;
     DescriptorSetLayout mPerViewDescriptorSetLayoutDepthVariant;
     DescriptorSetLayout mPerViewDescriptorSetLayoutSsrVariant;
     DescriptorSetLayout mPerRenderableDescriptorSetLayout;
@@ -607,14 +675,23 @@ private:
     ResourceList<FTexture> mTextures{ "Texture" };
     ResourceList<FSkybox> mSkyboxes{ "Skybox" };
     ResourceList<FColorGrading> mColorGradings{ "ColorGrading" };
+    FColorGrading::LutCache mColorGradingLutCache;
     ResourceList<FRenderTarget> mRenderTargets{ "RenderTarget" };
 
     // the fence list is accessed from multiple threads
     utils::Mutex mFenceListLock;
     ResourceList<FFence> mFences{"Fence"};
 
+    // this engine's fence timeline (see FFence::Timeline), accessed from the driver thread
+    FFence::Timeline mFenceTimeline;
+
     mutable uint32_t mMaterialId = 0;
 
+    // shader prewarm trace, keyed by the materials' stable cache id (see prewarm())
+    bool mPrewarmTraceRecording = false;
+    tsl::robin_map<uint64_t, VariantList> mPrewarmTraceRecorded;
+    tsl::robin_map<uint64_t, VariantList> mPrewarmTraceLoaded;
+
     // FMaterialInstance are handled directly by FMaterial
     std::unordered_map<const FMaterial*, ResourceList<FMaterialInstance>> mMaterialInstances;
 
@@ -629,12 +706,16 @@ private:
 
     RootArenaScope::Arena mPerRenderPassArena;
     HeapAllocatorArena mHeapAllocator;
+    ScratchBufferPool mScratchBufferPool;
 
     utils::JobSystem mJobSystem;
     static uint32_t getJobSystemThreadPoolSize(Config const& config) noexcept;
 
     std::default_random_engine mRandomEngine;
 
+    // textures with mipmap generation pending, in submission order
+    std::vector<FTexture const*> mPendingMipmapGeneration;
+
     Epoch mEngineEpoch;
 
     mutable FMaterial const* mDefaultMaterial = nullptr;
@@ -652,6 +733,7 @@ private:
     mutable ShaderContent mVertexShaderContent;
     mutable ShaderContent mFragmentShaderContent;
     FDebugRegistry mDebugRegistry;
+    MemoryMonitor mMemoryMonitor;
 
     backend::Handle<backend::HwTexture> mDummyOneTexture;
     backend::Handle<backend::HwTexture> mDummyOneTextureArray;
@@ -679,6 +761,9 @@ public:
             bool visualize_cascades = false;
             bool disable_light_frustum_align = false;
             bool depth_clamp = true;
+            // re-render shadow maps at most every update_interval frames (round-robin) when
+            // their light didn't move; 1 (the default) re-renders all of them every frame
+            int update_interval = 1;
             float dzn = -1.0f;
             float dzf =  1.0f;
             float display_shadow_texture_scale = 0.25f;
@@ -691,25 +776,55 @@ public:
         } shadowmap;
         struct {
             bool camera_at_origin = true;
+            // experimental Hi-Z occlusion culling (see OcclusionCuller)
+            bool occlusion_culling = false;
             struct {
                 float kp = 0.0f;
                 float ki = 0.0f;
                 float kd = 0.0f;
             } pid;
+            // number of renderables that survived culling in the last prepared view,
+            // published through the counter registry
+            FDebugRegistry::Counter* visible_renderables = nullptr;
         } view;
+        struct {
+            // when > 0, overrides TemporalAntiAliasingOptions::filterWidth for kernel tuning
+            float filter_width = 0.0f;
+            // when false, the TAA filter-weight cache is flushed every frame (for comparison)
+            bool use_filter_weight_cache = true;
+        } taa;
         struct {
             // When set to true, the backend will attempt to capture the next frame and write the
             // capture to file. At the moment, only supported by the Metal backend.
             bool doFrameCapture = false;
             bool disable_buffer_padding = false;
             bool disable_subpasses = false;
+            // number of heap allocations that went through utils::HeapAllocator during the
+            // last beginFrame/endFrame interval (see utils::HeapAllocationCounter)
+            int heap_allocation_count = 0;
+            // when true, FrameGraph passes are bracketed with GPU timer queries and the
+            // measured times show up in "d.renderer.pass_stats" a few frames later
+            // (see FrameGraphPassProfiler); supersedes the frame-wide GPU timer
+            bool gpu_pass_profiling = false;
+            // total number of frames rendered, published through the counter registry
+            FDebugRegistry::Counter* frame_count = nullptr;
+            // number of draw commands generated for the last color pass
+            FDebugRegistry::Counter* draw_calls = nullptr;
         } renderer;
         struct {
             bool debug_froxel_visualization = false;
+            // time spent in Froxelizer::froxelizeAssignRecordsCompress() for the last
+            // froxelized frame, in microseconds
+            float froxelize_records_compress_us = 0.0f;
         } lighting;
         struct {
             bool combine_multiview_images = false;
         } stereo;
+        struct {
+            // number of program compilations still queued or in flight in the backend at the
+            // end of the last frame
+            int queue_depth = 0;
+        } shader_compiler;
         matdbg::DebugServer* server = nullptr;
         fgviewer::DebugServer* fgviewerServer = nullptr;
     } debug;
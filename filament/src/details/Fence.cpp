@@ -26,9 +26,9 @@
 #include <utils/Panic.h>
 #include <utils/debug.h>
 
+#include <algorithm>
 #include <condition_variable>
 #include <chrono>
-#include <memory>
 #include <mutex>
 
 #include <stdint.h>
@@ -37,28 +37,32 @@ namespace filament {
 
 using namespace backend;
 
-utils::Mutex FFence::sLock;
-utils::Condition FFence::sCondition;
-
 static constexpr uint64_t PUMP_INTERVAL_MILLISECONDS = 1;
 
 using ms = std::chrono::milliseconds;
 using ns = std::chrono::nanoseconds;
 
 FFence::FFence(FEngine& engine)
-    : mEngine(engine), mFenceSignal(std::make_shared<FenceSignal>()) {
+    : mEngine(engine) {
     DriverApi& driverApi = engine.getDriverApi();
 
-    // we have to first wait for the fence to be signaled by the command stream
-    auto& fs = mFenceSignal;
-    driverApi.queueCommand([fs]() {
-        fs->signal();
+    Timeline& timeline = engine.getFenceTimeline();
+    {
+        std::lock_guard const lock(timeline.lock);
+        mTimelineValue = ++timeline.issued;
+    }
+
+    // the command stream signals our timeline value when it reaches this point; the
+    // timeline is owned by the engine, which outlives any queued command
+    uint64_t const value = mTimelineValue;
+    driverApi.queueCommand([&timeline, value]() {
+        signalTimeline(timeline, value);
     });
 }
 
 void FFence::terminate(FEngine&) noexcept {
-    FenceSignal * const fs = mFenceSignal.get();
-    fs->signal(FenceSignal::DESTROYED);
+    // nothing to do: the signaling command captures the timeline value, not the fence,
+    // so it signals waiters even after the fence is destroyed
 }
 
 UTILS_NOINLINE
@@ -71,28 +75,32 @@ FenceStatus FFence::waitAndDestroy(FFence* fence, Mode const mode) noexcept {
 
 UTILS_NOINLINE
 FenceStatus FFence::wait(Mode const mode, uint64_t const timeout) {
+    return waitForTimelineValue(mEngine, mTimelineValue, mode, timeout);
+}
+
+UTILS_NOINLINE
+FenceStatus FFence::waitForTimelineValue(FEngine& engine,
+        uint64_t const value, Mode const mode, uint64_t const timeout) {
     FILAMENT_CHECK_PRECONDITION(UTILS_HAS_THREADING || timeout == 0)
             << "Non-zero timeout requires threads.";
 
-    FEngine& engine = mEngine;
-
     if (mode == Mode::FLUSH) {
         engine.flush();
     }
 
-    FenceSignal * const fs = mFenceSignal.get();
-
     FenceStatus status;
 
+    Timeline& timeline = engine.getFenceTimeline();
+
     if (UTILS_LIKELY(!engine.pumpPlatformEvents())) {
-        status = fs->wait(timeout);
+        status = timelineWait(timeline, value, timeout);
     } else {
         // Unfortunately, some platforms might force us to have sync points between the GL thread
         // and user thread. To prevent deadlock on these platforms, we chop up the waiting time into
         // polling and pumping the platform's event queue.
         const auto startTime = std::chrono::system_clock::now();
         while (true) {
-            status = fs->wait(ns(ms(PUMP_INTERVAL_MILLISECONDS)).count());
+            status = timelineWait(timeline, value, ns(ms(PUMP_INTERVAL_MILLISECONDS)).count());
             if (status != FenceStatus::TIMEOUT_EXPIRED) {
                 break;
             }
@@ -104,36 +112,31 @@ FenceStatus FFence::wait(Mode const mode, uint64_t const timeout) {
         }
     }
 
-    if (status != FenceStatus::CONDITION_SATISFIED) {
-        return status;
-    }
-
     return status;
 }
 
 UTILS_NOINLINE
-void FFence::FenceSignal::signal(State const s) noexcept {
-    std::lock_guard const lock(sLock);
-    mState = s;
-    sCondition.notify_all();
+void FFence::signalTimeline(Timeline& timeline, uint64_t const value) noexcept {
+    std::lock_guard const lock(timeline.lock);
+    // commands execute in submission order, but be defensive about it
+    timeline.signaled = std::max(timeline.signaled, value);
+    timeline.condition.notify_all();
 }
 
 UTILS_NOINLINE
-Fence::FenceStatus FFence::FenceSignal::wait(uint64_t const timeout) noexcept {
-    std::unique_lock lock(sLock);
-    while (mState == UNSIGNALED) {
+Fence::FenceStatus FFence::timelineWait(Timeline& timeline,
+        uint64_t const value, uint64_t const timeout) noexcept {
+    std::unique_lock lock(timeline.lock);
+    while (timeline.signaled < value) {
         if (timeout == FENCE_WAIT_FOR_EVER) {
-            sCondition.wait(lock);
+            timeline.condition.wait(lock);
         } else {
             if (timeout == 0 ||
-                    sCondition.wait_for(lock, ns(timeout)) == std::cv_status::timeout) {
+                    timeline.condition.wait_for(lock, ns(timeout)) == std::cv_status::timeout) {
                 return FenceStatus::TIMEOUT_EXPIRED;
             }
         }
     }
-    if (mState == DESTROYED) {
-        return FenceStatus::ERROR;
-    }
     return FenceStatus::CONDITION_SATISFIED;
 }
 
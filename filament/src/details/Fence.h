@@ -33,6 +33,21 @@ class FEngine;
 
 class FFence : public Fence {
 public:
+    // Each engine owns a single monotonically increasing timeline shared by all its fences:
+    // a fence is assigned the next value when it is created, and the engine's command stream
+    // signals that value when it reaches the fence's position -- in submission order -- so
+    // waiting for a value covers all the fences created on that engine up to that point.
+    // The timeline must be per-engine: each engine has its own driver thread, so a shared
+    // counter would let one engine's progress satisfy waits on another engine's fences.
+    // We assume we don't have a lot of contention on fences and have all of an engine's
+    // fences share a single lock/condition.
+    struct Timeline {
+        utils::Mutex lock;
+        utils::Condition condition;
+        uint64_t issued = 0;      // last value assigned to a fence, guarded by lock
+        uint64_t signaled = 0;    // last value reached by the command stream, guarded by lock
+    };
+
     FFence(FEngine& engine);
 
     void terminate(FEngine& engine) noexcept;
@@ -41,23 +56,20 @@ public:
 
     static FenceStatus waitAndDestroy(FFence* fence, Mode mode) noexcept;
 
+    uint64_t getTimelineValue() const noexcept { return mTimelineValue; }
+
+    static FenceStatus waitForTimelineValue(FEngine& engine,
+            uint64_t value, Mode mode, uint64_t timeout);
+
 private:
-    // We assume we don't have a lot of contention of fence and have all of them
-    // share a single lock/condition
-    static utils::Mutex sLock;
-    static utils::Condition sCondition;
-
-    struct FenceSignal {
-        explicit FenceSignal() noexcept = default;
-        enum State : uint8_t { UNSIGNALED, SIGNALED, DESTROYED };
-        State mState = UNSIGNALED;
-        void signal(State s = SIGNALED) noexcept;
-        FenceStatus wait(uint64_t timeout) noexcept;
-    };
+    // called on the driver thread when the command stream reaches the fence's position
+    static void signalTimeline(Timeline& timeline, uint64_t value) noexcept;
+
+    // wait until the timeline reaches at least value
+    static FenceStatus timelineWait(Timeline& timeline, uint64_t value, uint64_t timeout) noexcept;
 
     FEngine& mEngine;
-    // TODO: use custom allocator for these small objects
-    std::shared_ptr<FenceSignal> mFenceSignal;
+    uint64_t mTimelineValue = 0;
 };
 
 FILAMENT_DOWNCAST(Fence)
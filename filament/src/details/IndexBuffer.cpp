@@ -87,9 +87,13 @@ FIndexBuffer::FIndexBuffer(FEngine& engine, const Builder& builder)
     if (!name.empty()) {
         driver.setDebugTag(mHandle.getId(), std::move(name));
     }
+    mByteCount = mIndexCount *
+            (builder->mIndexType == IndexType::UINT ? sizeof(uint32_t) : sizeof(uint16_t));
+    engine.getMemoryMonitor().track(MemoryMonitor::Category::BUFFERS, mByteCount);
 }
 
 void FIndexBuffer::terminate(FEngine& engine) {
+    engine.getMemoryMonitor().release(MemoryMonitor::Category::BUFFERS, mByteCount);
     FEngine::DriverApi& driver = engine.getDriverApi();
     driver.destroyIndexBuffer(mHandle);
 }
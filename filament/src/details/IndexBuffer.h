@@ -46,6 +46,7 @@ private:
     friend class IndexBuffer;
     backend::Handle<backend::HwIndexBuffer> mHandle;
     uint32_t mIndexCount;
+    uint32_t mByteCount = 0;    // reported to the engine's MemoryMonitor
 };
 
 FILAMENT_DOWNCAST(IndexBuffer)
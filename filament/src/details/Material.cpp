@@ -16,6 +16,8 @@
 
 #include "details/Material.h"
 #include "details/Engine.h"
+#include "details/RenderTarget.h"
+#include "details/VertexBuffer.h"
 
 #include "Froxelizer.h"
 #include "MaterialParser.h"
@@ -78,10 +80,11 @@ using namespace backend;
 using namespace filaflat;
 using namespace utils;
 
-static std::unique_ptr<MaterialParser> createParser(Backend const backend,
-        FixedCapacityVector<ShaderLanguage> languages, const void* data, size_t size) {
+std::unique_ptr<MaterialParser> FMaterial::createParser(Backend const backend,
+        FixedCapacityVector<ShaderLanguage> languages, const void* data, size_t const size,
+        bool const copyData) {
     // unique_ptr so we don't leak MaterialParser on failures below
-    auto materialParser = std::make_unique<MaterialParser>(languages, data, size);
+    auto materialParser = std::make_unique<MaterialParser>(languages, data, size, copyData);
 
     MaterialParser::ParseResult const materialResult = materialParser->parse();
 
@@ -180,7 +183,7 @@ const char* toString(ShaderModel model) {
 }
 
 Material* Material::Builder::build(Engine& engine) const {
-    std::unique_ptr<MaterialParser> materialParser = createParser(
+    std::unique_ptr<MaterialParser> materialParser = FMaterial::createParser(
         downcast(engine).getBackend(), downcast(engine).getShaderLanguage(),
         mImpl->mPayload, mImpl->mSize);
 
@@ -290,6 +293,10 @@ FMaterial::FMaterial(FEngine& engine, const Builder& builder,
     parser->getVertexDomain(&mVertexDomain);
     parser->getMaterialDomain(&mMaterialDomain);
     parser->getMaterialVariantFilterMask(&mVariantFilterMask);
+    // fold in the engine-wide filter: variants the application declared unused at Engine
+    // creation are pruned as if the material had been compiled with matc's --variant-filter
+    mVariantFilterMask |= engine.getConfig().variantFilter
+            & UserVariantFilterMask(UserVariantFilterBit::ALL);
     parser->getRequiredAttributes(&mRequiredAttributes);
     parser->getRefractionMode(&mRefractionMode);
     parser->getRefractionType(&mRefractionType);
@@ -346,6 +353,13 @@ FMaterial::FMaterial(FEngine& engine, const Builder& builder,
     processDescriptorSets(engine, parser);
     precacheDepthVariants(engine);
 
+    if (auto const* const prewarm = engine.getPrewarmVariants(mCacheId);
+            UTILS_UNLIKELY(prewarm)) {
+        // this material appears in the prewarm trace loaded by FEngine::prewarm(), start
+        // compiling the variants it used last session right away
+        prewarmVariants(*prewarm);
+    }
+
 #if FILAMENT_ENABLE_MATDBG
     // Register the material with matdbg.
     matdbg::DebugServer* server = downcast(engine).debug.server;
@@ -379,8 +393,25 @@ void FMaterial::invalidate(Variant::type_t variantMask, Variant::type_t variantV
     destroyPrograms(mEngine, variantMask, variantValue);
 }
 
+void FMaterial::setShadowSamplingQuality(Builder::ShadowSamplingQuality const quality) noexcept {
+    if (mMaterialDomain != MaterialDomain::SURFACE) {
+        return;
+    }
+    if (setConstant(+ReservedSpecializationConstants::CONFIG_SHADOW_SAMPLING_METHOD,
+            int32_t(quality))) {
+        // only the shadow-receiving variants sample the shadow map, the other cached
+        // programs can be kept (the depth variants are preserved by invalidate())
+        invalidate(Variant::SRE | Variant::DEP, Variant::SRE);
+    }
+}
+
 void FMaterial::terminate(FEngine& engine) {
 
+    // the dictionary prefetch job captures mMaterialParser, make sure it has finished
+    if (UTILS_UNLIKELY(mDictionaryPrefetchJob)) {
+        engine.getJobSystem().waitAndRelease(mDictionaryPrefetchJob);
+    }
+
     if (mDefaultMaterialInstance) {
         mDefaultMaterialInstance->setDefaultInstance(false);
         engine.destroy(mDefaultMaterialInstance);
@@ -447,7 +478,8 @@ void FMaterial::compile(CompilerPriorityQueue const priority,
     }
 
     UserVariantFilterMask const variantFilter =
-            ~variantSpec & UserVariantFilterMask(UserVariantFilterBit::ALL);
+            (~variantSpec & UserVariantFilterMask(UserVariantFilterBit::ALL))
+                    | mVariantFilterMask;
 
     if (UTILS_LIKELY(mEngine.getDriverApi().isParallelShaderCompileSupported())) {
         auto const& variants = isVariantLit() ?
@@ -459,6 +491,12 @@ void FMaterial::compile(CompilerPriorityQueue const priority,
                 }
             }
         }
+    } else if (!mDictionaryPrefetchJob) {
+        // The driver can't compile ahead of time, so shaders are built at first use; at least
+        // decode the shader dictionary on a worker now so the first draw doesn't pay for it.
+        JobSystem& js = mEngine.getJobSystem();
+        mDictionaryPrefetchJob = js.runAndRetain(jobs::createJob(js, nullptr,
+                [parser = mMaterialParser.get()] { parser->ensureShaderDictionary(); }));
     }
 
     if (callback) {
@@ -478,6 +516,82 @@ void FMaterial::compile(CompilerPriorityQueue const priority,
     }
 }
 
+void FMaterial::prewarmVariants(VariantList const& variants) noexcept {
+    if (UTILS_UNLIKELY(!mEngine.getDriverApi().isParallelShaderCompileSupported())) {
+        // without an asynchronous compiler service there is nothing useful to queue early
+        return;
+    }
+    for (size_t k = 0; k < VARIANT_COUNT; k++) {
+        if (!variants[k]) {
+            continue;
+        }
+        Variant const variant{ Variant::type_t(k) };
+        if (mMaterialDomain == MaterialDomain::SURFACE &&
+                UTILS_UNLIKELY(Variant::isReserved(variant) ||
+                        variant != Variant::filterVariant(variant, isVariantLit()))) {
+            // traces come from files, don't trust stale or corrupted keys
+            continue;
+        }
+        if (hasVariant(variant)) {
+            prepareProgram(variant, CompilerPriorityQueue::LOW);
+        }
+    }
+    mEngine.getDriverApi().compilePrograms(CompilerPriorityQueue::LOW, nullptr, nullptr, nullptr);
+}
+
+void FMaterial::precompilePipelines(FRenderTarget* const renderTarget,
+        FVertexBuffer* const vertexBuffer, UserVariantFilterMask variantSpec) noexcept {
+
+    DriverApi& driver = mEngine.getDriverApi();
+
+    // Turn off the STE variant if stereo is not supported (see compile()).
+    if (!driver.isStereoSupported()) {
+        variantSpec &= ~UserVariantFilterMask(UserVariantFilterBit::STE);
+    }
+
+    UserVariantFilterMask const variantFilter =
+            (~variantSpec & UserVariantFilterMask(UserVariantFilterBit::ALL))
+                    | mVariantFilterMask;
+
+    // This pipeline state approximates how RenderPass draws this material. The per-draw bits
+    // we can't know here (stencil state, per-instance polygon offset) keep their defaults;
+    // backends key their pipeline caches on the whole state, so draws using different values
+    // still create their pipeline on first use -- the common case is covered, not all cases.
+    backend::PipelineState pipeline{};
+    pipeline.vertexBufferInfo = vertexBuffer->getVertexBufferInfoHandle();
+    pipeline.rasterState = mRasterState;
+    pipeline.pipelineLayout.setLayout[+DescriptorSetBindingPoints::PER_RENDERABLE] =
+            mEngine.getPerRenderableDescriptorSetLayout().getHandle();
+    pipeline.pipelineLayout.setLayout[+DescriptorSetBindingPoints::PER_MATERIAL] =
+            getDescriptorSetLayout().getHandle();
+
+    // A render pass compatible with the requested attachment layout. Everything is discarded
+    // and nothing is drawn; this only exists because monolithic pipeline objects are created
+    // against a compatible render pass.
+    RenderPassParams params{};
+    params.flags.discardStart = TargetBufferFlags::ALL;
+    params.flags.discardEnd = TargetBufferFlags::ALL;
+    params.viewport = { 0, 0, 1, 1 };   // viewport/scissor are dynamic pipeline states
+
+    driver.beginRenderPass(renderTarget->getHwHandle(), params);
+
+    auto const& variants = isVariantLit() ?
+            VariantUtils::getLitVariants() : VariantUtils::getUnlitVariants();
+    for (auto const variant : variants) {
+        if (!variantFilter || variant == Variant::filterUserVariant(variant, variantFilter)) {
+            if (hasVariant(variant)) {
+                prepareProgram(variant);
+                pipeline.program = getProgram(variant);
+                pipeline.pipelineLayout.setLayout[+DescriptorSetBindingPoints::PER_VIEW] =
+                        getPerViewDescriptorSetLayout(variant, false).getHandle();
+                driver.precompilePipeline(pipeline);
+            }
+        }
+    }
+
+    driver.endRenderPass();
+}
+
 FMaterialInstance* FMaterial::createInstance(const char* name) const noexcept {
     if (mDefaultMaterialInstance) {
         // if we have a default instance, use it to create a new one
@@ -502,6 +616,11 @@ bool FMaterial::hasParameter(const char* name) const noexcept {
             mSubpassInfo.name == CString(name);
 }
 
+bool FMaterial::hasConstant(const char* name) const noexcept {
+    return mSpecializationConstantsNameToIndex.find(name) !=
+            mSpecializationConstantsNameToIndex.end();
+}
+
 bool FMaterial::isSampler(const char* name) const noexcept {
     return mSamplerInterfaceBlock.hasSampler(name);
 }
@@ -538,6 +657,16 @@ bool FMaterial::hasVariant(Variant const variant) const noexcept {
 void FMaterial::prepareProgramSlow(Variant const variant,
         backend::CompilerPriorityQueue const priorityQueue) const noexcept {
     assert_invariant(mEngine.hasFeatureLevel(mFeatureLevel));
+    if (UTILS_UNLIKELY(mEngine.isPrewarmTraceRecording())) {
+        mEngine.recordPrewarmVariant(mCacheId, variant);
+    }
+    // remember which variants were queued at LOW priority, so prepareProgram() can promote
+    // them later if a command ends up needing them before they're compiled
+    if (priorityQueue == CompilerPriorityQueue::LOW) {
+        mLowPriorityVariants.set(variant.key);
+    } else {
+        mLowPriorityVariants.unset(variant.key);
+    }
     switch (getMaterialDomain()) {
         case MaterialDomain::SURFACE:
             getSurfaceProgramSlow(variant, priorityQueue);
@@ -577,6 +706,14 @@ void FMaterial::getPostProcessProgramSlow(Variant const variant,
     createAndCacheProgram(std::move(pb), variant);
 }
 
+void FMaterial::escalateProgramSlow(Variant const variant) const noexcept {
+    mLowPriorityVariants.unset(variant.key);
+    if (mCachedPrograms[variant.key]) {
+        mEngine.getDriverApi().setCompilerPriorityQueue(mCachedPrograms[variant.key],
+                CompilerPriorityQueue::HIGH);
+    }
+}
+
 Program FMaterial::getProgramWithVariants(
         Variant variant,
         Variant vertexVariant,
@@ -651,6 +788,20 @@ Program FMaterial::getProgramWithVariants(
     return program;
 }
 
+uint32_t FMaterial::getSpecializationConstantsHash() const noexcept {
+    size_t h = 42;
+    for (auto const& c : mSpecializationConstants) {
+        h = hash::combine(h, size_t(c.id));
+        h = hash::combine(h, c.value.index());
+        std::visit([&h](auto v) {
+            uint32_t bits = 0;
+            memcpy(&bits, &v, sizeof(v));
+            h = hash::combine(h, size_t(bits));
+        }, c.value);
+    }
+    return uint32_t(h);
+}
+
 void FMaterial::createAndCacheProgram(Program&& p, Variant const variant) const noexcept {
     FEngine const& engine = mEngine;
     DriverApi& driverApi = mEngine.getDriverApi();
@@ -669,7 +820,15 @@ void FMaterial::createAndCacheProgram(Program&& p, Variant const variant) const
         }
     }
 
-    auto const program = driverApi.createProgram(std::move(p));
+    Handle<HwProgram> program;
+    if (UTILS_LIKELY(!isShared)) {
+        // Materials built from the same package produce byte-identical shaders for a given
+        // variant, so let the engine-wide factory share one backend program between them.
+        program = mEngine.getProgramFactory().create(driverApi,
+                { mCacheId, getSpecializationConstantsHash(), variant.key }, std::move(p));
+    } else {
+        program = driverApi.createProgram(std::move(p));
+    }
     driverApi.setDebugTag(program.getId(), mName);
     assert_invariant(program);
     mCachedPrograms[variant.key] = program;
@@ -754,6 +913,10 @@ bool FMaterial::hasPendingEdits() const noexcept {
 }
 
 void FMaterial::latchPendingEdits() noexcept {
+    // the dictionary prefetch job captures mMaterialParser, which we're about to replace
+    if (UTILS_UNLIKELY(mDictionaryPrefetchJob)) {
+        mEngine.getJobSystem().waitAndRelease(mDictionaryPrefetchJob);
+    }
     std::lock_guard const lock(mPendingEditsLock);
     mMaterialParser = std::move(mPendingEdits);
 }
@@ -827,7 +990,8 @@ void FMaterial::destroyPrograms(FEngine& engine,
                         // Only destroy if the handle is valid. Not strictly needed, but we have a lot
                         // of variants, and this generates traffic in the command queue.
                         if (cachedPrograms[k]) {
-                            driverApi.destroyProgram(std::move(cachedPrograms[k]));
+                            engine.getProgramFactory().destroy(driverApi,
+                                    std::move(cachedPrograms[k]));
                         }
                     }
                 }
@@ -858,7 +1022,8 @@ void FMaterial::destroyPrograms(FEngine& engine,
                                 continue;
                             }
 
-                            driverApi.destroyProgram(std::move(cachedPrograms[k]));
+                            engine.getProgramFactory().destroy(driverApi,
+                                    std::move(cachedPrograms[k]));
                         }
                     }
                 }
@@ -871,7 +1036,8 @@ void FMaterial::destroyPrograms(FEngine& engine,
                     // Only destroy if the handle is valid. Not strictly needed, but we have a lot
                     // of variant, and this generates traffic in the command queue.
                     if (cachedPrograms[k]) {
-                        driverApi.destroyProgram(std::move(cachedPrograms[k]));
+                        engine.getProgramFactory().destroy(driverApi,
+                                std::move(cachedPrograms[k]));
                     }
                 }
             }
@@ -1167,6 +1333,10 @@ void FMaterial::precacheDepthVariants(FEngine& engine) {
             if (!stereoSupported && Variant::isStereoVariant(variant)) {
                 continue;
             }
+            // don't precache variants pruned by the engine-wide filter (e.g. VSM)
+            if (variant != Variant::filterUserVariant(variant, mVariantFilterMask)) {
+                continue;
+            }
             assert_invariant(Variant::isValidDepthVariant(variant));
             if (hasVariant(variant)) {
                 prepareProgram(variant);
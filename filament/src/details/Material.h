@@ -43,6 +43,7 @@
 #include <utils/debug.h>
 #include <utils/FixedCapacityVector.h>
 #include <utils/Invocable.h>
+#include <utils/JobSystem.h>
 #include <utils/Mutex.h>
 
 #include <array>
@@ -68,6 +69,8 @@ namespace filament {
 class MaterialParser;
 
 class  FEngine;
+class FRenderTarget;
+class FVertexBuffer;
 
 class FMaterial : public Material {
 public:
@@ -80,6 +83,15 @@ public:
         DefaultMaterialBuilder();
     };
 
+    // Parses a material package. This is pure CPU work with no engine state involved, so it
+    // can run on any thread (e.g. to overlap parsing with other initialization); the result
+    // is then handed to FEngine::createMaterial(). copyData can be set to false when the
+    // package outlives the parser (e.g. resgen data linked into the binary) to parse the
+    // bytes in place instead of copying them.
+    static std::unique_ptr<MaterialParser> createParser(backend::Backend backend,
+            utils::FixedCapacityVector<backend::ShaderLanguage> languages,
+            const void* data, size_t size, bool copyData = true);
+
 
     void terminate(FEngine& engine);
 
@@ -105,11 +117,22 @@ public:
             backend::CallbackHandler* handler,
             utils::Invocable<void(Material*)>&& callback) noexcept;
 
+    void precompilePipelines(FRenderTarget* renderTarget, FVertexBuffer* vertexBuffer,
+            UserVariantFilterMask variantSpec) noexcept;
+
+    // queues background (LOW priority) compilation of the given variants, typically
+    // replayed from a prewarm trace recorded in a previous session (see FEngine::prewarm())
+    void prewarmVariants(VariantList const& variants) noexcept;
+
+    void setShadowSamplingQuality(Builder::ShadowSamplingQuality quality) noexcept;
+
     // Create an instance of this material
     FMaterialInstance* createInstance(const char* name) const noexcept;
 
     bool hasParameter(const char* name) const noexcept;
 
+    bool hasConstant(const char* name) const noexcept;
+
     bool isSampler(const char* name) const noexcept;
 
     BufferInterfaceBlock::FieldInfo const* reflect(std::string_view name) const noexcept;
@@ -136,6 +159,11 @@ public:
         // prepareProgram() is called for each RenderPrimitive in the scene, so it must be efficient.
         if (UTILS_UNLIKELY(!isCached(variant))) {
             prepareProgramSlow(variant, priorityQueue);
+        } else if (UTILS_UNLIKELY(mLowPriorityVariants[variant.key]
+                && priorityQueue == CompilerPriorityQueue::HIGH)) {
+            // the program was queued at LOW priority earlier (e.g. by compile()) and a command
+            // is about to use it, promote it so it compiles next
+            escalateProgramSlow(variant);
         }
     }
 
@@ -160,6 +188,9 @@ public:
     backend::RasterState getRasterState() const noexcept  { return mRasterState; }
     uint32_t getId() const noexcept { return mMaterialId; }
 
+    // stable across sessions for a given material package, used to key prewarm traces
+    uint64_t getCacheId() const noexcept { return mCacheId; }
+
     UserVariantFilterMask getSupportedVariants() const noexcept {
         return UserVariantFilterMask(UserVariantFilterBit::ALL) & ~mVariantFilterMask;
     }
@@ -266,6 +297,7 @@ private:
             CompilerPriorityQueue priorityQueue) const noexcept;
     void getPostProcessProgramSlow(Variant variant,
             CompilerPriorityQueue priorityQueue) const noexcept;
+    void escalateProgramSlow(Variant variant) const noexcept;
     backend::Program getProgramWithVariants(Variant variant,
             Variant vertexVariant, Variant fragmentVariant) const;
 
@@ -282,6 +314,9 @@ private:
 
     void createAndCacheProgram(backend::Program&& p, Variant variant) const noexcept;
 
+    // hash of the current specialization constant values, part of the program cache key
+    uint32_t getSpecializationConstantsHash() const noexcept;
+
     inline bool isSharedVariant(Variant const variant) const {
         return (mMaterialDomain == MaterialDomain::SURFACE) && !mIsDefaultMaterial &&
                !mHasCustomDepthShader && Variant::isValidDepthVariant(variant);
@@ -289,6 +324,7 @@ private:
 
     // try to order by frequency of use
     mutable std::array<backend::Handle<backend::HwProgram>, VARIANT_COUNT> mCachedPrograms;
+    mutable VariantList mLowPriorityVariants; // variants whose program was queued at LOW priority
     DescriptorSetLayout mPerViewDescriptorSetLayout;
     DescriptorSetLayout mPerViewDescriptorSetLayoutVsm;
     DescriptorSetLayout mDescriptorSetLayout;
@@ -369,6 +405,9 @@ private:
     const uint32_t mMaterialId;
     uint64_t mCacheId = 0;
     mutable uint32_t mMaterialInstanceId = 0;
+    // shader dictionary prefetch kicked from compile() when the driver can't compile
+    // ahead of time; waited on before mMaterialParser can be destroyed or replaced
+    utils::JobSystem::Job* mDictionaryPrefetchJob = nullptr;
     std::unique_ptr<MaterialParser> mMaterialParser;
 };
 
@@ -221,8 +221,14 @@ void FMaterialInstance::commit(FEngine& engine) const {
 
 void FMaterialInstance::commit(DriverApi& driver) const {
     // update uniforms if needed
-    if (mUniforms.isDirty() || mHasStreamUniformAssociations) {
+    if (UTILS_UNLIKELY(mHasStreamUniformAssociations)) {
         driver.updateBufferObject(mUbHandle, mUniforms.toBufferDescriptor(driver), 0);
+    } else if (mUniforms.isDirty()) {
+        // only upload the byte range modified since the last commit; a UI animating a
+        // single parameter then uploads a few bytes instead of the whole buffer
+        auto const [offset, size] = mUniforms.getDirtyRange();
+        driver.updateBufferObject(mUbHandle,
+                mUniforms.toBufferDescriptor(driver, offset, size), offset);
     }
     if (!mTextureParameters.empty()) {
         for (auto const& [binding, p]: mTextureParameters) {
@@ -379,6 +385,10 @@ const char* FMaterialInstance::getName() const noexcept {
 // ------------------------------------------------------------------------------------------------
 
 void FMaterialInstance::use(FEngine::DriverApi& driver) const {
+    getDescriptorSet().bind(driver, DescriptorSetBindingPoints::PER_MATERIAL);
+}
+
+DescriptorSet const& FMaterialInstance::getDescriptorSet() const {
 
     if (UTILS_UNLIKELY(mMissingSamplerDescriptors.any())) {
         std::call_once(mMissingSamplersFlag, [this] {
@@ -399,7 +409,7 @@ void FMaterialInstance::use(FEngine::DriverApi& driver) const {
         mMissingSamplerDescriptors.clear();
     }
 
-    mDescriptorSet.bind(driver, DescriptorSetBindingPoints::PER_MATERIAL);
+    return mDescriptorSet;
 }
 
 void FMaterialInstance::fixMissingSamplers() const {
@@ -73,6 +73,10 @@ public:
 
     void use(FEngine::DriverApi& driver) const;
 
+    // Same side effects as use(), but lets the caller do the binding, possibly batched with
+    // other descriptor sets (see DescriptorSet::bind()).
+    DescriptorSet const& getDescriptorSet() const;
+
     FMaterial const* getMaterial() const noexcept { return mMaterial; }
 
     uint64_t getSortingKey() const noexcept { return mMaterialSortingKey; }
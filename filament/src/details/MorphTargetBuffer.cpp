@@ -22,6 +22,7 @@
 
 #include "FilamentAPI-impl.h"
 
+#include <math/half.h>
 #include <math/mat4.h>
 #include <math/norm.h>
 
@@ -36,6 +37,7 @@ using namespace math;
 struct MorphTargetBuffer::BuilderDetails {
     size_t mVertexCount = 0;
     size_t mCount = 0;
+    PositionPrecision mPositionPrecision = PositionPrecision::FULL;
 };
 
 using BuilderType = MorphTargetBuffer;
@@ -56,6 +58,12 @@ MorphTargetBuffer::Builder& MorphTargetBuffer::Builder::count(size_t const count
     return *this;
 }
 
+MorphTargetBuffer::Builder& MorphTargetBuffer::Builder::positionPrecision(
+        PositionPrecision const precision) noexcept {
+    mImpl->mPositionPrecision = precision;
+    return *this;
+}
+
 MorphTargetBuffer::Builder& MorphTargetBuffer::Builder::name(const char* name, size_t const len) noexcept {
     return BuilderNameMixin::name(name, len);
 }
@@ -85,13 +93,13 @@ static inline size_t getHeight(size_t const vertexCount) noexcept {
 template<VertexAttribute A>
 inline size_t getSize(size_t vertexCount) noexcept;
 
-template<>
-inline size_t getSize<POSITION>(size_t const vertexCount) noexcept {
+static inline size_t getPositionsSize(size_t const vertexCount, bool const halfPositions) noexcept {
     const size_t stride = getWidth(vertexCount);
     const size_t height = getHeight(vertexCount);
     return Texture::PixelBufferDescriptor::computeDataSize(
             Texture::PixelBufferDescriptor::PixelDataFormat::RGBA,
-            Texture::PixelBufferDescriptor::PixelDataType::FLOAT,
+            halfPositions ? Texture::PixelBufferDescriptor::PixelDataType::HALF
+                          : Texture::PixelBufferDescriptor::PixelDataType::FLOAT,
             stride, height, 1);
 }
 
@@ -112,7 +120,8 @@ FMorphTargetBuffer::EmptyMorphTargetBuilder::EmptyMorphTargetBuilder() {
 
 FMorphTargetBuffer::FMorphTargetBuffer(FEngine& engine, const Builder& builder)
         : mVertexCount(builder->mVertexCount),
-          mCount(builder->mCount) {
+          mCount(builder->mCount),
+          mHalfPositions(builder->mPositionPrecision == PositionPrecision::HALF) {
 
     if (UTILS_UNLIKELY(engine.getSupportedFeatureLevel() <= FeatureLevel::FEATURE_LEVEL_0)) {
         // feature level 0 doesn't support morph target buffers
@@ -121,9 +130,10 @@ FMorphTargetBuffer::FMorphTargetBuffer(FEngine& engine, const Builder& builder)
 
     FEngine::DriverApi& driver = engine.getDriverApi();
 
-    // create buffer (here a texture) to store the morphing vertex data
+    // create buffer (here a texture) to store the morphing vertex data; both formats are
+    // float-sampled, so the precision is transparent to the shaders
     mPbHandle = driver.createTexture(SamplerType::SAMPLER_2D_ARRAY, 1,
-            TextureFormat::RGBA32F, 1,
+            mHalfPositions ? TextureFormat::RGBA16F : TextureFormat::RGBA32F, 1,
             getWidth(mVertexCount),
             getHeight(mVertexCount),
             mCount,
@@ -158,21 +168,31 @@ void FMorphTargetBuffer::setPositionsAt(FEngine& engine, size_t const targetInde
             << "MorphTargetBuffer (size=" << (unsigned)mVertexCount
             << ") overflow (count=" << (unsigned)count << ", offset=" << (unsigned)offset << ")";
 
-    auto size = getSize<POSITION>(count);
+    auto size = getPositionsSize(count, mHalfPositions);
 
     FILAMENT_CHECK_PRECONDITION(targetIndex < mCount)
             << targetIndex << " target index must be < " << mCount;
 
-    // We could use a pool instead of malloc() directly.
-    auto* out = (float4*) malloc(size);
-    std::transform(positions, positions + count, out,
-            [](const float3& p) { return float4(p, 1.0f); });
-
     FEngine::DriverApi& driver = engine.getDriverApi();
-    updateDataAt(driver, mPbHandle,
-            Texture::Format::RGBA, Texture::Type::FLOAT,
-            (char const*)out, sizeof(float4), targetIndex,
-            count, offset);
+
+    // We could use a pool instead of malloc() directly.
+    if (UTILS_UNLIKELY(mHalfPositions)) {
+        auto* out = (half4*) malloc(size);
+        std::transform(positions, positions + count, out,
+                [](const float3& p) { return half4(float4(p, 1.0f)); });
+        updateDataAt(driver, mPbHandle,
+                Texture::Format::RGBA, Texture::Type::HALF,
+                (char const*)out, sizeof(half4), targetIndex,
+                count, offset);
+    } else {
+        auto* out = (float4*) malloc(size);
+        std::transform(positions, positions + count, out,
+                [](const float3& p) { return float4(p, 1.0f); });
+        updateDataAt(driver, mPbHandle,
+                Texture::Format::RGBA, Texture::Type::FLOAT,
+                (char const*)out, sizeof(float4), targetIndex,
+                count, offset);
+    }
 }
 
 void FMorphTargetBuffer::setPositionsAt(FEngine& engine, size_t const targetIndex,
@@ -181,20 +201,30 @@ void FMorphTargetBuffer::setPositionsAt(FEngine& engine, size_t const targetInde
             << "MorphTargetBuffer (size=" << mVertexCount
             << ") overflow (count=" << (unsigned)count << ", offset=" << (unsigned)offset << ")";
 
-    auto size = getSize<POSITION>(count);
+    auto size = getPositionsSize(count, mHalfPositions);
 
     FILAMENT_CHECK_PRECONDITION(targetIndex < mCount)
             << targetIndex << " target index must be < " << mCount;
 
-    // We could use a pool instead of malloc() directly.
-    auto* out = (float4*) malloc(size);
-    memcpy(out, positions, sizeof(float4) * count);
-
     FEngine::DriverApi& driver = engine.getDriverApi();
-    updateDataAt(driver, mPbHandle,
-            Texture::Format::RGBA, Texture::Type::FLOAT,
-            (char const*)out, sizeof(float4), targetIndex,
-            count, offset);
+
+    // We could use a pool instead of malloc() directly.
+    if (UTILS_UNLIKELY(mHalfPositions)) {
+        auto* out = (half4*) malloc(size);
+        std::transform(positions, positions + count, out,
+                [](const float4& p) { return half4(p); });
+        updateDataAt(driver, mPbHandle,
+                Texture::Format::RGBA, Texture::Type::HALF,
+                (char const*)out, sizeof(half4), targetIndex,
+                count, offset);
+    } else {
+        auto* out = (float4*) malloc(size);
+        memcpy(out, positions, sizeof(float4) * count);
+        updateDataAt(driver, mPbHandle,
+                Texture::Format::RGBA, Texture::Type::FLOAT,
+                (char const*)out, sizeof(float4), targetIndex,
+                count, offset);
+    }
 }
 
 void FMorphTargetBuffer::setTangentsAt(FEngine& engine, size_t const targetIndex,
@@ -76,6 +76,7 @@ private:
     backend::TextureHandle mTbHandle;
     uint32_t mVertexCount;
     uint32_t mCount;
+    bool mHalfPositions; // positions are stored as RGBA16F instead of RGBA32F
 };
 
 FILAMENT_DOWNCAST(MorphTargetBuffer)
@@ -59,6 +59,7 @@
 #include <utils/debug.h>
 #include <utils/ostream.h>
 
+#include <algorithm>
 #include <chrono>
 #include <limits>
 #include <memory>
@@ -94,8 +95,12 @@ FRenderer::FRenderer(FEngine& engine) :
         mResourceAllocator(std::make_unique<ResourceAllocator>(
                 engine.getSharedResourceAllocatorDisposer(),
                 engine.getConfig(),
-                engine.getDriverApi()))
+                engine.getDriverApi())),
+        mFrameGraphCompileCache(std::make_unique<FrameGraphCompileCache>())
 {
+    // frame graph transients contribute to the engine's GPU memory dashboard
+    mResourceAllocator->setMemoryMonitor(&engine.getMemoryMonitor());
+
     FDebugRegistry& debugRegistry = engine.getDebugRegistry();
     debugRegistry.registerProperty("d.renderer.doFrameCapture",
             &engine.debug.renderer.doFrameCapture);
@@ -122,6 +127,9 @@ FRenderer::FRenderer(FEngine& engine) :
     debugRegistry.registerProperty("d.stereo.combine_multiview_images",
         &engine.debug.stereo.combine_multiview_images);
 
+    debugRegistry.registerDataSource("d.renderer.pass_stats",
+            mPassStats.data(), mPassStats.size());
+
     DriverApi& driver = engine.getDriverApi();
 
     mIsRGB8Supported = driver.isRenderTargetFormatSupported(TextureFormat::RGB8);
@@ -176,6 +184,8 @@ void FRenderer::terminate(FEngine& engine) {
         // to initialize themselves, otherwise the engine tries to destroy invalid handles.
         engine.execute();
     }
+    engine.getDebugRegistry().unregisterDataSource("d.renderer.pass_stats");
+    mPassProfiler.terminate(driver);
     mFrameInfoManager.terminate(driver);
     mFrameSkipper.terminate(driver);
     mResourceAllocator->terminate();
@@ -306,6 +316,10 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
     mFrameId++;
     mViewRenderedCount = 0;
 
+    // snapshot the heap allocation counter; endFrame() publishes the delta, so that
+    // steady-state frames can be audited for unwanted heap allocations
+    mHeapAllocationsAtBeginFrame = HeapAllocationCounter::getCount();
+
     FILAMENT_TRACING_FRAME_ID(FILAMENT_TRACING_CATEGORY_FILAMENT, mFrameId);
 
     FEngine& engine = mEngine;
@@ -332,6 +346,9 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
     // NOTE: this makes synchronous calls to the driver
     driver.updateStreams(&driver);
 
+    // Generate mipmaps queued with Texture::generateMipmapsAsync(), a budgeted amount per frame.
+    engine.processMipmapGenerationQueue();
+
     // Gives the backend a chance to execute periodic tasks. This must be called before
     // the frame skipper.
     driver.tick();
@@ -359,7 +376,10 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
         // a command buffer before creating a fence.
 
         mFrameInfoManager.beginFrame(driver, {
-                .historySize = mFrameRateOptions.history
+                .historySize = mFrameRateOptions.history,
+                // the frame-wide timer query yields to per-pass profiling, the OpenGL
+                // GL_TIME_ELAPSED path only supports one active query
+                .gpuTimerQuery = !engine.debug.renderer.gpu_pass_profiling,
         }, mFrameId);
 
         // ask the engine to do what it needs to (e.g. updates light buffer, materials...)
@@ -408,13 +428,44 @@ void FRenderer::endFrame() {
             << "SwapChain must remain valid until endFrame is called.";
 
     if (mSwapChain) {
+        if (UTILS_UNLIKELY(mHasFrameDamage && mFrameDamageValid)) {
+            driver.setPresentationDamage(mSwapChain->getHwHandle(), mFrameDamage);
+        }
+        // commit the deferred swapchains of the frame group first (in rendering order),
+        // so that all the presents of a multi-window frame are issued back-to-back and
+        // ride the single command-buffer flush below
+        for (FSwapChain* const swapChain : mGroupSwapChains) {
+            FILAMENT_CHECK_PRECONDITION(engine.isValid(swapChain))
+                    << "SwapChains of a frame group must remain valid until endFrame is called.";
+            swapChain->commit(driver);
+        }
         mSwapChain->commit(driver);
         mSwapChain = nullptr;
     }
+    mGroupSwapChains.clear();
+    mFrameDamage = {};
+    mHasFrameDamage = false;
+    mFrameDamageValid = true;
 
     mFrameInfoManager.endFrame(driver);
     mFrameSkipper.endFrame(driver);
 
+    // update the pacing model with this frame's timing, so the application can query when
+    // to start the next frame (see getFrameStartOffsetNanos())
+    mFramePacer.update(mFrameInfoManager.getLastFrameInfo(),
+            mDisplayInfo.refreshRate == 0.0 ? 0 : int64_t(
+                    1'000'000'000.0 / mDisplayInfo.refreshRate),
+            mFrameRateOptions.headRoomRatio);
+
+    engine.debug.renderer.heap_allocation_count =
+            int(HeapAllocationCounter::getCount() - mHeapAllocationsAtBeginFrame);
+
+    engine.debug.shader_compiler.queue_depth = int(driver.getShaderCompilerQueueDepth());
+
+    if (auto* const counter = engine.debug.renderer.frame_count) {
+        counter->increment();
+    }
+
     driver.endFrame(mFrameId);
 
     // gives the backend a chance to execute periodic tasks
@@ -578,6 +629,99 @@ void FRenderer::render(FView const* view) {
     }
 }
 
+void FRenderer::renderSwapChainGroup(FSwapChain* const* swapChains, FView const* const* views,
+        size_t const count) {
+    FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
+
+    if (UTILS_UNLIKELY(mBeginFrameInternal)) {
+        // this should not happen, the user should not call renderSwapChainGroup() if we
+        // returned false from beginFrame(). But because this is allowed, we handle it
+        // gracefully.
+        mBeginFrameInternal();
+        mBeginFrameInternal = {};
+    }
+
+    // after beginFrame() is called, mSwapChain should be true
+    assert_invariant(mSwapChain);
+
+    FEngine& engine = mEngine;
+    FEngine::DriverApi& driver = engine.getDriverApi();
+
+    for (size_t i = 0; i < count; i++) {
+        FSwapChain* const swapChain = swapChains[i];
+        FILAMENT_CHECK_PRECONDITION(engine.isValid(swapChain))
+                << "SwapChain passed to renderSwapChainGroup() is invalid.";
+
+        if (swapChain != mSwapChain) {
+            FILAMENT_CHECK_PRECONDITION(
+                    std::find(mGroupSwapChains.begin(), mGroupSwapChains.end(), swapChain)
+                            == mGroupSwapChains.end())
+                    << "a SwapChain can only appear in one contiguous run of a frame group";
+            // defer the present of the previous window to endFrame(), where all the
+            // swapchains of the group are committed together
+            mGroupSwapChains.push_back(mSwapChain);
+            // the damage region can only describe a single surface
+            mFrameDamageValid = false;
+            mSwapChain = swapChain;
+            swapChain->makeCurrent(driver);
+        }
+
+        FView const* const view = views[i];
+        if (UTILS_LIKELY(view && view->getScene() && view->hasCamera())) {
+            if (mViewRenderedCount) {
+                // This is a good place to kick the GPU, since we've rendered a View before,
+                // and we're about to render another one.
+                driver.flush();
+            }
+            renderInternal(view);
+            mViewRenderedCount++;
+        }
+    }
+}
+
+void FRenderer::renderViewGroup(FView const* const* views, size_t const viewCount) {
+    FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
+
+    if (UTILS_UNLIKELY(mBeginFrameInternal)) {
+        // this should not happen, the user should not call renderViewGroup() if we returned
+        // false from beginFrame(). But because this is allowed, we handle it gracefully.
+        mBeginFrameInternal();
+        mBeginFrameInternal = {};
+    }
+
+    // after beginFrame() is called, mSwapChain should be true
+    assert_invariant(mSwapChain);
+
+    if (UTILS_UNLIKELY(viewCount == 0)) {
+        return;
+    }
+
+    // all views of a group must share the same scene, this is what allows the scene
+    // preparation of the first view to be reused by the others
+    FScene const* const scene = views[0]->getScene();
+    for (size_t i = 1; i < viewCount; i++) {
+        FILAMENT_CHECK_PRECONDITION(views[i]->getScene() == scene)
+                << "all Views of a view group must share the same Scene";
+    }
+
+    mViewGroup.scene = scene;
+    mViewGroup.scenePrepared = false;
+    for (size_t i = 0; i < viewCount; i++) {
+        FView const* const view = views[i];
+        if (UTILS_LIKELY(view && view->getScene() && view->hasCamera())) {
+            if (mViewRenderedCount) {
+                // This is a good place to kick the GPU, since we've rendered a View before,
+                // and we're about to render another one.
+                mEngine.getDriverApi().flush();
+            }
+            renderInternal(view);
+            mViewGroup.scenePrepared = true;
+            mViewRenderedCount++;
+        }
+    }
+    mViewGroup = {};
+}
+
 void FRenderer::renderInternal(FView const* view) {
     FEngine& engine = mEngine;
 
@@ -625,6 +769,16 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
     auto aoOptions = view.getAmbientOcclusionOptions();
     auto taaOptions = view.getTemporalAntiAliasingOptions();
     auto vignetteOptions = view.getVignetteOptions();
+
+    // apply the adaptive quality governor's post-processing tier, if any
+    if (UTILS_UNLIKELY(view.getAdaptiveQualityOptions().enabled)) {
+        QualityLevel const cap = view.getPostProcessQualityCap();
+        dsrOptions.quality = std::min(dsrOptions.quality, cap);
+        bloomOptions.quality = std::min(bloomOptions.quality, cap);
+        aoOptions.quality = std::min(aoOptions.quality, cap);
+        aoOptions.lowPassFilter = std::min(aoOptions.lowPassFilter, cap);
+        aoOptions.upsampling = std::min(aoOptions.upsampling, cap);
+    }
     auto colorGrading = view.getColorGrading();
     auto ssReflectionsOptions = view.getScreenSpaceReflectionsOptions();
     auto guardBandOptions = view.getGuardBandOptions();
@@ -660,8 +814,9 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
                 dsrOptions.enabled = false;
                 // also, upscaling doesn't work well with quater-resolution SSAO
                 aoOptions.resolution = 1.0;
-                // Currently we only support a fixed TAA upscaling ratio
-                scale = 0.5f;
+                // render at sub-native resolution, the TAA pass reconstructs at display
+                // resolution (upscalingFactor is clamped by setTemporalAntiAliasingOptions)
+                scale = 1.0f / taaOptions.upscalingFactor;
             }
         }
     }
@@ -721,11 +876,40 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
         return;
     }
 
+    if (scaled) {
+        // Quantize the scaled viewport, so that small dynamic-resolution fluctuations don't
+        // produce a stream of slightly different transient texture sizes; ResourceAllocator's
+        // cache only reuses textures with exact dimensions, so every unique size costs a
+        // texture allocation. The scale factor is adjusted to stay consistent with the
+        // quantized viewport (it's used e.g. to map user coordinates for picking).
+        constexpr uint32_t quantum = 16u;
+        svp.width  = std::min((svp.width  + quantum - 1u) & ~(quantum - 1u), vp.width);
+        svp.height = std::min((svp.height + quantum - 1u) & ~(quantum - 1u), vp.height);
+        scale = { float(svp.width) / float(vp.width), float(svp.height) / float(vp.height) };
+    }
+
     // xvp is the viewport relative to svp containing the "interesting" rendering
     filament::Viewport xvp = svp;
 
     CameraInfo cameraInfo = view.computeCameraInfo(engine);
 
+    // When rendering a view group, all views must share the world origin chosen by the
+    // group's first view, so that the scene data it prepared can be reused as-is.
+    bool reusePreparedScene = false;
+    if (UTILS_UNLIKELY(mViewGroup.scene)) {
+        if (mViewGroup.scenePrepared) {
+            cameraInfo = view.computeCameraInfo(mViewGroup.worldTransform);
+            reusePreparedScene = true;
+        } else {
+            mViewGroup.worldTransform = cameraInfo.worldTransform;
+        }
+    }
+
+    if (UTILS_UNLIKELY(view.getAutoExposureOptions().enabled)) {
+        // replace the camera's exposure with the adapted metering result, if any
+        cameraInfo.ev100 = view.updateAutoExposure(cameraInfo.ev100);
+    }
+
     // If fxaa and scaling are not enabled, we're essentially in a very fast rendering path -- in
     // this case, we would need an extra blit to "resolve" the buffer padding (because there are no
     // other pass that can do it as a side effect). In this case, it is better to skip the padding,
@@ -791,7 +975,11 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
         xvp.bottom = int32_t(guardBand);
     }
 
-    view.prepare(engine, driver, rootArenaScope, svp, cameraInfo, getShaderUserTime(), needsAlphaChannel);
+    auto const prepareStart = FrameInfoManager::clock::now();
+    view.prepare(engine, driver, rootArenaScope, svp, cameraInfo, getShaderUserTime(),
+            needsAlphaChannel, reusePreparedScene);
+    mFrameInfoManager.accumulate(&FrameInfoImpl::viewPrepareTime,
+            FrameInfoManager::clock::now() - prepareStart);
 
     view.prepareUpscaler(scale, taaOptions, dsrOptions);
 
@@ -910,6 +1098,20 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
     // the clearFlags and clearColor specified below will only apply when rendering into the
     // temporary color buffer. In particular, they won't apply when rendering into the main
     // swapchain (imported render target above)
+    // When the view declared a damage region and we're rendering without post-processing,
+    // restrict shading to it; the region is given in viewport coordinates and is scaled
+    // to the physical viewport (the executor offsets and clips it to the rendering viewport).
+    bool const hasDamage = UTILS_UNLIKELY(view.hasDamageRegion()) && !hasPostProcess;
+    filament::Viewport damageScissor{};
+    if (hasDamage) {
+        filament::Viewport const& damage = view.getDamageRegion();
+        damageScissor = filament::Viewport{
+                int32_t(float(damage.left) * scale.x),
+                int32_t(float(damage.bottom) * scale.y),
+                uint32_t(std::ceil(float(damage.width) * scale.x)),
+                uint32_t(std::ceil(float(damage.height) * scale.y)) };
+    }
+
     RendererUtils::ColorPassConfig config{
             .physicalViewport = svp,
             .logicalViewport = xvp,
@@ -923,7 +1125,9 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
             .hasContactShadows = scene.hasContactShadows(),
             // at this point we don't know if we have refraction, but that's handled later
             .hasScreenSpaceReflectionsOrRefractions = ssReflectionsOptions.enabled,
-            .enabledStencilBuffer = view.isStencilBufferEnabled()
+            .enabledStencilBuffer = view.isStencilBufferEnabled(),
+            .damage = damageScissor,
+            .hasDamage = hasDamage
     };
 
     /*
@@ -992,6 +1196,16 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
     });
     auto picking = picking_;
 
+    // --------------------------------------------------------------------------------------------
+    // Hi-Z pyramid and readback -- feeds next frame's occlusion culling (see OcclusionCuller)
+
+    if (UTILS_UNLIKELY(engine.debug.view.occlusion_culling)) {
+        auto const hiz = ppm.hiZ(fg, structure);
+        view.getOcclusionCuller().readback(fg, hiz,
+                mat4{ highPrecisionMultiply(cameraInfo.cullingProjection, cameraInfo.view) },
+                cameraInfo.worldTransform);
+    }
+
     // --------------------------------------------------------------------------------------------
     // Picking pass -- automatically culled if not used
     // Picking is handled here if transparent picking is enabled.
@@ -1154,7 +1368,9 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
                 });
     }
 
-    passBuilder.commandTypeFlags(RenderPass::CommandTypeFlags::COLOR);
+    passBuilder.commandTypeFlags(view.isDepthPrepassEnabled()
+            ? RenderPass::CommandTypeFlags::COLOR_WITH_DEPTH_PREPASS
+            : RenderPass::CommandTypeFlags::COLOR);
 
 
     // RenderPass::IS_INSTANCED_STEREOSCOPIC only applies to the color pass
@@ -1164,8 +1380,32 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
         passBuilder.renderFlags(renderFlags);
     }
 
-    // create the pass, which generates all its commands (this is a heavy operation)
-    RenderPass const pass{ passBuilder.build(engine, driver) };
+    // Create the pass, which generates all its commands; this is a heavy operation. When
+    // screen-space refraction is enabled we need the sorted commands right away to locate the
+    // first refraction command, so the pass is built synchronously. Otherwise, the command
+    // generation and sort are moved to a job, overlapping with the rest of the frame graph
+    // setup and its compilation; the pass is then finalized on this thread below, just before
+    // the frame graph executes.
+    bool const deferPassGeneration = !view.isScreenSpaceRefractionEnabled();
+    FrameInfoManager::duration commandGenTime{};
+    auto const passBuildStart = FrameInfoManager::clock::now();
+    RenderPass pass{ deferPassGeneration ?
+            passBuilder.buildDeferred() : passBuilder.build(engine, driver) };
+    if (!deferPassGeneration) {
+        commandGenTime = FrameInfoManager::clock::now() - passBuildStart;
+    }
+
+    JobSystem::Job* passGenerationJob = nullptr;
+    if (deferPassGeneration) {
+        // the job writes commandGenTime, which is only read back on this thread after
+        // waitAndRelease() below
+        passGenerationJob = js.runAndRetain(jobs::createJob(js, nullptr,
+                [&pass, &engine, &commandGenTime] {
+                    auto const start = FrameInfoManager::clock::now();
+                    pass.generate(engine);
+                    commandGenTime = FrameInfoManager::clock::now() - start;
+                }));
+    }
 
     // now that we have the commands we can figure out if we have refraction commands
     auto* const firstRefractionCommand = [&view](RenderPass const& pass) {
@@ -1189,9 +1429,7 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
             (isRenderingMultiview && engine.debug.stereo.
             combine_multiview_images);
 
-    // this is slightly ugly, but conceptually `pass` is const; it's just that we can't set
-    // the scissor viewport during construction
-    const_cast<RenderPass&>(pass).setScissorViewport(useIntermediateBuffer ? xvp : vp);
+    pass.setScissorViewport(useIntermediateBuffer ? xvp : vp);
 
     FrameGraphTexture::Descriptor colorBufferDesc = {
             .width = config.physicalViewport.width,
@@ -1235,7 +1473,7 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
                 .ssr = ssrConfig.ssr,
                 .structure = structure
             },
-            colorBufferDesc, config, colorGradingConfigForColor, pass.getExecutor());
+            colorBufferDesc, config, colorGradingConfigForColor, pass);
 
     if (UTILS_UNLIKELY(hasScreenSpaceRefraction)) {
         // This cancels the colorPass() call above if refraction is active.
@@ -1281,6 +1519,7 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
                     auto& history = view.getFrameHistory();
                     auto& current = history.getCurrent();
                     current.ssr.projection = projection;
+                    current.ssr.frameId = history.getPrevious().ssr.frameId + 1;
                     resources.detach(data.history, &current.ssr.color, &current.ssr.desc);
                 });
     }
@@ -1321,8 +1560,9 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
             UTILS_UNUSED_IN_RELEASE auto const& inputDesc = fg.getDescriptor(input);
             svp.width = inputDesc.width;
             svp.height = inputDesc.height;
-            xvp.width *= 2;
-            xvp.height *= 2;
+            // same rounding as the TAA pass output (see PostProcessManager::taa)
+            xvp.width  = uint32_t(float(xvp.width)  * taaOptions.upscalingFactor + 0.5f);
+            xvp.height = uint32_t(float(xvp.height) * taaOptions.upscalingFactor + 0.5f);
         }
     }
 
@@ -1335,6 +1575,11 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
 
     bool mightNeedFinalBlit = true;
     if (hasPostProcess) {
+        if (UTILS_UNLIKELY(view.getAutoExposureOptions().enabled)) {
+            // meter the linear HDR buffer; the result feeds next frame's exposure
+            ppm.autoExposure(fg, input, view.getAutoExposureResult());
+        }
+
         if (dofOptions.enabled) {
             // The bokeh height is always correct regardless of the dynamic resolution scaling.
             // (because the CoC is calculated w.r.t. the height), so we only need to adjust
@@ -1480,7 +1725,20 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
 
     fg.present(fgViewRenderTarget);
 
-    fg.compile();
+    auto const fgCompileStart = FrameInfoManager::clock::now();
+    fg.compile(mFrameGraphCompileCache.get());
+    mFrameInfoManager.accumulate(&FrameInfoImpl::frameGraphTime,
+            FrameInfoManager::clock::now() - fgCompileStart);
+
+    // when several views are rendered, the data source reflects the last one, just like
+    // "d.view.frame_info" does
+    fg.getPassStats(mPassStats.data(), mPassStats.size());
+
+    bool const gpuPassProfiling = UTILS_UNLIKELY(engine.debug.renderer.gpu_pass_profiling);
+    if (gpuPassProfiling) {
+        // overlay the most recently resolved GPU times (they lag by a few frames)
+        mPassProfiler.fillGpuTimes(mPassStats.data(), mPassStats.size());
+    }
 
 #if FILAMENT_ENABLE_FGVIEWER
     fgviewer::DebugServer* fgviewerServer = engine.debug.fgviewerServer;
@@ -1493,11 +1751,65 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
     //fg.export_graphviz(graphviz, view.getName());
     //DLOG(INFO) << graphviz.c_str();
 
+    // If the pass creation was deferred, wait for the command generation job and complete the
+    // pass on this thread. This can't be pushed further down into the frame graph execution
+    // because the shadow map passes mutate the renderable SoA (visibility masks, LODs) that
+    // the command generation reads from.
+    if (passGenerationJob) {
+        js.waitAndRelease(passGenerationJob);
+        auto const finalizeStart = FrameInfoManager::clock::now();
+        pass.finalize(engine, driver);
+        commandGenTime += FrameInfoManager::clock::now() - finalizeStart;
+    }
+    mFrameInfoManager.accumulate(&FrameInfoImpl::commandGenTime, commandGenTime);
+
+    if (auto* const counter = engine.debug.renderer.draw_calls) {
+        counter->set(uint64_t(pass.getCommandCount()));
+    }
+
+    if (gpuPassProfiling) {
+        mPassProfiler.beginFrame(driver);
+        fg.setProfiler(&mPassProfiler);
+    }
+
+    auto const fgExecuteStart = FrameInfoManager::clock::now();
     fg.execute(driver);
+    mFrameInfoManager.accumulate(&FrameInfoImpl::frameGraphTime,
+            FrameInfoManager::clock::now() - fgExecuteStart);
+
+    if (gpuPassProfiling) {
+        mPassProfiler.endFrame(driver);
+    }
 
     // save the current history entry and destroy the oldest entry
     view.commitFrameHistory(engine);
 
+    // accumulate this view's damage for presentation; any view rendered into the swap chain
+    // without a (honored) damage region forces a full present
+    if (viewRenderTarget == mRenderTargetHandle) {
+        if (UTILS_LIKELY(!hasDamage)) {
+            mFrameDamageValid = false;
+        } else if (mFrameDamageValid) {
+            filament::Viewport const& damage = view.getDamageRegion();
+            filament::Viewport const surfaceDamage{
+                    vp.left + damage.left, vp.bottom + damage.bottom,
+                    damage.width, damage.height };
+            if (!mHasFrameDamage) {
+                mFrameDamage = surfaceDamage;
+                mHasFrameDamage = true;
+            } else {
+                int32_t const l = std::min(mFrameDamage.left, surfaceDamage.left);
+                int32_t const b = std::min(mFrameDamage.bottom, surfaceDamage.bottom);
+                int32_t const r = std::max(mFrameDamage.left + int32_t(mFrameDamage.width),
+                        surfaceDamage.left + int32_t(surfaceDamage.width));
+                int32_t const t = std::max(mFrameDamage.bottom + int32_t(mFrameDamage.height),
+                        surfaceDamage.bottom + int32_t(surfaceDamage.height));
+                mFrameDamage = filament::Viewport{ l, b, uint32_t(r - l), uint32_t(t - b) };
+            }
+        }
+    }
+    view.clearDamageRegion();
+
     recordHighWatermark(commandArena.getListener().getHighWatermark());
 }
 
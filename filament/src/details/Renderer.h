@@ -21,10 +21,13 @@
 
 #include "Allocators.h"
 #include "FrameInfo.h"
+#include "FramePacer.h"
 #include "FrameSkipper.h"
 #include "PostProcessManager.h"
 #include "RenderPass.h"
 
+#include "fg/FrameGraphPassProfiler.h"
+
 #include "details/SwapChain.h"
 
 #include "backend/DriverApiForward.h"
@@ -39,15 +42,20 @@
 #include <utils/Allocator.h>
 #include <utils/FixedCapacityVector.h>
 
+#include <math/mat4.h>
 #include <math/vec4.h>
 
 #include <tsl/robin_set.h>
 
+#include <filament/DebugRegistry.h>
+
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <stddef.h>
 #include <stdint.h>
@@ -61,7 +69,9 @@ class Driver;
 } // namespace backend
 
 class FEngine;
+class FrameGraphCompileCache;
 class FRenderTarget;
+class FScene;
 class FView;
 
 /*
@@ -103,6 +113,15 @@ public:
     // render a view. must be called between beginFrame/enfFrame.
     void render(FView const* view);
 
+    // render a group of views sharing the same scene, preparing the scene only once.
+    // must be called between beginFrame/enfFrame.
+    void renderViewGroup(FView const* const* views, size_t viewCount);
+
+    // render several (swapchain, view) pairs in the current frame; presents are deferred
+    // and batched in endFrame(). must be called between beginFrame/enfFrame.
+    void renderSwapChainGroup(FSwapChain* const* swapChains, FView const* const* views,
+            size_t count);
+
     // read pixel from the current swapchain. must be called between beginFrame/enfFrame.
     void readPixels(uint32_t xoffset, uint32_t yoffset, uint32_t width, uint32_t height,
             backend::PixelBufferDescriptor&& buffer);
@@ -155,6 +174,10 @@ public:
         return MAX_FRAMETIME_HISTORY;
     }
 
+    int64_t getFrameStartOffsetNanos() const noexcept {
+        return mFramePacer.getFrameStartOffsetNanos();
+    }
+
 private:
     friend class Renderer;
     using Command = RenderPass::Command;
@@ -194,10 +217,19 @@ private:
     FrameSkipper mFrameSkipper;
     backend::Handle<backend::HwRenderTarget> mRenderTargetHandle;
     FSwapChain* mSwapChain = nullptr;
+    // swapchains rendered to earlier in the frame, whose present was deferred to endFrame()
+    // (see renderSwapChainGroup()); mSwapChain is always the most recent one
+    std::vector<FSwapChain*> mGroupSwapChains;
+    // union of the damage declared by the views rendered into the swap chain this frame,
+    // in surface coordinates; used to present with a damage rect, see FView::declareDamageRegion()
+    Viewport mFrameDamage{};
+    bool mHasFrameDamage = false;
+    bool mFrameDamageValid = true;
     size_t mCommandsHighWatermark = 0;
     uint32_t mFrameId = 0;
     uint32_t mViewRenderedCount = 0;
     FrameInfoManager mFrameInfoManager;
+    FramePacer mFramePacer;
     backend::TextureFormat mHdrTranslucent;
     backend::TextureFormat mHdrQualityMedium;
     backend::TextureFormat mHdrQualityHigh;
@@ -212,7 +244,24 @@ private:
     tsl::robin_set<FRenderTarget*> mPreviousRenderTargets;
     std::function<void()> mBeginFrameInternal;
     uint64_t mVsyncSteadyClockTimeNano = 0;
+    uint64_t mHeapAllocationsAtBeginFrame = 0;
     std::unique_ptr<ResourceAllocator> mResourceAllocator{};
+    std::unique_ptr<FrameGraphCompileCache> mFrameGraphCompileCache{};
+
+    // per-pass bandwidth estimates of the last compiled frame graph, exposed through the
+    // "d.renderer.pass_stats" data source (updated in renderJob after compile())
+    std::array<DebugRegistry::PassStats, 64> mPassStats{};
+
+    // brackets FrameGraph passes with GPU timer queries when
+    // "d.renderer.gpu_pass_profiling" is set; results land in mPassStats a few frames later
+    FrameGraphPassProfiler mPassProfiler;
+
+    // state of the view group currently being rendered (see renderViewGroup())
+    struct ViewGroup {
+        FScene const* scene = nullptr;  // scene shared by the whole group
+        bool scenePrepared = false;     // the first view of the group prepared the scene
+        math::mat4 worldTransform;      // world origin chosen by the first view
+    } mViewGroup;
 };
 
 FILAMENT_DOWNCAST(Renderer)
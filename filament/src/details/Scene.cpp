@@ -26,7 +26,8 @@
 #include "details/InstanceBuffer.h"
 #include "details/Skybox.h"
 
-#include "BufferPoolAllocator.h"
+#include "ScratchBufferPool.h"
+#include "SceneBvh.h"
 
 #include <private/utils/Tracing.h>
 
@@ -37,6 +38,9 @@
 #include <math/quat.h>
 
 #include <algorithm>
+#include <atomic>
+
+#include <string.h>
 
 using namespace filament::backend;
 using namespace filament::math;
@@ -47,7 +51,7 @@ namespace filament {
 // ------------------------------------------------------------------------------------------------
 
 FScene::FScene(FEngine& engine) :
-        mEngine(engine), mSharedState(std::make_shared<SharedState>()) {
+        mEngine(engine) {
 }
 
 FScene::~FScene() noexcept = default;
@@ -56,7 +60,8 @@ FScene::~FScene() noexcept = default;
 void FScene::prepare(JobSystem& js,
         RootArenaScope& rootArenaScope,
         mat4 const& worldTransform,
-        bool shadowReceiversAreCasters) noexcept {
+        bool shadowReceiversAreCasters,
+        bool const prepareRenderables) noexcept {
     // TODO: can we skip this in most cases? Since we rely on indices staying the same,
     //       we could only skip, if nothing changed in the RCM.
 
@@ -95,38 +100,146 @@ void FScene::prepare(JobSystem& js,
 
     // find the max intensity directional light index in our local array
     float maxIntensity = 0.0f;
-    std::pair<LightManager::Instance, TransformManager::Instance> directionalLightInstances{};
+    LightContainerData directionalLightInstances{};
 
     /*
-     * First compute the exact number of renderables and lights in the scene.
-     * Also find the main directional light.
+     * First gather the renderable and light instances of the scene, and find the main
+     * directional light. The component-manager lookups dominate here and are independent
+     * per entity, so the entity list is partitioned across the JobSystem workers: each
+     * partition compacts what it finds into a private slice of a scratch array (an entity
+     * contributes at most one renderable and one light, so a slice can never overflow its
+     * partition's entity range), and the slices are then merged in entity order, making
+     * the result identical to a serial walk regardless of how the work was split.
      */
 
-    for (Entity const e: entities) {
-        if (UTILS_LIKELY(em.isAlive(e))) {
-            auto ti = tcm.getInstance(e);
-            auto li = lcm.getInstance(e);
-            auto ri = rcm.getInstance(e);
-            if (li) {
-                // we handle the directional light here because it'd prevent multithreading below
-                if (UTILS_UNLIKELY(lcm.isDirectionalLight(li))) {
-                    // we don't store the directional lights, because we only have a single one
-                    if (lcm.getIntensity(li) >= maxIntensity) {
-                        maxIntensity = lcm.getIntensity(li);
-                        directionalLightInstances = { li, ti };
+    size_t const entityCount = entities.size();
+    if (entityCount) {
+        auto& arena = localArenaScope.getArena();
+
+        struct InstancePartition {
+            uint32_t offset;            // index of the partition's first entity
+            uint32_t renderableCount;   // renderables found in this partition
+            uint32_t lightCount;        // punctual lights found in this partition
+            float maxIntensity;         // intensity of the brightest directional light
+            LightContainerData directionalLight;
+        };
+
+        // mEntities is a set, flatten it so it can be partitioned
+        Entity* const entityArray = arena.alloc<Entity>(entityCount);
+
+        RenderableContainerData* const renderableScratch =
+                arena.alloc<RenderableContainerData>(entityCount);
+        LightContainerData* const lightScratch = arena.alloc<LightContainerData>(entityCount);
+
+        // CountSplitter<COUNT> splits ranges in half while they hold more than COUNT
+        // entities, so no more than 2n/COUNT + 1 partitions can be produced
+        constexpr size_t INSTANCE_LOOP_CHUNK = 2048;
+        InstancePartition* const partitions =
+                arena.alloc<InstancePartition>(2 * entityCount / INSTANCE_LOOP_CHUNK + 2);
+
+        if (UTILS_UNLIKELY(!entityArray || !renderableScratch || !lightScratch || !partitions)) {
+            // the per-render-pass arena couldn't hold the parallel gather's scratch
+            // (LinearAllocator returns nullptr when exhausted); gather serially instead,
+            // which needs no scratch beyond the instance containers themselves
+            for (Entity const e : entities) {
+                if (UTILS_LIKELY(em.isAlive(e))) {
+                    auto ti = tcm.getInstance(e);
+                    auto li = lcm.getInstance(e);
+                    auto ri = rcm.getInstance(e);
+                    if (li) {
+                        // the directional light is handled separately, we only keep one
+                        if (UTILS_UNLIKELY(lcm.isDirectionalLight(li))) {
+                            if (lcm.getIntensity(li) >= maxIntensity) {
+                                maxIntensity = lcm.getIntensity(li);
+                                directionalLightInstances = { li, ti };
+                            }
+                        } else {
+                            lightInstances.emplace_back(li, ti);
+                        }
+                    }
+                    if (ri) {
+                        renderableInstances.emplace_back(ri, ti);
                     }
-                } else {
-                    lightInstances.emplace_back(li, ti);
                 }
             }
-            if (ri) {
-                renderableInstances.emplace_back(ri, ti);
+        } else {
+            { size_t i = 0; for (Entity const e : entities) { entityArray[i++] = e; } }
+
+            std::atomic<uint32_t> partitionCount{ 0 };
+
+            auto instanceWork = [&em, &tcm, &lcm, &rcm, entityArray,
+                    renderableScratch, lightScratch, partitions, &partitionCount]
+                    (Entity const* p, size_t const c) {
+                FILAMENT_TRACING_NAME(FILAMENT_TRACING_CATEGORY_FILAMENT, "instanceWork");
+                size_t const offset = p - entityArray;
+                InstancePartition partition{ uint32_t(offset), 0, 0, 0.0f, {} };
+                for (size_t i = 0; i < c; i++) {
+                    Entity const e = p[i];
+                    if (UTILS_LIKELY(em.isAlive(e))) {
+                        auto ti = tcm.getInstance(e);
+                        auto li = lcm.getInstance(e);
+                        auto ri = rcm.getInstance(e);
+                        if (li) {
+                            // the directional light is handled separately, we only keep one
+                            if (UTILS_UNLIKELY(lcm.isDirectionalLight(li))) {
+                                if (lcm.getIntensity(li) >= partition.maxIntensity) {
+                                    partition.maxIntensity = lcm.getIntensity(li);
+                                    partition.directionalLight = { li, ti };
+                                }
+                            } else {
+                                lightScratch[offset + partition.lightCount++] = { li, ti };
+                            }
+                        }
+                        if (ri) {
+                            renderableScratch[offset + partition.renderableCount++] = { ri, ti };
+                        }
+                    }
+                }
+                partitions[partitionCount.fetch_add(1, std::memory_order_relaxed)] = partition;
+            };
+
+            auto* instanceJob = parallel_for(js, nullptr, entityArray, entityCount,
+                    std::cref(instanceWork), jobs::CountSplitter<INSTANCE_LOOP_CHUNK>());
+            js.runAndWait(instanceJob);
+
+            // merge the partition slices in entity order, so the ordering (and the choice of
+            // directional light among equals) matches what the serial walk produced
+            uint32_t const n = partitionCount.load(std::memory_order_relaxed);
+            std::sort(partitions, partitions + n,
+                    [](InstancePartition const& lhs, InstancePartition const& rhs) {
+                        return lhs.offset < rhs.offset;
+                    });
+
+            for (size_t i = 0; i < n; i++) {
+                InstancePartition const& partition = partitions[i];
+                size_t const renderableBase = renderableInstances.size();
+                renderableInstances.resize(renderableBase + partition.renderableCount);
+                std::copy_n(renderableScratch + partition.offset, partition.renderableCount,
+                        renderableInstances.data() + renderableBase);
+                size_t const lightBase = lightInstances.size();
+                lightInstances.resize(lightBase + partition.lightCount);
+                std::copy_n(lightScratch + partition.offset, partition.lightCount,
+                        lightInstances.data() + lightBase);
+                if (partition.directionalLight.first && partition.maxIntensity >= maxIntensity) {
+                    maxIntensity = partition.maxIntensity;
+                    directionalLightInstances = partition.directionalLight;
+                }
             }
         }
     }
 
     FILAMENT_TRACING_NAME_END(FILAMENT_TRACING_CATEGORY_FILAMENT);
 
+    // Sort the renderables by component-manager instance, so that the per-field gathers in
+    // renderableWork below walk the RenderableManager's SoA in increasing address order rather
+    // than in arbitrary scene insertion order. This gather is DRAM-latency bound, and a
+    // monotonic access pattern lets the hardware prefetcher hide most of it. The order of the
+    // rows in sceneData carries no meaning (draws are sorted by key later), so this is safe.
+    std::sort(renderableInstances.begin(), renderableInstances.end(),
+            [](RenderableContainerData const& lhs, RenderableContainerData const& rhs) {
+                return lhs.first.asValue() < rhs.first.asValue();
+            });
+
     /*
      * Evaluate the capacity needed for the renderable and light SoAs
      */
@@ -149,19 +262,32 @@ void FScene::prepare(JobSystem& js,
 
     // TODO: the resize below could happen in a job
 
-    if (!sceneData.capacity() || sceneData.size() != renderableInstances.size()) {
-        sceneData.clear();
-        if (sceneData.capacity() < renderableDataCapacity) {
-            sceneData.setCapacity(renderableDataCapacity);
+    // When the scene membership changes we only adjust the size of the SoAs; the rows
+    // themselves are not cleared because every field that matters is rewritten each frame,
+    // either below (renderableWork / lightWork) or in prepareVisibleRenderables() for the
+    // visible set. Capacity grows geometrically (preserving the multiple-of-16 plus one
+    // extra entry invariants) so that scenes streaming entities in every frame don't pay
+    // for a reallocation and a full re-construction of the SoA on each membership change.
+
+    auto grownCapacity = [](size_t const current, size_t const needed) {
+        return std::max(needed, ((current * 3 / 2 + 0xFu) & ~size_t(0xFu)) + 1);
+    };
+
+    if (prepareRenderables &&
+            (!sceneData.capacity() || sceneData.size() != renderableInstances.size())) {
+        if (UTILS_UNLIKELY(sceneData.capacity() < renderableDataCapacity)) {
+            // the rows are rewritten below, no need to move them to the new allocation
+            sceneData.clear();
+            sceneData.setCapacity(grownCapacity(sceneData.capacity(), renderableDataCapacity));
         }
         assert_invariant(renderableInstances.size() <= sceneData.capacity());
         sceneData.resize(renderableInstances.size());
     }
 
     if (lightData.size() != lightInstances.size() + DIRECTIONAL_LIGHTS_COUNT) {
-        lightData.clear();
-        if (lightData.capacity() < lightDataCapacity) {
-            lightData.setCapacity(lightDataCapacity);
+        if (UTILS_UNLIKELY(lightData.capacity() < lightDataCapacity)) {
+            lightData.clear();
+            lightData.setCapacity(grownCapacity(lightData.capacity(), lightDataCapacity));
         }
         assert_invariant(lightInstances.size() + DIRECTIONAL_LIGHTS_COUNT <= lightData.capacity());
         lightData.resize(lightInstances.size() + DIRECTIONAL_LIGHTS_COUNT);
@@ -247,15 +373,17 @@ void FScene::prepare(JobSystem& js,
 
     JobSystem::Job* rootJob = js.createJob();
 
-    auto* renderableJob = parallel_for(js, rootJob,
-            renderableInstances.data(), renderableInstances.size(),
-            std::cref(renderableWork), jobs::CountSplitter<64>());
+    if (prepareRenderables) {
+        auto* renderableJob = parallel_for(js, rootJob,
+                renderableInstances.data(), renderableInstances.size(),
+                std::cref(renderableWork), jobs::CountSplitter<64>());
+        js.run(renderableJob);
+    }
 
     auto* lightJob = parallel_for(js, rootJob,
             lightInstances.data(), lightInstances.size(),
             std::cref(lightWork), jobs::CountSplitter<32, 5>());
 
-    js.run(renderableJob);
     js.run(lightJob);
 
     // Everything below can be done in parallel.
@@ -314,7 +442,7 @@ void FScene::prepare(JobSystem& js,
 
     // Purely for the benefit of MSAN, we can avoid uninitialized reads by zeroing out the
     // unused scene elements between the end of the array and the rounded-up count.
-    if (UTILS_HAS_SANITIZE_MEMORY) {
+    if (UTILS_HAS_SANITIZE_MEMORY && prepareRenderables) {
         for (size_t i = sceneData.size(), e = sceneData.capacity(); i < e; i++) {
             sceneData.data<LAYERS>()[i] = 0;
             sceneData.data<VISIBLE_MASK>()[i] = 0;
@@ -324,6 +452,19 @@ void FScene::prepare(JobSystem& js,
 
     js.runAndWait(rootJob);
 
+    // Keep the culling BVH in sync with the new world-space AABBs. This refits the
+    // hierarchy in place unless the renderable list itself changed.
+    if (UTILS_LIKELY(prepareRenderables)) {
+        if (UTILS_UNLIKELY(sceneData.size() >= SceneBvh::MIN_RENDERABLE_COUNT)) {
+            if (!mBvh) {
+                mBvh = std::make_unique<SceneBvh>();
+            }
+            mBvh->update(sceneData);
+        } else if (UTILS_UNLIKELY(mBvh)) {
+            mBvh->update(sceneData); // clears the hierarchy
+        }
+    }
+
     FILAMENT_TRACING_NAME_END(FILAMENT_TRACING_CATEGORY_FILAMENT);
 }
 
@@ -372,7 +513,9 @@ void FScene::prepareVisibleRenderables(Range<uint32_t> visibleRenderables) noexc
                 sceneData.elementAt<INSTANCES>(i).buffer != nullptr,
                 sceneData.elementAt<CHANNELS>(i));
 
-        uboData.morphTargetCount = sceneData.elementAt<MORPHING_BUFFER>(i).count;
+        // the shader only needs to loop over the targets that can contribute (trailing
+        // zero-weight targets are skipped entirely)
+        uboData.morphTargetCount = sceneData.elementAt<MORPHING_BUFFER>(i).activeCount;
 
         uboData.objectId = rcm.getEntity(ri).getId();
 
@@ -385,24 +528,14 @@ void FScene::prepareVisibleRenderables(Range<uint32_t> visibleRenderables) noexc
 
 void FScene::updateUBOs(
         Range<uint32_t> visibleRenderables,
-        Handle<HwBufferObject> renderableUbh) noexcept {
+        Handle<HwBufferObject> renderableUbh,
+        RenderableUboCache& cache) noexcept {
     FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
     FEngine::DriverApi& driver = mEngine.getDriverApi();
 
     // don't allocate more than 16 KiB directly into the render stream
     static constexpr size_t MAX_STREAM_ALLOCATION_COUNT = 64;   // 16 KiB
     const size_t count = visibleRenderables.size();
-    PerRenderableData* buffer = [&]{
-        if (count >= MAX_STREAM_ALLOCATION_COUNT) {
-            // use the heap allocator
-            auto& bufferPoolAllocator = mSharedState->mBufferPoolAllocator;
-            return (PerRenderableData*)bufferPoolAllocator.get(count * sizeof(PerRenderableData));
-        } else {
-            // allocate space into the command stream directly
-            return driver.allocatePod<PerRenderableData>(count);
-        }
-    }();
-
     PerRenderableData const* const uboData = mRenderableData.data<UBO>();
     mat4f const* const worldTransformData = mRenderableData.data<WORLD_TRANSFORM>();
 
@@ -416,29 +549,46 @@ void FScene::updateUBOs(
         }
     }
 
+    // elide the upload when the content is bit-identical to what's already in the UBO;
+    // the per-renderable data is world-space, so a static scene seen from a moving camera
+    // hits this every frame. The memcmp (plus the snapshot on change) reads the data twice,
+    // which is much cheaper than pushing it through the command stream and the driver.
+    PerRenderableData const* const first = uboData + visibleRenderables.first;
+    if (cache.valid && cache.data.size() == count
+            && !memcmp(cache.data.data(), first, count * sizeof(PerRenderableData))) {
+        return;
+    }
+    cache.data.assign(first, first + count);
+    cache.valid = true;
+
+    PerRenderableData* buffer = [&]{
+        if (count >= MAX_STREAM_ALLOCATION_COUNT) {
+            // use the engine's shared scratch pool
+            auto& scratchBufferPool = mEngine.getScratchBufferPool();
+            return (PerRenderableData*)scratchBufferPool.get(
+                    count * sizeof(PerRenderableData), ScratchBufferPool::Tag::SCENE);
+        } else {
+            // allocate space into the command stream directly
+            return driver.allocatePod<PerRenderableData>(count);
+        }
+    }();
+
     // copy our data into the UBO for each visible renderable
     for (uint32_t const i : visibleRenderables) {
         buffer[i] = uboData[i];
     }
 
-    // We capture state shared between Scene and the update buffer callback, because the Scene could
-    // be destroyed before the callback executes.
-    std::weak_ptr<SharedState>* const weakShared = new std::weak_ptr<SharedState>(mSharedState);
-
-    // update the UBO
+    // The callback captures the engine-owned scratch pool rather than Scene state; the Scene
+    // can be destroyed before the callback executes, but the Engine drains the command stream
+    // before it goes away.
     driver.resetBufferObject(renderableUbh);
     driver.updateBufferObjectUnsynchronized(renderableUbh, {
             buffer, count * sizeof(PerRenderableData),
             +[](void* p, size_t const s, void* user) {
-                std::weak_ptr<SharedState>* const weakShared =
-                        static_cast<std::weak_ptr<SharedState>*>(user);
                 if (s >= MAX_STREAM_ALLOCATION_COUNT * sizeof(PerRenderableData)) {
-                    if (auto state = weakShared->lock()) {
-                        state->mBufferPoolAllocator.put(p);
-                    }
+                    static_cast<ScratchBufferPool*>(user)->put(p);
                 }
-                delete weakShared;
-            }, weakShared
+            }, &mEngine.getScratchBufferPool()
     }, 0);
 }
 
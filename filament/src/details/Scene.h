@@ -28,8 +28,6 @@
 #include "components/RenderableManager.h"
 #include "components/TransformManager.h"
 
-#include "BufferPoolAllocator.h"
-
 #include <filament/Box.h>
 #include <filament/Scene.h>
 
@@ -43,10 +41,12 @@
 #include <utils/debug.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <tsl/robin_set.h>
 
 #include <memory>
+#include <vector>
 
 namespace filament {
 
@@ -55,6 +55,7 @@ class FEngine;
 class FIndirectLight;
 class FRenderer;
 class FSkybox;
+class SceneBvh;
 
 class FScene : public Scene {
 public:
@@ -74,8 +75,12 @@ public:
     ~FScene() noexcept;
     void terminate(FEngine& engine);
 
+    // prepareRenderables can be false when the renderable data has already been prepared
+    // this frame with the same worldTransform (see FRenderer::renderViewGroup()); in that
+    // case only the light data is re-gathered.
     void prepare(utils::JobSystem& js, RootArenaScope& rootArenaScope,
-            math::mat4 const& worldTransform, bool shadowReceiversAreCasters) noexcept;
+            math::mat4 const& worldTransform, bool shadowReceiversAreCasters,
+            bool prepareRenderables = true) noexcept;
 
     void prepareVisibleRenderables(utils::Range<uint32_t> visibleRenderables) noexcept;
 
@@ -88,19 +93,35 @@ public:
 
     using VisibleMaskType = Culler::result_type;
 
+    // Packed per-frame classification of a renderable. This is computed only once per frame
+    // by RenderPass::updateCommandDescriptors() and consumed by the command-generation loop
+    // of every pass (see RenderPass::generateCommandsImpl()), so that per-renderable state
+    // scattered across several columns isn't re-derived for each pass.
+    struct CommandDescriptor {              // 16 bytes
+        uint64_t keyFragment;               // channel|priority sort-key bits, same in all passes
+        uint32_t skinningOffset;            // offset in the bone UBO, in bytes
+        uint16_t instanceCount;             // user-requested count, without the stereo multiplier
+        bool hasSkinning            : 1;    // whether a bone UBO is bound
+        bool hasMorphing            : 1;    // whether a morphing UBO is bound
+        bool hasSkinningOrMorphing  : 1;    // whether the SKN variant is needed
+        bool hasHybridInstancing    : 1;    // whether an instance buffer is bound
+    };
+
     enum {
         RENDERABLE_INSTANCE,    //   4 | instance of the Renderable component
         WORLD_TRANSFORM,        //  16 | instance of the Transform component
         VISIBILITY_STATE,       //   2 | visibility data of the component
         SKINNING_BUFFER,        //   8 | bones uniform buffer handle, offset, indices and weights
-        MORPHING_BUFFER,        //  16 | weights uniform buffer handle, count, morph targets
+        MORPHING_BUFFER,        //  24 | weights uniform buffer handle, counts, morph targets
         INSTANCES,              //  16 | instancing info for this Renderable
         WORLD_AABB_CENTER,      //  12 | world-space bounding box center of the renderable
         VISIBLE_MASK,           //   2 | each bit represents a visibility in a pass
         CHANNELS,               //   1 | currently light channels only
 
-        // These are not needed anymore after culling
+        // This is not needed anymore after culling
         LAYERS,                 //   1 | layers
+
+        // This is also read after culling, for lod selection
         WORLD_AABB_EXTENT,      //  12 | world-space bounding box half-extent of the renderable
 
         // These are temporaries and should be stored out of line
@@ -108,6 +129,7 @@ public:
         SUMMED_PRIMITIVE_COUNT, //   4 | summed visible primitive counts
         UBO,                    // 128 |
         DESCRIPTOR_SET_HANDLE,
+        COMMAND_DESCRIPTOR,     //  16 | per-frame packed classification for command generation
 
         // FIXME: We need a better way to handle this
         USER_DATA,              //   4 | user data currently used to store the scale
@@ -129,6 +151,7 @@ public:
             uint32_t,                                   // SUMMED_PRIMITIVE_COUNT
             PerRenderableData,                          // UBO
             backend::DescriptorSetHandle,               // DESCRIPTOR_SET_HANDLE
+            CommandDescriptor,                          // COMMAND_DESCRIPTOR
             // FIXME: We need a better way to handle this
             float                                       // USER_DATA
     >;
@@ -136,6 +159,10 @@ public:
     RenderableSoa const& getRenderableData() const noexcept { return mRenderableData; }
     RenderableSoa& getRenderableData() noexcept { return mRenderableData; }
 
+    // BVH over mRenderableData, rebuilt or refit by prepare(); null for small scenes.
+    // Only valid until the visibility partition reorders mRenderableData.
+    SceneBvh const* getBvh() const noexcept { return mBvh.get(); }
+
     static inline uint32_t getPrimitiveCount(RenderableSoa const& soa,
             uint32_t const first, uint32_t const last) noexcept {
         // the caller must guarantee that last is dereferenceable
@@ -186,8 +213,19 @@ public:
     LightSoa const& getLightData() const noexcept { return mLightData; }
     LightSoa& getLightData() noexcept { return mLightData; }
 
+    // Shadow copy of the last data uploaded to a view's renderable UBO, owned by the view
+    // because the buffer is. Lets updateUBOs() elide the upload entirely when nothing
+    // changed, which is the common case for static content (the per-renderable data is in
+    // world space and thus camera-independent). Must be invalidated when the underlying
+    // buffer object is re-created.
+    struct RenderableUboCache {
+        std::vector<PerRenderableData> data;
+        bool valid = false;
+    };
+
     void updateUBOs(utils::Range<uint32_t> visibleRenderables,
-            backend::Handle<backend::HwBufferObject> renderableUbh) noexcept;
+            backend::Handle<backend::HwBufferObject> renderableUbh,
+            RenderableUboCache& cache) noexcept;
 
     bool hasContactShadows() const noexcept;
 
@@ -229,13 +267,9 @@ private:
      */
     RenderableSoa mRenderableData;
     LightSoa mLightData;
+    std::unique_ptr<SceneBvh> mBvh;
     bool mHasContactShadows = false;
 
-    // State shared between Scene and driver callbacks.
-    struct SharedState {
-        BufferPoolAllocator<3> mBufferPoolAllocator = {};
-    };
-    std::shared_ptr<SharedState> mSharedState;
 };
 
 FILAMENT_DOWNCAST(Scene)
@@ -28,6 +28,8 @@
 #include <utils/CString.h>
 #include <utils/StaticString.h>
 
+#include <algorithm>
+
 #include <string.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -76,7 +78,8 @@ SkinningBuffer* SkinningBuffer::Builder::build(Engine& engine) {
 // ------------------------------------------------------------------------------------------------
 
 FSkinningBuffer::FSkinningBuffer(FEngine& engine, const Builder& builder)
-        : mBoneCount(builder->mBoneCount) {
+        : mShadow(decltype(mShadow)::with_capacity(builder->mBoneCount)),
+          mBoneCount(builder->mBoneCount) {
     FEngine::DriverApi& driver = engine.getDriverApi();
 
     // According to the OpenGL ES 3.2 specification in 7.6.3 Uniform
@@ -96,12 +99,18 @@ FSkinningBuffer::FSkinningBuffer(FEngine& engine, const Builder& builder)
         driver.setDebugTag(mHandle.getId(), std::move(name));
     }
 
+    mShadow.resize(mBoneCount);
+
     if (builder->mInitialize) {
         // initialize the bones to identity (before rounding up)
         auto* out = driver.allocatePod<PerRenderableBoneUib::BoneData>(mBoneCount);
         std::uninitialized_fill_n(out, mBoneCount, makeBone({}));
         driver.updateBufferObject(mHandle, {
             out, mBoneCount * sizeof(PerRenderableBoneUib::BoneData) }, 0);
+        // the shadow copy now matches the whole GPU palette
+        std::fill(mShadow.begin(), mShadow.end(), makeBone({}));
+        mShadowValidBegin = 0;
+        mShadowValidEnd = mBoneCount;
     }
 }
 
@@ -110,6 +119,60 @@ void FSkinningBuffer::terminate(FEngine& engine) {
     driver.destroyBufferObject(mHandle);
 }
 
+template<typename BoneMaker>
+void FSkinningBuffer::updateBones(FEngine& engine, size_t const count, size_t const offset,
+        BoneMaker&& boneAt) noexcept {
+    auto& driverApi = engine.getDriverApi();
+    PerRenderableBoneUib::BoneData* const UTILS_RESTRICT shadow = mShadow.data() + offset;
+
+    // When we know what the GPU palette contains for this range, trim the upload to the span
+    // of bones that actually changed; animations typically leave most of the palette
+    // untouched (e.g. idle clips animating a few joints).
+    size_t first = 0;
+    size_t last = count;
+    if (UTILS_LIKELY(offset >= mShadowValidBegin && offset + count <= mShadowValidEnd)) {
+        while (first < count) {
+            PerRenderableBoneUib::BoneData const bone{ boneAt(first) };
+            if (memcmp(&bone, &shadow[first], sizeof(bone)) != 0) {
+                break;
+            }
+            ++first;
+        }
+        if (first == count) {
+            return; // nothing changed
+        }
+        while (last - 1 > first) {
+            PerRenderableBoneUib::BoneData const bone{ boneAt(last - 1) };
+            if (memcmp(&bone, &shadow[last - 1], sizeof(bone)) != 0) {
+                break;
+            }
+            --last;
+        }
+    }
+
+    for (size_t i = first; i < last; ++i) {
+        shadow[i] = boneAt(i);
+    }
+
+    // grow the known-valid range; if the new range is disjoint from the old one we keep only
+    // the new one, which is conservative but matches how palettes are used in practice
+    if (mShadowValidEnd == mShadowValidBegin ||
+            offset > mShadowValidEnd || offset + count < mShadowValidBegin) {
+        mShadowValidBegin = uint32_t(offset);
+        mShadowValidEnd = uint32_t(offset + count);
+    } else {
+        mShadowValidBegin = std::min(mShadowValidBegin, uint32_t(offset));
+        mShadowValidEnd = std::max(mShadowValidEnd, uint32_t(offset + count));
+    }
+
+    size_t const dirtyCount = last - first;
+    auto* UTILS_RESTRICT out = driverApi.allocatePod<PerRenderableBoneUib::BoneData>(dirtyCount);
+    memcpy(out, shadow + first, dirtyCount * sizeof(PerRenderableBoneUib::BoneData));
+    driverApi.updateBufferObject(mHandle,
+            { out, dirtyCount * sizeof(PerRenderableBoneUib::BoneData) },
+            (offset + first) * sizeof(PerRenderableBoneUib::BoneData));
+}
+
 void FSkinningBuffer::setBones(FEngine& engine,
         RenderableManager::Bone const* transforms, size_t const count, size_t const offset) {
     FILAMENT_CHECK_PRECONDITION((offset + count) <= mBoneCount)
@@ -117,7 +180,12 @@ void FSkinningBuffer::setBones(FEngine& engine,
             << ") overflow (boneCount=" << (unsigned)count << ", offset=" << (unsigned)offset
             << ")";
 
-    setBones(engine, mHandle, transforms, count, offset);
+    updateBones(engine, count, offset, [transforms](size_t const i) {
+        // the transform is stored in row-major, last row is not stored.
+        mat4f transform(transforms[i].unitQuaternion);
+        transform[3] = float4{ transforms[i].translation, 1.0f };
+        return makeBone(transform);
+    });
 }
 
 void FSkinningBuffer::setBones(FEngine& engine,
@@ -127,7 +195,9 @@ void FSkinningBuffer::setBones(FEngine& engine,
             << ") overflow (boneCount=" << (unsigned)count << ", offset=" << (unsigned)offset
             << ")";
 
-    setBones(engine, mHandle, transforms, count, offset);
+    updateBones(engine, count, offset, [transforms](size_t const i) {
+        return makeBone(transforms[i]);
+    });
 }
 
 UTILS_UNUSED
@@ -43,6 +43,14 @@ namespace filament {
 class FEngine;
 class FRenderableManager;
 
+/*
+ * TODO: pre-skin on compute once per frame instead of in every pass' vertex shader. With
+ * cascaded shadows a skinned mesh is skinned 5+ times per frame (each depth variant plus the
+ * color pass); a compute dispatch fed by this buffer could write post-transform positions to a
+ * transient buffer that all passes then fetch with a trivial vertex stage. Blocked on
+ * MaterialDomain::COMPUTE, which is not implemented yet (see Material.cpp) -- the dispatch,
+ * the variant selection and the position-stream substitution should hang off it when it lands.
+ */
 class FSkinningBuffer : public SkinningBuffer {
 public:
     FSkinningBuffer(FEngine& engine, const Builder& builder);
@@ -84,7 +92,17 @@ private:
           const utils::FixedCapacityVector<math::float2>& pairs,
           size_t count);
 
+    // converts bones via boneAt(i), diffs them against the shadow copy and uploads only the
+    // span that actually changed
+    template<typename BoneMaker>
+    void updateBones(FEngine& engine, size_t count, size_t offset, BoneMaker&& boneAt) noexcept;
+
     backend::Handle<backend::HwBufferObject> mHandle;
+    // CPU shadow of the GPU palette, so setBones can skip the bones that didn't change
+    utils::FixedCapacityVector<PerRenderableBoneUib::BoneData> mShadow;
+    // range of mShadow known to match the GPU buffer's content
+    uint32_t mShadowValidBegin = 0;
+    uint32_t mShadowValidEnd = 0;
     uint32_t mBoneCount;
 };
 
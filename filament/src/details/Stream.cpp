@@ -126,4 +126,9 @@ int64_t FStream::getTimestamp() const noexcept {
     return driver.getStreamTimestamp(mStreamHandle);
 }
 
+StreamStats FStream::getStats() const noexcept {
+    FEngine::DriverApi& driver = mEngine.getDriverApi();
+    return driver.getStreamStats(mStreamHandle);
+}
+
 } // namespace filament
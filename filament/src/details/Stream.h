@@ -51,6 +51,8 @@ public:
 
     int64_t getTimestamp() const noexcept;
 
+    backend::StreamStats getStats() const noexcept;
+
 private:
     FEngine& mEngine;
     const StreamType mStreamType;
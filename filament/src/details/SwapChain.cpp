@@ -41,6 +41,19 @@ FSwapChain::FSwapChain(FEngine& engine, uint32_t const width, uint32_t const hei
     mHwSwapChain = engine.getDriverApi().createSwapChainHeadless(width, height, flags);
 }
 
+void FSwapChain::setFrameQueueDepth(uint8_t const depth) noexcept {
+    // a depth of one frame is the low-latency mode; anything deeper is left to the
+    // presentation engine's default queueing
+    uint64_t flags = mConfigFlags;
+    if (depth <= 1) {
+        flags |= CONFIG_LOW_LATENCY;
+    } else {
+        flags &= ~CONFIG_LOW_LATENCY;
+    }
+    // recreateWithNewFlags() is a no-op if the flags don't change
+    recreateWithNewFlags(mEngine, flags);
+}
+
 void FSwapChain::recreateWithNewFlags(FEngine& engine, uint64_t flags) noexcept {
     flags = initFlags(engine, flags);
     if (flags != mConfigFlags) {
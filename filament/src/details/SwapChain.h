@@ -90,8 +90,9 @@ public:
 
     static bool isProtectedContentSupported(FEngine& engine) noexcept;
 
-    // This is currently only used for debugging. This allows to recreate the HwSwapChain with
-    // new flags.
+    void setFrameQueueDepth(uint8_t depth) noexcept;
+
+    // Recreates the HwSwapChain with new flags. Used by setFrameQueueDepth() and for debugging.
     void recreateWithNewFlags(FEngine& engine, uint64_t flags) noexcept;
 
 private:
@@ -312,6 +312,19 @@ FTexture::FTexture(FEngine& engine, const Builder& builder)
     if (UTILS_LIKELY(!isImported)) {
         mHandle = driver.createTexture(
                 mTarget, mLevelCount, mFormat, mSampleCount, mWidth, mHeight, mDepth, mUsage);
+        // account for the estimated GPU storage (imported and external textures are not
+        // owned by the engine, so they're not counted)
+        size_t pixelCount = size_t(mWidth) * mHeight * mDepth;
+        if (mTarget == Sampler::SAMPLER_CUBEMAP || mTarget == Sampler::SAMPLER_CUBEMAP_ARRAY) {
+            pixelCount *= 6;
+        }
+        size_t size = pixelCount * getFormatSize(mFormat) * std::max(uint8_t(1), mSampleCount);
+        if (mLevelCount > 1) {
+            // if we have mip-maps we assume the full pyramid
+            size += size / 3;
+        }
+        mEstimatedSize = size;
+        engine.getMemoryMonitor().track(MemoryMonitor::Category::TEXTURES, mEstimatedSize);
     } else {
         mHandle = driver.importTexture(builder->mImportedId,
                 mTarget, mLevelCount, mFormat, mSampleCount, mWidth, mHeight, mDepth, mUsage);
@@ -335,6 +348,10 @@ FTexture::FTexture(FEngine& engine, const Builder& builder)
 
 // frees driver resources, object becomes invalid
 void FTexture::terminate(FEngine& engine) {
+    if (mEstimatedSize) {
+        engine.getMemoryMonitor().release(MemoryMonitor::Category::TEXTURES, mEstimatedSize);
+        mEstimatedSize = 0;
+    }
     setHandles({});
 }
 
@@ -561,6 +578,7 @@ void FTexture::setExternalImage(FEngine& engine, ExternalImageHandleRef image) n
     }
 
     setHandles(texture);
+    mExternalImage = image;
 }
 
 void FTexture::setExternalImage(FEngine& engine, void* image) noexcept {
@@ -649,6 +667,43 @@ void FTexture::generateMipmaps(FEngine& engine) const noexcept {
     const_cast<FTexture*>(this)->updateLodRange(0, mLevelCount);
 }
 
+void FTexture::generateMipmapsAsync(FEngine& engine) const noexcept {
+    FILAMENT_CHECK_PRECONDITION(!mExternal)
+            << "External Textures are not mipmappable.";
+
+    FILAMENT_CHECK_PRECONDITION(mTarget != SamplerType::SAMPLER_3D)
+            << "3D Textures are not mipmappable.";
+
+    const bool formatMipmappable = engine.getDriverApi().isTextureFormatMipmappable(mFormat);
+    FILAMENT_CHECK_PRECONDITION(formatMipmappable)
+            << "Texture format " << (unsigned)mFormat << " is not mipmappable.";
+
+    if (mLevelCount < 2 || (mWidth == 1 && mHeight == 1)) {
+        return;
+    }
+
+    // The GPU work happens a budgeted amount per frame; until then samplers stay clamped to
+    // the levels populated with setImage(), so the texture renders at reduced detail.
+    engine.queueMipmapGeneration(this);
+}
+
+void FTexture::setLodRange(FEngine&, uint8_t const baseLevel, uint8_t const levelCount) {
+    FILAMENT_CHECK_PRECONDITION(!mExternal)
+            << "External Texture not supported for this operation.";
+
+    FILAMENT_CHECK_PRECONDITION(any(mUsage & Usage::SAMPLEABLE) && mLevelCount > 1)
+            << "setLodRange() requires a SAMPLEABLE texture with more than one mip level.";
+
+    FILAMENT_CHECK_PRECONDITION(levelCount >= 1 && baseLevel + levelCount <= mLevelCount)
+            << "baseLevel=" << unsigned(baseLevel) << " levelCount=" << unsigned(levelCount)
+            << " is out of range for levelCount=" << unsigned(mLevelCount) << ".";
+
+    // Unlike updateLodRange(), which only ever grows the range as levels are populated, this
+    // can shrink it, marking levels non-resident again (e.g. an evicted mip head); the
+    // sampling view is re-created lazily by getHwHandleForSampling().
+    mLodRange = { baseLevel, uint8_t(baseLevel + levelCount) };
+}
+
 bool FTexture::textureHandleCanMutate() const noexcept {
     return (any(mUsage & Usage::SAMPLEABLE) && mLevelCount > 1) || mExternal;
 }
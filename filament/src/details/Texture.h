@@ -66,12 +66,17 @@ public:
             PixelBufferDescriptor&& buffer, const FaceOffsets& faceOffsets) const;
 
     void setExternalImage(FEngine& engine, ExternalImageHandleRef image) noexcept;
+    ExternalImageHandle getExternalImage() const noexcept { return mExternalImage; }
     void setExternalImage(FEngine& engine, void* image) noexcept;
     void setExternalImage(FEngine& engine, void* image, size_t plane) noexcept;
     void setExternalStream(FEngine& engine, FStream* stream) noexcept;
 
     void generateMipmaps(FEngine& engine) const noexcept;
 
+    void generateMipmapsAsync(FEngine& engine) const noexcept;
+
+    void setLodRange(FEngine& engine, uint8_t baseLevel, uint8_t levelCount);
+
     bool isCompressed() const noexcept { return isCompressedFormat(mFormat); }
 
     bool isCubemap() const noexcept { return mTarget == Sampler::SAMPLER_CUBEMAP; }
@@ -168,6 +173,9 @@ private:
     uint32_t mHeight = 1;
     uint32_t mDepth = 1;
 
+    // estimated GPU storage reported to the engine's MemoryMonitor, 0 when not counted
+    size_t mEstimatedSize = 0;
+
     InternalFormat mFormat = InternalFormat::RGBA8;
     Sampler mTarget = Sampler::SAMPLER_2D;
     uint8_t mLevelCount = 1;
@@ -188,6 +196,10 @@ private:
     bool mTextureIsSwizzled : 1;
 
     FStream* mStream = nullptr; // only needed for streaming textures
+
+    // Keeps the platform image set by setExternalImage() alive and retrievable, so it can be
+    // re-imported into other engines (see Texture::getExternalImage()).
+    ExternalImageHandle mExternalImage;
 };
 
 FILAMENT_DOWNCAST(Texture)
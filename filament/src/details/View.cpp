@@ -19,10 +19,13 @@
 #include "Culler.h"
 #include "FrameHistory.h"
 #include "Froxelizer.h"
+#include "RenderPass.h"
 #include "RenderPrimitive.h"
 #include "ResourceAllocator.h"
+#include "SceneBvh.h"
 #include "ShadowMapManager.h"
 
+#include "details/ColorGrading.h"
 #include "details/Engine.h"
 #include "details/IndirectLight.h"
 #include "details/RenderTarget.h"
@@ -42,6 +45,7 @@
 
 #include <utils/compiler.h>
 #include <utils/debug.h>
+#include <utils/FixedCapacityVector.h>
 #include <utils/Profiler.h>
 #include <utils/Slice.h>
 #include <utils/Zip2Iterator.h>
@@ -49,7 +53,12 @@
 #include <math/scalar.h>
 #include <math/fast.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <tuple>
 
@@ -61,6 +70,9 @@ using namespace backend;
 using namespace math;
 
 static constexpr float PID_CONTROLLER_Ki = 0.002f;
+
+// how many degradation steps the adaptive quality governor has per quality axis
+static constexpr uint8_t ADAPTIVE_QUALITY_STEPS_PER_AXIS = 2;
 static constexpr float PID_CONTROLLER_Kd = 0.0f;
 
 FView::FView(FEngine& engine)
@@ -105,6 +117,9 @@ FView::FView(FEngine& engine)
     debugRegistry.registerProperty("d.view.camera_at_origin",
             &engine.debug.view.camera_at_origin);
 
+    debugRegistry.registerProperty("d.view.occlusion_culling",
+            &engine.debug.view.occlusion_culling);
+
     // The integral term is used to fight back the dead-band below, we limit how much it can act.
     mPidController.setIntegralLimits(-100.0f, 100.0f);
 
@@ -181,6 +196,7 @@ void FView::terminate(FEngine& engine) {
     }
     mFroxelizer.terminate(driver);
     mCommonRenderableDescriptorSet.terminate(driver);
+    mOcclusionCuller.terminate();
 
     engine.getEntityManager().destroy(mFogEntity);
 
@@ -229,6 +245,20 @@ void FView::setDynamicResolutionOptions(DynamicResolutionOptions const& options)
     }
 }
 
+void FView::setAdaptiveQualityOptions(AdaptiveQualityOptions options) noexcept {
+    // sanitize the parameters
+    options.degradeFrameCount = std::max(options.degradeFrameCount, uint8_t(1));
+    options.restoreFrameCount = std::max(options.restoreFrameCount, uint16_t(1));
+    options.restoreHeadroom = clamp(options.restoreHeadroom, 0.0f, 0.5f);
+    mAdaptiveQualityOptions = options;
+    if (!options.enabled) {
+        // forget the current degradation, so quality is restored immediately
+        mAdaptiveQualityLevel = 0;
+        mOverBudgetFrameCount = 0;
+        mUnderBudgetFrameCount = 0;
+    }
+}
+
 void FView::setDynamicLightingOptions(float const zLightNear, float const zLightFar) noexcept {
     mFroxelizer.setOptions(zLightNear, zLightFar);
 }
@@ -248,6 +278,12 @@ float2 FView::updateScale(FEngine& engine,
     }
 #endif
 
+    // The quality governor consumes the same denoised frame-time signal as the dynamic
+    // resolution controller below, but acts on discrete quality tiers with hysteresis.
+    updateAdaptiveQuality(info,
+            (1000.0f * float(frameRateOptions.interval)) / displayInfo.refreshRate
+                    * (1.0f - frameRateOptions.headRoomRatio));
+
     DynamicResolutionOptions const& options = mDynamicResolution;
     if (options.enabled) {
         // if timerQueries are not supported, info.valid will always be false; but in that case
@@ -319,9 +355,18 @@ float2 FView::updateScale(FEngine& engine,
             mScale = std::sqrt(scale);
         }
 
+        // The quality governor can cap the upper bound of the scale range, forcing extra
+        // savings when the PID controller alone can't hold the frame budget.
+        float2 maxScale = options.maxScale;
+        if (UTILS_UNLIKELY(mAdaptiveQualityLevel)) {
+            constexpr float areaCap[ADAPTIVE_QUALITY_STEPS_PER_AXIS + 1] = { 1.0f, 0.75f, 0.5f };
+            uint8_t const steps = getAxisDegradation(AdaptiveQualityOptions::Axis::RESOLUTION);
+            maxScale *= std::sqrt(areaCap[steps]);
+        }
+
         // always clamp to the min/max scale range
         const auto s = mScale;
-        mScale = clamp(s, options.minScale, options.maxScale);
+        mScale = clamp(s, min(options.minScale, maxScale), maxScale);
 
         // disable the integration term when we're outside the controllable range
         // (i.e. we clamped). This help not to have to wait too long for the Integral term
@@ -357,6 +402,83 @@ float2 FView::updateScale(FEngine& engine,
     return mScale;
 }
 
+void FView::updateAdaptiveQuality(filament::details::FrameInfo const& info,
+        float const targetMilliseconds) noexcept {
+    AdaptiveQualityOptions const& options = mAdaptiveQualityOptions;
+    if (!options.enabled || !info.valid) {
+        // without frame-time measurements we can't close the loop; hold the current level
+        mOverBudgetFrameCount = 0;
+        mUnderBudgetFrameCount = 0;
+        return;
+    }
+
+    // total degradation steps available, given the deduplicated priority list
+    uint8_t maxLevel = 0;
+    bool seen[3] = {};
+    for (auto const axis : options.priority) {
+        size_t const index = size_t(axis);
+        if (index < 3 && !seen[index]) {
+            seen[index] = true;
+            maxLevel += ADAPTIVE_QUALITY_STEPS_PER_AXIS;
+        }
+    }
+    // the priority list can change between frames
+    mAdaptiveQualityLevel = std::min(mAdaptiveQualityLevel, maxLevel);
+
+    using std::chrono::duration;
+    float const measured = duration<float, std::milli>{ info.denoisedFrameTime }.count();
+    if (measured > targetMilliseconds) {
+        mOverBudgetFrameCount++;
+        mUnderBudgetFrameCount = 0;
+    } else if (measured < targetMilliseconds * (1.0f - options.restoreHeadroom)) {
+        mUnderBudgetFrameCount++;
+        mOverBudgetFrameCount = 0;
+    } else {
+        // inside the hysteresis band, hold
+        mOverBudgetFrameCount = 0;
+        mUnderBudgetFrameCount = 0;
+    }
+
+    if (mOverBudgetFrameCount >= options.degradeFrameCount && mAdaptiveQualityLevel < maxLevel) {
+        mAdaptiveQualityLevel++;
+        mOverBudgetFrameCount = 0;
+    } else if (mUnderBudgetFrameCount >= options.restoreFrameCount && mAdaptiveQualityLevel > 0) {
+        mAdaptiveQualityLevel--;
+        mUnderBudgetFrameCount = 0;
+    }
+}
+
+uint8_t FView::getAxisDegradation(AdaptiveQualityOptions::Axis const axis) const noexcept {
+    // walk the axes in sacrifice order, handing out steps until the current level is consumed
+    uint8_t level = mAdaptiveQualityLevel;
+    bool seen[3] = {};
+    for (auto const entry : mAdaptiveQualityOptions.priority) {
+        size_t const index = size_t(entry);
+        if (index >= 3 || seen[index]) {
+            continue;
+        }
+        seen[index] = true;
+        uint8_t const steps = std::min(level, ADAPTIVE_QUALITY_STEPS_PER_AXIS);
+        if (entry == axis) {
+            return steps;
+        }
+        level -= steps;
+    }
+    return 0;
+}
+
+QualityLevel FView::getPostProcessQualityCap() const noexcept {
+    switch (getAxisDegradation(AdaptiveQualityOptions::Axis::POST_PROCESSING)) {
+        default: return QualityLevel::ULTRA;
+        case 1:  return QualityLevel::MEDIUM;
+        case 2:  return QualityLevel::LOW;
+    }
+}
+
+uint8_t FView::getShadowMapSizeShift() const noexcept {
+    return getAxisDegradation(AdaptiveQualityOptions::Axis::SHADOWS);
+}
+
 void FView::setVisibleLayers(uint8_t const select, uint8_t const values) noexcept {
     mVisibleLayers = (mVisibleLayers & ~select) | (values & select);
 }
@@ -524,18 +646,37 @@ CameraInfo FView::computeCameraInfo(FEngine& engine) const noexcept {
         // as float, it only has about a 1e-8 precision on the size of the basis vectors
         rotation = orthogonalize(rotation);
     }
-    return { *camera, mat4{ rotation } * mat4::translation(translation) };
+    return computeCameraInfo(mat4{ rotation } * mat4::translation(translation));
+}
+
+CameraInfo FView::computeCameraInfo(mat4 const& worldTransform) const noexcept {
+    FCamera const* const camera = mViewingCamera ? mViewingCamera : mCullingCamera;
+    return { *camera, worldTransform };
 }
 
 void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootArenaScope,
         filament::Viewport const viewport, CameraInfo cameraInfo,
-        float4 const& userTime, bool const needsAlphaChannel) noexcept {
+        float4 const& userTime, bool const needsAlphaChannel,
+        bool const reusePreparedScene) noexcept {
 
         FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
         FILAMENT_TRACING_CONTEXT(FILAMENT_TRACING_CATEGORY_FILAMENT);
 
     JobSystem& js = engine.getJobSystem();
 
+    // If a new color grading was set, switch to it once its LUT is baked; until then the
+    // current one remains active, so changing gradings never stalls a frame.
+    if (UTILS_UNLIKELY(mPendingColorGrading)) {
+        if (mPendingColorGrading->isReady()) {
+            mPendingColorGrading->completeBake(engine);
+            mColorGrading = mPendingColorGrading;
+            mPendingColorGrading = nullptr;
+        }
+    }
+    // This handles the very first frames, when even the initial LUT can still be baking;
+    // in that case we wait, just like when the LUT was generated at build() time.
+    mColorGrading->completeBake(engine);
+
     /*
      * Prepare the scene -- this is where we gather all the objects added to the scene,
      * and in particular their world-space AABB.
@@ -564,10 +705,23 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
     /*
      * Gather all information needed to render this scene. Apply the world origin to all
      * objects in the scene.
+     *
+     * When we're part of a view group, a previous view has already prepared the renderable
+     * data with the same world origin (see FRenderer::renderViewGroup()), and we can reuse
+     * it. The light data however is re-gathered, because prepareVisibleLights() below trims
+     * it to each view's visible set. The visibility masks are reset because the culling
+     * passes OR into them.
      */
     scene->prepare(js, rootArenaScope,
             cameraInfo.worldTransform,
-            hasVSM());
+            hasVSM(),
+            !reusePreparedScene);
+
+    if (UTILS_UNLIKELY(reusePreparedScene)) {
+        auto& sceneData = scene->getRenderableData();
+        std::fill_n(sceneData.data<FScene::VISIBLE_MASK>(), sceneData.size(),
+                FScene::VisibleMaskType{});
+    }
 
     /*
      * Light culling: runs in parallel with Renderable culling (below)
@@ -613,6 +767,34 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
 
         prepareVisibleRenderables(js, cullingFrustum, renderableData);
 
+        /*
+         * Instanced stereo: refine the main-camera visibility with per-eye masks. The single
+         * culling frustum above covers all eyes and can be very conservative when the eyes
+         * diverge (e.g. one scene driving several displays).
+         */
+        if (UTILS_UNLIKELY(hasStereo() && isFrustumCullingEnabled() &&
+                engine.getConfig().stereoscopicType == StereoscopicType::INSTANCED)) {
+            cullRenderablesPerEye(renderableData, cameraInfo,
+                    engine.getConfig().stereoscopicEyeCount);
+        }
+
+        /*
+         * Occlusion culling: remove renderables hidden behind last frame's occluders,
+         * using the Hi-Z snapshot read back by the FrameGraph (see OcclusionCuller).
+         */
+        if (UTILS_UNLIKELY(engine.debug.view.occlusion_culling)) {
+            mOcclusionCuller.prepare(cameraInfo.worldTransform);
+            cullRenderablesOccluded(renderableData);
+        }
+
+        /*
+         * Contribution culling: drop renderables whose projected bounding sphere covers
+         * less than the configured number of pixels (see setContributionCullingThreshold()).
+         */
+        if (UTILS_UNLIKELY(mContributionCullingThreshold > 0.0f)) {
+            cullRenderablesContribution(renderableData, cameraInfo, mViewport,
+                    mContributionCullingThreshold);
+        }
 
         /*
          * Shadowing: compute the shadow camera and cull shadow casters
@@ -644,6 +826,8 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
                 //       strictly necessary
                 getColorPassDescriptorSet().prepareDynamicLights(mFroxelizer);
             }
+            // set before the job is launched, froxelizeLights() reads these
+            froxelizer.setFogOptions(mFogOptions);
             // We need to pass viewMatrix by value here because it extends the scope of this
             // function.
             std::function<void(JobSystem&, JobSystem::Job*)> froxelizerWork =
@@ -709,6 +893,10 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
         // convert to indices
         mVisibleRenderables = { 0, uint32_t(beginDirCastersOnly - beginRenderables) };
 
+        if (auto* const counter = engine.debug.view.visible_renderables) {
+            counter->set(uint64_t(mVisibleRenderables.size()));
+        }
+
         mVisibleDirectionalShadowCasters = {
                 uint32_t(beginDirCasters - beginRenderables),
                 uint32_t(endDirCastersOnly - beginRenderables)};
@@ -740,11 +928,13 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
                 mRenderableUbh = driver.createBufferObject(
                         mRenderableUBOSize + sizeof(PerRenderableUib),
                         BufferObjectBinding::UNIFORM, BufferUsage::DYNAMIC);
+                // the new buffer is empty, the shadow copy no longer matches its content
+                mRenderableUboCache.valid = false;
             } else {
                 // TODO: should we shrink the underlying UBO at some point?
             }
             assert_invariant(mRenderableUbh);
-            scene->updateUBOs(merged, mRenderableUbh);
+            scene->updateUBOs(merged, mRenderableUbh, mRenderableUboCache);
 
             mCommonRenderableDescriptorSet.setBuffer(
                 engine.getPerRenderableDescriptorSetLayout(),
@@ -836,6 +1026,10 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
                         mCommonRenderableDescriptorSet.getHandle();
             }
         }
+
+        // Classify the renderables once for the whole frame; every pass (shadow, color,
+        // picking, ...) consumes this from its command-generation loop.
+        RenderPass::updateCommandDescriptors(sceneData, merged);
     }
 
     /*
@@ -917,7 +1111,7 @@ void FView::prepareUpscaler(float2 const scale,
     if (taaOptions.enabled) {
         bias += taaOptions.lodBias;
         if (taaOptions.upscaling) {
-            derivativesScale = 0.5f;
+            derivativesScale = 1.0f / taaOptions.upscalingFactor;
         }
     }
     getColorPassDescriptorSet().prepareLodBias(bias, derivativesScale);
@@ -1003,21 +1197,137 @@ void FView::commitFroxels(DriverApi& driverApi) const noexcept {
 }
 
 UTILS_NOINLINE
-void FView::prepareVisibleRenderables(JobSystem& js,
+void FView::prepareVisibleRenderables(JobSystem&,
         Frustum const& frustum, FScene::RenderableSoa& renderableData) const noexcept {
     FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
     if (UTILS_LIKELY(isFrustumCullingEnabled())) {
-        cullRenderables(js, renderableData, frustum, VISIBLE_RENDERABLE_BIT);
+        cullRenderablesTemporal(renderableData, frustum);
     } else {
+        mTemporalVisibility.valid = false;
         std::uninitialized_fill(renderableData.begin<FScene::VISIBLE_MASK>(),
                   renderableData.end<FScene::VISIBLE_MASK>(), VISIBLE_RENDERABLE);
     }
 }
 
+void FView::cullRenderablesTemporal(FScene::RenderableSoa& renderableData,
+        Frustum const& frustum) const noexcept {
+    FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
+
+    size_t const count = renderableData.size();
+    auto& cache = mTemporalVisibility;
+
+    float3 const* const UTILS_RESTRICT center = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const UTILS_RESTRICT extent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+    auto const* const UTILS_RESTRICT instances = renderableData.data<FScene::RENDERABLE_INSTANCE>();
+    FScene::VisibleMaskType* const UTILS_RESTRICT visibleArray =
+            renderableData.data<FScene::VISIBLE_MASK>();
+
+    float4 planes[6];
+    frustum.getNormalizedPlanes(planes);
+
+    // signed distance of an AABB to the closest culling plane; > 0 when the box intersects
+    // the frustum (same convention as Culler::intersects(), which tests dot < 0)
+    auto const slackOf = [&planes](float3 const c, float3 const e) noexcept -> float {
+        float slack = std::numeric_limits<float>::max();
+        for (auto const& p : planes) {
+            const float dot =
+                    p.x * c.x - std::abs(p.x) * e.x +
+                    p.y * c.y - std::abs(p.y) * e.y +
+                    p.z * c.z - std::abs(p.z) * e.z +
+                    p.w;
+            slack = std::min(slack, -dot);
+        }
+        return slack;
+    };
+
+    auto const setBit = [visibleArray](size_t const i, bool const visible) noexcept {
+        auto r = visibleArray[i];
+        r &= ~FScene::VisibleMaskType(VISIBLE_RENDERABLE);
+        r |= FScene::VisibleMaskType(visible ? VISIBLE_RENDERABLE : 0u);
+        visibleArray[i] = r;
+    };
+
+    // the cache is only usable if the renderable list is the same as last frame's
+    bool const reusable = cache.valid && cache.instances.size() == count &&
+            !memcmp(cache.instances.data(), instances, count * sizeof(instances[0]));
+
+    if (reusable) {
+        // conservative frame-over-frame bound on how much each plane moved
+        float dnMax = 0.0f;     // rotation of the (normalized) plane normals
+        float ddMax = 0.0f;     // translation of the plane offsets
+        for (size_t j = 0; j < 6; j++) {
+            dnMax = std::max(dnMax, length(planes[j].xyz - cache.planes[j].xyz));
+            ddMax = std::max(ddMax, std::abs(planes[j].w - cache.planes[j].w));
+        }
+        for (size_t i = 0; i < count; i++) {
+            // the plane test at 'c' can have changed by at most this much since last frame;
+            // a large camera jump makes this bound larger than every slack, which degenerates
+            // into a full re-cull below.
+            float const bound = dnMax * (length(center[i]) + length(extent[i])) + ddMax
+                    + length(center[i] - cache.centers[i])
+                    + std::abs(extent[i].x - cache.extents[i].x)
+                    + std::abs(extent[i].y - cache.extents[i].y)
+                    + std::abs(extent[i].z - cache.extents[i].z);
+            float m = cache.slack[i];
+            if (std::abs(m) > bound) {
+                // last frame's result still holds; shrink the slack by the motion bound
+                m = (m > 0.0f) ? m - bound : m + bound;
+            } else {
+                m = slackOf(center[i], extent[i]);
+            }
+            cache.slack[i] = m;
+            cache.centers[i] = center[i];
+            cache.extents[i] = extent[i];
+            setBit(i, m > 0.0f);
+        }
+    } else {
+        cache.instances.assign(instances, instances + count);
+        cache.centers.assign(center, center + count);
+        cache.extents.assign(extent, extent + count);
+        cache.slack.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            float const m = slackOf(center[i], extent[i]);
+            cache.slack[i] = m;
+            setBit(i, m > 0.0f);
+        }
+    }
+    std::copy(std::begin(planes), std::end(planes), std::begin(cache.planes));
+    cache.valid = true;
+}
+
+void FView::cullRenderablesOccluded(FScene::RenderableSoa& renderableData) const noexcept {
+    FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
+
+    if (!mOcclusionCuller.hasSnapshot()) {
+        return;
+    }
+
+    size_t const count = renderableData.size();
+    float3 const* const UTILS_RESTRICT center = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const UTILS_RESTRICT extent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+    FScene::VisibleMaskType* const UTILS_RESTRICT visibleArray =
+            renderableData.data<FScene::VISIBLE_MASK>();
+
+    // only the main camera's visibility is affected; shadow casters keep their bits, an
+    // occluded renderable can still cast a visible shadow
+    for (size_t i = 0; i < count; i++) {
+        if ((visibleArray[i] & VISIBLE_RENDERABLE) &&
+                !mOcclusionCuller.isVisible(center[i], extent[i])) {
+            visibleArray[i] &= ~FScene::VisibleMaskType(VISIBLE_RENDERABLE);
+        }
+    }
+}
+
 void FView::cullRenderables(JobSystem&,
-        FScene::RenderableSoa& renderableData, Frustum const& frustum, size_t bit) noexcept {
+        FScene::RenderableSoa& renderableData, Frustum const& frustum, size_t bit,
+        SceneBvh const* bvh) noexcept {
     FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
 
+    if (bvh && bvh->isValidFor(renderableData)) {
+        bvh->cull(frustum, renderableData, bit);
+        return;
+    }
+
     float3 const* worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
     float3 const* worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
     FScene::VisibleMaskType* visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
@@ -1040,6 +1350,156 @@ void FView::cullRenderables(JobSystem&,
     functor(0, renderableData.size());
 }
 
+void FView::cullRenderablesPerEye(FScene::RenderableSoa& renderableData,
+        CameraInfo const& cameraInfo, size_t const eyeCount) noexcept {
+    FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
+
+    assert_invariant(eyeCount <= CONFIG_MAX_STEREOSCOPIC_EYES);
+
+    float3 const* worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+    FScene::VisibleMaskType* const visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
+    size_t const count = renderableData.size();
+
+    // Note: eyeProjection is the drawing projection (infinite far plane); the far-plane
+    // cull already happened against the main culling frustum in prepareVisibleRenderables().
+    for (size_t eye = 0; eye < eyeCount; eye++) {
+        Frustum const eyeFrustum{ mat4f{ highPrecisionMultiply(
+                cameraInfo.eyeProjection[eye],
+                highPrecisionMultiply(cameraInfo.eyeFromView[eye], cameraInfo.view)) }};
+        Culler::intersects(visibleArray, eyeFrustum,
+                worldAABBCenter, worldAABBExtent, count, VISIBLE_EYE_0_RENDERABLE_BIT + eye);
+    }
+
+    // With widely diverging eyes (e.g. multi-display rigs) the single culling frustum is a
+    // loose union of the eye frusta; a renderable inside that union but outside every eye's
+    // own frustum doesn't need to be drawn at all.
+    for (size_t i = 0; i < count; i++) {
+        if ((visibleArray[i] & VISIBLE_RENDERABLE) && !(visibleArray[i] & VISIBLE_EYES_MASK)) {
+            visibleArray[i] &= ~FScene::VisibleMaskType(VISIBLE_RENDERABLE);
+        }
+    }
+}
+
+void FView::cullRenderablesContribution(FScene::RenderableSoa& renderableData,
+        CameraInfo const& cameraInfo, filament::Viewport const& viewport,
+        float const minPixelArea) noexcept {
+    FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
+
+    float3 const* const UTILS_RESTRICT center = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const UTILS_RESTRICT extent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+    FScene::VisibleMaskType* const UTILS_RESTRICT visibleArray =
+            renderableData.data<FScene::VISIBLE_MASK>();
+    size_t const count = renderableData.size();
+
+    // projection[1][1] maps view-space y to clip space, so a bounding sphere of radius r
+    // at view-space distance d projects to a circle of roughly r / d * p11 * height / 2
+    // pixels (no division by d for an orthographic projection)
+    bool const isPerspective = cameraInfo.projection[3].w == 0.0f;
+    float const yScale = cameraInfo.projection[1][1] * float(viewport.height) * 0.5f;
+    float3 const cameraPosition = cameraInfo.getPosition();
+
+    // the threshold is a covered area in pixels, convert it to a radius in pixels
+    float const minRadiusPixels = std::sqrt(minPixelArea / f::PI);
+
+    for (size_t i = 0; i < count; i++) {
+        if (visibleArray[i] & VISIBLE_RENDERABLE) {
+            float const radius = length(extent[i]);
+            float const distance = length(center[i] - cameraPosition);
+            if (isPerspective && distance <= radius) {
+                // the camera is inside the bounding sphere, it covers the whole screen
+                continue;
+            }
+            float const radiusPixels = isPerspective ? radius * yScale / distance
+                                                     : radius * yScale;
+            if (radiusPixels < minRadiusPixels) {
+                // only the main visibility is affected, the object can still cast shadows
+                visibleArray[i] &= ~FScene::VisibleMaskType(VISIBLE_RENDERABLE);
+            }
+        }
+    }
+}
+
+
+// Distributes `budget` light slots over the [first, last) range of light indices by
+// recursively median-splitting the lights along their largest spatial extent (an implicit
+// BVH over the light positions) and sharing the budget between the two halves
+// proportionally to their summed perceived contribution. Rejected indices get their
+// distance set to +inf, so a subsequent sort by distance pushes them past the budget.
+// This guarantees every significant cluster keeps its most relevant lights, where a plain
+// nearest-N cut can starve an entire distant lit area (e.g. a far shoreline of small
+// lights behind thousands of nearby ones).
+static void distributeLightBudget(uint32_t* const first, uint32_t* const last,
+        size_t const budget,
+        float4 const* const UTILS_RESTRICT spheres,
+        float const* const UTILS_RESTRICT contributions,
+        float* const UTILS_RESTRICT distances) noexcept {
+    size_t const count = size_t(last - first);
+    if (count <= budget) {
+        return;
+    }
+    if (budget == 0) {
+        for (uint32_t const* p = first; p != last; ++p) {
+            distances[*p] = std::numeric_limits<float>::infinity();
+        }
+        return;
+    }
+
+    // at the leaves, keep the largest contributors of the cluster
+    constexpr size_t LEAF_LIGHT_COUNT = 16;
+    if (count <= LEAF_LIGHT_COUNT) {
+        std::nth_element(first, first + budget, last,
+                [contributions](uint32_t const lhs, uint32_t const rhs) {
+                    return contributions[lhs] > contributions[rhs];
+                });
+        for (uint32_t const* p = first + budget; p != last; ++p) {
+            distances[*p] = std::numeric_limits<float>::infinity();
+        }
+        return;
+    }
+
+    // split at the spatial median of the largest axis
+    float3 lo = std::numeric_limits<float>::max();
+    float3 hi = std::numeric_limits<float>::lowest();
+    for (uint32_t const* p = first; p != last; ++p) {
+        lo = min(lo, spheres[*p].xyz);
+        hi = max(hi, spheres[*p].xyz);
+    }
+    float3 const extent = hi - lo;
+    size_t const axis = (extent.x >= extent.y)
+            ? (extent.x >= extent.z ? 0 : 2) : (extent.y >= extent.z ? 1 : 2);
+
+    uint32_t* const mid = first + count / 2;
+    std::nth_element(first, mid, last,
+            [spheres, axis](uint32_t const lhs, uint32_t const rhs) {
+                return spheres[lhs].xyz[axis] < spheres[rhs].xyz[axis];
+            });
+
+    double sumLeft = 0.0;
+    for (uint32_t const* p = first; p != mid; ++p) {
+        sumLeft += contributions[*p];
+    }
+    double sumRight = 0.0;
+    for (uint32_t const* p = mid; p != last; ++p) {
+        sumRight += contributions[*p];
+    }
+
+    double const total = sumLeft + sumRight;
+    size_t budgetLeft = (total > 0.0)
+            ? size_t(double(budget) * (sumLeft / total) + 0.5)
+            : budget * size_t(mid - first) / count;
+    budgetLeft = std::min(budgetLeft, budget);
+    // a non-empty half always keeps at least one light, so no cluster disappears entirely
+    if (budgetLeft == 0 && sumLeft > 0.0) {
+        budgetLeft = 1;
+    } else if (budgetLeft == budget && sumRight > 0.0) {
+        budgetLeft = budget - 1;
+    }
+
+    distributeLightBudget(first, mid, budgetLeft, spheres, contributions, distances);
+    distributeLightBudget(mid, last, budget - budgetLeft, spheres, contributions, distances);
+}
+
 void FView::prepareVisibleLights(FLightManager const& lcm,
         Slice<float> scratch,
         mat4f const& viewMatrix, Frustum const& frustum,
@@ -1103,9 +1563,9 @@ void FView::prepareVisibleLights(FLightManager const& lcm,
      *
      * We always sort lights by distance to the camera so that:
      * - we can build light trees later
-     * - lights farther from the camera are dropped when in excess
-     *   Note this doesn't always work well, e.g. for search-lights, we might need to also
-     *   take the radius into account.
+     * - lights farther from the camera are dropped when in excess; when that happens the
+     *   cut is refined below by distributing the slots over a light hierarchy, so bright
+     *   or isolated distant clusters are not starved by nearby lights.
      * - This helps our limited numbers of spot-shadow as well.
      */
 
@@ -1123,6 +1583,26 @@ void FView::prepareVisibleLights(FLightManager const& lcm,
         Zip2Iterator<FScene::LightSoa::iterator, float*> b = { lightData.begin(), distances };
         std::sort(b + FScene::DIRECTIONAL_LIGHTS_COUNT, b + visibleLightCount,
                 [](auto const& lhs, auto const& rhs) { return lhs.second < rhs.second; });
+
+        if (UTILS_UNLIKELY(positionalLightCount > CONFIG_MAX_LIGHT_COUNT)) {
+            // More visible lights than the GPU buffer can hold. Instead of simply keeping
+            // the CONFIG_MAX_LIGHT_COUNT nearest lights, distribute the slots over a spatial
+            // hierarchy of the lights weighted by their perceived contribution, then re-sort
+            // so the selected lights land in the front in distance order.
+            auto indices = FixedCapacityVector<uint32_t>::with_capacity(positionalLightCount);
+            auto contributions = FixedCapacityVector<float>::with_capacity(positionalLightCount);
+            for (size_t i = FScene::DIRECTIONAL_LIGHTS_COUNT; i < visibleLightCount; i++) {
+                indices.push_back(uint32_t(i));
+                // an estimate of the light's illuminance at the camera
+                float const d = std::max(0.0f, distances[i] - spheres[i].w);
+                contributions.push_back(
+                        lcm.getIntensity(instanceArray[i]) / (1.0f + d * d));
+            }
+            distributeLightBudget(indices.begin(), indices.end(), CONFIG_MAX_LIGHT_COUNT,
+                    spheres, contributions.data(), distances);
+            std::sort(b + FScene::DIRECTIONAL_LIGHTS_COUNT, b + visibleLightCount,
+                    [](auto const& lhs, auto const& rhs) { return lhs.second < rhs.second; });
+        }
     }
 
     // drop excess lights
@@ -1150,11 +1630,35 @@ inline void FView::computeLightCameraDistances(
 }
 
 void FView::updatePrimitivesLod(FScene::RenderableSoa& renderableData,
-        FEngine const& engine, CameraInfo const&, Range visible) noexcept {
+        FEngine const& engine, CameraInfo const& camera, Range visible) noexcept {
     FRenderableManager const& rcm = engine.getRenderableManager();
+    float3 const cameraPosition = camera.getPosition();
+    // projection[1][1] is the cotangent of the half vertical fov for a perspective
+    // projection, or the inverse of the half viewport height for an orthographic one
+    float const yScale = camera.projection[1][1];
+    bool const isPerspective = camera.projection[2][3] != 0.0f;
     for (uint32_t const index : visible) {
-        uint8_t const level = 0; // TODO: pick the proper level of detail
         auto ri = renderableData.elementAt<FScene::RENDERABLE_INSTANCE>(index);
+        uint8_t level = 0;
+        auto const lods = rcm.getLods(ri);
+        if (UTILS_UNLIKELY(lods.count > 1)) {
+            // estimate the screen coverage of this renderable as the ratio of its projected
+            // bounding sphere's diameter to the viewport height (see Builder::lodThreshold)
+            float const radius =
+                    length(renderableData.elementAt<FScene::WORLD_AABB_EXTENT>(index));
+            float coverage = radius * yScale;
+            if (isPerspective) {
+                float3 const center =
+                        renderableData.elementAt<FScene::WORLD_AABB_CENTER>(index);
+                float const distance =
+                        std::max(camera.zn, length(center - cameraPosition));
+                coverage = coverage / distance;
+            }
+            coverage = std::min(coverage, 1.0f);
+            while (level < lods.count - 1 && coverage < lods.thresholds[level]) {
+                level++;
+            }
+        }
         renderableData.elementAt<FScene::PRIMITIVES>(index) = rcm.getRenderPrimitives(ri, level);
     }
 }
@@ -1193,15 +1697,15 @@ void FView::clearFrameHistory(FEngine& engine) noexcept {
 void FView::executePickingQueries(DriverApi& driver,
         RenderTargetHandle handle, float2 const scale) noexcept {
 
-    while (mActivePickingQueriesList) {
-        FPickingQuery* const pQuery = mActivePickingQueriesList;
-        mActivePickingQueriesList = pQuery->next;
+    if (UTILS_UNLIKELY(driver.getFeatureLevel() == FeatureLevel::FEATURE_LEVEL_0)) {
+        while (mActivePickingQueriesList) {
+            FPickingQuery* const pQuery = mActivePickingQueriesList;
+            mActivePickingQueriesList = pQuery->next;
 
-        // adjust for dynamic resolution and structure buffer scale
-        const uint32_t x = uint32_t(float(pQuery->x) * scale.x);
-        const uint32_t y = uint32_t(float(pQuery->y) * scale.y);
+            // adjust for dynamic resolution and structure buffer scale
+            const uint32_t x = uint32_t(float(pQuery->x) * scale.x);
+            const uint32_t y = uint32_t(float(pQuery->y) * scale.y);
 
-        if (UTILS_UNLIKELY(driver.getFeatureLevel() == FeatureLevel::FEATURE_LEVEL_0)) {
             driver.readPixels(handle, x, y, 1, 1, {
                     &pQuery->result.reserved1, 4u, // 4
                     PixelDataFormat::RGBA, PixelDataType::UBYTE,
@@ -1223,8 +1727,41 @@ void FView::executePickingQueries(DriverApi& driver,
                         FPickingQuery::put(pQuery);
                     }, pQuery
             });
-        } else {
-            driver.readPixels(handle, x, y, 1, 1, {
+        }
+        return;
+    }
+
+    while (mActivePickingQueriesList) {
+        // extract all queries sharing the first query's handler, so the batch's completion
+        // callback can invoke them in the handler context they asked for
+        CallbackHandler* const handler = mActivePickingQueriesList->handler;
+        FPickingQuery* batchList = nullptr;
+        uint32_t minX = std::numeric_limits<uint32_t>::max(), minY = minX;
+        uint32_t maxX = 0, maxY = 0;
+        for (FPickingQuery** prev = &mActivePickingQueriesList; *prev; ) {
+            FPickingQuery* const pQuery = *prev;
+            if (pQuery->handler == handler) {
+                *prev = pQuery->next;
+                pQuery->next = batchList;
+                batchList = pQuery;
+                // adjust for dynamic resolution and structure buffer scale
+                const uint32_t x = uint32_t(float(pQuery->x) * scale.x);
+                const uint32_t y = uint32_t(float(pQuery->y) * scale.y);
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+            } else {
+                prev = &pQuery->next;
+            }
+        }
+
+        assert_invariant(batchList);
+
+        if (!batchList->next) {
+            // single query, read the pixel directly into the query -- no staging needed
+            FPickingQuery* const pQuery = batchList;
+            driver.readPixels(handle, minX, minY, 1, 1, {
                     &pQuery->result.renderable, 4u * 4u, // 4*float
                     PixelDataFormat::RG, PixelDataType::FLOAT,
                     pQuery->handler, [](void*, size_t, void* user) {
@@ -1236,7 +1773,52 @@ void FView::executePickingQueries(DriverApi& driver,
                         FPickingQuery::put(pQuery);
                     }, pQuery
             });
+            continue;
+        }
+
+        // coalesce the batch into a single readback of the queries' bounding rectangle;
+        // a marquee selection spanning the viewport naturally degenerates to a whole-buffer
+        // id readback
+        uint32_t const width  = maxX - minX + 1u;
+        uint32_t const height = maxY - minY + 1u;
+        FPickingQueryBatch* const batch =
+                FPickingQueryBatch::get(minX, minY, width, height, scale);
+        if (UTILS_UNLIKELY(!batch)) {
+            // allocation failed, deliver empty results
+            while (batchList) {
+                FPickingQuery* const pQuery = batchList;
+                batchList = pQuery->next;
+                pQuery->callback(pQuery->result, pQuery);
+                FPickingQuery::put(pQuery);
+            }
+            continue;
         }
+        batch->queries = batchList;
+
+        driver.readPixels(handle, minX, minY, width, height, {
+                batch->storage.data(), batch->storage.size() * sizeof(float),
+                PixelDataFormat::RG, PixelDataType::FLOAT,
+                handler, [](void*, size_t, void* user) {
+                    FPickingQueryBatch* const batch = static_cast<FPickingQueryBatch*>(user);
+                    FPickingQuery* pQuery = batch->queries;
+                    while (pQuery) {
+                        FPickingQuery* const next = pQuery->next;
+                        uint32_t const x = uint32_t(float(pQuery->x) * batch->scale.x) - batch->x;
+                        uint32_t const y = uint32_t(float(pQuery->y) * batch->scale.y) - batch->y;
+                        float const* const texel = batch->storage.data()
+                                + 2u * (size_t(y) * batch->width + x);
+                        // same layout as the single-query readback above: R holds the entity
+                        // id bits and G the depth (renderable and depth are adjacent)
+                        memcpy(&pQuery->result.renderable, texel, 2u * sizeof(float));
+                        pQuery->result.fragCoords = {
+                                pQuery->x, pQuery->y, float(1.0 - pQuery->result.depth) };
+                        pQuery->callback(pQuery->result, pQuery);
+                        FPickingQuery::put(pQuery);
+                        pQuery = next;
+                    }
+                    FPickingQueryBatch::put(batch);
+                }, batch
+        });
     }
 }
 
@@ -1252,6 +1834,7 @@ void FView::clearPickingQueries() noexcept {
 void FView::setTemporalAntiAliasingOptions(TemporalAntiAliasingOptions options) noexcept {
     options.feedback = clamp(options.feedback, 0.0f, 1.0f);
     options.filterWidth = std::max(0.2f, options.filterWidth); // below 0.2 causes issues
+    options.upscalingFactor = clamp(options.upscalingFactor, 1.0f, 2.0f);
     mTemporalAntiAliasingOptions = options;
 }
 
@@ -1337,6 +1920,63 @@ void FView::setVignetteOptions(VignetteOptions options) noexcept {
     mVignetteOptions = options;
 }
 
+void FView::declareDamageRegion(filament::Viewport const& damage) noexcept {
+    if (!mHasDamageRegion) {
+        mDamageRegion = damage;
+        mHasDamageRegion = true;
+    } else {
+        // merge into the bounding rectangle
+        int32_t const l = std::min(mDamageRegion.left, damage.left);
+        int32_t const b = std::min(mDamageRegion.bottom, damage.bottom);
+        int32_t const r = std::max(mDamageRegion.left + int32_t(mDamageRegion.width),
+                damage.left + int32_t(damage.width));
+        int32_t const t = std::max(mDamageRegion.bottom + int32_t(mDamageRegion.height),
+                damage.bottom + int32_t(damage.height));
+        mDamageRegion = filament::Viewport{ l, b, uint32_t(r - l), uint32_t(t - b) };
+    }
+}
+
+std::shared_ptr<std::atomic<float>> const& FView::getAutoExposureResult() noexcept {
+    if (UTILS_UNLIKELY(!mAutoExposureMetered)) {
+        mAutoExposureMetered = std::make_shared<std::atomic<float>>(
+                std::numeric_limits<float>::quiet_NaN());
+    }
+    return mAutoExposureMetered;
+}
+
+float FView::updateAutoExposure(float const cameraEv100) noexcept {
+    using clock = std::chrono::steady_clock;
+    auto const now = clock::now();
+    float const dt = mAutoExposureLastUpdate == clock::time_point{} ? 0.0f :
+            std::chrono::duration<float>(now - mAutoExposureLastUpdate).count();
+    mAutoExposureLastUpdate = now;
+
+    float const metered = mAutoExposureMetered ?
+            mAutoExposureMetered->load(std::memory_order_relaxed) :
+            std::numeric_limits<float>::quiet_NaN();
+    if (std::isnan(metered)) {
+        // no metering result yet, render with the camera's exposure
+        return cameraEv100;
+    }
+
+    AutoExposureOptions const& options = mAutoExposureOptions;
+    float const current = mAutoExposureValid ? mAutoExposureAdaptedEv100 : cameraEv100;
+
+    // The color buffer is pre-exposed, so the metered log2 average luminance is relative to
+    // the exposure the metered frame was rendered with; adding the current adapted value back
+    // recovers the scene's EV100 (the 1.2 factor and 100/12.5 calibration come from
+    // Exposure::exposure()). This is a feedback loop, which the smoothing below keeps stable.
+    float const target = clamp(
+            metered + current + std::log2(1.2f) + 3.0f - options.compensation,
+            options.minEv100, options.maxEv100);
+
+    float const rate = target > current ? options.speedUp : options.speedDown;
+    float const a = 1.0f - std::exp(-dt * rate);
+    mAutoExposureAdaptedEv100 = mAutoExposureValid ? current + (target - current) * a : target;
+    mAutoExposureValid = true;
+    return mAutoExposureAdaptedEv100;
+}
+
 View::PickingQuery& FView::pick(uint32_t const x, uint32_t const y, CallbackHandler* handler,
         PickingQueryResultCallback const callback) noexcept {
     FPickingQuery* pQuery = FPickingQuery::get(x, y, handler, callback);
@@ -24,6 +24,7 @@
 #include "FrameHistory.h"
 #include "FrameInfo.h"
 #include "Froxelizer.h"
+#include "OcclusionCuller.h"
 #include "PIDController.h"
 #include "ShadowMapManager.h"
 
@@ -56,6 +57,7 @@
 #include <utils/compiler.h>
 #include <utils/Allocator.h>
 #include <utils/Entity.h>
+#include <utils/FixedCapacityVector.h>
 #include <utils/StructureOfArrays.h>
 #include <utils/Range.h>
 #include <utils/Slice.h>
@@ -72,8 +74,11 @@ namespace filament::fgviewer {
 #include <math/mat4.h>
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <new>
+#include <vector>
 
 #include <stddef.h>
 #include <stdint.h>
@@ -111,11 +116,18 @@ public:
 
     CameraInfo computeCameraInfo(FEngine& engine) const noexcept;
 
+    // Same as above, but with a caller-supplied world origin. Used for view groups, where
+    // all views must agree on the world origin (see FRenderer::renderViewGroup()).
+    CameraInfo computeCameraInfo(math::mat4 const& worldTransform) const noexcept;
+
     // note: viewport/cameraInfo are passed by value to make it clear that prepare cannot
     // keep references on them that would outlive the scope of prepare() (e.g. with JobSystem).
+    // reusePreparedScene skips the scene's renderable preparation, which a previous view of
+    // the same view group already did with the same world origin.
     void prepare(FEngine& engine, backend::DriverApi& driver, RootArenaScope& rootArenaScope,
             Viewport viewport, CameraInfo cameraInfo,
-            math::float4 const& userTime, bool needsAlphaChannel) noexcept;
+            math::float4 const& userTime, bool needsAlphaChannel,
+            bool reusePreparedScene = false) noexcept;
 
     void setScene(FScene* scene) { mScene = scene; }
     FScene const* getScene() const noexcept { return mScene; }
@@ -129,6 +141,22 @@ public:
         return mViewport;
     }
 
+    void declareDamageRegion(Viewport const& damage) noexcept;
+
+    bool hasDamageRegion() const noexcept {
+        return mHasDamageRegion;
+    }
+
+    Viewport const& getDamageRegion() const noexcept {
+        return mDamageRegion;
+    }
+
+    // called by FRenderer once the damage has been consumed
+    void clearDamageRegion() noexcept {
+        mHasDamageRegion = false;
+        mDamageRegion = {};
+    }
+
     bool getClearTargetColor() const noexcept {
         // don't clear the color buffer if we have a skybox
         return !isSkyboxVisible();
@@ -138,6 +166,13 @@ public:
     void setFrustumCullingEnabled(bool const culling) noexcept { mCulling = culling; }
     bool isFrustumCullingEnabled() const noexcept { return mCulling; }
 
+    void setContributionCullingThreshold(float const minPixelArea) noexcept {
+        mContributionCullingThreshold = minPixelArea;
+    }
+    float getContributionCullingThreshold() const noexcept {
+        return mContributionCullingThreshold;
+    }
+
     void setFrontFaceWindingInverted(bool const inverted) noexcept { mFrontFaceWindingInverted = inverted; }
     bool isFrontFaceWindingInverted() const noexcept { return mFrontFaceWindingInverted; }
 
@@ -222,6 +257,10 @@ public:
 
     void setScreenSpaceRefractionEnabled(bool const enabled) noexcept { mScreenSpaceRefractionEnabled = enabled; }
 
+    void setDepthPrepassEnabled(bool const enabled) noexcept { mDepthPrepassEnabled = enabled; }
+
+    bool isDepthPrepassEnabled() const noexcept { return mDepthPrepassEnabled; }
+
     bool isScreenSpaceRefractionEnabled() const noexcept { return mScreenSpaceRefractionEnabled; }
 
     bool isScreenSpaceReflectionEnabled() const noexcept { return mScreenSpaceReflectionsOptions.enabled; }
@@ -290,7 +329,9 @@ public:
     }
 
     void setColorGrading(FColorGrading* colorGrading) noexcept {
-        mColorGrading = colorGrading == nullptr ? mDefaultColorGrading : colorGrading;
+        // The new color grading is not used until its LUT is baked; until then the current
+        // one remains active so the switch is hitch-free (see prepare()).
+        mPendingColorGrading = colorGrading == nullptr ? mDefaultColorGrading : colorGrading;
     }
 
     const FColorGrading* getColorGrading() const noexcept {
@@ -324,6 +365,20 @@ public:
         return mDynamicResolution;
     }
 
+    void setAdaptiveQualityOptions(AdaptiveQualityOptions options) noexcept;
+
+    AdaptiveQualityOptions getAdaptiveQualityOptions() const noexcept {
+        return mAdaptiveQualityOptions;
+    }
+
+    // Highest QualityLevel post-processing effects may use this frame, as decided by the
+    // adaptive quality governor (see updateAdaptiveQuality()).
+    QualityLevel getPostProcessQualityCap() const noexcept;
+
+    // Right-shift to apply to ShadowOptions::mapSize this frame, as decided by the adaptive
+    // quality governor (see updateAdaptiveQuality()).
+    uint8_t getShadowMapSizeShift() const noexcept;
+
     void setRenderQuality(RenderQuality const& renderQuality) noexcept {
         mRenderQuality = renderQuality;
     }
@@ -396,6 +451,22 @@ public:
         return mVignetteOptions;
     }
 
+    void setAutoExposureOptions(AutoExposureOptions const options) noexcept {
+        mAutoExposureOptions = options;
+    }
+
+    AutoExposureOptions getAutoExposureOptions() const noexcept {
+        return mAutoExposureOptions;
+    }
+
+    // Destination for the asynchronous metering readback scheduled by
+    // PostProcessManager::autoExposure(). Shared because the readback can outlive this View.
+    std::shared_ptr<std::atomic<float>> const& getAutoExposureResult() noexcept;
+
+    // Advances the temporal adaptation using the latest metering result, and returns the
+    // exposure value (EV100) to render with. Called once per frame by FRenderer.
+    float updateAutoExposure(float cameraEv100) noexcept;
+
     void setBlendMode(BlendMode const blendMode) noexcept {
         mBlendMode = blendMode;
     }
@@ -437,13 +508,19 @@ public:
         }
     }
 
+    // when a SceneBvh matching renderableData is supplied, whole subtrees are accepted or
+    // rejected at once instead of testing every renderable
     static void cullRenderables(utils::JobSystem& js, FScene::RenderableSoa& renderableData,
-            Frustum const& frustum, size_t bit) noexcept;
+            Frustum const& frustum, size_t bit, SceneBvh const* bvh = nullptr) noexcept;
 
     ColorPassDescriptorSet& getColorPassDescriptorSet() const noexcept {
             return mColorPassDescriptorSet[mShadowType == ShadowType::PCF ? 0 : 1];
     }
 
+    // Returns the Hi-Z occlusion culling state. This is used by the FrameGraph to issue
+    // the Hi-Z pyramid readback (see OcclusionCuller).
+    OcclusionCuller& getOcclusionCuller() noexcept { return mOcclusionCuller; }
+
     // Returns the frame history FIFO. This is typically used by the FrameGraph to access
     // previous frame data.
     FrameHistory& getFrameHistory() noexcept { return mFrameHistory; }
@@ -510,9 +587,68 @@ private:
         PickingQueryResult result;
     };
 
+    // Queries issued in the same frame with the same handler are coalesced into a single
+    // region readback covering their bounding rectangle, and demultiplexed to the individual
+    // callbacks when the readback completes (see executePickingQueries()).
+    struct FPickingQueryBatch {
+    private:
+        FPickingQueryBatch(uint32_t const x, uint32_t const y,
+                uint32_t const width, uint32_t const height, math::float2 const scale) noexcept
+                : x(x), y(y), width(width), height(height), scale(scale),
+                  storage(size_t(width) * height * 2u) {}
+        ~FPickingQueryBatch() noexcept = default;
+    public:
+        static FPickingQueryBatch* get(uint32_t const x, uint32_t const y,
+                uint32_t const width, uint32_t const height, math::float2 const scale) noexcept {
+            return new(std::nothrow) FPickingQueryBatch(x, y, width, height, scale);
+        }
+        static void put(FPickingQueryBatch* batch) noexcept {
+            delete batch;
+        }
+        FPickingQuery* queries = nullptr;
+        // readback region in structure-buffer coordinates
+        uint32_t const x;
+        uint32_t const y;
+        uint32_t const width;
+        uint32_t const height;
+        math::float2 const scale;
+        // staging for the RG32F readback, lives until the readback completes
+        utils::FixedCapacityVector<float> storage;
+    };
+
     void prepareVisibleRenderables(utils::JobSystem& js,
             Frustum const& frustum, FScene::RenderableSoa& renderableData) const noexcept;
 
+    // Temporal (cross-frame) version of cullRenderables() used for the main camera.
+    // Reuses last frame's per-renderable result when the camera and the renderable
+    // moved by less than the renderable's distance to the closest culling plane.
+    void cullRenderablesTemporal(FScene::RenderableSoa& renderableData,
+            Frustum const& frustum) const noexcept;
+
+    // Clears the VISIBLE_RENDERABLE bit of renderables hidden behind last frame's
+    // occluders (conservative, see OcclusionCuller).
+    void cullRenderablesOccluded(FScene::RenderableSoa& renderableData) const noexcept;
+
+    // With instanced stereo, sets one VISIBLE_EYE bit per eye whose frustum intersects the
+    // renderable, and clears the VISIBLE_RENDERABLE bit of renderables visible to no eye.
+    static void cullRenderablesPerEye(FScene::RenderableSoa& renderableData,
+            CameraInfo const& cameraInfo, size_t eyeCount) noexcept;
+
+    // Contribution culling: clears the VISIBLE_RENDERABLE bit of renderables whose
+    // projected bounding sphere covers less than minPixelArea pixels.
+    static void cullRenderablesContribution(FScene::RenderableSoa& renderableData,
+            CameraInfo const& cameraInfo, Viewport const& viewport,
+            float minPixelArea) noexcept;
+
+    // Closed-loop quality governor: steps mAdaptiveQualityLevel up or down, with hysteresis,
+    // based on the measured frame time. Called once per frame from updateScale().
+    void updateAdaptiveQuality(details::FrameInfo const& info,
+            float targetMilliseconds) noexcept;
+
+    // Number of degradation steps (0..2) currently applied to the given quality axis, given
+    // mAdaptiveQualityLevel and the user-ranked axis priorities.
+    uint8_t getAxisDegradation(AdaptiveQualityOptions::Axis axis) const noexcept;
+
     static void prepareVisibleLights(FLightManager const& lcm,
             utils::Slice<float> scratch,
             math::mat4f const& viewMatrix, Frustum const& frustum,
@@ -537,6 +673,7 @@ private:
     // these are accessed in the render loop, keep together
     backend::Handle<backend::HwBufferObject> mLightUbh;
     backend::Handle<backend::HwBufferObject> mRenderableUbh;
+    FScene::RenderableUboCache mRenderableUboCache;
     DescriptorSet mCommonRenderableDescriptorSet;
 
     FScene* mScene = nullptr;
@@ -548,10 +685,30 @@ private:
     mutable Froxelizer mFroxelizer;
     utils::JobSystem::Job* mFroxelizerSync = nullptr;
 
+    // Cross-frame visibility cache for cullRenderablesTemporal(). For each renderable we
+    // keep the signed "slack" of the last full frustum test: the distance to the closest
+    // culling plane, negative when culled. As long as the accumulated camera and renderable
+    // motion stays below that slack, last frame's result is still valid and the six-plane
+    // test can be skipped. The cache is discarded whenever the renderable list changes.
+    struct TemporalVisibility {
+        bool valid = false;
+        math::float4 planes[6] = {};
+        std::vector<utils::EntityInstance<RenderableManager>> instances;
+        std::vector<math::float3> centers;
+        std::vector<math::float3> extents;
+        std::vector<float> slack;
+    };
+    mutable TemporalVisibility mTemporalVisibility;
+
+    // Hi-Z occlusion culling state (enabled with d.view.occlusion_culling)
+    mutable OcclusionCuller mOcclusionCuller;
+
     Viewport mViewport;
     bool mCulling = true;
+    float mContributionCullingThreshold = 0.0f; // in pixels of covered area, 0 disables
     bool mFrontFaceWindingInverted = false;
     bool mIsTransparentPickingEnabled = false;
+    bool mDepthPrepassEnabled = false;
 
     FRenderTarget* mRenderTarget = nullptr;
 
@@ -570,13 +727,26 @@ private:
     FogOptions mFogOptions;
     DepthOfFieldOptions mDepthOfFieldOptions;
     VignetteOptions mVignetteOptions;
+    AutoExposureOptions mAutoExposureOptions;
     TemporalAntiAliasingOptions mTemporalAntiAliasingOptions;
     MultiSampleAntiAliasingOptions mMultiSampleAntiAliasingOptions;
     ScreenSpaceReflectionsOptions mScreenSpaceReflectionsOptions;
     GuardBandOptions mGuardBandOptions;
     StereoscopicOptions mStereoscopicOptions;
     BlendMode mBlendMode = BlendMode::OPAQUE;
+
+    // per-frame damage declared with declareDamageRegion(), consumed by FRenderer
+    Viewport mDamageRegion{};
+    bool mHasDamageRegion = false;
+
+    // auto-exposure adaptation state, see updateAutoExposure()
+    std::shared_ptr<std::atomic<float>> mAutoExposureMetered;
+    std::chrono::steady_clock::time_point mAutoExposureLastUpdate{};
+    float mAutoExposureAdaptedEv100 = 0.0f;
+    bool mAutoExposureValid = false;
+
     const FColorGrading* mColorGrading = nullptr;
+    const FColorGrading* mPendingColorGrading = nullptr;
     const FColorGrading* mDefaultColorGrading = nullptr;
     utils::Entity mFogEntity{};
     bool mIsStereoSupported : 1;
@@ -586,6 +756,12 @@ private:
     math::float2 mScale = 1.0f;
     bool mIsDynamicResolutionSupported = false;
 
+    // adaptive quality governor (see updateAdaptiveQuality())
+    AdaptiveQualityOptions mAdaptiveQualityOptions;
+    uint8_t mAdaptiveQualityLevel = 0;      // current number of degradation steps applied
+    uint16_t mOverBudgetFrameCount = 0;     // consecutive frames over the frame budget
+    uint16_t mUnderBudgetFrameCount = 0;    // consecutive frames with restore headroom
+
     RenderQuality mRenderQuality;
 
     mutable TypedUniformBuffer<PerViewUib> mUniforms;
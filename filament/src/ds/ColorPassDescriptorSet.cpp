@@ -151,17 +151,16 @@ void ColorPassDescriptorSet::prepareCamera(FEngine& engine, const CameraInfo& ca
     const mat4f viewFromClip{ inverse((mat4)camera.projection) };
     const mat4f worldFromClip{ highPrecisionMultiply(worldFromView, viewFromClip) };
 
-    auto& s = mUniforms.edit();
-    s.viewFromWorldMatrix = viewFromWorld;    // view
-    s.worldFromViewMatrix = worldFromView;    // model
-    s.clipFromViewMatrix  = clipFromView;     // projection
-    s.viewFromClipMatrix  = viewFromClip;     // 1/projection
-    s.worldFromClipMatrix = worldFromClip;    // 1/(projection * view)
-    s.userWorldFromWorldMatrix = mat4f(inverse(camera.worldTransform));
-    s.clipTransform = camera.clipTransform;
-    s.cameraFar = camera.zf;
-    s.oneOverFarMinusNear = 1.0f / (camera.zf - camera.zn);
-    s.nearOverFarMinusNear = camera.zn / (camera.zf - camera.zn);
+    setUniform(&PerViewUib::viewFromWorldMatrix, viewFromWorld);    // view
+    setUniform(&PerViewUib::worldFromViewMatrix, worldFromView);    // model
+    setUniform(&PerViewUib::clipFromViewMatrix,  clipFromView);     // projection
+    setUniform(&PerViewUib::viewFromClipMatrix,  viewFromClip);     // 1/projection
+    setUniform(&PerViewUib::worldFromClipMatrix, worldFromClip);    // 1/(projection * view)
+    setUniform(&PerViewUib::userWorldFromWorldMatrix, mat4f(inverse(camera.worldTransform)));
+    setUniform(&PerViewUib::clipTransform, camera.clipTransform);
+    setUniform(&PerViewUib::cameraFar, camera.zf);
+    setUniform(&PerViewUib::oneOverFarMinusNear, 1.0f / (camera.zf - camera.zn));
+    setUniform(&PerViewUib::nearOverFarMinusNear, camera.zn / (camera.zf - camera.zn));
 
     mat4f const& headFromWorld = camera.view;
     Engine::Config const& config = engine.getConfig();
@@ -169,26 +168,23 @@ void ColorPassDescriptorSet::prepareCamera(FEngine& engine, const CameraInfo& ca
         mat4f const& eyeFromHead = camera.eyeFromView[i];   // identity for monoscopic rendering
         mat4f const& clipFromEye = camera.eyeProjection[i];
         // clipFromEye * eyeFromHead * headFromWorld
-        s.clipFromWorldMatrix[i] = highPrecisionMultiply(
-                clipFromEye, highPrecisionMultiply(eyeFromHead, headFromWorld));
+        setUniform(&PerViewUib::clipFromWorldMatrix, i, highPrecisionMultiply(
+                clipFromEye, highPrecisionMultiply(eyeFromHead, headFromWorld)));
     }
 
     // with a clip-space of [-w, w] ==> z' = -z
     // with a clip-space of [0,  w] ==> z' = (w - z)/2
-    s.clipControl = engine.getDriverApi().getClipSpaceParams();
+    setUniform(&PerViewUib::clipControl, engine.getDriverApi().getClipSpaceParams());
 }
 
 void ColorPassDescriptorSet::prepareLodBias(float const bias, float2 const derivativesScale) noexcept {
-    auto& s = mUniforms.edit();
-    s.lodBias = bias;
-    s.derivativesScale = derivativesScale;
+    setUniform(&PerViewUib::lodBias, bias);
+    setUniform(&PerViewUib::derivativesScale, derivativesScale);
 }
 
 void ColorPassDescriptorSet::prepareExposure(float const ev100) noexcept {
-    const float exposure = Exposure::exposure(ev100);
-    auto& s = mUniforms.edit();
-    s.exposure = exposure;
-    s.ev100 = ev100;
+    setUniform(&PerViewUib::exposure, Exposure::exposure(ev100));
+    setUniform(&PerViewUib::ev100, ev100);
 }
 
 void ColorPassDescriptorSet::prepareViewport(
@@ -198,26 +194,23 @@ void ColorPassDescriptorSet::prepareViewport(
                            physicalViewport.width, physicalViewport.height };
     float4 const logical{ logicalViewport.left, logicalViewport.bottom,
                           logicalViewport.width, logicalViewport.height };
-    auto& s = mUniforms.edit();
-    s.resolution = { physical.zw, 1.0f / physical.zw };
-    s.logicalViewportScale = physical.zw / logical.zw;
-    s.logicalViewportOffset = -logical.xy / logical.zw;
+    setUniform(&PerViewUib::resolution, { physical.zw, 1.0f / physical.zw });
+    setUniform(&PerViewUib::logicalViewportScale, physical.zw / logical.zw);
+    setUniform(&PerViewUib::logicalViewportOffset, -logical.xy / logical.zw);
 }
 
 void ColorPassDescriptorSet::prepareTime(FEngine& engine, float4 const& userTime) noexcept {
-    auto& s = mUniforms.edit();
     const uint64_t oneSecondRemainder = engine.getEngineTime().count() % 1000000000;
     const float fraction = float(double(oneSecondRemainder) / 1000000000.0);
-    s.time = fraction;
-    s.userTime = userTime;
+    setUniform(&PerViewUib::time, fraction);
+    setUniform(&PerViewUib::userTime, userTime);
 }
 
 void ColorPassDescriptorSet::prepareTemporalNoise(FEngine& engine,
         TemporalAntiAliasingOptions const& options) noexcept {
     std::uniform_real_distribution<float> uniformDistribution{ 0.0f, 1.0f };
-    auto& s = mUniforms.edit();
     const float temporalNoise = uniformDistribution(engine.getRandomEngine());
-    s.temporalNoise = options.enabled ? temporalNoise : 0.0f;
+    setUniform(&PerViewUib::temporalNoise, options.enabled ? temporalNoise : 0.0f);
 }
 
 void ColorPassDescriptorSet::prepareFog(FEngine& engine, const CameraInfo& cameraInfo,
@@ -250,17 +243,15 @@ void ColorPassDescriptorSet::prepareFog(FEngine& engine, const CameraInfo& camer
     // precalculate the constant part of density integral
     const float density = -float(heightFalloff * (userCameraPosition.y - options.height));
 
-    auto& s = mUniforms.edit();
-
     // note: this code is written so that near/far/minLod/maxLod could be user settable
     //       currently they're inferred.
     Handle<HwTexture> fogColorTextureHandle;
     if (options.skyColor) {
         fogColorTextureHandle = downcast(options.skyColor)->getHwHandleForSampling();
         half2 const minMaxMip{ 0.0f, float(options.skyColor->getLevels()) - 1.0f };
-        s.fogMinMaxMip = packHalf2x16(minMaxMip);
-        s.fogOneOverFarMinusNear = 1.0f / (cameraInfo.zf - cameraInfo.zn);
-        s.fogNearOverFarMinusNear = cameraInfo.zn / (cameraInfo.zf - cameraInfo.zn);
+        setUniform(&PerViewUib::fogMinMaxMip, packHalf2x16(minMaxMip));
+        setUniform(&PerViewUib::fogOneOverFarMinusNear, 1.0f / (cameraInfo.zf - cameraInfo.zn));
+        setUniform(&PerViewUib::fogNearOverFarMinusNear, cameraInfo.zn / (cameraInfo.zf - cameraInfo.zn));
     }
     if (!fogColorTextureHandle && options.fogColorFromIbl) {
         if (ibl) {
@@ -272,9 +263,9 @@ void ColorPassDescriptorSet::prepareFog(FEngine& engine, const CameraInfo& camer
             fogColorTextureHandle = ibl->getReflectionHwHandle();
             float const levelCount = float(ibl->getLevelCount());
             half2 const minMaxMip{ levelCount - 2.0f, levelCount - 1.0f };
-            s.fogMinMaxMip = packHalf2x16(minMaxMip);
-            s.fogOneOverFarMinusNear = 1.0f / (cameraInfo.zf - cameraInfo.zn);
-            s.fogNearOverFarMinusNear = cameraInfo.zn / (cameraInfo.zf - cameraInfo.zn);
+            setUniform(&PerViewUib::fogMinMaxMip, packHalf2x16(minMaxMip));
+            setUniform(&PerViewUib::fogOneOverFarMinusNear, 1.0f / (cameraInfo.zf - cameraInfo.zn));
+            setUniform(&PerViewUib::fogNearOverFarMinusNear, cameraInfo.zn / (cameraInfo.zf - cameraInfo.zn));
         }
     }
 
@@ -285,16 +276,16 @@ void ColorPassDescriptorSet::prepareFog(FEngine& engine, const CameraInfo& camer
                     .filterMin = SamplerMinFilter::LINEAR_MIPMAP_LINEAR
             });
 
-    s.fogStart             = options.distance;
-    s.fogMaxOpacity        = options.maximumOpacity;
-    s.fogHeightFalloff     = heightFalloff;
-    s.fogCutOffDistance    = options.cutOffDistance;
-    s.fogColor             = options.color;
-    s.fogDensity           = { options.density, density, options.density * std::exp(density) };
-    s.fogInscatteringStart = options.inScatteringStart;
-    s.fogInscatteringSize  = options.inScatteringSize;
-    s.fogColorFromIbl      = fogColorTextureHandle ? 1.0f : 0.0f;
-    s.fogFromWorldMatrix   = mat3f{ cof(fogFromWorld) };
+    setUniform(&PerViewUib::fogStart,             options.distance);
+    setUniform(&PerViewUib::fogMaxOpacity,        options.maximumOpacity);
+    setUniform(&PerViewUib::fogHeightFalloff,     heightFalloff);
+    setUniform(&PerViewUib::fogCutOffDistance,    options.cutOffDistance);
+    setUniform(&PerViewUib::fogColor,             options.color);
+    setUniform(&PerViewUib::fogDensity,           { options.density, density, options.density * std::exp(density) });
+    setUniform(&PerViewUib::fogInscatteringStart, options.inScatteringStart);
+    setUniform(&PerViewUib::fogInscatteringSize,  options.inScatteringSize);
+    setUniform(&PerViewUib::fogColorFromIbl,      fogColorTextureHandle ? 1.0f : 0.0f);
+    setUniform(&PerViewUib::fogFromWorldMatrix,   mat3f{ cof(fogFromWorld) });
 }
 
 void ColorPassDescriptorSet::prepareSSAO(Handle<HwTexture> ssao,
@@ -312,22 +303,20 @@ void ColorPassDescriptorSet::prepareSSAO(Handle<HwTexture> ssao,
     });
 
     const float edgeDistance = 1.0f / options.bilateralThreshold;
-    auto& s = mUniforms.edit();
-    s.aoSamplingQualityAndEdgeDistance =
-            options.enabled ? (highQualitySampling ? edgeDistance : 0.0f) : -1.0f;
-    s.aoBentNormals = options.enabled && options.bentNormals ? 1.0f : 0.0f;
+    setUniform(&PerViewUib::aoSamplingQualityAndEdgeDistance,
+            options.enabled ? (highQualitySampling ? edgeDistance : 0.0f) : -1.0f);
+    setUniform(&PerViewUib::aoBentNormals, options.enabled && options.bentNormals ? 1.0f : 0.0f);
 }
 
 void ColorPassDescriptorSet::prepareBlending(bool const needsAlphaChannel) noexcept {
-    mUniforms.edit().needsAlphaChannel = needsAlphaChannel ? 1.0f : 0.0f;
+    setUniform(&PerViewUib::needsAlphaChannel, needsAlphaChannel ? 1.0f : 0.0f);
 }
 
 void ColorPassDescriptorSet::prepareMaterialGlobals(
         std::array<float4, 4> const& materialGlobals) noexcept {
-    mUniforms.edit().custom[0] = materialGlobals[0];
-    mUniforms.edit().custom[1] = materialGlobals[1];
-    mUniforms.edit().custom[2] = materialGlobals[2];
-    mUniforms.edit().custom[3] = materialGlobals[3];
+    for (size_t i = 0; i < materialGlobals.size(); i++) {
+        setUniform(&PerViewUib::custom, i, materialGlobals[i]);
+    }
 }
 
 void ColorPassDescriptorSet::prepareSSR(Handle<HwTexture> ssr,
@@ -340,9 +329,9 @@ void ColorPassDescriptorSet::prepareSSR(Handle<HwTexture> ssr,
         .filterMin = SamplerMinFilter::LINEAR_MIPMAP_LINEAR
     });
 
-    auto& s = mUniforms.edit();
-    s.refractionLodOffset = refractionLodOffset;
-    s.ssrDistance = (ssrOptions.enabled && !disableSSR) ? ssrOptions.maxDistance : 0.0f;
+    setUniform(&PerViewUib::refractionLodOffset, refractionLodOffset);
+    setUniform(&PerViewUib::ssrDistance,
+            (ssrOptions.enabled && !disableSSR) ? ssrOptions.maxDistance : 0.0f);
 }
 
 void ColorPassDescriptorSet::prepareHistorySSR(Handle<HwTexture> ssr,
@@ -355,13 +344,15 @@ void ColorPassDescriptorSet::prepareHistorySSR(Handle<HwTexture> ssr,
         .filterMin = SamplerMinFilter::LINEAR
     });
 
-    auto& s = mUniforms.edit();
-    s.ssrReprojection = historyProjection;
-    s.ssrUvFromViewMatrix = uvFromViewMatrix;
-    s.ssrThickness = ssrOptions.thickness;
-    s.ssrBias = ssrOptions.bias;
-    s.ssrDistance = ssrOptions.enabled ? ssrOptions.maxDistance : 0.0f;
-    s.ssrStride = ssrOptions.stride;
+    setUniform(&PerViewUib::ssrReprojection, historyProjection);
+    setUniform(&PerViewUib::ssrUvFromViewMatrix, uvFromViewMatrix);
+    setUniform(&PerViewUib::ssrThickness, ssrOptions.thickness);
+    setUniform(&PerViewUib::ssrBias, ssrOptions.bias);
+    setUniform(&PerViewUib::ssrDistance, ssrOptions.enabled ? ssrOptions.maxDistance : 0.0f);
+    setUniform(&PerViewUib::ssrStride, ssrOptions.stride);
+    // the color-pass SSR variant always traces at full rate
+    setUniform(&PerViewUib::ssrTracePattern, 0);
+    setUniform(&PerViewUib::ssrHistoryWeight, 0.0f);
 }
 
 void ColorPassDescriptorSet::prepareStructure(Handle<HwTexture> structure) noexcept {
@@ -374,11 +365,10 @@ void ColorPassDescriptorSet::prepareDirectionalLight(FEngine& engine,
         float3 const& sceneSpaceDirection,
         LightManagerInstance directionalLight) noexcept {
     FLightManager const& lcm = engine.getLightManager();
-    auto& s = mUniforms.edit();
 
     float const shadowFar = lcm.getShadowFar(directionalLight);
-    s.shadowFarAttenuationParams = shadowFar > 0.0f ?
-            0.5f * float2{ 10.0f, 10.0f / (shadowFar * shadowFar) } : float2{ 1.0f, 0.0f };
+    setUniform(&PerViewUib::shadowFarAttenuationParams, shadowFar > 0.0f ?
+            0.5f * float2{ 10.0f, 10.0f / (shadowFar * shadowFar) } : float2{ 1.0f, 0.0f });
 
     const float3 l = -sceneSpaceDirection; // guaranteed normalized
 
@@ -386,9 +376,9 @@ void ColorPassDescriptorSet::prepareDirectionalLight(FEngine& engine,
         const float4 colorIntensity = {
                 lcm.getColor(directionalLight), lcm.getIntensity(directionalLight) * exposure };
 
-        s.lightDirection = l;
-        s.lightColorIntensity = colorIntensity;
-        s.lightChannels = lcm.getLightChannels(directionalLight);
+        setUniform(&PerViewUib::lightDirection, l);
+        setUniform(&PerViewUib::lightColorIntensity, colorIntensity);
+        setUniform(&PerViewUib::lightChannels, lcm.getLightChannels(directionalLight));
 
         const bool isSun = lcm.isSunLight(directionalLight);
         // The last parameter must be < 0.0f for regular directional lights
@@ -404,24 +394,22 @@ void ColorPassDescriptorSet::prepareDirectionalLight(FEngine& engine,
             sun.z = 1.0f / (std::cos(radius * haloSize) - sun.x);
             sun.w = haloFalloff;
         }
-        s.sun = sun;
+        setUniform(&PerViewUib::sun, sun);
     } else {
         // Disable the sun if there's no directional light
-        s.sun = float4{ 0.0f, 0.0f, 0.0f, -1.0f };
+        setUniform(&PerViewUib::sun, float4{ 0.0f, 0.0f, 0.0f, -1.0f });
     }
 }
 
 void ColorPassDescriptorSet::prepareAmbientLight(FEngine& engine, FIndirectLight const& ibl,
         float const intensity, float const exposure) noexcept {
-    auto& s = mUniforms.edit();
-
     // Set up uniforms and sampler for the IBL, guaranteed to be non-null at this point.
-    float const iblRoughnessOneLevel = float(ibl.getLevelCount() - 1);
-    s.iblRoughnessOneLevel = iblRoughnessOneLevel;
-    s.iblLuminance = intensity * exposure;
-    std::transform(ibl.getSH(), ibl.getSH() + 9, s.iblSH, [](float3 const v) {
-        return float4(v, 0.0f);
-    });
+    setUniform(&PerViewUib::iblRoughnessOneLevel, float(ibl.getLevelCount() - 1));
+    setUniform(&PerViewUib::iblLuminance, intensity * exposure);
+    float3 const* const sh = ibl.getSH();
+    for (size_t i = 0; i < 9; i++) {
+        setUniform(&PerViewUib::iblSH, i, float4{ sh[i], 0.0f });
+    }
 
     // We always sample from the reflection texture, so provide a dummy texture if necessary.
     Handle<HwTexture> reflection = ibl.getReflectionHwHandle();
@@ -436,6 +424,8 @@ void ColorPassDescriptorSet::prepareAmbientLight(FEngine& engine, FIndirectLight
 }
 
 void ColorPassDescriptorSet::prepareDynamicLights(Froxelizer& froxelizer) noexcept {
+    // we're only called when the froxelization parameters changed (see FView::prepare),
+    // so writing through edit() unconditionally is fine here
     auto& s = mUniforms.edit();
     froxelizer.updateUniforms(s);
     float const f = froxelizer.getLightFar();
@@ -444,19 +434,18 @@ void ColorPassDescriptorSet::prepareDynamicLights(Froxelizer& froxelizer) noexce
 }
 
 void ColorPassDescriptorSet::prepareShadowMapping(BufferObjectHandle shadowUniforms, bool const highPrecision) noexcept {
-    auto& s = mUniforms.edit();
     constexpr float low  = 5.54f; // ~ std::log(std::numeric_limits<math::half>::max()) * 0.5f;
     constexpr float high = 42.0f; // ~ std::log(std::numeric_limits<float>::max()) * 0.5f;
-    s.vsmExponent = highPrecision ? high : low;
+    setUniform(&PerViewUib::vsmExponent, highPrecision ? high : low);
     setBuffer(+PerViewBindingPoints::SHADOWS, shadowUniforms, 0, sizeof(ShadowUib));
 }
 
-void ColorPassDescriptorSet::prepareShadowSampling(PerViewUib& uniforms,
+void ColorPassDescriptorSet::prepareShadowSampling(
         ShadowMappingUniforms const& shadowMappingUniforms) noexcept {
-    uniforms.cascadeSplits              = shadowMappingUniforms.cascadeSplits;
-    uniforms.ssContactShadowDistance    = shadowMappingUniforms.ssContactShadowDistance;
-    uniforms.directionalShadows         = int32_t(shadowMappingUniforms.directionalShadows);
-    uniforms.cascades                   = int32_t(shadowMappingUniforms.cascades);
+    setUniform(&PerViewUib::cascadeSplits, shadowMappingUniforms.cascadeSplits);
+    setUniform(&PerViewUib::ssContactShadowDistance, shadowMappingUniforms.ssContactShadowDistance);
+    setUniform(&PerViewUib::directionalShadows, int32_t(shadowMappingUniforms.directionalShadows));
+    setUniform(&PerViewUib::cascades, int32_t(shadowMappingUniforms.cascades));
 }
 
 void ColorPassDescriptorSet::prepareShadowVSM(Handle<HwTexture> texture,
@@ -474,12 +463,12 @@ void ColorPassDescriptorSet::prepareShadowVSM(Handle<HwTexture> texture,
                     .filterMin = filterMin,
                     .anisotropyLog2 = options.anisotropy,
             });
-    auto& s = mUniforms.edit();
-    s.shadowSamplingType = SHADOW_SAMPLING_RUNTIME_EVSM;
-    s.vsmExponent = options.highPrecision ? high : low;
-    s.vsmDepthScale = options.minVarianceScale * 0.01f * s.vsmExponent;
-    s.vsmLightBleedReduction = options.lightBleedReduction;
-    prepareShadowSampling(s, shadowMappingUniforms);
+    float const vsmExponent = options.highPrecision ? high : low;
+    setUniform(&PerViewUib::shadowSamplingType, SHADOW_SAMPLING_RUNTIME_EVSM);
+    setUniform(&PerViewUib::vsmExponent, vsmExponent);
+    setUniform(&PerViewUib::vsmDepthScale, options.minVarianceScale * 0.01f * vsmExponent);
+    setUniform(&PerViewUib::vsmLightBleedReduction, options.lightBleedReduction);
+    prepareShadowSampling(shadowMappingUniforms);
 }
 
 void ColorPassDescriptorSet::prepareShadowPCF(Handle<HwTexture> texture,
@@ -491,29 +480,26 @@ void ColorPassDescriptorSet::prepareShadowPCF(Handle<HwTexture> texture,
                     .compareMode = SamplerCompareMode::COMPARE_TO_TEXTURE,
                     .compareFunc = SamplerCompareFunc::GE
             });
-    auto& s = mUniforms.edit();
-    s.shadowSamplingType = SHADOW_SAMPLING_RUNTIME_PCF;
-    prepareShadowSampling(s, shadowMappingUniforms);
+    setUniform(&PerViewUib::shadowSamplingType, SHADOW_SAMPLING_RUNTIME_PCF);
+    prepareShadowSampling(shadowMappingUniforms);
 }
 
 void ColorPassDescriptorSet::prepareShadowDPCF(Handle<HwTexture> texture,
         ShadowMappingUniforms const& shadowMappingUniforms,
         SoftShadowOptions const& options) noexcept {
     setSampler(+PerViewBindingPoints::SHADOW_MAP, texture, {});
-    auto& s = mUniforms.edit();
-    s.shadowSamplingType = SHADOW_SAMPLING_RUNTIME_DPCF;
-    s.shadowPenumbraRatioScale = options.penumbraRatioScale;
-    prepareShadowSampling(s, shadowMappingUniforms);
+    setUniform(&PerViewUib::shadowSamplingType, SHADOW_SAMPLING_RUNTIME_DPCF);
+    setUniform(&PerViewUib::shadowPenumbraRatioScale, options.penumbraRatioScale);
+    prepareShadowSampling(shadowMappingUniforms);
 }
 
 void ColorPassDescriptorSet::prepareShadowPCSS(Handle<HwTexture> texture,
         ShadowMappingUniforms const& shadowMappingUniforms,
         SoftShadowOptions const& options) noexcept {
     setSampler(+PerViewBindingPoints::SHADOW_MAP, texture, {});
-    auto& s = mUniforms.edit();
-    s.shadowSamplingType = SHADOW_SAMPLING_RUNTIME_PCSS;
-    s.shadowPenumbraRatioScale = options.penumbraRatioScale;
-    prepareShadowSampling(s, shadowMappingUniforms);
+    setUniform(&PerViewUib::shadowSamplingType, SHADOW_SAMPLING_RUNTIME_PCSS);
+    setUniform(&PerViewUib::shadowPenumbraRatioScale, options.penumbraRatioScale);
+    prepareShadowSampling(shadowMappingUniforms);
 }
 
 void ColorPassDescriptorSet::prepareShadowPCFDebug(Handle<HwTexture> texture,
@@ -522,9 +508,8 @@ void ColorPassDescriptorSet::prepareShadowPCFDebug(Handle<HwTexture> texture,
             .filterMag = SamplerMagFilter::NEAREST,
             .filterMin = SamplerMinFilter::NEAREST
     });
-    auto& s = mUniforms.edit();
-    s.shadowSamplingType = SHADOW_SAMPLING_RUNTIME_PCF;
-    prepareShadowSampling(s, shadowMappingUniforms);
+    setUniform(&PerViewUib::shadowSamplingType, SHADOW_SAMPLING_RUNTIME_PCF);
+    prepareShadowSampling(shadowMappingUniforms);
 }
 
 void ColorPassDescriptorSet::commit(DriverApi& driver) noexcept {
@@ -33,12 +33,15 @@
 #include <math/vec2.h>
 #include <math/vec3.h>
 #include <math/vec4.h>
+#include <math/mat3.h>
 #include <math/mat4.h>
 
 #include <array>
+#include <type_traits>
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 namespace filament {
 
@@ -171,8 +174,34 @@ private:
     void setBuffer(backend::descriptor_binding_t binding,
             backend::BufferObjectHandle boh, uint32_t offset, uint32_t size) noexcept;
 
-    static void prepareShadowSampling(PerViewUib& uniforms,
-            ShadowMappingUniforms const& shadowMappingUniforms) noexcept;
+    void prepareShadowSampling(ShadowMappingUniforms const& shadowMappingUniforms) noexcept;
+
+    // Helpers to set an individual value in the PerViewUib. The uniform buffer is marked
+    // dirty -- triggering an upload in commit() -- only when the value actually changes,
+    // so that frames where nothing changed don't pay for a buffer update.
+    template<typename T>
+    void setUniform(T PerViewUib::* const field, std::type_identity_t<T> const& value) noexcept {
+        mUniforms.setField(field, value);
+    }
+
+    template<typename T, size_t N>
+    void setUniform(T (PerViewUib::* const field)[N], size_t const index,
+            std::type_identity_t<T> const& value) noexcept {
+        mUniforms.setField(field, index, value);
+    }
+
+    // std140::mat33 is compared element-wise because its padding content is unspecified
+    void setUniform(std140::mat33 PerViewUib::* const field, math::mat3f const& value) noexcept {
+        auto const& current = mUniforms.get().*field;
+        for (size_t i = 0; i < 3; i++) {
+            if (current[i][0] != value[i][0] ||
+                current[i][1] != value[i][1] ||
+                current[i][2] != value[i][2]) {
+                mUniforms.edit().*field = value;
+                return;
+            }
+        }
+    }
 
     TypedUniformBuffer<PerViewUib>& mUniforms;
     std::array<DescriptorSetLayout, DESCRIPTOR_LAYOUT_COUNT> mDescriptorSetLayout;
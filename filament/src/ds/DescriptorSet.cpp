@@ -130,6 +130,26 @@ void DescriptorSet::bind(FEngine::DriverApi& driver, DescriptorSetBindingPoints
     // within the renderpass. We have to comment the assert out since it crashed a client's debug
     // build.
     // assert_invariant(mDirty.none());
+    warnIfSetAfterCommit();
+    driver.bindDescriptorSet(mDescriptorSetHandle, +set, std::move(dynamicOffsets));
+}
+
+void DescriptorSet::bind(FEngine::DriverApi& driver,
+        std::initializer_list<std::pair<DescriptorSet const*, DescriptorSetBindingPoints>> const
+                sets) noexcept {
+    backend::DescriptorSetBindingArray bindings(sets.size(), driver);
+    backend::DescriptorSetBindingArray::size_type i = 0;
+    for (auto const& [ds, set] : sets) {
+        assert_invariant(ds->mDescriptorSetHandle);
+        ds->warnIfSetAfterCommit();
+        bindings[i].dsh = ds->mDescriptorSetHandle;
+        bindings[i].set = +set;
+        i++;
+    }
+    driver.bindDescriptorSets(std::move(bindings));
+}
+
+void DescriptorSet::warnIfSetAfterCommit() const noexcept {
     if (UTILS_VERY_UNLIKELY(mDirty.any() && !mSetAfterCommitWarning)) {
         mDirty.forEachSetBit([&](uint8_t const binding) {
             LOG(WARNING) << "Descriptor set (handle=" << mDescriptorSetHandle.getId()
@@ -137,7 +157,6 @@ void DescriptorSet::bind(FEngine::DriverApi& driver, DescriptorSetBindingPoints
         });
         mSetAfterCommitWarning = true;
     }
-    driver.bindDescriptorSet(mDescriptorSetHandle, +set, std::move(dynamicOffsets));
 }
 
 void DescriptorSet::setBuffer(DescriptorSetLayout const& layout,
@@ -31,6 +31,9 @@
 #include <utils/FixedCapacityVector.h>
 #include <utils/StaticString.h>
 
+#include <initializer_list>
+#include <utility>
+
 #include <stdint.h>
 
 namespace filament {
@@ -62,6 +65,11 @@ public:
     void bind(backend::DriverApi& driver, DescriptorSetBindingPoints set,
             backend::DescriptorSetOffsetArray dynamicOffsets) const noexcept;
 
+    // binds several descriptor sets with a single driver command
+    static void bind(backend::DriverApi& driver,
+            std::initializer_list<std::pair<DescriptorSet const*, DescriptorSetBindingPoints>>
+                    sets) noexcept;
+
     // sets a ubo/ssbo descriptor
     void setBuffer(DescriptorSetLayout const& layout,
             backend::descriptor_binding_t binding,
@@ -89,6 +97,8 @@ public:
         backend::TextureType t, backend::DescriptorType d) noexcept;
 
 private:
+    void warnIfSetAfterCommit() const noexcept;
+
     struct Desc {
         Desc() noexcept { }
         union {
@@ -49,6 +49,10 @@ public:
         return mDescriptorSetLayout;
     }
 
+    DescriptorSet const& getDescriptorSet() const noexcept {
+        return mDescriptorSet;
+    }
+
 private:
     DescriptorSetLayout mDescriptorSetLayout;
     DescriptorSet mDescriptorSet;
@@ -73,7 +73,8 @@ void SsrPassDescriptorSet::setFrameUniforms(FEngine const& engine,
 void SsrPassDescriptorSet::prepareHistorySSR(FEngine const& engine, Handle<HwTexture> ssr,
         mat4f const& historyProjection,
         mat4f const& uvFromViewMatrix,
-        ScreenSpaceReflectionsOptions const& ssrOptions) noexcept {
+        ScreenSpaceReflectionsOptions const& ssrOptions,
+        uint32_t const frameId) noexcept {
 
     mDescriptorSet.setSampler(engine.getPerViewDescriptorSetLayoutSsrVariant(),
             +PerViewBindingPoints::SSR, ssr, {
@@ -89,6 +90,13 @@ void SsrPassDescriptorSet::prepareHistorySSR(FEngine const& engine, Handle<HwTex
     s.ssrBias = ssrOptions.bias;
     s.ssrDistance = ssrOptions.enabled ? ssrOptions.maxDistance : 0.0f;
     s.ssrStride = ssrOptions.stride;
+
+    // With quarter-rate tracing, only the pixels whose position within the 2x2 pixel
+    // pattern matches ssrTracePattern march a ray this frame; the others blend the
+    // reprojected history with ssrHistoryWeight, or fall back to IBL (alpha = 0) when
+    // the history sample is disoccluded. A weight of 0 selects full-rate tracing.
+    s.ssrTracePattern = int32_t(frameId & 3u);
+    s.ssrHistoryWeight = ssrOptions.quarterRateTracing ? 1.0f : 0.0f;
 }
 
 void SsrPassDescriptorSet::prepareStructure(FEngine const& engine,
@@ -54,7 +54,8 @@ public:
     void prepareHistorySSR(FEngine const& engine, TextureHandle ssr,
             math::mat4f const& historyProjection,
             math::mat4f const& uvFromViewMatrix,
-            ScreenSpaceReflectionsOptions const& ssrOptions) noexcept;
+            ScreenSpaceReflectionsOptions const& ssrOptions,
+            uint32_t frameId) noexcept;
 
 
     // update local data into GPU UBO
@@ -21,7 +21,10 @@
 
 #include <backend/BufferDescriptor.h>
 
+#include <type_traits>
+
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 namespace filament {
@@ -31,7 +34,9 @@ class TypedBuffer { // NOLINT(cppcoreguidelines-pro-type-member-init)
 public:
 
     T& itemAt(size_t i) noexcept {
+        // we must assume the caller modifies the buffer through the returned reference
         mSomethingDirty = true;
+        mGeneration++;
         return mBuffer[i];
     }
 
@@ -39,6 +44,47 @@ public:
         return itemAt(0);
     }
 
+    // read-only access, doesn't mark the buffer dirty
+    T const& itemAt(size_t i) const noexcept {
+        return mBuffer[i];
+    }
+
+    T const& get() const noexcept {
+        return mBuffer[0];
+    }
+
+    // Typed field accessors: the buffer is marked dirty -- and the generation counter
+    // bumped -- only when the new value differs from the stored one, so redundant writes
+    // don't trigger an upload in commit(). Returns true if the field actually changed.
+    template<typename F>
+    bool setField(F T::* const field, std::type_identity_t<F> const& value) noexcept {
+        static_assert(N == 1, "setField() only works on single-item buffers");
+        if (memcmp(&(mBuffer[0].*field), &value, sizeof(F)) != 0) {
+            mBuffer[0].*field = value;
+            mSomethingDirty = true;
+            mGeneration++;
+            return true;
+        }
+        return false;
+    }
+
+    template<typename F, size_t M>
+    bool setField(F (T::* const field)[M], size_t const index,
+            std::type_identity_t<F> const& value) noexcept {
+        static_assert(N == 1, "setField() only works on single-item buffers");
+        if (memcmp(&((mBuffer[0].*field)[index]), &value, sizeof(F)) != 0) {
+            (mBuffer[0].*field)[index] = value;
+            mSomethingDirty = true;
+            mGeneration++;
+            return true;
+        }
+        return false;
+    }
+
+    // monotonically increasing modification counter; unlike the dirty flag it survives
+    // clean(), so callers can cache it to cheaply detect changes across commits
+    uint32_t getGeneration() const noexcept { return mGeneration; }
+
     // size of the uniform buffer in bytes
     size_t getSize() const noexcept { return sizeof(T) * N; }
 
@@ -67,6 +113,7 @@ public:
 
 private:
     T mBuffer[N];
+    uint32_t mGeneration = 0;
     mutable bool mSomethingDirty = false;
 };
 
@@ -23,7 +23,10 @@
 #include <backend/DriverApiForward.h>
 #include <backend/Handle.h>
 
+#include <type_traits>
+
 #include <stddef.h>
+#include <stdint.h>
 
 namespace filament {
 
@@ -58,6 +61,30 @@ public:
         return mTypedBuffer.itemAt(0);
     }
 
+    // read-only access, doesn't mark the buffer dirty
+    T const& itemAt(size_t i) const noexcept {
+        return mTypedBuffer.itemAt(i);
+    }
+
+    T const& get() const noexcept {
+        return mTypedBuffer.get();
+    }
+
+    // typed field accessors with change detection, see TypedBuffer::setField()
+    template<typename F>
+    bool setField(F T::* const field, std::type_identity_t<F> const& value) noexcept {
+        return mTypedBuffer.setField(field, value);
+    }
+
+    template<typename F, size_t M>
+    bool setField(F (T::* const field)[M], size_t const index,
+            std::type_identity_t<F> const& value) noexcept {
+        return mTypedBuffer.setField(field, index, value);
+    }
+
+    // see TypedBuffer::getGeneration()
+    uint32_t getGeneration() const noexcept { return mTypedBuffer.getGeneration(); }
+
     // size of the uniform buffer in bytes
     size_t getSize() const noexcept { return mTypedBuffer.getSize(); }
 
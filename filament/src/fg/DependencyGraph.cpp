@@ -18,10 +18,15 @@
 
 #include <private/utils/Tracing.h>
 
+#include <utils/compiler.h>
+#include <utils/Hash.h>
+
 #include <iterator>
 
 namespace filament {
 
+using namespace utils;
+
 DependencyGraph::DependencyGraph() noexcept {
     // Some reasonable defaults size for our vectors
     mNodes.reserve(8);
@@ -134,6 +139,37 @@ void DependencyGraph::cull() noexcept {
     }
 }
 
+uint64_t DependencyGraph::getTopologyHash() const noexcept {
+    size_t h = mNodes.size();
+    for (Node const* const pNode : mNodes) {
+        // before cull(), the reference count only holds the TARGET bit
+        hash::combine(h, pNode->mRefCount);
+    }
+    for (Edge const* const pEdge : mEdges) {
+        hash::combine(h, (uint64_t(pEdge->from) << 32u) | pEdge->to);
+    }
+    return h;
+}
+
+void DependencyGraph::saveRefCounts(std::vector<uint32_t>& out) const {
+    out.clear();
+    out.reserve(mNodes.size());
+    for (Node const* const pNode : mNodes) {
+        out.push_back(pNode->mRefCount);
+    }
+}
+
+bool DependencyGraph::restoreRefCounts(std::vector<uint32_t> const& in) noexcept {
+    if (UTILS_UNLIKELY(in.size() != mNodes.size())) {
+        return false;
+    }
+    auto curr = in.begin();
+    for (Node* const pNode : mNodes) {
+        pNode->mRefCount = *curr++;
+    }
+    return true;
+}
+
 void DependencyGraph::clear() noexcept {
     mEdges.clear();
     mNodes.clear();
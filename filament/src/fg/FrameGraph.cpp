@@ -15,6 +15,7 @@
  */
 
 #include "fg/FrameGraph.h"
+#include "fg/FrameGraphPassProfiler.h"
 #include "fg/details/PassNode.h"
 #include "fg/details/Resource.h"
 #include "fg/details/ResourceNode.h"
@@ -31,6 +32,8 @@
 #include <backend/DriverEnums.h>
 #include <backend/Handle.h>
 
+#include <private/backend/BackendUtils.h>
+
 #include <private/utils/Tracing.h>
 
 #include <utils/compiler.h>
@@ -54,6 +57,14 @@ void FrameGraph::Builder::sideEffect() noexcept {
     mPassNode->makeTarget();
 }
 
+void FrameGraph::Builder::executeWhen(std::function<bool()> predicate) noexcept {
+    mPassNode->setPredicate(std::move(predicate));
+}
+
+void FrameGraph::Builder::queueAffinity(QueueAffinity const affinity) noexcept {
+    mPassNode->queueAffinity = affinity;
+}
+
 const char* FrameGraph::Builder::getName(FrameGraphHandle const handle) const noexcept {
     return mFrameGraph.getResource(handle)->name;
 }
@@ -118,14 +129,26 @@ void FrameGraph::reset() noexcept {
     mResourceSlots.clear();
 }
 
-FrameGraph& FrameGraph::compile() noexcept {
+FrameGraph& FrameGraph::compile(FrameGraphCompileCache* const cache) noexcept {
 
     FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_FILAMENT);
 
     DependencyGraph& dependencyGraph = mGraph;
 
-    // first we cull unreachable nodes
-    dependencyGraph.cull();
+    // first we cull unreachable nodes; when the topology is identical to the previously
+    // compiled graph, the culling result is reused instead of re-walking the graph
+    if (cache) {
+        uint64_t const hash = dependencyGraph.getTopologyHash();
+        if (!cache->mValid || cache->mHash != hash ||
+                !dependencyGraph.restoreRefCounts(cache->mRefCounts)) {
+            dependencyGraph.cull();
+            dependencyGraph.saveRefCounts(cache->mRefCounts);
+            cache->mHash = hash;
+            cache->mValid = true;
+        }
+    } else {
+        dependencyGraph.cull();
+    }
 
     /*
      * update the reference counter of the resource themselves and
@@ -214,21 +237,32 @@ void FrameGraph::execute(backend::DriverApi& driver) noexcept {
         FILAMENT_TRACING_NAME(FILAMENT_TRACING_CATEGORY_FILAMENT, node->getName());
         driver.pushGroupMarker(node->getName());
 
+        if (UTILS_UNLIKELY(mProfiler)) {
+            mProfiler->beginPass(driver, node->getName());
+        }
+
         // devirtualize resourcesList
         for (VirtualResource* resource : node->devirtualize) {
             assert_invariant(resource->first == node);
             resource->devirtualize(resourceAllocator, useProtectedMemory);
         }
 
-        // call execute
-        FrameGraphResources const resources(*this, *node);
-        node->execute(resources, driver);
+        // call execute, unless the pass's predicate says there is nothing to do this frame
+        if (UTILS_LIKELY(node->isEnabled())) {
+            FrameGraphResources const resources(*this, *node);
+            node->execute(resources, driver);
+        }
 
         // destroy concrete resources
         for (VirtualResource* resource : node->destroy) {
             assert_invariant(resource->last == node);
             resource->destroy(resourceAllocator);
         }
+
+        if (UTILS_UNLIKELY(mProfiler)) {
+            mProfiler->endPass(driver);
+        }
+
         driver.popGroupMarker();
     }
     driver.popGroupMarker();
@@ -556,6 +590,23 @@ fgviewer::FrameGraphInfo FrameGraph::getFrameGraphInfo(const char *viewName) con
             emplace_resource_property("format",
                 utils::to_string(descriptor.format));
 
+            // Estimated allocation size of the devirtualized resource, so the viewer can chart
+            // transient memory over time. This mirrors what ResourceAllocator ends up creating;
+            // compressed formats are approximated by their block size.
+            uint64_t sizeBytes = 0;
+            uint32_t w = descriptor.width;
+            uint32_t h = descriptor.height;
+            uint32_t d = descriptor.depth;
+            size_t const formatSize = backend::getFormatSize(descriptor.format);
+            for (size_t l = 0; l < descriptor.levels; l++) {
+                sizeBytes += uint64_t(w) * h * d * formatSize;
+                w = std::max(1u, w >> 1u);
+                h = std::max(1u, h >> 1u);
+                d = std::max(1u, d >> 1u);
+            }
+            sizeBytes *= std::max(uint8_t(1), descriptor.samples);
+            emplace_resource_property("size_bytes",
+                utils::CString(std::to_string(sizeBytes).data()));
         };
 
         if (resourceNode->getParentNode() != nullptr) {
@@ -585,6 +636,23 @@ fgviewer::FrameGraphInfo FrameGraph::getFrameGraphInfo(const char *viewName) con
 #endif
 }
 
+size_t FrameGraph::getPassStats(DebugRegistry::PassStats* stats, size_t capacity) const noexcept {
+    size_t count = 0;
+    auto first = mPassNodes.cbegin();
+    Vector<PassNode*>::const_iterator const last = mActivePassNodesEnd;
+    while (first != last && count < capacity) {
+        if ((*first)->getPassStats(stats[count])) {
+            count++;
+        }
+        ++first;
+    }
+    // consumers scan the fixed-size array until the first empty name
+    for (size_t i = count; i < capacity; i++) {
+        stats[i].name[0] = '\0';
+    }
+    return count;
+}
+
 
 // ------------------------------------------------------------------------------------------------
 
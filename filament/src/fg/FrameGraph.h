@@ -31,6 +31,8 @@
 
 #include "backend/DriverApiForward.h"
 
+#include <filament/DebugRegistry.h>
+
 #include <backend/DriverEnums.h>
 #include <backend/Handle.h>
 
@@ -49,13 +51,44 @@ namespace filament {
 class ResourceAllocatorInterface;
 
 class FrameGraphPassExecutor;
+class FrameGraphPassProfiler;
 class PassNode;
 class ResourceNode;
 class VirtualResource;
 
+/**
+ * A cross-frame cache for FrameGraph::compile() (see there). An instance must persist across
+ * frames (it lives in FRenderer). It only helps when the same topology is compiled repeatedly;
+ * if several graphs with different topologies share the cache, every compile falls back to the
+ * full path.
+ */
+class FrameGraphCompileCache {
+public:
+    //! drops the cached culling result; the next compile() re-walks the dependency graph
+    void invalidate() noexcept { mValid = false; }
+private:
+    friend class FrameGraph;
+    uint64_t mHash = 0;
+    bool mValid = false;
+    std::vector<uint32_t> mRefCounts;   // per-node post-cull() reference counts
+};
+
 class FrameGraph {
 public:
 
+    /**
+     * Hint about which hardware queue a pass would best execute on.
+     *
+     * This is purely a scheduling hint: the FrameGraph still executes all passes in declaration
+     * order on the graphics queue, but records the affinity on each pass so that backends with
+     * hardware async compute queues can overlap eligible passes with graphics work once
+     * DriverApi exposes queue selection. Backends without async queues ignore it.
+     */
+    enum class QueueAffinity : uint8_t {
+        GRAPHICS,   //!< pass must execute on the graphics queue (default)
+        COMPUTE,    //!< self-contained compute-like work that may overlap graphics work
+    };
+
     class Builder {
     public:
         Builder(Builder const&) = delete;
@@ -162,6 +195,30 @@ public:
          */
         void sideEffect() noexcept;
 
+        /**
+         * Declares which hardware queue this pass would best execute on (see QueueAffinity).
+         * A pass declared with QueueAffinity::COMPUTE promises that it only depends on the
+         * resources it reads, so a backend with an async compute queue may overlap it with
+         * unrelated graphics work. The default is QueueAffinity::GRAPHICS.
+         */
+        void queueAffinity(QueueAffinity affinity) noexcept;
+
+        /**
+         * Makes this pass conditional. The predicate is evaluated by FrameGraph::execute()
+         * just before the pass would run, i.e. after the graph is compiled; when it returns
+         * false the pass's execute lambda and its render target creation are skipped for this
+         * frame.
+         *
+         * The pass still participates in compilation: its resources keep their computed
+         * lifetimes and are allocated and released on schedule, so skipping never affects
+         * other passes' aliasing decisions. Consequently, the content of a skipped pass's
+         * outputs is undefined -- consumers must share the predicate or tolerate stale data.
+         * The typical use is an effect whose input is known to be a no-op this frame, e.g.
+         * bloom when a previous frame's luminance readback says nothing exceeds the
+         * threshold.
+         */
+        void executeWhen(std::function<bool()> predicate) noexcept;
+
         /**
          * Retrieves the descriptor associated to a resource
          * @tparam RESOURCE Type of the resource
@@ -295,9 +352,16 @@ public:
 
     /**
      * Allocates concrete resources and culls unreferenced passes.
+     *
+     * A FrameGraphCompileCache can optionally be supplied; the graph is rebuilt from scratch
+     * every frame but its topology rarely changes frame-to-frame, so when the declaration
+     * sequence hashes to the same value as the previously compiled graph, the culling result
+     * is reused instead of re-walking the dependency graph.
+     *
+     * @param cache an optional compile cache persisting across frames
      * @return a reference to the FrameGraph, for chaining calls.
      */
-    FrameGraph& compile() noexcept;
+    FrameGraph& compile(FrameGraphCompileCache* cache = nullptr) noexcept;
 
     /**
      * Execute all referenced passes
@@ -448,6 +512,19 @@ public:
      */
     fgviewer::FrameGraphInfo getFrameGraphInfo(const char *viewName) const;
 
+    /**
+     * Fills \p stats with per-pass attachment bandwidth estimates for the culled-in passes.
+     * Only valid after compile(). Entries past the last pass are given an empty name.
+     * @return the number of entries written
+     */
+    size_t getPassStats(DebugRegistry::PassStats* stats, size_t capacity) const noexcept;
+
+    /**
+     * Sets the profiler that execute() brackets each pass with (GPU timer queries).
+     * Must be set before execute(). nullptr (the default) disables pass profiling.
+     */
+    void setProfiler(FrameGraphPassProfiler* profiler) noexcept { mProfiler = profiler; }
+
 private:
     friend class FrameGraphResources;
     friend class PassNode;
@@ -544,6 +621,7 @@ private:
     Vector<ResourceNode*> mResourceNodes;
     Vector<PassNode*> mPassNodes;
     Vector<PassNode*>::iterator mActivePassNodesEnd;
+    FrameGraphPassProfiler* mProfiler = nullptr;
 };
 
 template<typename Data, typename Setup, typename Execute>
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fg/FrameGraphPassProfiler.h"
+
+#include <backend/DriverEnums.h>
+
+#include <private/backend/DriverApi.h>
+
+#include <utils/compiler.h>
+#include <utils/debug.h>
+
+#include <string.h>
+
+namespace filament {
+
+using namespace backend;
+
+void FrameGraphPassProfiler::terminate(DriverApi& driver) noexcept {
+    for (auto& batch : mBatches) {
+        recycle(batch);
+    }
+    for (auto const query : mFreeQueries) {
+        driver.destroyTimerQuery(query);
+    }
+    mFreeQueries.clear();
+    mResolved.clear();
+    mIndex = mLast = 0;
+}
+
+TimerQueryHandle FrameGraphPassProfiler::obtainQuery(DriverApi& driver) noexcept {
+    if (!mFreeQueries.empty()) {
+        TimerQueryHandle const query = mFreeQueries.back();
+        mFreeQueries.pop_back();
+        return query;
+    }
+    return driver.createTimerQuery();
+}
+
+void FrameGraphPassProfiler::recycle(std::vector<PassQuery>& batch) noexcept {
+    for (auto const& pass : batch) {
+        mFreeQueries.push_back(pass.query);
+    }
+    batch.clear();
+}
+
+void FrameGraphPassProfiler::beginFrame(DriverApi& driver) noexcept {
+    // resolve the pending batches, oldest first, stopping at the first one that isn't
+    // ready (by construction the newer ones aren't either)
+    while (mLast != mIndex) {
+        auto& batch = mBatches[mLast];
+        if (!batch.empty()) {
+            // queries complete in submission order, so the whole batch is done once its
+            // last query is
+            uint64_t elapsed = 0;
+            TimerQueryResult const result =
+                    driver.getTimerQueryValue(batch.back().query, &elapsed);
+            if (result == TimerQueryResult::NOT_READY) {
+                break;
+            }
+            if (result == TimerQueryResult::AVAILABLE) {
+                mResolved.clear();
+                for (auto const& pass : batch) {
+                    uint64_t gpuTimeNs = 0;
+                    if (&pass == &batch.back()) {
+                        gpuTimeNs = elapsed;
+                    } else if (driver.getTimerQueryValue(pass.query, &gpuTimeNs)
+                            != TimerQueryResult::AVAILABLE) {
+                        gpuTimeNs = 0;
+                    }
+                    auto& resolved = mResolved.emplace_back();
+                    memcpy(resolved.name, pass.name, NAME_LENGTH);
+                    resolved.gpuTimeNs = gpuTimeNs;
+                }
+            }
+            // on ERROR the batch is simply dropped
+        }
+        recycle(batch);
+        mLast = (mLast + 1) % BATCH_COUNT;
+    }
+}
+
+void FrameGraphPassProfiler::beginPass(DriverApi& driver, const char* name) noexcept {
+    // FrameGraph passes execute sequentially, scopes don't nest (and can't, on the
+    // OpenGL GL_TIME_ELAPSED path)
+    assert_invariant(!mActiveQuery);
+    auto& entry = mBatches[mIndex].emplace_back();
+    strncpy(entry.name, name, NAME_LENGTH - 1);
+    entry.name[NAME_LENGTH - 1] = '\0';
+    entry.query = obtainQuery(driver);
+    mActiveQuery = entry.query;
+    driver.beginTimerQuery(entry.query);
+}
+
+void FrameGraphPassProfiler::endPass(DriverApi& driver) noexcept {
+    assert_invariant(mActiveQuery);
+    driver.endTimerQuery(mActiveQuery);
+    mActiveQuery = {};
+}
+
+void FrameGraphPassProfiler::endFrame(DriverApi&) noexcept {
+    assert_invariant(!mActiveQuery);
+    mIndex = (mIndex + 1) % BATCH_COUNT;
+    if (UTILS_UNLIKELY(mIndex == mLast)) {
+        // the GPU is more than BATCH_COUNT frames behind, drop the oldest sample
+        recycle(mBatches[mLast]);
+        mLast = (mLast + 1) % BATCH_COUNT;
+    }
+}
+
+void FrameGraphPassProfiler::fillGpuTimes(DebugRegistry::PassStats* stats,
+        size_t const capacity) const noexcept {
+    for (auto const& resolved : mResolved) {
+        for (size_t i = 0; i < capacity && stats[i].name[0]; i++) {
+            if (!strncmp(stats[i].name, resolved.name, NAME_LENGTH)) {
+                stats[i].gpuTimeNs = resolved.gpuTimeNs;
+                break;
+            }
+        }
+    }
+}
+
+} // namespace filament
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_FG_FRAMEGRAPHPASSPROFILER_H
+#define TNT_FILAMENT_FG_FRAMEGRAPHPASSPROFILER_H
+
+#include "backend/DriverApiForward.h"
+
+#include <filament/DebugRegistry.h>
+
+#include <backend/Handle.h>
+
+#include <array>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+/**
+ * Brackets each FrameGraph pass with a GPU timer query and publishes the measured GPU times
+ * once they become available, a few frames later.
+ *
+ * An instance must persist across frames (it lives in FRenderer). Query handles are pooled and
+ * recycled, so a steady-state frame performs no allocations. Because FrameGraph passes execute
+ * sequentially, the "hierarchy" is flat: the whole frame is the root, the passes its children;
+ * this also sidesteps OpenGL's restriction of a single active GL_TIME_ELAPSED query (the
+ * frame-wide query of FrameInfoManager must still be disabled while this is active, see
+ * FrameInfoManager::Config::gpuTimerQuery).
+ *
+ * Results are matched to FrameGraph::getPassStats() entries by pass name, since the set of
+ * passes can change between submission and resolution.
+ */
+class FrameGraphPassProfiler {
+    static constexpr size_t BATCH_COUNT = 4;    // in-flight batches, like FrameInfoManager
+
+public:
+    FrameGraphPassProfiler() noexcept = default;
+    FrameGraphPassProfiler(FrameGraphPassProfiler const&) = delete;
+    FrameGraphPassProfiler& operator=(FrameGraphPassProfiler const&) = delete;
+
+    void terminate(backend::DriverApi& driver) noexcept;
+
+    // Starts recording a batch of pass queries; also polls the oldest pending batches,
+    // publishing the most recent one that completed. Call before FrameGraph::execute().
+    void beginFrame(backend::DriverApi& driver) noexcept;
+
+    // Called by FrameGraph::execute() around each pass. Scopes cannot nest.
+    void beginPass(backend::DriverApi& driver, const char* name) noexcept;
+    void endPass(backend::DriverApi& driver) noexcept;
+
+    // Submits the current batch. Call after FrameGraph::execute().
+    void endFrame(backend::DriverApi& driver) noexcept;
+
+    // Copies the most recently resolved GPU times into the matching (by name) entries
+    // of a getPassStats() array. Entries without a match are left untouched.
+    void fillGpuTimes(DebugRegistry::PassStats* stats, size_t capacity) const noexcept;
+
+private:
+    static constexpr size_t NAME_LENGTH = DebugRegistry::PassStats::NAME_LENGTH;
+
+    struct PassQuery {
+        char name[NAME_LENGTH];
+        backend::TimerQueryHandle query;
+    };
+    struct ResolvedPass {
+        char name[NAME_LENGTH];
+        uint64_t gpuTimeNs;
+    };
+
+    backend::TimerQueryHandle obtainQuery(backend::DriverApi& driver) noexcept;
+    void recycle(std::vector<PassQuery>& batch) noexcept;
+
+    std::vector<backend::TimerQueryHandle> mFreeQueries;    // recycled query pool
+    std::array<std::vector<PassQuery>, BATCH_COUNT> mBatches;
+    uint32_t mIndex = 0;                        // batch currently being recorded
+    uint32_t mLast = 0;                         // oldest batch still pending
+    backend::TimerQueryHandle mActiveQuery;     // query of the currently open pass scope
+    std::vector<ResolvedPass> mResolved;        // most recent fully resolved batch
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_FG_FRAMEGRAPHPASSPROFILER_H
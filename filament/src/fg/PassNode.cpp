@@ -23,6 +23,10 @@
 
 #include <details/Texture.h>
 
+#include <private/backend/BackendUtils.h>
+
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 using namespace filament::backend;
@@ -153,9 +157,8 @@ void RenderPassNode::resolve() noexcept {
 
                 // Discard at the end only if we are writing to this attachment AND later reading
                 // from it. (in particular, don't discard if we're not writing at all, because this
-                // attachment might have other readers after us).
-                // TODO: we could set the discard flag if we are the last reader, i.e.
-                //       if rt->incoming[i] last reader is us.
+                // attachment might have other readers after us). The read-only case is handled
+                // below, once we have the resource: we can discard if we're the last reader.
                 if (rt.outgoing[i] && !rt.outgoing[i]->hasActiveReaders()) {
                     rt.backend.params.flags.discardEnd |= target;
                 }
@@ -173,6 +176,17 @@ void RenderPassNode::resolve() noexcept {
                 VirtualResource* pResource = mFrameGraph.getResource(rt.descriptor.attachments.array[i]);
                 Resource<FrameGraphTexture>* pTextureResource = static_cast<Resource<FrameGraphTexture>*>(pResource);
 
+                // If we're not writing to this attachment and nobody reads it after us, its
+                // contents are dead once this pass ends and don't need to be stored (a real
+                // bandwidth saving on tilers). Imported resources are excluded because their
+                // contents can be observed outside the graph.
+                if (!rt.outgoing[i] || !rt.outgoing[i]->hasWriterPass()) {
+                    if (!pResource->isImported() &&
+                            rt.incoming[i] && rt.incoming[i]->isLastActiveReader(this)) {
+                        rt.backend.params.flags.discardEnd |= target;
+                    }
+                }
+
                 pImportedRenderTarget = pImportedRenderTarget ?
                         pImportedRenderTarget : pResource->asImportedRenderTarget();
 
@@ -292,6 +306,37 @@ RenderPassNode::RenderPassData const* RenderPassNode::getRenderPassData(uint32_t
     return id < mRenderTargetData.size() ? &mRenderTargetData[id] : nullptr;
 }
 
+bool RenderPassNode::getPassStats(DebugRegistry::PassStats& stats) const noexcept {
+    stats = {};
+    strncpy(stats.name, mName, DebugRegistry::PassStats::NAME_LENGTH - 1);
+    bool hasRenderTarget = false;
+    for (auto const& rt : mRenderTargetData) {
+        // resolve() computed the viewport and discard flags, so traffic can be estimated
+        // the way a tiler sees it: an attachment is loaded unless it's discarded or
+        // cleared on entry, and stored unless it's discarded on exit.
+        auto const& params = rt.backend.params;
+        uint64_t const pixelCount = uint64_t(params.viewport.width) * params.viewport.height
+                * std::max(uint8_t(1), rt.descriptor.samples);
+        for (size_t i = 0; i < RenderPassData::ATTACHMENT_COUNT; i++) {
+            if (!rt.attachmentInfo[i]) {
+                continue;
+            }
+            auto const* pResource = static_cast<Resource<FrameGraphTexture> const*>(
+                    mFrameGraph.getResource(rt.attachmentInfo[i]));
+            uint64_t const bytes = pixelCount * getFormatSize(pResource->descriptor.format);
+            TargetBufferFlags const target = getTargetBufferFlagsAt(i);
+            if (none(params.flags.discardStart & target) && none(params.flags.clear & target)) {
+                stats.attachmentReadBytes += bytes;
+            }
+            if (none(params.flags.discardEnd & target)) {
+                stats.attachmentWriteBytes += bytes;
+            }
+            hasRenderTarget = true;
+        }
+    }
+    return hasRenderTarget;
+}
+
 utils::CString RenderPassNode::graphvizify() const noexcept {
 #ifndef NDEBUG
     std::string s;
@@ -306,6 +351,9 @@ utils::CString RenderPassNode::graphvizify() const noexcept {
     s.append(std::to_string(refCount));
     s.append(", id: ");
     s.append(std::to_string(id));
+    if (queueAffinity == FrameGraph::QueueAffinity::COMPUTE) {
+        s.append(" (compute)");
+    }
 
     for (auto const& rt :mRenderTargetData) {
         s.append("\\nS:");
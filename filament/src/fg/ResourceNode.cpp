@@ -86,6 +86,18 @@ bool ResourceNode::hasActiveWriters() const noexcept {
     return !writers.empty();
 }
 
+bool ResourceNode::isLastActiveReader(PassNode const* node) const noexcept {
+    // here we don't use mReaderPasses because this wouldn't account for subresources
+    DependencyGraph& dependencyGraph = mFrameGraph.getGraph();
+    auto const& readers = dependencyGraph.getOutgoingEdges(this);
+    for (auto const& reader : readers) {
+        if (reader->to != node->getId() && !dependencyGraph.getNode(reader->to)->isCulled()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 ResourceEdgeBase* ResourceNode::getReaderEdgeForPass(PassNode const* node) const noexcept {
     auto pos = std::find_if(mReaderPasses.begin(), mReaderPasses.end(),
             [node](ResourceEdgeBase const* edge) {
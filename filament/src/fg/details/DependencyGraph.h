@@ -163,6 +163,17 @@ public:
     //! cull unreferenced nodes. Links ARE NOT removed, only reference counts are updated.
     void cull() noexcept;
 
+    //! hash of the graph's topology: nodes, target bits and edges, in declaration order.
+    //! Must be called before cull().
+    uint64_t getTopologyHash() const noexcept;
+
+    //! saves the post-cull() per-node reference counts (see FrameGraphCompileCache)
+    void saveRefCounts(std::vector<uint32_t>& out) const;
+
+    //! restores previously saved reference counts in lieu of calling cull().
+    //! Returns false (and leaves the graph untouched) on a node count mismatch.
+    bool restoreRefCounts(std::vector<uint32_t> const& in) noexcept;
+
     /**
      * Return whether an edge is valid, that is if both ends are connected to nodes
      * that are not culled. Valid only after cull() is called.
@@ -24,8 +24,11 @@
 
 #include "backend/DriverApiForward.h"
 
+#include <filament/DebugRegistry.h>
+
 #include <backend/TargetBufferInfo.h>
 
+#include <functional>
 #include <unordered_set>
 
 namespace utils {
@@ -56,10 +59,32 @@ public:
 
     virtual void execute(FrameGraphResources const& resources, backend::DriverApi& driver) noexcept = 0;
     virtual void resolve() noexcept = 0;
+
+    // Fills estimated attachment bandwidth statistics for this pass. Only valid after
+    // resolve(). Returns false for passes without render targets.
+    virtual bool getPassStats(DebugRegistry::PassStats& stats) const noexcept { return false; }
+
     utils::CString graphvizifyEdgeColor() const noexcept override;
 
+    // Makes this pass conditional, see FrameGraph::Builder::executeWhen().
+    void setPredicate(std::function<bool()> predicate) noexcept {
+        mPredicate = std::move(predicate);
+    }
+
+    // Evaluates the pass's predicate; a pass without a predicate always runs.
+    bool isEnabled() const noexcept {
+        return !mPredicate || mPredicate();
+    }
+
     Vector<VirtualResource*> devirtualize;         // resources we need to create before executing
     Vector<VirtualResource*> destroy;              // resources we need to destroy after executing
+
+    // scheduling hint, see FrameGraph::QueueAffinity
+    FrameGraph::QueueAffinity queueAffinity = FrameGraph::QueueAffinity::GRAPHICS;
+
+private:
+    // evaluated by FrameGraph::execute() just before the pass runs
+    std::function<bool()> mPredicate;
 };
 
 class RenderPassNode : public PassNode {
@@ -92,6 +117,8 @@ public:
 
     RenderPassData const* getRenderPassData(uint32_t id) const noexcept;
 
+    bool getPassStats(DebugRegistry::PassStats& stats) const noexcept override;
+
 private:
     // virtuals from DependencyGraph::Node
     char const* getName() const noexcept override { return mName; }
@@ -65,6 +65,9 @@ public:
     // is any non culled Node (of any type) reading from this ResourceNode
     bool hasActiveReaders() const noexcept;
 
+    // is the specified PassNode the only non culled Node reading from this ResourceNode
+    bool isLastActiveReader(PassNode const* node) const noexcept;
+
     // is the specified PassNode reading this resource, if so return the corresponding edge.
     ResourceEdgeBase* getReaderEdgeForPass(PassNode const* node) const noexcept;
 
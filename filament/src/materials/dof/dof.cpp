@@ -36,6 +36,7 @@ static const StaticMaterialInfo sMaterialList[] = {
         { "dofDownsample",      MATERIAL(DOF, DOFDOWNSAMPLE) },
         { "dofMedian",          MATERIAL(DOF, DOFMEDIAN) },
         { "dofMipmap",          MATERIAL(DOF, DOFMIPMAP) },
+        { "dofTileMask",        MATERIAL(DOF, DOFTILEMASK) },
         { "dofTiles",           MATERIAL(DOF, DOFTILES) },
         { "dofTilesSwizzle",    MATERIAL(DOF, DOFTILESSWIZZLE) },
 };
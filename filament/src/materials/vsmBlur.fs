@@ -0,0 +1,42 @@
+highp vec4 fetch(const highp vec2 p) {
+    return textureLod(materialParams_source, p, 0.0);
+}
+
+float weightAt(const int i) {
+    return materialParams.kernel[i].x;
+}
+
+float offsetAt(const int i) {
+    // the first tap is the center texel, the others fold two texels via linear filtering
+    return i == 0 ? 0.0 : float(2 * i - 1) + materialParams.kernel[i].y;
+}
+
+void postProcess(inout PostProcessInputs postProcess) {
+    highp vec2 uv = variable_vertex.xy;
+    highp vec2 axis = materialParams.axis;
+
+    // 2D expansion of the separable gaussian kernel: the weights are products of the 1D
+    // weights, so a single pass produces the same image as the horizontal+vertical pair
+    // without writing and re-reading the intermediate render target. Only worthwhile for
+    // small kernels, where (2*count-1)^2 taps cost less than the extra round trip.
+    highp vec4 sum = vec4(0.0);
+    for (int j = 0; j < materialParams.count; j++) {
+        float wy = weightAt(j);
+        float oy = offsetAt(j);
+        for (int i = 0; i < materialParams.count; i++) {
+            float w = weightAt(i) * wy;
+            float ox = offsetAt(i);
+            sum += fetch(uv + vec2(ox, oy) * axis) * w;
+            if (i > 0) {
+                sum += fetch(uv + vec2(-ox, oy) * axis) * w;
+            }
+            if (j > 0) {
+                sum += fetch(uv + vec2(ox, -oy) * axis) * w;
+                if (i > 0) {
+                    sum += fetch(uv + vec2(-ox, -oy) * axis) * w;
+                }
+            }
+        }
+    }
+    postProcess.color = sum;
+}
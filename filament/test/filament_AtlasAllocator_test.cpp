@@ -199,3 +199,71 @@ TEST(AtlasAllocator, AllocateBySizeFullLayers) {
     EXPECT_EQ(vp3.viewport, r);
 }
 
+
+TEST(AtlasAllocator, FreeAndReuse) {
+    AtlasAllocator allocator(1024);
+
+    auto a = allocator.allocate(1024);
+    auto b = allocator.allocate(1024);
+    EXPECT_EQ(a.layer, 0);
+    EXPECT_EQ(b.layer, 1);
+
+    EXPECT_TRUE(allocator.free(a));
+    // double free is rejected
+    EXPECT_FALSE(allocator.free(a));
+
+    // the freed slot is reused
+    auto c = allocator.allocate(1024);
+    EXPECT_EQ(c.layer, 0);
+    EXPECT_EQ(c.viewport, a.viewport);
+}
+
+TEST(AtlasAllocator, FreeMixedSizes) {
+    AtlasAllocator allocator(1024);
+
+    auto a = allocator.allocate(512);
+    auto b = allocator.allocate(512);
+    auto c = allocator.allocate(256);
+
+    EXPECT_TRUE(allocator.free(b));
+    auto d = allocator.allocate(512);
+    EXPECT_EQ(d.layer, b.layer);
+    EXPECT_EQ(d.viewport, b.viewport);
+
+    EXPECT_TRUE(allocator.free(a));
+    EXPECT_TRUE(allocator.free(c));
+    EXPECT_TRUE(allocator.free(d));
+
+    // everything was freed, a full-size allocation is possible again
+    auto e = allocator.allocate(1024);
+    EXPECT_EQ(e.layer, 0);
+    EXPECT_EQ(e.viewport, Viewport(0, 0, 1024, 1024));
+}
+
+TEST(AtlasAllocator, Defragment) {
+    AtlasAllocator allocator(1024);
+
+    // fill the first layer with four 512 maps, then spill one onto the next layer
+    AtlasAllocator::Allocation maps[4];
+    for (auto& map : maps) {
+        map = allocator.allocate(512);
+        EXPECT_EQ(map.layer, 0);
+    }
+    auto last = allocator.allocate(512);
+    EXPECT_EQ(last.layer, 1);
+
+    // an atlas without holes has nothing to defragment
+    AtlasAllocator::Relocation relocation;
+    EXPECT_FALSE(allocator.defragment(&relocation));
+
+    // punch a hole in the first layer, the spilled block should move into it
+    EXPECT_TRUE(allocator.free(maps[1]));
+    EXPECT_TRUE(allocator.defragment(&relocation));
+    EXPECT_EQ(relocation.from.layer, last.layer);
+    EXPECT_EQ(relocation.from.viewport, last.viewport);
+    EXPECT_EQ(relocation.to.layer, maps[1].layer);
+    EXPECT_EQ(relocation.to.viewport, maps[1].viewport);
+
+    // a single step was enough, the atlas is compact again
+    EXPECT_FALSE(allocator.defragment(&relocation));
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ScratchBufferPool.h"
+
+using namespace filament;
+
+TEST(ScratchBufferPool, GetPutReuse) {
+    ScratchBufferPool pool;
+
+    void* const a = pool.get(1000, ScratchBufferPool::Tag::SCENE);
+    ASSERT_NE(a, nullptr);
+
+    auto accounting = pool.getAccounting(ScratchBufferPool::Tag::SCENE);
+    EXPECT_GE(accounting.outstandingBytes, 1000u);
+    EXPECT_EQ(accounting.pooledBytes, 0u);
+
+    pool.put(a);
+    accounting = pool.getAccounting(ScratchBufferPool::Tag::SCENE);
+    EXPECT_EQ(accounting.outstandingBytes, 0u);
+    EXPECT_GT(accounting.pooledBytes, 0u);
+
+    // a same-size request is serviced from the pool
+    void* const b = pool.get(1000, ScratchBufferPool::Tag::SCENE);
+    EXPECT_EQ(a, b);
+    pool.put(b);
+}
+
+TEST(ScratchBufferPool, SizeBuckets) {
+    ScratchBufferPool pool;
+
+    // requests of different magnitudes are pooled independently
+    void* const small = pool.get(1 << 10, ScratchBufferPool::Tag::SCENE);
+    void* const large = pool.get(1 << 20, ScratchBufferPool::Tag::SCENE);
+    EXPECT_NE(small, large);
+    pool.put(small);
+    pool.put(large);
+
+    void* const small2 = pool.get(1 << 10, ScratchBufferPool::Tag::SCENE);
+    void* const large2 = pool.get(1 << 20, ScratchBufferPool::Tag::SCENE);
+    EXPECT_EQ(small, small2);
+    EXPECT_EQ(large, large2);
+    pool.put(small2);
+    pool.put(large2);
+}
+
+TEST(ScratchBufferPool, PerTagAccounting) {
+    ScratchBufferPool pool;
+
+    void* const a = pool.get(4096, ScratchBufferPool::Tag::SCENE);
+    void* const b = pool.get(4096, ScratchBufferPool::Tag::READBACK);
+
+    EXPECT_GT(pool.getAccounting(ScratchBufferPool::Tag::SCENE).outstandingBytes, 0u);
+    EXPECT_GT(pool.getAccounting(ScratchBufferPool::Tag::READBACK).outstandingBytes, 0u);
+    EXPECT_EQ(pool.getAccounting(ScratchBufferPool::Tag::FROXELIZER).outstandingBytes, 0u);
+
+    pool.put(a);
+    pool.put(b);
+    EXPECT_EQ(pool.getAccounting(ScratchBufferPool::Tag::SCENE).outstandingBytes, 0u);
+    EXPECT_EQ(pool.getAccounting(ScratchBufferPool::Tag::READBACK).outstandingBytes, 0u);
+}
+
+TEST(ScratchBufferPool, Oversized) {
+    ScratchBufferPool pool;
+
+    // larger than the largest bucket, serviced but not pooled
+    constexpr uint32_t SIZE = 32u << 20;
+    void* const a = pool.get(SIZE, ScratchBufferPool::Tag::OTHER);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(pool.getAccounting(ScratchBufferPool::Tag::OTHER).outstandingBytes, SIZE);
+
+    pool.put(a);
+    auto const accounting = pool.getAccounting(ScratchBufferPool::Tag::OTHER);
+    EXPECT_EQ(accounting.outstandingBytes, 0u);
+    EXPECT_EQ(accounting.pooledBytes, 0u);
+}
+
+TEST(ScratchBufferPool, Trim) {
+    ScratchBufferPool pool;
+
+    void* const a = pool.get(8192, ScratchBufferPool::Tag::SCENE);
+    pool.put(a);
+    EXPECT_GT(pool.getAccounting(ScratchBufferPool::Tag::SCENE).pooledBytes, 0u);
+
+    pool.trim();
+    EXPECT_EQ(pool.getAccounting(ScratchBufferPool::Tag::SCENE).pooledBytes, 0u);
+
+    // the pool grows back transparently after a trim
+    void* const b = pool.get(8192, ScratchBufferPool::Tag::SCENE);
+    ASSERT_NE(b, nullptr);
+    pool.put(b);
+}
@@ -353,6 +353,49 @@ TEST_F(FrameGraphTest, Culling1) {
     fg.execute(driverApi);
 }
 
+TEST_F(FrameGraphTest, ConditionalPass) {
+    struct PassData {
+        FrameGraphId<FrameGraphTexture> out;
+    };
+
+    bool firstExecuted = false;
+    bool secondExecuted = false;
+
+    auto& skipped = fg.addPass<PassData>("Skipped pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.out = builder.create<FrameGraphTexture>("Out0", {.width=16, .height=32});
+                data.out = builder.write(data.out, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                builder.executeWhen([]() { return false; });
+            },
+            [&](FrameGraphResources const&, auto const&, backend::DriverApi&) {
+                firstExecuted = true;
+            });
+
+    auto& executed = fg.addPass<PassData>("Executed pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.out = builder.create<FrameGraphTexture>("Out1", {.width=16, .height=32});
+                data.out = builder.write(data.out, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                builder.executeWhen([]() { return true; });
+            },
+            [&](FrameGraphResources const&, auto const&, backend::DriverApi&) {
+                secondExecuted = true;
+            });
+
+    fg.present(skipped->out);
+    fg.present(executed->out);
+
+    fg.compile();
+
+    // neither pass is culled: the predicate is an execute-time decision
+    EXPECT_FALSE(fg.isCulled(skipped));
+    EXPECT_FALSE(fg.isCulled(executed));
+
+    fg.execute(driverApi);
+
+    EXPECT_FALSE(firstExecuted);
+    EXPECT_TRUE(secondExecuted);
+}
+
 TEST_F(FrameGraphTest, Basic) {
     struct DepthPassData {
         FrameGraphId<FrameGraphTexture> depth;
@@ -31,6 +31,8 @@ namespace camutils {
 
 enum class Fov { VERTICAL, HORIZONTAL };
 
+template <typename FLOAT> class RaycastIndex;
+
 /**
  * Helper that enables camera interaction similar to sketchfab or Google Maps.
  *
@@ -109,6 +111,7 @@ public:
         vec4 groundPlane;
         RayCallback raycastCallback;
         void* raycastUserdata;
+        const RaycastIndex<FLOAT>* raycastIndex;
         bool panning = true;
     };
 
@@ -143,6 +146,7 @@ public:
         // Raycast properties
         Builder& groundPlane(FLOAT a, FLOAT b, FLOAT c, FLOAT d);  //! Plane equation used as a raycast fallback
         Builder& raycastCallback(RayCallback cb, void* userdata);  //! Raycast function for accurate grab-and-pan
+        Builder& raycastIndex(const RaycastIndex<FLOAT>* index);   //! Accelerated raycast over scene bounds, used when no callback is set
 
         Builder& panning(bool enabled);  //! Sets whether panning is enabled
 
@@ -174,8 +178,8 @@ public:
     void getLookAt(vec3* eyePosition, vec3* targetPosition, vec3* upward) const;
 
     /**
-     * Given a viewport coordinate, picks a point in the ground plane, or in the actual scene if the
-     * raycast callback was provided.
+     * Given a viewport coordinate, picks a point in the ground plane, or in the actual scene if a
+     * raycast callback or raycast index was provided.
      */
     bool raycast(int x, int y, vec3* result) const;
 
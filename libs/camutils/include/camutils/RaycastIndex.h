@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CAMUTILS_RAYCASTINDEX_H
+#define CAMUTILS_RAYCASTINDEX_H
+
+#include <camutils/compiler.h>
+
+#include <math/vec3.h>
+
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace filament {
+namespace camutils {
+
+/**
+ * Accelerated raycast over a set of world-space bounding boxes.
+ *
+ * This builds a small bounding-volume hierarchy so that Manipulator can ground its pivot and
+ * zoom-to-cursor queries against the scene at pointer-move frequency, without a round trip
+ * through a per-primitive raycast callback. Clients typically populate it with the world-space
+ * bounds of their renderables and rebuild it when the scene changes.
+ *
+ * Hits are reported against box entry points, which is a conservative approximation of the
+ * underlying geometry; for camera grounding this is generally indistinguishable from an exact
+ * mesh intersection. Clients that need exact hits can keep using the raycast callback.
+ *
+ * @see Manipulator::Builder::raycastIndex
+ */
+template <typename FLOAT>
+class CAMUTILS_PUBLIC RaycastIndex {
+public:
+    using vec3 = filament::math::vec3<FLOAT>;
+
+    /**
+     * Rebuilds the hierarchy over the given world-space boxes.
+     *
+     * The minima / maxima arrays hold the lower and upper corner of each box and are copied,
+     * so they need not outlive this call. Passing a count of zero clears the index, in which
+     * case raycast() always misses.
+     */
+    void setBoxes(const vec3* minima, const vec3* maxima, size_t count);
+
+    /**
+     * Finds the nearest box hit along the given ray.
+     *
+     * The direction is assumed to be normalized. Returns true and writes the distance to the
+     * nearest box entry point into t (zero when the origin is inside a box), or returns false
+     * if the ray misses every box.
+     */
+    bool raycast(const vec3& origin, const vec3& dir, FLOAT* t) const;
+
+    /** Returns the number of boxes the index was built over. */
+    size_t getBoxCount() const { return mBoxes.size(); }
+
+private:
+    struct Box {
+        vec3 minimum;
+        vec3 maximum;
+    };
+
+    struct Node {
+        vec3 minimum;       // world-space AABB lower corner of the subtree
+        vec3 maximum;       // world-space AABB upper corner of the subtree
+        uint32_t left = 0;  // index of the left child (right is left + 1), 0 for leaves
+        uint32_t first = 0; // first entry in mBoxes covered by this subtree
+        uint32_t count = 0; // number of entries covered by this subtree
+    };
+
+    // Leaves batch a few boxes so the per-box loop stays tight.
+    static constexpr size_t LEAF_SIZE = 4;
+
+    uint32_t buildNode(uint32_t first, uint32_t count);
+
+    std::vector<Node> mNodes;
+    std::vector<Box> mBoxes;    // client boxes, partitioned per subtree
+};
+
+} // namespace camutils
+} // namespace filament
+
+#endif /* CAMUTILS_RAYCASTINDEX_H */
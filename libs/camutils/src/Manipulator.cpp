@@ -15,6 +15,7 @@
  */
 
 #include <camutils/Manipulator.h>
+#include <camutils/RaycastIndex.h>
 
 #include <math/scalar.h>
 
@@ -144,6 +145,13 @@ Manipulator<FLOAT>::Builder& Manipulator<FLOAT>::Builder::raycastCallback(RayCal
     return *this;
 }
 
+template <typename FLOAT> typename
+Manipulator<FLOAT>::Builder& Manipulator<FLOAT>::Builder::raycastIndex(
+        const RaycastIndex<FLOAT>* index) {
+    details.raycastIndex = index;
+    return *this;
+}
+
 
 
 template <typename FLOAT> typename
@@ -229,6 +237,13 @@ static bool raycastPlane(const filament::math::vec3<FLOAT>& origin,
     return false;
 }
 
+template<typename FLOAT>
+static bool raycastAccelerated(const filament::math::vec3<FLOAT>& origin,
+        const filament::math::vec3<FLOAT>& dir, FLOAT* t, void* userdata) {
+    auto index = (const RaycastIndex<FLOAT>*) userdata;
+    return index->raycast(origin, dir, t);
+}
+
 template <typename FLOAT>
 void Manipulator<FLOAT>::getRay(int x, int y, vec3* porigin, vec3* pdir) const {
     const vec3 gaze = normalize(mTarget - mEye);
@@ -266,10 +281,14 @@ bool Manipulator<FLOAT>::raycast(int x, int y, vec3* result) const {
     vec3 origin, dir;
     getRay(x, y, &origin, &dir);
 
-    // Choose either the user's callback function or the plane intersector.
+    // Choose the user's callback function, the accelerated index, or the plane intersector.
     auto callback = mProps.raycastCallback;
     auto fallback = raycastPlane<FLOAT>;
     void* userdata = mProps.raycastUserdata;
+    if (!callback && mProps.raycastIndex) {
+        callback = raycastAccelerated<FLOAT>;
+        userdata = (void*) mProps.raycastIndex;
+    }
     if (!callback) {
         callback = fallback;
         userdata = (void*) &mProps;
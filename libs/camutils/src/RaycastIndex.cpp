@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <camutils/RaycastIndex.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace filament::math;
+
+namespace filament {
+namespace camutils {
+
+// Standard slab test. Writes the entry distance (clamped to zero when the origin is inside
+// the box) and returns whether the ray hits the box at all.
+template<typename FLOAT>
+static bool intersectBox(const vec3<FLOAT>& minimum, const vec3<FLOAT>& maximum,
+        const vec3<FLOAT>& origin, const vec3<FLOAT>& invDir, FLOAT* tnear) {
+    const vec3<FLOAT> t0 = (minimum - origin) * invDir;
+    const vec3<FLOAT> t1 = (maximum - origin) * invDir;
+    const vec3<FLOAT> tmin = min(t0, t1);
+    const vec3<FLOAT> tmax = max(t0, t1);
+    const FLOAT enter = std::max(std::max(tmin.x, tmin.y), tmin.z);
+    const FLOAT exit = std::min(std::min(tmax.x, tmax.y), tmax.z);
+    if (exit < 0 || enter > exit) {
+        return false;
+    }
+    *tnear = enter < 0 ? FLOAT(0) : enter;
+    return true;
+}
+
+template <typename FLOAT>
+void RaycastIndex<FLOAT>::setBoxes(const vec3* minima, const vec3* maxima, size_t count) {
+    mNodes.clear();
+    mBoxes.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        mBoxes[i] = { minima[i], maxima[i] };
+    }
+    if (count == 0) {
+        return;
+    }
+    // A binary hierarchy with LEAF_SIZE-bounded leaves never has more than 2n-1 nodes.
+    mNodes.reserve(2 * count);
+    buildNode(0, uint32_t(count));
+}
+
+template <typename FLOAT>
+uint32_t RaycastIndex<FLOAT>::buildNode(uint32_t first, uint32_t count) {
+    const uint32_t nodeIndex = uint32_t(mNodes.size());
+    mNodes.push_back({});
+
+    vec3 minimum = mBoxes[first].minimum;
+    vec3 maximum = mBoxes[first].maximum;
+    for (uint32_t i = first + 1; i < first + count; i++) {
+        minimum = min(minimum, mBoxes[i].minimum);
+        maximum = max(maximum, mBoxes[i].maximum);
+    }
+
+    uint32_t left = 0;
+    if (count > LEAF_SIZE) {
+        // Median split along the longest axis of the subtree bounds.
+        const vec3 extent = maximum - minimum;
+        const int axis = (extent.x > extent.y)
+                ? (extent.x > extent.z ? 0 : 2)
+                : (extent.y > extent.z ? 1 : 2);
+        Box* const begin = mBoxes.data() + first;
+        std::nth_element(begin, begin + count / 2, begin + count,
+                [axis](Box const& lhs, Box const& rhs) {
+                    return lhs.minimum[axis] + lhs.maximum[axis]
+                            < rhs.minimum[axis] + rhs.maximum[axis];
+                });
+        left = buildNode(first, count / 2);
+        buildNode(first + count / 2, count - count / 2);
+    }
+
+    Node& node = mNodes[nodeIndex];
+    node.minimum = minimum;
+    node.maximum = maximum;
+    node.left = left;
+    node.first = first;
+    node.count = count;
+    return nodeIndex;
+}
+
+template <typename FLOAT>
+bool RaycastIndex<FLOAT>::raycast(const vec3& origin, const vec3& dir, FLOAT* t) const {
+    if (mNodes.empty()) {
+        return false;
+    }
+    const vec3 invDir = FLOAT(1) / dir;
+    FLOAT best = std::numeric_limits<FLOAT>::max();
+
+    // The hierarchy is balanced by the median split, so its depth is logarithmic and a small
+    // fixed-size stack is plenty.
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        Node const& node = mNodes[stack[--top]];
+        FLOAT tnear;
+        if (!intersectBox(node.minimum, node.maximum, origin, invDir, &tnear) || tnear >= best) {
+            continue;
+        }
+        if (node.left == 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                if (intersectBox(mBoxes[i].minimum, mBoxes[i].maximum, origin, invDir, &tnear)
+                        && tnear < best) {
+                    best = tnear;
+                }
+            }
+        } else {
+            stack[top++] = node.left;
+            stack[top++] = node.left + 1;
+        }
+    }
+
+    if (best == std::numeric_limits<FLOAT>::max()) {
+        return false;
+    }
+    *t = best;
+    return true;
+}
+
+template class RaycastIndex<float>;
+
+} // namespace camutils
+} // namespace filament
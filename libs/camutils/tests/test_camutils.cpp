@@ -16,9 +16,12 @@
 
 #include <camutils/Bookmark.h>
 #include <camutils/Manipulator.h>
+#include <camutils/RaycastIndex.h>
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 using namespace filament::math;
 
 namespace camutils = filament::camutils;
@@ -79,6 +82,67 @@ TEST_F(CamUtilsTest, Map) {
     delete map;
 }
 
+TEST_F(CamUtilsTest, RaycastIndex) {
+    // A grid of unit boxes along the x axis, plus one box behind the camera.
+    std::vector<float3> minima, maxima;
+    for (int i = 0; i < 100; i++) {
+        minima.push_back(float3(i * 2.0f, -0.5f, -0.5f));
+        maxima.push_back(float3(i * 2.0f + 1.0f, 0.5f, 0.5f));
+    }
+
+    camutils::RaycastIndex<float> index;
+    index.setBoxes(minima.data(), maxima.data(), minima.size());
+    EXPECT_EQ(index.getBoxCount(), 100u);
+
+    float t;
+
+    // A ray down the x axis enters the first box.
+    ASSERT_TRUE(index.raycast(float3(-3, 0, 0), float3(1, 0, 0), &t));
+    EXPECT_FLOAT_EQ(t, 3.0f);
+
+    // A ray perpendicular to the grid hits the box it crosses.
+    ASSERT_TRUE(index.raycast(float3(8.5f, 0, -4), float3(0, 0, 1), &t));
+    EXPECT_FLOAT_EQ(t, 3.5f);
+
+    // A ray starting inside a box reports a zero distance.
+    ASSERT_TRUE(index.raycast(float3(0.5f, 0, 0), float3(1, 0, 0), &t));
+    EXPECT_FLOAT_EQ(t, 0.0f);
+
+    // A ray above the grid misses everything.
+    EXPECT_FALSE(index.raycast(float3(-3, 2, 0), float3(1, 0, 0), &t));
+
+    // An empty index always misses.
+    index.setBoxes(nullptr, nullptr, 0);
+    EXPECT_FALSE(index.raycast(float3(-3, 0, 0), float3(1, 0, 0), &t));
+}
+
+TEST_F(CamUtilsTest, OrbitRaycastIndex) {
+    // A unit box centered at the origin, with the camera looking straight at it.
+    const float3 minimum(-0.5f, -0.5f, -0.5f);
+    const float3 maximum(0.5f, 0.5f, 0.5f);
+
+    camutils::RaycastIndex<float> index;
+    index.setBoxes(&minimum, &maximum, 1);
+
+    CamManipulator* orbit = CamManipulator::Builder()
+        .viewport(256, 256)
+        .targetPosition(0, 0, 0)
+        .orbitHomePosition(0, 0, 4)
+        .raycastIndex(&index)
+        .build(camutils::Mode::ORBIT);
+
+    // The center pixel grounds on the front face of the box.
+    float3 result;
+    ASSERT_TRUE(orbit->raycast(128, 128, &result));
+    EXPECT_NEAR(result.z, 0.5f, 0.01f);
+
+    // A corner pixel misses the box and falls back to the ground plane.
+    ASSERT_TRUE(orbit->raycast(0, 0, &result));
+    EXPECT_GT(distance(result, float3(0, 0, 0.5f)), 1.0f);
+
+    delete orbit;
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
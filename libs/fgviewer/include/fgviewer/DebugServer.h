@@ -22,6 +22,7 @@
 #include <utils/CString.h>
 #include <utils/Mutex.h>
 
+#include <deque>
 #include <unordered_map>
 #include <vector>
 
@@ -31,6 +32,26 @@ namespace filament::fgviewer {
 
 using ViewHandle = uint32_t;
 
+/**
+ * A compiled frame graph retained for frame-over-frame comparison. Consecutive
+ * identical graphs are collapsed into a single snapshot; firstFrame/lastFrame
+ * record the range of updates during which this graph was current.
+ */
+struct FrameGraphSnapshot {
+    uint64_t firstFrame;
+    uint64_t lastFrame;
+    FrameGraphInfo info;
+};
+
+/**
+ * Per-view record: the number of updates received so far and a bounded history
+ * of the distinct graphs seen, oldest first. back() is the current graph.
+ */
+struct ViewHistory {
+    uint64_t frameCount = 0;
+    std::deque<FrameGraphSnapshot> snapshots;
+};
+
 /**
  * Server-side frame graph debugger.
  *
@@ -56,16 +77,22 @@ public:
     void destroyView(ViewHandle h);
 
     /**
-     * Updates the information for a given view.
+     * Updates the information for a given view. When the compiled graph differs from the
+     * previous one a new snapshot is recorded, so clients can diff consecutive graphs and
+     * chart transient memory over time; otherwise only the current snapshot's frame range
+     * is extended.
      */
     void update(ViewHandle h, FrameGraphInfo info);
 
     bool isReady() const { return mServer; }
 
+    // Maximum number of distinct graphs retained per view; older snapshots are dropped.
+    static constexpr size_t kMaxSnapshots = 32;
+
 private:
     CivetServer* mServer;
 
-    std::unordered_map<ViewHandle, FrameGraphInfo> mViews;
+    std::unordered_map<ViewHandle, ViewHistory> mViews;
     uint32_t mViewCounter = 0;
     mutable utils::Mutex mViewsMutex;
 
@@ -82,6 +82,11 @@ public:
 
     const char* getViewName() const;
 
+    // Sums the "size_bytes" property over all resources, skipping subresources
+    // (which alias their parent's memory). Returns 0 when the producer didn't
+    // provide sizes.
+    uint64_t getTransientBytes() const;
+
     const std::vector<Pass>& getPasses() const;
 
     const std::unordered_map<ResourceId, Resource>& getResources() const;
@@ -17,11 +17,13 @@
 #ifndef FGVIEWER_JSONWRITER_H
 #define FGVIEWER_JSONWRITER_H
 
+#include <fgviewer/DebugServer.h>
+
 #include <utils/CString.h>
 
 namespace filament::fgviewer {
 
-struct FrameGraphInfo;
+class FrameGraphInfo;
 
 // This class generates portions of JSON messages that are sent to the web client.
 // Note that some portions of these JSON strings are generated by directly in DebugServer,
@@ -36,6 +38,15 @@ public:
     // Generates a JSON string describing the given FrameGraphInfo.
     bool writeFrameGraphInfo(const FrameGraphInfo& frameGraph);
 
+    // Generates a JSON string summarizing each retained snapshot of a view (frame range,
+    // pass and resource counts, estimated transient bytes), oldest first. This backs the
+    // transient-memory-over-time chart.
+    bool writeFrameGraphHistory(const ViewHistory& view);
+
+    // Generates a JSON string describing the pass and resource churn between two compiled
+    // graphs: passes and resources added or removed, and resources whose size changed.
+    bool writeFrameGraphDiff(const FrameGraphInfo& base, const FrameGraphInfo& other);
+
 private:
     utils::CString mJsonString;
 };
@@ -66,7 +66,7 @@ bool ApiHandler::handleGet(CivetServer* server, struct mg_connection* conn) {
             bool const last = (++index) == mServer->mViews.size();
 
             JsonWriter writer;
-            if (!writer.writeFrameGraphInfo(view.second)) {
+            if (!writer.writeFrameGraphInfo(view.second.snapshots.back().info)) {
                 return error(__LINE__, uri);
             }
 
@@ -92,9 +92,73 @@ bool ApiHandler::handleGet(CivetServer* server, struct mg_connection* conn) {
         return true;
     }
 
+    if (uri == "/api/framegraph_history") {
+        return handleGetHistory(conn, request);
+    }
+
+    if (uri == "/api/framegraph_diff") {
+        return handleGetDiff(conn, request);
+    }
+
     return error(__LINE__, uri);
 }
 
+bool ApiHandler::handleGetHistory(struct mg_connection* conn,
+        struct mg_request_info const* request) {
+    std::unique_lock const lock(mServer->mViewsMutex);
+    const ViewHistory* view = getViewHistory(request);
+    if (!view) {
+        return error(__LINE__, request->local_uri);
+    }
+
+    JsonWriter writer;
+    if (!writer.writeFrameGraphHistory(*view)) {
+        return error(__LINE__, request->local_uri);
+    }
+    mg_printf(conn, kSuccessHeader.data(), "application/json");
+    mg_printf(conn, "{ %s }", writer.getJsonString());
+    return true;
+}
+
+bool ApiHandler::handleGetDiff(struct mg_connection* conn,
+        struct mg_request_info const* request) {
+    std::unique_lock const lock(mServer->mViewsMutex);
+    const ViewHistory* view = getViewHistory(request);
+    if (!view) {
+        return error(__LINE__, request->local_uri);
+    }
+
+    // The base and other query parameters index into the snapshot list served by
+    // /api/framegraph_history; by default the two most recent snapshots are compared.
+    size_t const count = view->snapshots.size();
+    if (count < 2) {
+        return error(__LINE__, request->local_uri);
+    }
+    size_t base = count - 2;
+    size_t other = count - 1;
+
+    size_t const qlength = strlen(request->query_string);
+    char value[16] = {};
+    if (mg_get_var(request->query_string, qlength, "base", value, sizeof(value)) > 0) {
+        base = strtoul(value, nullptr, 10);
+    }
+    if (mg_get_var(request->query_string, qlength, "other", value, sizeof(value)) > 0) {
+        other = strtoul(value, nullptr, 10);
+    }
+    if (base >= count || other >= count) {
+        return error(__LINE__, request->local_uri);
+    }
+
+    JsonWriter writer;
+    if (!writer.writeFrameGraphDiff(view->snapshots[base].info, view->snapshots[other].info)) {
+        return error(__LINE__, request->local_uri);
+    }
+    mg_printf(conn, kSuccessHeader.data(), "application/json");
+    mg_printf(conn, "{ \"base\": %zu, \"other\": %zu,\n%s }", base, other,
+            writer.getJsonString());
+    return true;
+}
+
 void ApiHandler::updateFrameGraph(ViewHandle view_handle) {
     std::unique_lock const lock(mStatusMutex);
     snprintf(statusFrameGraphId, sizeof(statusFrameGraphId), "%8.8x", view_handle);
@@ -102,20 +166,25 @@ void ApiHandler::updateFrameGraph(ViewHandle view_handle) {
     mStatusCondition.notify_all();
 }
 
-const FrameGraphInfo* ApiHandler::getFrameGraphInfo(struct mg_request_info const* request) {
+const ViewHistory* ApiHandler::getViewHistory(struct mg_request_info const* request) {
     size_t const qlength = strlen(request->query_string);
     char fgid[9] = {};
     if (mg_get_var(request->query_string, qlength, "fgid", fgid, sizeof(fgid)) < 0) {
         return nullptr;
     }
     uint32_t const id = strtoul(fgid, nullptr, 16);
-    std::unique_lock const lock(mServer->mViewsMutex);
     const auto it = mServer->mViews.find(id);
     return it == mServer->mViews.end()
         ? nullptr
         : &(it->second);
 }
 
+const FrameGraphInfo* ApiHandler::getFrameGraphInfo(struct mg_request_info const* request) {
+    std::unique_lock const lock(mServer->mViewsMutex);
+    const ViewHistory* view = getViewHistory(request);
+    return view ? &(view->snapshots.back().info) : nullptr;
+}
+
 bool ApiHandler::handleGetStatus(struct mg_connection* conn,
                                  struct mg_request_info const* request) {
     char const* qstr = request->query_string;
@@ -19,17 +19,23 @@
 
 #include <fgviewer/DebugServer.h>
 
+#include <condition_variable>
+#include <mutex>
+
 #include <CivetServer.h>
 
 namespace filament::fgviewer {
 
 class DebugServer;
-struct FrameGraphInfo;
+class FrameGraphInfo;
+struct ViewHistory;
 
 // Handles the following REST requests, where {id} is an 8-digit hex string.
 //
 //    GET /api/framegraphs
 //    GET /api/framegraph?fg={fgid}
+//    GET /api/framegraph_history?fg={fgid}
+//    GET /api/framegraph_diff?fg={fgid}&base={index}&other={index}
 //    GET /api/status
 //
 class ApiHandler : public CivetHandler {
@@ -43,11 +49,20 @@ public:
     void updateFrameGraph(ViewHandle view_handle);
 
 private:
+    // The caller must hold mServer->mViewsMutex.
+    const ViewHistory* getViewHistory(struct mg_request_info const* request);
+
     const FrameGraphInfo* getFrameGraphInfo(struct mg_request_info const* request);
 
     bool handleGetStatus(struct mg_connection* conn,
                          struct mg_request_info const* request);
 
+    bool handleGetHistory(struct mg_connection* conn,
+                          struct mg_request_info const* request);
+
+    bool handleGetDiff(struct mg_connection* conn,
+                       struct mg_request_info const* request);
+
     DebugServer* mServer;
 
     std::mutex mStatusMutex;
@@ -161,7 +161,9 @@ DebugServer::~DebugServer() {
 ViewHandle DebugServer::createView(utils::CString name) {
     std::unique_lock<utils::Mutex> lock(mViewsMutex);
     ViewHandle handle = mViewCounter++;
-    mViews.emplace(handle, FrameGraphInfo(std::move(name)));
+    ViewHistory& view = mViews[handle];
+    view.snapshots.push_back({0, 0, FrameGraphInfo(std::move(name))});
+    view.frameCount = 1;
     mApiHandler->updateFrameGraph(handle);
 
     return handle;
@@ -180,12 +182,19 @@ void DebugServer::update(ViewHandle h, FrameGraphInfo info) {
         return;
     }
 
-    bool has_changed = !(it->second == info);
-    if (!has_changed)
+    ViewHistory& view = it->second;
+    const uint64_t frame = view.frameCount++;
+
+    bool has_changed = view.snapshots.empty() || !(view.snapshots.back().info == info);
+    if (!has_changed) {
+        view.snapshots.back().lastFrame = frame;
         return;
+    }
 
-    mViews.erase(h);
-    mViews.emplace(h, std::move(info));
+    view.snapshots.push_back({frame, frame, std::move(info)});
+    if (view.snapshots.size() > kMaxSnapshots) {
+        view.snapshots.pop_front();
+    }
     mApiHandler->updateFrameGraph(h);
 }
 
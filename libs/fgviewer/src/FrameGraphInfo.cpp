@@ -18,6 +18,8 @@
 
 #include <utils/CString.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <unordered_map>
 #include <vector>
 
@@ -75,6 +77,25 @@ const char* FrameGraphInfo::getViewName() const {
     return viewName.c_str_safe();
 }
 
+uint64_t FrameGraphInfo::getTransientBytes() const {
+    uint64_t total = 0;
+    for (const auto& [id, resource] : resources) {
+        uint64_t sizeBytes = 0;
+        bool isSubresource = false;
+        for (const auto& property : resource.properties) {
+            if (strcmp(property.name.c_str_safe(), "size_bytes") == 0) {
+                sizeBytes = strtoull(property.value.c_str_safe(), nullptr, 10);
+            } else if (strcmp(property.name.c_str_safe(), "is_subresource_of") == 0) {
+                isSubresource = true;
+            }
+        }
+        if (!isSubresource) {
+            total += sizeBytes;
+        }
+    }
+    return total;
+}
+
 const std::vector<FrameGraphInfo::Pass>& FrameGraphInfo::getPasses() const {
     return passes;
 }
@@ -14,14 +14,20 @@
  * limitations under the License.
  */
 
+#include <fgviewer/DebugServer.h>
 #include <fgviewer/FrameGraphInfo.h>
 #include <fgviewer/JsonWriter.h>
 
 #include <utils/CString.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <ostream>
 #include <sstream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace filament::fgviewer {
@@ -116,6 +122,24 @@ void writeResources(std::ostream& os, const FrameGraphInfo& frameGraph) {
     os << "  }\n";
 }
 
+uint64_t getResourceSizeBytes(const FrameGraphInfo::Resource& resource) {
+    for (const auto& [key, value] : resource.properties) {
+        if (strcmp(key.c_str_safe(), "size_bytes") == 0) {
+            return strtoull(value.c_str_safe(), nullptr, 10);
+        }
+    }
+    return 0;
+}
+
+void writeStringArray(std::ostream& os, const std::vector<const char*>& strings) {
+    os << "[";
+    for (size_t i = 0; i < strings.size(); ++i) {
+        writeJSONString(os, strings[i]);
+        if (i + 1 < strings.size()) os << ", ";
+    }
+    os << "]";
+}
+
 void writeGraphviz(std::ostream& os, const FrameGraphInfo& frameGraph) {
     const char* graphvizString = frameGraph.getGraphvizData();
 
@@ -150,4 +174,102 @@ bool JsonWriter::writeFrameGraphInfo(const FrameGraphInfo& frameGraph) {
     return true;
 }
 
+bool JsonWriter::writeFrameGraphHistory(const ViewHistory& view) {
+    std::ostringstream os;
+
+    os << "  \"frameCount\": " << view.frameCount << ",\n";
+    os << "  \"snapshots\": [\n";
+    for (size_t i = 0; i < view.snapshots.size(); ++i) {
+        const FrameGraphSnapshot& snapshot = view.snapshots[i];
+        os << "    {\n";
+        os << "      \"firstFrame\": " << snapshot.firstFrame << ",\n";
+        os << "      \"lastFrame\": " << snapshot.lastFrame << ",\n";
+        os << "      \"passCount\": " << snapshot.info.getPasses().size() << ",\n";
+        os << "      \"resourceCount\": " << snapshot.info.getResources().size() << ",\n";
+        os << "      \"transientBytes\": " << snapshot.info.getTransientBytes() << "\n";
+        os << "    }";
+        if (i + 1 < view.snapshots.size()) os << ",";
+        os << "\n";
+    }
+    os << "  ]\n";
+
+    mJsonString = utils::CString(os.str().c_str());
+    return true;
+}
+
+bool JsonWriter::writeFrameGraphDiff(const FrameGraphInfo& base, const FrameGraphInfo& other) {
+    std::ostringstream os;
+
+    // Passes and resources are matched by name rather than id, since ids are assigned
+    // anew every time the graph is compiled.
+    std::vector<const char*> addedPasses, removedPasses;
+    for (const auto& pass : other.getPasses()) {
+        const auto& basePasses = base.getPasses();
+        bool const found = std::any_of(basePasses.begin(), basePasses.end(),
+                [&pass](const auto& p) { return p.name == pass.name; });
+        if (!found) addedPasses.push_back(pass.name.c_str_safe());
+    }
+    for (const auto& pass : base.getPasses()) {
+        const auto& otherPasses = other.getPasses();
+        bool const found = std::any_of(otherPasses.begin(), otherPasses.end(),
+                [&pass](const auto& p) { return p.name == pass.name; });
+        if (!found) removedPasses.push_back(pass.name.c_str_safe());
+    }
+
+    std::unordered_map<std::string, uint64_t> baseSizes, otherSizes;
+    for (const auto& [id, resource] : base.getResources()) {
+        baseSizes.emplace(resource.name.c_str_safe(), getResourceSizeBytes(resource));
+    }
+    for (const auto& [id, resource] : other.getResources()) {
+        otherSizes.emplace(resource.name.c_str_safe(), getResourceSizeBytes(resource));
+    }
+
+    os << "  \"addedPasses\": ";
+    writeStringArray(os, addedPasses);
+    os << ",\n";
+    os << "  \"removedPasses\": ";
+    writeStringArray(os, removedPasses);
+    os << ",\n";
+
+    auto writeResourceDelta = [&os](const char* key,
+            const std::unordered_map<std::string, uint64_t>& from,
+            const std::unordered_map<std::string, uint64_t>& to) {
+        os << "  \"" << key << "\": [";
+        bool first = true;
+        for (const auto& [name, sizeBytes] : to) {
+            if (from.find(name) != from.end()) continue;
+            if (!first) os << ", ";
+            first = false;
+            os << "{ \"name\": ";
+            writeJSONString(os, name.c_str());
+            os << ", \"sizeBytes\": " << sizeBytes << " }";
+        }
+        os << "]";
+    };
+    writeResourceDelta("addedResources", baseSizes, otherSizes);
+    os << ",\n";
+    writeResourceDelta("removedResources", otherSizes, baseSizes);
+    os << ",\n";
+
+    os << "  \"resizedResources\": [";
+    bool first = true;
+    for (const auto& [name, sizeBytes] : otherSizes) {
+        const auto it = baseSizes.find(name);
+        if (it == baseSizes.end() || it->second == sizeBytes) continue;
+        if (!first) os << ", ";
+        first = false;
+        os << "{ \"name\": ";
+        writeJSONString(os, name.c_str());
+        os << ", \"baseSizeBytes\": " << it->second
+           << ", \"otherSizeBytes\": " << sizeBytes << " }";
+    }
+    os << "],\n";
+
+    os << "  \"baseTransientBytes\": " << base.getTransientBytes() << ",\n";
+    os << "  \"otherTransientBytes\": " << other.getTransientBytes() << "\n";
+
+    mJsonString = utils::CString(os.str().c_str());
+    return true;
+}
+
 } // namespace filament::fgviewer
@@ -187,6 +187,10 @@ struct PerViewUib { // NOLINT(cppcoreguidelines-pro-type-member-init)
     float ssrBias;                      // ssr bias, in world units
     float ssrDistance;                  // ssr world raycast distance, 0 when ssr is off
     float ssrStride;                    // ssr texel stride, >= 1.0
+    int32_t ssrTracePattern;            // which quadrant of the 2x2 pattern is traced this frame
+    float ssrHistoryWeight;             // history weight for non-traced pixels, 0 = full-rate
+    float ssrReserved0;
+    float ssrReserved1;
 
     // --------------------------------------------------------------------------------------------
     // user defined global variables
@@ -202,7 +206,7 @@ struct PerViewUib { // NOLINT(cppcoreguidelines-pro-type-member-init)
     float es2Reserved2;
 
     // bring PerViewUib to 2 KiB
-    math::float4 reserved[40];
+    math::float4 reserved[39];
 };
 
 // 2 KiB == 128 float4s
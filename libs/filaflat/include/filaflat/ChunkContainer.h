@@ -29,7 +29,37 @@
 namespace filaflat {
 
 using ShaderContent = utils::FixedCapacityVector<uint8_t>;
-using BlobDictionary = utils::FixedCapacityVector<ShaderContent>;
+
+// A shader blob held by a BlobDictionary: either borrowed from the ChunkContainer's data --
+// which outlives the dictionary, so text and Metal library dictionaries are used in place
+// rather than keeping the shader data resident twice -- or owning its storage when the blob
+// had to be decoded on load (SPIR-V).
+class Blob {
+public:
+    Blob() noexcept = default;
+
+    // borrowed, the pointed-to data must outlive this Blob
+    Blob(const void* data, size_t const size) noexcept
+            : mData(static_cast<uint8_t const*>(data)), mSize(size) {}
+
+    // owned
+    explicit Blob(ShaderContent&& content) noexcept
+            : mStorage(std::move(content)), mData(mStorage.data()), mSize(mStorage.size()) {}
+
+    // the default move is fine: the storage's heap buffer doesn't move with it
+    Blob(Blob&& rhs) noexcept = default;
+    Blob& operator=(Blob&& rhs) noexcept = default;
+
+    uint8_t const* data() const noexcept { return mData; }
+    size_t size() const noexcept { return mSize; }
+
+private:
+    ShaderContent mStorage{};
+    uint8_t const* mData = nullptr;
+    size_t mSize = 0;
+};
+
+using BlobDictionary = utils::FixedCapacityVector<Blob>;
 
 class Unflattener;
 
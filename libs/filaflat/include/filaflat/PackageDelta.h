@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAFLAT_PACKAGE_DELTA_H
+#define TNT_FILAFLAT_PACKAGE_DELTA_H
+
+#include <utils/compiler.h>
+
+#include <utils/FixedCapacityVector.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filaflat {
+
+// Chunk-level binary deltas between two material packages.
+//
+// A package edit (e.g. a live shader tweak) typically rewrites a single chunk and leaves the
+// rest of the container untouched. Instead of shipping the whole package again, a delta lists
+// the chunks of the updated package in order: chunks whose content hash matches a chunk of the
+// base package are encoded as a copy reference, everything else is carried verbatim. Applying
+// the delta to the base package reconstructs the updated package byte for byte.
+//
+// Deltas are self-identifying (see isDelta()), so they can share a transport with whole
+// packages: receivers apply anything that carries the delta magic against the previous version
+// and pass everything else through unchanged.
+class UTILS_PUBLIC PackageDelta {
+public:
+    // Returns true if the given buffer starts with the delta magic.
+    static bool isDelta(void const* data, size_t size) noexcept;
+
+    // Computes a delta that reconstructs the updated package from the base package.
+    // Returns an empty vector if either buffer is not a parsable chunk stream.
+    static utils::FixedCapacityVector<uint8_t> computeDelta(
+            void const* base, size_t baseSize,
+            void const* updated, size_t updatedSize);
+
+    // Reconstructs the updated package by applying a delta to the base package.
+    // Returns an empty vector if the delta is malformed or references chunks that the
+    // base package doesn't have.
+    static utils::FixedCapacityVector<uint8_t> applyDelta(
+            void const* base, size_t baseSize,
+            void const* delta, size_t deltaSize);
+};
+
+} // namespace filaflat
+
+#endif // TNT_FILAFLAT_PACKAGE_DELTA_H
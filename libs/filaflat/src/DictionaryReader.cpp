@@ -71,7 +71,8 @@ bool DictionaryReader::unflatten(ChunkContainer const& container,
             if (!smolv::Decode(compressed, compressedSize, spirv.data(), spirvSize)) {
                 return false;
             }
-            dictionary.emplace_back(std::move(spirv));
+            // decoded SPIR-V has no backing in the container, the blob owns it
+            dictionary.emplace_back(Blob{ std::move(spirv) });
 #else
             return false;
 #endif
@@ -93,8 +94,8 @@ bool DictionaryReader::unflatten(ChunkContainer const& container,
             if (!unflattener.read(&data, &dataSize)) {
                 return false;
             }
-            dictionary.emplace_back(dataSize);
-            memcpy(dictionary.back().data(), data, dictionary.back().size());
+            // used in place from the container's data
+            dictionary.emplace_back(data, dataSize);
         }
         return true;
     } else if (dictionaryTag == ChunkType::DictionaryText) {
@@ -110,9 +111,9 @@ bool DictionaryReader::unflatten(ChunkContainer const& container,
                 return false;
             }
             // BlobDictionary hold binary chunks and does not care if the data holds text, it is
-            // therefore crucial to include the trailing null.
-            dictionary.emplace_back(strlen(str) + 1);
-            memcpy(dictionary.back().data(), str, dictionary.back().size());
+            // therefore crucial to include the trailing null. The string is used in place from
+            // the container's data, which keeps the shader text resident only once.
+            dictionary.emplace_back(str, strlen(str) + 1);
         }
         return true;
     }
@@ -166,7 +166,9 @@ bool MaterialChunk::getBinaryShader(BlobDictionary const& dictionary,
         return false;
     }
 
-    shaderContent = dictionary[pos->second];
+    Blob const& blob = dictionary[pos->second];
+    shaderContent = ShaderContent(blob.size());
+    memcpy(shaderContent.data(), blob.data(), blob.size());
     return true;
 }
 
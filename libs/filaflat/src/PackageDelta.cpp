@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <filaflat/PackageDelta.h>
+
+#include <filaflat/Unflattener.h>
+
+#include <utils/Hash.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <string.h>
+
+namespace filaflat {
+
+// The delta format mirrors the chunk stream it encodes. After an 8-byte magic, each record is:
+//   uint64 chunkType, uint8 op
+//   op == RAW:  uint32 payloadSize, payload bytes
+//   op == COPY: uint32 payloadSize, uint32 payloadHash
+// A COPY record refers to the base chunk of the same type whose payload hashes to payloadHash.
+
+static constexpr uint64_t DELTA_MAGIC = 0x464c415444454c54ull; // "FLATDELT"
+static constexpr uint8_t OP_RAW = 0;
+static constexpr uint8_t OP_COPY = 1;
+
+static constexpr uint32_t HASH_SEED = 42;
+
+namespace {
+
+struct ChunkRef {
+    uint64_t type;
+    uint8_t const* payload;
+    uint32_t size;
+    uint32_t hash;
+};
+
+// Walks a raw chunk stream in order; the robin_map in ChunkContainer would lose the chunk
+// order, which the reconstructed package must preserve.
+bool parseChunkStream(void const* data, size_t size, std::vector<ChunkRef>* out) {
+    uint8_t const* const begin = static_cast<uint8_t const*>(data);
+    Unflattener unflattener(begin, begin + size);
+    while (unflattener.hasData()) {
+        uint64_t type;
+        uint32_t chunkSize;
+        if (!unflattener.read(&type) || !unflattener.read(&chunkSize) ||
+                unflattener.willOverflow(chunkSize)) {
+            return false;
+        }
+        uint8_t const* const payload = unflattener.getCursor();
+        out->push_back({ type, payload, chunkSize,
+                utils::hash::murmurSlow(payload, chunkSize, HASH_SEED) });
+        unflattener.setCursor(payload + chunkSize);
+    }
+    return true;
+}
+
+template<typename T>
+void append(std::vector<uint8_t>& buffer, T value) {
+    for (size_t i = 0; i < sizeof(T); i++) {
+        buffer.push_back(uint8_t(value >> (8 * i)));
+    }
+}
+
+utils::FixedCapacityVector<uint8_t> copyToVector(std::vector<uint8_t> const& buffer) {
+    auto result = utils::FixedCapacityVector<uint8_t>::with_capacity(buffer.size());
+    result.resize(buffer.size());
+    memcpy(result.data(), buffer.data(), buffer.size());
+    return result;
+}
+
+} // anonymous namespace
+
+bool PackageDelta::isDelta(void const* data, size_t size) noexcept {
+    uint8_t const* const begin = static_cast<uint8_t const*>(data);
+    Unflattener unflattener(begin, begin + size);
+    uint64_t magic;
+    return unflattener.read(&magic) && magic == DELTA_MAGIC;
+}
+
+utils::FixedCapacityVector<uint8_t> PackageDelta::computeDelta(
+        void const* base, size_t baseSize, void const* updated, size_t updatedSize) {
+    std::vector<ChunkRef> baseChunks;
+    std::vector<ChunkRef> updatedChunks;
+    if (!parseChunkStream(base, baseSize, &baseChunks) ||
+            !parseChunkStream(updated, updatedSize, &updatedChunks)) {
+        return {};
+    }
+
+    std::vector<uint8_t> delta;
+    delta.reserve(updatedSize / 16);
+    append(delta, DELTA_MAGIC);
+
+    for (ChunkRef const& chunk : updatedChunks) {
+        auto const pos = std::find_if(baseChunks.begin(), baseChunks.end(),
+                [&chunk](ChunkRef const& candidate) {
+                    return candidate.type == chunk.type && candidate.hash == chunk.hash &&
+                            candidate.size == chunk.size;
+                });
+        append(delta, chunk.type);
+        if (pos != baseChunks.end()) {
+            append(delta, OP_COPY);
+            append(delta, chunk.size);
+            append(delta, chunk.hash);
+        } else {
+            append(delta, OP_RAW);
+            append(delta, chunk.size);
+            delta.insert(delta.end(), chunk.payload, chunk.payload + chunk.size);
+        }
+    }
+    return copyToVector(delta);
+}
+
+utils::FixedCapacityVector<uint8_t> PackageDelta::applyDelta(
+        void const* base, size_t baseSize, void const* delta, size_t deltaSize) {
+    std::vector<ChunkRef> baseChunks;
+    if (!parseChunkStream(base, baseSize, &baseChunks)) {
+        return {};
+    }
+
+    uint8_t const* const begin = static_cast<uint8_t const*>(delta);
+    Unflattener unflattener(begin, begin + deltaSize);
+    uint64_t magic;
+    if (!unflattener.read(&magic) || magic != DELTA_MAGIC) {
+        return {};
+    }
+
+    std::vector<uint8_t> package;
+    package.reserve(baseSize);
+    while (unflattener.hasData()) {
+        uint64_t type;
+        uint8_t op;
+        uint32_t size;
+        if (!unflattener.read(&type) || !unflattener.read(&op) || !unflattener.read(&size)) {
+            return {};
+        }
+        append(package, type);
+        append(package, size);
+        if (op == OP_RAW) {
+            if (unflattener.willOverflow(size)) {
+                return {};
+            }
+            uint8_t const* const payload = unflattener.getCursor();
+            package.insert(package.end(), payload, payload + size);
+            unflattener.setCursor(payload + size);
+        } else if (op == OP_COPY) {
+            uint32_t hash;
+            if (!unflattener.read(&hash)) {
+                return {};
+            }
+            auto const pos = std::find_if(baseChunks.begin(), baseChunks.end(),
+                    [type, hash, size](ChunkRef const& candidate) {
+                        return candidate.type == type && candidate.hash == hash &&
+                                candidate.size == size;
+                    });
+            if (pos == baseChunks.end()) {
+                return {};
+            }
+            package.insert(package.end(), pos->payload, pos->payload + pos->size);
+        } else {
+            return {};
+        }
+    }
+    return copyToVector(package);
+}
+
+} // namespace filaflat
@@ -21,6 +21,10 @@
 
 struct ImVec2;
 
+namespace filament {
+class Engine;
+} // namespace filament
+
 /**
  * Namespace for custom widgets that follow the API conventions used by ImGui.
  * For example, the prototype for ImGuiExt::DirectionWidget is similar to ImGui::DragFloat3.
@@ -54,6 +58,15 @@ namespace ImGuiExt {
             void (*series_end)(int series),
             void* data, int values_count, int values_offset, const char* overlay_text,
             float scale_min, float scale_max, ImVec2 graph_size);
+
+    /**
+     * Draws a table with the engine's per-pass attachment bandwidth estimates, along with the
+     * draw-call count of the last color pass. The data comes from the "d.renderer.pass_stats"
+     * data source and the "d.renderer.draw_calls" counter, which the engine refreshes each
+     * frame, so this can simply be called from the app's UI callback.
+     */
+    UTILS_PUBLIC
+    void PassBandwidthTable(filament::Engine& engine);
 }
 
 #endif // FILAGUI_IMGUIEXTENSIONS_H
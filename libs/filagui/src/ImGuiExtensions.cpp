@@ -19,11 +19,17 @@
 #include <imgui.h>
 #include <imgui_internal.h>
 
+#include <filament/DebugRegistry.h>
+#include <filament/Engine.h>
+
 #include <math/scalar.h>
 #include <math/vec3.h>
 #include <math/quat.h>
 
 #include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <iterator>
 #include <limits>
 
 using namespace filament::math;
@@ -211,6 +217,57 @@ void PlotLinesSeries(const char* label, int series_count,
             data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size);
 }
 
+void PassBandwidthTable(filament::Engine& engine) {
+    using filament::DebugRegistry;
+    DebugRegistry& debug = engine.getDebugRegistry();
+
+    uint64_t drawCalls = 0;
+    DebugRegistry::CounterSnapshot counters[32];
+    size_t const counterCount = std::min(
+            debug.snapshotCounters(counters, std::size(counters)), std::size(counters));
+    for (size_t i = 0; i < counterCount; i++) {
+        if (!strcmp(counters[i].name, "d.renderer.draw_calls")) {
+            drawCalls = counters[i].u64;
+        }
+    }
+    ImGui::Text("Draw calls: %" PRIu64, drawCalls);
+
+    auto const source = debug.getDataSource("d.renderer.pass_stats");
+    if (!source.data || !source.count) {
+        return;
+    }
+    auto const* const stats = static_cast<DebugRegistry::PassStats const*>(source.data);
+
+    constexpr double MiB = 1024.0 * 1024.0;
+    if (ImGui::BeginTable("pass_stats", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersH)) {
+        ImGui::TableSetupColumn("Pass");
+        ImGui::TableSetupColumn("Load (MiB)", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Store (MiB)", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableHeadersRow();
+        uint64_t totalRead = 0;
+        uint64_t totalWrite = 0;
+        for (size_t i = 0; i < source.count && stats[i].name[0]; i++) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(stats[i].name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%7.2f", double(stats[i].attachmentReadBytes) / MiB);
+            ImGui::TableNextColumn();
+            ImGui::Text("%7.2f", double(stats[i].attachmentWriteBytes) / MiB);
+            totalRead += stats[i].attachmentReadBytes;
+            totalWrite += stats[i].attachmentWriteBytes;
+        }
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted("Total");
+        ImGui::TableNextColumn();
+        ImGui::Text("%7.2f", double(totalRead) / MiB);
+        ImGui::TableNextColumn();
+        ImGui::Text("%7.2f", double(totalWrite) / MiB);
+        ImGui::EndTable();
+    }
+}
+
 } // namespace ImGuiExt
 
 ArrowWidget::ArrowWidget(float3 direction) {
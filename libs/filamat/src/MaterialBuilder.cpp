@@ -919,11 +919,12 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
     std::atomic_bool cancelJobs(false);
     bool firstJob = true;
 
-    for (const auto& params : mCodeGenPermutations) {
-        if (cancelJobs.load()) {
-            return false;
-        }
+    // All permutations and variants are fanned out under a single root job, so that
+    // different target APIs post-process concurrently instead of each permutation's
+    // batch draining before the next one starts.
+    JobSystem::Job* rootJob = jobSystem.createJob();
 
+    for (const auto& params : mCodeGenPermutations) {
         const ShaderModel shaderModel = ShaderModel(params.shaderModel);
         const TargetApi targetApi = params.targetApi;
         const TargetLanguage targetLanguage = params.targetLanguage;
@@ -938,11 +939,13 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
         const bool targetApiNeedsWgsl = targetApi == TargetApi::WEBGPU;
         const bool targetApiNeedsGlsl = targetApi == TargetApi::OPENGL;
 
-        // Set when a job fails
-        JobSystem::Job* parent = jobSystem.createJob();
-
         for (const auto& v : variants) {
-            JobSystem::Job* job = jobs::createJob(jobSystem, parent, [&]() {
+            // the per-permutation locals are captured by value because jobs from several
+            // permutations are now in flight at the same time
+            JobSystem::Job* job = jobs::createJob(jobSystem, rootJob,
+                    [&, shaderModel, targetApi, targetLanguage, featureLevel,
+                            targetApiNeedsSpirv, targetApiNeedsMsl,
+                            targetApiNeedsWgsl, targetApiNeedsGlsl]() {
                 if (cancelJobs.load()) {
                     return;
                 }
@@ -1114,10 +1117,10 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
                 jobSystem.run(job);
             }
         }
-
-        jobSystem.runAndWait(parent);
     }
 
+    jobSystem.runAndWait(rootJob);
+
     if (cancelJobs.load()) {
         return false;
     }
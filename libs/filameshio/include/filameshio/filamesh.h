@@ -27,6 +27,14 @@ static const char MAGICID[] { 'F', 'I', 'L', 'A', 'M', 'E', 'S', 'H' };
 
 static const uint32_t VERSION = 1;
 
+// Version 2 is identical to version 1 except that the vertex and index blobs each start at the
+// next BLOB_ALIGNMENT boundary (relative to the beginning of the file), with zero padding
+// inserted before them. This lets a reader hand the blob pointers of an mmap()'d file straight
+// to the backend with no copy or fixup.
+static const uint32_t VERSION_ALIGNED = 2;
+
+static const uint32_t BLOB_ALIGNMENT = 64;
+
 enum IndexType : uint32_t {
     UI32 = 0,
     UI16 = 1,
@@ -39,6 +39,7 @@
 
 #include <fcntl.h>
 #if !defined(WIN32)
+#    include <sys/mman.h>
 #    include <unistd.h>
 #else
 #    include <io.h>
@@ -167,6 +168,20 @@ MeshReader::Mesh MeshReader::loadMeshFromFile(filament::Engine* engine, const ut
     int fd = open(path.c_str(), O_RDONLY);
 
     size_t size = fileSize(fd);
+
+#if !defined(WIN32)
+    // Map the file instead of copying it: the pages come straight from the page cache, and with
+    // version 2 files the vertex/index blobs are read in place with no fixup.
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+        if (!strncmp(MAGICID, (const char*) data, 8)) {
+            mesh = loadMeshFromBuffer(engine, data, nullptr, nullptr, materials);
+        }
+
+        Fence::waitAndDestroy(engine->createFence());
+        munmap(data, size);
+    }
+#else
     char* data = (char*) malloc(size);
     read(fd, data, size);
 
@@ -182,6 +197,7 @@ MeshReader::Mesh MeshReader::loadMeshFromFile(filament::Engine* engine, const ut
         Fence::waitAndDestroy(engine->createFence());
         free(data);
     }
+#endif
     close(fd);
 
     return mesh;
@@ -208,10 +224,24 @@ MeshReader::Mesh MeshReader::loadMeshFromBuffer(filament::Engine* engine,
     Header* header = (Header*) p;
     p += sizeof(Header);
 
-    uint8_t const* vertexData = p;
+    if (header->version > VERSION_ALIGNED) {
+        utils::slog.e << "Unsupported filamesh version " << header->version << "."
+                << utils::io::endl;
+        return {};
+    }
+
+    // Version 2 files align the vertex and index blobs on BLOB_ALIGNMENT so that the pointers
+    // handed to the backend are usable straight out of an mmap()'d file.
+    auto const align = [base = (uint8_t const*) data](uint8_t const* p) -> uint8_t const* {
+        size_t const offset = size_t(p - base);
+        return base + ((offset + BLOB_ALIGNMENT - 1) & ~size_t(BLOB_ALIGNMENT - 1));
+    };
+    const bool aligned = header->version >= VERSION_ALIGNED;
+
+    uint8_t const* vertexData = aligned ? (p = align(p)) : p;
     p += header->vertexSize;
 
-    uint8_t const* indices = p;
+    uint8_t const* indices = aligned ? (p = align(p)) : p;
     p += header->indexSize;
 
     Part* parts = (Part*) p;
@@ -167,6 +167,63 @@ TEST_F(FilameshTest, NonInterleaved) {
     engine->destroy(mi);
 }
 
+TEST_F(FilameshTest, NonInterleavedAligned) {
+    // Same mesh as NonInterleaved, but serialized as a version 2 file whose vertex and index
+    // blobs start on BLOB_ALIGNMENT boundaries.
+    const Header header {
+        .version = VERSION_ALIGNED,
+        .parts = 1,
+        .aabb = unitBox,
+        .offsetTangents = sizeof(positions),
+        .offsetColor = sizeof(positions) + sizeof(tangents),
+        .offsetUV0 = sizeof(positions) + sizeof(tangents) + sizeof(colors),
+        .strideUV1 = maxint,
+        .vertexCount = vertexCount,
+        .vertexSize = sizeof(positions) + sizeof(tangents) + sizeof(colors) + sizeof(uv0),
+        .indexType = IndexType::UI16,
+        .indexCount = 3,
+        .indexSize = sizeof(uint16_t) * 3
+    };
+    const uint32_t nmats = 1;
+    const string matname = "DefaultMaterial";
+    const uint32_t matnamelength = matname.size();
+
+    auto pad = [](std::ostream& out, size_t& offset) {
+        static const char zeros[BLOB_ALIGNMENT] = {};
+        const size_t aligned = (offset + BLOB_ALIGNMENT - 1) & ~size_t(BLOB_ALIGNMENT - 1);
+        out.write(zeros, aligned - offset);
+        offset = aligned;
+    };
+
+    stringstream stream(ios_base::out);
+    size_t offset = sizeof(MAGICID) + sizeof(header);
+    write(stream, MAGICID, sizeof(MAGICID));
+    write(stream, &header, sizeof(header));
+    pad(stream, offset);
+    write(stream, positions, sizeof(positions));
+    write(stream, tangents, sizeof(tangents));
+    write(stream, colors, sizeof(colors));
+    write(stream, uv0, sizeof(uv0));
+    offset += header.vertexSize;
+    pad(stream, offset);
+    write(stream, indices, sizeof(indices));
+    write(stream, parts, sizeof(parts));
+    write(stream, &nmats, sizeof(nmats));
+    write(stream, &matnamelength, sizeof(matnamelength));
+    write(stream, matname.c_str(), matnamelength + 1);
+
+    // Deserialize the mesh as a smoke test.
+    MaterialInstance* mi = engine->getDefaultMaterial()->createInstance();
+    auto mesh = MeshReader::loadMeshFromBuffer(engine, stream.str().data(), nullptr, nullptr, mi);
+    auto& rm = engine->getRenderableManager();
+    auto inst = rm.getInstance(mesh.renderable);
+    EXPECT_EQ(rm.getPrimitiveCount(inst), 1);
+
+    // Cleanup.
+    engine->destroy(mesh.renderable);
+    engine->destroy(mi);
+}
+
 TEST_F(FilameshTest, Interleaved) {
     // Serialize a single-triangle mesh with 1 UV set
     const Header header {
@@ -23,6 +23,10 @@
 
 #include <variant>
 
+namespace utils {
+class JobSystem;
+} // namespace utils
+
 namespace filament {
 namespace geometry {
 
@@ -56,8 +60,10 @@ public:
          *   -----------------------------------------------------------
          *   normals                                FRISVAD
          *   positions + indices                    FLAT_SHADING
+         *   normals + tangents                     TANGENTS_PROVIDED
          *   normals + uvs + positions + indices    MIKKTSPACE
          * </pre>
+         * When several rows match, authored tangents take precedence over regeneration.
          */
         DEFAULT = 0,
 
@@ -223,6 +229,28 @@ public:
          */
         Builder& algorithm(Algorithm algorithm) noexcept;
 
+        /**
+         * Optional caller-owned destination for the tangent space quaternions, written tightly
+         * packed during build(). Only valid with algorithms that do not remesh the input (see
+         * remeshed()); build() will abort if the selected algorithm remeshes. This skips both the
+         * internal allocation and the copy that getQuats() performs, which matters when
+         * recomputing tangents repeatedly on large meshes.
+         *
+         * @param quats Client-allocated array of at least vertexCount elements. Must stay alive
+         *              for the duration of build() and of any getQuats() query.
+         * @return Builder
+         */
+        Builder& quats(filament::math::quatf* quats) noexcept;
+
+        /**
+         * Optional JobSystem used to parallelize the per-vertex work. The computation stays
+         * synchronous: build() returns once all jobs have completed.
+         *
+         * @param js A JobSystem whose threads may run part of the computation
+         * @return Builder
+         */
+        Builder& jobSystem(utils::JobSystem& js) noexcept;
+
         /**
          * Computes the tangent space mesh. The resulting mesh object is owned by the callee. The
          * callee must call TangentSpaceMesh::destroy on the object once they are finished with it.
@@ -69,6 +69,15 @@ public:
         bool normalized;
         uint32_t componentCount;
         uint32_t inputStrideBytes = 0; //!< If stride is 0, the transcoder assumes tight packing.
+
+        /**
+         * If zero, the output is tightly packed. Otherwise each converted element is written at
+         * this byte stride, which allows several attributes to be transcoded straight into their
+         * final interleaved vertex buffer layout (pass a target pointer offset to each
+         * attribute's first slot) without intermediate deinterleaved buffers. The target must be
+         * able to hold (count - 1) * outputStrideBytes + componentCount * sizeof(float) bytes.
+         */
+        uint32_t outputStrideBytes = 0;
     };
 
     /**
@@ -90,6 +99,7 @@ public:
      * @param source Pointer to the data to read from (does not get retained)
      * @param count The maximum number of items to write (i.e. number of float3 values, not bytes)
      * @return Number of bytes required to contain "count" items after conversion to packed floats
+     *         (the payload size; with a non-zero outputStrideBytes the target area is larger)
      *
      */
     size_t operator()(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source,
@@ -93,10 +93,12 @@ inline void takeStride(InputType*& out, size_t const stride) noexcept {
 }
 
 inline AlgorithmImpl selectBestDefaultAlgorithm(uint8_t const inputType) {
-    if (isInputType(inputType, NORMALS_UVS_POSITIONS_INDICES)) {
-        return AlgorithmImpl::MIKKTSPACE;
-    } else if (isInputType(inputType, NORMALS_TANGENTS)) {
+    // Authored tangents take precedence over regeneration: they are authoritative per the glTF
+    // spec, and honoring them avoids the unweld/remesh that mikktspace implies.
+    if (isInputType(inputType, NORMALS_TANGENTS)) {
         return AlgorithmImpl::TANGENTS_PROVIDED;
+    } else if (isInputType(inputType, NORMALS_UVS_POSITIONS_INDICES)) {
+        return AlgorithmImpl::MIKKTSPACE;
     } else if (isInputType(inputType, POSITIONS_INDICES)) {
         return AlgorithmImpl::FLAT_SHADING;
     } else {
@@ -166,6 +168,22 @@ AlgorithmImpl selectAlgorithm(TangentSpaceMeshInput *input) noexcept {
     return outAlgo;
 }
 
+// Runs func(start, count) over [0, vertexCount), in parallel when the client provided a
+// JobSystem and the mesh is large enough to amortize the scheduling, serially otherwise.
+// func must write each vertex exactly once so that ranges are independent.
+template<typename Func>
+void forEachVertexRange(utils::JobSystem* js, size_t const vertexCount, Func func) {
+    constexpr size_t MIN_PARALLEL_VERTEX_COUNT = 4096;
+    if (js && vertexCount >= MIN_PARALLEL_VERTEX_COUNT) {
+        auto* job = utils::jobs::parallel_for(*js, nullptr, 0, uint32_t(vertexCount),
+                [&func](uint32_t const start, uint32_t const count) { func(start, count); },
+                utils::jobs::CountSplitter<MIN_PARALLEL_VERTEX_COUNT / 2, 8>());
+        js->runAndWait(job);
+    } else {
+        func(0, vertexCount);
+    }
+}
+
 // The paper uses a Z-up world basis, which has been converted to Y-up here
 inline std::pair<float3, float3> frisvadKernel(float3 const& n) {
     float3 b, t;
@@ -190,12 +208,15 @@ void frisvadMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* o
     float3 const* UTILS_RESTRICT normals = input->normals();
     size_t const nstride = input->normalsStride();
 
-    for (size_t qindex = 0; qindex < vertexCount; ++qindex) {
-        float3 const n = *normals;
-        auto const [b, t] = frisvadKernel(n);
-        quats[qindex] = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
-        normals = pointerAdd(normals, 1, nstride);
-    }
+    forEachVertexRange(input->jobSystem, vertexCount, [=](size_t const start, size_t const count) {
+        float3 const* UTILS_RESTRICT normal = pointerAdd(normals, start, nstride);
+        for (size_t qindex = start, end = start + count; qindex < end; ++qindex) {
+            float3 const n = *normal;
+            auto const [b, t] = frisvadKernel(n);
+            quats[qindex] = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
+            normal = pointerAdd(normal, 1, nstride);
+        }
+    });
     output->vertexCount = input->vertexCount;
     output->triangleCount = input->triangleCount;
     output->passthrough(input->attributeData, {AttributeImpl::UV0, AttributeImpl::POSITIONS});
@@ -212,21 +233,24 @@ void hughesMollerMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutp
     float3 const* UTILS_RESTRICT normals = input->normals();
     size_t const nstride = input->normalsStride();
 
-    for (size_t qindex = 0; qindex < vertexCount; ++qindex) {
-        float3 const n = *normals;
-        float3 b, t;
+    forEachVertexRange(input->jobSystem, vertexCount, [=](size_t const start, size_t const count) {
+        float3 const* UTILS_RESTRICT normal = pointerAdd(normals, start, nstride);
+        for (size_t qindex = start, end = start + count; qindex < end; ++qindex) {
+            float3 const n = *normal;
+            float3 b, t;
 
-        if (abs(n.x) > abs(n.z) + std::numeric_limits<float>::epsilon()) {
-            t = float3{-n.y, n.x, 0.0f};
-        } else {
-            t = float3{0.0f, -n.z, n.y};
-        }
-        t = normalize(t);
-        b = cross(n, t);
+            if (abs(n.x) > abs(n.z) + std::numeric_limits<float>::epsilon()) {
+                t = float3{-n.y, n.x, 0.0f};
+            } else {
+                t = float3{0.0f, -n.z, n.y};
+            }
+            t = normalize(t);
+            b = cross(n, t);
 
-        quats[qindex] = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
-        normals = pointerAdd(normals, 1, nstride);
-    }
+            quats[qindex] = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
+            normal = pointerAdd(normal, 1, nstride);
+        }
+    });
     output->vertexCount = input->vertexCount;
     output->triangleCount = input->triangleCount;
     output->passthrough(input->attributeData, {AttributeImpl::UV0, AttributeImpl::POSITIONS});
@@ -385,20 +409,22 @@ void tangentsProvidedMethod(TangentSpaceMeshInput const* input, TangentSpaceMesh
     float4 const* tanvec = input->tangents();
     size_t const tstride = input->tangentsStride();
 
-    for (size_t qindex = 0; qindex < vertexCount; ++qindex) {
-        float3 const& n = *pointerAdd(normal, qindex, nstride);
-        float4 const& t4 = *pointerAdd(tanvec, qindex, nstride);
-        float3 tv = t4.xyz;
-        float3 b = t4.w > 0 ? cross(tv, n) : cross(n, tv);
+    forEachVertexRange(input->jobSystem, vertexCount, [=](size_t const start, size_t const count) {
+        for (size_t qindex = start, end = start + count; qindex < end; ++qindex) {
+            float3 const& n = *pointerAdd(normal, qindex, nstride);
+            float4 const& t4 = *pointerAdd(tanvec, qindex, tstride);
+            float3 tv = t4.xyz;
+            float3 b = t4.w > 0 ? cross(tv, n) : cross(n, tv);
 
-        // Some assets do not provide perfectly orthogonal tangents and normals, so we adjust the
-        // tangent to enforce orthonormality. We would rather honor the exact normal vector than
-        // the exact tangent vector since the latter is only used for bump mapping and anisotropic
-        // lighting.
-        tv = t4.w > 0 ? cross(n, b) : cross(b, n);
+            // Some assets do not provide perfectly orthogonal tangents and normals, so we adjust
+            // the tangent to enforce orthonormality. We would rather honor the exact normal vector
+            // than the exact tangent vector since the latter is only used for bump mapping and
+            // anisotropic lighting.
+            tv = t4.w > 0 ? cross(n, b) : cross(b, n);
 
-        quats[qindex] = mat3f::packTangentFrame({tv, b, n});
-    }
+            quats[qindex] = mat3f::packTangentFrame({tv, b, n});
+        }
+    });
 
     output->vertexCount = vertexCount;
     output->triangleCount = input->triangleCount;
@@ -479,21 +505,26 @@ void lengyelMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* o
         tan2[tri.z] += tdir;
     }
 
+    // The per-triangle accumulation above scatters into shared per-vertex sums and stays
+    // serial; the per-vertex orthogonalization below is independent and can go wide.
     quatf* quats = output->tspace().allocate(vertexCount);
-    for (size_t a = 0; a < vertexCount; a++) {
-        float3 const& n = *pointerAdd(normals, a, normalStride);
-        float3 const& t1 = tan1[a];
-        float3 const& t2 = tan2[a];
+    forEachVertexRange(input->jobSystem, vertexCount,
+            [=, &tan1, &tan2](size_t const start, size_t const count) {
+        for (size_t a = start, end = start + count; a < end; a++) {
+            float3 const& n = *pointerAdd(normals, a, normalStride);
+            float3 const& t1 = tan1[a];
+            float3 const& t2 = tan2[a];
 
-        // Gram-Schmidt orthogonalize
-        float3 const t = normalize(t1 - n * dot(n, t1));
+            // Gram-Schmidt orthogonalize
+            float3 const t = normalize(t1 - n * dot(n, t1));
 
-        // Calculate handedness
-        float const w = (dot(cross(n, t1), t2) < 0.0f) ? -1.0f : 1.0f;
+            // Calculate handedness
+            float const w = (dot(cross(n, t1), t2) < 0.0f) ? -1.0f : 1.0f;
 
-        float3 b = w < 0 ? cross(t, n) : cross(n, t);
-        quats[a] = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
-    }
+            float3 b = w < 0 ? cross(t, n) : cross(n, t);
+            quats[a] = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
+        }
+    });
 
     output->vertexCount = vertexCount;
     output->triangleCount = triangleCount;
@@ -579,6 +610,16 @@ Builder& Builder::algorithm(Algorithm algo) noexcept {
     return *this;
 }
 
+Builder& Builder::quats(quatf* quats) noexcept {
+    mMesh->mInput->quatsBuffer = quats;
+    return *this;
+}
+
+Builder& Builder::jobSystem(utils::JobSystem& js) noexcept {
+    mMesh->mInput->jobSystem = &js;
+    return *this;
+}
+
 TangentSpaceMesh* Builder::build() {
     FILAMENT_CHECK_PRECONDITION(!mMesh->mInput->triangles32 || !mMesh->mInput->triangles16)
             << "Cannot provide both uint32 triangles and uint16 triangles";
@@ -591,6 +632,16 @@ TangentSpaceMesh* Builder::build() {
     }
 
     mMesh->mOutput->algorithm = selectAlgorithm(mMesh->mInput);
+
+    if (mMesh->mInput->quatsBuffer) {
+        auto const algo = mMesh->mOutput->algorithm;
+        FILAMENT_CHECK_PRECONDITION(
+                algo != AlgorithmImpl::MIKKTSPACE && algo != AlgorithmImpl::FLAT_SHADING)
+                << "A caller-provided quaternion buffer requires an algorithm that does not "
+                   "remesh the input";
+        mMesh->mOutput->tspace().adopt(mMesh->mInput->quatsBuffer);
+    }
+
     MethodPtr method = nullptr;
     switch (mMesh->mOutput->algorithm) {
         case AlgorithmImpl::MIKKTSPACE:
@@ -24,6 +24,7 @@
 #include <math/quat.h>
 
 #include <utils/debug.h>
+#include <utils/JobSystem.h>
 #include <utils/Panic.h>
 
 #include <unordered_map>
@@ -112,26 +113,39 @@ template<typename T>
 class InternalArray {
 public:
     void borrow(T const* ptr, size_t stride=sizeof(T)) {
-        assert_invariant(mAllocated.empty());
+        assert_invariant(mAllocated.empty() && !mAdopted);
         mBorrowed = ptr;
         mBorrowedStride = stride;
     }
 
+    // Wraps a caller-owned, tightly packed buffer: allocate() hands it back instead of
+    // allocating, so the methods compute straight into the client's memory.
+    void adopt(T* ptr) {
+        assert_invariant(mAllocated.empty() && !mBorrowed);
+        mAdopted = ptr;
+    }
+
     T* allocate(size_t size) {
         assert_invariant(!mBorrowed);
+        if (mAdopted) {
+            return mAdopted;
+        }
         mAllocated.resize(size);
         mAllocated.shrink_to_fit();
         return mAllocated.data();
     }
 
     explicit operator bool() const noexcept {
-        return mBorrowed || !mAllocated.empty();
+        return mBorrowed || mAdopted || !mAllocated.empty();
     }
 
     T const& operator [](int i) const {
         if (mBorrowed) {
             return *pointerAdd(mBorrowed, i, mBorrowedStride);
         }
+        if (mAdopted) {
+            return mAdopted[i];
+        }
         return mAllocated[i];
     }
 
@@ -139,12 +153,16 @@ public:
         if (mBorrowed) {
             return *pointerAdd(mBorrowed, i, mBorrowedStride);
         }
+        if (mAdopted) {
+            return mAdopted[i];
+        }
         return mAllocated[i];
     }
 
 private:
     std::vector<T> mAllocated;
     T const* mBorrowed = nullptr;
+    T* mAdopted = nullptr;
     size_t mBorrowedStride = sizeof(T);
 };
 
@@ -328,6 +346,12 @@ struct TangentSpaceMeshInput {
     AttributeMap attributeData;
 
     Algorithm algorithm;
+
+    // Optional caller-owned destination for the tangent space quaternions, see Builder::quats().
+    quatf* quatsBuffer = nullptr;
+
+    // Optional JobSystem used to parallelize the per-vertex loops, see Builder::jobSystem().
+    utils::JobSystem* jobSystem = nullptr;
 };
 
 struct TangentSpaceMeshOutput {
@@ -18,6 +18,15 @@
 
 #include <math/half.h>
 
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#   define GEOMETRY_TRANSCODER_USE_NEON 1
+#   include <arm_neon.h>
+#elif defined(__x86_64__) || (defined(_M_X64) && !defined(_M_ARM64EC))
+// SSE2 is part of the x86-64 baseline
+#   define GEOMETRY_TRANSCODER_USE_SSE 1
+#   include <emmintrin.h>
+#endif
+
 using filament::math::half;
 
 namespace filament {
@@ -85,6 +94,113 @@ void convertClamped(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT sou
     }
 }
 
+// When both input and output are tightly packed, the per-vertex structure disappears and the
+// conversion becomes elementwise over count * componentCount scalars, which is where the
+// widen-and-scale kernels below get their SIMD width from.
+
+void convertFlatU8Norm(float* UTILS_RESTRICT target, uint8_t const* UTILS_RESTRICT src,
+        size_t n) noexcept {
+    constexpr float scale = 1.0f / 255.0f;
+    size_t i = 0;
+#if defined(GEOMETRY_TRANSCODER_USE_SSE)
+    __m128 const vscale = _mm_set1_ps(scale);
+    __m128i const zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        __m128i const b = _mm_loadu_si128((__m128i const*) (src + i));
+        __m128i const lo = _mm_unpacklo_epi8(b, zero);
+        __m128i const hi = _mm_unpackhi_epi8(b, zero);
+        _mm_storeu_ps(target + i + 0,
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), vscale));
+        _mm_storeu_ps(target + i + 4,
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), vscale));
+        _mm_storeu_ps(target + i + 8,
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), vscale));
+        _mm_storeu_ps(target + i + 12,
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), vscale));
+    }
+#elif defined(GEOMETRY_TRANSCODER_USE_NEON)
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t const b = vld1q_u8(src + i);
+        uint16x8_t const lo = vmovl_u8(vget_low_u8(b));
+        uint16x8_t const hi = vmovl_u8(vget_high_u8(b));
+        vst1q_f32(target + i + 0,
+                vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), scale));
+        vst1q_f32(target + i + 4,
+                vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), scale));
+        vst1q_f32(target + i + 8,
+                vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), scale));
+        vst1q_f32(target + i + 12,
+                vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), scale));
+    }
+#endif
+    for (; i < n; ++i) {
+        target[i] = float(src[i]) * scale;
+    }
+}
+
+void convertFlatU16Norm(float* UTILS_RESTRICT target, uint16_t const* UTILS_RESTRICT src,
+        size_t n) noexcept {
+    constexpr float scale = 1.0f / 65535.0f;
+    size_t i = 0;
+#if defined(GEOMETRY_TRANSCODER_USE_SSE)
+    __m128 const vscale = _mm_set1_ps(scale);
+    __m128i const zero = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        __m128i const s = _mm_loadu_si128((__m128i const*) (src + i));
+        _mm_storeu_ps(target + i + 0,
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(s, zero)), vscale));
+        _mm_storeu_ps(target + i + 4,
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(s, zero)), vscale));
+    }
+#elif defined(GEOMETRY_TRANSCODER_USE_NEON)
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t const s = vld1q_u16(src + i);
+        vst1q_f32(target + i + 0,
+                vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(s))), scale));
+        vst1q_f32(target + i + 4,
+                vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(s))), scale));
+    }
+#endif
+    for (; i < n; ++i) {
+        target[i] = float(src[i]) * scale;
+    }
+}
+
+void convertFlatHalf(float* UTILS_RESTRICT target, uint16_t const* UTILS_RESTRICT src,
+        size_t n) noexcept {
+    size_t i = 0;
+#if defined(GEOMETRY_TRANSCODER_USE_NEON)
+    // x86 needs F16C for a vector conversion, which is not part of the x86-64 baseline, so
+    // only arm64 gets a SIMD path here.
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(target + i, vcvt_f32_f16(vld1_f16((float16_t const*) (src + i))));
+    }
+#endif
+    half const* h = (half const*) src;
+    for (; i < n; ++i) {
+        target[i] = float(h[i]);
+    }
+}
+
+// Used when the client requested an interleaved destination. The scattered stores don't
+// vectorize, but a single fused pass replaces the convert-then-interleave double pass (and its
+// intermediate buffer) that the caller would otherwise need.
+template<typename SOURCE_TYPE, int NORMALIZATION_FACTOR, bool CLAMP>
+void convertInterleaved(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source,
+        size_t count, int componentCount, int srcStride, int dstStride) noexcept {
+    constexpr float scale = 1.0f / float(NORMALIZATION_FACTOR);
+    uint8_t const* srcBytes = (uint8_t const*) source;
+    uint8_t* dstBytes = (uint8_t*) target;
+    for (size_t i = 0; i < count; ++i, dstBytes += dstStride, srcBytes += srcStride) {
+        SOURCE_TYPE const* src = (SOURCE_TYPE const*) srcBytes;
+        float* dst = (float*) dstBytes;
+        for (int n = 0; n < componentCount; ++n) {
+            const float value = float(src[n]) * scale;
+            dst[n] = (CLAMP && value < -1.0f) ? -1.0f : value;
+        }
+    }
+}
+
 size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source,
         size_t count) const noexcept {
     const size_t required = count * mConfig.componentCount * sizeof(float);
@@ -92,9 +208,20 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         return required;
     }
     const uint32_t comp = mConfig.componentCount;
+    const uint32_t dstStride = mConfig.outputStrideBytes;
     switch (mConfig.componentType) {
         case ComponentType::BYTE: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : comp;
+            if (dstStride) {
+                if (mConfig.normalized) {
+                    convertInterleaved<int8_t, 127, true>(target, source, count, comp,
+                            stride, dstStride);
+                } else {
+                    convertInterleaved<int8_t, 1, false>(target, source, count, comp,
+                            stride, dstStride);
+                }
+                return required;
+            }
             if (mConfig.normalized) {
                 if (comp == 2) {
                     convertClamped<int8_t, 127, 2>(target, source, count, stride);
@@ -116,8 +243,20 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         }
         case ComponentType::UBYTE: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : comp;
+            if (dstStride) {
+                if (mConfig.normalized) {
+                    convertInterleaved<uint8_t, 255, false>(target, source, count, comp,
+                            stride, dstStride);
+                } else {
+                    convertInterleaved<uint8_t, 1, false>(target, source, count, comp,
+                            stride, dstStride);
+                }
+                return required;
+            }
             if (mConfig.normalized) {
-                if (comp == 2) {
+                if (stride == comp) {
+                    convertFlatU8Norm(target, (uint8_t const*) source, count * comp);
+                } else if (comp == 2) {
                     convert<uint8_t, 255, 2>(target, source, count, stride);
                 } else if (comp == 3) {
                     convert<uint8_t, 255, 3>(target, source, count, stride);
@@ -137,6 +276,16 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         }
         case ComponentType::SHORT: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (2 * comp);
+            if (dstStride) {
+                if (mConfig.normalized) {
+                    convertInterleaved<int16_t, 32767, true>(target, source, count, comp,
+                            stride, dstStride);
+                } else {
+                    convertInterleaved<int16_t, 1, false>(target, source, count, comp,
+                            stride, dstStride);
+                }
+                return required;
+            }
             if (mConfig.normalized) {
                 if (comp == 2) {
                     convertClamped<int16_t, 32767, 2>(target, source, count, stride);
@@ -158,8 +307,20 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         }
         case ComponentType::USHORT: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (2 * comp);
+            if (dstStride) {
+                if (mConfig.normalized) {
+                    convertInterleaved<uint16_t, 65535, false>(target, source, count, comp,
+                            stride, dstStride);
+                } else {
+                    convertInterleaved<uint16_t, 1, false>(target, source, count, comp,
+                            stride, dstStride);
+                }
+                return required;
+            }
             if (mConfig.normalized) {
-                if (comp == 2) {
+                if (stride == 2 * comp) {
+                    convertFlatU16Norm(target, (uint16_t const*) source, count * comp);
+                } else if (comp == 2) {
                     convert<uint16_t, 65535, 2>(target, source, count, stride);
                 } else if (comp == 3) {
                     convert<uint16_t, 65535, 3>(target, source, count, stride);
@@ -179,6 +340,15 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         }
         case ComponentType::HALF: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (2 * comp);
+            if (dstStride) {
+                convertInterleaved<half, 1, false>(target, source, count, comp,
+                        stride, dstStride);
+                return required;
+            }
+            if (stride == 2 * comp) {
+                convertFlatHalf(target, (uint16_t const*) source, count * comp);
+                return required;
+            }
             uint8_t const* srcBytes = (uint8_t const*) source;
             for (size_t i = 0; i < count; ++i, target += comp, srcBytes += stride) {
                 half const* src = (half const*) srcBytes;
@@ -191,6 +361,11 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         case ComponentType::FLOAT: {
             const uint32_t srcStride =
                     mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (4 * comp);
+            if (dstStride) {
+                convertInterleaved<float, 1, false>(target, source, count, comp,
+                        srcStride, dstStride);
+                return required;
+            }
             uint8_t const* srcBytes = (uint8_t const*) source;
             for (size_t i = 0; i < count; ++i, target += comp, srcBytes += srcStride) {
                 // This will never break alignment rules because the glTF spec stipulates that the
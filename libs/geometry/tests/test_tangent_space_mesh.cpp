@@ -21,6 +21,7 @@
 
 #include <gtest/gtest.h>
 
+#include <utils/JobSystem.h>
 #include <utils/Log.h>
 
 #include <vector>
@@ -291,6 +292,36 @@ TEST_F(TangentSpaceMeshTest, Frisvad) {
     TangentSpaceMesh::destroy(mesh);
 }
 
+TEST_F(TangentSpaceMeshTest, FrisvadCallerBuffer) {
+    utils::JobSystem js;
+    js.adopt();
+
+    std::vector<quatf> quats(TEST_NORMALS.size());
+    TangentSpaceMesh* mesh = TangentSpaceMesh::Builder()
+            .vertexCount(TEST_NORMALS.size())
+            .normals(TEST_NORMALS.data())
+            .algorithm(TangentSpaceMesh::Algorithm::FRISVAD)
+            .quats(quats.data())
+            .jobSystem(js)
+            .build();
+
+    ASSERT_EQ(mesh->getVertexCount(), TEST_NORMALS.size());
+
+    // The quaternions were written straight into the caller's buffer.
+    for (size_t i = 0; i < TEST_NORMALS.size(); ++i) {
+        const float3 n = quats[i] * NORMAL_AXIS;
+        EXPECT_PRED2(isAlmostEqual3, n, TEST_NORMALS[i]);
+    }
+
+    // getQuats() reads back from the same buffer.
+    std::vector<quatf> copied(mesh->getVertexCount());
+    mesh->getQuats(copied.data());
+    for (size_t i = 0; i < TEST_NORMALS.size(); ++i) {
+        EXPECT_PRED2(isAlmostEqual4, copied[i].xyzw, quats[i].xyzw);
+    }
+    TangentSpaceMesh::destroy(mesh);
+}
+
 TEST_F(TangentSpaceMeshTest, HughesMoller) {
     TangentSpaceMesh* mesh = TangentSpaceMesh::Builder()
             .vertexCount(TEST_NORMALS.size())
@@ -124,6 +124,77 @@ TEST_F(TranscoderTest, NonNormalized) {
     ASSERT_EQ(result[1], 1.0f);
 }
 
+TEST_F(TranscoderTest, TightlyPacked) {
+    // Enough elements to exercise the vectorized flat path, plus a remainder tail.
+    static constexpr int n = 67;
+
+    uint8_t bytes[n];
+    uint16_t shorts[n];
+    for (int i = 0; i < n; ++i) {
+        bytes[i] = uint8_t(i * 3);
+        shorts[i] = uint16_t(i * 977);
+    }
+
+    float result[n];
+
+    Transcoder transcodeBytes({
+        .componentType = ComponentType::UBYTE,
+        .normalized = true,
+        .componentCount = 1u,
+    });
+    transcodeBytes(result, bytes, n);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(result[i], float(bytes[i]) / 255.0f);
+    }
+
+    Transcoder transcodeShorts({
+        .componentType = ComponentType::USHORT,
+        .normalized = true,
+        .componentCount = 1u,
+    });
+    transcodeShorts(result, shorts, n);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(result[i], float(shorts[i]) / 65535.0f);
+    }
+}
+
+TEST_F(TranscoderTest, InterleavedOutput) {
+    // Two attributes written into one interleaved layout: { float4 color; float h; }.
+    struct OutVertex {
+        float color[4];
+        float h;
+    };
+    OutVertex result[count];
+    char const* srcBytes = (char const*) vbuffer;
+
+    Transcoder transcodeBytes({
+        .componentType = ComponentType::UBYTE,
+        .normalized = true,
+        .componentCount = 4u,
+        .inputStrideBytes = sizeof(Vertex),
+        .outputStrideBytes = sizeof(OutVertex)
+    });
+    transcodeBytes(result[0].color, vbuffer, count);
+
+    Transcoder transcodeHalf({
+        .componentType = ComponentType::HALF,
+        .normalized = false,
+        .componentCount = 1u,
+        .inputStrideBytes = sizeof(Vertex),
+        .outputStrideBytes = sizeof(OutVertex)
+    });
+    transcodeHalf(&result[0].h, srcBytes + 10, count);
+
+    ASSERT_EQ(result[0].color[0], 0.0f);
+    ASSERT_EQ(result[0].color[1], 1.0f);
+    ASSERT_NEAR(result[0].color[2], 0.50f, 0.005f);
+    ASSERT_EQ(result[0].h, -0.5f);
+
+    ASSERT_EQ(result[1].color[0], 0.0f);
+    ASSERT_EQ(result[1].color[1], 1.0f);
+    ASSERT_EQ(result[1].h, 1.0f);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
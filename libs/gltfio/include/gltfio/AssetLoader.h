@@ -83,6 +83,13 @@ struct AssetConfiguration {
     //! Optional to enable mikktspace tangents. Lifetime of struct only needs to be maintained for
     //  the duration of the constructor of AssetLoader.
     AssetConfigurationExtended* ext = nullptr;
+
+    //! Collapses groups of nodes that reference the same glTF mesh into a single renderable
+    //! that uses GPU instancing, which reduces draw calls for assets with many repeated meshes.
+    //! Per-node transforms are baked into an InstanceBuffer at load time, so this should only be
+    //! enabled for assets whose mesh nodes are not repositioned after loading. Nodes with skins,
+    //! morph targets, or animated transforms are never collapsed.
+    bool detectInstancing = false;
 };
 
 /**
@@ -23,6 +23,8 @@
 
 #include <utils/compiler.h>
 
+#include <stddef.h>
+
 namespace filament {
     class Engine;
 }
@@ -49,6 +51,19 @@ struct ResourceConfiguration {
     //! If true, adjusts skinning weights to sum to 1. Well formed glTF files do not need this,
     //! but it is useful for robustness.
     bool normalizeSkinningWeights;
+
+    //! Maximum number of bytes of vertex and index data allowed to be in flight to the GPU
+    //! at once during #loadResources, or 0 (the default) for no limit. When the budget is
+    //! exceeded the loader waits for the backend to consume the pending uploads before
+    //! queueing more, which bounds the transient CPU memory used while loading large assets
+    //! at the cost of extra synchronization.
+    size_t uploadBudgetBytes;
+
+    //! If true, reorders each triangle primitive's indices at load time with meshoptimizer's
+    //! vertex-cache and overdraw passes before upload. Assets straight out of authoring tools
+    //! often have poor vertex-cache locality; the reorder happens in place on CPU-side data
+    //! (parallel across primitives) and doesn't change the mesh, only the triangle order.
+    bool optimizeMeshes;
 };
 
 /**
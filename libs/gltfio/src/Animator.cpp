@@ -34,8 +34,9 @@
 #include <math/vec3.h>
 #include <math/vec4.h>
 
-#include <map>
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace filament;
@@ -45,7 +46,10 @@ using namespace utils;
 
 namespace filament::gltfio {
 
-using TimeValues = map<float, size_t>;
+// Keyframe times paired with their source index in the accessor, sorted by time. A flat sorted
+// array keeps lookups cache-friendly; the old red-black tree dominated sampling time when many
+// clips were active.
+using TimeValues = vector<pair<float, size_t>>;
 using SourceValues = vector<float>;
 using BoneVector = vector<mat4f>;
 
@@ -53,6 +57,9 @@ struct Sampler {
     TimeValues times;
     SourceValues values;
     enum { LINEAR, STEP, CUBIC } interpolation;
+    // Keyframe lookup result from the previous tick. Animations mostly play forward, so the
+    // next lookup usually resolves with a short scan from here instead of a binary search.
+    mutable size_t cursor = 0;
 };
 
 struct Channel {
@@ -87,8 +94,30 @@ struct AnimatorImpl {
     void updateBoneMatrices(FFilamentInstance* instance);
 };
 
+// Returns the index of the first keyframe with a time at or after the given time, or
+// times.size() when the given time lies past the last keyframe. Starts with a short forward
+// scan from the given cursor and falls back to a binary search for seeks and large jumps.
+static size_t findKeyframeIndex(const TimeValues& times, size_t cursor, float time) {
+    constexpr size_t MAX_LINEAR_SCAN = 16;
+    auto const byTime = [](const pair<float, size_t>& lhs, float rhs) { return lhs.first < rhs; };
+    size_t const count = times.size();
+    cursor = std::min(cursor, count);
+    if (cursor > 0 && times[cursor - 1].first >= time) {
+        // The time moved backward (a seek or a loop restart); search the range before the cursor.
+        return std::lower_bound(times.begin(), times.begin() + cursor, time, byTime)
+                - times.begin();
+    }
+    size_t const end = std::min(cursor + MAX_LINEAR_SCAN, count);
+    size_t i = cursor;
+    while (i < end && times[i].first < time) ++i;
+    if (i < end || i == count) {
+        return i;
+    }
+    return std::lower_bound(times.begin() + i, times.end(), time, byTime) - times.begin();
+}
+
 static void createSampler(const cgltf_animation_sampler& src, Sampler& dst) {
-    // Copy the time values into a red-black tree.
+    // Copy the time values into a flat sorted array.
     const cgltf_accessor* timelineAccessor = src.input;
     const uint8_t* timelineBlob = nullptr;
     const float* timelineFloats = nullptr;
@@ -100,8 +129,17 @@ static void createSampler(const cgltf_animation_sampler& src, Sampler& dst) {
         timelineFloats = (const float*) (timelineBlob + timelineAccessor->offset +
                 timelineAccessor->buffer_view->offset);
     }
+    dst.times.reserve(timelineAccessor->count);
     for (size_t i = 0, len = timelineAccessor->count; i < len; ++i) {
-        dst.times[timelineFloats[i]] = i;
+        dst.times.emplace_back(timelineFloats[i], i);
+    }
+    // The glTF spec requires keyframe times to be strictly increasing, so sorting is almost
+    // always a no-op; each entry keeps its source index so values stay addressable either way.
+    auto const byTime = [](const pair<float, size_t>& a, const pair<float, size_t>& b) {
+        return a.first < b.first;
+    };
+    if (UTILS_UNLIKELY(!std::is_sorted(dst.times.begin(), dst.times.end(), byTime))) {
+        std::stable_sort(dst.times.begin(), dst.times.end(), byTime);
     }
 
     // Convert source data to float.
@@ -222,7 +260,7 @@ Animator::Animator(FFilamentAsset const* asset, FFilamentInstance* instance) {
             Sampler& dstSampler = dstAnim.samplers[j];
             createSampler(srcSampler, dstSampler);
             if (dstSampler.times.size() > 1) {
-                float maxtime = (--dstSampler.times.end())->first;
+                float maxtime = dstSampler.times.back().first;
                 dstAnim.duration = std::max(dstAnim.duration, maxtime);
             }
         }
@@ -275,25 +313,26 @@ void Animator::applyAnimation(size_t animationIndex, float time) const {
 
         const TimeValues& times = sampler->times;
 
-        // Find the first keyframe after the given time, or the keyframe that matches it exactly.
-        TimeValues::const_iterator iter = times.lower_bound(time);
+        // Find the first keyframe after the given time, or the keyframe that matches it exactly,
+        // resuming from the per-sampler cursor left by the previous tick.
+        size_t const index = findKeyframeIndex(times, sampler->cursor, time);
+        sampler->cursor = index;
 
         // Compute the interpolant (between 0 and 1) and determine the keyframe pair.
         float t = 0.0f;
         size_t nextIndex;
         size_t prevIndex;
-        if (iter == times.end()) {
-            nextIndex = times.size() - 1;
+        if (index == times.size()) {
+            nextIndex = times.back().second;
+            prevIndex = nextIndex;
+        } else if (index == 0) {
+            nextIndex = times.front().second;
             prevIndex = nextIndex;
-        } else if (iter == times.begin()) {
-            nextIndex = 0;
-            prevIndex = 0;
         } else {
-            TimeValues::const_iterator prev = iter; --prev;
-            nextIndex = iter->second;
-            prevIndex = prev->second;
-            const float nextTime = iter->first;
-            const float prevTime = prev->first;
+            nextIndex = times[index].second;
+            prevIndex = times[index - 1].second;
+            const float nextTime = times[index].first;
+            const float prevTime = times[index - 1].first;
             float deltaTime = nextTime - prevTime;
             assert(deltaTime >= 0);
             if (deltaTime > 0) {
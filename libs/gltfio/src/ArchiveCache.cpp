@@ -24,6 +24,7 @@
 #include <utils/compiler.h>
 #include <utils/CString.h>
 #include <utils/FixedCapacityVector.h>
+#include <utils/Hash.h>
 #include <utils/Log.h>
 #include <utils/Panic.h>
 #include <utils/debug.h>
@@ -58,17 +59,117 @@ static bool strIsEqual(const CString& a, const char* b) {
     return strncmp(a.c_str(), b, a.size()) == 0;
 }
 
+// Returns the two filter bits for a flag name. False positives only cause the string
+// comparison path to run; false negatives are impossible.
+static uint64_t flagFilterBits(const char* name, size_t length) {
+    uint32_t const h = hash::murmurSlow((const uint8_t*) name, length, 42);
+    return (1ull << (h & 63u)) | (1ull << ((h >> 6u) & 63u));
+}
+
 void ArchiveCache::load(const void* archiveData, uint64_t archiveByteCount) {
     assert_invariant(mArchive == nullptr && "Do not call load() twice");
-    const uint64_t decompSize = ZSTD_getFrameContentSize(archiveData, archiveByteCount);
-    if (decompSize == ZSTD_CONTENTSIZE_UNKNOWN || decompSize == ZSTD_CONTENTSIZE_ERROR) {
-        PANIC_POSTCONDITION("Decompression error.");
+    if (hasUncompressedIndex(archiveData, archiveByteCount)) {
+        // Version >= 1: the index is uncompressed and each package is an independent zstd
+        // frame, decompressed on demand in loadMaterial(); only the compressed bytes stay
+        // resident.
+        uint64_t* basePointer = (uint64_t*) utils::aligned_alloc(archiveByteCount, 8);
+        memcpy(basePointer, archiveData, archiveByteCount);
+        mArchive = (ReadableArchive*) basePointer;
+        mLazyPackages = true;
+    } else {
+        const uint64_t decompSize = ZSTD_getFrameContentSize(archiveData, archiveByteCount);
+        if (decompSize == ZSTD_CONTENTSIZE_UNKNOWN || decompSize == ZSTD_CONTENTSIZE_ERROR) {
+            PANIC_POSTCONDITION("Decompression error.");
+        }
+        uint64_t* basePointer = (uint64_t*) utils::aligned_alloc(decompSize, 8);
+        ZSTD_decompress(basePointer, decompSize, archiveData, archiveByteCount);
+        mArchive = (ReadableArchive*) basePointer;
     }
-    uint64_t* basePointer = (uint64_t*) utils::aligned_alloc(decompSize, 8);
-    ZSTD_decompress(basePointer, decompSize, archiveData, archiveByteCount);
-    mArchive = (ReadableArchive*) basePointer;
     convertOffsetsToPointers(mArchive);
     mMaterials = FixedCapacityVector<Material*>(mArchive->specsCount, nullptr);
+
+    // Precompute each spec's flag-name filter so that getMaterial() can reject most
+    // unsuitable specs without any string comparisons.
+    mSpecFilters = FixedCapacityVector<uint64_t>(mArchive->specsCount, 0);
+    for (uint64_t i = 0; i < mArchive->specsCount; ++i) {
+        const ArchiveSpec& spec = mArchive->specs[i];
+        for (uint64_t j = 0; j < spec.flagsCount; ++j) {
+            const char* const name = spec.flags[j].name;
+            mSpecFilters[i] |= flagFilterBits(name, strlen(name));
+        }
+    }
+}
+
+Material* ArchiveCache::buildMaterial(size_t specIndex, Material::Builder& builder) const {
+    const ArchiveSpec& spec = mArchive->specs[specIndex];
+    if (UTILS_LIKELY(mLazyPackages)) {
+        const uint64_t packageSize = ZSTD_getFrameContentSize(spec.package, spec.packageByteCount);
+        if (packageSize == ZSTD_CONTENTSIZE_UNKNOWN || packageSize == ZSTD_CONTENTSIZE_ERROR) {
+            PANIC_POSTCONDITION("Decompression error.");
+        }
+        FixedCapacityVector<uint8_t> package(packageSize);
+        ZSTD_decompress(package.data(), packageSize, spec.package, spec.packageByteCount);
+        return builder.package(package.data(), packageSize).build(mEngine);
+    }
+    return builder.package(spec.package, spec.packageByteCount).build(mEngine);
+}
+
+Material* ArchiveCache::loadMaterial(size_t specIndex) {
+    Material::Builder builder;
+    return buildMaterial(specIndex, builder);
+}
+
+// Returns a clone of the given ubershader whose feature branches have been resolved to
+// compile-time constants, or the shared ubershader when the archive's materials don't declare
+// feature constant parameters.
+Material* ArchiveCache::getSpecializedMaterial(size_t specIndex,
+        const ArchiveRequirements& reqs) {
+    if (mMaterials[specIndex] == nullptr) {
+        mMaterials[specIndex] = loadMaterial(specIndex);
+    }
+    Material* const base = mMaterials[specIndex];
+    const ArchiveSpec& spec = mArchive->specs[specIndex];
+
+    // The cache key packs the spec index with one bit per feature flag; the flag count has
+    // never come close to the bit budget, but don't corrupt the key if it ever does.
+    if (UTILS_UNLIKELY(spec.flagsCount >= 48)) {
+        return base;
+    }
+
+    uint64_t featureBits = 0;
+    bool hasConstants = false;
+    for (uint64_t j = 0; j < spec.flagsCount; ++j) {
+        const char* const name = spec.flags[j].name;
+        if (!base->hasConstant(name)) {
+            continue;
+        }
+        hasConstants = true;
+        // This allocates a new CString just to make a robin_map lookup, but this runs once per
+        // material resolution, not per frame.
+        auto iter = reqs.features.find(CString(name));
+        if (iter != reqs.features.end() && iter.value()) {
+            featureBits |= 1ull << j;
+        }
+    }
+    if (!hasConstants) {
+        return base;
+    }
+
+    const uint64_t key = (uint64_t(specIndex) << 48u) | featureBits;
+    if (auto iter = mSpecializedMaterials.find(key); iter != mSpecializedMaterials.end()) {
+        return iter->second;
+    }
+
+    Material::Builder builder;
+    for (uint64_t j = 0; j < spec.flagsCount; ++j) {
+        const char* const name = spec.flags[j].name;
+        if (base->hasConstant(name)) {
+            builder.constant(name, strlen(name), bool(featureBits & (1ull << j)));
+        }
+    }
+    Material* const specialized = buildMaterial(specIndex, builder);
+    mSpecializedMaterials[key] = specialized;
+    return specialized;
 }
 
 // This loops though all ubershaders and returns the first one that meets the given requirements.
@@ -78,6 +179,15 @@ Material* ArchiveCache::getMaterial(const ArchiveRequirements& reqs) {
         return nullptr;
     }
 
+    // Combined filter of all required features; a spec whose filter doesn't contain every
+    // bit can't satisfy the requirements, so it is rejected without string comparisons.
+    uint64_t requiredBits = 0;
+    for (const auto& req : reqs.features) {
+        if (req.second) {
+            requiredBits |= flagFilterBits(req.first.c_str(), req.first.size());
+        }
+    }
+
     for (uint64_t i = 0; i < mArchive->specsCount; ++i) {
         const ArchiveSpec& spec = mArchive->specs[i];
         if (spec.blendingMode != INVALID_BLENDING && spec.blendingMode != reqs.blendingMode) {
@@ -88,6 +198,10 @@ Material* ArchiveCache::getMaterial(const ArchiveRequirements& reqs) {
             debugSuitability(i, "material model.");
             continue;
         }
+        if ((mSpecFilters[i] & requiredBits) != requiredBits) {
+            debugSuitability(i, "feature filter.");
+            continue;
+        }
         bool specIsSuitable = true;
 
         // For each feature required by the mesh, this ubershader is suitable only if it includes a
@@ -131,13 +245,7 @@ Material* ArchiveCache::getMaterial(const ArchiveRequirements& reqs) {
         }
 
         if (specIsSuitable) {
-            if (mMaterials[i] == nullptr) {
-                mMaterials[i] = Material::Builder()
-                    .package(spec.package, spec.packageByteCount)
-                    .build(mEngine);
-            }
-
-            return mMaterials[i];
+            return getSpecializedMaterial(i, reqs);
         }
     }
     return nullptr;
@@ -148,9 +256,7 @@ Material* ArchiveCache::getDefaultMaterial() {
     assert_invariant(!mMaterials.empty() && "Archive must have at least one material.");
     if (!mArchive) return nullptr;
     if (mMaterials[0] == nullptr) {
-        mMaterials[0] = Material::Builder()
-            .package(mArchive->specs[0].package, mArchive->specs[0].packageByteCount)
-            .build(mEngine);
+        mMaterials[0] = loadMaterial(0);
     }
     return mMaterials[0];
 }
@@ -158,20 +264,37 @@ Material* ArchiveCache::getDefaultMaterial() {
 void ArchiveCache::destroyMaterials() {
     for (auto mat : mMaterials) mEngine.destroy(mat);
     mMaterials.clear();
+    for (auto const& pair : mSpecializedMaterials) mEngine.destroy(pair.second);
+    mSpecializedMaterials.clear();
 }
 
 FeatureMap ArchiveCache::getFeatureMap(Material* material) const {
-    FeatureMap features;
-    for (size_t specIndex = 0; specIndex < mMaterials.size(); ++specIndex) {
-        if (material == mMaterials[specIndex]) {
-            const ArchiveSpec& spec = mArchive->specs[specIndex];
-            for (uint64_t j = 0; j < spec.flagsCount; ++j) {
-                const ArchiveFlag& flag = spec.flags[j];
-                features[flag.name] = flag.value;
-            }
+    size_t specIndex = mMaterials.size();
+    for (size_t i = 0; i < mMaterials.size(); ++i) {
+        if (material == mMaterials[i]) {
+            specIndex = i;
             break;
         }
     }
+    if (specIndex == mMaterials.size()) {
+        // Specialized materials share their spec with the base ubershader they were cloned
+        // from; the spec index is in the high bits of the cache key.
+        for (auto const& pair : mSpecializedMaterials) {
+            if (material == pair.second) {
+                specIndex = size_t(pair.first >> 48u);
+                break;
+            }
+        }
+    }
+
+    FeatureMap features;
+    if (specIndex < mMaterials.size()) {
+        const ArchiveSpec& spec = mArchive->specs[specIndex];
+        for (uint64_t j = 0; j < spec.flagsCount; ++j) {
+            const ArchiveFlag& flag = spec.flags[j];
+            features[flag.name] = flag.value;
+        }
+    }
     return features;
 }
 
@@ -36,6 +36,11 @@ namespace filament::gltfio {
 
     // Stores a set of Filament materials and knows how to choose a suitable material when given a
     // set of requirements. Used by gltfio; users do not need to access this class directly.
+    //
+    // When the archive's materials declare a boolean constant parameter named after each feature
+    // flag, getMaterial() returns a clone of the ubershader specialized for the resolved feature
+    // set (via Material::Builder::constant), which removes the uniform-driven branches from the
+    // fragment shader. Legacy archives without constant parameters keep the shared ubershaders.
     class ArchiveCache {
     public:
         ArchiveCache(Engine& engine) : mEngine(engine) {}
@@ -50,9 +55,21 @@ namespace filament::gltfio {
         FeatureMap getFeatureMap(Material* material) const;
 
     private:
+        Material* loadMaterial(size_t specIndex);
+        Material* buildMaterial(size_t specIndex, Material::Builder& builder) const;
+        Material* getSpecializedMaterial(size_t specIndex, const ArchiveRequirements& reqs);
+
         Engine& mEngine;
         utils::FixedCapacityVector<Material*> mMaterials;
+        // Specialized clones of the ubershaders, keyed by spec index and enabled-feature bits.
+        // Only populated for archives whose materials declare feature constant parameters.
+        tsl::robin_map<uint64_t, Material*> mSpecializedMaterials;
+        // One small filter of flag-name hashes per spec, used to reject unsuitable specs
+        // without string comparisons.
+        utils::FixedCapacityVector<uint64_t> mSpecFilters;
         uberz::ReadableArchive* mArchive = nullptr;
+        // True for version >= 1 archives, whose packages are decompressed on demand.
+        bool mLazyPackages = false;
     };
 
     struct ArchiveRequirements {
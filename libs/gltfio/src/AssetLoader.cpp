@@ -31,6 +31,7 @@
 #include <filament/Camera.h>
 #include <filament/Engine.h>
 #include <filament/IndexBuffer.h>
+#include <filament/InstanceBuffer.h>
 #include <filament/LightManager.h>
 #include <filament/Material.h>
 #include <filament/MorphTargetBuffer.h>
@@ -91,6 +92,14 @@ static constexpr cgltf_material kDefaultMat = {
     },
 };
 
+static size_t countNodes(cgltf_node const* node) {
+    size_t count = 1;
+    for (cgltf_size i = 0, len = node->children_count; i < len; ++i) {
+        count += countNodes(node->children[i]);
+    }
+    return count;
+}
+
 static std::string getNodeName(cgltf_node const* node, char const* defaultNodeName) {
     auto const getNameImpl = [node, defaultNodeName]() -> char const* {
         if (node->name) return node->name;
@@ -261,6 +270,7 @@ struct FAssetLoader : public AssetLoader {
             mTransformManager(config.engine->getTransformManager()),
             mMaterials(*config.materials),
             mEngine(*config.engine),
+            mDetectInstancing(config.detectInstancing),
             mDefaultNodeName(config.defaultNodeName) {
         if (config.ext) {
             FILAMENT_CHECK_POSTCONDITION(AssetConfigurationExtended::isSupported())
@@ -305,6 +315,7 @@ private:
 
     // Methods used during the first traveral (creation of VertexBuffer, IndexBuffer, etc)
     FFilamentAsset* createRootAsset(const cgltf_data* srcAsset);
+    void detectInstancingGroups(const cgltf_data* srcAsset, FFilamentAsset* fAsset);
     void recursePrimitives(const cgltf_node* rootNode, FFilamentAsset* fAsset);
     void createPrimitives(const cgltf_node* node, const char* name, FFilamentAsset* fAsset);
     bool createPrimitive(const cgltf_primitive& inPrim, const char* name, Primitive* outPrim,
@@ -313,7 +324,7 @@ private:
     // Methods used during subsequent traverals (creation of entities, renderables, etc)
     void createInstances(size_t numInstances, FFilamentAsset* fAsset);
     void recurseEntities(const cgltf_node* node, SceneMask scenes, Entity parent,
-            FFilamentAsset* fAsset, FFilamentInstance* instance);
+            FFilamentAsset* fAsset, FFilamentInstance* instance, const Entity*& nextEntity);
     void createRenderable(const cgltf_node* node, Entity entity, const char* name,
             FFilamentAsset* fAsset);
     void createLight(const cgltf_light* light, Entity entity, FFilamentAsset* fAsset);
@@ -343,6 +354,8 @@ public:
     FNodeManager mNodeManager;
     FTrsTransformManager mTrsTransformManager;
 
+    const bool mDetectInstancing;
+
     // Transient state used only for the asset currently being loaded:
     const char* mDefaultNodeName;
     bool mError = false;
@@ -446,10 +459,28 @@ FilamentInstance* FAssetLoader::createInstance(FFilamentAsset* fAsset) {
         instance->mVariants.push_back({ CString(srcAsset->variants[i].name) });
     }
 
+    // Entities for the whole hierarchy are created in one batch; creating them one at a time
+    // in recurseEntities() is measurably slower on assets with thousands of nodes.
+    size_t nodeCount = 0;
+    for (const auto& pair : fAsset->mRootNodes) {
+        nodeCount += countNodes(pair.first);
+    }
+    auto entities = FixedCapacityVector<Entity>(nodeCount);
+    mEntityManager.create(entities.size(), entities.data());
+    fAsset->mEntities.reserve(fAsset->mEntities.size() + nodeCount);
+    instance->mEntities.reserve(nodeCount);
+
+    // Component storage can also be grown once for the whole hierarchy.
+    RenderableManager& rm = mEngine.getRenderableManager();
+    rm.reserve(rm.getComponentCount() + fAsset->mRenderableCount);
+    mTransformManager.reserve(mTransformManager.getComponentCount() + nodeCount + 1);
+
     // For each scene root, recursively create all entities.
+    const Entity* nextEntity = entities.data();
     for (const auto& pair : fAsset->mRootNodes) {
-        recurseEntities(pair.first, pair.second, instanceRoot, fAsset, instance);
+        recurseEntities(pair.first, pair.second, instanceRoot, fAsset, instance, nextEntity);
     }
+    assert_invariant(nextEntity == entities.data() + nodeCount);
 
     importSkins(instance, srcAsset);
 
@@ -526,6 +557,10 @@ FFilamentAsset* FAssetLoader::createRootAsset(const cgltf_data* srcAsset) {
         }
     }
 
+    if (mDetectInstancing) {
+        detectInstancingGroups(srcAsset, fAsset);
+    }
+
     for (const auto& [node, sceneMask] : fAsset->mRootNodes) {
         recursePrimitives(node, fAsset);
     }
@@ -567,6 +602,78 @@ void FAssetLoader::recursePrimitives(const cgltf_node* node, FFilamentAsset* fAs
     }
 }
 
+void FAssetLoader::detectInstancingGroups(const cgltf_data* srcAsset, FFilamentAsset* fAsset) {
+    // Material variants rebind material instances per entity, which a renderable shared by
+    // several nodes cannot express.
+    if (srcAsset->variants_count > 0) {
+        return;
+    }
+
+    // Instance transforms are baked at creation time, so any node whose world transform can be
+    // animated (including via an ancestor) must keep its own renderable.
+    tsl::robin_set<const cgltf_node*> animated;
+    for (cgltf_size i = 0, n = srcAsset->animations_count; i < n; ++i) {
+        const cgltf_animation& animation = srcAsset->animations[i];
+        for (cgltf_size j = 0, m = animation.channels_count; j < m; ++j) {
+            if (animation.channels[j].target_node) {
+                animated.insert(animation.channels[j].target_node);
+            }
+        }
+    }
+    auto const hasAnimatedAncestor = [&animated](const cgltf_node* node) {
+        for (; node; node = node->parent) {
+            if (animated.find(node) != animated.end()) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Group shareable nodes by their glTF mesh; nodes with the same mesh necessarily have the
+    // same primitives and materials. Skinned and morphed nodes are excluded because their
+    // deformation state is per-entity.
+    tsl::robin_map<const cgltf_mesh*, std::vector<const cgltf_node*>> groups;
+    for (cgltf_size i = 0, n = srcAsset->nodes_count; i < n; ++i) {
+        const cgltf_node* node = &srcAsset->nodes[i];
+        const cgltf_mesh* mesh = node->mesh;
+        if (!mesh || node->skin || node->weights_count > 0 || mesh->weights_count > 0) {
+            continue;
+        }
+        if (mesh->primitives_count > 0 && mesh->primitives[0].targets_count > 0) {
+            continue;
+        }
+        if (hasAnimatedAncestor(node)) {
+            continue;
+        }
+        groups[mesh].push_back(node);
+    }
+
+    const size_t maxInstances = mEngine.getMaxAutomaticInstances();
+    for (const auto& [mesh, nodes] : groups) {
+        if (nodes.size() < 2 || nodes.size() > maxInstances) {
+            continue;
+        }
+
+        // The first node becomes the primary: it owns the renderable and contributes the
+        // identity transform. Every other node's transform is expressed relative to it.
+        const cgltf_node* primary = nodes[0];
+        mat4f primaryWorld;
+        cgltf_node_transform_world(primary, &primaryWorld[0][0]);
+        const mat4f primaryWorldInverse = inverse(primaryWorld);
+
+        FixedCapacityVector<mat4f> localTransforms(nodes.size());
+        for (size_t i = 0, c = nodes.size(); i < c; ++i) {
+            mat4f world;
+            cgltf_node_transform_world(nodes[i], &world[0][0]);
+            localTransforms[i] = primaryWorldInverse * world;
+            if (nodes[i] != primary) {
+                fAsset->mInstancedNodes.insert(nodes[i]);
+            }
+        }
+        fAsset->mInstancingGroups.emplace(primary, std::move(localTransforms));
+    }
+}
+
 void FAssetLoader::createInstances(size_t numInstances, FFilamentAsset* fAsset) {
     // Create a separate entity hierarchy for each instance. Note that MeshCache (vertex
     // buffers and index buffers) and MaterialInstanceCache (materials and textures) help avoid
@@ -587,10 +694,10 @@ void FAssetLoader::createInstances(size_t numInstances, FFilamentAsset* fAsset)
 }
 
 void FAssetLoader::recurseEntities(const cgltf_node* node, SceneMask scenes, Entity parent,
-        FFilamentAsset* fAsset, FFilamentInstance* instance) {
+        FFilamentAsset* fAsset, FFilamentInstance* instance, const Entity*& nextEntity) {
     NodeManager& nm = mNodeManager;
     const cgltf_data* srcAsset = fAsset->mSourceAsset->hierarchy;
-    const Entity entity = mEntityManager.create();
+    const Entity entity = *nextEntity++;
     nm.create(entity);
     const auto nodeInstance = nm.getInstance(entity);
     nm.setSceneMembership(nodeInstance, scenes);
@@ -637,8 +744,9 @@ void FAssetLoader::recurseEntities(const cgltf_node* node, SceneMask scenes, Ent
     // If no name is provided in the glTF or AssetConfiguration, use "node" for error messages.
     name = name ? name : "node";
 
-    // If the node has a mesh, then create a renderable component.
-    if (node->mesh) {
+    // If the node has a mesh, then create a renderable component, unless the node was collapsed
+    // into another node's InstanceBuffer, in which case it only keeps its entity and transform.
+    if (node->mesh && fAsset->mInstancedNodes.find(node) == fAsset->mInstancedNodes.end()) {
         createRenderable(node, entity, name, fAsset);
         if (srcAsset->variants_count > 0) {
             createMaterialVariants(node->mesh, entity, fAsset, instance);
@@ -654,7 +762,7 @@ void FAssetLoader::recurseEntities(const cgltf_node* node, SceneMask scenes, Ent
     }
 
     for (cgltf_size i = 0, len = node->children_count; i < len; ++i) {
-        recurseEntities(node->children[i], scenes, entity, fAsset, instance);
+        recurseEntities(node->children[i], scenes, entity, fAsset, instance, nextEntity);
     }
 }
 
@@ -874,6 +982,26 @@ void FAssetLoader::createRenderable(const cgltf_node* node, Entity entity, const
         builder.skinning(node->skin->joints_count);
     }
 
+    // If instancing detection collapsed other nodes into this one, create an InstanceBuffer with
+    // their baked transforms and grow the bounding box so that culling covers every instance.
+    if (auto iter = fAsset->mInstancingGroups.find(node);
+            UTILS_UNLIKELY(iter != fAsset->mInstancingGroups.end())) {
+        const FixedCapacityVector<mat4f>& localTransforms = iter->second;
+        InstanceBuffer* instanceBuffer = InstanceBuffer::Builder(localTransforms.size())
+                .localTransforms(localTransforms.data())
+                .build(mEngine);
+        fAsset->mInstanceBuffers.push_back(instanceBuffer);
+        builder.instances(localTransforms.size(), instanceBuffer);
+
+        Aabb instanced;
+        for (const mat4f& transform : localTransforms) {
+            const Aabb transformed = aabb.transform(transform);
+            instanced.min = min(instanced.min, transformed.min);
+            instanced.max = max(instanced.max, transformed.max);
+        }
+        aabb = instanced;
+    }
+
     // Per the spec, glTF models must have valid mix / max annotations for position attributes.
     // If desired, clients can call "recomputeBoundingBoxes()" in FilamentInstance.
     Box box = Box().set(aabb.min, aabb.max);
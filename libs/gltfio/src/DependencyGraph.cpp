@@ -16,6 +16,7 @@
 
 #include "DependencyGraph.h"
 
+#include <utils/compiler.h>
 #include <utils/debug.h>
 #include <utils/Panic.h>
 
@@ -70,26 +71,45 @@ void DependencyGraph::commitEdges() {
 
 void DependencyGraph::addEdge(Texture* texture, MaterialInstance* material, const char* parameter) {
     assert_invariant(texture);
-    if (!mDisabled) {
-        mTextureToMaterial[texture].insert(material);
-        mMaterialToTexture.at(material).params.at(parameter) = getStatus(texture);
+    if (mDisabled) {
+        return;
+    }
+    MaterialNode& node = mMaterialToTexture.at(material);
+    TextureNode*& slot = node.params.at(parameter);
+    if (UTILS_UNLIKELY(slot)) {
+        // the parameter is being rebound, undo the old texture's edge
+        auto& counts = mTextureToMaterial.at(slot->texture);
+        if (--counts.at(material) == 0) {
+            counts.erase(material);
+        }
+        if (slot->ready) {
+            node.numReadyParams--;
+        }
+    }
+    slot = getStatus(texture);
+    mTextureToMaterial[texture][material]++;
+    if (slot->ready) {
+        // the texture has already been decoded; completeness is evaluated when the
+        // edges are committed
+        node.numReadyParams++;
     }
 }
 
 void DependencyGraph::checkReadiness(Material* material) {
     auto& status = mMaterialToTexture.at(material);
 
-    // Check this material's texture parameters, there are 5 in the worst case.
-    bool materialIsReady = true;
+    // (Re)establish the ready-count from scratch; this is the only place that scans the
+    // parameters (there are 5 in the worst case), everything else is incremental.
+    uint32_t numReadyParams = 0;
     for (const auto& [name, texture] : status.params) {
-        if (!texture || !texture->ready) {
-            materialIsReady = false;
-            break;
+        if (texture && texture->ready) {
+            numReadyParams++;
         }
     }
+    status.numReadyParams = numReadyParams;
 
     // If all of its textures are ready, then the material has become ready.
-    if (materialIsReady) {
+    if (numReadyParams == status.params.size()) {
         markAsReady(material);
     }
 }
@@ -100,17 +120,35 @@ void DependencyGraph::markAsReady(Texture* texture) {
     if (iter == mTextureNodes.end()) {
         return;
     }
-    iter.value()->ready = true;
+    TextureNode* const node = iter.value().get();
+    if (node->ready) {
+        // already accounted for in the per-material ready-counts
+        return;
+    }
+    node->ready = true;
 
-    // Iterate over the materials associated with this texture to check if any have become ready.
-    // This is O(n2) but the inner loop is always small.
-    auto& materials = mTextureToMaterial.at(texture);
-    for (auto material : materials) {
-        checkReadiness(material);
+    // Bump the ready-count of each dependent material by the number of parameter slots
+    // bound to this texture; this is O(number of dependent materials), independent of
+    // how many parameters or textures those materials have.
+    auto t2m = mTextureToMaterial.find(texture);
+    if (t2m == mTextureToMaterial.end()) {
+        return;
+    }
+    for (const auto& [material, slotCount] : t2m->second) {
+        MaterialNode& mnode = mMaterialToTexture.at(material);
+        mnode.numReadyParams += slotCount;
+        assert_invariant(mnode.numReadyParams <= mnode.params.size());
+        if (mnode.numReadyParams == mnode.params.size()) {
+            markAsReady(material);
+        }
     }
 }
 
 void DependencyGraph::markAsReady(MaterialInstance* material) {
+    if (UTILS_UNLIKELY(!mReadyMaterials.insert(material).second)) {
+        // this material was already revealed, don't double-count it in the entities
+        return;
+    }
     auto iter = mMaterialToEntity.find(material);
     if (iter == mMaterialToEntity.end()) {
         // It's fine if no entities exist yet.
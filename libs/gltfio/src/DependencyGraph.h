@@ -25,6 +25,8 @@
 #include <queue>
 #include <string>
 
+#include <stdint.h>
+
 namespace filament {
     class MaterialInstance;
     class Texture;
@@ -91,6 +93,9 @@ private:
 
     struct MaterialNode {
         tsl::robin_map<std::string, TextureNode*> params;
+        // number of parameter slots bound to a decoded texture; the material becomes
+        // ready when this reaches params.size() (see markAsReady(Texture*))
+        uint32_t numReadyParams = 0;
     };
 
     struct EntityNode {
@@ -102,11 +107,19 @@ private:
     void markAsReady(Material* material);
     TextureNode* getStatus(Texture* texture);
 
-    // The following maps contain the directed edges in the graph.
+    // The following maps contain the directed edges in the graph. Texture => Material
+    // edges carry the number of parameter slots bound to the texture, so that a texture
+    // finishing its decode updates each dependent material's ready-count in O(1) without
+    // re-scanning its parameters.
     tsl::robin_map<Entity, EntityNode, Entity::Hasher> mEntityToMaterial;
     tsl::robin_map<Material*, tsl::robin_set<Entity, Entity::Hasher>> mMaterialToEntity;
     tsl::robin_map<Material*, MaterialNode> mMaterialToTexture;
-    tsl::robin_map<Texture*, tsl::robin_set<Material*>> mTextureToMaterial;
+    tsl::robin_map<Texture*, tsl::robin_map<Material*, uint32_t>> mTextureToMaterial;
+
+    // Materials that have already been revealed to their entities; guards against double
+    // counting in EntityNode::numReadyMaterials (e.g. when commitEdges() runs again after
+    // more edges were added).
+    tsl::robin_set<Material*> mReadyMaterials;
 
     // Each texture (and its readiness flag) can be referenced from multiple nodes, so we own
     // a collection of wrapper objects in the following map. This uses std::unique_ptr to allow
@@ -21,8 +21,12 @@
 #endif
 
 #include <utils/compiler.h>
+#include <utils/JobSystem.h>
 #include <utils/Log.h>
 
+#include <algorithm>
+#include <vector>
+
 #if GLTFIO_DRACO_SUPPORTED
 
 #include <memory>
@@ -49,6 +53,41 @@ DracoMesh* DracoCache::findOrCreateMesh(const cgltf_buffer_view* key) {
     return mesh;
 }
 
+void DracoCache::decodeMeshes(utils::JobSystem& js, const cgltf_buffer_view* const* keys,
+        size_t count) {
+    // Dedupe against existing cache entries and against repeated keys before fanning out;
+    // several primitives commonly reference the same compressed buffer view.
+    std::vector<const cgltf_buffer_view*> pending;
+    pending.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const cgltf_buffer_view* key = keys[i];
+        if (key && mCache.find(key) == mCache.end() &&
+                std::find(pending.begin(), pending.end(), key) == pending.end()) {
+            pending.push_back(key);
+        }
+    }
+    if (pending.empty()) {
+        return;
+    }
+
+    // Each worker decodes into its own slot; the cache is only mutated after the join.
+    std::vector<DracoMesh*> decoded(pending.size(), nullptr);
+    utils::JobSystem::Job* parent = js.createJob();
+    for (size_t i = 0, n = pending.size(); i < n; ++i) {
+        js.run(utils::jobs::createJob(js, parent, [&pending, &decoded, i] {
+            const cgltf_buffer_view* key = pending[i];
+            assert(key->buffer && key->buffer->data);
+            const uint8_t* compressedData = key->offset + (uint8_t*) key->buffer->data;
+            decoded[i] = DracoMesh::decode(compressedData, key->size);
+        }));
+    }
+    js.runAndWait(parent);
+
+    for (size_t i = 0, n = pending.size(); i < n; ++i) {
+        mCache.emplace(pending[i], decoded[i]);
+    }
+}
+
 DracoMesh::DracoMesh(struct DracoMeshDetails* details) : mDetails(details) {}
 
 #if GLTFIO_DRACO_SUPPORTED
@@ -21,6 +21,8 @@
 
 #include <tsl/robin_map.h>
 
+#include <utils/JobSystem.h>
+
 #include <memory>
 
 #ifndef GLTFIO_DRACO_SUPPORTED
@@ -38,6 +40,13 @@ class DracoMesh;
 class DracoCache {
 public:
     DracoMesh* findOrCreateMesh(const cgltf_buffer_view* key);
+
+    // Decodes the given compressed buffer views on JobSystem workers and populates the cache
+    // with the results, so that subsequent findOrCreateMesh() calls are cache hits that only
+    // perform accessor conversion. Must be called from the thread that owns the cache; the
+    // cache itself is never touched by the workers.
+    void decodeMeshes(utils::JobSystem& js, const cgltf_buffer_view* const* keys, size_t count);
+
 private:
     tsl::robin_map<const cgltf_buffer_view*, std::unique_ptr<DracoMesh>> mCache;
 };
@@ -23,6 +23,7 @@
 
 #include <filament/Engine.h>
 #include <filament/IndexBuffer.h>
+#include <filament/InstanceBuffer.h>
 #include <filament/MaterialInstance.h>
 #include <filament/RenderableManager.h>
 #include <filament/Texture.h>
@@ -264,6 +265,7 @@ struct FFilamentAsset : public FilamentAsset {
     std::vector<BufferObject*> mBufferObjects;
     std::vector<IndexBuffer*> mIndexBuffers;
     std::vector<MorphTargetBuffer*> mMorphTargetBuffers;
+    std::vector<InstanceBuffer*> mInstanceBuffers;
     utils::FixedCapacityVector<Skin> mSkins;
     utils::FixedCapacityVector<utils::CString> mScenes;
     Aabb mBoundingBox;
@@ -301,6 +303,13 @@ struct FFilamentAsset : public FilamentAsset {
     // The mapping of root nodes to scene membership sets.
     tsl::robin_map<cgltf_node*, SceneMask> mRootNodes;
 
+    // Instancing groups computed when AssetConfiguration::detectInstancing is set. Each group is
+    // keyed by the node that owns the instanced renderable and holds one transform per instance,
+    // relative to that node. Nodes in mInstancedNodes were collapsed into a group and do not get
+    // a renderable of their own.
+    tsl::robin_map<const cgltf_node*, utils::FixedCapacityVector<math::mat4f>> mInstancingGroups;
+    tsl::robin_set<const cgltf_node*> mInstancedNodes;
+
     // Stores all information related to a single cgltf_texture.
     // Note that more than one cgltf_texture can map to a single Filament texture,
     // e.g. if several have the same URL or bufferView. For each Filament texture,
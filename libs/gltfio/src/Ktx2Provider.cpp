@@ -70,6 +70,7 @@ private:
         ktxreader::Ktx2Reader::Async* async;
         QueueItemState state;
         atomic<TranscoderState> transcoderState;
+        atomic<uint32_t> remainingLevels;
         JobSystem::Job* job;
     };
 
@@ -115,12 +116,26 @@ Texture* Ktx2Provider::pushTexture(const uint8_t* data, size_t byteCount,
         return async->getTexture();
     }
 
+    // Parallelize across mip levels rather than across whole textures, so that a single large
+    // texture doesn't serialize on one core while smaller ones finish early. The level job that
+    // finishes last publishes the final state; a failed level stores ERROR before decrementing
+    // the counter, so ERROR always wins over SUCCESS.
     JobSystem* js = &mEngine->getJobSystem();
-    item->job = jobs::createJob(*js, mDecoderRootJob, [item] {
-        using Result = ktxreader::Ktx2Reader::Result;
-        const bool success = Result::SUCCESS == item->async->doTranscoding();
-        item->transcoderState.store(success ? TranscoderState::SUCCESS : TranscoderState::ERROR);
-    });
+    const uint32_t levelCount = item->async->getLevelCount();
+    item->remainingLevels.store(levelCount);
+    item->job = js->createJob(mDecoderRootJob);
+    for (uint32_t levelIndex = 0; levelIndex < levelCount; ++levelIndex) {
+        js->run(jobs::createJob(*js, item->job, [item, levelIndex] {
+            using Result = ktxreader::Ktx2Reader::Result;
+            if (Result::SUCCESS != item->async->doTranscoding(levelIndex)) {
+                item->transcoderState.store(TranscoderState::ERROR);
+            }
+            if (item->remainingLevels.fetch_sub(1) == 1) {
+                TranscoderState expected = TranscoderState::NOT_STARTED;
+                item->transcoderState.compare_exchange_strong(expected, TranscoderState::SUCCESS);
+            }
+        }));
+    }
 
     js->runAndRetain(item->job);
     return async->getTexture();
@@ -49,11 +49,13 @@
 #include <math/vec4.h>
 
 #include <tsl/robin_map.h>
+#include <tsl/robin_set.h>
 
 #include <fstream>
 #include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 using namespace filament;
 using namespace filament::math;
@@ -82,11 +84,15 @@ struct ResourceLoader::Impl {
     explicit Impl(const ResourceConfiguration& config) :
         mEngine(config.engine),
         mNormalizeSkinningWeights(config.normalizeSkinningWeights),
+        mUploadBudgetBytes(config.uploadBudgetBytes),
+        mOptimizeMeshes(config.optimizeMeshes),
         mGltfPath(config.gltfPath ? config.gltfPath : ""),
         mUriDataCache(std::make_shared<UriDataCache>()) {}
 
     Engine* const mEngine;
     bool mNormalizeSkinningWeights;
+    size_t mUploadBudgetBytes;
+    bool mOptimizeMeshes;
     std::string mGltfPath;
 
     // User-provided resource data with URI string keys, populated with addResourceData().
@@ -228,8 +234,118 @@ inline void createSkins(cgltf_data const* gltf, bool normalize,
     }
 }
 
+// Reorders a triangle primitive's index data in place with meshoptimizer's vertex-cache and
+// overdraw passes. The vertex-fetch pass is intentionally not run: it reorders the vertex
+// streams themselves, which may be shared (or interleaved) with other primitives.
+static void optimizePrimitiveIndices(const cgltf_primitive* prim) {
+    const cgltf_accessor* indices = prim->indices;
+    const size_t indexCount = indices->count;
+
+    const cgltf_accessor* positions = nullptr;
+    for (cgltf_size i = 0; i < prim->attributes_count; i++) {
+        if (prim->attributes[i].type == cgltf_attribute_type_position) {
+            positions = prim->attributes[i].data;
+            break;
+        }
+    }
+    if (!positions || positions->count == 0) {
+        return;
+    }
+    const size_t vertexCount = positions->count;
+
+    std::vector<uint32_t> scratch(indexCount);
+    for (size_t i = 0; i < indexCount; i++) {
+        scratch[i] = uint32_t(cgltf_accessor_read_index(indices, i));
+    }
+
+    meshopt_optimizeVertexCache(scratch.data(), scratch.data(), indexCount, vertexCount);
+
+    // The overdraw pass must run after (and preserves) the vertex-cache ordering.
+    if (positions->type == cgltf_type_vec3 && !positions->is_sparse) {
+        std::vector<float> unpacked(vertexCount * 3);
+        cgltf_accessor_unpack_floats(positions, unpacked.data(), unpacked.size());
+        constexpr float kOverdrawThreshold = 1.05f;   // allow 5% ACMR regression
+        meshopt_optimizeOverdraw(scratch.data(), scratch.data(), indexCount, unpacked.data(),
+                vertexCount, 3 * sizeof(float), kOverdrawThreshold);
+    }
+
+    // Write the permuted indices back where uploadBuffers() will pick them up, preserving
+    // the source component type.
+    const cgltf_buffer_view* view = indices->buffer_view;
+    uint8_t* data;
+    if (view->has_meshopt_compression) {
+        data = (uint8_t*) view->data + indices->offset;
+    } else {
+        data = (uint8_t*) view->buffer->data + utility::computeBindingOffset(indices);
+    }
+    const size_t stride = indices->stride;
+    switch (indices->component_type) {
+        case cgltf_component_type_r_8u:
+            for (size_t i = 0; i < indexCount; i++) {
+                *(data + i * stride) = uint8_t(scratch[i]);
+            }
+            break;
+        case cgltf_component_type_r_16u:
+            for (size_t i = 0; i < indexCount; i++) {
+                *(uint16_t*) (data + i * stride) = uint16_t(scratch[i]);
+            }
+            break;
+        case cgltf_component_type_r_32u:
+            for (size_t i = 0; i < indexCount; i++) {
+                *(uint32_t*) (data + i * stride) = scratch[i];
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// Opt-in load-time index optimization, see ResourceConfiguration::optimizeMeshes. Runs after
+// Draco/meshopt decompression and before upload, one job per primitive.
+inline void optimizeMeshes(FFilamentAsset* asset, JobSystem& js) {
+    FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_GLTFIO);
+
+    auto& primitives = std::get<FFilamentAsset::ResourceInfo>(asset->mResourceInfo).mPrimitives;
+
+    // index accessors can be shared between primitives, only optimize each one once
+    tsl::robin_set<const cgltf_accessor*> seen;
+
+    JobSystem::Job* parent = js.createJob();
+    for (auto& [prim, vertexBuffer] : primitives) {
+        if (prim->type != cgltf_primitive_type_triangles || !prim->indices) {
+            continue;
+        }
+        const cgltf_accessor* indices = prim->indices;
+        if (!indices->buffer_view || indices->is_sparse
+                || indices->count < 3 || indices->count % 3 != 0) {
+            continue;
+        }
+        if (!seen.insert(indices).second) {
+            continue;
+        }
+        const cgltf_primitive* p = prim;
+        js.run(jobs::createJob(js, parent, [p] { optimizePrimitiveIndices(p); }));
+    }
+    js.runAndWait(parent);
+}
+
 inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
-        UriDataCacheHandle uriDataCache) {
+        UriDataCacheHandle uriDataCache, size_t uploadBudgetBytes) {
+    // When an upload budget is configured, track how much data has been handed to the backend
+    // and wait for it to drain before queueing more. This bounds the transient memory held by
+    // the command stream (and by the conversion copies made below) while loading large assets.
+    size_t pendingUploadBytes = 0;
+    auto const trackUpload = [&](size_t byteCount) {
+        if (uploadBudgetBytes == 0) {
+            return;
+        }
+        pendingUploadBytes += byteCount;
+        if (pendingUploadBytes >= uploadBudgetBytes) {
+            engine.flushAndWait();
+            pendingUploadBytes = 0;
+        }
+    };
+
     // Upload VertexBuffer and IndexBuffer data to the GPU.
     auto& slots = std::get<FFilamentAsset::ResourceInfo>(asset->mResourceInfo).mBufferSlots;
     for (auto const& slot: slots) {
@@ -258,6 +374,7 @@ inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
                 asset->mBufferObjects.push_back(bo);
                 bo->setBuffer(engine, BufferDescriptor(floatsData, floatsByteCount, FREE_CALLBACK));
                 slot.vertexBuffer->setBufferObjectAt(engine, slot.bufferIndex, bo);
+                trackUpload(floatsByteCount);
                 continue;
             }
 
@@ -266,6 +383,7 @@ inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
             bo->setBuffer(engine, BufferDescriptor(data, size, uploadCallback,
                                           uploadUserdata(asset, uriDataCache)));
             slot.vertexBuffer->setBufferObjectAt(engine, slot.bufferIndex, bo);
+            trackUpload(size);
             continue;
         } else if (slot.indexBuffer) {
             if (accessor->component_type == cgltf_component_type_r_8u) {
@@ -275,11 +393,13 @@ inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
                 IndexBuffer::BufferDescriptor bd(data16, size16, FREE_CALLBACK);
 
                 slot.indexBuffer->setBuffer(engine, std::move(bd));
+                trackUpload(size16);
                 continue;
             }
             IndexBuffer::BufferDescriptor bd(data, size, uploadCallback,
                     uploadUserdata(asset, uriDataCache));
             slot.indexBuffer->setBuffer(engine, std::move(bd));
+            trackUpload(size);
             continue;
         }
 
@@ -303,6 +423,7 @@ inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
                         slot.morphTargetOffset);
             }
             free(floatsData);
+            trackUpload(floatsByteCount);
             continue;
         }
 
@@ -316,6 +437,7 @@ inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
                     slot.morphTargetCount,
                     slot.morphTargetOffset);
         }
+        trackUpload(size);
     }
 }
 
@@ -329,6 +451,8 @@ ResourceLoader::~ResourceLoader() {
 
 void ResourceLoader::setConfiguration(const ResourceConfiguration& config) {
     pImpl->mNormalizeSkinningWeights = config.normalizeSkinningWeights;
+    pImpl->mUploadBudgetBytes = config.uploadBudgetBytes;
+    pImpl->mOptimizeMeshes = config.optimizeMeshes;
     pImpl->mGltfPath = config.gltfPath;
 }
 
@@ -435,6 +559,18 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
         // as tangent generation.
         DracoCache* dracoCache = &asset->mSourceAsset->dracoCache;
         auto& primitives = std::get<FFilamentAsset::ResourceInfo>(asset->mResourceInfo).mPrimitives;
+        // Decode every referenced Draco mesh on JobSystem workers first; the per-primitive pass
+        // below then hits the warm cache and only performs accessor conversion.
+        std::vector<const cgltf_buffer_view*> dracoViews;
+        for (auto& [prim, vertexBuffer]: primitives) {
+            if (prim->has_draco_mesh_compression) {
+                dracoViews.push_back(prim->draco_mesh_compression.buffer_view);
+            }
+        }
+        if (!dracoViews.empty()) {
+            dracoCache->decodeMeshes(pImpl->mEngine->getJobSystem(), dracoViews.data(),
+                    dracoViews.size());
+        }
         // Go through every primitive and check if it has a Draco mesh.
         for (auto& [prim, vertexBuffer]: primitives) {
             if (!prim->has_draco_mesh_compression) {
@@ -444,7 +580,11 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
         }
         utility::decodeMeshoptCompression((cgltf_data*) gltf);
 
-        uploadBuffers(asset, *pImpl->mEngine, pImpl->mUriDataCache);
+        if (pImpl->mOptimizeMeshes) {
+            optimizeMeshes(asset, pImpl->mEngine->getJobSystem());
+        }
+
+        uploadBuffers(asset, *pImpl->mEngine, pImpl->mUriDataCache, pImpl->mUploadBudgetBytes);
 
         // Compute surface orientation quaternions if necessary. This is similar to sparse data in
         // that we need to generate the contents of a GPU buffer by processing one or more CPU
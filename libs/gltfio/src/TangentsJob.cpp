@@ -15,6 +15,7 @@
  */
 
 #include "TangentsJob.h"
+#include "Utility.h"
 
 #include <cstdlib>
 #include <memory>
@@ -129,12 +130,7 @@ void TangentsJob::run(Params* params) {
     unpackedTriangles.reset(new uint3[triangleCount]);
 
     if (prim.indices) {
-        for (size_t tri = 0, j = 0; tri < triangleCount; ++tri) {
-            auto& triangle = unpackedTriangles[tri];
-            triangle.x = cgltf_accessor_read_index(prim.indices, j++);
-            triangle.y = cgltf_accessor_read_index(prim.indices, j++);
-            triangle.z = cgltf_accessor_read_index(prim.indices, j++);
-        }
+        utility::unpackIndices(prim.indices, &unpackedTriangles[0].x, triangleCount * 3);
     } else {
         for (size_t tri = 0, j = 0; tri < triangleCount; ++tri) {
             auto& triangle = unpackedTriangles[tri];
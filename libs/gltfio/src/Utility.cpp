@@ -172,6 +172,56 @@ uint32_t computeBindingOffset(cgltf_accessor const* accessor) {
     return uint32_t(accessor->offset + accessor->buffer_view->offset);
 }
 
+// Unpacks triangle indices into tightly packed 32-bit values. cgltf_accessor_read_index
+// re-validates the accessor on every call, which dominates tangent generation for large meshes,
+// so when the index data is non-sparse and tightly packed we copy (or widen) it in bulk instead;
+// these loops are trivially vectorized by the compiler.
+void unpackIndices(cgltf_accessor const* indices, uint32_t* dst, size_t count) {
+    const cgltf_buffer_view* view = indices->buffer_view;
+    const uint8_t* src = nullptr;
+    if (!indices->is_sparse && view) {
+        if (view->has_meshopt_compression) {
+            if (view->data) {
+                src = (const uint8_t*) view->data + indices->offset;
+            }
+        } else if (view->buffer->data) {
+            src = (const uint8_t*) view->buffer->data + computeBindingOffset(indices);
+        }
+    }
+    if (src) {
+        switch (indices->component_type) {
+            case cgltf_component_type_r_32u:
+                if (indices->stride == sizeof(uint32_t)) {
+                    memcpy(dst, src, count * sizeof(uint32_t));
+                    return;
+                }
+                break;
+            case cgltf_component_type_r_16u:
+                if (indices->stride == sizeof(uint16_t)) {
+                    const uint16_t* src16 = (const uint16_t*) src;
+                    for (size_t i = 0; i < count; ++i) {
+                        dst[i] = src16[i];
+                    }
+                    return;
+                }
+                break;
+            case cgltf_component_type_r_8u:
+                if (indices->stride == sizeof(uint8_t)) {
+                    for (size_t i = 0; i < count; ++i) {
+                        dst[i] = src[i];
+                    }
+                    return;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = cgltf_accessor_read_index(indices, i);
+    }
+}
+
 bool requiresConversion(cgltf_accessor const* accessor) {
     if (UTILS_UNLIKELY(accessor->is_sparse)) {
         return true;
@@ -475,15 +475,8 @@ void TangentsJobExtended::run(Params* params) {
     size_t const triangleCount = prim.indices ? (prim.indices->count / 3) : (vertexCount / 3);
     unpackedTriangles.reset(new uint3[triangleCount]);
 
-    // TODO: this is slow. We might be able to skip the manual read if the indices are already in
-    // the right format.
     if (prim.indices) {
-        for (size_t tri = 0, j = 0; tri < triangleCount; ++tri) {
-            auto& triangle = unpackedTriangles[tri];
-            triangle.x = cgltf_accessor_read_index(prim.indices, j++);
-            triangle.y = cgltf_accessor_read_index(prim.indices, j++);
-            triangle.z = cgltf_accessor_read_index(prim.indices, j++);
-        }
+        utility::unpackIndices(prim.indices, &unpackedTriangles[0].x, triangleCount * 3);
     } else {
         for (size_t tri = 0, j = 0; tri < triangleCount; ++tri) {
             auto& triangle = unpackedTriangles[tri];
@@ -21,13 +21,23 @@
 #include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <utils/JobSystem.h>
 #include <utils/Panic.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#   include <arm_neon.h>
+#   define IMAGE_SAMPLER_USE_NEON 1
+#elif defined(__x86_64__) || (defined(_M_X64) && !defined(_M_ARM64EC))
+#   include <immintrin.h>
+#   define IMAGE_SAMPLER_USE_SSE 1
+#endif
+
 using namespace image;
 
 namespace {
@@ -226,8 +236,70 @@ void normalize(LinearImage& image) {
     }
 }
 
+// Executes the expanded (per-channel) MAD program over a range of rows.
+void processRowsScalar(MadProgram const& program,
+        float const* UTILS_RESTRICT sourceRow, float* UTILS_RESTRICT targetRow,
+        size_t sourceStride, size_t targetStride, size_t rowCount) {
+    for (size_t row = 0; row < rowCount; ++row) {
+        for (auto const& mad : program) {
+            targetRow[mad.targetIndex] += sourceRow[mad.sourceIndex] * mad.weight;
+        }
+        targetRow += targetStride;
+        sourceRow += sourceStride;
+    }
+}
+
+// Executes the single-channel MAD program over a range of rows of 4-channel pixels, one whole
+// pixel per instruction: a quarter of the instruction stream of the scalar path, and each
+// multiply-add runs on full vector registers.
+void processRows4(MadProgram const& program,
+        float const* UTILS_RESTRICT sourceRow, float* UTILS_RESTRICT targetRow,
+        size_t sourceStride, size_t targetStride, size_t rowCount) {
+    for (size_t row = 0; row < rowCount; ++row) {
+#if defined(IMAGE_SAMPLER_USE_NEON)
+        for (auto const& mad : program) {
+            float const* const s = sourceRow + mad.sourceIndex * 4;
+            float* const t = targetRow + mad.targetIndex * 4;
+            vst1q_f32(t, vfmaq_n_f32(vld1q_f32(t), vld1q_f32(s), mad.weight));
+        }
+#elif defined(IMAGE_SAMPLER_USE_SSE)
+        for (auto const& mad : program) {
+            float const* const s = sourceRow + mad.sourceIndex * 4;
+            float* const t = targetRow + mad.targetIndex * 4;
+            _mm_storeu_ps(t, _mm_add_ps(_mm_loadu_ps(t),
+                    _mm_mul_ps(_mm_loadu_ps(s), _mm_set1_ps(mad.weight))));
+        }
+#else
+        for (auto const& mad : program) {
+            float const* const s = sourceRow + mad.sourceIndex * 4;
+            float* const t = targetRow + mad.targetIndex * 4;
+            for (int c = 0; c < 4; ++c) {
+                t[c] += s[c] * mad.weight;
+            }
+        }
+#endif
+        targetRow += targetStride;
+        sourceRow += sourceStride;
+    }
+}
+
+// Runs rowFunc(firstRow, rowCount) over [0, rowCount), splitting over the JobSystem when one
+// is provided and the image is tall enough to amortize the scheduling overhead. Each row only
+// touches its own slice of the source and target images, so rows can run concurrently.
+template<typename F>
+void forEachRowRange(utils::JobSystem* js, uint32_t rowCount, F rowFunc) {
+    if (js && rowCount >= 64) {
+        auto* job = utils::jobs::parallel_for(*js, nullptr, 0, rowCount,
+                std::ref(rowFunc), utils::jobs::CountSplitter<16, 8>());
+        js->runAndWait(job);
+    } else {
+        rowFunc(0, rowCount);
+    }
+}
+
 LinearImage resampleImage1D(const LinearImage& source, MadProgram* program,
-        uint32_t twidth, Filter filter, float left, float right, float filterRadiusMultiplier) {
+        uint32_t twidth, Filter filter, float left, float right, float filterRadiusMultiplier,
+        utils::JobSystem* js = nullptr) {
     const uint32_t swidth = source.getWidth();
     const uint32_t sheight = source.getHeight();
     const uint32_t nchan = source.getChannels();
@@ -238,37 +310,50 @@ LinearImage resampleImage1D(const LinearImage& source, MadProgram* program,
     // Generate a flat list of multiply-add (MAD) instructions.
     program->clear();
     generateMadProgram(twidth, swidth, left, right, hfn, filterRadiusMultiplier, program);
-    expandMadProgram(nchan, program);
 
     // Allocate the target image.
     LinearImage result(twidth, sheight, nchan);
-    float const* sourceRow = source.getPixelRef();
-    float* targetRow = result.getPixelRef();
+    float const* const sourcePixels = source.getPixelRef();
+    float* const targetPixels = result.getPixelRef();
+    const size_t sourceStride = size_t(swidth) * nchan;
+    const size_t targetStride = size_t(twidth) * nchan;
 
     // The MIN filter is special because it starts with non-zero values and ignores filter weights.
     if (filter == Filter::MINIMUM) {
+        expandMadProgram(nchan, program);
         for (uint32_t n = 0; n < twidth * sheight * nchan; ++n) {
-            targetRow[n] = std::numeric_limits<float>::max();
+            targetPixels[n] = std::numeric_limits<float>::max();
         }
-        for (uint32_t row = 0; row < sheight; ++row) {
-            for (auto mad : *program) {
-                const float a = sourceRow[mad.sourceIndex];
-                const float b = targetRow[mad.targetIndex];
-                targetRow[mad.targetIndex] = std::min(a, b);
+        forEachRowRange(js, sheight, [&](size_t firstRow, size_t rowCount) {
+            float const* sourceRow = sourcePixels + firstRow * sourceStride;
+            float* targetRow = targetPixels + firstRow * targetStride;
+            for (size_t row = 0; row < rowCount; ++row) {
+                for (auto const& mad : *program) {
+                    const float a = sourceRow[mad.sourceIndex];
+                    const float b = targetRow[mad.targetIndex];
+                    targetRow[mad.targetIndex] = std::min(a, b);
+                }
+                targetRow += targetStride;
+                sourceRow += sourceStride;
             }
-            targetRow += twidth * nchan;
-            sourceRow += swidth * nchan;
-        }
+        });
         return result;
     }
 
-    // Resize the image horizontally by executing the MAD instructions over each row.
-    for (uint32_t row = 0; row < sheight; ++row) {
-        for (auto mad : *program) {
-            targetRow[mad.targetIndex] += sourceRow[mad.sourceIndex] * mad.weight;
-        }
-        targetRow += twidth * nchan;
-        sourceRow += swidth * nchan;
+    // Resize the image horizontally by executing the MAD instructions over each row. For
+    // 4-channel images we keep the program in single-channel (per-pixel) form and use the
+    // vectorized kernel; other channel counts run the expanded per-channel program.
+    if (nchan == 4) {
+        forEachRowRange(js, sheight, [&](size_t firstRow, size_t rowCount) {
+            processRows4(*program, sourcePixels + firstRow * sourceStride,
+                    targetPixels + firstRow * targetStride, sourceStride, targetStride, rowCount);
+        });
+    } else {
+        expandMadProgram(nchan, program);
+        forEachRowRange(js, sheight, [&](size_t firstRow, size_t rowCount) {
+            processRowsScalar(*program, sourcePixels + firstRow * sourceStride,
+                    targetPixels + firstRow * targetStride, sourceStride, targetStride, rowCount);
+        });
     }
 
     // Perform post processing for the current pass.
@@ -286,8 +371,8 @@ SingleSample::~SingleSample() {
     delete[] data;
 }
 
-LinearImage resampleImage(const LinearImage& source, uint32_t width, uint32_t height,
-        const ImageSampler& sampler) {
+static LinearImage resampleImage(utils::JobSystem* js, const LinearImage& source,
+        uint32_t width, uint32_t height, const ImageSampler& sampler) {
     FILAMENT_CHECK_PRECONDITION(sampler.east.mode == Boundary::EXCLUDE &&
             sampler.north.mode == Boundary::EXCLUDE && sampler.west.mode == Boundary::EXCLUDE &&
             sampler.south.mode == Boundary::EXCLUDE)
@@ -301,11 +386,16 @@ LinearImage resampleImage(const LinearImage& source, uint32_t width, uint32_t he
     const float bottom = sampler.sourceRegion.bottom;
     MadProgram program;
     LinearImage result;
-    result = transpose(resampleImage1D(source, &program, width, hfilter, left, right, radius));
-    result = transpose(resampleImage1D(result, &program, height, vfilter, top, bottom, radius));
+    result = transpose(resampleImage1D(source, &program, width, hfilter, left, right, radius, js));
+    result = transpose(resampleImage1D(result, &program, height, vfilter, top, bottom, radius, js));
     return result;
 }
 
+LinearImage resampleImage(const LinearImage& source, uint32_t width, uint32_t height,
+        const ImageSampler& sampler) {
+    return resampleImage(nullptr, source, width, height, sampler);
+}
+
 LinearImage resampleImage(const LinearImage& source, uint32_t width, uint32_t height,
         Filter filter) {
     return resampleImage(source, width, height, ImageSampler {
@@ -314,6 +404,19 @@ LinearImage resampleImage(const LinearImage& source, uint32_t width, uint32_t he
     });
 }
 
+LinearImage resampleImage(utils::JobSystem& js, const LinearImage& source,
+        uint32_t width, uint32_t height, const ImageSampler& sampler) {
+    return resampleImage(&js, source, width, height, sampler);
+}
+
+LinearImage resampleImage(utils::JobSystem& js, const LinearImage& source,
+        uint32_t width, uint32_t height, Filter filter) {
+    return resampleImage(js, source, width, height, ImageSampler {
+        .horizontalFilter = filter,
+        .verticalFilter = filter
+    });
+}
+
 void computeSingleSample(const LinearImage& source, float x, float y, SingleSample* result,
         Filter filter) {
     const float radius = 1.0f;
@@ -348,6 +451,18 @@ void generateMipmaps(const LinearImage& source, Filter filter, LinearImage* resu
     }
 }
 
+void generateMipmaps(utils::JobSystem& js, const LinearImage& source, Filter filter,
+        LinearImage* result, uint32_t mips) {
+    mips = std::min(mips, getMipmapCount(source));
+    uint32_t width = source.getWidth();
+    uint32_t height = source.getHeight();
+    for (uint32_t n = 0; n < mips; ++n) {
+        width = std::max(width >> 1u, 1u);
+        height = std::max(height >> 1u, 1u);
+        result[n] = resampleImage(js, source, width, height, filter);
+    }
+}
+
 uint32_t getMipmapCount(const LinearImage& source) {
     uint32_t width = source.getWidth();
     uint32_t height = source.getHeight();
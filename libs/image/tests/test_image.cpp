@@ -26,12 +26,14 @@
 
 #include <gtest/gtest.h>
 
+#include <utils/JobSystem.h>
 #include <utils/Panic.h>
 #include <utils/Path.h>
 
 #include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <cstring>
 #include <fstream>
 #include <string>
 #include <sstream>
@@ -238,6 +240,27 @@ TEST_F(ImageTest, ColorFilters) { // NOLINT
     ASSERT_EQ(blu, 200);
 }
 
+TEST_F(ImageTest, ParallelResample) { // NOLINT
+    utils::JobSystem js;
+    js.adopt();
+
+    // 4 channels exercise the vectorized per-pixel kernel, 3 channels the per-channel one.
+    for (uint32_t nchan : { 3u, 4u }) {
+        LinearImage source(640, 400, nchan);
+        float* pixels = source.getPixelRef();
+        for (uint32_t n = 0; n < 640 * 400 * nchan; ++n) {
+            pixels[n] = float(n % 251) / 250.0f;
+        }
+        for (auto filter : { Filter::BOX, Filter::MITCHELL, Filter::LANCZOS }) {
+            auto serial = resampleImage(source, 101, 77, filter);
+            auto parallel = resampleImage(js, source, 101, 77, filter);
+            // row partitioning must not change the result
+            ASSERT_EQ(0, memcmp(serial.getPixelRef(), parallel.getPixelRef(),
+                    sizeof(float) * 101 * 77 * nchan));
+        }
+    }
+}
+
 TEST_F(ImageTest, VectorFilters) { // NOLINT
     auto toColors = vectorsToColors;
     auto normals = createNormalMap(1024);
@@ -35,6 +35,7 @@
 #    include <arpa/inet.h>
 #endif
 
+#include <math/half.h>
 #include <math/vec3.h>
 #include <math/vec4.h>
 
@@ -256,6 +257,40 @@ LinearImage PNGDecoder::decode() {
         uint32_t height = png_get_image_height(mPNG, mInfo);
         size_t rowBytes = png_get_rowbytes(mPNG, mInfo);
 
+        // Non-interlaced files (the common case) are streamed one scanline at a time so
+        // peak memory is the output image plus a single row; staging the whole 16-bit
+        // image first costs gigabytes on very large sources.
+        if (png_get_interlace_type(mPNG, mInfo) == PNG_INTERLACE_NONE) {
+            imageData = std::make_unique<uint8_t[]>(rowBytes);
+            const bool hasAlpha = colorType == PNG_COLOR_TYPE_RGBA;
+            const bool srgb = getColorSpace() == ImageDecoder::ColorSpace::SRGB;
+            LinearImage image(width, height, hasAlpha ? 4 : 3);
+            for (uint32_t y = 0; y < height; y++) {
+                png_read_row(mPNG, imageData.get(), nullptr);
+                // PNG 16 stores data in network order (big endian)
+                auto const* src = reinterpret_cast<uint16_t const*>(imageData.get());
+                if (hasAlpha) {
+                    auto* dst = reinterpret_cast< filament::math::float4*>(image.getPixelRef(0, y));
+                    for (uint32_t x = 0; x < width; x++, src += 4) {
+                         filament::math::float4 sRGB(ntohs(src[0]), ntohs(src[1]),
+                                ntohs(src[2]), ntohs(src[3]));
+                        sRGB /= std::numeric_limits<uint16_t>::max();
+                        dst[x] = srgb ? sRGBToLinear(sRGB) : sRGB;
+                    }
+                } else {
+                    auto* dst = reinterpret_cast< filament::math::float3*>(image.getPixelRef(0, y));
+                    for (uint32_t x = 0; x < width; x++, src += 3) {
+                         filament::math::float3 sRGB(ntohs(src[0]), ntohs(src[1]), ntohs(src[2]));
+                        sRGB /= std::numeric_limits<uint16_t>::max();
+                        dst[x] = srgb ? sRGBToLinear(sRGB) : sRGB;
+                    }
+                }
+            }
+            png_read_end(mPNG, mInfo);
+            return image;
+        }
+
+        // Interlaced files require several passes over the whole image; keep the staging path.
         imageData = std::make_unique<uint8_t[]>(height * rowBytes);
         std::unique_ptr<png_bytep[]> rowPointers(new png_bytep[height]);
         for (size_t y = 0 ; y < height ; y++) {
@@ -449,7 +484,7 @@ EXRDecoder::~EXRDecoder() = default;
 
 LinearImage EXRDecoder::decode() {
     try {
-        // copy the EXR data in memory
+        // copy the EXR data in memory, tinyexr only parses complete buffers
         std::vector<unsigned char> src;
         unsigned char buffer[4096];
         while (mStream.read(reinterpret_cast<char*>(buffer), sizeof(buffer))) {
@@ -457,38 +492,108 @@ LinearImage EXRDecoder::decode() {
         }
         src.insert(src.end(), &buffer[0], &buffer[mStream.gcount()]);
 
-        int width;
-        int height;
-        float* rgba;
-        const char* error;
+        const char* error = nullptr;
 
-        int ret = LoadEXRFromMemory(&rgba, &width, &height, src.data(), src.size(), &error);
-        if (ret != TINYEXR_SUCCESS) {
+        EXRVersion version;
+        if (ParseEXRVersionFromMemory(&version, src.data(), src.size()) != TINYEXR_SUCCESS ||
+                version.multipart || version.non_image) {
+            std::cerr << "Could not decode OpenEXR: unsupported layout" << std::endl;
+            mStream.seekg(mStreamStartPos);
+            return LinearImage();
+        }
+
+        EXRHeader header;
+        InitEXRHeader(&header);
+        if (ParseEXRHeaderFromMemory(&header, &version, src.data(), src.size(), &error)
+                != TINYEXR_SUCCESS) {
             std::cerr << "Could not decode OpenEXR: " << error << std::endl;
             FreeEXRErrorMessage(error);
             mStream.seekg(mStreamStartPos);
             return LinearImage();
         }
 
+        // Decode to the stored pixel type (typically HALF) rather than asking tinyexr for
+        // a float conversion: the float staging planes would be twice the size of the
+        // file's own data, which matters a lot for large environment sources. The
+        // half->float conversion happens below, while writing the output image.
+        EXRImage exrImage;
+        InitEXRImage(&exrImage);
+        if (LoadEXRImageFromMemory(&exrImage, &header, src.data(), src.size(), &error)
+                != TINYEXR_SUCCESS) {
+            std::cerr << "Could not decode OpenEXR: " << error << std::endl;
+            FreeEXRErrorMessage(error);
+            FreeEXRHeader(&header);
+            mStream.seekg(mStreamStartPos);
+            return LinearImage();
+        }
+
+        // release the source bytes before allocating the output image
         src.clear();
         src.shrink_to_fit();
 
-        LinearImage image((uint32_t) width, (uint32_t) height, 3);
-
-        size_t i = 0;
-        for (uint32_t y = 0; y < height; y++) {
-            for (uint32_t x = 0; x < width; x++) {
-                filament::math::float3& pixel =
-                        *reinterpret_cast< filament::math::float3*>(image.getPixelRef(x, y));
-                pixel.r = rgba[i++];
-                pixel.g = rgba[i++];
-                pixel.b = rgba[i++];
-                // skip alpha
-                i++;
+        // find the RGB channels; grayscale images replicate their single channel
+        int channels[3] = { 0, 0, 0 };
+        for (int c = 0; c < header.num_channels; c++) {
+            char const* const name = header.channels[c].name;
+            if (!strcmp(name, "R")) { channels[0] = c; }
+            else if (!strcmp(name, "G")) { channels[1] = c; }
+            else if (!strcmp(name, "B")) { channels[2] = c; }
+        }
+        for (int i = 0; i < 3; i++) {
+            const int type = header.requested_pixel_types[channels[i]];
+            if (type != TINYEXR_PIXELTYPE_HALF && type != TINYEXR_PIXELTYPE_FLOAT) {
+                std::cerr << "Could not decode OpenEXR: unsupported pixel type" << std::endl;
+                FreeEXRImage(&exrImage);
+                FreeEXRHeader(&header);
+                mStream.seekg(mStreamStartPos);
+                return LinearImage();
+            }
+        }
+
+        const uint32_t width = uint32_t(exrImage.width);
+        const uint32_t height = uint32_t(exrImage.height);
+        LinearImage image(width, height, 3);
+
+        // copies one window of decoded channel planes into the output image
+        auto writeWindow = [&](unsigned char* const* planes, uint32_t x0, uint32_t y0,
+                uint32_t w, uint32_t h) {
+            for (size_t i = 0; i < 3; i++) {
+                const int c = channels[i];
+                const bool isHalf = header.requested_pixel_types[c] == TINYEXR_PIXELTYPE_HALF;
+                for (uint32_t y = 0; y < h && y0 + y < height; y++) {
+                    float* dst = reinterpret_cast<float*>(image.getPixelRef(x0, y0 + y)) + i;
+                    if (isHalf) {
+                        auto const* p = reinterpret_cast<uint16_t const*>(planes[c]) + size_t(y) * w;
+                        for (uint32_t x = 0; x < w && x0 + x < width; x++, dst += 3) {
+                            *dst = float(filament::math::makeHalf(p[x]));
+                        }
+                    } else {
+                        auto const* p = reinterpret_cast<float const*>(planes[c]) + size_t(y) * w;
+                        for (uint32_t x = 0; x < w && x0 + x < width; x++, dst += 3) {
+                            *dst = p[x];
+                        }
+                    }
+                }
             }
+        };
+
+        if (exrImage.tiles) {
+            for (int t = 0; t < exrImage.num_tiles; t++) {
+                EXRTile const& tile = exrImage.tiles[t];
+                if (tile.level_x != 0 || tile.level_y != 0) {
+                    continue; // only the full resolution level of mip/ripmapped files
+                }
+                writeWindow(tile.images,
+                        uint32_t(tile.offset_x) * uint32_t(header.tile_size_x),
+                        uint32_t(tile.offset_y) * uint32_t(header.tile_size_y),
+                        uint32_t(tile.width), uint32_t(tile.height));
+            }
+        } else {
+            writeWindow(exrImage.images, 0, 0, width, height);
         }
 
-        free(rgba);
+        FreeEXRImage(&exrImage);
+        FreeEXRHeader(&header);
 
         return image;
     } catch(std::runtime_error& e) {
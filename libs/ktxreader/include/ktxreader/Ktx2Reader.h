@@ -46,6 +46,7 @@ class Ktx2Reader {
             UNCOMPRESSED_TRANSCODE_FAILURE,
             FORMAT_UNSUPPORTED,
             FORMAT_ALREADY_REQUESTED,
+            BUFFER_TOO_SMALL,
         };
 
         Ktx2Reader(Engine& engine, bool quiet = false);
@@ -93,6 +94,23 @@ class Ktx2Reader {
          */
         Texture* load(const void* data, size_t size, TransferFunction transfer);
 
+        /**
+         * Variant of load() that transcodes into a caller-provided scratch arena.
+         *
+         * Miplevels are carved sequentially out of the arena and handed to the engine without
+         * any intermediate heap allocation; the given callback is invoked once per miplevel as
+         * the engine finishes reading it, after which that region of the arena may be reused
+         * (e.g. for the next texture). Returns null if the arena cannot hold all transcoded
+         * miplevels.
+         *
+         * This is useful when loading many textures: transcoded texels go straight from
+         * reusable caller-owned memory into the engine instead of through a per-level
+         * malloc / free cycle.
+         */
+        Texture* load(const void* data, size_t size, TransferFunction transfer,
+                void* scratch, size_t scratchSize,
+                Texture::PixelBufferDescriptor::Callback callback, void* user = nullptr);
+
         /**
          * Asynchronous Interface
          * ======================
@@ -123,6 +141,11 @@ class Ktx2Reader {
              */
             Texture* getTexture() const noexcept;
 
+            /**
+             * Returns the number of mipmap levels in the KTX2 file.
+             */
+            size_t getLevelCount() const noexcept;
+
             /**
              * Loads all mipmaps from the KTX2 file and transcodes them to the resolved format.
              *
@@ -131,6 +154,36 @@ class Ktx2Reader {
              */
             Result doTranscoding();
 
+            /**
+             * Transcodes a single mipmap level to the resolved format.
+             *
+             * Unlike the all-levels variant, this may be called concurrently from several
+             * threads, each with a different level index; the underlying transcoder is
+             * thread-safe at level granularity. Call uploadImages() once every level has
+             * been transcoded.
+             */
+            Result doTranscoding(uint32_t levelIndex);
+
+            /**
+             * Returns the number of bytes that transcoding the given miplevel produces.
+             *
+             * This allows callers to size a reusable scratch buffer for the caller-provided
+             * variant of doTranscoding().
+             */
+            size_t getTranscodedSize(uint32_t levelIndex) const noexcept;
+
+            /**
+             * Variant of the single-level doTranscoding() that writes into caller-owned memory.
+             *
+             * The buffer must hold at least getTranscodedSize(levelIndex) bytes (otherwise
+             * BUFFER_TOO_SMALL is returned) and must stay valid until the engine invokes the
+             * given callback, which happens after uploadImages() has submitted the level and
+             * the backend has consumed it. The callback may then recycle the memory for
+             * another level or texture, avoiding a per-level heap allocation.
+             */
+            Result doTranscoding(uint32_t levelIndex, void* buffer, size_t size,
+                    Texture::PixelBufferDescriptor::Callback callback, void* user = nullptr);
+
             /**
              * Uploads pending mipmaps to the texture.
              *
@@ -192,9 +245,21 @@ class Ktx2Reader {
         Texture* createTexture(basist::ktx2_transcoder* transcoder, const void* data,
                 size_t size, TransferFunction transfer);
 
+        // Memoizes the format selection performed in createTexture(), which queries device
+        // capabilities for each requested format. The outcome depends only on the transfer
+        // function and the basis source format, so it is cached per (transfer, source format)
+        // pair and invalidated when the requested format list changes.
+        struct FormatCacheEntry {
+            TransferFunction transfer;
+            uint32_t basisSourceFormat;
+            bool found;
+            Texture::InternalFormat resolved;
+        };
+
         Engine& mEngine;
         basist::ktx2_transcoder* const mTranscoder;
         utils::FixedCapacityVector<Texture::InternalFormat> mRequestedFormats;
+        utils::FixedCapacityVector<FormatCacheEntry> mFormatCache;
         bool mQuiet;
 };
 
@@ -113,14 +113,32 @@ static void freeCallback(void* buf, size_t, void* userdata) {
     free(buf);
 }
 
-// This helper is used by both the asynchronous and synchronous API's.
+// Returns the number of bytes that transcoding the given miplevel produces.
+static size_t getTranscodedByteCount(ktx2_transcoder& transcoder, Texture::InternalFormat format,
+        uint32_t levelIndex) {
+    using basisu::texture_format;
+    const FinalFormatInfo formatInfo = getFinalFormatInfo(format);
+    basist::ktx2_image_level_info levelInfo;
+    transcoder.get_image_level_info(levelInfo, levelIndex, 0, 0);
+    if (formatInfo.isCompressed) {
+        const texture_format destFormat = basis_get_basisu_texture_format(formatInfo.basisFormat);
+        const uint32_t qwordsPerBlock = basisu::get_qwords_per_block(destFormat);
+        return sizeof(uint64_t) * qwordsPerBlock * levelInfo.m_total_blocks;
+    }
+    const uint32_t bytesPerPix = basis_get_bytes_per_block_or_pixel(formatInfo.basisFormat);
+    return bytesPerPix * levelInfo.m_orig_width * levelInfo.m_orig_height;
+}
+
+// This helper is used by both the asynchronous and synchronous API's. It transcodes a single
+// miplevel directly into the given destination, which must hold getTranscodedByteCount() bytes,
+// and wraps it in a descriptor that releases the memory through the given callback.
 static Result transcodeImageLevel(ktx2_transcoder& transcoder,
         ktx2_transcoder_state& transcoderState, Texture::InternalFormat format,
-        uint32_t levelIndex, Texture::PixelBufferDescriptor** pbd)  {
-    using basisu::texture_format;
+        uint32_t levelIndex, void* buffer, size_t byteCount,
+        Texture::PixelBufferDescriptor::Callback callback, void* user,
+        Texture::PixelBufferDescriptor** pbd)  {
     assert_invariant(levelIndex < KTX2_MAX_SUPPORTED_LEVEL_COUNT);
     const FinalFormatInfo formatInfo = getFinalFormatInfo(format);
-    const texture_format destFormat = basis_get_basisu_texture_format(formatInfo.basisFormat);
     const uint32_t layerIndex = 0;
     const uint32_t faceIndex = 0;
     const uint32_t decodeFlags = 0;
@@ -133,34 +151,43 @@ static Result transcodeImageLevel(ktx2_transcoder& transcoder,
     transcoder.get_image_level_info(levelInfo, levelIndex, layerIndex, faceIndex);
 
     if (formatInfo.isCompressed) {
-        const uint32_t qwordsPerBlock = basisu::get_qwords_per_block(destFormat);
-        const size_t byteCount = sizeof(uint64_t) * qwordsPerBlock * levelInfo.m_total_blocks;
-        uint64_t* const blocks = (uint64_t*) malloc(byteCount);
-        if (!transcoder.transcode_image_level(levelIndex, layerIndex, faceIndex, blocks,
+        if (!transcoder.transcode_image_level(levelIndex, layerIndex, faceIndex, buffer,
                 levelInfo.m_total_blocks, formatInfo.basisFormat, decodeFlags,
                 outputRowPitch, outputRowCount, channel0,
                 channel1, &transcoderState)) {
             return Result::COMPRESSED_TRANSCODE_FAILURE;
         }
-        *pbd = new Texture::PixelBufferDescriptor(blocks,
-                byteCount, formatInfo.compressedPixelDataType, byteCount, freeCallback);
+        *pbd = new Texture::PixelBufferDescriptor(buffer,
+                byteCount, formatInfo.compressedPixelDataType, byteCount, callback, user);
         return Result::SUCCESS;
     }
 
-    const uint32_t rowCount = levelInfo.m_orig_height;
     const uint32_t bytesPerPix = basis_get_bytes_per_block_or_pixel(formatInfo.basisFormat);
-    const size_t byteCount = bytesPerPix * levelInfo.m_orig_width * rowCount;
-    uint64_t* const rows = (uint64_t*) malloc(byteCount);
-    if (!transcoder.transcode_image_level(levelIndex, layerIndex, faceIndex, rows,
+    if (!transcoder.transcode_image_level(levelIndex, layerIndex, faceIndex, buffer,
             byteCount / bytesPerPix, formatInfo.basisFormat, decodeFlags,
             outputRowPitch, outputRowCount, channel0, channel1, &transcoderState)) {
         return Result::UNCOMPRESSED_TRANSCODE_FAILURE;
     }
-    *pbd = new Texture::PixelBufferDescriptor(rows, byteCount,
-            formatInfo.pixelDataFormat, formatInfo.pixelDataType, freeCallback);
+    *pbd = new Texture::PixelBufferDescriptor(buffer, byteCount,
+            formatInfo.pixelDataFormat, formatInfo.pixelDataType, callback, user);
     return Result::SUCCESS;
 }
 
+// Convenience overload that heap-allocates the destination and frees it once the engine is
+// done reading from it.
+static Result transcodeImageLevel(ktx2_transcoder& transcoder,
+        ktx2_transcoder_state& transcoderState, Texture::InternalFormat format,
+        uint32_t levelIndex, Texture::PixelBufferDescriptor** pbd)  {
+    const size_t byteCount = getTranscodedByteCount(transcoder, format, levelIndex);
+    void* const buffer = malloc(byteCount);
+    const Result result = transcodeImageLevel(transcoder, transcoderState, format, levelIndex,
+            buffer, byteCount, freeCallback, nullptr, pbd);
+    if (UTILS_UNLIKELY(result != Result::SUCCESS)) {
+        free(buffer);
+    }
+    return result;
+}
+
 namespace ktxreader {
 
 class FAsync : public Async {
@@ -169,7 +196,12 @@ public:
             mTexture(texture), mEngine(engine), mTranscoder(transcoder),
             mSourceBuffer(std::move(buf)) {}
     Texture* getTexture() const noexcept { return mTexture; }
+    size_t getLevelCount() const noexcept;
+    size_t getTranscodedSize(uint32_t levelIndex) const noexcept;
     Result doTranscoding();
+    Result doTranscoding(uint32_t levelIndex);
+    Result doTranscoding(uint32_t levelIndex, void* buffer, size_t size,
+            Texture::PixelBufferDescriptor::Callback callback, void* user);
     void uploadImages();
 
 protected:
@@ -201,6 +233,9 @@ Ktx2Reader::Ktx2Reader(Engine& engine, bool quiet) :
     mQuiet(quiet),
     mTranscoder(new ktx2_transcoder()) {
     mRequestedFormats.reserve((size_t) transcoder_texture_format::cTFTotalTextureFormats);
+    // One entry per (transfer function, basis source format) pair: 2 transfer functions
+    // and 2 source formats (ETC1S and UASTC).
+    mFormatCache.reserve(4);
     basisu_transcoder_init();
 }
 
@@ -218,6 +253,7 @@ Result Ktx2Reader::requestFormat(Texture::InternalFormat format) noexcept {
         }
     }
     mRequestedFormats.push_back(format);
+    mFormatCache.clear();
     return Result::SUCCESS;
 }
 
@@ -225,6 +261,7 @@ void Ktx2Reader::unrequestFormat(Texture::InternalFormat format) noexcept {
     for (auto iter = mRequestedFormats.begin(); iter != mRequestedFormats.end(); ++iter) {
         if (*iter == format) {
             mRequestedFormats.erase(iter);
+            mFormatCache.clear();
             return;
         }
     }
@@ -259,6 +296,58 @@ Texture* Ktx2Reader::load(const void* data, size_t size, TransferFunction transf
             return nullptr;
         }
         texture->setImage(mEngine, levelIndex, std::move(*pbd));
+        delete pbd;
+    }
+    return texture;
+}
+
+Texture* Ktx2Reader::load(const void* data, size_t size, TransferFunction transfer,
+        void* scratch, size_t scratchSize,
+        Texture::PixelBufferDescriptor::Callback callback, void* user) {
+    Texture* texture = createTexture(mTranscoder, data, size, transfer);
+    if (texture == nullptr) {
+        return nullptr;
+    }
+
+    if (!mTranscoder->start_transcoding()) {
+        mEngine.destroy(texture);
+        if (!mQuiet) {
+            utils::slog.e << "BasisU start_transcoding failed." << utils::io::endl;
+        }
+        return nullptr;
+    }
+
+    ktx2_transcoder_state basisThreadState;
+    basisThreadState.clear();
+
+    uint8_t* const arena = static_cast<uint8_t*>(scratch);
+    size_t offset = 0;
+    for (uint32_t levelIndex = 0, n = mTranscoder->get_levels(); levelIndex < n; levelIndex++) {
+        const size_t byteCount =
+                getTranscodedByteCount(*mTranscoder, texture->getFormat(), levelIndex);
+        // The transcoder writes 64-bit blocks, so keep each region 8-byte aligned.
+        offset = (offset + 7) & ~size_t(7);
+        if (UTILS_UNLIKELY(offset + byteCount > scratchSize)) {
+            mEngine.destroy(texture);
+            if (!mQuiet) {
+                utils::slog.e << "Scratch arena too small for level " << levelIndex
+                        << utils::io::endl;
+            }
+            return nullptr;
+        }
+        Texture::PixelBufferDescriptor* pbd;
+        Result result = transcodeImageLevel(*mTranscoder, basisThreadState, texture->getFormat(),
+                levelIndex, arena + offset, byteCount, callback, user, &pbd);
+        if (UTILS_UNLIKELY(result != Result::SUCCESS)) {
+            mEngine.destroy(texture);
+            if (!mQuiet) {
+                utils::slog.e << "Failed to transcode level " << levelIndex << utils::io::endl;
+            }
+            return nullptr;
+        }
+        offset += byteCount;
+        texture->setImage(mEngine, levelIndex, std::move(*pbd));
+        delete pbd;
     }
     return texture;
 }
@@ -272,6 +361,14 @@ FAsync::~FAsync() {
     }
 }
 
+size_t FAsync::getLevelCount() const noexcept {
+    return mTranscoder->get_levels();
+}
+
+size_t FAsync::getTranscodedSize(uint32_t levelIndex) const noexcept {
+    return getTranscodedByteCount(*mTranscoder, mTexture->getFormat(), levelIndex);
+}
+
 Result FAsync::doTranscoding() {
     ktx2_transcoder_state basisThreadState;
     basisThreadState.clear();
@@ -287,6 +384,40 @@ Result FAsync::doTranscoding() {
     return Result::SUCCESS;
 }
 
+Result FAsync::doTranscoding(uint32_t levelIndex) {
+    // Each call gets its own transcoder state, which is what makes concurrent per-level
+    // transcoding safe; see the comment on the mTranscoder member.
+    ktx2_transcoder_state basisThreadState;
+    basisThreadState.clear();
+    Texture::PixelBufferDescriptor* pbd;
+    Result result = transcodeImageLevel(*mTranscoder, basisThreadState, mTexture->getFormat(),
+            levelIndex, &pbd);
+    if (UTILS_UNLIKELY(result != Result::SUCCESS)) {
+        return result;
+    }
+    mTranscoderResults[levelIndex].store(pbd);
+    return Result::SUCCESS;
+}
+
+Result FAsync::doTranscoding(uint32_t levelIndex, void* buffer, size_t size,
+        Texture::PixelBufferDescriptor::Callback callback, void* user) {
+    const size_t byteCount = getTranscodedByteCount(*mTranscoder, mTexture->getFormat(),
+            levelIndex);
+    if (UTILS_UNLIKELY(size < byteCount)) {
+        return Result::BUFFER_TOO_SMALL;
+    }
+    ktx2_transcoder_state basisThreadState;
+    basisThreadState.clear();
+    Texture::PixelBufferDescriptor* pbd;
+    Result result = transcodeImageLevel(*mTranscoder, basisThreadState, mTexture->getFormat(),
+            levelIndex, buffer, byteCount, callback, user, &pbd);
+    if (UTILS_UNLIKELY(result != Result::SUCCESS)) {
+        return result;
+    }
+    mTranscoderResults[levelIndex].store(pbd);
+    return Result::SUCCESS;
+}
+
 void FAsync::uploadImages() {
     size_t levelIndex = 0;
     UTILS_NOUNROLL
@@ -368,32 +499,40 @@ Texture* Ktx2Reader::createTexture(ktx2_transcoder* transcoder, const void* data
         return nullptr;
     }
 
-    // First pass through, just to make sure we can transcode it.
+    // First pass through, just to make sure we can transcode it. The outcome depends only on
+    // the transfer function and the source format, so consult the cache before re-querying
+    // device capabilities for every requested format.
     bool found = false;
-    Texture::InternalFormat resolvedFormat;
-    FinalFormatInfo info;
-    for (Texture::InternalFormat requestedFormat : mRequestedFormats) {
-        if (!Texture::isTextureFormatSupported(mEngine, requestedFormat)) {
-            continue;
-        }
-        info = getFinalFormatInfo(requestedFormat);
-        if (!info.isSupported || info.transferFunction != transfer) {
-            continue;
+    Texture::InternalFormat resolvedFormat = {};
+    const uint32_t sourceFormat = (uint32_t) transcoder->get_format();
+    bool cached = false;
+    for (const FormatCacheEntry& entry : mFormatCache) {
+        if (entry.transfer == transfer && entry.basisSourceFormat == sourceFormat) {
+            found = entry.found;
+            resolvedFormat = entry.resolved;
+            cached = true;
+            break;
         }
-        if (!basis_is_format_supported(info.basisFormat, transcoder->get_format())) {
-            continue;
-        }
-        const uint32_t layerIndex = 0;
-        const uint32_t faceIndex = 0;
-        for (uint32_t levelIndex = 0; levelIndex < transcoder->get_levels(); levelIndex++) {
-            basist::ktx2_image_level_info info;
-            if (!transcoder->get_image_level_info(info, levelIndex, layerIndex, faceIndex)) {
+    }
+    if (!cached) {
+        for (Texture::InternalFormat requestedFormat : mRequestedFormats) {
+            if (!Texture::isTextureFormatSupported(mEngine, requestedFormat)) {
                 continue;
             }
+            const FinalFormatInfo info = getFinalFormatInfo(requestedFormat);
+            if (!info.isSupported || info.transferFunction != transfer) {
+                continue;
+            }
+            if (!basis_is_format_supported(info.basisFormat, transcoder->get_format())) {
+                continue;
+            }
+            found = true;
+            resolvedFormat = requestedFormat;
+            break;
+        }
+        if (mFormatCache.size() < mFormatCache.capacity()) {
+            mFormatCache.push_back({ transfer, sourceFormat, found, resolvedFormat });
         }
-        found = true;
-        resolvedFormat = requestedFormat;
-        break;
     }
 
     if (!found) {
@@ -418,7 +557,7 @@ Texture* Ktx2Reader::createTexture(ktx2_transcoder* transcoder, const void* data
     #if BASISU_FORCE_DEVEL_MESSAGES
     utils::slog.e << "Ktx2Reader created "
             << transcoder->get_width() << "x" << transcoder->get_height() << " texture with format "
-            << info.name << utils::io::endl;
+            << getFinalFormatInfo(resolvedFormat).name << utils::io::endl;
     #endif
 
     return texture;
@@ -430,10 +569,27 @@ Texture* Async::getTexture() const noexcept {
     return static_cast<FAsync const*>(this)->getTexture();
 }
 
+size_t Async::getLevelCount() const noexcept {
+    return static_cast<FAsync const*>(this)->getLevelCount();
+}
+
+size_t Async::getTranscodedSize(uint32_t levelIndex) const noexcept {
+    return static_cast<FAsync const*>(this)->getTranscodedSize(levelIndex);
+}
+
 Result Async::doTranscoding() {
     return static_cast<FAsync*>(this)->doTranscoding();
 }
 
+Result Async::doTranscoding(uint32_t levelIndex) {
+    return static_cast<FAsync*>(this)->doTranscoding(levelIndex);
+}
+
+Result Async::doTranscoding(uint32_t levelIndex, void* buffer, size_t size,
+        Texture::PixelBufferDescriptor::Callback callback, void* user) {
+    return static_cast<FAsync*>(this)->doTranscoding(levelIndex, buffer, size, callback, user);
+}
+
 void Async::uploadImages() {
     return static_cast<FAsync*>(this)->uploadImages();
 }
@@ -23,6 +23,7 @@
 #include <gtest/gtest.h>
 #include <utils/Path.h>
 
+#include <atomic>
 #include <fstream>
 #include <vector>
 
@@ -90,6 +91,42 @@ TEST_F(KtxReaderTest, Ktx2) {
     engine->destroy(tex);
 }
 
+static std::atomic<int> gArenaReleaseCount(0);
+static void arenaReleaseCallback(void*, size_t, void*) { ++gArenaReleaseCount; }
+
+TEST_F(KtxReaderTest, Ktx2ScratchArena) {
+    const utils::Path parent = Path::getCurrentExecutable().getParent();
+    const auto contents = readFile(parent + "color_grid_uastc_zstd.ktx2");
+    ASSERT_EQ(contents.size(), 170512);
+
+    ktxreader::Ktx2Reader reader(*engine);
+    reader.requestFormat(Texture::InternalFormat::DXT5_SRGBA);
+    reader.requestFormat(Texture::InternalFormat::SRGB8_A8);
+
+    // Large enough for all miplevels of a 1024x1024 DXT5 texture.
+    vector<uint8_t> arena(2 * 1024 * 1024);
+    gArenaReleaseCount = 0;
+
+    Texture* tex = reader.load(contents.data(), contents.size(),
+            ktxreader::Ktx2Reader::TransferFunction::sRGB,
+            arena.data(), arena.size(), arenaReleaseCallback);
+
+    ASSERT_NE(tex, nullptr);
+    ASSERT_EQ(tex->getWidth(), 1024);
+
+    // Once the engine has consumed every miplevel, each arena region has been released.
+    engine->flushAndWait();
+    ASSERT_EQ(gArenaReleaseCount.load(), int(tex->getLevels()));
+
+    // An arena too small to hold all miplevels makes load() fail.
+    Texture* tex2 = reader.load(contents.data(), contents.size(),
+            ktxreader::Ktx2Reader::TransferFunction::sRGB,
+            arena.data(), 1024, arenaReleaseCallback);
+    ASSERT_EQ(tex2, nullptr);
+
+    engine->destroy(tex);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
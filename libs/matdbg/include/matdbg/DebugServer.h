@@ -39,6 +39,8 @@ struct MaterialRecord {
     utils::CString name;
     MaterialKey key;
     VariantList activeVariants;
+    float gpuMilliseconds = 0.0f;
+    uint32_t timingSampleCount = 0;
 };
 
 // Matches DriverEnums' ShaderModel
@@ -75,6 +77,16 @@ public:
      */
     void removeMaterial(MaterialKey key);
 
+    /**
+     * Reports a GPU timing sample for the given material, in milliseconds.
+     *
+     * Samples are smoothed with an exponential moving average and served through the
+     * /api/timings endpoint, so clients can see the GPU cost per material while live-editing
+     * shaders. This is typically fed from timer queries batched around the render pass command
+     * ranges of each material and may be called from the render thread.
+     */
+    void updateMaterialTiming(MaterialKey key, float gpuMilliseconds);
+
     using EditCallback = void(*)(void* userdata, const utils::CString& name, const void*, size_t);
     using QueryCallback = void(*)(void* userdata, VariantList* variants);
 
@@ -436,6 +436,22 @@ bool ApiHandler::handleGet(CivetServer* server, struct mg_connection* conn) {
         return true;
     }
 
+    if (uri == "/api/timings") {
+        std::unique_lock const lock(mServer->mMaterialRecordsMutex);
+        mg_printf(conn, kSuccessHeader.data(), "application/json");
+        mg_printf(conn, "[");
+        int index = 0;
+        for (auto const& pair: mServer->mMaterialRecords) {
+            auto const& record = pair.second;
+            bool const last = (++index) == mServer->mMaterialRecords.size();
+            mg_printf(conn, "{ \"matid\": \"%8.8x\", \"name\": \"%s\", \"ms\": %.3f, "
+                    "\"samples\": %u } %s", pair.first, record.name.c_str_safe(),
+                    record.gpuMilliseconds, record.timingSampleCount, last ? "" : ",");
+        }
+        mg_printf(conn, "]");
+        return true;
+    }
+
     if (uri == "/api/shader") {
         return handleGetApiShader(conn, request);
     }
@@ -37,6 +37,7 @@ struct MaterialRecord;
 //    GET /api/material?matid={id}
 //    GET /api/shader?matid={id}&type=[glsl|spirv]&[glindex|vkindex|metalindex]={index}
 //    GET /api/active
+//    GET /api/timings
 //    GET /api/status
 //    POST /api/edit
 //
@@ -221,6 +221,21 @@ void DebugServer::removeMaterial(MaterialKey key) {
     mMaterialRecords.erase(key);
 }
 
+void DebugServer::updateMaterialTiming(MaterialKey key, float gpuMilliseconds) {
+    std::unique_lock<utils::Mutex> lock(mMaterialRecordsMutex);
+    if (auto iter = mMaterialRecords.find(key); iter != mMaterialRecords.end()) {
+        MaterialRecord& record = iter.value();
+        if (record.timingSampleCount == 0) {
+            record.gpuMilliseconds = gpuMilliseconds;
+        } else {
+            // Smooth with an exponential moving average so the reported cost is stable even
+            // though individual frames (and timer query results) are noisy.
+            record.gpuMilliseconds += (gpuMilliseconds - record.gpuMilliseconds) * 0.125f;
+        }
+        record.timingSampleCount++;
+    }
+}
+
 const MaterialRecord* DebugServer::getRecord(const MaterialKey& key) const {
     std::unique_lock<utils::Mutex> lock(mMaterialRecordsMutex);
     const auto& iter = mMaterialRecords.find(key);
@@ -463,10 +463,9 @@ void BlobIndex::replaceShader(ShaderModel model, Variant variant,
             // same content before the edit. In practice this is rarely problematic, but we should
             // perhaps fix this one day.
 
-            auto& blob = mDataBlobs[record.dictionaryIndex];
-            blob.reserve(sourceLength);
-            blob.resize(sourceLength);
-            memcpy(blob.data(), source, sourceLength);
+            filaflat::ShaderContent content(sourceLength);
+            memcpy(content.data(), source, sourceLength);
+            mDataBlobs[record.dictionaryIndex] = filaflat::Blob{ std::move(content) };
 
             return;
         }
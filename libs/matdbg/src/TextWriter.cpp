@@ -21,6 +21,7 @@
 #include <backend/DriverEnums.h>
 
 #include <matdbg/TextWriter.h>
+#include <matdbg/ShaderExtractor.h>
 #include <matdbg/ShaderInfo.h>
 
 #include <sstream>
@@ -397,10 +398,30 @@ static void printChunks(ostream& text, const ChunkContainer& container) {
     }
 }
 
+static ShaderLanguage toShaderLanguage(ChunkType chunkType) {
+    switch (chunkType) {
+        case ChunkType::MaterialGlsl:         return ShaderLanguage::ESSL3;
+        case ChunkType::MaterialEssl1:        return ShaderLanguage::ESSL1;
+        case ChunkType::MaterialSpirv:        return ShaderLanguage::SPIRV;
+        case ChunkType::MaterialMetal:        return ShaderLanguage::MSL;
+        case ChunkType::MaterialMetalLibrary: return ShaderLanguage::METAL_LIBRARY;
+        case ChunkType::MaterialWgsl:         return ShaderLanguage::WGSL;
+        default:
+            assert(false && "Invalid shader ChunkType");
+            return ShaderLanguage::ESSL3;
+    }
+}
+
 static void printShaderInfo(ostream& text, const vector<ShaderInfo>& info,
-        const ChunkContainer& container) {
+        const ChunkContainer& container, ChunkType chunkType) {
     MaterialDomain domain = MaterialDomain::SURFACE;
     read(container, ChunkType::MaterialDomain, reinterpret_cast<uint8_t*>(&domain));
+    // decode each shader so the listing shows what each variant actually costs in the
+    // package (dictionary compression makes the raw chunk offsets meaningless)
+    ShaderExtractor extractor(toShaderLanguage(chunkType),
+            container.getData(), container.getSize());
+    bool const canExtract = extractor.parse();
+    ShaderContent content;
     for (uint64_t i = 0; i < info.size(); ++i) {
         const auto& item = info[i];
         text << "    #";
@@ -412,6 +433,12 @@ static void printShaderInfo(ostream& text, const vector<ShaderInfo>& info,
         text << "0x" << hex << setfill('0') << setw(2)
              << right << +item.variant.key;
         text << setfill(' ') << dec;
+        if (canExtract &&
+                extractor.getShader(item.shaderModel, item.variant, item.pipelineStage, content)) {
+            text << " " << setw(8) << right << content.size() << " B";
+        } else {
+            text << " " << setw(8) << right << "?" << "  ";
+        }
         text << "   ";
         text << formatVariantString(item.variant, domain);
         text << endl;
@@ -448,7 +475,7 @@ static bool printShaderInfo(ostream& text, const ChunkContainer& container, Chun
             assert(false && "Invalid shader ChunkType");
             break;
     }
-    printShaderInfo(text, info, container);
+    printShaderInfo(text, info, container, chunkType);
     return true;
 }
 
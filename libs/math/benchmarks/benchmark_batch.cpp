@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PerformanceCounters.h"
+
+#include <benchmark/benchmark.h>
+
+#include <math/batch.h>
+#include <math/mat4.h>
+
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace filament::math;
+
+static constexpr size_t ELEMENT_COUNT = 1024;
+
+struct BatchData {
+    mat4f matrix;
+    float4 plane;
+    std::vector<float3> points = std::vector<float3>(ELEMENT_COUNT);
+    std::vector<float3> extents = std::vector<float3>(ELEMENT_COUNT);
+
+    BatchData() {
+        std::default_random_engine generator(82828); // NOLINT
+        std::uniform_real_distribution<float> distribution(-4.0f, 4.0f);
+        auto rand_gen = std::bind(distribution, generator);
+        for (size_t col = 0; col < 4; ++col) {
+            for (size_t row = 0; row < 3; ++row) {
+                matrix[col][row] = rand_gen();
+            }
+        }
+        plane = float4{ rand_gen(), rand_gen(), rand_gen(), rand_gen() };
+        for (size_t i = 0; i < ELEMENT_COUNT; ++i) {
+            points[i] = float3{ rand_gen(), rand_gen(), rand_gen() };
+            extents[i] = abs(float3{ rand_gen(), rand_gen(), rand_gen() });
+        }
+    }
+};
+
+static void BM_transformPoints_scalar(benchmark::State& state) noexcept {
+    BatchData data;
+    std::vector<float3> out(ELEMENT_COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            for (size_t i = 0; i < ELEMENT_COUNT; i++) {
+                out[i] = (data.matrix * float4{ data.points[i], 1.0f }).xyz;
+            }
+            benchmark::ClobberMemory();
+            benchmark::DoNotOptimize(out);
+        }
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * ELEMENT_COUNT);
+    }
+}
+
+static void BM_transformPoints_batch(benchmark::State& state) noexcept {
+    BatchData data;
+    std::vector<float3> out(ELEMENT_COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            batch::transformPoints(data.matrix, out.data(), data.points.data(), ELEMENT_COUNT);
+            benchmark::ClobberMemory();
+            benchmark::DoNotOptimize(out);
+        }
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * ELEMENT_COUNT);
+    }
+}
+
+static void BM_transformBoxes_scalar(benchmark::State& state) noexcept {
+    BatchData data;
+    std::vector<float3> outCenter(ELEMENT_COUNT);
+    std::vector<float3> outExtent(ELEMENT_COUNT);
+    const mat4f& m = data.matrix;
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            for (size_t i = 0; i < ELEMENT_COUNT; i++) {
+                const float3 e = data.extents[i];
+                outCenter[i] = (m * float4{ data.points[i], 1.0f }).xyz;
+                outExtent[i] = float3{
+                        std::abs(m[0].x) * e.x + std::abs(m[1].x) * e.y + std::abs(m[2].x) * e.z,
+                        std::abs(m[0].y) * e.x + std::abs(m[1].y) * e.y + std::abs(m[2].y) * e.z,
+                        std::abs(m[0].z) * e.x + std::abs(m[1].z) * e.y + std::abs(m[2].z) * e.z };
+            }
+            benchmark::ClobberMemory();
+            benchmark::DoNotOptimize(outCenter);
+            benchmark::DoNotOptimize(outExtent);
+        }
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * ELEMENT_COUNT);
+    }
+}
+
+static void BM_transformBoxes_batch(benchmark::State& state) noexcept {
+    BatchData data;
+    std::vector<float3> outCenter(ELEMENT_COUNT);
+    std::vector<float3> outExtent(ELEMENT_COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            batch::transformBoxes(data.matrix, outCenter.data(), outExtent.data(),
+                    data.points.data(), data.extents.data(), ELEMENT_COUNT);
+            benchmark::ClobberMemory();
+            benchmark::DoNotOptimize(outCenter);
+            benchmark::DoNotOptimize(outExtent);
+        }
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * ELEMENT_COUNT);
+    }
+}
+
+static void BM_planeDistances_scalar(benchmark::State& state) noexcept {
+    BatchData data;
+    std::vector<float> out(ELEMENT_COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            for (size_t i = 0; i < ELEMENT_COUNT; i++) {
+                out[i] = dot(data.plane.xyz, data.points[i]) + data.plane.w;
+            }
+            benchmark::ClobberMemory();
+            benchmark::DoNotOptimize(out);
+        }
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * ELEMENT_COUNT);
+    }
+}
+
+static void BM_planeDistances_batch(benchmark::State& state) noexcept {
+    BatchData data;
+    std::vector<float> out(ELEMENT_COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            batch::planeDistances(data.plane, out.data(), data.points.data(), ELEMENT_COUNT);
+            benchmark::ClobberMemory();
+            benchmark::DoNotOptimize(out);
+        }
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * ELEMENT_COUNT);
+    }
+}
+
+BENCHMARK(BM_transformPoints_scalar);
+BENCHMARK(BM_transformPoints_batch);
+BENCHMARK(BM_transformBoxes_scalar);
+BENCHMARK(BM_transformBoxes_batch);
+BENCHMARK(BM_planeDistances_scalar);
+BENCHMARK(BM_planeDistances_batch);
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_MATH_BATCH_H
+#define TNT_MATH_BATCH_H
+
+#include <math/mat4.h>
+#include <math/vec3.h>
+#include <math/vec4.h>
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#   include <arm_neon.h>
+#   define MATH_BATCH_USE_NEON 1
+#elif defined(__x86_64__) || (defined(_M_X64) && !defined(_M_ARM64EC))
+    // SSE2 is part of the x86-64 baseline.
+#   include <emmintrin.h>
+#   define MATH_BATCH_USE_SSE 1
+#endif
+
+namespace filament::math::batch {
+
+/*
+ * Batch kernels over arrays of points, boxes and plane distances. These are shared by callers
+ * that would otherwise loop over mat4 operator* one element at a time (culling, shadow-caster
+ * bounds, transform updates); keeping them here gives such hot loops a single vectorized
+ * implementation instead of per-module hand-rolled SIMD.
+ *
+ * All kernels are float-only and read/write tightly packed arrays. Destination arrays may
+ * alias their sources element-for-element (i.e. in-place operation is supported), but must
+ * not partially overlap.
+ */
+
+#if defined(MATH_BATCH_USE_SSE)
+
+namespace details {
+// Stores exactly the 12 bytes of a float3, so runs of adjacent elements can be written
+// without trampling the neighbor (which also makes in-place operation safe).
+inline void storeFloat3(float3* p, __m128 v) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(&p->x), v);
+    _mm_store_ss(&p->z, _mm_movehl_ps(v, v));
+}
+} // namespace details
+
+#elif defined(MATH_BATCH_USE_NEON)
+
+namespace details {
+inline void storeFloat3(float3* p, float32x4_t v) {
+    vst1_f32(&p->x, vget_low_f32(v));
+    vst1q_lane_f32(&p->z, v, 2);
+}
+} // namespace details
+
+#endif
+
+/**
+ * Transforms count points: out[i] = (m * float4{ in[i], 1 }).xyz.
+ *
+ * The matrix is assumed to be affine (its last row is ignored).
+ */
+inline void transformPoints(mat4f const& m, float3* out, float3 const* in, size_t count) noexcept {
+    size_t i = 0;
+#if defined(MATH_BATCH_USE_SSE)
+    const __m128 c0 = _mm_loadu_ps(&m[0].x);
+    const __m128 c1 = _mm_loadu_ps(&m[1].x);
+    const __m128 c2 = _mm_loadu_ps(&m[2].x);
+    const __m128 c3 = _mm_loadu_ps(&m[3].x);
+    // Loading a float3 as a 16-byte vector overreads into the next element, so the last
+    // point is always handled by the scalar tail.
+    for (; i + 1 < count; i++) {
+        const __m128 p = _mm_loadu_ps(&in[i].x);
+        __m128 r = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0))));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1))));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2))));
+        details::storeFloat3(out + i, r);
+    }
+#elif defined(MATH_BATCH_USE_NEON)
+    const float32x4_t c0 = vld1q_f32(&m[0].x);
+    const float32x4_t c1 = vld1q_f32(&m[1].x);
+    const float32x4_t c2 = vld1q_f32(&m[2].x);
+    const float32x4_t c3 = vld1q_f32(&m[3].x);
+    for (; i + 1 < count; i++) {
+        const float32x4_t p = vld1q_f32(&in[i].x);
+        float32x4_t r = vfmaq_laneq_f32(c3, c0, p, 0);
+        r = vfmaq_laneq_f32(r, c1, p, 1);
+        r = vfmaq_laneq_f32(r, c2, p, 2);
+        details::storeFloat3(out + i, r);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = (m * float4{ in[i], 1.0f }).xyz;
+    }
+}
+
+/**
+ * Transforms count axis-aligned boxes given as center / half-extent pairs. Centers are
+ * transformed as points and half-extents through the absolute value of the upper-left 3x3,
+ * yielding the axis-aligned bounds of the transformed box.
+ *
+ * The matrix is assumed to be affine (its last row is ignored).
+ */
+inline void transformBoxes(mat4f const& m,
+        float3* outCenter, float3* outExtent,
+        float3 const* center, float3 const* extent, size_t count) noexcept {
+    size_t i = 0;
+#if defined(MATH_BATCH_USE_SSE)
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 c0 = _mm_loadu_ps(&m[0].x);
+    const __m128 c1 = _mm_loadu_ps(&m[1].x);
+    const __m128 c2 = _mm_loadu_ps(&m[2].x);
+    const __m128 c3 = _mm_loadu_ps(&m[3].x);
+    const __m128 a0 = _mm_and_ps(c0, signMask);
+    const __m128 a1 = _mm_and_ps(c1, signMask);
+    const __m128 a2 = _mm_and_ps(c2, signMask);
+    for (; i + 1 < count; i++) {
+        const __m128 c = _mm_loadu_ps(&center[i].x);
+        const __m128 e = _mm_loadu_ps(&extent[i].x);
+        __m128 rc = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0))));
+        rc = _mm_add_ps(rc, _mm_mul_ps(c1, _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1))));
+        rc = _mm_add_ps(rc, _mm_mul_ps(c2, _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2))));
+        __m128 re = _mm_mul_ps(a0, _mm_shuffle_ps(e, e, _MM_SHUFFLE(0, 0, 0, 0)));
+        re = _mm_add_ps(re, _mm_mul_ps(a1, _mm_shuffle_ps(e, e, _MM_SHUFFLE(1, 1, 1, 1))));
+        re = _mm_add_ps(re, _mm_mul_ps(a2, _mm_shuffle_ps(e, e, _MM_SHUFFLE(2, 2, 2, 2))));
+        details::storeFloat3(outCenter + i, rc);
+        details::storeFloat3(outExtent + i, re);
+    }
+#elif defined(MATH_BATCH_USE_NEON)
+    const float32x4_t c0 = vld1q_f32(&m[0].x);
+    const float32x4_t c1 = vld1q_f32(&m[1].x);
+    const float32x4_t c2 = vld1q_f32(&m[2].x);
+    const float32x4_t c3 = vld1q_f32(&m[3].x);
+    const float32x4_t a0 = vabsq_f32(c0);
+    const float32x4_t a1 = vabsq_f32(c1);
+    const float32x4_t a2 = vabsq_f32(c2);
+    for (; i + 1 < count; i++) {
+        const float32x4_t c = vld1q_f32(&center[i].x);
+        const float32x4_t e = vld1q_f32(&extent[i].x);
+        float32x4_t rc = vfmaq_laneq_f32(c3, c0, c, 0);
+        rc = vfmaq_laneq_f32(rc, c1, c, 1);
+        rc = vfmaq_laneq_f32(rc, c2, c, 2);
+        float32x4_t re = vmulq_laneq_f32(a0, e, 0);
+        re = vfmaq_laneq_f32(re, a1, e, 1);
+        re = vfmaq_laneq_f32(re, a2, e, 2);
+        details::storeFloat3(outCenter + i, rc);
+        details::storeFloat3(outExtent + i, re);
+    }
+#endif
+    for (; i < count; i++) {
+        const float3 c = center[i];
+        const float3 e = extent[i];
+        outCenter[i] = (m * float4{ c, 1.0f }).xyz;
+        outExtent[i] = float3{
+                std::abs(m[0].x) * e.x + std::abs(m[1].x) * e.y + std::abs(m[2].x) * e.z,
+                std::abs(m[0].y) * e.x + std::abs(m[1].y) * e.y + std::abs(m[2].y) * e.z,
+                std::abs(m[0].z) * e.x + std::abs(m[1].z) * e.y + std::abs(m[2].z) * e.z };
+    }
+}
+
+/**
+ * Computes count signed plane distances: out[i] = dot(plane.xyz, in[i]) + plane.w.
+ */
+inline void planeDistances(float4 const& plane,
+        float* out, float3 const* in, size_t count) noexcept {
+    size_t i = 0;
+#if defined(MATH_BATCH_USE_SSE)
+    const __m128 nx = _mm_set1_ps(plane.x);
+    const __m128 ny = _mm_set1_ps(plane.y);
+    const __m128 nz = _mm_set1_ps(plane.z);
+    const __m128 w = _mm_set1_ps(plane.w);
+    // Four float3 are exactly three 16-byte vectors, deinterleaved with shuffles.
+    for (; i + 4 <= count; i += 4) {
+        float const* const p = &in[i].x;
+        const __m128 t0 = _mm_loadu_ps(p);      // x0 y0 z0 x1
+        const __m128 t1 = _mm_loadu_ps(p + 4);  // y1 z1 x2 y2
+        const __m128 t2 = _mm_loadu_ps(p + 8);  // z2 x3 y3 z3
+        const __m128 xy = _mm_shuffle_ps(t1, t2, _MM_SHUFFLE(2, 1, 3, 2));  // x2 y2 x3 y3
+        const __m128 yz = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 2, 1));  // y0 z0 y1 z1
+        const __m128 x = _mm_shuffle_ps(t0, xy, _MM_SHUFFLE(2, 0, 3, 0));   // x0 x1 x2 x3
+        const __m128 y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));   // y0 y1 y2 y3
+        const __m128 z = _mm_shuffle_ps(yz, t2, _MM_SHUFFLE(3, 0, 3, 1));   // z0 z1 z2 z3
+        __m128 d = _mm_add_ps(w, _mm_mul_ps(nx, x));
+        d = _mm_add_ps(d, _mm_mul_ps(ny, y));
+        d = _mm_add_ps(d, _mm_mul_ps(nz, z));
+        _mm_storeu_ps(out + i, d);
+    }
+#elif defined(MATH_BATCH_USE_NEON)
+    const float32x4_t nx = vdupq_n_f32(plane.x);
+    const float32x4_t ny = vdupq_n_f32(plane.y);
+    const float32x4_t nz = vdupq_n_f32(plane.z);
+    const float32x4_t w = vdupq_n_f32(plane.w);
+    for (; i + 4 <= count; i += 4) {
+        const float32x4x3_t p = vld3q_f32(&in[i].x);
+        float32x4_t d = vfmaq_f32(w, nx, p.val[0]);
+        d = vfmaq_f32(d, ny, p.val[1]);
+        d = vfmaq_f32(d, nz, p.val[2]);
+        vst1q_f32(out + i, d);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = dot(plane.xyz, in[i]) + plane.w;
+    }
+}
+
+} // namespace filament::math::batch
+
+#endif // TNT_MATH_BATCH_H
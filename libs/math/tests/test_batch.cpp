@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <math/batch.h>
+#include <math/mat4.h>
+
+using namespace filament::math;
+
+class BatchTest : public testing::Test {
+protected:
+    void SetUp() override {
+        std::default_random_engine generator(82828); // NOLINT
+        std::uniform_real_distribution<float> distribution(-4.0f, 4.0f);
+        auto rand_gen = std::bind(distribution, generator);
+
+        for (size_t col = 0; col < 4; ++col) {
+            for (size_t row = 0; row < 3; ++row) {
+                matrix[col][row] = rand_gen();
+            }
+        }
+        points.resize(COUNT);
+        extents.resize(COUNT);
+        for (size_t i = 0; i < COUNT; ++i) {
+            points[i] = float3{ rand_gen(), rand_gen(), rand_gen() };
+            extents[i] = abs(float3{ rand_gen(), rand_gen(), rand_gen() });
+        }
+        plane = float4{ rand_gen(), rand_gen(), rand_gen(), rand_gen() };
+    }
+
+    // An odd count exercises the SIMD kernels' scalar tails.
+    static constexpr size_t COUNT = 67;
+
+    mat4f matrix;
+    std::vector<float3> points;
+    std::vector<float3> extents;
+    float4 plane;
+};
+
+TEST_F(BatchTest, TransformPoints) {
+    std::vector<float3> out(COUNT);
+    batch::transformPoints(matrix, out.data(), points.data(), COUNT);
+    for (size_t i = 0; i < COUNT; ++i) {
+        const float3 expected = (matrix * float4{ points[i], 1.0f }).xyz;
+        EXPECT_NEAR(length(out[i] - expected), 0.0f, 1e-5f) << "point " << i;
+    }
+}
+
+TEST_F(BatchTest, TransformPointsInPlace) {
+    std::vector<float3> out = points;
+    batch::transformPoints(matrix, out.data(), out.data(), COUNT);
+    for (size_t i = 0; i < COUNT; ++i) {
+        const float3 expected = (matrix * float4{ points[i], 1.0f }).xyz;
+        EXPECT_NEAR(length(out[i] - expected), 0.0f, 1e-5f) << "point " << i;
+    }
+}
+
+TEST_F(BatchTest, TransformBoxes) {
+    std::vector<float3> outCenter(COUNT), outExtent(COUNT);
+    batch::transformBoxes(matrix, outCenter.data(), outExtent.data(),
+            points.data(), extents.data(), COUNT);
+    for (size_t i = 0; i < COUNT; ++i) {
+        const float3 c = (matrix * float4{ points[i], 1.0f }).xyz;
+        const float3 e = extents[i];
+        const float3 expected = {
+                std::abs(matrix[0].x) * e.x + std::abs(matrix[1].x) * e.y + std::abs(matrix[2].x) * e.z,
+                std::abs(matrix[0].y) * e.x + std::abs(matrix[1].y) * e.y + std::abs(matrix[2].y) * e.z,
+                std::abs(matrix[0].z) * e.x + std::abs(matrix[1].z) * e.y + std::abs(matrix[2].z) * e.z };
+        EXPECT_NEAR(length(outCenter[i] - c), 0.0f, 1e-5f) << "center " << i;
+        EXPECT_NEAR(length(outExtent[i] - expected), 0.0f, 1e-5f) << "extent " << i;
+    }
+}
+
+TEST_F(BatchTest, PlaneDistances) {
+    std::vector<float> out(COUNT);
+    batch::planeDistances(plane, out.data(), points.data(), COUNT);
+    for (size_t i = 0; i < COUNT; ++i) {
+        const float expected = dot(plane.xyz, points[i]) + plane.w;
+        EXPECT_NEAR(out[i], expected, 1e-5f) << "point " << i;
+    }
+}
+
+TEST_F(BatchTest, EmptyAndSingle) {
+    // Degenerate counts must not touch memory out of range (the single-element case goes
+    // entirely through the scalar tail).
+    batch::transformPoints(matrix, nullptr, nullptr, 0);
+    float3 out;
+    batch::transformPoints(matrix, &out, points.data(), 1);
+    const float3 expected = (matrix * float4{ points[0], 1.0f }).xyz;
+    EXPECT_NEAR(length(out - expected), 0.0f, 1e-5f);
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SCENEGEN_SCENEGENERATOR_H
+#define SCENEGEN_SCENEGENERATOR_H
+
+#include <utils/compiler.h>
+#include <utils/Entity.h>
+
+#include <vector>
+
+#include <stdint.h>
+
+namespace filament {
+
+class Engine;
+class IndexBuffer;
+class Material;
+class MaterialInstance;
+class Scene;
+class VertexBuffer;
+
+namespace scenegen {
+
+/**
+ * Describes a procedurally generated stress-test scene. Generation is fully deterministic:
+ * the same spec always produces an identical scene (the placement PRNG avoids
+ * implementation-defined standard library distributions), so performance numbers are
+ * comparable across machines and commits.
+ */
+struct UTILS_PUBLIC SceneSpec {
+    uint32_t renderableCount = 0;   //!< number of cube renderables
+    uint32_t materialCount = 1;     //!< distinct material instances cycled across renderables
+    uint32_t pointLightCount = 0;   //!< number of point lights
+    uint32_t spotLightCount = 0;    //!< number of spot lights
+    uint32_t skinnedCount = 0;      //!< renderables (from the front) that get a 4-bone skin
+    uint32_t hierarchyDepth = 1;    //!< transform chain length above each renderable
+    uint32_t seed = 0;              //!< seed for the placement PRNG
+    float extent = 50.0f;           //!< half-size of the placement volume, in world units
+};
+
+/**
+ * Procedurally generates deterministic scenes for scaling experiments (culling, command
+ * generation, froxelization). All content is built with RenderableManager::Builder and
+ * LightManager::Builder through the public API, so the generator can back benchmark
+ * harnesses and samples alike.
+ */
+class UTILS_PUBLIC SceneGenerator {
+public:
+    /**
+     * @param engine engine used to create all generated resources
+     * @param baseMaterial material the generated instances are created from; when null,
+     *                     the engine's default material is used and materialCount is ignored
+     */
+    explicit SceneGenerator(Engine& engine, Material* baseMaterial = nullptr);
+
+    /** Destroys all generated content, see destroy(). */
+    ~SceneGenerator();
+
+    SceneGenerator(SceneGenerator const&) = delete;
+    SceneGenerator& operator=(SceneGenerator const&) = delete;
+
+    /**
+     * Generates the content described by \p spec and adds it to \p scene. Call destroy()
+     * before generating again with the same instance.
+     */
+    void generate(Scene& scene, SceneSpec const& spec);
+
+    /** Removes the generated content from the scene and destroys all created resources. */
+    void destroy();
+
+    /** All scene entities created by generate(): renderables first, then lights. */
+    std::vector<utils::Entity> const& getEntities() const noexcept { return mEntities; }
+
+private:
+    Engine& mEngine;
+    Material* mBaseMaterial = nullptr;
+    Scene* mScene = nullptr;
+    VertexBuffer* mVertexBuffer = nullptr;
+    IndexBuffer* mIndexBuffer = nullptr;
+    std::vector<MaterialInstance*> mMaterialInstances;
+    std::vector<utils::Entity> mEntities;       // renderables and lights, added to the scene
+    std::vector<utils::Entity> mHierarchyNodes; // intermediate transform-only entities
+};
+
+} // namespace scenegen
+} // namespace filament
+
+#endif // SCENEGEN_SCENEGENERATOR_H
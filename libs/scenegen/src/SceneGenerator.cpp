@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <scenegen/SceneGenerator.h>
+
+#include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+#include <filament/LightManager.h>
+#include <filament/Material.h>
+#include <filament/MaterialInstance.h>
+#include <filament/RenderableManager.h>
+#include <filament/Scene.h>
+#include <filament/TransformManager.h>
+#include <filament/VertexBuffer.h>
+
+#include <utils/EntityManager.h>
+
+#include <math/mat4.h>
+#include <math/vec3.h>
+#include <math/vec4.h>
+
+#include <cmath>
+
+#include <stdint.h>
+
+using namespace filament::math;
+using namespace utils;
+
+namespace filament::scenegen {
+
+namespace {
+
+constexpr float3 CUBE_POSITIONS[8] = {
+        { -1, -1, -1 }, {  1, -1, -1 }, { -1,  1, -1 }, {  1,  1, -1 },
+        { -1, -1,  1 }, {  1, -1,  1 }, { -1,  1,  1 }, {  1,  1,  1 },
+};
+
+// identity quaternion, packed as normalized SHORT4
+constexpr short4 CUBE_TANGENTS[8] = {
+        { 0, 0, 0, 32767 }, { 0, 0, 0, 32767 }, { 0, 0, 0, 32767 }, { 0, 0, 0, 32767 },
+        { 0, 0, 0, 32767 }, { 0, 0, 0, 32767 }, { 0, 0, 0, 32767 }, { 0, 0, 0, 32767 },
+};
+
+constexpr uint16_t CUBE_INDICES[36] = {
+        0, 2, 1,  1, 2, 3,   // -z
+        4, 5, 6,  5, 7, 6,   // +z
+        0, 4, 2,  2, 4, 6,   // -x
+        1, 3, 5,  3, 7, 5,   // +x
+        0, 1, 4,  1, 5, 4,   // -y
+        2, 6, 3,  3, 6, 7,   // +y
+};
+
+// A small explicit PRNG (xorshift32) rather than std::uniform_real_distribution, whose
+// output is implementation-defined and would make scenes differ across standard libraries.
+class Prng {
+public:
+    explicit Prng(uint32_t const seed) noexcept : mState(seed ? seed : 1u) {}
+
+    float next(float const lo, float const hi) noexcept {
+        uint32_t x = mState;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        mState = x;
+        return lo + (hi - lo) * (float(x >> 8) / float(1u << 24));
+    }
+
+private:
+    uint32_t mState;
+};
+
+} // anonymous
+
+SceneGenerator::SceneGenerator(Engine& engine, Material* baseMaterial)
+        : mEngine(engine), mBaseMaterial(baseMaterial) {
+}
+
+SceneGenerator::~SceneGenerator() {
+    destroy();
+}
+
+void SceneGenerator::generate(Scene& scene, SceneSpec const& spec) {
+    mScene = &scene;
+    auto& em = mEngine.getEntityManager();
+    auto& tcm = mEngine.getTransformManager();
+
+    mVertexBuffer = VertexBuffer::Builder()
+            .vertexCount(8)
+            .bufferCount(2)
+            .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3)
+            .attribute(VertexAttribute::TANGENTS, 1, VertexBuffer::AttributeType::SHORT4)
+            .normalized(VertexAttribute::TANGENTS)
+            .build(mEngine);
+    mVertexBuffer->setBufferAt(mEngine, 0, { CUBE_POSITIONS, sizeof(CUBE_POSITIONS) });
+    mVertexBuffer->setBufferAt(mEngine, 1, { CUBE_TANGENTS, sizeof(CUBE_TANGENTS) });
+
+    mIndexBuffer = IndexBuffer::Builder()
+            .indexCount(36)
+            .bufferType(IndexBuffer::IndexType::USHORT)
+            .build(mEngine);
+    mIndexBuffer->setBuffer(mEngine, { CUBE_INDICES, sizeof(CUBE_INDICES) });
+
+    if (mBaseMaterial) {
+        uint32_t const materialCount = spec.materialCount > 0 ? spec.materialCount : 1;
+        mMaterialInstances.reserve(materialCount);
+        for (uint32_t i = 0; i < materialCount; i++) {
+            mMaterialInstances.push_back(mBaseMaterial->createInstance());
+        }
+    }
+
+    Prng prng(spec.seed);
+    float const extent = spec.extent;
+    uint32_t const hierarchyDepth = spec.hierarchyDepth > 0 ? spec.hierarchyDepth : 1;
+    mat4f const identityBones[4] = {};
+
+    mEntities.reserve(spec.renderableCount + spec.pointLightCount + spec.spotLightCount);
+    for (uint32_t i = 0; i < spec.renderableCount; i++) {
+        float3 const position{
+                prng.next(-extent, extent),
+                prng.next(-extent, extent),
+                prng.next(-extent, extent) };
+
+        // each renderable sits at the bottom of its own transform chain, so deep
+        // hierarchies stress the transform manager's world-transform updates
+        TransformManager::Instance parent{};
+        for (uint32_t level = 0; level + 1 < hierarchyDepth; level++) {
+            Entity const node = em.create();
+            tcm.create(node, parent, mat4f{});
+            parent = tcm.getInstance(node);
+            mHierarchyNodes.push_back(node);
+        }
+
+        Entity const e = em.create();
+        tcm.create(e, parent, mat4f::translation(position));
+
+        RenderableManager::Builder builder(1);
+        builder.boundingBox({{ -1, -1, -1 }, { 1, 1, 1 }})
+                .geometry(0, RenderableManager::PrimitiveType::TRIANGLES,
+                        mVertexBuffer, mIndexBuffer);
+        if (!mMaterialInstances.empty()) {
+            builder.material(0, mMaterialInstances[i % mMaterialInstances.size()]);
+        }
+        if (i < spec.skinnedCount) {
+            builder.skinning(4, identityBones);
+        }
+        builder.build(mEngine, e);
+
+        mScene->addEntity(e);
+        mEntities.push_back(e);
+    }
+
+    for (uint32_t i = 0; i < spec.pointLightCount; i++) {
+        Entity const e = em.create();
+        LightManager::Builder(LightManager::Type::POINT)
+                .position({ prng.next(-extent, extent),
+                            prng.next(-extent, extent),
+                            prng.next(-extent, extent) })
+                .intensity(10000.0f)
+                .falloff(extent * 0.2f)
+                .build(mEngine, e);
+        mScene->addEntity(e);
+        mEntities.push_back(e);
+    }
+
+    for (uint32_t i = 0; i < spec.spotLightCount; i++) {
+        Entity const e = em.create();
+        LightManager::Builder(LightManager::Type::SPOT)
+                .position({ prng.next(-extent, extent),
+                            extent,
+                            prng.next(-extent, extent) })
+                .direction({ 0.0f, -1.0f, 0.0f })
+                .spotLightCone(0.3f, 0.6f)
+                .intensity(50000.0f)
+                .falloff(extent * 0.5f)
+                .build(mEngine, e);
+        mScene->addEntity(e);
+        mEntities.push_back(e);
+    }
+}
+
+void SceneGenerator::destroy() {
+    auto& em = mEngine.getEntityManager();
+    if (mScene) {
+        mScene->removeEntities(mEntities.data(), mEntities.size());
+        mScene = nullptr;
+    }
+    for (Entity const e : mEntities) {
+        mEngine.destroy(e);
+        em.destroy(e);
+    }
+    mEntities.clear();
+    for (Entity const e : mHierarchyNodes) {
+        mEngine.destroy(e);
+        em.destroy(e);
+    }
+    mHierarchyNodes.clear();
+    for (MaterialInstance* const mi : mMaterialInstances) {
+        mEngine.destroy(mi);
+    }
+    mMaterialInstances.clear();
+    if (mVertexBuffer) {
+        mEngine.destroy(mVertexBuffer);
+        mVertexBuffer = nullptr;
+    }
+    if (mIndexBuffer) {
+        mEngine.destroy(mIndexBuffer);
+        mIndexBuffer = nullptr;
+    }
+}
+
+} // namespace filament::scenegen
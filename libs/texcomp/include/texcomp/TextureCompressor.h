@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TEXCOMP_TEXTURECOMPRESSOR_H
+#define TEXCOMP_TEXTURECOMPRESSOR_H
+
+#include <utils/compiler.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+class Engine;
+class Texture;
+} // namespace filament
+
+namespace filament::texcomp {
+
+/**
+ * TextureCompressor block-compresses RGBA8 images at runtime.
+ *
+ * Textures generated dynamically (decals, painted canvases, composited atlases) are usually
+ * kept uncompressed because offline compression pipelines can't see them, costing 4x the
+ * memory and sampling bandwidth of a block-compressed texture. This utility closes that gap:
+ * it compresses to ASTC 4x4 (the mobile baseline) or BC7 (the desktop baseline), both 8 bpp
+ * with quality suitable for color content.
+ *
+ * Both formats are produced by the same basis encoder: pixels are packed into UASTC blocks,
+ * which then transcode losslessly to ASTC and with minimal loss to BC7. Compression runs on
+ * the CPU, spread over worker threads; a 512x512 decal compresses in a few milliseconds at
+ * Quality::FASTEST.
+ *
+ * Usage:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * TextureCompressor compressor(*engine);
+ *
+ * TextureCompressor::Format format;
+ * if (TextureCompressor::selectFormat(*engine, true, &format)) {
+ *     Texture* texture = compressor.compress(format,
+ *             TextureCompressor::Quality::DEFAULT, true, w, h, pixels);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class UTILS_PUBLIC TextureCompressor {
+public:
+    enum class Format : uint8_t {
+        ASTC_4x4,   //!< 8 bpp, supported on mobile feature levels
+        BC7,        //!< 8 bpp, supported on desktop
+    };
+
+    //! Speed / quality tradeoff of the encoder.
+    enum class Quality : uint8_t {
+        FASTEST,    //!< for latency-sensitive updates (e.g. while the user is painting)
+        DEFAULT,    //!< good default for decal-creation time
+        HIGH,       //!< for content compressed once and cached
+    };
+
+    explicit TextureCompressor(Engine& engine) noexcept;
+    ~TextureCompressor() noexcept;
+
+    TextureCompressor(TextureCompressor const&) = delete;
+    TextureCompressor& operator=(TextureCompressor const&) = delete;
+
+    /** Returns true if `format` (in the requested transfer function) can be sampled. */
+    static bool isSupported(Engine& engine, Format format, bool srgb) noexcept;
+
+    /**
+     * Picks the compressed format for the current device: ASTC 4x4 where available
+     * (mobile), otherwise BC7 (desktop). Returns false if the device supports neither,
+     * in which case the texture should stay uncompressed.
+     */
+    static bool selectFormat(Engine& engine, bool srgb, Format* outFormat) noexcept;
+
+    /** Size in bytes of a compressed image; both formats use 128-bit 4x4 blocks. */
+    static size_t getCompressedSize(uint32_t const width, uint32_t const height) noexcept {
+        return ((width + 3u) / 4u) * (size_t((height + 3u) / 4u)) * 16u;
+    }
+
+    /**
+     * Compresses a tightly packed RGBA8 image into a new single-level compressed Texture.
+     *
+     * Dimensions don't need to be multiples of 4; edge blocks replicate the border pixels.
+     * The call blocks until compression completes and the upload has been issued. Returns
+     * nullptr if `format` is not supported by the device.
+     */
+    Texture* compress(Format format, Quality quality, bool srgb,
+            uint32_t width, uint32_t height, void const* rgba);
+
+    /**
+     * Compresses a tightly packed RGBA8 image into caller-provided block storage of
+     * getCompressedSize() bytes, without creating a Texture. Use this to refresh a
+     * 4-pixel-aligned sub-rectangle of an existing compressed atlas via Texture::setImage.
+     */
+    static void compressBlocks(Format format, Quality quality,
+            uint32_t width, uint32_t height, void const* rgba, void* blocks) noexcept;
+
+private:
+    Engine& mEngine;
+};
+
+} // namespace filament::texcomp
+
+#endif // TEXCOMP_TEXTURECOMPRESSOR_H
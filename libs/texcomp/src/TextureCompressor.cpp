@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <texcomp/TextureCompressor.h>
+
+#include <filament/Engine.h>
+#include <filament/Texture.h>
+
+#include <backend/DriverEnums.h>
+#include <backend/PixelBufferDescriptor.h>
+
+#include <utils/debug.h>
+
+#include <basisu_enc.h>
+#include <basisu_uastc_enc.h>
+#include <basisu_transcoder_uastc.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace filament::texcomp {
+
+using namespace backend;
+
+namespace {
+
+TextureFormat toTextureFormat(TextureCompressor::Format const format, bool const srgb) noexcept {
+    switch (format) {
+        case TextureCompressor::Format::ASTC_4x4:
+            return srgb ? TextureFormat::SRGB8_ALPHA8_ASTC_4x4 : TextureFormat::RGBA_ASTC_4x4;
+        case TextureCompressor::Format::BC7:
+            return srgb ? TextureFormat::SRGB_ALPHA_BPTC_UNORM : TextureFormat::RGBA_BPTC_UNORM;
+    }
+    return TextureFormat::RGBA_ASTC_4x4; // unreachable
+}
+
+CompressedPixelDataType toPixelDataType(
+        TextureCompressor::Format const format, bool const srgb) noexcept {
+    switch (format) {
+        case TextureCompressor::Format::ASTC_4x4:
+            return srgb ? CompressedPixelDataType::SRGB8_ALPHA8_ASTC_4x4
+                        : CompressedPixelDataType::RGBA_ASTC_4x4;
+        case TextureCompressor::Format::BC7:
+            return srgb ? CompressedPixelDataType::SRGB_ALPHA_BPTC_UNORM
+                        : CompressedPixelDataType::RGBA_BPTC_UNORM;
+    }
+    return CompressedPixelDataType::RGBA_ASTC_4x4; // unreachable
+}
+
+uint32_t toUASTCLevel(TextureCompressor::Quality const quality) noexcept {
+    switch (quality) {
+        case TextureCompressor::Quality::FASTEST:   return basisu::cPackUASTCLevelFastest;
+        case TextureCompressor::Quality::DEFAULT:   return basisu::cPackUASTCLevelDefault;
+        case TextureCompressor::Quality::HIGH:      return basisu::cPackUASTCLevelSlower;
+    }
+    return basisu::cPackUASTCLevelDefault; // unreachable
+}
+
+// Compresses the block rows [firstRow, lastRow) of the image.
+void compressRows(TextureCompressor::Format const format, uint32_t const level,
+        uint32_t const width, uint32_t const height, uint8_t const* rgba,
+        uint8_t* blocks, uint32_t const firstRow, uint32_t const lastRow) noexcept {
+    uint32_t const blockCountX = (width + 3u) / 4u;
+    for (uint32_t by = firstRow; by < lastRow; by++) {
+        uint8_t* dst = blocks + size_t(by) * blockCountX * 16u;
+        for (uint32_t bx = 0; bx < blockCountX; bx++, dst += 16) {
+            // gather the 4x4 block, replicating border pixels for partial edge blocks
+            uint8_t texels[4 * 4 * 4];
+            for (uint32_t y = 0; y < 4; y++) {
+                uint32_t const sy = std::min(by * 4u + y, height - 1u);
+                for (uint32_t x = 0; x < 4; x++) {
+                    uint32_t const sx = std::min(bx * 4u + x, width - 1u);
+                    memcpy(&texels[(y * 4u + x) * 4u],
+                            &rgba[(size_t(sy) * width + sx) * 4u], 4u);
+                }
+            }
+            basist::uastc_block uastc;
+            basisu::encode_uastc(texels, uastc, level);
+            switch (format) {
+                case TextureCompressor::Format::ASTC_4x4:
+                    // UASTC blocks are a subset of ASTC; this transcode is lossless
+                    basist::transcode_uastc_to_astc(uastc, dst);
+                    break;
+                case TextureCompressor::Format::BC7:
+                    basist::transcode_uastc_to_bc7(uastc, dst);
+                    break;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+TextureCompressor::TextureCompressor(Engine& engine) noexcept
+        : mEngine(engine) {
+    // initializes the encoder's global tables, harmless if another library did it already
+    static std::once_flag sEncoderInit;
+    std::call_once(sEncoderInit, []() { basisu::basisu_encoder_init(); });
+}
+
+TextureCompressor::~TextureCompressor() noexcept = default;
+
+bool TextureCompressor::isSupported(Engine& engine,
+        Format const format, bool const srgb) noexcept {
+    return Texture::isTextureFormatSupported(engine, toTextureFormat(format, srgb));
+}
+
+bool TextureCompressor::selectFormat(Engine& engine,
+        bool const srgb, Format* const outFormat) noexcept {
+    for (Format const format : { Format::ASTC_4x4, Format::BC7 }) {
+        if (isSupported(engine, format, srgb)) {
+            *outFormat = format;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TextureCompressor::compressBlocks(Format const format, Quality const quality,
+        uint32_t const width, uint32_t const height,
+        void const* rgba, void* blocks) noexcept {
+    assert_invariant(width > 0 && height > 0);
+    uint32_t const blockCountY = (height + 3u) / 4u;
+    uint32_t const level = toUASTCLevel(quality);
+    auto const* src = static_cast<uint8_t const*>(rgba);
+    auto* dst = static_cast<uint8_t*>(blocks);
+
+    // spread block rows over worker threads; small images aren't worth the spawn cost
+    uint32_t const threadCount = std::min({
+            std::max(1u, std::thread::hardware_concurrency() / 2u),
+            blockCountY,
+            1u + (width / 4u) * blockCountY / 256u });
+    if (threadCount <= 1) {
+        compressRows(format, level, width, height, src, dst, 0, blockCountY);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    std::atomic<uint32_t> nextRow{ 0 };
+    for (uint32_t t = 0; t < threadCount; t++) {
+        workers.emplace_back([&]() {
+            // dynamic partitioning, block rows can have very different encode cost
+            uint32_t row;
+            while ((row = nextRow.fetch_add(1, std::memory_order_relaxed)) < blockCountY) {
+                compressRows(format, level, width, height, src, dst, row, row + 1);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+Texture* TextureCompressor::compress(Format const format, Quality const quality,
+        bool const srgb, uint32_t const width, uint32_t const height, void const* rgba) {
+    if (!isSupported(mEngine, format, srgb)) {
+        return nullptr;
+    }
+
+    size_t const size = getCompressedSize(width, height);
+    void* const blocks = malloc(size);
+    compressBlocks(format, quality, width, height, rgba, blocks);
+
+    Texture* const texture = Texture::Builder()
+            .width(width)
+            .height(height)
+            .levels(1)
+            .sampler(Texture::Sampler::SAMPLER_2D)
+            .format(toTextureFormat(format, srgb))
+            .build(mEngine);
+
+    texture->setImage(mEngine, 0, PixelBufferDescriptor(blocks, size,
+            toPixelDataType(format, srgb), uint32_t(size),
+            [](void* buffer, size_t, void*) { free(buffer); }));
+
+    return texture;
+}
+
+} // namespace filament::texcomp
@@ -18,6 +18,7 @@
 #define UBERZ_READABLE_ARCHIVE_H
 
 #include <stdint.h>
+#include <string.h>
 
 #include <uberz/ArchiveEnums.h>
 
@@ -30,6 +31,20 @@ namespace filament::uberz {
 // offset fields into pointers.
 void convertOffsetsToPointers(struct ReadableArchive* archive);
 
+// Version 0 archives are a single zstd frame holding the entire serialized archive. Version 1
+// archives store the index (header, specs, flags, names) uncompressed and each material package
+// as an independent zstd frame, so readers can decompress only the packages they instantiate.
+// This returns true for version >= 1 archives, which start with the magic word rather than a
+// zstd frame header.
+inline bool hasUncompressedIndex(const void* archiveData, uint64_t archiveByteCount) {
+    uint32_t magic;
+    if (archiveByteCount < sizeof(magic)) {
+        return false;
+    }
+    memcpy(&magic, archiveData, sizeof(magic));
+    return magic == 'UBER';
+}
+
 UTILS_WARNING_PUSH
 UTILS_WARNING_ENABLE_PADDED
 
@@ -230,6 +230,31 @@ void WritableArchive::addSpecLine(string_view line) {
 }
 
 FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
+    // Maximum zstd compression is slow, but that's okay since uberz is invoked during the build,
+    // not at run time.  However in debug builds it is debilitatingly slow, and we're fine with
+    // larger archives, so we use minimum compression.
+#ifdef NDEBUG
+    const int compressionLevel = ZSTD_maxCLevel();
+#else
+    const int compressionLevel = ZSTD_minCLevel();
+#endif
+
+    // Since version 1, each package is compressed as its own zstd frame and the index is left
+    // uncompressed, so that readers can decompress only the packages they actually instantiate.
+    auto packages = FixedCapacityVector<FixedCapacityVector<uint8_t>>::with_capacity(
+            mMaterials.size());
+    for (const auto& mat : mMaterials) {
+        FixedCapacityVector<uint8_t> compressed(ZSTD_compressBound(mat.package.size()));
+        size_t const zstdResult = ZSTD_compress(compressed.data(), compressed.size(),
+                mat.package.data(), mat.package.size(), compressionLevel);
+        if (ZSTD_isError(zstdResult)) {
+            PANIC_POSTCONDITION("Error during archive compression: %s",
+                    ZSTD_getErrorName(zstdResult));
+        }
+        compressed.resize(zstdResult);
+        packages.push_back(std::move(compressed));
+    }
+
     size_t byteCount = sizeof(ReadableArchive);
     for (const auto& mat : mMaterials) {
         byteCount += sizeof(ArchiveSpec);
@@ -247,28 +272,29 @@ FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
         }
     }
     size_t filamatOffset = byteCount;
-    for (const auto& mat : mMaterials) {
-        byteCount += mat.package.size();
+    for (const auto& package : packages) {
+        byteCount += package.size();
     }
 
     ReadableArchive archive;
     archive.magic = 'UBER';
-    archive.version = 0;
+    archive.version = 1;
     archive.specsCount = mMaterials.size();
     archive.specsOffset = sizeof(ReadableArchive);
 
     auto specs = FixedCapacityVector<ArchiveSpec>::with_capacity(mMaterials.size());
     size_t flagCount = 0;
-    for (const auto& mat : mMaterials) {
+    for (size_t i = 0, n = mMaterials.size(); i < n; ++i) {
+        const auto& mat = mMaterials[i];
         ArchiveSpec spec = {};
         spec.shadingModel = mat.shadingModel;
         spec.blendingMode = mat.blendingMode;
         spec.flagsCount = mat.flags.size();
         spec.flagsOffset = flaglistOffset + flagCount * sizeof(ArchiveFlag);
-        spec.packageByteCount = mat.package.size();
+        spec.packageByteCount = packages[i].size();
         spec.packageOffset = filamatOffset;
         specs.push_back(spec);
-        filamatOffset += mat.package.size();
+        filamatOffset += packages[i].size();
         flagCount += mat.flags.size();
     }
 
@@ -304,31 +330,13 @@ FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
     writeCursor += sizeof(ArchiveFlag) * flags.size();
     memcpy(writeCursor, flagNames.data(), charCount);
     writeCursor += charCount;
-    for (const auto& mat : mMaterials) {
-        memcpy(writeCursor, mat.package.data(), mat.package.size());
-        writeCursor += mat.package.size();
+    for (const auto& package : packages) {
+        memcpy(writeCursor, package.data(), package.size());
+        writeCursor += package.size();
     }
     assert_invariant(writeCursor - outputBuf.data() == outputBuf.size());
 
-    FixedCapacityVector<uint8_t> compressedBuf(ZSTD_compressBound(outputBuf.size()));
-
-    // Maximum zstd compression is slow, but that's okay since uberz is invoked during the build,
-    // not at run time.  However in debug builds it is debilitatingly slow, and we're fine with
-    // larger archives, so we use minimum compression.
-#ifdef NDEBUG
-    const int compressionLevel = ZSTD_maxCLevel();
-#else
-    const int compressionLevel = ZSTD_minCLevel();
-#endif
-
-    size_t zstdResult = ZSTD_compress(compressedBuf.data(), compressedBuf.size(), outputBuf.data(),
-            outputBuf.size(), compressionLevel);
-    if (ZSTD_isError(zstdResult)) {
-        PANIC_POSTCONDITION("Error during archive compression: %s", ZSTD_getErrorName(zstdResult));
-    }
-
-    compressedBuf.resize(zstdResult);
-    return compressedBuf;
+    return outputBuf;
 }
 
 void WritableArchive::setShadingModel(Shading sm) {
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_UTILS_PRIVATE_TRACERECORDER_H
+#define TNT_UTILS_PRIVATE_TRACERECORDER_H
+
+#include <utils/compiler.h>
+
+#include <atomic>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace utils {
+
+/*
+ * TraceRecorder captures FILAMENT_TRACING_* events into a caller-owned ring buffer, for
+ * platforms without a trace daemon (e.g. headless Linux). It is the backend used by the
+ * generic branch of private/utils/Tracing.h; a session is started and stopped through
+ * Engine::startProfiling() / Engine::stopProfiling().
+ *
+ * Recording is wait-free: writers claim a slot with a single fetch_add and the only cost
+ * at a macro site when no session is active is one relaxed atomic load.
+ */
+class UTILS_PUBLIC TraceRecorder {
+public:
+    /*
+     * Binary layout of a recorded event, stable by design so out-of-process tooling can
+     * ingest the buffer directly. All fields are native-endian.
+     *
+     *   byte  0: u64 timestampNs   time from std::chrono::steady_clock, in nanoseconds
+     *   byte  8: u32 threadId      stable hash of the emitting thread's id
+     *   byte 12: u8  type          one of Type below
+     *   byte 13: u8[3]             reserved, zero
+     *   byte 16: i64 value         counter value, frame id or async cookie; 0 otherwise
+     *   byte 24: char[40]          zero-padded zone/counter name, truncated if longer
+     */
+    struct Event {
+        static constexpr size_t NAME_SIZE = 40;
+        uint64_t timestampNs;
+        uint32_t threadId;
+        uint8_t type;
+        uint8_t reserved[3];
+        int64_t value;
+        char name[NAME_SIZE];
+    };
+    static_assert(sizeof(Event) == 64, "Event is part of a documented binary layout");
+
+    enum Type : uint8_t {
+        NONE    = 0,
+        BEGIN   = 1,    // start of a zone on the emitting thread
+        END     = 2,    // end of the most recent zone on the emitting thread
+        COUNTER = 3,    // named value sample
+        FRAME   = 4     // frame marker, value holds the frame id
+    };
+
+    // the global recorder the tracing macros write to
+    static TraceRecorder& get() noexcept;
+
+    // Starts a session capturing into the caller-owned buffer, which must stay valid until
+    // stop() returns and hold at least sizeof(Event) bytes; any partial trailing space is
+    // unused. An ongoing session is stopped first.
+    void start(void* buffer, size_t sizeInBytes) noexcept;
+
+    // Stops the session and returns the total number of events recorded since start().
+    // When that count exceeds the buffer's capacity in events, the buffer wrapped and
+    // holds the most recent events; the oldest one lives at slot (count % capacity).
+    // Returns 0 if no session was active.
+    size_t stop() noexcept;
+
+    static bool isRecording() noexcept {
+        return sRecording.load(std::memory_order_relaxed);
+    }
+
+    void beginZone(const char* name) noexcept { record(BEGIN, name, 0); }
+    void endZone() noexcept { record(END, nullptr, 0); }
+    void counter(const char* name, int64_t const value) noexcept { record(COUNTER, name, value); }
+    void frame(uint64_t const id) noexcept { record(FRAME, "frame", int64_t(id)); }
+
+    // RAII helper for the zone macros
+    struct ScopedZone {
+        explicit ScopedZone(const char* name) noexcept : mActive(isRecording()) {
+            if (UTILS_UNLIKELY(mActive)) {
+                get().beginZone(name);
+            }
+        }
+        ~ScopedZone() noexcept {
+            if (UTILS_UNLIKELY(mActive)) {
+                get().endZone();
+            }
+        }
+        ScopedZone(ScopedZone const&) = delete;
+        ScopedZone& operator=(ScopedZone const&) = delete;
+    private:
+        bool const mActive;
+    };
+
+private:
+    TraceRecorder() noexcept = default;
+
+    void record(Type type, const char* name, int64_t value) noexcept;
+
+    static std::atomic<bool> sRecording;
+
+    Event* mEvents = nullptr;
+    size_t mCapacity = 0;                           // in events
+    std::atomic<uint64_t> mCursor = { 0 };          // total events recorded, doesn't wrap
+    std::atomic<int32_t> mActiveWriters = { 0 };    // writers in record(), drained by stop()
+};
+
+} // namespace utils
+
+#endif // TNT_UTILS_PRIVATE_TRACERECORDER_H
@@ -34,6 +34,47 @@
 #    include <private/utils/android/Tracing.h>
 #elif defined(__APPLE__) && FILAMENT_APPLE_SYSTRACE && FILAMENT_TRACING_ENABLED
 #    include <private/utils/darwin/Tracing.h>
+#elif FILAMENT_TRACING_ENABLED
+
+// On platforms without a trace daemon, the macro sites record into the in-process
+// TraceRecorder; capture is off until a session is started (see Engine::startProfiling()),
+// each site then only costs one relaxed atomic load.
+
+#include <private/utils/TraceRecorder.h>
+
+#define FILAMENT_TRACING_CONCAT_(a, b) a ## b
+#define FILAMENT_TRACING_CONCAT(a, b) FILAMENT_TRACING_CONCAT_(a, b)
+
+#define FILAMENT_TRACING_ENABLE(category)
+#define FILAMENT_TRACING_CONTEXT(category)
+
+#define FILAMENT_TRACING_NAME(category, name) \
+        utils::TraceRecorder::ScopedZone FILAMENT_TRACING_CONCAT(filamentTracingZone, __LINE__)(name)
+
+#define FILAMENT_TRACING_FRAME_ID(category, frameId) \
+        do { if (UTILS_UNLIKELY(utils::TraceRecorder::isRecording())) \
+                utils::TraceRecorder::get().frame(frameId); } while (0)
+
+#define FILAMENT_TRACING_NAME_BEGIN(category, name) \
+        do { if (UTILS_UNLIKELY(utils::TraceRecorder::isRecording())) \
+                utils::TraceRecorder::get().beginZone(name); } while (0)
+
+#define FILAMENT_TRACING_NAME_END(category) \
+        do { if (UTILS_UNLIKELY(utils::TraceRecorder::isRecording())) \
+                utils::TraceRecorder::get().endZone(); } while (0)
+
+#define FILAMENT_TRACING_CALL(category) FILAMENT_TRACING_NAME(category, __FUNCTION__)
+
+#define FILAMENT_TRACING_ASYNC_BEGIN(category, name, cookie) \
+        FILAMENT_TRACING_NAME_BEGIN(category, name)
+
+#define FILAMENT_TRACING_ASYNC_END(category, name, cookie) \
+        FILAMENT_TRACING_NAME_END(category)
+
+#define FILAMENT_TRACING_VALUE(category, name, val) \
+        do { if (UTILS_UNLIKELY(utils::TraceRecorder::isRecording())) \
+                utils::TraceRecorder::get().counter(name, int64_t(val)); } while (0)
+
 #else
 
 #define FILAMENT_TRACING_ENABLE(category)
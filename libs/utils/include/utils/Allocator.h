@@ -141,6 +141,28 @@ private:
     uint32_t mCur = 0;
 };
 
+/* ------------------------------------------------------------------------------------------------
+ * HeapAllocationCounter
+ *
+ * Counts the heap allocations performed through HeapAllocator, which includes the fallback
+ * paths of LinearAllocatorWithFallback and PoolAllocatorWithFallback. This is an audit hook:
+ * code that is expected to be heap-allocation free in steady state (e.g. a renderer frame)
+ * can snapshot the counter around the section and check that it didn't move.
+ * ------------------------------------------------------------------------------------------------
+ */
+class HeapAllocationCounter {
+public:
+    static uint64_t getCount() noexcept {
+        return sCount.load(std::memory_order_relaxed);
+    }
+private:
+    friend class HeapAllocator;
+    static void increment() noexcept {
+        sCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    static std::atomic<uint64_t> sCount;
+};
+
 /* ------------------------------------------------------------------------------------------------
  * HeapAllocator
  *
@@ -157,6 +179,7 @@ public:
 
     // our allocator concept
     void* alloc(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        HeapAllocationCounter::increment();
         return aligned_alloc(size, alignment);
     }
 
@@ -559,6 +582,50 @@ private:
     void* mEnd = nullptr;
 };
 
+// Like HeapArea, but the memory is obtained directly from the kernel with mmap() on Linux
+// (falling back to malloc() elsewhere, or if mmap() fails). This gives control over the backing
+// pages: the area can be madvise()d for transparent hugepages, which reduces TLB pressure for
+// large arenas, and it can be pre-faulted at construction, which -- combined with the kernel's
+// first-touch policy -- places the pages on the NUMA node of the constructing thread (e.g. a
+// pinned JobSystem worker).
+class MappedArea {
+public:
+    struct Options {
+        bool hugePages = false;     // madvise(MADV_HUGEPAGE) the whole area (Linux only)
+        bool preFault = false;      // touch every page now, binding them to this thread's node
+    };
+
+    MappedArea() noexcept = default;
+
+    explicit MappedArea(size_t size) : MappedArea(size, Options{}) { }
+
+    MappedArea(size_t size, Options options);
+
+    ~MappedArea() noexcept;
+
+    MappedArea(const MappedArea& rhs) = delete;
+    MappedArea& operator=(const MappedArea& rhs) = delete;
+    MappedArea(MappedArea&& rhs) noexcept = delete;
+    MappedArea& operator=(MappedArea&& rhs) noexcept = delete;
+
+    void* data() const noexcept { return mBegin; }
+    void* begin() const noexcept { return mBegin; }
+    void* end() const noexcept { return mEnd; }
+    size_t size() const noexcept { return uintptr_t(mEnd) - uintptr_t(mBegin); }
+
+    friend void swap(MappedArea& lhs, MappedArea& rhs) noexcept {
+        using std::swap;
+        swap(lhs.mBegin, rhs.mBegin);
+        swap(lhs.mEnd, rhs.mEnd);
+        swap(lhs.mMappedSize, rhs.mMappedSize);
+    }
+
+private:
+    void* mBegin = nullptr;
+    void* mEnd = nullptr;
+    size_t mMappedSize = 0; // non-zero when the area came from mmap()
+};
+
 class NullArea {
 public:
     void* data() const noexcept { return nullptr; }
@@ -610,6 +677,13 @@ struct HighWatermark {
     void onReset() noexcept;
     void onRewind(void const* addr) noexcept;
     uint32_t getHighWatermark() const noexcept { return mHighWaterMark; }
+    // Returns the high-water mark since the last call and restarts tracking from the current
+    // usage. Intended for sampling arena usage once per frame.
+    uint32_t getAndResetHighWatermark() noexcept {
+        uint32_t const wm = mHighWaterMark;
+        mHighWaterMark = mCurrent;
+        return wm;
+    }
 protected:
     const char* mName = nullptr;
     void* mBase = nullptr;
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_UTILS_ASYNCIO_H
+#define TNT_UTILS_ASYNCIO_H
+
+#include <utils/Invocable.h>
+#include <utils/JobSystem.h>
+#include <utils/Mutex.h>
+#include <utils/compiler.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace utils {
+
+/*
+ * An asynchronous file read service. Reads are submitted from any thread and complete on a
+ * service-owned thread; a blocking read on a worker thread keeps the storage queue depth at 1,
+ * while queueing many reads here lets the kernel and the device reorder and overlap them.
+ *
+ * On Linux and Android the reads are submitted to an io_uring, so a single thread can keep an
+ * arbitrary number of reads in flight; everywhere else (and when io_uring is unavailable at
+ * runtime) a small thread pool of positioned reads is used instead.
+ *
+ * Completions can chain directly into a JobSystem job, so a decode job can be made runnable by
+ * the read that produces its input without waking an intermediate thread.
+ */
+class UTILS_PUBLIC AsyncIO {
+public:
+    // destination range of a scatter read, layout-compatible with POSIX iovec
+    struct Buffer {
+        void* data;
+        size_t size;
+    };
+
+    // receives the total number of bytes read, or -errno
+    using Callback = Invocable<void(ssize_t bytesRead)>;
+
+    // creates the service on first use
+    static AsyncIO& get() noexcept;
+
+    /*
+     * Reads `size` bytes at `offset` from `fd` into `data` and invokes `callback` on an
+     * unspecified service thread when the read completes. The file descriptor and destination
+     * memory must stay valid until then; the file position of `fd` is not used or modified.
+     * Callbacks must be cheap -- hand anything substantial to a job, see below.
+     */
+    void read(int fd, int64_t offset, void* data, size_t size, Callback callback);
+
+    /*
+     * Scatter version: fills each of the `count` buffers in order from a single contiguous
+     * range of the file. The buffer array must also stay valid until completion.
+     */
+    void read(int fd, int64_t offset, Buffer const* buffers, size_t count, Callback callback);
+
+    /*
+     * Chains a job on completion: `job` is run (not signaled) on `js` once the destination
+     * buffers are filled. The job is run even if the read failed -- check the byte count from
+     * the Callback overloads if short reads must be handled.
+     *
+     * Jobs are handed to the JobSystem from a single service thread which adopts `js` on
+     * first use (like the engine's driver thread does), so `js` needs a free adoptable slot
+     * and all jobs chained through this service must target the same JobSystem.
+     */
+    void read(int fd, int64_t offset, Buffer const* buffers, size_t count,
+            JobSystem& js, JobSystem::Job* job);
+
+    AsyncIO(AsyncIO const&) = delete;
+    AsyncIO& operator=(AsyncIO const&) = delete;
+
+    class Backend;      // internal
+    class JobRunner;    // internal
+
+private:
+    AsyncIO();
+    ~AsyncIO();
+
+    JobRunner* getRunner();
+
+    Backend* mBackend = nullptr;
+    JobRunner* mRunner = nullptr;   // created on first job-chained read
+    Mutex mRunnerLock;
+};
+
+} // namespace utils
+
+#endif // TNT_UTILS_ASYNCIO_H
@@ -20,6 +20,8 @@
 #include <utils/Entity.h>
 #include <utils/compiler.h>
 
+#include <atomic>
+
 #include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -80,7 +82,10 @@ public:
     // Thread safe.
     bool isAlive(Entity e) const noexcept {
         assert(getIndex(e) < RAW_INDEX_COUNT);
-        return (!e.isNull()) && (getGeneration(e) == mGens[getIndex(e)]);
+        // entities work as weak references, the relaxed load just means that isAlive() can
+        // return true a little longer than expected in some other threads.
+        return (!e.isNull()) &&
+               (getGeneration(e) == mGens[getIndex(e)].load(std::memory_order_relaxed));
     }
 
     // Registers a listener to be called when an entity is destroyed. Thread safe.
@@ -95,7 +100,7 @@ public:
 
     // current generation of the given index. Use for debugging and testing.
     uint8_t getGenerationForIndex(size_t index) const noexcept {
-        return mGens[index];
+        return mGens[index].load(std::memory_order_relaxed);
     }
 
     // singleton, can't be copied
@@ -129,7 +134,7 @@ private:
     }
 
     // stores the generation of each index.
-    uint8_t * const mGens;
+    std::atomic<uint8_t>* const mGens;
 };
 
 } // namespace utils
@@ -24,6 +24,7 @@
 #include <utils/Condition.h>
 #include <utils/memalign.h>
 #include <utils/Mutex.h>
+#include <utils/Profiler.h>
 #include <utils/Slice.h>
 #include <utils/ostream.h>
 #include <utils/WorkStealingDequeue.h>
@@ -47,6 +48,8 @@ class JobSystem {
     static constexpr size_t MAX_JOB_COUNT = 1 << 14; // 16384
     static constexpr uint32_t JOB_COUNT_MASK = MAX_JOB_COUNT - 1;
     static constexpr uint32_t WAITER_COUNT_SHIFT = 24;
+    // bits [14, 24) of runningJobCount are not used by the job count or the waiter count
+    static constexpr uint32_t CONTINUATION_FLAG = 1u << 16;
     static_assert(MAX_JOB_COUNT <= 0x7FFE, "MAX_JOB_COUNT must be <= 0x7FFE");
     using WorkQueue = WorkStealingDequeue<uint16_t, MAX_JOB_COUNT>;
     using Mutex = utils::Mutex;
@@ -343,6 +346,26 @@ public:
         runAndWait(p);
     }
 
+    /*
+     * Schedules continuation to run once job and all of its children have finished. The
+     * continuation is added to the queue of the thread that finishes job, which allows
+     * multi-stage pipelines to be expressed as chained jobs without blocking a worker in
+     * waitAndRelease().
+     *
+     * This must be called before job is run. A job can have a single continuation; longer
+     * chains are built by calling runOnCompletion() on the continuation itself. Use retain()
+     * on the last job of a chain to wait for the whole pipeline. If job is cancelled, its
+     * continuation still runs.
+     *
+     * Like run(), the continuation's reference drops automatically and it can't be used
+     * after this call.
+     */
+    void runOnCompletion(Job* job, Job*& continuation) noexcept;
+    void runOnCompletion(Job* job, Job*&& continuation) noexcept {
+        Job* p = continuation;
+        runOnCompletion(job, p);
+    }
+
     // for debugging
     friend io::ostream& operator << (io::ostream& out, JobSystem const& js);
 
@@ -362,6 +385,59 @@ public:
     static void setThreadPriority(Priority priority) noexcept;
     static void setThreadAffinityById(size_t id) noexcept;
 
+    // Per-worker telemetry counters. Workers [0, getThreadCount()) are pool threads, the
+    // remaining slots are adoptable threads.
+    struct WorkerMetrics {
+        uint64_t jobsExecuted;  // number of jobs this worker has run
+        uint64_t jobsStolen;    // subset of jobsExecuted that was obtained by stealing
+        uint64_t parkCount;     // number of times this worker went to sleep for lack of work
+        // PMU counters accumulated across job executions while worker profiling is enabled
+        // (see enableWorkerProfiling()); all zero otherwise, or when the PMU is unavailable
+        uint64_t cacheReferences;
+        uint64_t cacheMisses;
+        uint64_t branches;
+        uint64_t branchMisses;
+    };
+
+    size_t getWorkerCount() const noexcept { return mThreadStates.size(); }
+
+    // Returns a snapshot of the given worker's counters. Counters are maintained with relaxed
+    // atomics, so values read while jobs are in flight are approximate.
+    WorkerMetrics getWorkerMetrics(size_t worker) const noexcept;
+
+    /*
+     * Limits how many pool threads actively pick up jobs; the others park until the count is
+     * raised again. Jobs left in a parked worker's queue remain stealable. Together with
+     * getWorkerMetrics() and setThreadAffinity() this can be used as a governor on
+     * heterogeneous CPUs, where running on all cores can be slower than running on a few
+     * fast ones. count is clamped to [1, getThreadCount()]; adopted threads are not affected.
+     */
+    void setActiveThreadCount(size_t count) noexcept;
+
+    size_t getActiveThreadCount() const noexcept {
+        return mActiveThreadCount.load(std::memory_order_relaxed);
+    }
+
+    // Pins the given pool thread to a CPU, using the same id space as setThreadAffinityById().
+    // Only supported on Linux, no-op elsewhere.
+    void setThreadAffinity(size_t worker, size_t cpuId) noexcept;
+
+    /*
+     * Enables PMU counters on every worker: each worker opens its own Profiler event group
+     * (see utils::Profiler, eventMask uses its EV_* flags) the next time it picks up a job,
+     * and the counter deltas measured around each job execution are accumulated into that
+     * worker's WorkerMetrics. To attribute counters to a specific parallel stage, bracket
+     * it with enable/disable and diff getWorkerMetrics() snapshots.
+     *
+     * Profiling costs two counter reads per job, only use it when measuring. Counters stay
+     * at zero on platforms without perf_event support or when access to it is restricted.
+     */
+    void enableWorkerProfiling(uint32_t profilerEventMask) noexcept;
+
+    // Disables worker PMU profiling. If an in-process profiling session is active (see
+    // TraceRecorder), the per-worker totals are also emitted to it as counter events.
+    void disableWorkerProfiling() noexcept;
+
     size_t getParallelSplitCount() const noexcept {
         return mParallelSplitCount;
     }
@@ -404,6 +480,20 @@ private:
         // make sure storage is cache-line aligned
         WorkQueue workQueue;
 
+        // telemetry counters, written only by the owning worker thread
+        alignas(CACHELINE_SIZE)
+        std::atomic<uint64_t> jobsExecuted = { 0 };
+        std::atomic<uint64_t> jobsStolen = { 0 };
+        std::atomic<uint64_t> parkCount = { 0 };
+        std::atomic<uint64_t> cacheReferences = { 0 };
+        std::atomic<uint64_t> cacheMisses = { 0 };
+        std::atomic<uint64_t> branches = { 0 };
+        std::atomic<uint64_t> branchMisses = { 0 };
+
+        // per-worker PMU counters, opened and read only on the owning thread
+        Profiler profiler;
+        uint32_t profilerGeneration = 0;
+
         // these are not accessed by the worker threads
         alignas(CACHELINE_SIZE)         // this causes 56-bytes padding
         JobSystem* js;                  // this is in fact const and always initialized
@@ -462,6 +552,7 @@ private:
     aligned_vector<ThreadState> mThreadStates;          // actual data is stored offline
     std::atomic<bool> mExitRequested = { false };       // this one is almost never written
     std::atomic<uint16_t> mAdoptedThreads = { 0 };      // this one is almost never written
+    std::atomic<uint16_t> mActiveThreadCount = { 0 };   // this one is almost never written
     Job* const mJobStorageBase;                         // Base for conversion to indices
     uint16_t mThreadCount = 0;                          // total # of threads in the pool
     uint8_t mParallelSplitCount = 0;                    // # of split allowable in parallel_for
@@ -469,6 +560,14 @@ private:
 
     Mutex mThreadMapLock; // this should have very little contention
     tsl::robin_map<std::thread::id, ThreadState *> mThreadMap;
+
+    Mutex mContinuationLock; // only touched by jobs that use runOnCompletion()
+    tsl::robin_map<Job const*, Job*> mContinuations;
+
+    // bumped by enable/disableWorkerProfiling(); workers re-open their Profiler when they
+    // notice a new generation
+    std::atomic<uint32_t> mProfilerGeneration = { 0 };
+    std::atomic<uint32_t> mProfilerEventMask = { 0 };
 };
 
 // -------------------------------------------------------------------------------------------------
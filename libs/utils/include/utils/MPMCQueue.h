@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_UTILS_MPMCQUEUE_H
+#define TNT_UTILS_MPMCQUEUE_H
+
+#include <utils/architecture.h>
+#include <utils/compiler.h>
+#include <utils/Condition.h>
+#include <utils/Mutex.h>
+
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace utils {
+
+/*
+ * A templated, fixed-size, lock-free bounded MPMC queue.
+ *
+ * tryPush() and tryPop() are lock-free and can be called concurrently from any number of
+ * threads. push() and pop() add a wait/notify fallback on top: they block when the queue is
+ * full (resp. empty), without adding anything more than one relaxed atomic load to the
+ * uncontended fast path.
+ *
+ * Unlike WorkStealingDequeue, items pushed by any thread can be popped by any other thread,
+ * and unlike FixedCircularBuffer, all operations are thread-safe.
+ *
+ * References:
+ * - This is the classic bounded MPMC queue with per-cell sequence numbers:
+ *   https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+template<typename TYPE, size_t COUNT>
+class MPMCQueue {
+    static_assert(COUNT >= 2 && !(COUNT & (COUNT - 1)), "COUNT must be a power of two");
+    static_assert(std::is_nothrow_copy_assignable_v<TYPE> ||
+            std::is_nothrow_move_assignable_v<TYPE>);
+    static constexpr size_t MASK = COUNT - 1;
+
+    struct Cell {
+        // each cell's sequence number tells producers/consumers whose turn it is:
+        //  seq == pos          : free, a producer at position pos may claim it
+        //  seq == pos + 1      : occupied, a consumer at position pos may claim it
+        std::atomic<size_t> sequence;
+        TYPE data;
+    };
+
+public:
+    using value_type = TYPE;
+
+    MPMCQueue() noexcept {
+        for (size_t i = 0; i < COUNT; i++) {
+            mCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCQueue(MPMCQueue const&) = delete;
+    MPMCQueue& operator=(MPMCQueue const&) = delete;
+
+    static constexpr size_t capacity() noexcept { return COUNT; }
+
+    // approximate, for debugging only
+    size_t size() const noexcept {
+        size_t const head = mPushCursor.load(std::memory_order_relaxed);
+        size_t const tail = mPopCursor.load(std::memory_order_relaxed);
+        return head - tail;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    // Attempts to push an item. Returns false if the queue is full. Lock-free.
+    bool tryPush(TYPE item) noexcept {
+        Cell* cell;
+        size_t pos = mPushCursor.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &mCells[pos & MASK];
+            size_t const seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t const diff = intptr_t(seq) - intptr_t(pos);
+            if (diff == 0) {
+                // it's our turn, try to claim this cell.
+                // seq_cst so that a consumer blocked in pop() can't miss this advance in
+                // looksEmpty() after the seq_cst exchange in notify() misses its waiter count.
+                if (mPushCursor.compare_exchange_weak(pos, pos + 1,
+                        std::memory_order_seq_cst)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the cell still holds an item from the previous lap, the queue is full
+                return false;
+            } else {
+                // another producer claimed this cell under our feet, try the next position
+                pos = mPushCursor.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(item);
+        // release the item to the consumer at this position
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        notify(mPopWaiters);
+        return true;
+    }
+
+    // Attempts to pop an item into out. Returns false if the queue is empty. Lock-free.
+    bool tryPop(TYPE& out) noexcept {
+        Cell* cell;
+        size_t pos = mPopCursor.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &mCells[pos & MASK];
+            size_t const seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t const diff = intptr_t(seq) - intptr_t(pos + 1);
+            if (diff == 0) {
+                // the cell holds an item for this position, try to claim it.
+                // seq_cst for the same reason as in tryPush(), with looksFull().
+                if (mPopCursor.compare_exchange_weak(pos, pos + 1,
+                        std::memory_order_seq_cst)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // no item has been produced at this position yet, the queue is empty
+                return false;
+            } else {
+                // another consumer claimed this cell under our feet, try the next position
+                pos = mPopCursor.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->data);
+        // hand the cell back to the producer one lap ahead
+        cell->sequence.store(pos + COUNT, std::memory_order_release);
+        notify(mPushWaiters);
+        return true;
+    }
+
+    // Pushes an item, blocking while the queue is full.
+    void push(TYPE item) noexcept {
+        while (UTILS_UNLIKELY(!tryPush(item))) {
+            // the queue looked full; register as a waiter and sleep until a consumer
+            // frees a cell, then retry. tryPush() is never called with the lock held,
+            // because it takes the lock itself in notify().
+            std::unique_lock lock(mWaiterLock);
+            // seq_cst pairs with the seq_cst load in notify(): either the consumer sees our
+            // waiter count, or we see the cell it just freed in looksFull() below.
+            mPushWaiters.fetch_add(1, std::memory_order_seq_cst);
+            while (looksFull()) {
+                mWaiterCondition.wait(lock);
+            }
+            mPushWaiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Pops an item, blocking while the queue is empty.
+    TYPE pop() noexcept {
+        TYPE item{};
+        while (UTILS_UNLIKELY(!tryPop(item))) {
+            // see push() above
+            std::unique_lock lock(mWaiterLock);
+            mPopWaiters.fetch_add(1, std::memory_order_seq_cst);
+            while (looksEmpty()) {
+                mWaiterCondition.wait(lock);
+            }
+            mPopWaiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+private:
+    // conservative conditions used only while blocked in push()/pop(); a stale answer just
+    // causes one more trip around the retry loop
+    bool looksFull() const noexcept {
+        return mPushCursor.load(std::memory_order_seq_cst) -
+               mPopCursor.load(std::memory_order_seq_cst) >= COUNT;
+    }
+
+    bool looksEmpty() const noexcept {
+        return intptr_t(mPushCursor.load(std::memory_order_seq_cst)) -
+               intptr_t(mPopCursor.load(std::memory_order_seq_cst)) <= 0;
+    }
+
+    void notify(std::atomic<uint32_t> const& waiters) noexcept {
+        if (UTILS_UNLIKELY(waiters.load(std::memory_order_seq_cst))) {
+            // this empty critical section guarantees that notify_all() happens either before
+            // the waiter's condition is checked, or after the condition variable sleeps
+            mWaiterLock.lock();
+            mWaiterLock.unlock();
+            mWaiterCondition.notify_all();
+        }
+    }
+
+    alignas(CACHELINE_SIZE) std::atomic<size_t> mPushCursor = { 0 };
+    alignas(CACHELINE_SIZE) std::atomic<size_t> mPopCursor = { 0 };
+
+    alignas(CACHELINE_SIZE) Cell mCells[COUNT];
+
+    // these are only touched when a blocking push()/pop() would block
+    std::atomic<uint32_t> mPushWaiters = { 0 };
+    std::atomic<uint32_t> mPopWaiters = { 0 };
+    Mutex mWaiterLock;
+    Condition mWaiterCondition;
+};
+
+} // namespace utils
+
+#endif // TNT_UTILS_MPMCQUEUE_H
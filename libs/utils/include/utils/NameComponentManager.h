@@ -18,10 +18,15 @@
 #define TNT_UTILS_NAMECOMPONENTMANAGER_H
 
 #include <utils/compiler.h>
-#include <utils/CString.h>
 #include <utils/Entity.h>
 #include <utils/EntityInstance.h>
 #include <utils/SingleInstanceComponentManager.h>
+#include <utils/StringInterner.h>
+
+#include <tsl/robin_map.h>
+
+#include <string_view>
+#include <vector>
 
 #include <stddef.h>
 
@@ -47,7 +52,7 @@ class EntityManager;
  * printf("%s\n", names->getName(names->getInstance(myEntity));
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  */
-class UTILS_PUBLIC NameComponentManager : private SingleInstanceComponentManager<CString> {
+class UTILS_PUBLIC NameComponentManager : private SingleInstanceComponentManager<InternedString> {
 public:
     using Instance = EntityInstance<NameComponentManager>;
 
@@ -86,6 +91,9 @@ public:
 
     /**
      * Stores a copy of the given string and associates it with the given instance.
+     *
+     * Names are interned in the global StringInterner: entities sharing a name share one
+     * copy of the characters, which live for the lifetime of the process.
      */
     void setName(Instance instance, const char* name) noexcept;
 
@@ -96,11 +104,39 @@ public:
      */
     const char* getName(Instance instance) const noexcept;
 
+    /**
+     * Returns the first entity associated with the given name, or a null entity if none exists.
+     *
+     * Lookups are backed by a reverse index maintained by setName() and removeComponent(),
+     * so their cost doesn't grow with the number of components.
+     */
+    Entity getFirstEntityByName(const char* name) const noexcept;
+
+    /**
+     * Gets a list of entities associated with the given name.
+     *
+     * @param name the name to look up
+     * @param entities pointer to an array that receives the entities, or nullptr to only
+     *                 count them
+     * @param maxCount capacity of the entities array
+     * @return the number of entities written to the array, or, if entities is nullptr, the
+     *         number of entities associated with the name
+     */
+    size_t getEntitiesByName(const char* name, Entity* entities, size_t maxCount) const noexcept;
+
     void gc(EntityManager& em) noexcept {
-        SingleInstanceComponentManager<CString>::gc(em, [this](Entity e) {
+        SingleInstanceComponentManager<InternedString>::gc(em, [this](Entity e) {
             removeComponent(e);
         });
     }
+
+private:
+    void eraseFromIndex(InternedString name, Entity e) noexcept;
+
+    // Reverse index from name to the entities carrying it. The keys view characters owned by
+    // the global StringInterner, which never frees them, so they stay valid even after every
+    // component using a name is removed.
+    tsl::robin_map<std::string_view, std::vector<Entity>> mNameToEntities;
 };
 
 } // namespace utils
@@ -74,9 +74,12 @@ public:
     Profiler& operator=(const Profiler& rhs) = delete;
     Profiler& operator=(Profiler&& rhs) = delete;
 
-    // selects which events are enabled. 
+    // selects which events are enabled.
     uint32_t resetEvents(uint32_t eventMask) noexcept;
 
+    // closes all counters; isValid() returns false until resetEvents() is called again
+    void closeEvents() noexcept;
+
     uint32_t getEnabledEvents() const noexcept { return mEnabledEvents; }
 
     // could return false if performance counters are not supported/enabled
@@ -116,6 +116,17 @@ public:
         return elementAt<ENTITY_INDEX>(i);
     }
 
+    // Pre-allocates storage for at least n components, so a batch of addComponent() calls
+    // doesn't repeatedly reallocate and move the arrays.
+    // This invalidates all pointers components.
+    void reserve(size_t n) {
+        // index 0 is reserved for the dummy component
+        if (n + 1 > mData.capacity()) {
+            mData.setCapacity(n + 1);
+        }
+        mInstanceMap.reserve(n);
+    }
+
     // Add a component to the given Entity. If the entity already has a component from this
     // manager, this function is a no-op.
     // This invalidates all pointers components.
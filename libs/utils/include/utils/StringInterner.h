@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_UTILS_STRINGINTERNER_H
+#define TNT_UTILS_STRINGINTERNER_H
+
+#include <utils/compiler.h>
+#include <utils/Mutex.h>
+
+#include <tsl/robin_set.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <stddef.h>
+
+namespace utils {
+
+class StringInterner;
+
+/**
+ * @brief A handle to a string stored in a StringInterner.
+ *
+ * Like StaticString, this is just a pointer and a size; it doesn't own the characters it
+ * points to, which live for the lifetime of the interner that produced it. Because the
+ * interner stores each distinct string exactly once, two InternedStrings obtained from the
+ * same interner compare equal if and only if their pointers are equal -- comparisons don't
+ * look at the characters at all.
+ */
+class UTILS_PUBLIC InternedString {
+public:
+    using value_type = std::string_view::value_type;
+    using const_pointer = std::string_view::const_pointer;
+    using size_type = std::string_view::size_type;
+    using const_iterator = std::string_view::const_iterator;
+
+    constexpr InternedString() noexcept = default;
+
+    // the characters are always null-terminated, c_str() is safe to pass to C APIs
+    constexpr const_pointer c_str() const noexcept { return mString.data(); }
+    constexpr const_pointer data() const noexcept { return mString.data(); }
+    constexpr size_type size() const noexcept { return mString.size(); }
+    constexpr size_type length() const noexcept { return mString.size(); }
+    constexpr bool empty() const noexcept { return mString.empty(); }
+
+    constexpr const_iterator begin() const noexcept { return mString.begin(); }
+    constexpr const_iterator end() const noexcept { return mString.end(); }
+
+    constexpr operator std::string_view() const noexcept { return mString; } // NOLINT(*-explicit-constructor)
+
+    struct Hasher {
+        size_t operator()(InternedString const& s) const noexcept {
+            return std::hash<const char*>{}(s.data());
+        }
+    };
+
+private:
+    friend class StringInterner;
+    constexpr explicit InternedString(std::string_view const s) noexcept : mString(s) {}
+
+    std::string_view mString;
+
+    // pointer equality is enough, the interner guarantees uniqueness. This only holds for
+    // handles obtained from the same interner; don't mix tables.
+    friend constexpr bool operator==(InternedString const& lhs, InternedString const& rhs) noexcept {
+        return lhs.mString.data() == rhs.mString.data();
+    }
+    friend constexpr bool operator!=(InternedString const& lhs, InternedString const& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * @brief A thread-safe, append-only string table that stores each distinct string once.
+ *
+ * intern() returns a stable, null-terminated InternedString handle; calling it again with
+ * equal characters returns the same handle, so repeated names (e.g. object labels that share
+ * a few common prefixes or are outright duplicated) cost one allocation total instead of one
+ * per use, and comparisons become pointer equality.
+ *
+ * Interned strings are never freed; use this for strings with process lifetime, such as
+ * entity names or debug labels, not for transient data.
+ */
+class UTILS_PUBLIC StringInterner {
+public:
+    StringInterner() noexcept;
+    ~StringInterner() noexcept;
+
+    StringInterner(StringInterner const&) = delete;
+    StringInterner& operator=(StringInterner const&) = delete;
+
+    // the global table, created on first use and never destroyed
+    static StringInterner& get() noexcept;
+
+    // Returns the unique handle for the given characters, copying them into the table if
+    // they're not already present. The copy is null-terminated. A nullptr str yields an
+    // empty handle.
+    InternedString intern(const char* str, size_t length) noexcept;
+
+    InternedString intern(const char* str) noexcept;
+
+    InternedString intern(std::string_view const str) noexcept {
+        return intern(str.data(), str.size());
+    }
+
+    // number of distinct strings in the table
+    size_t size() const noexcept;
+
+private:
+    char* allocate(size_t size) noexcept;
+
+    mutable Mutex mLock;
+    tsl::robin_set<std::string_view> mStrings;
+    std::vector<std::unique_ptr<char[]>> mBlocks;
+    char* mCurrent = nullptr;
+    size_t mRemaining = 0;
+};
+
+} // namespace utils
+
+#endif // TNT_UTILS_STRINGINTERNER_H
@@ -19,7 +19,9 @@
 
 #include <type_traits>
 #include <utils/Allocator.h>
+#include <utils/architecture.h>
 #include <utils/compiler.h>
+#include <utils/JobSystem.h>
 #include <utils/Slice.h>
 
 #include <algorithm>
@@ -275,7 +277,8 @@ public:
         // capacity cannot change when optional storage is specified
         if (capacity >= mSize) {
             // TODO: not entirely sure if "max" of all alignments is always correct
-            constexpr size_t align = std::max({ std::max(alignof(std::max_align_t), alignof(Elements))... });
+            constexpr size_t align = std::max({ CACHELINE_SIZE,
+                    std::max(alignof(std::max_align_t), alignof(Elements))... });
             const size_t sizeNeeded = getNeededSize(capacity);
             void* buffer = mAllocator.alloc(sizeNeeded, align);
             auto const oldBuffer = std::get<0>(mArrays);
@@ -413,6 +416,27 @@ public:
         });
     }
 
+    /*
+     * Calls f(i) for each index in [0, size()), with the range split across the given
+     * JobSystem (the calling thread participates and the call returns once the whole range
+     * has been processed). Columns... lists the arrays the functor accesses; each one is
+     * software-prefetched a couple of cache lines ahead of the loop, which helps hot loops
+     * that hop between several columns per element.
+     *
+     * f is copied into each split, so it must be small (see jobs::parallel_for) and safe to
+     * call concurrently on distinct indices; it must not add or remove elements. Splitter
+     * controls the split granularity, by default ranges of less than 64 elements are not
+     * split further.
+     */
+    template<size_t ... Columns, typename F, typename Splitter = jobs::CountSplitter<64>>
+    void forEachParallel(JobSystem& js, F f, Splitter splitter = Splitter()) noexcept {
+        auto* job = jobs::parallel_for(js, nullptr, 0, uint32_t(mSize),
+                [this, f = std::move(f)](uint32_t const start, uint32_t const count) {
+                    forEachInRange<Columns...>(f, start, start + count);
+                }, splitter);
+        js.runAndWait(job);
+    }
+
     // return a pointer to the first element of the ElementIndex]th array
     template<size_t ElementIndex>
     TypeAt<ElementIndex>* data() noexcept {
@@ -534,6 +558,18 @@ public:
     };
 
 private:
+    // scalar loop over [begin, end) used by each forEachParallel() split
+    template<size_t ... Columns, typename F>
+    void forEachInRange(F& f, size_t const begin, size_t const end) noexcept {
+        for (size_t i = begin; i < end; i++) {
+            // prefetch each accessed column about two cache lines ahead, scaled to the
+            // column's element size. Prefetching past the end of an array is harmless.
+            (UTILS_PREFETCH(data<Columns>() + i +
+                    std::max(size_t(1), 2 * CACHELINE_SIZE / sizeof(TypeAt<Columns>))), ...);
+            f(i);
+        }
+    }
+
     template<std::size_t I = 0, typename FuncT, typename... Tp>
     inline std::enable_if_t<I == sizeof...(Tp), void>
     for_each(std::tuple<Tp...>&, FuncT) {}
@@ -579,8 +615,10 @@ private:
         // compute the required size of each array
         const size_t sizes[] = { (sizeof(Elements) * capacity)... };
 
-        // we align each array to at least the same alignment guaranteed by malloc
-        constexpr size_t const alignments[] = { std::max(alignof(std::max_align_t), alignof(Elements))... };
+        // we align each array to at least the same alignment guaranteed by malloc, and to a
+        // cache line so that parallel loops over different columns never share a line
+        constexpr size_t const alignments[] = { std::max({ CACHELINE_SIZE,
+                alignof(std::max_align_t), alignof(Elements) })... };
 
         // hopefully most of this gets unrolled and inlined
         std::array<size_t, kArrayCount> offsets;
@@ -26,8 +26,71 @@
 #include <assert.h>
 #include <string.h>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace utils {
 
+// ------------------------------------------------------------------------------------------------
+// AreaPolicy::MappedArea
+// ------------------------------------------------------------------------------------------------
+
+AreaPolicy::MappedArea::MappedArea(size_t const size, Options const options) {
+    if (size) {
+        void* p = nullptr;
+        size_t areaSize = size;
+#if defined(__linux__)
+        // round up to a whole number of (huge)pages so madvise() covers the entire area
+        size_t const granularity = options.hugePages ?
+                size_t(2) * 1024 * 1024 : size_t(sysconf(_SC_PAGESIZE));
+        size_t const mappedSize = (size + granularity - 1) & ~(granularity - 1);
+        p = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+            if (options.hugePages) {
+                madvise(p, mappedSize, MADV_HUGEPAGE);
+            }
+#endif
+            mMappedSize = mappedSize;
+            areaSize = mappedSize;
+        } else {
+            p = nullptr;
+        }
+#endif
+        if (!p) {
+            // mmap() isn't available or failed, fall back to the heap
+            p = malloc(size);
+            areaSize = size;
+        }
+        mBegin = p;
+        mEnd = pointermath::add(p, areaSize);
+        if (options.preFault && p) {
+            // writing the whole area faults every page in; with the kernel's first-touch
+            // policy this places the backing pages on the calling thread's NUMA node
+            memset(p, 0, areaSize);
+        }
+    }
+}
+
+AreaPolicy::MappedArea::~MappedArea() noexcept {
+#if defined(__linux__)
+    if (mMappedSize) {
+        munmap(mBegin, mMappedSize);
+        return;
+    }
+#endif
+    free(mBegin);
+}
+
+// ------------------------------------------------------------------------------------------------
+// HeapAllocationCounter
+// ------------------------------------------------------------------------------------------------
+
+std::atomic<uint64_t> HeapAllocationCounter::sCount = { 0 };
+
 // ------------------------------------------------------------------------------------------------
 // LinearAllocator
 // ------------------------------------------------------------------------------------------------
@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <utils/AsyncIO.h>
+
+#include <utils/Condition.h>
+#include <utils/Invocable.h>
+#include <utils/Mutex.h>
+#include <utils/compiler.h>
+#include <utils/debug.h>
+
+#include <algorithm>
+#include <deque>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__linux__)
+#   include <linux/io_uring.h>
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   include <sys/uio.h>
+#   include <unistd.h>
+#   define HAS_IO_URING 1
+#elif defined(WIN32)
+#   include <io.h>
+#else
+#   include <unistd.h>
+#endif
+
+namespace utils {
+
+struct Request {
+    int fd;
+    int64_t offset;
+    AsyncIO::Buffer const* buffers;
+    size_t count;
+    AsyncIO::Buffer inlineBuffer;   // backing store for single-buffer reads
+    AsyncIO::Callback callback;
+};
+
+class AsyncIO::Backend {
+public:
+    virtual ~Backend() noexcept = default;
+    // takes ownership of the request, completes it on a service thread
+    virtual void submit(Request* request) = 0;
+};
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Thread-pool fallback: a few threads performing positioned reads. Bounded by the pool size,
+// but always available.
+// ------------------------------------------------------------------------------------------------
+
+class ThreadPoolBackend final : public AsyncIO::Backend {
+public:
+    ThreadPoolBackend() {
+        uint32_t const threadCount =
+                std::min(POOL_SIZE, std::max(1u, std::thread::hardware_concurrency() / 2));
+        mThreads.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; i++) {
+            mThreads.emplace_back(&ThreadPoolBackend::loop, this);
+        }
+    }
+
+    ~ThreadPoolBackend() noexcept override {
+        {
+            std::lock_guard const lock(mLock);
+            mExitRequested = true;
+        }
+        mCondition.notify_all();
+        for (auto& thread : mThreads) {
+            thread.join();
+        }
+    }
+
+    void submit(Request* request) override {
+        {
+            std::lock_guard const lock(mLock);
+            mQueue.push_back(request);
+        }
+        mCondition.notify_one();
+    }
+
+private:
+    static constexpr uint32_t POOL_SIZE = 4;
+
+    void loop() {
+        while (true) {
+            Request* request;
+            {
+                std::unique_lock lock(mLock);
+                mCondition.wait(lock, [this] { return mExitRequested || !mQueue.empty(); });
+                if (mExitRequested && mQueue.empty()) {
+                    return;
+                }
+                request = mQueue.front();
+                mQueue.pop_front();
+            }
+            request->callback(execute(*request));
+            delete request;
+        }
+    }
+
+    static ssize_t execute(Request const& request) noexcept {
+        ssize_t total = 0;
+        int64_t offset = request.offset;
+        for (size_t i = 0; i < request.count; i++) {
+            auto const& b = request.buffers[i];
+#if defined(WIN32)
+            if (_lseeki64(request.fd, offset, SEEK_SET) < 0) {
+                return -ssize_t(errno);
+            }
+            ssize_t const r = _read(request.fd, b.data, unsigned(b.size));
+#else
+            ssize_t const r = pread(request.fd, b.data, b.size, off_t(offset));
+#endif
+            if (r < 0) {
+                return -ssize_t(errno);
+            }
+            total += r;
+            offset += r;
+            if (size_t(r) < b.size) {
+                break;  // short read (EOF)
+            }
+        }
+        return total;
+    }
+
+    Mutex mLock;
+    Condition mCondition;
+    std::deque<Request*> mQueue;
+    std::vector<std::thread> mThreads;
+    bool mExitRequested = false;
+};
+
+// ------------------------------------------------------------------------------------------------
+// io_uring backend (Linux and Android). Raw syscalls rather than liburing, so we don't pull a
+// dependency into utils; the ring layout below is kernel ABI.
+// ------------------------------------------------------------------------------------------------
+
+#if defined(HAS_IO_URING)
+
+class IoUringBackend final : public AsyncIO::Backend {
+public:
+    // returns nullptr when the kernel (or a seccomp policy) doesn't provide io_uring
+    static IoUringBackend* create() {
+        io_uring_params params = {};
+        int const ring = int(syscall(__NR_io_uring_setup, RING_ENTRIES, &params));
+        if (ring < 0) {
+            return nullptr;
+        }
+        auto* backend = new(std::nothrow) IoUringBackend(ring, params);
+        if (backend && !backend->mSqes) {
+            delete backend;
+            return nullptr;
+        }
+        return backend;
+    }
+
+    ~IoUringBackend() noexcept override {
+        if (mCompletionThread.joinable()) {
+            {
+                std::lock_guard const lock(mLock);
+                mExitRequested = true;
+                submitLocked(IORING_OP_NOP, 0, 0, nullptr, 0, nullptr);
+            }
+            mCompletionThread.join();
+        }
+        if (mSqRing != MAP_FAILED) {
+            munmap(mSqRing, mSqRingSize);
+        }
+        if (mCqRing != MAP_FAILED && mCqRing != mSqRing) {
+            munmap(mCqRing, mCqRingSize);
+        }
+        if (mSqes) {
+            munmap(mSqes, mSqEntries * sizeof(io_uring_sqe));
+        }
+        close(mRing);
+    }
+
+    void submit(Request* request) override {
+        std::lock_guard const lock(mLock);
+        submitLocked(IORING_OP_READV, request->fd, uint64_t(request->offset),
+                request->buffers, uint32_t(request->count), request);
+    }
+
+private:
+    static constexpr uint32_t RING_ENTRIES = 256;
+
+    IoUringBackend(int ring, io_uring_params const& params) : mRing(ring) {
+        mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            mSqRingSize = mCqRingSize = std::max(mSqRingSize, mCqRingSize);
+        }
+        mSqRing = mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+        mCqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? mSqRing
+                : mmap(nullptr, mCqRingSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING);
+        void* const sqes = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe),
+                PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES);
+        if (mSqRing == MAP_FAILED || mCqRing == MAP_FAILED || sqes == MAP_FAILED) {
+            return; // mSqes stays null, create() cleans up
+        }
+        mSqes = static_cast<io_uring_sqe*>(sqes);
+        mSqEntries = params.sq_entries;
+
+        auto const at = [](void* base, uint32_t offset) {
+            return reinterpret_cast<uint32_t*>(static_cast<char*>(base) + offset);
+        };
+        mSqTail = at(mSqRing, params.sq_off.tail);
+        mSqMask = *at(mSqRing, params.sq_off.ring_mask);
+        mSqArray = at(mSqRing, params.sq_off.array);
+        mCqHead = at(mCqRing, params.cq_off.head);
+        mCqTail = at(mCqRing, params.cq_off.tail);
+        mCqMask = *at(mCqRing, params.cq_off.ring_mask);
+        mCqes = reinterpret_cast<io_uring_cqe*>(
+                static_cast<char*>(mCqRing) + params.cq_off.cqes);
+
+        mCompletionThread = std::thread(&IoUringBackend::loop, this);
+    }
+
+    void submitLocked(uint8_t opcode, int fd, uint64_t offset,
+            AsyncIO::Buffer const* buffers, uint32_t count, Request* request) {
+        uint32_t const tail = __atomic_load_n(mSqTail, __ATOMIC_RELAXED);
+        uint32_t const index = tail & mSqMask;
+        io_uring_sqe& sqe = mSqes[index];
+        sqe = {};
+        sqe.opcode = opcode;
+        sqe.fd = fd;
+        sqe.off = offset;
+        // Buffer is layout-compatible with iovec
+        static_assert(sizeof(AsyncIO::Buffer) == sizeof(iovec) &&
+                      offsetof(AsyncIO::Buffer, data) == offsetof(iovec, iov_base) &&
+                      offsetof(AsyncIO::Buffer, size) == offsetof(iovec, iov_len));
+        sqe.addr = reinterpret_cast<uint64_t>(buffers);
+        sqe.len = count;
+        sqe.user_data = reinterpret_cast<uint64_t>(request);
+        mSqArray[index] = index;
+        __atomic_store_n(mSqTail, tail + 1, __ATOMIC_RELEASE);
+        syscall(__NR_io_uring_enter, mRing, 1, 0, 0, nullptr, 0);
+    }
+
+    void loop() {
+        while (true) {
+            uint32_t head = __atomic_load_n(mCqHead, __ATOMIC_RELAXED);
+            if (head == __atomic_load_n(mCqTail, __ATOMIC_ACQUIRE)) {
+                syscall(__NR_io_uring_enter, mRing, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                continue;
+            }
+            io_uring_cqe const& cqe = mCqes[head & mCqMask];
+            auto* const request = reinterpret_cast<Request*>(uintptr_t(cqe.user_data));
+            ssize_t const result = cqe.res;
+            __atomic_store_n(mCqHead, head + 1, __ATOMIC_RELEASE);
+            if (request) {
+                request->callback(result);
+                delete request;
+            } else if (mExitRequested) {
+                return;
+            }
+        }
+    }
+
+    int const mRing;
+    void* mSqRing = MAP_FAILED;
+    void* mCqRing = MAP_FAILED;
+    io_uring_sqe* mSqes = nullptr;
+    size_t mSqRingSize = 0;
+    size_t mCqRingSize = 0;
+    uint32_t mSqEntries = 0;
+    uint32_t* mSqTail = nullptr;
+    uint32_t* mSqArray = nullptr;
+    uint32_t mSqMask = 0;
+    uint32_t* mCqHead = nullptr;
+    uint32_t* mCqTail = nullptr;
+    uint32_t mCqMask = 0;
+    io_uring_cqe* mCqes = nullptr;
+    Mutex mLock;
+    std::thread mCompletionThread;
+    bool mExitRequested = false;
+};
+
+#endif // HAS_IO_URING
+
+} // anonymous namespace
+
+// ------------------------------------------------------------------------------------------------
+// Hands completed reads' jobs to a JobSystem. JobSystem::run() may only be called from a
+// thread the JobSystem knows about, so a single thread adopts it (as the engine's driver
+// thread does) and runs all chained jobs.
+// ------------------------------------------------------------------------------------------------
+
+class AsyncIO::JobRunner {
+public:
+    JobRunner() : mThread(&JobRunner::loop, this) {}
+
+    ~JobRunner() noexcept {
+        {
+            std::lock_guard const lock(mLock);
+            mExitRequested = true;
+        }
+        mCondition.notify_all();
+        mThread.join();
+    }
+
+    void post(JobSystem& js, JobSystem::Job* job) {
+        {
+            std::lock_guard const lock(mLock);
+            mQueue.push_back({ &js, job });
+        }
+        mCondition.notify_one();
+    }
+
+private:
+    void loop() {
+        while (true) {
+            std::pair<JobSystem*, JobSystem::Job*> entry;
+            {
+                std::unique_lock lock(mLock);
+                mCondition.wait(lock, [this] { return mExitRequested || !mQueue.empty(); });
+                if (mExitRequested && mQueue.empty()) {
+                    return;
+                }
+                entry = mQueue.front();
+                mQueue.pop_front();
+            }
+            entry.first->adopt();   // idempotent once this thread is adopted
+            entry.first->run(entry.second);
+        }
+    }
+
+    Mutex mLock;
+    Condition mCondition;
+    std::deque<std::pair<JobSystem*, JobSystem::Job*>> mQueue;
+    std::thread mThread;
+    bool mExitRequested = false;
+};
+
+// ------------------------------------------------------------------------------------------------
+
+AsyncIO& AsyncIO::get() noexcept {
+    static AsyncIO instance;
+    return instance;
+}
+
+AsyncIO::AsyncIO() {
+#if defined(HAS_IO_URING)
+    mBackend = IoUringBackend::create();
+#endif
+    if (!mBackend) {
+        mBackend = new ThreadPoolBackend();
+    }
+}
+
+AsyncIO::~AsyncIO() {
+    delete mRunner;
+    delete mBackend;
+}
+
+AsyncIO::JobRunner* AsyncIO::getRunner() {
+    std::lock_guard const lock(mRunnerLock);
+    if (!mRunner) {
+        mRunner = new JobRunner();
+    }
+    return mRunner;
+}
+
+void AsyncIO::read(int fd, int64_t offset, Buffer const* buffers, size_t count,
+        JobSystem& js, JobSystem::Job* job) {
+    JobRunner* const runner = getRunner();
+    read(fd, offset, buffers, count, [runner, &js, job](ssize_t) {
+        runner->post(js, job);
+    });
+}
+
+void AsyncIO::read(int fd, int64_t offset, void* data, size_t size, Callback callback) {
+    auto* const request = new Request{ fd, offset, nullptr, 1, { data, size },
+            std::move(callback) };
+    request->buffers = &request->inlineBuffer;
+    mBackend->submit(request);
+}
+
+void AsyncIO::read(int fd, int64_t offset, Buffer const* buffers, size_t count,
+        Callback callback) {
+    assert_invariant(count > 0);
+    mBackend->submit(new Request{ fd, offset, buffers, count, {}, std::move(callback) });
+}
+
+} // namespace utils
@@ -21,6 +21,7 @@
 
 #include <utils/compiler.h>
 #include <utils/Entity.h>
+#include <utils/MPMCQueue.h>
 #include <utils/Mutex.h>
 #include <utils/CallStack.h>
 #include <utils/FixedCapacityVector.h>
@@ -31,13 +32,18 @@
 #include <tsl/robin_map.h>
 #endif
 
-#include <deque>
+#include <atomic>
+#include <memory>
 #include <mutex> // for std::lock_guard
 #include <vector>
 
 
 namespace utils {
 
+// recycling doesn't start until at least this many freed indices are outstanding, and a
+// freed index round-trips through a shared FIFO behind every index freed before it, so a
+// given index isn't reused until roughly that many other frees have happened -- which is
+// what delays generation reuse (and wrap-around) of any given index
 static constexpr const size_t MIN_FREE_INDICES = 1024;
 
 class UTILS_PRIVATE EntityManagerImpl : public EntityManager {
@@ -48,54 +54,69 @@ public:
     using EntityManager::create;
     using EntityManager::destroy;
 
-    UTILS_NOINLINE
+    EntityManagerImpl()
+            : mSharedFreeList(std::make_shared<FreeList>()) {
+    }
+
     size_t getEntityCount() const noexcept {
-        std::lock_guard<Mutex> const lock(mFreeListLock);
-        if (mCurrentIndex < RAW_INDEX_COUNT) {
-            return (mCurrentIndex - 1) - mFreeList.size();
-        } else {
-            return getMaxEntityCount() - mFreeList.size();
-        }
+        return mEntityCount.load(std::memory_order_relaxed);
     }
 
     UTILS_NOINLINE
     void create(size_t n, Entity* entities) {
-        Entity::Type index{};
-        auto& freeList = mFreeList;
-        uint8_t* const gens = mGens;
-
-        // this must be thread-safe, acquire the free-list mutex
-        std::lock_guard<Mutex> const lock(mFreeListLock);
-        Entity::Type currentIndex = mCurrentIndex;
+        FreeListCache& cache = bindFreeListCache();
+        std::atomic<uint8_t> const* const gens = mGens;
+        uint32_t created = 0;
         for (size_t i = 0; i < n; i++) {
-            if (UTILS_UNLIKELY(currentIndex >= RAW_INDEX_COUNT || freeList.size() >= MIN_FREE_INDICES)) {
-
-                // this could only happen if we had gone through all the indices at least once
-                if (UTILS_UNLIKELY(freeList.empty())) {
+            Entity::Type index = 0;
+            if (UTILS_UNLIKELY(mFreeCount.load(std::memory_order_relaxed) >= MIN_FREE_INDICES
+                    || mCurrentIndex.load(std::memory_order_relaxed) >= RAW_INDEX_COUNT)) {
+                // enough freed indices are outstanding (or we have gone through all the
+                // indices at least once), recycle one from our per-thread magazine,
+                // refilling it in a batch from the oldest end of the shared FIFO if needed
+                if (!cache.incomingCount) {
+                    cache.refill(*mSharedFreeList);
+                }
+                if (cache.incomingCount) {
+                    index = cache.incoming[--cache.incomingCount];
+                    mFreeCount.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+            if (UTILS_LIKELY(!index)) {
+                index = allocateIndex();
+            }
+            if (UTILS_UNLIKELY(!index)) {
+                // the index space is exhausted, recycle whatever is left even below
+                // the MIN_FREE_INDICES cushion, including our own not-yet-flushed frees
+                if (!cache.incomingCount) {
+                    cache.flush(*mSharedFreeList);
+                    cache.refill(*mSharedFreeList);
+                }
+                if (cache.incomingCount) {
+                    index = cache.incoming[--cache.incomingCount];
+                    mFreeCount.fetch_sub(1, std::memory_order_relaxed);
+                } else {
                     // return the null entity
                     entities[i] = {};
                     continue;
                 }
-
-                index = freeList.front();
-                freeList.pop_front();
-            } else {
-                index = currentIndex++;
             }
-            entities[i] = Entity{ makeIdentity(gens[index], index) };
+            entities[i] = Entity{ makeIdentity(
+                    gens[index].load(std::memory_order_relaxed), index) };
+            created++;
 #if FILAMENT_UTILS_TRACK_ENTITIES
+            std::lock_guard<Mutex> const lock(mDebugLock);
             mDebugActiveEntities.emplace(entities[i], CallStack::unwind(5));
 #endif
         }
-        mCurrentIndex = currentIndex;
+        mEntityCount.fetch_add(created, std::memory_order_relaxed);
     }
 
     UTILS_NOINLINE
     void destroy(size_t n, Entity* entities) noexcept {
-        auto& freeList = mFreeList;
-        uint8_t* const gens = mGens;
-
-        std::unique_lock<Mutex> lock(mFreeListLock);
+        FreeListCache& cache = bindFreeListCache();
+        std::atomic<uint8_t>* const gens = mGens;
+        uint32_t destroyed = 0;
         for (size_t i = 0; i < n; i++) {
             if (!entities[i]) {
                 // behave like free(), ok to free null Entity.
@@ -110,20 +131,29 @@ public:
             // will be called.
             if (isAlive(entities[i])) {
                 Entity::Type const index = getIndex(entities[i]);
-                freeList.push_back(index);
 
-                // The generation update doesn't require the lock because it's only used for isAlive()
-                // and entities work as weak references -- it just means that isAlive() could return
-                // true a little longer than expected in some other threads.
-                // We do need a memory fence though, it is provided by the mFreeListLock.unlock() below.
-                gens[index]++;
+                // The generation update is only used for isAlive() and entities work as weak
+                // references -- the relaxed store just means that isAlive() could return true
+                // a little longer than expected in some other threads. A thread that recycles
+                // this index observes the new generation through the shared free list's
+                // release/acquire ordering.
+                gens[index].fetch_add(1, std::memory_order_relaxed);
+
+                if (cache.outgoingCount == FreeListCache::CAPACITY) {
+                    // our magazine is full, push the whole batch to the shared FIFO
+                    cache.flush(*mSharedFreeList);
+                }
+                cache.outgoing[cache.outgoingCount++] = index;
+                mFreeCount.fetch_add(1, std::memory_order_relaxed);
+                destroyed++;
 
 #if FILAMENT_UTILS_TRACK_ENTITIES
+                std::lock_guard<Mutex> const lock(mDebugLock);
                 mDebugActiveEntities.erase(entities[i]);
 #endif
             }
         }
-        lock.unlock();
+        mEntityCount.fetch_sub(destroyed, std::memory_order_relaxed);
 
         // notify our listeners that some entities are being destroyed
         auto listeners = getListeners();
@@ -144,6 +174,7 @@ public:
 
 #if FILAMENT_UTILS_TRACK_ENTITIES
     std::vector<Entity> getActiveEntities() const {
+        std::lock_guard<Mutex> const lock(mDebugLock);
         std::vector<Entity> result(mDebugActiveEntities.size());
         auto p = result.begin();
         for (auto i : mDebugActiveEntities) {
@@ -153,6 +184,7 @@ public:
     }
 
     void dumpActiveEntities(utils::io::ostream& out) const {
+        std::lock_guard<Mutex> const lock(mDebugLock);
         for (auto i : mDebugActiveEntities) {
             out << "*** Entity " << i.first.getId() << " was allocated at:\n";
             out << i.second;
@@ -162,6 +194,109 @@ public:
 #endif
 
 private:
+    /*
+     * A lock-free FIFO of freed indices, sized to hold the entire index space so pushes
+     * can never fail. The FIFO order is load-bearing: a freed index waits behind every
+     * index freed before it, which -- together with the MIN_FREE_INDICES gate -- is what
+     * delays generation reuse of any given index. It is shared (via shared_ptr) with the
+     * per-thread caches, so a cache can safely flush -- or discover that its manager is
+     * gone -- when its thread exits.
+     */
+    class FreeList {
+    public:
+        // pushes a batch of indices; the queue holds the whole index space, so this
+        // cannot fail
+        void push(Entity::Type const* indices, uint32_t const n) noexcept {
+            for (uint32_t k = 0; k < n; k++) {
+                UTILS_UNUSED_IN_RELEASE bool const pushed = mQueue.tryPush(indices[k]);
+                assert(pushed);
+            }
+        }
+
+        // pops up to n of the oldest indices, returns how many were popped
+        uint32_t pop(Entity::Type* indices, uint32_t const n) noexcept {
+            uint32_t k = 0;
+            while (k < n && mQueue.tryPop(indices[k])) {
+                k++;
+            }
+            return k;
+        }
+
+    private:
+        MPMCQueue<Entity::Type, RAW_INDEX_COUNT> mQueue;
+    };
+
+    /*
+     * Per-thread magazines of freed indices, only there to amortize the shared-queue
+     * traffic: destroy() write-combines into the outgoing magazine and flushes it to the
+     * shared FIFO in batches, create() refills the incoming magazine from the FIFO's
+     * oldest end in batches. A freed index always round-trips through the shared FIFO --
+     * create() never consumes this thread's own recent frees directly -- so the per-index
+     * reuse delay survives the caching. The cache references its manager's free list
+     * weakly, so a thread that outlives the manager just drops its indices on exit.
+     */
+    struct FreeListCache {
+        static constexpr uint32_t CAPACITY = 32;
+        std::weak_ptr<FreeList> freeList;
+        uint32_t incomingCount = 0;
+        uint32_t outgoingCount = 0;
+        Entity::Type incoming[CAPACITY];
+        Entity::Type outgoing[CAPACITY];
+
+        // moves the outgoing magazine to the shared list
+        void flush(FreeList& sharedFreeList) noexcept {
+            sharedFreeList.push(outgoing, outgoingCount);
+            outgoingCount = 0;
+        }
+
+        // grabs a batch of the oldest indices from the shared list
+        void refill(FreeList& sharedFreeList) noexcept {
+            assert(incomingCount == 0);
+            incomingCount = sharedFreeList.pop(incoming, CAPACITY);
+        }
+
+        void rebind(std::shared_ptr<FreeList> const& sharedFreeList) noexcept {
+            if (auto const previous = freeList.lock()) {
+                previous->push(outgoing, outgoingCount);
+                previous->push(incoming, incomingCount);
+            }
+            incomingCount = 0;
+            outgoingCount = 0;
+            freeList = sharedFreeList;
+        }
+
+        ~FreeListCache() noexcept {
+            if (auto const sharedFreeList = freeList.lock()) {
+                sharedFreeList->push(outgoing, outgoingCount);
+                sharedFreeList->push(incoming, incomingCount);
+            }
+        }
+    };
+
+    // returns this thread's magazine, bound to this manager's free list
+    FreeListCache& bindFreeListCache() noexcept {
+        static thread_local FreeListCache sCache;
+        FreeListCache& cache = sCache;
+        if (UTILS_UNLIKELY(cache.freeList.owner_before(mSharedFreeList)
+                || mSharedFreeList.owner_before(cache.freeList))) {
+            // first use on this thread, or this thread last used another manager
+            cache.rebind(mSharedFreeList);
+        }
+        return cache;
+    }
+
+    // allocates a never-used index, or returns 0 if the index space is exhausted
+    Entity::Type allocateIndex() noexcept {
+        Entity::Type index = mCurrentIndex.load(std::memory_order_relaxed);
+        do {
+            if (UTILS_UNLIKELY(index >= RAW_INDEX_COUNT)) {
+                return 0;
+            }
+        } while (!mCurrentIndex.compare_exchange_weak(index, index + 1,
+                std::memory_order_relaxed));
+        return index;
+    }
+
     FixedCapacityVector<Listener*> getListeners() const noexcept {
         std::lock_guard<Mutex> const lock(mListenerLock);
         tsl::robin_set<Listener*> const& listeners = mListeners;
@@ -171,16 +306,22 @@ private:
         return result; // the c++ standard guarantees a move
     }
 
-    uint32_t mCurrentIndex = 1;
+    std::atomic<Entity::Type> mCurrentIndex = { 1 };
+
+    // number of live entities
+    std::atomic<uint32_t> mEntityCount = { 0 };
+
+    // number of freed indices outstanding, wherever they live (shared list or magazines)
+    std::atomic<uint32_t> mFreeCount = { 0 };
 
     // stores indices that got freed
-    mutable Mutex mFreeListLock;
-    std::deque<Entity::Type> mFreeList;
+    std::shared_ptr<FreeList> const mSharedFreeList;
 
     mutable Mutex mListenerLock;
     tsl::robin_set<Listener*> mListeners;
 
 #if FILAMENT_UTILS_TRACK_ENTITIES
+    mutable Mutex mDebugLock;
     tsl::robin_map<Entity, CallStack, Entity::Hasher> mDebugActiveEntities;
 #endif
 };
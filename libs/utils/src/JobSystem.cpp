@@ -28,6 +28,7 @@
 #include <utils/JobSystem.h>
 
 #include <private/utils/Tracing.h>
+#include <private/utils/TraceRecorder.h>
 
 #include <utils/compiler.h>
 #include <utils/debug.h>
@@ -50,6 +51,7 @@
 #include <math.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 
 
 #if defined(WIN32)
@@ -174,6 +176,63 @@ void JobSystem::setThreadAffinityById(size_t id) noexcept {
 #endif
 }
 
+void JobSystem::setThreadAffinity(size_t const worker, size_t const cpuId) noexcept {
+#if defined(__linux__)
+    if (worker < mThreadCount) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpuId, &set);
+        pthread_setaffinity_np(mThreadStates[worker].thread.native_handle(),
+                sizeof(set), &set);
+    }
+#endif
+}
+
+JobSystem::WorkerMetrics JobSystem::getWorkerMetrics(size_t const worker) const noexcept {
+    assert(worker < mThreadStates.size());
+    ThreadState const& state = mThreadStates[worker];
+    return {
+            state.jobsExecuted.load(std::memory_order_relaxed),
+            state.jobsStolen.load(std::memory_order_relaxed),
+            state.parkCount.load(std::memory_order_relaxed),
+            state.cacheReferences.load(std::memory_order_relaxed),
+            state.cacheMisses.load(std::memory_order_relaxed),
+            state.branches.load(std::memory_order_relaxed),
+            state.branchMisses.load(std::memory_order_relaxed) };
+}
+
+void JobSystem::enableWorkerProfiling(uint32_t const profilerEventMask) noexcept {
+    mProfilerEventMask.store(profilerEventMask, std::memory_order_relaxed);
+    mProfilerGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void JobSystem::disableWorkerProfiling() noexcept {
+    mProfilerEventMask.store(0, std::memory_order_relaxed);
+    mProfilerGeneration.fetch_add(1, std::memory_order_release);
+    // hand the per-worker totals to an ongoing in-process profiling session, if any
+    if (UTILS_UNLIKELY(TraceRecorder::isRecording())) {
+        char name[TraceRecorder::Event::NAME_SIZE];
+        for (size_t i = 0, n = mThreadStates.size(); i < n; i++) {
+            WorkerMetrics const metrics = getWorkerMetrics(i);
+            snprintf(name, sizeof(name), "worker%zu dcache-refs", i);
+            TraceRecorder::get().counter(name, int64_t(metrics.cacheReferences));
+            snprintf(name, sizeof(name), "worker%zu dcache-misses", i);
+            TraceRecorder::get().counter(name, int64_t(metrics.cacheMisses));
+            snprintf(name, sizeof(name), "worker%zu branches", i);
+            TraceRecorder::get().counter(name, int64_t(metrics.branches));
+            snprintf(name, sizeof(name), "worker%zu branch-misses", i);
+            TraceRecorder::get().counter(name, int64_t(metrics.branchMisses));
+        }
+    }
+}
+
+void JobSystem::setActiveThreadCount(size_t const count) noexcept {
+    uint16_t const clamped = uint16_t(std::min(std::max(count, size_t(1)), size_t(mThreadCount)));
+    mActiveThreadCount.store(clamped, std::memory_order_relaxed);
+    // wake everyone up so workers on either side of the new count notice the change
+    wakeAll();
+}
+
 JobSystem::JobSystem(const size_t userThreadCount, const size_t adoptableThreadsCount) noexcept
     : mJobPool("JobSystem Job pool", MAX_JOB_COUNT * sizeof(Job)),
       mJobStorageBase(static_cast<Job *>(mJobPool.getAllocator().getCurrent()))
@@ -200,6 +259,7 @@ JobSystem::JobSystem(const size_t userThreadCount, const size_t adoptableThreads
 
     mThreadStates = aligned_vector<ThreadState>(threadPoolCount + adoptableThreadsCount);
     mThreadCount = uint16_t(threadPoolCount);
+    mActiveThreadCount.store(mThreadCount, std::memory_order_relaxed);
     mParallelSplitCount = (uint8_t)std::ceil((std::log2f(threadPoolCount + adoptableThreadsCount)));
 
     static_assert(std::atomic<bool>::is_always_lock_free);
@@ -419,6 +479,7 @@ bool JobSystem::execute(ThreadState& state) noexcept {
     HEAVY_FILAMENT_TRACING_CALL(FILAMENT_TRACING_CATEGORY_JOBSYSTEM);
 
     Job* job = pop(state.workQueue);
+    bool stolen = false;
 
     // It is beneficial for some benchmarks to poll on steal() for a bit, because going back to
     // sleep and waking up is pretty expensive. However, it is unclear it helps in practice with
@@ -427,14 +488,48 @@ bool JobSystem::execute(ThreadState& state) noexcept {
     for (size_t i = 0; UTILS_UNLIKELY(!job && i < STEAL_TRY_COUNT); i++) {
         // our queue is empty, try to steal a job
         job = steal(state);
+        stolen = job != nullptr;
     }
 
     if (UTILS_LIKELY(job)) {
+        state.jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+        if (UTILS_UNLIKELY(stolen)) {
+            state.jobsStolen.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // (re)open or close our PMU counters if enableWorkerProfiling() was called since
+        // the last job; perf events can only be opened from the thread they count.
+        uint32_t const profilerGeneration =
+                mProfilerGeneration.load(std::memory_order_acquire);
+        if (UTILS_UNLIKELY(state.profilerGeneration != profilerGeneration)) {
+            state.profilerGeneration = profilerGeneration;
+            uint32_t const eventMask = mProfilerEventMask.load(std::memory_order_relaxed);
+            if (eventMask) {
+                state.profiler.resetEvents(eventMask);
+                state.profiler.start();
+            } else {
+                state.profiler.closeEvents();
+            }
+        }
+
         assert((job->runningJobCount.load(std::memory_order_relaxed) & JOB_COUNT_MASK) >= 1);
         if (UTILS_LIKELY(job->function)) {
             HEAVY_FILAMENT_TRACING_NAME(FILAMENT_TRACING_CATEGORY_JOBSYSTEM, "job->function");
             job->id = std::distance(mThreadStates.data(), &state);
-            job->function(job->storage, *this, job);
+            if (UTILS_UNLIKELY(state.profiler.isValid())) {
+                Profiler::Counters const before = state.profiler.readCounters();
+                job->function(job->storage, *this, job);
+                Profiler::Counters const delta = state.profiler.readCounters() - before;
+                state.cacheReferences.fetch_add(delta.getL1DReferences(),
+                        std::memory_order_relaxed);
+                state.cacheMisses.fetch_add(delta.getL1DMisses(), std::memory_order_relaxed);
+                state.branches.fetch_add(delta.getBranchInstructions(),
+                        std::memory_order_relaxed);
+                state.branchMisses.fetch_add(delta.getBranchMisses(),
+                        std::memory_order_relaxed);
+            } else {
+                job->function(job->storage, *this, job);
+            }
             job->id = invalidThreadId;
         }
         finish(job);
@@ -453,10 +548,28 @@ void JobSystem::loop(ThreadState* state) {
 
     FILAMENT_CHECK_PRECONDITION(inserted) << "This thread is already in a loop.";
 
+    size_t const workerIndex = size_t(std::distance(mThreadStates.data(), state));
+
     // run our main loop...
     do {
+        // If the governor shrank the active thread count past us, park until it grows again.
+        if (UTILS_UNLIKELY(workerIndex >= mActiveThreadCount.load(std::memory_order_relaxed))) {
+            std::unique_lock lock(mWaiterLock);
+            state->parkCount.fetch_add(1, std::memory_order_relaxed);
+            while (!exitRequested() &&
+                    workerIndex >= mActiveThreadCount.load(std::memory_order_relaxed)) {
+                if (hasActiveJobs()) {
+                    // We may have consumed a wake-up meant for an active worker, pass it
+                    // along. Jobs left in our queue remain stealable while we're parked.
+                    mWaiterCondition.notify_one();
+                }
+                wait(lock);
+            }
+            continue;
+        }
         if (!execute(*state)) {
             std::unique_lock lock(mWaiterLock);
+            state->parkCount.fetch_add(1, std::memory_order_relaxed);
             while (!exitRequested() && !hasActiveJobs()) {
                 wait(lock);
             }
@@ -485,6 +598,21 @@ void JobSystem::finish(Job* job) noexcept {
             if (waiters) {
                 notify = true;
             }
+            // if a continuation was attached with runOnCompletion(), dispatch it now
+            if (UTILS_UNLIKELY(v & CONTINUATION_FLAG)) {
+                Job* continuation = nullptr;
+                {
+                    std::lock_guard const lock(mContinuationLock);
+                    auto const iter = mContinuations.find(job);
+                    if (iter != mContinuations.end()) {
+                        continuation = iter->second;
+                        mContinuations.erase(iter);
+                    }
+                }
+                if (continuation) {
+                    run(continuation);
+                }
+            }
             Job* const parent = job->parent == 0x7FFF ? nullptr : &storage[job->parent];
             decRef(job);
             job = parent;
@@ -629,6 +757,29 @@ void JobSystem::runAndWait(Job*& job) noexcept {
     waitAndRelease(job);
 }
 
+void JobSystem::runOnCompletion(Job* const job, Job*& continuation) noexcept {
+    assert(job);
+    assert(continuation);
+
+    // this is only allowed before the job has run (see cancel())
+    assert((job->runningJobCount.load(std::memory_order_relaxed) & JOB_COUNT_MASK) >= 1);
+
+    {
+        std::lock_guard const lock(mContinuationLock);
+        // a single continuation per job; chain through the continuation itself if needed
+        assert(mContinuations.find(job) == mContinuations.end());
+        mContinuations[job] = continuation;
+    }
+
+    // memory_order_release so that the thread observing the flag in finish() also sees the
+    // map insertion above (the lock alone guarantees it, but this makes the intent explicit).
+    job->runningJobCount.fetch_or(CONTINUATION_FLAG, std::memory_order_release);
+
+    // after runOnCompletion() returns, the continuation is virtually invalid (it'll run and
+    // die on its own)
+    continuation = nullptr;
+}
+
 void JobSystem::adopt() {
     const auto tid = std::this_thread::get_id();
 
@@ -676,7 +827,11 @@ void JobSystem::emancipate() {
 io::ostream& operator<<(io::ostream& out, JobSystem const& js) {
     for (auto const& item : js.mThreadStates) {
         size_t const id = std::distance(js.mThreadStates.data(), &item);
-        out << id << ": " << item.workQueue.getCount() << io::endl;
+        out << id << ": " << item.workQueue.getCount()
+            << " (executed=" << item.jobsExecuted.load(std::memory_order_relaxed)
+            << ", stolen=" << item.jobsStolen.load(std::memory_order_relaxed)
+            << ", parked=" << item.parkCount.load(std::memory_order_relaxed) << ")"
+            << io::endl;
     }
     return out;
 }
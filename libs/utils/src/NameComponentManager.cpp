@@ -17,6 +17,8 @@
 #include <utils/NameComponentManager.h>
 #include <utils/EntityManager.h>
 
+#include <algorithm>
+
 namespace utils {
 
 static constexpr size_t NAME = 0;
@@ -28,7 +30,19 @@ NameComponentManager::~NameComponentManager() = default;
 
 void NameComponentManager::setName(Instance instance, const char* name) noexcept {
     if (instance) {
-        elementAt<NAME>(instance) = CString{ name };
+        InternedString& slot = elementAt<NAME>(instance);
+        InternedString const interned = StringInterner::get().intern(name);
+        if (slot == interned) {
+            return;
+        }
+        Entity const e = getEntity(instance);
+        if (!slot.empty()) {
+            eraseFromIndex(slot, e);
+        }
+        slot = interned;
+        if (!interned.empty()) {
+            mNameToEntities[std::string_view(interned)].push_back(e);
+        }
     }
 }
 
@@ -36,11 +50,52 @@ const char* NameComponentManager::getName(Instance instance) const noexcept {
     return elementAt<NAME>(instance).c_str();
 }
 
+Entity NameComponentManager::getFirstEntityByName(const char* name) const noexcept {
+    auto pos = mNameToEntities.find(std::string_view(name ? name : ""));
+    return pos == mNameToEntities.end() ? Entity{} : pos->second.front();
+}
+
+size_t NameComponentManager::getEntitiesByName(const char* name, Entity* entities,
+        size_t maxCount) const noexcept {
+    auto pos = mNameToEntities.find(std::string_view(name ? name : ""));
+    if (pos == mNameToEntities.end()) {
+        return 0;
+    }
+    std::vector<Entity> const& found = pos->second;
+    if (entities == nullptr) {
+        return found.size();
+    }
+    size_t const count = std::min(maxCount, found.size());
+    std::copy_n(found.begin(), count, entities);
+    return count;
+}
+
+void NameComponentManager::eraseFromIndex(InternedString name, Entity e) noexcept {
+    auto pos = mNameToEntities.find(std::string_view(name));
+    if (pos == mNameToEntities.end()) {
+        return;
+    }
+    std::vector<Entity>& entities = pos.value();
+    if (auto it = std::find(entities.begin(), entities.end(), e); it != entities.end()) {
+        // order within a bucket doesn't matter, swap with the last entry
+        *it = entities.back();
+        entities.pop_back();
+    }
+    if (entities.empty()) {
+        mNameToEntities.erase(pos);
+    }
+}
+
 void NameComponentManager::addComponent(Entity e) {
     SingleInstanceComponentManager::addComponent(e);
 }
 
 void NameComponentManager::removeComponent(Entity e) {
+    if (Instance const instance = getInstance(e); instance) {
+        if (InternedString const name = elementAt<NAME>(instance); !name.empty()) {
+            eraseFromIndex(name, e);
+        }
+    }
     SingleInstanceComponentManager::removeComponent(e);
 }
 
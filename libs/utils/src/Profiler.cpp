@@ -63,16 +63,10 @@ Profiler::Profiler(uint32_t eventMask) noexcept : Profiler() {
 }
 
 Profiler::~Profiler() noexcept {
-    #pragma nounroll
-    for (int fd : mCountersFd) {
-        if (fd >= 0) {
-            close(fd);
-        }
-    }
+    closeEvents();
 }
 
-uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
-    // close all counters
+void Profiler::closeEvents() noexcept {
     #pragma nounroll
     for (int& fd : mCountersFd) {
         if (fd >= 0) {
@@ -81,6 +75,11 @@ uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
         }
     }
     mEnabledEvents = 0;
+}
+
+uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
+    // close all counters
+    closeEvents();
 
 #if defined(__linux__)
 
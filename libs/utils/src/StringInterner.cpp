@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <utils/StringInterner.h>
+
+#include <mutex>
+
+#include <string.h>
+
+namespace utils {
+
+// granularity of the backing storage; small strings share blocks, anything larger gets a
+// dedicated allocation
+constexpr size_t BLOCK_SIZE = 16384;
+
+StringInterner::StringInterner() noexcept = default;
+StringInterner::~StringInterner() noexcept = default;
+
+StringInterner& StringInterner::get() noexcept {
+    static StringInterner instance;
+    return instance;
+}
+
+char* StringInterner::allocate(size_t const size) noexcept {
+    if (size > mRemaining) {
+        size_t const blockSize = size > BLOCK_SIZE ? size : BLOCK_SIZE;
+        mBlocks.emplace_back(new char[blockSize]);
+        mCurrent = mBlocks.back().get();
+        mRemaining = blockSize;
+    }
+    char* const p = mCurrent;
+    mCurrent += size;
+    mRemaining -= size;
+    return p;
+}
+
+InternedString StringInterner::intern(const char* str, size_t const length) noexcept {
+    if (!str) {
+        return {};
+    }
+    std::lock_guard const lock(mLock);
+    auto const pos = mStrings.find(std::string_view{ str, length });
+    if (pos != mStrings.end()) {
+        return InternedString{ *pos };
+    }
+    char* const copy = allocate(length + 1);
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+    std::string_view const view{ copy, length };
+    mStrings.insert(view);
+    return InternedString{ view };
+}
+
+InternedString StringInterner::intern(const char* str) noexcept {
+    return str ? intern(str, strlen(str)) : InternedString{};
+}
+
+size_t StringInterner::size() const noexcept {
+    std::lock_guard const lock(mLock);
+    return mStrings.size();
+}
+
+} // namespace utils
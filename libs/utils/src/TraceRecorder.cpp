@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <private/utils/TraceRecorder.h>
+
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include <string.h>
+
+namespace utils {
+
+std::atomic<bool> TraceRecorder::sRecording = { false };
+
+TraceRecorder& TraceRecorder::get() noexcept {
+    static TraceRecorder instance;
+    return instance;
+}
+
+void TraceRecorder::start(void* buffer, size_t const sizeInBytes) noexcept {
+    if (!buffer || sizeInBytes < sizeof(Event)) {
+        return;
+    }
+    stop();
+    mEvents = static_cast<Event*>(buffer);
+    mCapacity = sizeInBytes / sizeof(Event);
+    mCursor.store(0, std::memory_order_relaxed);
+    sRecording.store(true, std::memory_order_seq_cst);
+}
+
+size_t TraceRecorder::stop() noexcept {
+    if (!sRecording.load(std::memory_order_relaxed)) {
+        return 0;
+    }
+    sRecording.store(false, std::memory_order_seq_cst);
+    // wait for in-flight writers so the caller can reclaim the buffer when we return
+    while (mActiveWriters.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    mEvents = nullptr;
+    mCapacity = 0;
+    return size_t(mCursor.load(std::memory_order_relaxed));
+}
+
+void TraceRecorder::record(Type const type, const char* name, int64_t const value) noexcept {
+    if (UTILS_LIKELY(!isRecording())) {
+        return;
+    }
+    mActiveWriters.fetch_add(1, std::memory_order_acquire);
+    // re-check now that we're accounted for; stop() drains us before releasing the buffer
+    if (UTILS_LIKELY(sRecording.load(std::memory_order_acquire))) {
+        size_t const slot = size_t(mCursor.fetch_add(1, std::memory_order_relaxed) % mCapacity);
+        Event& event = mEvents[slot];
+        event.timestampNs = uint64_t(
+                std::chrono::steady_clock::now().time_since_epoch().count());
+        event.threadId = uint32_t(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        event.type = type;
+        memset(event.reserved, 0, sizeof(event.reserved));
+        event.value = value;
+        if (name) {
+            strncpy(event.name, name, Event::NAME_SIZE - 1);
+            event.name[Event::NAME_SIZE - 1] = '\0';
+        } else {
+            event.name[0] = '\0';
+        }
+    }
+    mActiveWriters.fetch_sub(1, std::memory_order_release);
+}
+
+} // namespace utils
@@ -86,6 +86,42 @@ TEST(AllocatorTest, LinearAllocator) {
 }
 
 
+TEST(AllocatorTest, MappedArea) {
+    // default options: usable as a drop-in replacement for HeapArea
+    AreaPolicy::MappedArea area(1024 * 1024);
+    ASSERT_NE(nullptr, area.data());
+    EXPECT_GE(area.size(), size_t(1024 * 1024));
+    EXPECT_EQ(uintptr_t(area.end()), uintptr_t(area.begin()) + area.size());
+
+    // the area must be writable end-to-end
+    memset(area.data(), 0xa5, area.size());
+
+    // hugepage backing and pre-faulting are advisory, but must always yield a usable area
+    AreaPolicy::MappedArea hugeArea(4 * 1024 * 1024, { .hugePages = true, .preFault = true });
+    ASSERT_NE(nullptr, hugeArea.data());
+    EXPECT_GE(hugeArea.size(), size_t(4 * 1024 * 1024));
+    memset(hugeArea.data(), 0x5a, hugeArea.size());
+
+    // an empty area is valid
+    AreaPolicy::MappedArea emptyArea;
+    EXPECT_EQ(nullptr, emptyArea.data());
+    EXPECT_EQ(size_t(0), emptyArea.size());
+}
+
+TEST(AllocatorTest, HighWatermarkPerFrame) {
+    Arena<LinearAllocator, LockingPolicy::NoLock,
+            TrackingPolicy::HighWatermark, AreaPolicy::MappedArea> arena("test arena", 4096);
+
+    arena.alloc(1024, 1, 0);
+    EXPECT_EQ(1024u, arena.getListener().getHighWatermark());
+
+    // sampling returns the peak and restarts tracking from the current usage
+    EXPECT_EQ(1024u, arena.getListener().getAndResetHighWatermark());
+    arena.rewind(arena.getArea().begin());
+    arena.alloc(256, 1, 0);
+    EXPECT_EQ(256u, arena.getListener().getAndResetHighWatermark());
+}
+
 TEST(AllocatorTest, PoolAllocator) {
     char scratch[1024 + 31];
     void* p = nullptr;
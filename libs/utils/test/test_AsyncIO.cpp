@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/AsyncIO.h>
+#include <utils/CountDownLatch.h>
+#include <utils/Path.h>
+
+#include <atomic>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace utils;
+
+namespace {
+
+class AsyncIOTest : public testing::Test {
+protected:
+    void SetUp() override {
+        mPath = Path::getTemporaryDirectory() + "asyncio_test.bin";
+        mContent.resize(1u << 20);
+        for (size_t i = 0; i < mContent.size(); i++) {
+            mContent[i] = uint8_t(i * 31 + (i >> 8));
+        }
+        FILE* const f = fopen(mPath.c_str(), "wb");
+        ASSERT_NE(f, nullptr);
+        ASSERT_EQ(fwrite(mContent.data(), 1, mContent.size(), f), mContent.size());
+        fclose(f);
+#if defined(WIN32)
+        mFd = _open(mPath.c_str(), _O_RDONLY | _O_BINARY);
+#else
+        mFd = open(mPath.c_str(), O_RDONLY);
+#endif
+        ASSERT_GE(mFd, 0);
+    }
+
+    void TearDown() override {
+        if (mFd >= 0) {
+#if defined(WIN32)
+            _close(mFd);
+#else
+            close(mFd);
+#endif
+        }
+        mPath.unlinkFile();
+    }
+
+    Path mPath;
+    std::vector<uint8_t> mContent;
+    int mFd = -1;
+};
+
+TEST_F(AsyncIOTest, SingleRead) {
+    std::vector<uint8_t> out(4096);
+    CountDownLatch latch(1);
+    std::atomic<ssize_t> result{ 0 };
+    AsyncIO::get().read(mFd, 8192, out.data(), out.size(), [&](ssize_t bytesRead) {
+        result = bytesRead;
+        latch.latch();
+    });
+    latch.await();
+    EXPECT_EQ(result.load(), ssize_t(out.size()));
+    EXPECT_TRUE(!memcmp(out.data(), mContent.data() + 8192, out.size()));
+}
+
+TEST_F(AsyncIOTest, ScatterRead) {
+    std::vector<uint8_t> a(1000), b(24), c(65536);
+    AsyncIO::Buffer const buffers[3] = {
+        { a.data(), a.size() }, { b.data(), b.size() }, { c.data(), c.size() },
+    };
+    CountDownLatch latch(1);
+    std::atomic<ssize_t> result{ 0 };
+    AsyncIO::get().read(mFd, 512, buffers, 3, [&](ssize_t bytesRead) {
+        result = bytesRead;
+        latch.latch();
+    });
+    latch.await();
+    EXPECT_EQ(result.load(), ssize_t(a.size() + b.size() + c.size()));
+    EXPECT_TRUE(!memcmp(a.data(), mContent.data() + 512, a.size()));
+    EXPECT_TRUE(!memcmp(b.data(), mContent.data() + 512 + 1000, b.size()));
+    EXPECT_TRUE(!memcmp(c.data(), mContent.data() + 512 + 1024, c.size()));
+}
+
+TEST_F(AsyncIOTest, ManyConcurrentReads) {
+    constexpr size_t READ_COUNT = 64;
+    constexpr size_t READ_SIZE = 4096;
+    std::vector<uint8_t> out(READ_COUNT * READ_SIZE);
+    CountDownLatch latch(READ_COUNT);
+    std::atomic<size_t> failures{ 0 };
+    for (size_t i = 0; i < READ_COUNT; i++) {
+        AsyncIO::get().read(mFd, int64_t(i * READ_SIZE), out.data() + i * READ_SIZE, READ_SIZE,
+                [&latch, &failures](ssize_t bytesRead) {
+                    if (bytesRead != READ_SIZE) {
+                        failures++;
+                    }
+                    latch.latch();
+                });
+    }
+    latch.await();
+    EXPECT_EQ(failures.load(), 0u);
+    EXPECT_TRUE(!memcmp(out.data(), mContent.data(), out.size()));
+}
+
+TEST_F(AsyncIOTest, ReadPastEndOfFile) {
+    std::vector<uint8_t> out(4096);
+    CountDownLatch latch(1);
+    std::atomic<ssize_t> result{ -1 };
+    AsyncIO::get().read(mFd, int64_t(mContent.size()) - 100, out.data(), out.size(),
+            [&](ssize_t bytesRead) {
+                result = bytesRead;
+                latch.latch();
+            });
+    latch.await();
+    EXPECT_EQ(result.load(), 100);
+}
+
+TEST_F(AsyncIOTest, JobChaining) {
+    // two adoptable slots: this thread and the AsyncIO job-runner thread
+    JobSystem js(2, 2);
+    js.adopt();
+    std::vector<uint8_t> out(4096);
+    AsyncIO::Buffer const buffer = { out.data(), out.size() };
+    std::atomic_bool done{ false };
+    JobSystem::Job* job = js.createJob(nullptr,
+            [&done](JobSystem&, JobSystem::Job*) { done = true; });
+    job = JobSystem::retain(job);
+    AsyncIO::get().read(mFd, 0, &buffer, 1, js, job);
+    js.waitAndRelease(job);
+    EXPECT_TRUE(done.load());
+    EXPECT_TRUE(!memcmp(out.data(), mContent.data(), out.size()));
+    js.emancipate();
+}
+
+} // anonymous namespace
@@ -17,6 +17,9 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <set>
+#include <thread>
+#include <vector>
 
 #include "../src/EntityManagerImpl.h"
 #include <utils/NameComponentManager.h>
@@ -90,11 +93,55 @@ TEST(EntityTest, Free) {
     em.destroy(1024, entities);
 
     // now we have 1024 entities in the free list, we're going to start reusing them
-    // using a new generation
+    // using a new generation (reuse order is unspecified)
 
     Entity e = em.create();
-    // generation=1, index=1
-    EXPECT_EQ(EntityManagerImpl::makeIdentity(1, 1), e.getId());
+    EXPECT_TRUE(em.isAlive(e));
+    EXPECT_EQ(1, EntityManagerImpl::getGeneration(e));
+    EXPECT_GE(EntityManagerImpl::getIndex(e), 1);
+    EXPECT_LE(EntityManagerImpl::getIndex(e), 1024);
+}
+
+TEST(EntityTest, Concurrent) {
+    EntityManagerImpl em;
+
+    // churn entities from several threads at once; this exercises the per-thread
+    // free-list magazines and the shared lock-free list they spill into
+    constexpr size_t THREAD_COUNT = 4;
+    constexpr size_t ITERATIONS = 10000;
+    std::vector<std::thread> threads;
+    threads.reserve(THREAD_COUNT);
+    for (size_t t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&em]() {
+            Entity entities[16];
+            for (size_t i = 0; i < ITERATIONS; i++) {
+                em.create(16, entities);
+                for (auto const& e : entities) {
+                    EXPECT_FALSE(e.isNull());
+                    EXPECT_TRUE(em.isAlive(e));
+                }
+                em.destroy(16, entities);
+                for (auto const& e : entities) {
+                    EXPECT_FALSE(em.isAlive(e));
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(0, em.getEntityCount());
+
+    // all live entities must still be unique
+    Entity entities[1024];
+    em.create(1024, entities);
+    std::set<uint32_t> ids;
+    for (auto const& e : entities) {
+        EXPECT_TRUE(em.isAlive(e));
+        ids.insert(e.getId());
+    }
+    EXPECT_EQ(1024, ids.size());
+    em.destroy(1024, entities);
 }
 
 TEST(EntityTest, Lots) {
@@ -342,5 +342,126 @@ TEST(JobSystem, JobSystemDelegates) {
     EXPECT_EQ(4, functor.result);
 
 
+    js.emancipate();
+}
+
+TEST(JobSystem, JobSystemContinuations) {
+    JobSystem js;
+    js.adopt();
+
+    std::atomic_int stage = {0};
+
+    // each stage only advances the counter if the previous stage has completed
+    JobSystem::Job* first = js.createJob(nullptr, [&stage](JobSystem&, JobSystem::Job*) {
+        int expected = 0;
+        stage.compare_exchange_strong(expected, 1);
+    });
+    JobSystem::Job* second = js.createJob(nullptr, [&stage](JobSystem&, JobSystem::Job*) {
+        int expected = 1;
+        stage.compare_exchange_strong(expected, 2);
+    });
+    JobSystem::Job* third = js.createJob(nullptr, [&stage](JobSystem&, JobSystem::Job*) {
+        int expected = 2;
+        stage.compare_exchange_strong(expected, 3);
+    });
+
+    JobSystem::Job* last = js.retain(third);
+    js.runOnCompletion(second, third);
+    js.runOnCompletion(first, second);
+    js.run(first);
+    js.waitAndRelease(last);
+
+    EXPECT_EQ(3, stage.load());
+
+    js.emancipate();
+}
+
+TEST(JobSystem, JobSystemWorkerMetricsAndGovernor) {
+    JobSystem js;
+    js.adopt();
+
+    // shrink the pool to a single active worker; jobs must still all complete
+    js.setActiveThreadCount(1);
+    EXPECT_EQ(size_t(1), js.getActiveThreadCount());
+
+    std::atomic_int counter = {0};
+    JobSystem::Job* root = js.createJob();
+    for (int i = 0; i < 256; i++) {
+        js.run(js.createJob(root, [&counter](JobSystem&, JobSystem::Job*) {
+            counter++;
+        }));
+    }
+    js.runAndWait(root);
+    EXPECT_EQ(256, counter.load());
+
+    // restore the full pool and run another batch
+    js.setActiveThreadCount(js.getThreadCount());
+    EXPECT_EQ(js.getThreadCount(), js.getActiveThreadCount());
+
+    root = js.createJob();
+    for (int i = 0; i < 256; i++) {
+        js.run(js.createJob(root, [&counter](JobSystem&, JobSystem::Job*) {
+            counter++;
+        }));
+    }
+    js.runAndWait(root);
+    EXPECT_EQ(512, counter.load());
+
+    // every executed job shows up in exactly one worker's counters
+    uint64_t executed = 0;
+    uint64_t stolen = 0;
+    for (size_t i = 0, n = js.getWorkerCount(); i < n; i++) {
+        JobSystem::WorkerMetrics const metrics = js.getWorkerMetrics(i);
+        executed += metrics.jobsExecuted;
+        stolen += metrics.jobsStolen;
+    }
+    EXPECT_EQ(uint64_t(512 + 2), executed);     // 512 children + the two root jobs
+    EXPECT_LE(stolen, executed);
+
+    js.emancipate();
+}
+
+TEST(JobSystem, JobSystemWorkerProfiling) {
+    JobSystem js;
+    js.adopt();
+
+    js.enableWorkerProfiling(Profiler::EV_L1D_RATES | Profiler::EV_BPU_RATES);
+
+    std::atomic_int counter = {0};
+    JobSystem::Job* root = js.createJob();
+    for (int i = 0; i < 64; i++) {
+        js.run(js.createJob(root, [&counter](JobSystem&, JobSystem::Job*) {
+            counter++;
+        }));
+    }
+    js.runAndWait(root);
+    EXPECT_EQ(64, counter.load());
+
+    js.disableWorkerProfiling();
+
+    // PMU access may be restricted (e.g. perf_event_paranoid), in which case the counters
+    // simply stay at zero
+    auto sumCounters = [&js]() {
+        uint64_t sum = 0;
+        for (size_t i = 0, n = js.getWorkerCount(); i < n; i++) {
+            JobSystem::WorkerMetrics const metrics = js.getWorkerMetrics(i);
+            sum += metrics.cacheReferences + metrics.cacheMisses +
+                   metrics.branches + metrics.branchMisses;
+        }
+        return sum;
+    };
+    uint64_t const afterDisable = sumCounters();
+
+    // once disabled, running more jobs doesn't accumulate counters
+    root = js.createJob();
+    for (int i = 0; i < 64; i++) {
+        js.run(js.createJob(root, [&counter](JobSystem&, JobSystem::Job*) {
+            counter++;
+        }));
+    }
+    js.runAndWait(root);
+    EXPECT_EQ(128, counter.load());
+    EXPECT_EQ(afterDisable, sumCounters());
+
     js.emancipate();
 }
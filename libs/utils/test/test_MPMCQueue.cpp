@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/MPMCQueue.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace utils;
+
+TEST(MPMCQueue, SingleThreaded) {
+    MPMCQueue<int, 16> queue;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(16u, queue.capacity());
+
+    // simple push/pop
+    EXPECT_TRUE(queue.tryPush(42));
+    EXPECT_EQ(1u, queue.size());
+    int v = 0;
+    EXPECT_TRUE(queue.tryPop(v));
+    EXPECT_EQ(42, v);
+    EXPECT_TRUE(queue.empty());
+
+    // popping an empty queue fails
+    EXPECT_FALSE(queue.tryPop(v));
+
+    // fill up to capacity, FIFO order
+    for (int i = 0; i < 16; i++) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(16));
+    for (int i = 0; i < 16; i++) {
+        EXPECT_TRUE(queue.tryPop(v));
+        EXPECT_EQ(i, v);
+    }
+    EXPECT_FALSE(queue.tryPop(v));
+
+    // wrap around the ring a few times
+    for (int lap = 0; lap < 5; lap++) {
+        for (int i = 0; i < 12; i++) {
+            EXPECT_TRUE(queue.tryPush(lap * 12 + i));
+        }
+        for (int i = 0; i < 12; i++) {
+            EXPECT_TRUE(queue.tryPop(v));
+            EXPECT_EQ(lap * 12 + i, v);
+        }
+    }
+}
+
+TEST(MPMCQueue, ConcurrentProducersConsumers) {
+    constexpr int PRODUCERS = 4;
+    constexpr int CONSUMERS = 4;
+    constexpr int ITEMS_PER_PRODUCER = 10000;
+
+    MPMCQueue<int, 64> queue;
+    std::atomic<long long> sum = { 0 };
+    std::atomic_int popped = { 0 };
+
+    std::vector<std::thread> threads;
+    threads.reserve(PRODUCERS + CONSUMERS);
+    for (int p = 0; p < PRODUCERS; p++) {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < ITEMS_PER_PRODUCER; i++) {
+                queue.push(p * ITEMS_PER_PRODUCER + i);
+            }
+        });
+    }
+    for (int c = 0; c < CONSUMERS; c++) {
+        threads.emplace_back([&queue, &sum, &popped]() {
+            for (;;) {
+                if (popped.fetch_add(1) >= PRODUCERS * ITEMS_PER_PRODUCER) {
+                    return;
+                }
+                sum.fetch_add(queue.pop());
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // every item was popped exactly once
+    constexpr long long N = PRODUCERS * ITEMS_PER_PRODUCER;
+    EXPECT_EQ(N * (N - 1) / 2, sum.load());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MPMCQueue, BlockingFallback) {
+    // a tiny queue so both the full and empty blocking paths are exercised
+    MPMCQueue<int, 2> queue;
+
+    std::atomic_int consumed = { 0 };
+    std::thread producer([&queue]() {
+        for (int i = 0; i < 1000; i++) {
+            queue.push(i);        // blocks whenever the consumer lags behind
+        }
+    });
+    std::thread consumer([&queue, &consumed]() {
+        for (int i = 0; i < 1000; i++) {
+            EXPECT_EQ(i, queue.pop());  // blocks whenever the producer lags behind
+            consumed++;
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    EXPECT_EQ(1000, consumed.load());
+    EXPECT_TRUE(queue.empty());
+}
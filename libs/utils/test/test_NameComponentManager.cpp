@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/EntityManager.h>
+#include <utils/NameComponentManager.h>
+
+using namespace utils;
+
+TEST(NameComponentManager, LookupByName) {
+    EntityManager& em = EntityManager::get();
+    NameComponentManager names(em);
+
+    Entity entities[3];
+    em.create(3, entities);
+    for (Entity e : entities) {
+        names.addComponent(e);
+    }
+
+    names.setName(names.getInstance(entities[0]), "wheel");
+    names.setName(names.getInstance(entities[1]), "wheel");
+    names.setName(names.getInstance(entities[2]), "chassis");
+
+    EXPECT_EQ(entities[2], names.getFirstEntityByName("chassis"));
+    EXPECT_TRUE(names.getFirstEntityByName("spoiler").isNull());
+    EXPECT_TRUE(names.getFirstEntityByName(nullptr).isNull());
+
+    // passing nullptr only counts the entities
+    EXPECT_EQ(2u, names.getEntitiesByName("wheel", nullptr, 0));
+
+    Entity wheels[4] = {};
+    EXPECT_EQ(2u, names.getEntitiesByName("wheel", wheels, 4));
+    EXPECT_TRUE((wheels[0] == entities[0] && wheels[1] == entities[1]) ||
+                (wheels[0] == entities[1] && wheels[1] == entities[0]));
+
+    // maxCount truncates
+    EXPECT_EQ(1u, names.getEntitiesByName("wheel", wheels, 1));
+
+    // renaming moves the entity between buckets
+    names.setName(names.getInstance(entities[0]), "chassis");
+    EXPECT_EQ(1u, names.getEntitiesByName("wheel", nullptr, 0));
+    EXPECT_EQ(2u, names.getEntitiesByName("chassis", nullptr, 0));
+
+    // removing the component removes it from the index
+    names.removeComponent(entities[1]);
+    EXPECT_EQ(0u, names.getEntitiesByName("wheel", nullptr, 0));
+    EXPECT_TRUE(names.getFirstEntityByName("wheel").isNull());
+
+    for (Entity e : entities) {
+        names.removeComponent(e);
+    }
+    em.destroy(3, entities);
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/StringInterner.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <string.h>
+
+using namespace utils;
+
+TEST(StringInterner, Interning) {
+    StringInterner table;
+
+    InternedString const a = table.intern("hello");
+    InternedString const b = table.intern("hello");
+    InternedString const c = table.intern("world");
+
+    // equal content yields the same characters, so comparisons are pointer equality
+    EXPECT_EQ(a.c_str(), b.c_str());
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(2u, table.size());
+
+    EXPECT_STREQ("hello", a.c_str());
+    EXPECT_STREQ("world", c.c_str());
+    EXPECT_EQ(5u, a.size());
+
+    // the copy is null-terminated even when interned from a counted range
+    char const raw[] = { 'h', 'e', 'l', 'l', 'o', '!', '!' };
+    InternedString const d = table.intern(raw, 5);
+    EXPECT_EQ(a, d);
+    EXPECT_EQ('\0', a.c_str()[5]);
+
+    // empty and null are handled
+    InternedString const empty = table.intern("");
+    EXPECT_TRUE(empty.empty());
+    InternedString const null = table.intern(nullptr);
+    EXPECT_TRUE(null.empty());
+    EXPECT_EQ(nullptr, null.c_str());
+
+    // a string larger than the internal block size gets its own storage
+    std::string const big(100000, 'x');
+    InternedString const e = table.intern(big.c_str());
+    EXPECT_EQ(big.size(), e.size());
+    EXPECT_EQ(0, memcmp(big.data(), e.data(), e.size()));
+}
+
+TEST(StringInterner, ConcurrentInterning) {
+    StringInterner table;
+
+    constexpr int THREADS = 4;
+    constexpr int STRINGS = 1000;
+
+    // all threads intern the same set of strings; each string must end up in the
+    // table exactly once
+    std::vector<std::thread> threads;
+    std::vector<std::vector<InternedString>> results(THREADS);
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&table, &results, t]() {
+            results[t].reserve(STRINGS);
+            for (int i = 0; i < STRINGS; i++) {
+                results[t].push_back(table.intern(std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(size_t(STRINGS), table.size());
+    for (int t = 1; t < THREADS; t++) {
+        for (int i = 0; i < STRINGS; i++) {
+            EXPECT_EQ(results[0][i], results[t][i]);
+        }
+    }
+}
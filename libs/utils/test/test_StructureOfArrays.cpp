@@ -16,9 +16,12 @@
 
 #include <gtest/gtest.h>
 
+#include <utils/JobSystem.h>
 #include <utils/StructureOfArrays.h>
 #include <math/vec4.h>
 
+#include <atomic>
+
 using namespace filament::math;
 using namespace utils;
 
@@ -183,3 +186,42 @@ TEST(StructureOfArraysTest, MoveOnly) {
     EXPECT_EQ(*soa.elementAt<1>(1).get(), 2);
 }
 
+
+TEST(StructureOfArraysTest, ColumnAlignment) {
+    SoA soa;
+    soa.setCapacity(101); // odd on purpose, padding must still align the columns
+    soa.resize(101);
+    EXPECT_EQ(uintptr_t(soa.data<0>()) % CACHELINE_SIZE, 0u);
+    EXPECT_EQ(uintptr_t(soa.data<1>()) % CACHELINE_SIZE, 0u);
+    EXPECT_EQ(uintptr_t(soa.data<2>()) % CACHELINE_SIZE, 0u);
+}
+
+TEST(StructureOfArraysTest, ForEachParallel) {
+    JobSystem js;
+    js.adopt();
+
+    constexpr size_t COUNT = 10000;
+    StructureOfArrays<float, double> soa;
+    soa.setCapacity(COUNT);
+    soa.resize(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        soa.elementAt<0>(i) = float(i);
+    }
+
+    std::atomic<size_t> calls{ 0 };
+    soa.forEachParallel<0, 1>(js, [&soa, &calls](size_t i) {
+        soa.elementAt<1>(i) = soa.elementAt<0>(i) * 2.0;
+        calls.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    EXPECT_EQ(calls.load(), COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        EXPECT_EQ(soa.elementAt<1>(i), double(i) * 2.0);
+    }
+
+    // an empty range must not call the functor
+    StructureOfArrays<int> empty;
+    empty.forEachParallel(js, [](size_t) { FAIL(); });
+
+    js.emancipate();
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <private/utils/TraceRecorder.h>
+
+#include <vector>
+
+#include <string.h>
+
+using namespace utils;
+
+TEST(TraceRecorder, Session) {
+    TraceRecorder& recorder = TraceRecorder::get();
+    EXPECT_FALSE(TraceRecorder::isRecording());
+
+    // events emitted outside a session go nowhere
+    recorder.counter("ignored", 1);
+
+    std::vector<TraceRecorder::Event> buffer(16);
+    recorder.start(buffer.data(), buffer.size() * sizeof(TraceRecorder::Event));
+    EXPECT_TRUE(TraceRecorder::isRecording());
+
+    recorder.frame(7);
+    recorder.beginZone("zone");
+    recorder.counter("value", -42);
+    recorder.endZone();
+
+    size_t const count = recorder.stop();
+    EXPECT_FALSE(TraceRecorder::isRecording());
+    ASSERT_EQ(4u, count);
+
+    EXPECT_EQ(TraceRecorder::FRAME, buffer[0].type);
+    EXPECT_EQ(7, buffer[0].value);
+
+    EXPECT_EQ(TraceRecorder::BEGIN, buffer[1].type);
+    EXPECT_STREQ("zone", buffer[1].name);
+
+    EXPECT_EQ(TraceRecorder::COUNTER, buffer[2].type);
+    EXPECT_STREQ("value", buffer[2].name);
+    EXPECT_EQ(-42, buffer[2].value);
+
+    EXPECT_EQ(TraceRecorder::END, buffer[3].type);
+
+    // same thread, monotonic timestamps
+    EXPECT_EQ(buffer[0].threadId, buffer[3].threadId);
+    EXPECT_LE(buffer[0].timestampNs, buffer[3].timestampNs);
+
+    // stopping again is a no-op
+    EXPECT_EQ(0u, recorder.stop());
+}
+
+TEST(TraceRecorder, WrapAround) {
+    TraceRecorder& recorder = TraceRecorder::get();
+
+    std::vector<TraceRecorder::Event> buffer(4);
+    recorder.start(buffer.data(), buffer.size() * sizeof(TraceRecorder::Event));
+    for (int64_t i = 0; i < 10; i++) {
+        recorder.counter("i", i);
+    }
+    size_t const count = recorder.stop();
+    EXPECT_EQ(10u, count);
+
+    // the buffer holds the 4 most recent events; the oldest is at (count % capacity)
+    for (size_t i = 0; i < buffer.size(); i++) {
+        size_t const slot = (count + i) % buffer.size();
+        EXPECT_EQ(int64_t(count - buffer.size() + i), buffer[slot].value);
+    }
+}
+
+TEST(TraceRecorder, NameTruncation) {
+    TraceRecorder& recorder = TraceRecorder::get();
+
+    std::vector<TraceRecorder::Event> buffer(1);
+    recorder.start(buffer.data(), buffer.size() * sizeof(TraceRecorder::Event));
+    char longName[128];
+    memset(longName, 'a', sizeof(longName) - 1);
+    longName[sizeof(longName) - 1] = '\0';
+    recorder.beginZone(longName);
+    recorder.stop();
+
+    // truncated but still null-terminated
+    EXPECT_EQ(TraceRecorder::Event::NAME_SIZE - 1, strlen(buffer[0].name));
+}
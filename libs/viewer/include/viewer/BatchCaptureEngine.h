@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIEWER_BATCH_CAPTURE_ENGINE_H
+#define VIEWER_BATCH_CAPTURE_ENGINE_H
+
+#include <viewer/AutomationEngine.h>
+
+#include <math/vec3.h>
+
+#include <utils/Entity.h>
+
+#include <string>
+#include <vector>
+
+namespace filament {
+
+class Engine;
+class Renderer;
+class RenderTarget;
+class Scene;
+class Texture;
+class View;
+
+namespace viewer {
+
+/**
+ * The BatchCaptureEngine renders one scene from a list of camera poses into off-screen views
+ * and writes each image to disk. It is meant for headless dataset rendering, where throughput
+ * matters and there is no window to present to.
+ *
+ * Unlike the AutomationEngine, which steps through settings permutations one frame at a time,
+ * the capture engine creates several off-screen views with independent cameras and round-robins
+ * the pending poses across them: every tick() renders up to viewCount poses and queues an
+ * asynchronous readback for each, so the GPU renders the next batch while the previous
+ * readbacks are still in flight.
+ *
+ * Clients own the Engine, Renderer, Scene and the render loop. Call start() once the scene is
+ * fully loaded, then call tick() between Renderer::beginFrame() and Renderer::endFrame() until
+ * shouldClose() returns true (a headless SwapChain works fine for this). Finally call
+ * terminate() to destroy the off-screen views.
+ *
+ * The pose list can be built in code or parsed from a JSON spec, for example:
+ *
+ * {
+ *   "resolution": [1920, 1080],
+ *   "viewCount": 4,
+ *   "outputPrefix": "pose_",
+ *   "format": "tiff",
+ *   "fovDegrees": 45.0,
+ *   "near": 0.1,
+ *   "far": 1000.0,
+ *   "poses": [
+ *     { "eye": [0.0, 1.0, 5.0], "center": [0.0, 0.0, 0.0], "up": [0.0, 1.0, 0.0] },
+ *     { "eye": [5.0, 1.0, 0.0], "center": [0.0, 0.0, 0.0] }
+ *   ]
+ * }
+ */
+class UTILS_PUBLIC BatchCaptureEngine {
+public:
+    using ExportFormat = AutomationEngine::Options::ExportFormat;
+
+    struct Options {
+        /** Dimensions of the off-screen views, in pixels. */
+        uint32_t width = 1024;
+        uint32_t height = 1024;
+
+        /** Number of off-screen views rendered per tick. */
+        uint32_t viewCount = 4;
+
+        /** Prefix for the exported image files; the pose index and extension are appended. */
+        std::string outputPrefix = "capture_";
+
+        /** Which image format will be used for exporting the captures. */
+        ExportFormat exportFormat = ExportFormat::TIFF;
+
+        /** If true, capture progress is dumped to the utils Log (info priority). */
+        bool verbose = true;
+    };
+
+    /**
+     * A single camera pose; the projection parameters are shared by all poses (see Options).
+     */
+    struct CameraPose {
+        math::float3 eye;
+        math::float3 center;
+        math::float3 up = { 0.0f, 1.0f, 0.0f };
+    };
+
+    /**
+     * Creates a capture engine from a JSON string (see the schema above).
+     * Returns null if the JSON could not be parsed; clients should release with "delete".
+     */
+    static BatchCaptureEngine* createFromJSON(const char* jsonSpec, size_t size);
+
+    BatchCaptureEngine(Options const& options, std::vector<CameraPose> poses)
+            : mOptions(options), mPoses(std::move(poses)) {}
+
+    ~BatchCaptureEngine();
+
+    /**
+     * Creates the off-screen views, render targets and cameras, and attaches them to the
+     * given scene. Call this once, after the scene has finished loading.
+     */
+    void start(Engine* engine, Scene* scene);
+
+    /**
+     * Renders the next batch of poses and queues one readback per rendered view.
+     *
+     * Must be called between Renderer::beginFrame() and Renderer::endFrame(), from the
+     * Engine's main thread.
+     */
+    void tick(Engine* engine, Renderer* renderer);
+
+    /**
+     * Returns true once every pose has been rendered and every capture has been written.
+     */
+    bool shouldClose() const { return mShouldClose; }
+
+    /**
+     * Cancels pending captures and destroys the off-screen views. Safe to call at any point
+     * after start().
+     */
+    void terminate(Engine* engine);
+
+    /** Shared vertical field of view, in degrees. */
+    void setFov(double fovDegrees) { mFovDegrees = fovDegrees; }
+
+    /** Shared near and far clipping planes, in world units. */
+    void setClipPlanes(double near, double far) { mNear = near; mFar = far; }
+
+    Options const& getOptions() const { return mOptions; }
+    size_t currentPose() const { return mNextPose; }
+    size_t poseCount() const { return mPoses.size(); }
+    bool isTerminated() const { return mTerminated; }
+
+public:
+    // For internal use from a readback callback.
+    void onCaptureCompleted();
+
+private:
+    struct CaptureView {
+        View* view = nullptr;
+        RenderTarget* renderTarget = nullptr;
+        Texture* color = nullptr;
+        Texture* depth = nullptr;
+        utils::Entity cameraEntity;
+    };
+
+    Options const mOptions;
+    std::vector<CameraPose> const mPoses;
+    std::vector<CaptureView> mViews;
+
+    double mFovDegrees = 45.0;
+    double mNear = 0.1;
+    double mFar = 1000.0;
+
+    size_t mNextPose = 0;
+    size_t mPendingCaptures = 0;
+    bool mShouldClose = false;
+    bool mTerminated = false;
+};
+
+} // namespace viewer
+} // namespace filament
+
+#endif // VIEWER_BATCH_CAPTURE_ENGINE_H
@@ -23,6 +23,9 @@
 
 #include <stddef.h>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class CivetServer;
 
@@ -48,6 +51,11 @@ struct ReceivedMessage {
 /**
  * Manages a tiny WebSocket server that can receive model data and viewer settings.
  *
+ * Material packages (messages whose label ends with ".filamat") can also be sent as chunk-level
+ * binary deltas against the previous version (see filaflat::PackageDelta); the server
+ * reconstructs the full package before handing the message to the client, so repeated shader
+ * edits only ship the chunks that actually changed.
+ *
  * Client apps can call peekReceivedMessage to check for new data, or acquireReceivedMessage
  * to pop it off the small internal queue. When they are done examining the message contents
  * they should call releaseReceivedMessage.
@@ -91,6 +99,7 @@ private:
     static const size_t kMessageCapacity = 4;
     ReceivedMessage* mReceivedMessages[kMessageCapacity] = {};
     ReceivedMessage* mIncomingMessage = nullptr;
+    std::unordered_map<std::string, std::vector<char>> mPackageHistory;
     JsonSerializer mSerializer;
     mutable std::mutex mReceivedMessagesMutex;
     friend class MessageReceiver;
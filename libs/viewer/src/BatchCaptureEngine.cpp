@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define JSMN_HEADER
+
+#include <viewer/BatchCaptureEngine.h>
+
+#include "Settings_generated.h"
+#include "TIFFExport.h"
+#include "jsonParseUtils.h"
+
+#include <filament/Camera.h>
+#include <filament/Engine.h>
+#include <filament/RenderTarget.h>
+#include <filament/Renderer.h>
+#include <filament/Texture.h>
+#include <filament/View.h>
+#include <filament/Viewport.h>
+
+#include <backend/PixelBufferDescriptor.h>
+
+#include <utils/EntityManager.h>
+#include <utils/Log.h>
+#include <utils/Path.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <math.h>
+
+using namespace utils;
+
+namespace filament {
+namespace viewer {
+
+struct CaptureState {
+    std::string filename;
+    uint32_t width;
+    uint32_t height;
+    BatchCaptureEngine* engine;
+};
+
+static void convertRGBAtoRGB(void* buffer, uint32_t width, uint32_t height) {
+    uint8_t* writePtr = static_cast<uint8_t*>(buffer);
+    uint8_t const* readPtr = static_cast<uint8_t const*>(buffer);
+    for (uint32_t i = 0, n = width * height; i < n; ++i) {
+        writePtr[0] = readPtr[0];
+        writePtr[1] = readPtr[1];
+        writePtr[2] = readPtr[2];
+        writePtr += 3;
+        readPtr += 4;
+    }
+}
+
+static void exportCapture(void* buffer, const CaptureState& state, std::ofstream& outstream) {
+    Path out(state.filename);
+    auto extension = out.getExtension();
+    if (extension == "ppm") {
+        // ReadPixels on Metal only supports RGBA, but the PPM format only supports RGB.
+        convertRGBAtoRGB(buffer, state.width, state.height);
+        outstream << "P6 " << state.width << " " << state.height << " " << 255 << std::endl;
+        outstream.write(static_cast<char*>(buffer), state.width * state.height * 3);
+    } else if (extension == "tif" || extension == "tiff") {
+        exportTIFF(buffer, state.width, state.height, outstream);
+    } else {
+        slog.e << out.c_str() << " does not specify a supported file extension." << io::endl;
+    }
+}
+
+using ExportFormat = BatchCaptureEngine::ExportFormat;
+constexpr char const* getExportFormatExtension(ExportFormat format) {
+    switch (format) {
+        case ExportFormat::PPM: return ".ppm";
+        case ExportFormat::TIFF: return ".tif";
+    }
+}
+
+static int parse(jsmntok_t const* tokens, int i, const char* jsonChunk,
+        BatchCaptureEngine::CameraPose* out) {
+    CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+    int size = tokens[i++].size;
+    for (int j = 0; j < size && i >= 0; ++j) {
+        const jsmntok_t tok = tokens[i];
+        CHECK_KEY(tok);
+        if (0 == compare(tok, jsonChunk, "eye")) {
+            i = parse(tokens, i + 1, jsonChunk, &out->eye);
+        } else if (0 == compare(tok, jsonChunk, "center")) {
+            i = parse(tokens, i + 1, jsonChunk, &out->center);
+        } else if (0 == compare(tok, jsonChunk, "up")) {
+            i = parse(tokens, i + 1, jsonChunk, &out->up);
+        } else {
+            slog.w << "Invalid pose key: '" << STR(tok, jsonChunk) << "'" << io::endl;
+            i = parse(tokens, i + 1);
+        }
+    }
+    return i;
+}
+
+BatchCaptureEngine* BatchCaptureEngine::createFromJSON(const char* jsonSpec, size_t size) {
+    jsmn_parser parser = { 0, 0, 0 };
+
+    int tokenCount = jsmn_parse(&parser, jsonSpec, size, nullptr, 0);
+    if (tokenCount <= 0) {
+        return nullptr;
+    }
+
+    jsmntok_t* tokens = (jsmntok_t*) malloc(sizeof(jsmntok_t) * tokenCount);
+    assert(tokens);
+
+    jsmn_init(&parser);
+    tokenCount = jsmn_parse(&parser, jsonSpec, size, tokens, tokenCount);
+
+    if (tokenCount <= 0 || tokens[0].type != JSMN_OBJECT) {
+        free(tokens);
+        return nullptr;
+    }
+
+    Options options;
+    std::vector<CameraPose> poses;
+    float fovDegrees = 45.0f;
+    float near = 0.1f;
+    float far = 1000.0f;
+
+    int i = 1;
+    int const fieldCount = tokens[0].size;
+    for (int j = 0; j < fieldCount && i >= 0; ++j) {
+        const jsmntok_t tok = tokens[i];
+        if (tok.type != JSMN_STRING || tok.size == 0) {
+            i = -1;
+            break;
+        }
+        if (0 == compare(tok, jsonSpec, "resolution")) {
+            float resolution[2];
+            i = parse(tokens, i + 1, jsonSpec, resolution, 2);
+            options.width = (uint32_t) resolution[0];
+            options.height = (uint32_t) resolution[1];
+        } else if (0 == compare(tok, jsonSpec, "viewCount")) {
+            i = parse(tokens, i + 1, jsonSpec, &options.viewCount);
+        } else if (0 == compare(tok, jsonSpec, "outputPrefix")) {
+            options.outputPrefix = STR(tokens[i + 1], jsonSpec);
+            i += 2;
+        } else if (0 == compare(tok, jsonSpec, "format")) {
+            options.exportFormat = 0 == compare(tokens[i + 1], jsonSpec, "ppm") ?
+                    ExportFormat::PPM : ExportFormat::TIFF;
+            i += 2;
+        } else if (0 == compare(tok, jsonSpec, "fovDegrees")) {
+            i = parse(tokens, i + 1, jsonSpec, &fovDegrees);
+        } else if (0 == compare(tok, jsonSpec, "near")) {
+            i = parse(tokens, i + 1, jsonSpec, &near);
+        } else if (0 == compare(tok, jsonSpec, "far")) {
+            i = parse(tokens, i + 1, jsonSpec, &far);
+        } else if (0 == compare(tok, jsonSpec, "poses")) {
+            ++i;
+            if (tokens[i].type != JSMN_ARRAY) {
+                i = -1;
+                break;
+            }
+            int const poseCount = tokens[i++].size;
+            poses.resize(poseCount);
+            for (int k = 0; k < poseCount && i >= 0; ++k) {
+                i = parse(tokens, i, jsonSpec, &poses[k]);
+            }
+        } else {
+            slog.w << "Invalid capture key: '" << STR(tok, jsonSpec) << "'" << io::endl;
+            i = parse(tokens, i + 1);
+        }
+    }
+    free(tokens);
+
+    if (i < 0 || poses.empty()) {
+        return nullptr;
+    }
+
+    BatchCaptureEngine* result = new BatchCaptureEngine(options, std::move(poses));
+    result->setFov(fovDegrees);
+    result->setClipPlanes(near, far);
+    return result;
+}
+
+BatchCaptureEngine::~BatchCaptureEngine() = default;
+
+void BatchCaptureEngine::start(Engine* engine, Scene* scene) {
+    assert(mViews.empty());
+    const uint32_t viewCount = std::max(1u, mOptions.viewCount);
+    mViews.reserve(viewCount);
+    for (uint32_t i = 0; i < viewCount; ++i) {
+        CaptureView slot;
+        slot.color = Texture::Builder()
+                .width(mOptions.width)
+                .height(mOptions.height)
+                .levels(1)
+                .format(Texture::InternalFormat::RGBA8)
+                .usage(Texture::Usage::COLOR_ATTACHMENT)
+                .build(*engine);
+        slot.depth = Texture::Builder()
+                .width(mOptions.width)
+                .height(mOptions.height)
+                .levels(1)
+                .format(Texture::InternalFormat::DEPTH32F)
+                .usage(Texture::Usage::DEPTH_ATTACHMENT)
+                .build(*engine);
+        slot.renderTarget = RenderTarget::Builder()
+                .texture(RenderTarget::AttachmentPoint::COLOR, slot.color)
+                .texture(RenderTarget::AttachmentPoint::DEPTH, slot.depth)
+                .build(*engine);
+        slot.cameraEntity = EntityManager::get().create();
+        Camera* const camera = engine->createCamera(slot.cameraEntity);
+        slot.view = engine->createView();
+        slot.view->setViewport({ 0, 0, mOptions.width, mOptions.height });
+        slot.view->setRenderTarget(slot.renderTarget);
+        slot.view->setScene(scene);
+        slot.view->setCamera(camera);
+        mViews.push_back(slot);
+    }
+}
+
+void BatchCaptureEngine::tick(Engine* engine, Renderer* renderer) {
+    if (mTerminated || mShouldClose || mViews.empty()) {
+        return;
+    }
+
+    const int digits = (int) log10((double) mPoses.size()) + 1;
+    const double aspect = (double) mOptions.width / (double) mOptions.height;
+
+    // Round-robin the pending poses over the off-screen views. Each view gets its own
+    // readback, so the next tick can start rendering while these are still in flight.
+    for (const auto& slot : mViews) {
+        if (mNextPose >= mPoses.size()) {
+            break;
+        }
+        const size_t poseIndex = mNextPose++;
+        const CameraPose& pose = mPoses[poseIndex];
+
+        Camera* const camera = engine->getCameraComponent(slot.cameraEntity);
+        camera->setProjection(mFovDegrees, aspect, mNear, mFar, Camera::Fov::VERTICAL);
+        camera->lookAt(pose.eye, pose.center, pose.up);
+
+        renderer->render(slot.view);
+
+        std::ostringstream stringStream;
+        stringStream << mOptions.outputPrefix << std::setfill('0') << std::setw(digits)
+                << poseIndex << getExportFormatExtension(mOptions.exportFormat);
+
+        const size_t byteCount = mOptions.width * mOptions.height * 4;
+        backend::PixelBufferDescriptor buffer(
+            new uint8_t[byteCount], byteCount,
+            backend::PixelBufferDescriptor::PixelDataFormat::RGBA,
+            backend::PixelBufferDescriptor::PixelDataType::UBYTE,
+            [](void* buffer, size_t size, void* user) {
+                CaptureState* state = static_cast<CaptureState*>(user);
+                if (!state->engine->isTerminated()) {
+                    Path out(state->filename);
+                    std::ofstream outstream(out);
+                    exportCapture(buffer, *state, outstream);
+                    outstream.close();
+                    state->engine->onCaptureCompleted();
+                }
+                delete[] static_cast<uint8_t*>(buffer);
+                delete state;
+            },
+            new CaptureState { stringStream.str(), mOptions.width, mOptions.height, this }
+        );
+
+        renderer->readPixels(slot.renderTarget, 0, 0, mOptions.width, mOptions.height,
+                std::move(buffer));
+        mPendingCaptures++;
+
+        if (mOptions.verbose) {
+            slog.i << "Capturing pose " << poseIndex << " / " << mPoses.size() << io::endl;
+        }
+    }
+}
+
+void BatchCaptureEngine::onCaptureCompleted() {
+    assert(mPendingCaptures > 0);
+    if (--mPendingCaptures == 0 && mNextPose >= mPoses.size()) {
+        mShouldClose = true;
+    }
+}
+
+void BatchCaptureEngine::terminate(Engine* engine) {
+    mTerminated = true;
+    for (const auto& slot : mViews) {
+        engine->destroy(slot.view);
+        engine->destroy(slot.renderTarget);
+        engine->destroy(slot.color);
+        engine->destroy(slot.depth);
+        engine->destroyCameraComponent(slot.cameraEntity);
+        EntityManager::get().destroy(slot.cameraEntity);
+    }
+    mViews.clear();
+}
+
+} // namespace viewer
+} // namespace filament
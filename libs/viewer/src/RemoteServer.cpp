@@ -18,6 +18,8 @@
 
 #include <CivetServer.h>
 
+#include <filaflat/PackageDelta.h>
+
 #include <utils/Log.h>
 
 #include <cstring>
@@ -119,9 +121,41 @@ void RemoteServer::setIncomingMessage(ReceivedMessage* message) {
     mIncomingMessage = message;
 }
 
+static bool isMaterialPackageLabel(const char* label) {
+    static constexpr char kSuffix[] = ".filamat";
+    const size_t length = strlen(label);
+    return length >= sizeof(kSuffix) - 1 &&
+            !strcmp(label + length - (sizeof(kSuffix) - 1), kSuffix);
+}
+
 void RemoteServer::enqueueReceivedMessage(ReceivedMessage* message) {
     std::lock_guard lock(mReceivedMessagesMutex);
 
+    // Material packages can arrive as chunk-level deltas against the previous version with the
+    // same label; reconstruct the full package before clients can see the message.
+    if (isMaterialPackageLabel(message->label)) {
+        if (filaflat::PackageDelta::isDelta(message->buffer, message->bufferByteCount)) {
+            auto const pos = mPackageHistory.find(message->label);
+            auto package = pos == mPackageHistory.end() ?
+                    utils::FixedCapacityVector<uint8_t>{} :
+                    filaflat::PackageDelta::applyDelta(
+                            pos->second.data(), pos->second.size(),
+                            message->buffer, message->bufferByteCount);
+            if (package.empty()) {
+                slog.e << "Discarding delta for '" << message->label
+                       << "', no base version to apply it to." << io::endl;
+                releaseReceivedMessage(message);
+                return;
+            }
+            delete[] message->buffer;
+            message->bufferByteCount = package.size();
+            message->buffer = new char[package.size()];
+            memcpy(message->buffer, package.data(), package.size());
+        }
+        mPackageHistory[message->label] = std::vector<char>(
+                message->buffer, message->buffer + message->bufferByteCount);
+    }
+
     // Check if any unread messages have the same label as the incoming message. If so, it is safe
     // to discard the old message and snarf its slot.
     ReceivedMessage** empty_slot = nullptr;
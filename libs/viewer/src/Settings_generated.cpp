@@ -785,6 +785,8 @@ int parse(jsmntok_t const* tokens, int i, const char* jsonChunk, TemporalAntiAli
             i = parse(tokens, i + 1, jsonChunk, &out->enabled);
         } else if (compare(tok, jsonChunk, "upscaling") == 0) {
             i = parse(tokens, i + 1, jsonChunk, &out->upscaling);
+        } else if (compare(tok, jsonChunk, "upscalingFactor") == 0) {
+            i = parse(tokens, i + 1, jsonChunk, &out->upscalingFactor);
         } else if (compare(tok, jsonChunk, "filterHistory") == 0) {
             i = parse(tokens, i + 1, jsonChunk, &out->filterHistory);
         } else if (compare(tok, jsonChunk, "filterInput") == 0) {
@@ -823,6 +825,7 @@ std::ostream& operator<<(std::ostream& out, const TemporalAntiAliasingOptions& i
         << "\"sharpness\": " << (in.sharpness) << ",\n"
         << "\"enabled\": " << to_string(in.enabled) << ",\n"
         << "\"upscaling\": " << to_string(in.upscaling) << ",\n"
+        << "\"upscalingFactor\": " << (in.upscalingFactor) << ",\n"
         << "\"filterHistory\": " << to_string(in.filterHistory) << ",\n"
         << "\"filterInput\": " << to_string(in.filterInput) << ",\n"
         << "\"useYCoCg\": " << to_string(in.useYCoCg) << ",\n"
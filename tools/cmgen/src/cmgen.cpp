@@ -29,6 +29,13 @@
 #include <image/Ktx1Bundle.h>
 #include <image/ColorTransform.h>
 
+#include <filament/Engine.h>
+#include <filament/Renderer.h>
+#include <filament/RenderTarget.h>
+#include <filament/Texture.h>
+
+#include <filament-iblprefilter/IBLPrefilterContext.h>
+
 #include <utils/JobSystem.h>
 #include <utils/Path.h>
 #include <utils/algorithm.h>
@@ -108,6 +115,8 @@ static size_t g_num_samples = 1024;
 
 static bool g_mirror = false;
 
+static bool g_gpu = false;
+
 // -----------------------------------------------------------------------------------------------
 
 static void generateMipmaps(utils::JobSystem& js, std::vector<Cubemap>& levels,
@@ -117,6 +126,8 @@ static void sphericalHarmonics(utils::JobSystem& js, const utils::Path& iname,
 static void iblRoughnessPrefilter(
         utils::JobSystem& js, const utils::Path& iname, const std::vector<Cubemap>& levels,
         bool prefilter, const utils::Path& dir);
+static bool iblRoughnessPrefilterGPU(const Cubemap& environment, size_t baseExp,
+        size_t numLevels, std::vector<Image>& images, std::vector<Cubemap>& cubemaps);
 static void iblDiffuseIrradiance(utils::JobSystem& js, const utils::Path& iname,
         const std::vector<Cubemap>& levels, const utils::Path& dir);
 static void iblMipmapPrefilter(utils::JobSystem& js, const utils::Path& iname,
@@ -196,6 +207,9 @@ static void printUsage(char* name) {
             "       Number of samples to use for IBL integrations (default 1024)\n\n"
             "   --ibl-ld=dir\n"
             "       Roughness pre-filter into <dir>\n\n"
+            "   --gpu\n"
+            "       Roughness pre-filter on the GPU using a headless Engine;\n"
+            "       falls back to the CPU filter when no GPU is available\n\n"
             "   --sh-shader\n"
             "       Generate irradiance SH for shader code\n\n"
             "\n"
@@ -270,6 +284,7 @@ static int handleCommandLineArgments(int argc, char* argv[]) {
             { "ibl-no-prefilter",           no_argument, nullptr, 'n' },
             { "ibl-min-lod-size",     required_argument, nullptr, 'S' },
             { "ibl-samples",          required_argument, nullptr, 'k' },
+            { "gpu",                        no_argument, nullptr, 'G' },
             { "deploy",               required_argument, nullptr, 'x' },
             { "no-mirror",                  no_argument, nullptr, 'm' },
             { "debug",                      no_argument, nullptr, 'd' },
@@ -442,6 +457,9 @@ static int handleCommandLineArgments(int argc, char* argv[]) {
             case 'k':
                 g_num_samples = (size_t)std::stoi(arg);
                 break;
+            case 'G':
+                g_gpu = true;
+                break;
             case 'x':
                 g_deploy = true;
                 g_deploy_dir = arg;
@@ -918,6 +936,113 @@ static float lodToPerceptualRoughness(float lod) noexcept {
             : 0.0f;
 }
 
+// Runs the specular prefilter on the GPU (the same filter used at runtime by
+// libs/iblprefilter) against a headless Engine, then reads every level back into CPU
+// cubemaps so the regular export paths below can consume them. Returns false when no
+// usable GPU is available; the caller then falls back to the CPU filter.
+bool iblRoughnessPrefilterGPU(const Cubemap& environment, size_t baseExp,
+        size_t numLevels, std::vector<Image>& images, std::vector<Cubemap>& cubemaps) {
+    using filament::Engine;
+    using filament::Renderer;
+    using filament::RenderTarget;
+    using filament::Texture;
+
+    Engine* const engine = Engine::create();
+    if (engine == nullptr) {
+        return false;
+    }
+
+    // Upload the environment; the filter generates its own mipmap chain from level 0.
+    const uint32_t srcDim = uint32_t(environment.getDimensions());
+    Texture* const source = Texture::Builder()
+            .sampler(Texture::Sampler::SAMPLER_CUBEMAP)
+            .format(Texture::InternalFormat::R11F_G11F_B10F)
+            .width(srcDim).height(srcDim)
+            .levels(0xff)
+            .build(*engine);
+    for (size_t j = 0; j < 6; j++) {
+        // ibl::Cubemap and filament cubemaps use the same face order (+x,-x,+y,-y,+z,-z)
+        Image const& face = environment.getImageForFace((Cubemap::Face)j);
+        Texture::PixelBufferDescriptor buffer(face.getData(), face.getSize(),
+                Texture::Format::RGB, Texture::Type::FLOAT, 1, 0, 0,
+                uint32_t(face.getStride()));
+        source->setImage(*engine, 0, 0, 0, uint32_t(j), srcDim, srcDim, 1, std::move(buffer));
+    }
+
+    const uint32_t dim = 1u << baseExp;
+    Texture* const filtered = Texture::Builder()
+            .sampler(Texture::Sampler::SAMPLER_CUBEMAP)
+            .format(Texture::InternalFormat::R11F_G11F_B10F)
+            .width(dim).height(dim)
+            .levels(uint8_t(numLevels))
+            .usage(Texture::Usage::COLOR_ATTACHMENT | Texture::Usage::SAMPLEABLE |
+                   Texture::Usage::BLIT_SRC)
+            .build(*engine);
+
+    {
+        IBLPrefilterContext context(*engine);
+        IBLPrefilterContext::SpecularFilter filter(context, {
+                .sampleCount = uint16_t(std::min(g_num_samples, size_t(2048))),
+                .levelCount = uint8_t(numLevels) });
+        filter(source, filtered);
+    }
+
+    // Read every face of every level back. The readbacks are asynchronous; the staging
+    // buffers are collected first and converted after flushAndWait().
+    Renderer* const renderer = engine->createRenderer();
+    std::vector<RenderTarget*> renderTargets;
+    std::vector<std::unique_ptr<float[]>> staging(numLevels * 6);
+    for (size_t level = 0; level < numLevels; level++) {
+        const uint32_t levelDim = std::max(1u, dim >> level);
+        for (size_t j = 0; j < 6; j++) {
+            RenderTarget* const rt = RenderTarget::Builder()
+                    .texture(RenderTarget::AttachmentPoint::COLOR, filtered)
+                    .mipLevel(RenderTarget::AttachmentPoint::COLOR, uint8_t(level))
+                    .face(RenderTarget::AttachmentPoint::COLOR,
+                            (Texture::CubemapFace)j)
+                    .build(*engine);
+            renderTargets.push_back(rt);
+            auto& pixels = staging[level * 6 + j];
+            pixels = std::make_unique<float[]>(size_t(levelDim) * levelDim * 4);
+            Texture::PixelBufferDescriptor buffer(pixels.get(),
+                    size_t(levelDim) * levelDim * 4 * sizeof(float),
+                    Texture::Format::RGBA, Texture::Type::FLOAT);
+            renderer->readPixels(rt, 0, 0, levelDim, levelDim, std::move(buffer));
+        }
+    }
+    engine->flushAndWait();
+
+    // Convert the RGBA readbacks to the CPU cubemap layout. readPixels() returns rows
+    // bottom-to-top (framebuffer convention), so flip vertically while dropping alpha.
+    images.resize(numLevels);
+    cubemaps.reserve(numLevels);
+    for (size_t level = 0; level < numLevels; level++) {
+        const size_t levelDim = std::max(size_t(1), size_t(dim) >> level);
+        Cubemap& dst = cubemaps.emplace_back(CubemapUtils::create(images[level], levelDim));
+        for (size_t j = 0; j < 6; j++) {
+            Image& face = dst.getImageForFace((Cubemap::Face)j);
+            float const* src = staging[level * 6 + j].get();
+            for (size_t y = 0; y < levelDim; y++) {
+                auto* row = static_cast<float3*>(face.getPixelRef(0, levelDim - 1 - y));
+                for (size_t x = 0; x < levelDim; x++) {
+                    row[x] = float3{ src[0], src[1], src[2] };
+                    src += 4;
+                }
+            }
+        }
+        dst.makeSeamless();
+    }
+
+    for (RenderTarget* const rt : renderTargets) {
+        engine->destroy(rt);
+    }
+    engine->destroy(renderer);
+    engine->destroy(filtered);
+    engine->destroy(source);
+    Engine::destroy(engine);
+    return true;
+}
+
 void iblRoughnessPrefilter(
         utils::JobSystem& js, const utils::Path& iname, const std::vector<Cubemap>& levels,
         bool prefilter, const utils::Path& dir) {
@@ -943,6 +1068,18 @@ void iblRoughnessPrefilter(
     size_t numSamples = g_num_samples;
     const size_t numLevels = (baseExp + 1) - minLod;
 
+    // When requested, try the GPU filter first; it produces all levels in one shot.
+    std::vector<Image> gpuImages;
+    std::vector<Cubemap> gpuCubemaps;
+    bool useGpu = false;
+    if (g_gpu) {
+        useGpu = iblRoughnessPrefilterGPU(levels[0], baseExp, numLevels,
+                gpuImages, gpuCubemaps);
+        if (!g_quiet && !useGpu) {
+            std::cout << "GPU prefiltering unavailable, using the CPU filter" << std::endl;
+        }
+    }
+
     // It's convenient to create an empty KTX bundle on the stack in this scope, regardless of
     // whether KTX is requested. It does not consume memory if empty.
     Ktx1Bundle container((uint32_t) numLevels, 1, true);
@@ -983,22 +1120,27 @@ void iblRoughnessPrefilter(
         Image image;
         Cubemap dst = CubemapUtils::create(image, dim);
 
-        ProgressUpdater updater(1);
-        if (!g_quiet) {
-            updater.start();
-        }
-        CubemapIBL::roughnessFilter(js, dst, levels, roughness, numSamples,
-                float3{ 1, 1, 1 }, prefilter,
-                [](size_t index, float v, void* userdata) {
-                    if (!g_quiet) {
-                        ((ProgressUpdater*) userdata)->update(index, v);
-                    }
-                }, &updater);
-        if (!g_quiet) {
-            updater.stop();
-        }
+        if (useGpu) {
+            image = std::move(gpuImages[level]);
+            dst = std::move(gpuCubemaps[level]);
+        } else {
+            ProgressUpdater updater(1);
+            if (!g_quiet) {
+                updater.start();
+            }
+            CubemapIBL::roughnessFilter(js, dst, levels, roughness, numSamples,
+                    float3{ 1, 1, 1 }, prefilter,
+                    [](size_t index, float v, void* userdata) {
+                        if (!g_quiet) {
+                            ((ProgressUpdater*) userdata)->update(index, v);
+                        }
+                    }, &updater);
+            if (!g_quiet) {
+                updater.stop();
+            }
 
-        dst.makeSeamless();
+            dst.makeSeamless();
+        }
 
         if (g_debug) {
             ImageEncoder::Format debug_format = ImageEncoder::Format::HDR;
@@ -40,6 +40,14 @@ size_t write(unsigned char* out, const vector<T>& data) {
     return data.size() * sizeof(T);
 }
 
+// Writes zero padding up to the next BLOB_ALIGNMENT boundary of the file.
+void padToAlignment(ostream& out, size_t& offset) {
+    static const char zeros[BLOB_ALIGNMENT] = {};
+    const size_t aligned = (offset + BLOB_ALIGNMENT - 1) & ~size_t(BLOB_ALIGNMENT - 1);
+    out.write(zeros, aligned - offset);
+    offset = aligned;
+}
+
 void MeshWriter::optimize(Mesh& mesh) {
     // In debug builds, non-triangular data will assert in meshopt, but we need to have
     // a safety check here anyway to prevent potential OOB reads in release builds.
@@ -175,7 +183,7 @@ bool MeshWriter::serialize(ostream& out, Mesh& mesh) {
     write(out, "FILAMESH", 8 * sizeof(char));
 
     Header header;
-    header.version = VERSION;
+    header.version = mVersion;
     header.parts = uint32_t(mesh.parts.size());
     header.aabb = aabb;
     header.flags = mFlags;
@@ -220,6 +228,11 @@ bool MeshWriter::serialize(ostream& out, Mesh& mesh) {
 
     write(out, header);
 
+    size_t offset = sizeof(MAGICID) + sizeof(Header);
+    if (mVersion >= VERSION_ALIGNED) {
+        padToAlignment(out, offset);
+    }
+
     if (mFlags & COMPRESSION) {
         write(out, &cheader, 1);
         write(out, compressedVertices.data(), compressedVertices.size());
@@ -235,6 +248,11 @@ bool MeshWriter::serialize(ostream& out, Mesh& mesh) {
         }
     }
 
+    if (mVersion >= VERSION_ALIGNED) {
+        offset += header.vertexSize;
+        padToAlignment(out, offset);
+    }
+
     if (mFlags & COMPRESSION) {
         write(out, compressedIndices.data(), compressedIndices.size());
     } else if (!hasIndex16) {
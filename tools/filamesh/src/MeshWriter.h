@@ -57,9 +57,13 @@ struct Mesh {
 
 class MeshWriter {
     uint32_t mFlags;
+    uint32_t mVersion;
     void optimize(Mesh& mesh);
 public:
-    MeshWriter(uint32_t flags) : mFlags(flags) {}
+    // Version VERSION_ALIGNED pads the vertex and index blobs to BLOB_ALIGNMENT so readers can
+    // use them in place from an mmap()'d file.
+    MeshWriter(uint32_t flags, uint32_t version = VERSION)
+            : mFlags(flags), mVersion(version) {}
     bool serialize(std::ostream&, Mesh& mesh);
 };
 
@@ -47,6 +47,7 @@ using Assimp::Importer;
 bool g_interleaved = false;
 bool g_snormUVs = false;
 bool g_compression = false;
+bool g_aligned = false;
 bool g_ignore_uv1 = false;
 
 Mesh g_mesh;
@@ -271,6 +272,9 @@ static void printUsage(const char* name) {
                     "       interleaves mesh attributes\n\n"
                     "   --compress, -c\n"
                     "       enable compression\n\n"
+                    "   --aligned, -a\n"
+                    "       write a version 2 file whose vertex/index blobs are 64-byte aligned,\n"
+                    "       allowing readers to use an mmap()'d file in place\n\n"
                     "   --ignore-uv1, -g\n"
                     "       Ignore the second set of UV coordinates\n\n"
 
@@ -295,12 +299,13 @@ static void license() {
 }
 
 static int handleArguments(int argc, char* argv[]) {
-    static constexpr const char* OPTSTR = "hilcg";
+    static constexpr const char* OPTSTR = "hilcag";
     static const struct option OPTIONS[] = {
             { "help",        no_argument, 0, 'h' },
             { "license",     no_argument, 0, 'l' },
             { "interleaved", no_argument, 0, 'i' },
             { "compress",    no_argument, 0, 'c' },
+            { "aligned",     no_argument, 0, 'a' },
             { "ignore-uv1",  no_argument, 0, 'g' },
             { 0, 0, 0, 0 }  // termination of the option list
     };
@@ -326,6 +331,9 @@ static int handleArguments(int argc, char* argv[]) {
             case 'c':
                 g_compression = true;
         break;
+            case 'a':
+                g_aligned = true;
+                break;
             case 'g':
                 g_ignore_uv1 = true;
                 break;
@@ -441,7 +449,8 @@ int main(int argc, char* argv[]) {
     if (g_compression) {
         flags |= filamesh::COMPRESSION;
     }
-    MeshWriter(flags).serialize(out, g_mesh);
+    MeshWriter(flags, g_aligned ? filamesh::VERSION_ALIGNED : filamesh::VERSION)
+            .serialize(out, g_mesh);
 
     out.flush();
     out.close();
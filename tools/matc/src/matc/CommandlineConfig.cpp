@@ -81,6 +81,11 @@ static void usage(char* name) {
             "           MATC -PflipUV=false -PshadingModel=lit -Pname=myMat ...\n\n"
             "   --reflect, -r\n"
             "       Reflect the specified metadata as JSON: parameters\n\n"
+            "   --cache-dir, -C\n"
+            "       Cache compiled materials in the specified directory. The cache is keyed on\n"
+            "       the material source (with includes resolved), the compiler flags and the\n"
+            "       material version; unchanged materials are copied from the cache instead of\n"
+            "       being rebuilt.\n\n"
             "   --variant-filter=<filter>, -V <filter>\n"
             "       Filter out specified comma-separated variants:\n"
             "           directionalLighting, dynamicLighting, shadowReceiver, skinning, vsm, fog,"
@@ -181,7 +186,7 @@ static void parseDefine(std::string defineString, Config::StringReplacementMap&
 }
 
 bool CommandlineConfig::parse() {
-    static constexpr const char* OPTSTR = "hLxo:f:dm:a:l:p:D:T:P:OSEr:vV:gtwF1R";
+    static constexpr const char* OPTSTR = "hLxo:f:dm:a:l:p:C:D:T:P:OSEr:vV:gtwF1R";
     static const struct option OPTIONS[] = {
             { "help",                    no_argument, nullptr, 'h' },
             { "license",                 no_argument, nullptr, 'L' },
@@ -198,6 +203,7 @@ bool CommandlineConfig::parse() {
             { "api",               required_argument, nullptr, 'a' },
             { "feature-level",     required_argument, nullptr, 'l' },
             { "no-essl1",                no_argument, nullptr, '1' },
+            { "cache-dir",         required_argument, nullptr, 'C' },
             { "define",            required_argument, nullptr, 'D' },
             { "template",          required_argument, nullptr, 'T' },
             { "material-parameter",required_argument, nullptr, 'P' },
@@ -288,6 +294,9 @@ bool CommandlineConfig::parse() {
             case '1':
                 mIncludeEssl1 = false;
                 break;
+            case 'C':
+                mCacheDir = arg;
+                break;
             case 'D':
                 parseDefine(arg, mDefines);
                 break;
@@ -25,6 +25,7 @@
 #include <map>
 #include <memory>
 #include <ostream>
+#include <string>
 
 #include <utils/compiler.h>
 
@@ -147,6 +148,11 @@ public:
         return mFeatureLevel;
     }
 
+    // Directory used to cache compiled packages, empty when caching is disabled.
+    const std::string& getCacheDirectory() const noexcept {
+        return mCacheDir;
+    }
+
 protected:
     bool mDebug = false;
     bool mIsValid = true;
@@ -165,6 +171,7 @@ protected:
     StringReplacementMap mMaterialParameters;
     filament::UserVariantFilterMask mVariantFilter = 0;
     bool mIncludeEssl1 = true;
+    std::string mCacheDir;
 };
 
 }
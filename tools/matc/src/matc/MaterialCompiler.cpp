@@ -16,16 +16,24 @@
 
 #include "MaterialCompiler.h"
 
+#include <fstream>
 #include <memory>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
 #include <utility>
 
+#include <stdio.h>
+
 #include <filamat/MaterialBuilder.h>
 
 #include <filamat/Enums.h>
 
+#include <utils/Hash.h>
 #include <utils/Log.h>
 #include <utils/JobSystem.h>
+#include <utils/Path.h>
 
 #include "DirIncluder.h"
 #include "MaterialLexeme.h"
@@ -288,6 +296,50 @@ bool MaterialCompiler::isValidJsonStart(const char* buffer, size_t size) const n
     return c == 'n' && (end - buffer) > 3 && strncmp(buffer, "null", 5) != 0;
 }
 
+// Computes the cache key for a compilation: the material source, the content of every
+// (recursively) included file, the command line, and the material version. Two runs with the
+// same key produce byte-identical packages.
+static uint64_t computeCacheKey(const char* buffer, size_t size, const Config& config,
+        const utils::Path& materialFilePath) noexcept {
+    uint64_t key = filament::MATERIAL_VERSION;
+    auto hashBytes = [&key](const char* data, size_t len) {
+        if (len == 0) {
+            return;
+        }
+        uint32_t const h = utils::hash::murmurSlow(
+                reinterpret_cast<const uint8_t*>(data), len, uint32_t(key));
+        key = utils::hash::combine(size_t(key), size_t(h));
+    };
+    hashBytes(buffer, size);
+    std::string const flags = config.toString();
+    hashBytes(flags.data(), flags.size());
+
+    // Each include contributes its content, so that editing an included file invalidates the
+    // cache entries of all materials that use it.
+    DirIncluder includer;
+    includer.setIncludeDirectory(materialFilePath.getParent());
+    std::unordered_set<std::string> visited;
+    auto scan = [&](auto&& self, std::string_view text, const utils::CString& includerName) -> void {
+        for (size_t pos = text.find("#include"); pos != std::string_view::npos;
+                pos = text.find("#include", pos)) {
+            pos += 8; // skip over "#include"
+            while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t')) ++pos;
+            if (pos >= text.size() || text[pos] != '"') continue;
+            size_t const end = text.find('"', pos + 1);
+            if (end == std::string_view::npos) break;
+            std::string const name(text.substr(pos + 1, end - pos - 1));
+            pos = end + 1;
+            filamat::IncludeResult result{ utils::CString(name.c_str()) };
+            if (!includer(includerName, result)) continue;
+            if (!visited.insert(result.name.c_str()).second) continue;
+            hashBytes(result.text.c_str(), result.text.size());
+            self(self, std::string_view(result.text.c_str(), result.text.size()), result.name);
+        }
+    };
+    scan(scan, std::string_view(buffer, size), utils::CString());
+    return key;
+}
+
 bool MaterialCompiler::run(const Config& config) {
     Config::Input* input = config.getInput();
     ssize_t size = input->open();
@@ -369,6 +421,29 @@ bool MaterialCompiler::run(const Config& config) {
         return success;
     }
 
+    // With a cache directory configured, the build can be skipped entirely when an identical
+    // compilation has already been done.
+    utils::Path cacheEntry;
+    if (!config.getCacheDirectory().empty() &&
+            config.getReflectionTarget() == Config::Metadata::NONE) {
+        uint64_t const key = computeCacheKey(buffer.get(), size_t(size), config, materialFilePath);
+        char filename[32];
+        snprintf(filename, sizeof(filename), "%016llx.matpkg", (unsigned long long)key);
+        cacheEntry = utils::Path(config.getCacheDirectory()) + filename;
+        if (cacheEntry.isFile()) {
+            std::ifstream in(cacheEntry.getPath(), std::ios::binary | std::ios::ate);
+            ssize_t const cachedSize = in.tellg();
+            if (in && cachedSize > 0) {
+                Package cached{ size_t(cachedSize) };
+                in.seekg(0);
+                in.read(reinterpret_cast<char*>(cached.getData()), cachedSize);
+                if (in) {
+                    return writePackage(cached, config);
+                }
+            }
+        }
+    }
+
     MaterialBuilder::init();
     MaterialBuilder builder;
     // Before attempting an expensive lex, let's find out if we were sent pure JSON.
@@ -435,6 +510,21 @@ bool MaterialCompiler::run(const Config& config) {
         std::cerr << "Could not compile material " << input->getName() << std::endl;
         return false;
     }
+
+    if (!cacheEntry.getPath().empty()) {
+        utils::Path(config.getCacheDirectory()).mkdirRecursive();
+        // write through a temporary so a concurrent compilation never sees a partial entry
+        std::string const tmpPath = cacheEntry.getPath() + ".tmp";
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(package.getData()), ssize_t(package.getSize()));
+        out.close();
+        if (out) {
+            std::rename(tmpPath.c_str(), cacheEntry.getPath().c_str());
+        } else {
+            std::remove(tmpPath.c_str());
+        }
+    }
+
     return writePackage(package, config);
 }
 
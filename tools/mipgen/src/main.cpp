@@ -24,10 +24,12 @@
 #include <imageio/ImageDecoder.h>
 #include <imageio/ImageEncoder.h>
 
+#include <utils/JobSystem.h>
 #include <utils/Path.h>
 
 #include <getopt/getopt.h>
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -266,6 +268,9 @@ static int handleArguments(int argc, char* argv[]) {
 }
 
 int main(int argc, char* argv[]) {
+    utils::JobSystem js;
+    js.adopt();
+
     int optionIndex = handleArguments(argc, argv);
     int numArgs = argc - optionIndex;
     if (numArgs < 2) {
@@ -317,20 +322,18 @@ int main(int argc, char* argv[]) {
         sourceImage = colorsToVectors(sourceImage);
     }
 
-    if (!g_quietMode) {
-        puts("Generating miplevels...");
-    }
-
     uint32_t count = getMipmapCount(sourceImage);
     count = g_mipLevelCount == 0 ? count : min(g_mipLevelCount - 1, count);
-    vector<LinearImage> miplevels(count);
-    generateMipmaps(sourceImage, g_filter, miplevels.data(), count);
 
     if (g_ktx1Container) {
         if (!g_quietMode) {
+            puts("Generating miplevels...");
             puts("Writing KTX file to disk...");
         }
 
+        vector<LinearImage> miplevels(count);
+        generateMipmaps(js, sourceImage, g_filter, miplevels.data(), count);
+
         // The libimage API does not include the original image in the mip array,
         // which might make sense when generating individual files, but for a KTX
         // bundle, we want to include level 0, so add 1 to the KTX level count.
@@ -413,9 +416,13 @@ int main(int argc, char* argv[]) {
 
     if (g_ktx2Container) {
         if (!g_quietMode) {
+            puts("Generating miplevels...");
             puts("Writing KTX2 file to disk...");
         }
 
+        vector<LinearImage> miplevels(count);
+        generateMipmaps(js, sourceImage, g_filter, miplevels.data(), count);
+
         BasisEncoder::Builder builder(miplevels.size() + 1, 1);
         using IntermediateFormat = BasisEncoder::IntermediateFormat;
 
@@ -457,35 +464,52 @@ int main(int argc, char* argv[]) {
     }
 
     if (!g_quietMode) {
-        puts("Writing image files to disk...");
+        puts("Generating and writing miplevels...");
     }
 
-    char path[256];
-    uint32_t mip = 1; // start at 1 because 0 is the original image
-    for (auto image : miplevels) {
-        int result = snprintf(path, sizeof(path), outputPattern.c_str(), mip++);
-        if (result < 0 || result >= sizeof(path)) {
-            cerr << "Output pattern is too long." << endl;
-            return 1;
-        }
-        Path(path).getParent().mkdirRecursive();
-        ofstream outputStream(path, ios::binary | ios::trunc);
-        if (!outputStream) {
-            cerr << "The output file cannot be opened: " << path << endl;
-        } else {
+    // Each miplevel is resampled directly from the source image, so the levels are
+    // independent of each other. Fuse generation and compression by giving every level
+    // its own job: the encoders consume completed levels while the remaining levels are
+    // still being downsampled, instead of a full generation pass followed by a serial
+    // encoding pass.
+    std::atomic<bool> ok(true);
+    JobSystem::Job* parent = js.createJob();
+    for (uint32_t mip = 1; mip <= count; ++mip) { // start at 1 because 0 is the original image
+        js.run(jobs::createJob(js, parent, [&, mip]() {
+            char path[256];
+            int result = snprintf(path, sizeof(path), outputPattern.c_str(), mip);
+            if (result < 0 || result >= sizeof(path)) {
+                cerr << "Output pattern is too long." << endl;
+                ok = false;
+                return;
+            }
+            Path(path).getParent().mkdirRecursive();
+            ofstream outputStream(path, ios::binary | ios::trunc);
+            if (!outputStream) {
+                cerr << "The output file cannot be opened: " << path << endl;
+                return;
+            }
+            const uint32_t w = std::max(sourceImage.getWidth() >> mip, 1u);
+            const uint32_t h = std::max(sourceImage.getHeight() >> mip, 1u);
+            LinearImage image = resampleImage(js, sourceImage, w, h, g_filter);
             if (g_filter == Filter::GAUSSIAN_NORMALS) {
                 image = vectorsToColors(image);
             }
             if (!ImageEncoder::encode(outputStream, g_format, image, g_compressionString, path)) {
                 cerr << "An error occurred while encoding the image." << endl;
-                return 1;
+                ok = false;
+                return;
             }
             outputStream.close();
             if (!outputStream) {
                 cerr << "An error occurred while writing the output file: " << path << endl;
-                return 1;
+                ok = false;
             }
-        }
+        }));
+    }
+    js.runAndWait(parent);
+    if (!ok) {
+        return 1;
     }
 
     if (g_createGallery) {
@@ -493,8 +517,8 @@ int main(int argc, char* argv[]) {
             puts("Generating mipmaps.html...");
         }
 
+        char path[256];
         char tag[256];
-        mip = 1;
         const char* pattern = R"(<image src="%s" width="%dpx" height="%dpx">)";
         const uint32_t width = sourceImage.getWidth();
         const uint32_t height = sourceImage.getHeight();
@@ -506,8 +530,8 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         html << tag << std::endl;
-        for (auto image: miplevels) {
-            snprintf(path, sizeof(path), outputPattern.c_str(), mip++);
+        for (uint32_t mip = 1; mip <= count; ++mip) {
+            snprintf(path, sizeof(path), outputPattern.c_str(), mip);
             result = snprintf(tag, sizeof(tag), pattern, path, width, height);
             if (result < 0 || result >= sizeof(tag)) {
                 cerr << "Output pattern is too long." << endl;
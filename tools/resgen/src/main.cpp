@@ -45,7 +45,7 @@ static const char* USAGE = R"TXT(
 RESGEN aggregates a sequence of binary blobs, each of which becomes a "resource" whose id
 is the basename of the input file. It produces the following set of files:
 
-    resources.h ......... declares sizes and offsets for each resource
+    resources.h ......... declares sizes and offsets for each resource, plus an index table
     resources.S ......... small assembly file with incbin directive and rodata section
     resources.apple.S ... ditto but with different rodata name and underscore prefixes
     resources.bin ....... the aggregated binary blob that the incbin refers to
@@ -82,20 +82,29 @@ Examples:
                          TEXTURES_BEACH_DATA, TEXTURES_BEACH_SIZE
 )TXT";
 
+// The package gets its own page-aligned read-only section so that consumers can reference
+// the embedded bytes in place: the pages stay clean (shared across forked processes) and
+// each blob starts on a cache-line boundary (see BLOB_ALIGNMENT below).
 static const char* APPLE_ASM_TEMPLATE = R"ASM(
     .global _{RESOURCES}PACKAGE
     .section __TEXT,__const
+    .p2align 12
 _{RESOURCES}PACKAGE:
     .incbin "{resources}.bin"
 )ASM";
 
 static const char* ASM_TEMPLATE = R"ASM(
     .global {RESOURCES}PACKAGE
-    .section .rodata
+    .section .rodata.{resources}.resgen
+    .balign 4096
 {RESOURCES}PACKAGE:
     .incbin "{resources}.bin"
 )ASM";
 
+// Each blob is padded up to a multiple of this, so that every _OFFSET is cache-line aligned.
+// The _SIZE macros and the JSON summary report the unpadded sizes.
+static constexpr size_t BLOB_ALIGNMENT = 64;
+
 static void printUsage(const char* name) {
     std::string execName(Path(name).getName());
     const std::string from("RESGEN");
@@ -249,6 +258,8 @@ int main(int argc, char* argv[]) {
             << "    extern const uint8_t " << package << "[];" << endl;
 
     ostringstream headerMacros;
+    ostringstream headerIndex;
+    size_t resourceCount = 0;
     ostringstream appleDataAsmStream;
     ostringstream dataAsmStream;
     ostringstream jsonStream;
@@ -262,7 +273,7 @@ int main(int argc, char* argv[]) {
             exit(1);
         }
         xxdStream << "#include <stdint.h>\n"
-                  << "const uint8_t " << package << "[] = {\n";
+                  << "const uint8_t __attribute__((aligned(4096))) " << package << "[] = {\n";
     }
 
     // Consume each input file and write it back out into the various output streams.
@@ -294,6 +305,11 @@ int main(int argc, char* argv[]) {
             content.push_back(0);
         }
 
+        // The real size, as reported by the _SIZE macro and the JSON summary; the blob is
+        // then zero-padded so that the next offset lands on a cache-line boundary.
+        const size_t contentSize = content.size();
+        content.resize((contentSize + BLOB_ALIGNMENT - 1) & ~(BLOB_ALIGNMENT - 1), 0);
+
         // Formulate the resource name and the prefixed resource name.
         std::string rname = g_keepExtension ? inPath.getName() : inPath.getNameWithoutExtension();
         replace(rname.begin(), rname.end(), '.', '_');
@@ -306,9 +322,13 @@ int main(int argc, char* argv[]) {
         // Write the offsets and sizes.
         headerMacros
                 << "#define " << prname << "_OFFSET " << offset << "\n"
-                << "#define " << prname << "_SIZE " << content.size() << "\n"
+                << "#define " << prname << "_SIZE " << contentSize << "\n"
                 << "#define " << prname << "_DATA (" << package << " + " << prname << "_OFFSET)\n\n";
 
+        headerIndex
+                << "    { \"" << rname << "\", " << offset << ", " << contentSize << " },\n";
+        resourceCount++;
+
         // Write the xxd-style ASCII array, followed by a blank line.
         if (g_generateC) {
             xxdStream << "// " << rname << "\n";
@@ -324,12 +344,19 @@ int main(int argc, char* argv[]) {
             xxdStream << "\n";
         }
 
-        jsonStream << "\"" << rname << "\":" << content.size() << ",";
+        jsonStream << "\"" << rname << "\":" << contentSize << ",";
         offset += content.size();
     }
 
     headerStream << "}\n\n";
     headerStream << headerMacros.str();
+    headerStream
+            << "struct " << packagePrefix << "ENTRY { const char* name; uint32_t offset; uint32_t size; };\n"
+            << "#define " << packagePrefix << "ENTRY_COUNT " << resourceCount << "\n"
+            << "inline constexpr " << packagePrefix << "ENTRY "
+            << packagePrefix << "ENTRIES[" << packagePrefix << "ENTRY_COUNT] = {\n"
+            << headerIndex.str()
+            << "};\n\n";
     headerStream << "#endif\n";
 
     // To optimize builds, avoid overwriting the header file if nothing has changed.
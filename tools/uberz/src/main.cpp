@@ -184,13 +184,20 @@ int main(int argc, char* argv[]) {
             cerr << "Unable to consume " << g_outputFile << endl;
             exit(1);
         }
-        const uint64_t decompSize = ZSTD_getFrameContentSize(archiveData, archiveSize);
-        if (decompSize == ZSTD_CONTENTSIZE_UNKNOWN || decompSize == ZSTD_CONTENTSIZE_ERROR) {
-            PANIC_POSTCONDITION("Decompression error.");
+        if (hasUncompressedIndex(archiveData, archiveSize)) {
+            // Version >= 1: only the packages are compressed, each as its own zstd frame.
+            uint64_t* basePointer = (uint64_t*) utils::aligned_alloc(archiveSize, 8);
+            memcpy(basePointer, archiveData, archiveSize);
+            existingArchive = (ReadableArchive*) basePointer;
+        } else {
+            const uint64_t decompSize = ZSTD_getFrameContentSize(archiveData, archiveSize);
+            if (decompSize == ZSTD_CONTENTSIZE_UNKNOWN || decompSize == ZSTD_CONTENTSIZE_ERROR) {
+                PANIC_POSTCONDITION("Decompression error.");
+            }
+            uint64_t* basePointer = (uint64_t*) utils::aligned_alloc(decompSize, 8);
+            ZSTD_decompress(basePointer, decompSize, archiveData, archiveSize);
+            existingArchive = (ReadableArchive*) basePointer;
         }
-        uint64_t* basePointer = (uint64_t*) utils::aligned_alloc(decompSize, 8);
-        ZSTD_decompress(basePointer, decompSize, archiveData, archiveSize);
-        existingArchive = (ReadableArchive*) basePointer;
         convertOffsetsToPointers(existingArchive);
         existingMaterialsCount = existingArchive->specsCount;
     }
@@ -204,7 +211,21 @@ int main(int argc, char* argv[]) {
             // a made-up string (it is only used for error messages).
             std::string materialName = "mat" + to_string(specIndex);
             const ArchiveSpec& spec = existingArchive->specs[specIndex];
-            outputArchive.addMaterial(materialName.c_str(), spec.package, spec.packageByteCount);
+            const uint8_t* packageData = spec.package;
+            size_t packageSize = spec.packageByteCount;
+            FixedCapacityVector<uint8_t> decompressed;
+            if (existingArchive->version >= 1) {
+                // Packages are stored as individual zstd frames since version 1.
+                const uint64_t rawSize = ZSTD_getFrameContentSize(packageData, packageSize);
+                if (rawSize == ZSTD_CONTENTSIZE_UNKNOWN || rawSize == ZSTD_CONTENTSIZE_ERROR) {
+                    PANIC_POSTCONDITION("Decompression error.");
+                }
+                decompressed = FixedCapacityVector<uint8_t>(rawSize);
+                ZSTD_decompress(decompressed.data(), rawSize, packageData, packageSize);
+                packageData = decompressed.data();
+                packageSize = rawSize;
+            }
+            outputArchive.addMaterial(materialName.c_str(), packageData, packageSize);
             outputArchive.setShadingModel(spec.shadingModel);
             outputArchive.setBlendingModel(spec.blendingMode);
             for (uint16_t flagIndex = 0; flagIndex < spec.flagsCount; ++flagIndex) {